@@ -40,3 +40,4 @@ FOUNDATION_EXPORT const unsigned char AWSAPIGatewayVersionString[] DEPRECATED_MS
 
 #import <AWSCore/AWSCore.h>
 #import "AWSAPIGatewayClient.h"
+#import "AWSAPIGatewayResponseCache.h"
@@ -16,6 +16,7 @@
 #import <Foundation/Foundation.h>
 #import <AWSCore/AWSCore.h>
 #import "AWSAPIGatewayModel.h"
+#import "AWSAPIGatewayResponseCache.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -35,12 +36,42 @@ typedef NS_ENUM(NSInteger, AWSAPIGatewayErrorType) {
 
 @class AWSServiceConfiguration;
 
+/**
+ *  The default retry handler of `AWSAPIGatewayClient`. It retries throttled (429) requests, and requests of idempotent
+ *  methods that failed with a 500, 502, 503 or 504 status code or a network error. `POST` and `PATCH` requests are only
+ *  retried when they were throttled or could not reach the server. The delay honours the `Retry-After` header and
+ *  otherwise grows exponentially with random jitter.
+ */
+@interface AWSAPIGatewayRetryHandler : AWSURLRequestRetryHandler
+
+@end
+
 @interface AWSAPIGatewayClient : NSObject
 
 @property (nonatomic, strong) AWSServiceConfiguration *configuration;
 
 @property (nonatomic, strong, nullable) NSString *APIKey;
 
+/**
+ *  Decides whether failed requests are retried, and after how long. Defaults to the `retryHandler` of `configuration`
+ *  when it has one, and otherwise to an `AWSAPIGatewayRetryHandler` retrying `configuration.maxRetryCount` times.
+ *  Requests are signed again before every retry.
+ */
+@property (nonatomic, strong, null_resettable) id<AWSURLRequestRetryHandler> retryHandler;
+
+/**
+ *  The cache of `GET` responses. Responses are not cached when `nil`, which is the default. Requests without a
+ *  `Cache-Control` header are still sent with `Cache-Control: no-store`, so the `NSURLCache` of the URL session does
+ *  not store the responses as well.
+ */
+@property (nonatomic, strong, nullable) AWSAPIGatewayResponseCache *responseCache;
+
+/**
+ *  Whether a `GET` request waits for an identical request that is already in flight, sharing its response, instead of
+ *  being sent separately. Requests are identical when their URL and headers are. Defaults to `YES`.
+ */
+@property (nonatomic, assign) BOOL coalescesIdenticalRequests;
+
 
 
 /**
@@ -32,6 +32,20 @@ static int defaultChunkSize = 1024;
 // Networking
 @property (nonatomic, strong) NSURLSession *session;
 
+// The tasks of the GET requests in flight, by request key.
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSTask<AWSAPIGatewayResponse *> *> *requestsInFlight;
+
+@end
+
+@interface AWSAPIGatewayResponseCache()
+
++ (NSDictionary<NSString *, NSString *> *)cacheControlDirectives:(nullable NSString *)headerValue;
++ (NSDictionary<NSString *, NSString *> *)conditionalHeadersForResponse:(AWSAPIGatewayResponse *)cachedResponse;
+- (nullable AWSAPIGatewayResponse *)cachedResponseForKey:(NSString *)key fresh:(BOOL *)fresh;
+- (AWSAPIGatewayResponse *)storeResponse:(AWSAPIGatewayResponse *)response
+                    revalidatingResponse:(nullable AWSAPIGatewayResponse *)cachedResponse
+                                  forKey:(NSString *)key;
+
 @end
 
 @interface AWSAPIGatewayRequest()
@@ -58,6 +72,78 @@ static int defaultChunkSize = 1024;
 
 @end
 
+@implementation AWSAPIGatewayRetryHandler
+
+static NSTimeInterval const AWSAPIGatewayRetryBaseDelay = 0.1;
+static NSTimeInterval const AWSAPIGatewayRetryMaximumDelay = 20.0;
+
+- (AWSNetworkingRetryType)shouldRetry:(uint32_t)currentRetryCount
+                      originalRequest:(AWSNetworkingRequest *)originalRequest
+                             response:(NSHTTPURLResponse *)response
+                                 data:(NSData *)data
+                                error:(NSError *)error {
+    if (currentRetryCount >= self.maxRetryCount) {
+        return AWSNetworkingRetryTypeShouldNotRetry;
+    }
+
+    // Throttled requests were not processed.
+    if (response.statusCode == 429) {
+        return AWSNetworkingRetryTypeShouldRetry;
+    }
+
+    BOOL idempotent = originalRequest.HTTPMethod != AWSHTTPMethodPOST && originalRequest.HTTPMethod != AWSHTTPMethodPATCH;
+    if (!idempotent) {
+        // Only retries requests that never reached the server.
+        if ([error.domain isEqualToString:NSURLErrorDomain]) {
+            switch (error.code) {
+                case NSURLErrorCannotFindHost:
+                case NSURLErrorCannotConnectToHost:
+                case NSURLErrorDNSLookupFailed:
+                    return AWSNetworkingRetryTypeShouldRetry;
+
+                default:
+                    break;
+            }
+        }
+        return AWSNetworkingRetryTypeShouldNotRetry;
+    }
+
+    switch (response.statusCode) {
+        case 502:
+        case 504:
+            return AWSNetworkingRetryTypeShouldRetry;
+
+        default:
+            break;
+    }
+
+    return [super shouldRetry:currentRetryCount
+              originalRequest:originalRequest
+                     response:response
+                         data:data
+                        error:error];
+}
+
+- (NSTimeInterval)timeIntervalForRetry:(uint32_t)currentRetryCount
+                              response:(NSHTTPURLResponse *)response
+                                  data:(NSData *)data
+                                 error:(NSError *)error {
+    NSString *retryAfter = response.allHeaderFields[@"Retry-After"];
+    if (retryAfter) {
+        NSTimeInterval delay = [retryAfter doubleValue];
+        if (delay <= 0) {
+            delay = [[NSDate aws_dateFromString:retryAfter] timeIntervalSinceNow];
+        }
+        return MIN(MAX(delay, 0), AWSAPIGatewayRetryMaximumDelay);
+    }
+
+    // Exponential backoff with full jitter, so that throttled clients do not retry at the same time.
+    NSTimeInterval maximumDelay = MIN(AWSAPIGatewayRetryBaseDelay * pow(2, currentRetryCount), AWSAPIGatewayRetryMaximumDelay);
+    return maximumDelay * arc4random_uniform(1001) / 1000;
+}
+
+@end
+
 @implementation AWSAPIGatewayClient
 
 + (void)initialize {
@@ -82,10 +168,32 @@ static int defaultChunkSize = 1024;
         });
 
         _session = session;
+        _coalescesIdenticalRequests = YES;
+        _requestsInFlight = [NSMutableDictionary new];
     }
     return self;
 }
 
++ (AWSExecutor *)serializationExecutor {
+    static AWSExecutor *_serializationExecutor = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _serializationExecutor = [AWSExecutor executorWithDispatchQueue:dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0)];
+    });
+    return _serializationExecutor;
+}
+
+- (id<AWSURLRequestRetryHandler>)retryHandler {
+    if (_retryHandler) {
+        return _retryHandler;
+    }
+    if (self.configuration.retryHandler) {
+        return self.configuration.retryHandler;
+    }
+    // The configuration is usually assigned after the client is created, so the default is not kept.
+    return [[AWSAPIGatewayRetryHandler alloc] initWithMaximumRetryCount:self.configuration.maxRetryCount];
+}
+
 - (AWSTask<AWSAPIGatewayResponse *> *)invoke:(AWSAPIGatewayRequest *)apiRequest {
     
     if(!apiRequest) {
@@ -99,9 +207,8 @@ static int defaultChunkSize = 1024;
     request.HTTPMethod = apiRequest.HTTPMethod;
     request.allHTTPHeaderFields = [self finalizeRequestHeaders:apiRequest.headerParameters];
 
-    AWSTask *task = [AWSTask taskWithResult:nil];
-    
-    task = [task continueWithSuccessBlock:^id(AWSTask *task) {
+    // Serializes the body off the calling thread.
+    AWSTask *task = [[AWSTask taskWithResult:nil] continueWithExecutor:[AWSAPIGatewayClient serializationExecutor] withSuccessBlock:^id(AWSTask *task) {
         NSError *error = nil;
         if (apiRequest.HTTPBody != nil) {
             
@@ -159,53 +266,10 @@ static int defaultChunkSize = 1024;
         }
         return nil;
     }];
-    
-    // Refreshes credentials if necessary
-    task = [task continueWithSuccessBlock:^id(AWSTask *task) {
-        id signer = [self.configuration.requestInterceptors lastObject];
-        if (signer) {
-            if ([signer respondsToSelector:@selector(credentialsProvider)]) {
-                id<AWSCredentialsProvider> credentialsProvider = [signer performSelector:@selector(credentialsProvider)];
-                return [credentialsProvider credentials];
-            }
-        }
-        return nil;
-    }];
-    
-    // Signs the request
-    for (id<AWSNetworkingRequestInterceptor> interceptor in self.configuration.requestInterceptors) {
-        task = [task continueWithSuccessBlock:^id(AWSTask *task) {
-            return [interceptor interceptRequest:request];
-        }];
-    }
-    
-    return  [task continueWithSuccessBlock:^id(AWSTask *task) {
-        AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource new];
-        
-        void (^completionHandler)(NSData *data, NSURLResponse *response, NSError *error) = ^(NSData *data, NSURLResponse *response, NSError *error) {
-            // Networking errors
-            if (error) {
-                [completionSource setError:error];
-            } else {
-                
-                NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
-                NSDictionary *HTTPHeaderFields = HTTPResponse.allHeaderFields;
-                NSInteger HTTPStatusCode = HTTPResponse.statusCode;
-                
-                [completionSource setResult:[[AWSAPIGatewayResponse alloc] initWithHeaders:HTTPHeaderFields
-                                                                              responseData:data
-                                                                       NSURLResponseObject:response
-                                                                                statusCode:HTTPStatusCode]];
-            }
-        };
-        AWSDDLogVerbose(@"%@",request);
-        NSURLSessionDataTask *sessionTask = [self.session dataTaskWithRequest:request
-                                                            completionHandler:completionHandler];
-        [sessionTask resume];
-        
-        return completionSource.task;
-    }];
 
+    return [task continueWithSuccessBlock:^id(AWSTask *task) {
+        return [self sendRequest:request];
+    }];
 }
 
 - (AWSTask *)invokeHTTPRequest:(NSString *)HTTPMethod
@@ -220,17 +284,205 @@ static int defaultChunkSize = 1024;
     request.HTTPMethod = HTTPMethod;
     request.allHTTPHeaderFields = [self finalizeRequestHeaders:headerParameters];
 
+    // Serializes the body off the calling thread.
+    AWSTask *task = [[AWSTask taskWithResult:nil] continueWithExecutor:[AWSAPIGatewayClient serializationExecutor] withSuccessBlock:^id(AWSTask *task) {
+        if (body != nil) {
+            NSError *error = nil;
+            NSDictionary *bodyParameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:body] aws_removeNullValues];
+            request.HTTPBody = [NSJSONSerialization dataWithJSONObject:bodyParameters
+                                                               options:0
+                                                                 error:&error];
+            if (!request.HTTPBody) {
+                AWSDDLogError(@"Failed to serialize a request body. %@", error);
+            }
+        }
+        return nil;
+    }];
+
+    return [[task continueWithSuccessBlock:^id(AWSTask *task) {
+        return [self sendRequest:request];
+    }] continueWithSuccessBlock:^id(AWSTask<AWSAPIGatewayResponse *> *task) {
+        AWSAPIGatewayResponse *response = task.result;
+        return [self resultOfResponse:(NSHTTPURLResponse *)response.rawResponse
+                                 data:response.responseData
+                        responseClass:responseClass];
+    }];
+}
+
+- (AWSTask *)resultOfResponse:(NSHTTPURLResponse *)HTTPResponse
+                         data:(NSData *)data
+                responseClass:(Class)responseClass {
     NSError *error = nil;
-    if (body != nil) {
-        NSDictionary *bodyParameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:body] aws_removeNullValues];
-        request.HTTPBody = [NSJSONSerialization dataWithJSONObject:bodyParameters
-                                                           options:0
-                                                             error:&error];
-        if (!request.HTTPBody) {
-            AWSDDLogError(@"Failed to serialize a request body. %@", error);
+
+    // Serializes the HTTP body
+    id JSONObject = nil;
+    if (data && [data length] > 0) {
+        JSONObject = [NSJSONSerialization JSONObjectWithData:data
+                                                     options:NSJSONReadingAllowFragments
+                                                       error:&error];
+        if (!JSONObject) {
+            NSString *bodyString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+            if ([bodyString length] > 0) {
+                AWSDDLogError(@"The body is not in JSON format. Body: %@\nError: %@", bodyString, error);
+            }
+            return [AWSTask taskWithError:error];
+        }
+    }
+
+    // Handles developer defined errors
+    NSDictionary *HTTPHeaderFields = HTTPResponse.allHeaderFields;
+    NSInteger HTTPStatusCode = HTTPResponse.statusCode;
+    if (HTTPStatusCode/100 == 4 || HTTPStatusCode/100 == 5) {
+        NSMutableDictionary *userInfo = [NSMutableDictionary new];
+        if (JSONObject) {
+            userInfo[AWSAPIGatewayErrorHTTPBodyKey] = JSONObject;
+        }
+        if (HTTPHeaderFields) {
+            userInfo[AWSAPIGatewayErrorHTTPHeaderFieldsKey] = HTTPHeaderFields;
         }
+
+        return [AWSTask taskWithError:[NSError errorWithDomain:AWSAPIGatewayErrorDomain
+                                                          code:HTTPStatusCode/100 == 4 ? AWSAPIGatewayErrorTypeClient : AWSAPIGatewayErrorTypeService
+                                                      userInfo:userInfo]];
     }
 
+    // Maps a serialized JSON object to an Objective-C object
+    if (JSONObject) {
+        if (responseClass
+            && responseClass != [NSDictionary class]) {
+            if ([JSONObject isKindOfClass:[NSDictionary class]]) {
+                NSError *responseSerializationError = nil;
+                JSONObject = [AWSMTLJSONAdapter modelOfClass:responseClass
+                                          fromJSONDictionary:JSONObject
+                                                       error:&responseSerializationError];
+                if (!JSONObject) {
+                    AWSDDLogError(@"Failed to serialize the body JSON. %@", responseSerializationError);
+                }
+            }
+            if ([JSONObject isKindOfClass:[NSArray class]]) {
+                NSError *responseSerializationError = nil;
+                NSMutableArray *models = [NSMutableArray new];
+                for (id object in JSONObject) {
+                    id model = [AWSMTLJSONAdapter modelOfClass:responseClass
+                                            fromJSONDictionary:object
+                                                         error:&responseSerializationError];
+                    [models addObject:model];
+                    if (!JSONObject) {
+                        AWSDDLogError(@"Failed to serialize the body JSON. %@", responseSerializationError);
+                    }
+                }
+                JSONObject = models;
+            }
+        }
+    }
+    return [AWSTask taskWithResult:JSONObject];
+}
+
+#pragma mark - Sending requests
+
+/**
+ Sends a request, sharing the response of an identical GET request in flight.
+ */
+- (AWSTask<AWSAPIGatewayResponse *> *)sendRequest:(NSMutableURLRequest *)request {
+    if (self.configuration.timeoutIntervalForRequest > 0) {
+        request.timeoutInterval = self.configuration.timeoutIntervalForRequest;
+    }
+    if ([request.HTTPMethod caseInsensitiveCompare:@"GET"] != NSOrderedSame) {
+        return [self loadRequest:request key:nil];
+    }
+
+    NSString *key = [self keyForRequest:request];
+    if (!key || !self.coalescesIdenticalRequests) {
+        return [self loadRequest:request key:key];
+    }
+
+    AWSTaskCompletionSource *completionSource = nil;
+    @synchronized(self.requestsInFlight) {
+        AWSTask<AWSAPIGatewayResponse *> *requestInFlight = self.requestsInFlight[key];
+        if (requestInFlight) {
+            return requestInFlight;
+        }
+        completionSource = [AWSTaskCompletionSource taskCompletionSource];
+        self.requestsInFlight[key] = completionSource.task;
+    }
+    [[self loadRequest:request key:key] continueWithBlock:^id(AWSTask<AWSAPIGatewayResponse *> *task) {
+        @synchronized(self.requestsInFlight) {
+            [self.requestsInFlight removeObjectForKey:key];
+        }
+        if (task.error) {
+            [completionSource setError:task.error];
+        } else {
+            [completionSource setResult:task.result];
+        }
+        return nil;
+    }];
+    return completionSource.task;
+}
+
+/**
+ Identifies a GET request by its URL, headers and the identity it is signed for, before it is signed. Returns nil when
+ the credentials provider has an identity that is not known yet, so responses are never shared between users.
+ */
+- (nullable NSString *)keyForRequest:(NSURLRequest *)request {
+    NSMutableString *key = [NSMutableString stringWithString:[request.URL absoluteString]];
+    id signer = [self.configuration.requestInterceptors lastObject];
+    if ([signer respondsToSelector:@selector(credentialsProvider)]) {
+        id credentialsProvider = [signer performSelector:@selector(credentialsProvider)];
+        if ([credentialsProvider respondsToSelector:@selector(identityId)]) {
+            NSString *identityId = [credentialsProvider performSelector:@selector(identityId)];
+            if (!identityId) {
+                return nil;
+            }
+            [key appendFormat:@"\nidentity:%@", identityId];
+        }
+    }
+    NSDictionary<NSString *, NSString *> *headers = request.allHTTPHeaderFields;
+    for (NSString *name in [[headers allKeys] sortedArrayUsingSelector:@selector(caseInsensitiveCompare:)]) {
+        [key appendFormat:@"\n%@:%@", [name lowercaseString], headers[name]];
+    }
+    return key;
+}
+
+/**
+ Answers a request from the response cache when it can, and otherwise sends it, revalidating the cached response if
+ there is one. `key` is nil for the requests that are never cached.
+ */
+- (AWSTask<AWSAPIGatewayResponse *> *)loadRequest:(NSMutableURLRequest *)request key:(NSString *)key {
+    AWSAPIGatewayResponseCache *responseCache = key ? self.responseCache : nil;
+    NSDictionary<NSString *, NSString *> *directives = [AWSAPIGatewayResponseCache cacheControlDirectives:[request valueForHTTPHeaderField:@"Cache-Control"]];
+    if (directives[@"no-store"]) {
+        responseCache = nil;
+    }
+
+    AWSAPIGatewayResponse *cachedResponse = nil;
+    if (responseCache) {
+        request.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        // The response cache stores the response, the `NSURLCache` of the shared URL session must not.
+        if ([request valueForHTTPHeaderField:@"Cache-Control"] == nil) {
+            [request setValue:@"no-store" forHTTPHeaderField:@"Cache-Control"];
+        }
+        BOOL fresh = NO;
+        cachedResponse = [responseCache cachedResponseForKey:key fresh:&fresh];
+        if (cachedResponse && fresh && !directives[@"no-cache"]) {
+            return [AWSTask taskWithResult:cachedResponse];
+        }
+        [[AWSAPIGatewayResponseCache conditionalHeadersForResponse:cachedResponse] enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSString *value, BOOL *stop) {
+            [request setValue:value forHTTPHeaderField:name];
+        }];
+    }
+
+    AWSTask<AWSAPIGatewayResponse *> *task = [self signAndSendRequest:request
+                                                         retryHandler:self.retryHandler
+                                                           retryCount:0];
+    if (!responseCache) {
+        return task;
+    }
+    return [task continueWithSuccessBlock:^id(AWSTask<AWSAPIGatewayResponse *> *task) {
+        return [responseCache storeResponse:task.result revalidatingResponse:cachedResponse forKey:key];
+    }];
+}
+
+- (AWSTask *)signRequest:(NSMutableURLRequest *)request {
     // Refreshes credentials if necessary
     AWSTask *task = [AWSTask taskWithResult:nil];
     task = [task continueWithSuccessBlock:^id(AWSTask *task) {
@@ -250,106 +502,98 @@ static int defaultChunkSize = 1024;
             return [interceptor interceptRequest:request];
         }];
     }
+    return task;
+}
 
-    return [task continueWithSuccessBlock:^id(AWSTask *task) {
+- (AWSTask<AWSAPIGatewayResponse *> *)signAndSendRequest:(NSMutableURLRequest *)request
+                                             retryHandler:(id<AWSURLRequestRetryHandler>)retryHandler
+                                               retryCount:(uint32_t)retryCount {
+    return [[[self signRequest:request] continueWithSuccessBlock:^id(AWSTask *task) {
         AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource new];
 
         void (^completionHandler)(NSData *data, NSURLResponse *response, NSError *error) = ^(NSData *data, NSURLResponse *response, NSError *error) {
             // Networking errors
             if (error) {
                 [completionSource setError:error];
-                return;
-            }
-
-            // Serializes the HTTP body
-            id JSONObject = nil;
-            if (data && [data length] > 0) {
-                JSONObject = [NSJSONSerialization JSONObjectWithData:data
-                                                             options:NSJSONReadingAllowFragments
-                                                               error:&error];
-                if (!JSONObject) {
-                    NSString *bodyString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
-                    if ([bodyString length] > 0) {
-                        AWSDDLogError(@"The body is not in JSON format. Body: %@\nError: %@", bodyString, error);
-                    }
-                    [completionSource setError:error];
-                    return;
-                }
-            }
-
-            // Handles developer defined errors
-            NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
-
-            NSDictionary *HTTPHeaderFields = HTTPResponse.allHeaderFields;
-            NSInteger HTTPStatusCode = HTTPResponse.statusCode;
-            if (HTTPStatusCode/100 == 4 || HTTPStatusCode/100 == 5) {
-                NSMutableDictionary *userInfo = [NSMutableDictionary new];
-                if (JSONObject) {
-                    userInfo[AWSAPIGatewayErrorHTTPBodyKey] = JSONObject;
-                }
-                if (HTTPHeaderFields) {
-                    userInfo[AWSAPIGatewayErrorHTTPHeaderFieldsKey] = HTTPHeaderFields;
-                }
+            } else {
 
-                if (HTTPStatusCode/100 == 4) {
-                    NSError *clientError = [NSError errorWithDomain:AWSAPIGatewayErrorDomain
-                                                               code:AWSAPIGatewayErrorTypeClient
-                                                           userInfo:userInfo];
-                    [completionSource setError:clientError];
-                }
-                if (HTTPStatusCode/100 == 5) {
-                    NSError *clientError = [NSError errorWithDomain:AWSAPIGatewayErrorDomain
-                                                               code:AWSAPIGatewayErrorTypeService
-                                                           userInfo:userInfo];
-                    [completionSource setError:clientError];
-                }
-                return;
-            }
+                NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
+                NSDictionary *HTTPHeaderFields = HTTPResponse.allHeaderFields;
+                NSInteger HTTPStatusCode = HTTPResponse.statusCode;
 
-            // Maps a serialized JSON object to an Objective-C object
-            if (JSONObject) {
-                if (responseClass
-                    && responseClass != [NSDictionary class]) {
-                    if ([JSONObject isKindOfClass:[NSDictionary class]]) {
-                        NSError *responseSerializationError = nil;
-                        JSONObject = [AWSMTLJSONAdapter modelOfClass:responseClass
-                                                  fromJSONDictionary:JSONObject
-                                                               error:&responseSerializationError];
-                        if (!JSONObject) {
-                            AWSDDLogError(@"Failed to serialize the body JSON. %@", responseSerializationError);
-                        }
-                    }
-                    if ([JSONObject isKindOfClass:[NSArray class]]) {
-                        NSError *responseSerializationError = nil;
-                        NSMutableArray *models = [NSMutableArray new];
-                        for (id object in JSONObject) {
-                            id model = [AWSMTLJSONAdapter modelOfClass:responseClass
-                                                    fromJSONDictionary:object
-                                                                 error:&responseSerializationError];
-                            [models addObject:model];
-                            if (!JSONObject) {
-                                AWSDDLogError(@"Failed to serialize the body JSON. %@", responseSerializationError);
-                            }
-                        }
-                        JSONObject = models;
-                    }
-                }
-                [completionSource setResult:JSONObject];
-            } else {
-                [completionSource setResult:nil];
+                [completionSource setResult:[[AWSAPIGatewayResponse alloc] initWithHeaders:HTTPHeaderFields
+                                                                              responseData:data
+                                                                       NSURLResponseObject:response
+                                                                                statusCode:HTTPStatusCode]];
             }
         };
+        AWSDDLogVerbose(@"%@",request);
         NSURLSessionDataTask *sessionTask = [self.session dataTaskWithRequest:request
                                                             completionHandler:completionHandler];
         [sessionTask resume];
 
         return completionSource.task;
+    }] continueWithBlock:^id(AWSTask<AWSAPIGatewayResponse *> *task) {
+        NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)task.result.rawResponse;
+        if (!retryHandler
+            || task.cancelled
+            || (!task.error && HTTPResponse.statusCode < 400)
+            || (task.error && ![task.error.domain isEqualToString:NSURLErrorDomain])) {
+            return task;
+        }
+
+        AWSNetworkingRequest *originalRequest = [AWSNetworkingRequest new];
+        originalRequest.HTTPMethod = [self HTTPMethodOfRequest:request];
+        originalRequest.URLString = [request.URL absoluteString];
+        originalRequest.headers = request.allHTTPHeaderFields;
+        AWSNetworkingRetryType retryType = [retryHandler shouldRetry:retryCount
+                                                     originalRequest:originalRequest
+                                                            response:HTTPResponse
+                                                                data:task.result.responseData
+                                                               error:task.error];
+        switch (retryType) {
+            case AWSNetworkingRetryTypeShouldCorrectClockSkewAndRetry:
+            case AWSNetworkingRetryTypeShouldRefreshCredentialsAndRetry: {
+                id signer = [self.configuration.requestInterceptors lastObject];
+                if ([signer respondsToSelector:@selector(credentialsProvider)]) {
+                    id<AWSCredentialsProvider> credentialsProvider = [signer performSelector:@selector(credentialsProvider)];
+                    [credentialsProvider invalidateCachedTemporaryCredentials];
+                }
+            }
+                // Keep going to the next 'case' statement.
+            case AWSNetworkingRetryTypeResetStreamAndRetry:
+            case AWSNetworkingRetryTypeShouldRetry: {
+                NSTimeInterval timeIntervalToSleep = [retryHandler timeIntervalForRetry:retryCount
+                                                                               response:HTTPResponse
+                                                                                   data:task.result.responseData
+                                                                                  error:task.error];
+                AWSDDLogDebug(@"Retrying %@ in %.3f seconds.", request.URL, timeIntervalToSleep);
+                return [[AWSTask taskWithDelay:(int)(timeIntervalToSleep * 1000)] continueWithBlock:^id(AWSTask *delayTask) {
+                    return [self signAndSendRequest:request
+                                       retryHandler:retryHandler
+                                         retryCount:retryCount + 1];
+                }];
+            }
+
+            default:
+                return task;
+        }
     }];
 }
 
+- (AWSHTTPMethod)HTTPMethodOfRequest:(NSURLRequest *)request {
+    for (AWSHTTPMethod HTTPMethod = AWSHTTPMethodGET; HTTPMethod <= AWSHTTPMethodDELETE; HTTPMethod++) {
+        if ([request.HTTPMethod caseInsensitiveCompare:[NSString aws_stringWithHTTPMethod:HTTPMethod]] == NSOrderedSame) {
+            return HTTPMethod;
+        }
+    }
+    return AWSHTTPMethodUnknown;
+}
+
 - (NSDictionary *)finalizeRequestHeaders:(NSDictionary *)requestHeaders {
     NSMutableDictionary *finalizedDictionary = [NSMutableDictionary dictionaryWithDictionary:requestHeaders];
-    if ([requestHeaders valueForKey:@"Cache-Control"] == nil) {
+    // Requests the response cache may answer get their default `no-store` once their key is taken, see `loadRequest:key:`.
+    if ([requestHeaders valueForKey:@"Cache-Control"] == nil && !self.responseCache) {
         [finalizedDictionary setValue:@"no-store" forKey:@"Cache-Control"];
     }
     if (self.APIKey) {
@@ -0,0 +1,75 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  A cache of the responses to `GET` requests made by `AWSAPIGatewayClient`, kept in memory and on disk.
+ *
+ *  Responses are stored according to their `Cache-Control` header: `no-store` responses are never stored, responses
+ *  are served without a request while younger than `max-age`, and older or `no-cache` responses are revalidated with
+ *  `If-None-Match` and `If-Modified-Since` using their `ETag` and `Last-Modified` headers. A `304 Not Modified`
+ *  response then returns the stored body. Requests with a `Cache-Control: no-store` header bypass the cache, and
+ *  requests with `Cache-Control: no-cache` always revalidate.
+ *
+ *  Responses are stored per URL, request headers and identity ID of the client's credentials provider, so users signed
+ *  in one after the other never share them. Requests are not cached while the identity ID is not known yet. With other
+ *  credentials providers, call `removeAllResponses` when the signed in user changes.
+ */
+@interface AWSAPIGatewayResponseCache : NSObject
+
+/**
+ *  The maximum number of body bytes kept in memory.
+ */
+@property (nonatomic, assign, readonly) NSUInteger memoryCapacity;
+
+/**
+ *  The maximum number of bytes kept on disk. The least recently stored responses are removed first.
+ */
+@property (nonatomic, assign, readonly) NSUInteger diskCapacity;
+
+/**
+ *  The directory of the stored responses.
+ */
+@property (nonatomic, strong, readonly) NSURL *directoryURL;
+
+/**
+ *  Returns the cache shared by default, which keeps up to 4 MB in memory and 20 MB in the caches directory.
+ */
++ (instancetype)defaultResponseCache;
+
+/**
+ *  Creates a response cache.
+ *
+ *  @param memoryCapacity The maximum number of body bytes kept in memory.
+ *  @param diskCapacity   The maximum number of bytes kept on disk. Pass 0 to keep responses in memory only.
+ *  @param directoryURL   The directory of the stored responses. Pass `nil` to use a directory in the caches directory.
+ *
+ *  @return A response cache.
+ */
+- (instancetype)initWithMemoryCapacity:(NSUInteger)memoryCapacity
+                          diskCapacity:(NSUInteger)diskCapacity
+                          directoryURL:(nullable NSURL *)directoryURL;
+
+/**
+ *  Removes all stored responses from memory and disk.
+ */
+- (void)removeAllResponses;
+
+@end
+
+NS_ASSUME_NONNULL_END
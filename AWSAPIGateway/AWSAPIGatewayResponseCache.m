@@ -0,0 +1,383 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSAPIGatewayResponseCache.h"
+#import <AWSCore/AWSCore.h>
+#import <CommonCrypto/CommonDigest.h>
+#import "AWSAPIGatewayModel.h"
+
+static NSString *const AWSAPIGatewayResponseCacheDirectoryName = @"com.amazonaws.AWSAPIGatewayResponseCache";
+static NSUInteger const AWSAPIGatewayResponseCacheDefaultMemoryCapacity = 4 * 1024 * 1024;
+static NSUInteger const AWSAPIGatewayResponseCacheDefaultDiskCapacity = 20 * 1024 * 1024;
+
+// Keys of a stored response.
+static NSString *const AWSAPIGatewayCachedURLKey = @"URL";
+static NSString *const AWSAPIGatewayCachedHeadersKey = @"headers";
+static NSString *const AWSAPIGatewayCachedDataKey = @"data";
+static NSString *const AWSAPIGatewayCachedDateKey = @"date";
+static NSString *const AWSAPIGatewayCachedMaxAgeKey = @"maxAge";
+static NSString *const AWSAPIGatewayCachedRevalidateKey = @"revalidate";
+
+@interface AWSAPIGatewayResponse()
+
+- (instancetype)initWithHeaders:(NSDictionary *)headers
+                   responseData:(NSData *)responseData
+            NSURLResponseObject:(NSURLResponse *)NSURLResponseObject
+                     statusCode:(NSInteger)statusCode;
+
+@end
+
+@interface AWSAPIGatewayResponseCache()
+
+@property (nonatomic, strong) NSCache<NSString *, NSDictionary *> *memoryCache;
+@property (nonatomic, strong) dispatch_queue_t diskQueue;
+// The bytes on disk, or -1 until the directory is first read. Only used on diskQueue.
+@property (nonatomic, assign) long long diskUsage;
+
+@end
+
+@implementation AWSAPIGatewayResponseCache
+
++ (instancetype)defaultResponseCache {
+    static AWSAPIGatewayResponseCache *_defaultResponseCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _defaultResponseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:AWSAPIGatewayResponseCacheDefaultMemoryCapacity
+                                                                               diskCapacity:AWSAPIGatewayResponseCacheDefaultDiskCapacity
+                                                                               directoryURL:nil];
+    });
+    return _defaultResponseCache;
+}
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `+ defaultResponseCache` or `- initWithMemoryCapacity:diskCapacity:directoryURL:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithMemoryCapacity:(NSUInteger)memoryCapacity
+                          diskCapacity:(NSUInteger)diskCapacity
+                          directoryURL:(NSURL *)directoryURL {
+    if (self = [super init]) {
+        _memoryCapacity = memoryCapacity;
+        _diskCapacity = diskCapacity;
+        if (!directoryURL) {
+            NSString *cachesDirectory = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+            directoryURL = [NSURL fileURLWithPath:[cachesDirectory stringByAppendingPathComponent:AWSAPIGatewayResponseCacheDirectoryName]
+                                      isDirectory:YES];
+        }
+        _directoryURL = directoryURL;
+        _memoryCache = [NSCache new];
+        _memoryCache.totalCostLimit = memoryCapacity;
+        _diskQueue = dispatch_queue_create("com.amazonaws.AWSAPIGatewayResponseCache.disk", DISPATCH_QUEUE_SERIAL);
+        _diskUsage = -1;
+    }
+    return self;
+}
+
+- (void)removeAllResponses {
+    [self.memoryCache removeAllObjects];
+    dispatch_sync(self.diskQueue, ^{
+        [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+        self.diskUsage = 0;
+    });
+}
+
+#pragma mark - HTTP caching
+
++ (NSDictionary<NSString *, NSString *> *)cacheControlDirectives:(NSString *)headerValue {
+    NSMutableDictionary<NSString *, NSString *> *directives = [NSMutableDictionary new];
+    for (NSString *component in [headerValue componentsSeparatedByString:@","]) {
+        NSArray<NSString *> *nameAndValue = [component componentsSeparatedByString:@"="];
+        NSString *name = [[nameAndValue[0] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] lowercaseString];
+        if ([name length] == 0) {
+            continue;
+        }
+        NSString *value = @"";
+        if ([nameAndValue count] > 1) {
+            value = [nameAndValue[1] stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@" \t\""]];
+        }
+        directives[name] = value;
+    }
+    return directives;
+}
+
++ (NSString *)valueOfHeader:(NSString *)name inHeaders:(NSDictionary *)headers {
+    for (NSString *key in headers) {
+        if ([key caseInsensitiveCompare:name] == NSOrderedSame) {
+            return headers[key];
+        }
+    }
+    return nil;
+}
+
++ (NSDictionary<NSString *, NSString *> *)conditionalHeadersForResponse:(AWSAPIGatewayResponse *)cachedResponse {
+    NSMutableDictionary<NSString *, NSString *> *conditionalHeaders = [NSMutableDictionary new];
+    conditionalHeaders[@"If-None-Match"] = [self valueOfHeader:@"ETag" inHeaders:cachedResponse.headers];
+    conditionalHeaders[@"If-Modified-Since"] = [self valueOfHeader:@"Last-Modified" inHeaders:cachedResponse.headers];
+    return conditionalHeaders;
+}
+
+/**
+ Returns the response in the form it is stored, or `nil` if it must not be stored or could never be served from the
+ cache.
+ */
++ (NSDictionary *)storedResponseWithURL:(NSURL *)URL headers:(NSDictionary *)headers data:(NSData *)data {
+    NSDictionary<NSString *, NSString *> *directives = [self cacheControlDirectives:[self valueOfHeader:@"Cache-Control" inHeaders:headers]];
+    if (directives[@"no-store"] || !URL) {
+        return nil;
+    }
+
+    NSTimeInterval maxAge = -1;
+    if (directives[@"max-age"]) {
+        maxAge = [directives[@"max-age"] doubleValue];
+    } else {
+        NSString *expires = [self valueOfHeader:@"Expires" inHeaders:headers];
+        NSDate *expirationDate = expires ? [NSDate aws_dateFromString:expires] : nil;
+        if (expirationDate) {
+            maxAge = [expirationDate timeIntervalSinceNow];
+        }
+    }
+    BOOL revalidate = directives[@"no-cache"] != nil;
+    BOOL hasValidators = [self valueOfHeader:@"ETag" inHeaders:headers] || [self valueOfHeader:@"Last-Modified" inHeaders:headers];
+    if ((maxAge <= 0 || revalidate) && !hasValidators) {
+        return nil;
+    }
+
+    NSMutableDictionary<NSString *, NSString *> *stringHeaders = [NSMutableDictionary new];
+    for (id key in headers) {
+        if ([key isKindOfClass:[NSString class]] && [headers[key] isKindOfClass:[NSString class]]) {
+            stringHeaders[key] = headers[key];
+        }
+    }
+    return @{AWSAPIGatewayCachedURLKey: [URL absoluteString],
+             AWSAPIGatewayCachedHeadersKey: stringHeaders,
+             AWSAPIGatewayCachedDataKey: data ?: [NSData data],
+             AWSAPIGatewayCachedDateKey: [NSDate date],
+             AWSAPIGatewayCachedMaxAgeKey: @(maxAge),
+             AWSAPIGatewayCachedRevalidateKey: @(revalidate)};
+}
+
++ (AWSAPIGatewayResponse *)responseWithStoredResponse:(NSDictionary *)storedResponse {
+    NSDictionary *headers = storedResponse[AWSAPIGatewayCachedHeadersKey];
+    NSHTTPURLResponse *HTTPResponse = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:storedResponse[AWSAPIGatewayCachedURLKey]]
+                                                                  statusCode:200
+                                                                 HTTPVersion:@"HTTP/1.1"
+                                                                headerFields:headers];
+    return [[AWSAPIGatewayResponse alloc] initWithHeaders:headers
+                                             responseData:storedResponse[AWSAPIGatewayCachedDataKey]
+                                      NSURLResponseObject:HTTPResponse
+                                               statusCode:200];
+}
+
+- (AWSAPIGatewayResponse *)cachedResponseForKey:(NSString *)key fresh:(BOOL *)fresh {
+    NSDictionary *storedResponse = [self storedResponseForKey:key];
+    if (!storedResponse) {
+        return nil;
+    }
+    if (fresh) {
+        NSTimeInterval age = -[storedResponse[AWSAPIGatewayCachedDateKey] timeIntervalSinceNow];
+        *fresh = ![storedResponse[AWSAPIGatewayCachedRevalidateKey] boolValue]
+            && age < [storedResponse[AWSAPIGatewayCachedMaxAgeKey] doubleValue];
+    }
+    return [AWSAPIGatewayResponseCache responseWithStoredResponse:storedResponse];
+}
+
+- (AWSAPIGatewayResponse *)storeResponse:(AWSAPIGatewayResponse *)response
+                    revalidatingResponse:(AWSAPIGatewayResponse *)cachedResponse
+                                  forKey:(NSString *)key {
+    NSURL *URL = response.rawResponse.URL;
+    if (response.statusCode == 304 && cachedResponse) {
+        // The stored body is still valid. The headers of the 304 response replace the stored ones, except those
+        // describing the body.
+        NSMutableDictionary *headers = [cachedResponse.headers mutableCopy];
+        for (NSString *name in response.headers) {
+            if ([name caseInsensitiveCompare:@"Content-Length"] != NSOrderedSame
+                && [name caseInsensitiveCompare:@"Content-Type"] != NSOrderedSame
+                && [name caseInsensitiveCompare:@"Content-Encoding"] != NSOrderedSame) {
+                for (NSString *storedName in [headers allKeys]) {
+                    if ([storedName caseInsensitiveCompare:name] == NSOrderedSame) {
+                        [headers removeObjectForKey:storedName];
+                    }
+                }
+                headers[name] = response.headers[name];
+            }
+        }
+        NSDictionary *storedResponse = [AWSAPIGatewayResponseCache storedResponseWithURL:URL ?: cachedResponse.rawResponse.URL
+                                                                                 headers:headers
+                                                                                    data:cachedResponse.responseData];
+        if (storedResponse) {
+            [self setStoredResponse:storedResponse forKey:key];
+            return [AWSAPIGatewayResponseCache responseWithStoredResponse:storedResponse];
+        }
+        [self removeStoredResponseForKey:key];
+        return [[AWSAPIGatewayResponse alloc] initWithHeaders:headers
+                                                 responseData:cachedResponse.responseData
+                                          NSURLResponseObject:cachedResponse.rawResponse
+                                                   statusCode:cachedResponse.statusCode];
+    }
+
+    if (response.statusCode == 200) {
+        NSDictionary *storedResponse = [AWSAPIGatewayResponseCache storedResponseWithURL:URL
+                                                                                 headers:response.headers
+                                                                                    data:response.responseData];
+        if (storedResponse) {
+            [self setStoredResponse:storedResponse forKey:key];
+        } else {
+            [self removeStoredResponseForKey:key];
+        }
+    }
+    return response;
+}
+
+#pragma mark - Storage
+
+- (NSURL *)fileURLForKey:(NSString *)key {
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char hash[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(keyData.bytes, (CC_LONG)keyData.length, hash);
+    NSMutableString *fileName = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [fileName appendFormat:@"%02x", hash[i]];
+    }
+    return [self.directoryURL URLByAppendingPathComponent:fileName];
+}
+
+- (NSDictionary *)storedResponseForKey:(NSString *)key {
+    NSDictionary *storedResponse = [self.memoryCache objectForKey:key];
+    if (storedResponse || self.diskCapacity == 0) {
+        return storedResponse;
+    }
+
+    __block NSData *data = nil;
+    dispatch_sync(self.diskQueue, ^{
+        data = [NSData dataWithContentsOfURL:[self fileURLForKey:key]];
+    });
+    if (!data) {
+        return nil;
+    }
+    storedResponse = [NSPropertyListSerialization propertyListWithData:data
+                                                               options:NSPropertyListImmutable
+                                                                format:NULL
+                                                                 error:nil];
+    if (![storedResponse isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    [self.memoryCache setObject:storedResponse forKey:key cost:[storedResponse[AWSAPIGatewayCachedDataKey] length]];
+    return storedResponse;
+}
+
+- (void)setStoredResponse:(NSDictionary *)storedResponse forKey:(NSString *)key {
+    NSUInteger cost = [storedResponse[AWSAPIGatewayCachedDataKey] length];
+    if (cost <= self.memoryCapacity) {
+        [self.memoryCache setObject:storedResponse forKey:key cost:cost];
+    }
+    if (self.diskCapacity == 0) {
+        return;
+    }
+
+    NSError *error = nil;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:storedResponse
+                                                              format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0
+                                                               error:&error];
+    if (!data) {
+        AWSDDLogError(@"Failed to serialize a response for the cache. %@", error);
+        return;
+    }
+    if ([data length] > self.diskCapacity) {
+        return;
+    }
+    dispatch_async(self.diskQueue, ^{
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        [fileManager createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+        NSURL *fileURL = [self fileURLForKey:key];
+        [self readDiskUsageIfNeeded];
+        NSNumber *previousSize = nil;
+        [fileURL getResourceValue:&previousSize forKey:NSURLFileSizeKey error:nil];
+        NSError *writeError = nil;
+        if (![data writeToURL:fileURL options:NSDataWritingAtomic error:&writeError]) {
+            AWSDDLogError(@"Failed to write a response to the cache. %@", writeError);
+            return;
+        }
+        self.diskUsage += (long long)[data length] - [previousSize longLongValue];
+        [self trimDiskIfNeeded];
+    });
+}
+
+- (void)removeStoredResponseForKey:(NSString *)key {
+    if (![self.memoryCache objectForKey:key] && self.diskCapacity == 0) {
+        return;
+    }
+    [self.memoryCache removeObjectForKey:key];
+    dispatch_async(self.diskQueue, ^{
+        NSURL *fileURL = [self fileURLForKey:key];
+        NSNumber *size = nil;
+        if ([fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil]
+            && [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil]
+            && self.diskUsage >= 0) {
+            self.diskUsage -= [size longLongValue];
+        }
+    });
+}
+
+// Called on diskQueue.
+- (void)readDiskUsageIfNeeded {
+    if (self.diskUsage >= 0) {
+        return;
+    }
+    long long diskUsage = 0;
+    for (NSURL *fileURL in [[NSFileManager defaultManager] contentsOfDirectoryAtURL:self.directoryURL
+                                                         includingPropertiesForKeys:@[NSURLFileSizeKey]
+                                                                            options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                              error:nil]) {
+        NSNumber *size = nil;
+        [fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+        diskUsage += [size longLongValue];
+    }
+    self.diskUsage = diskUsage;
+}
+
+// Called on diskQueue. Removes the least recently written responses until the cache fits its capacity.
+- (void)trimDiskIfNeeded {
+    if (self.diskUsage <= (long long)self.diskCapacity) {
+        return;
+    }
+    NSArray<NSURLResourceKey> *keys = @[NSURLFileSizeKey, NSURLContentModificationDateKey];
+    NSMutableArray<NSURL *> *fileURLs = [[[NSFileManager defaultManager] contentsOfDirectoryAtURL:self.directoryURL
+                                                                       includingPropertiesForKeys:keys
+                                                                                          options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                            error:nil] mutableCopy];
+    [fileURLs sortUsingComparator:^NSComparisonResult(NSURL *fileURL1, NSURL *fileURL2) {
+        NSDate *date1 = nil;
+        NSDate *date2 = nil;
+        [fileURL1 getResourceValue:&date1 forKey:NSURLContentModificationDateKey error:nil];
+        [fileURL2 getResourceValue:&date2 forKey:NSURLContentModificationDateKey error:nil];
+        return [date1 compare:date2];
+    }];
+    for (NSURL *fileURL in fileURLs) {
+        if (self.diskUsage <= (long long)self.diskCapacity) {
+            break;
+        }
+        NSNumber *size = nil;
+        [fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+        if ([[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil]) {
+            self.diskUsage -= [size longLongValue];
+        }
+    }
+}
+
+@end
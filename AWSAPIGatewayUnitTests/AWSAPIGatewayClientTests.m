@@ -0,0 +1,381 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSAPIGateway.h"
+
+typedef NSData *(^AWSAPIGatewayStandInHandler)(NSURLRequest *request, NSInteger *statusCode, NSDictionary<NSString *, NSString *> **headers);
+
+static AWSAPIGatewayStandInHandler _standInHandler = nil;
+static NSTimeInterval _standInLatency = 0;
+static NSInteger _standInRequestCount = 0;
+static NSMutableArray<NSURLRequest *> *_standInRequests = nil;
+
+/**
+ Stands in for an API Gateway endpoint, answering requests with `_standInHandler` after `_standInLatency`.
+ */
+@interface AWSAPIGatewayStandInURLProtocol : NSURLProtocol
+
+@end
+
+@implementation AWSAPIGatewayStandInURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    return [request.URL.host isEqualToString:@"standin.test"];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    return request;
+}
+
+- (void)startLoading {
+    @synchronized([AWSAPIGatewayStandInURLProtocol class]) {
+        _standInRequestCount++;
+        [_standInRequests addObject:self.request];
+    }
+    NSThread *thread = [NSThread currentThread];
+    NSString *mode = [[NSRunLoop currentRunLoop] currentMode] ?: NSDefaultRunLoopMode;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_standInLatency * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        [self performSelector:@selector(respond) onThread:thread withObject:nil waitUntilDone:NO modes:@[mode]];
+    });
+}
+
+- (void)respond {
+    NSInteger statusCode = 200;
+    NSDictionary<NSString *, NSString *> *headers = @{};
+    NSData *data = _standInHandler(self.request, &statusCode, &headers);
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                              statusCode:statusCode
+                                                             HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:headers];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    if (data) {
+        [self.client URLProtocol:self didLoadData:data];
+    }
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading {
+}
+
+@end
+
+@interface AWSAPIGatewayClient()
+
+@property (nonatomic, strong) NSURLSession *session;
+
+@end
+
+/**
+ Provides fixed credentials for an identity that can be switched, as `AWSCognitoCredentialsProvider` does on sign in.
+ */
+@interface AWSAPIGatewayTestCredentialsProvider : NSObject <AWSCredentialsProvider>
+
+@property (atomic, strong, nullable) NSString *identityId;
+
+@end
+
+@implementation AWSAPIGatewayTestCredentialsProvider
+
+- (AWSTask<AWSCredentials *> *)credentials {
+    return [AWSTask taskWithResult:[[AWSCredentials alloc] initWithAccessKey:@"accessKey"
+                                                                   secretKey:@"secretKey"
+                                                                  sessionKey:nil
+                                                                  expiration:nil]];
+}
+
+- (void)invalidateCachedTemporaryCredentials {
+}
+
+@end
+
+@interface AWSAPIGatewayClientTests : XCTestCase
+
+@property (nonatomic, strong) NSURL *cacheDirectoryURL;
+
+@end
+
+@implementation AWSAPIGatewayClientTests
+
+- (void)setUp {
+    [super setUp];
+    _standInLatency = 0;
+    _standInRequestCount = 0;
+    _standInRequests = [NSMutableArray new];
+    _standInHandler = ^NSData *(NSURLRequest *request, NSInteger *statusCode, NSDictionary **headers) {
+        return [@"{}" dataUsingEncoding:NSUTF8StringEncoding];
+    };
+    self.cacheDirectoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.cacheDirectoryURL error:nil];
+    [super tearDown];
+}
+
+- (AWSAPIGatewayClient *)client {
+    AWSAPIGatewayClient *client = [AWSAPIGatewayClient new];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUnknown
+                                                                         credentialsProvider:nil];
+    configuration.baseURL = [NSURL URLWithString:@"https://standin.test"];
+    client.configuration = configuration;
+
+    NSURLSessionConfiguration *sessionConfiguration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    sessionConfiguration.protocolClasses = @[[AWSAPIGatewayStandInURLProtocol class]];
+    client.session = [NSURLSession sessionWithConfiguration:sessionConfiguration];
+    client.retryHandler = [[AWSAPIGatewayRetryHandler alloc] initWithMaximumRetryCount:2];
+    return client;
+}
+
+- (AWSAPIGatewayResponse *)invoke:(AWSAPIGatewayClient *)client method:(NSString *)HTTPMethod {
+    AWSAPIGatewayRequest *request = [[AWSAPIGatewayRequest alloc] initWithHTTPMethod:HTTPMethod
+                                                                           URLString:@"/items"
+                                                                     queryParameters:nil
+                                                                    headerParameters:@{@"Accept": @"application/json"}
+                                                                            HTTPBody:nil];
+    AWSTask<AWSAPIGatewayResponse *> *task = [client invoke:request];
+    [task waitUntilFinished];
+    XCTAssertNil(task.error);
+    return task.result;
+}
+
+- (void)testRetriesServerErrorsOfIdempotentRequests {
+    _standInHandler = ^NSData *(NSURLRequest *request, NSInteger *statusCode, NSDictionary **headers) {
+        *statusCode = _standInRequestCount < 3 ? 503 : 200;
+        *headers = @{@"Retry-After": @"0"};
+        return nil;
+    };
+    AWSAPIGatewayClient *client = [self client];
+
+    XCTAssertEqual([self invoke:client method:@"GET"].statusCode, 200);
+    XCTAssertEqual(_standInRequestCount, 3);
+
+    _standInRequestCount = 0;
+    XCTAssertEqual([self invoke:client method:@"POST"].statusCode, 503);
+    XCTAssertEqual(_standInRequestCount, 1);
+}
+
+- (void)testRetriesThrottledRequests {
+    _standInHandler = ^NSData *(NSURLRequest *request, NSInteger *statusCode, NSDictionary **headers) {
+        *statusCode = 429;
+        *headers = @{@"Retry-After": @"0"};
+        return nil;
+    };
+    AWSAPIGatewayClient *client = [self client];
+
+    XCTAssertEqual([self invoke:client method:@"POST"].statusCode, 429);
+    XCTAssertEqual(_standInRequestCount, 3);
+
+    XCTAssertTrue([[[AWSAPIGatewayClient new] retryHandler] isKindOfClass:[AWSAPIGatewayRetryHandler class]]);
+}
+
+- (void)testRevalidatesCachedResponses {
+    _standInHandler = ^NSData *(NSURLRequest *request, NSInteger *statusCode, NSDictionary **headers) {
+        *headers = @{@"ETag": @"\"v1\"", @"Cache-Control": @"max-age=0"};
+        if ([[request valueForHTTPHeaderField:@"If-None-Match"] isEqualToString:@"\"v1\""]) {
+            *statusCode = 304;
+            return nil;
+        }
+        return [@"{\"a\":1}" dataUsingEncoding:NSUTF8StringEncoding];
+    };
+    AWSAPIGatewayClient *client = [self client];
+    client.responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:1024 * 1024
+                                                                          diskCapacity:1024 * 1024
+                                                                          directoryURL:self.cacheDirectoryURL];
+
+    XCTAssertEqualObjects([self invoke:client method:@"GET"].responseData, [@"{\"a\":1}" dataUsingEncoding:NSUTF8StringEncoding]);
+    AWSAPIGatewayResponse *response = [self invoke:client method:@"GET"];
+    XCTAssertEqual(response.statusCode, 200);
+    XCTAssertEqualObjects(response.responseData, [@"{\"a\":1}" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertEqual(_standInRequestCount, 2);
+    XCTAssertNil([_standInRequests[0] valueForHTTPHeaderField:@"If-None-Match"]);
+    XCTAssertEqualObjects([_standInRequests[1] valueForHTTPHeaderField:@"If-None-Match"], @"\"v1\"");
+    XCTAssertEqualObjects([_standInRequests[0] valueForHTTPHeaderField:@"Cache-Control"], @"no-store");
+    XCTAssertEqualObjects([_standInRequests[1] valueForHTTPHeaderField:@"Cache-Control"], @"no-store");
+}
+
+- (void)testServesFreshResponsesFromMemoryAndDisk {
+    _standInHandler = ^NSData *(NSURLRequest *request, NSInteger *statusCode, NSDictionary **headers) {
+        *headers = @{@"Cache-Control": @"max-age=60"};
+        return [@"[1,2,3]" dataUsingEncoding:NSUTF8StringEncoding];
+    };
+    AWSAPIGatewayClient *client = [self client];
+    client.responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:1024 * 1024
+                                                                          diskCapacity:1024 * 1024
+                                                                          directoryURL:self.cacheDirectoryURL];
+    [self invoke:client method:@"GET"];
+    [self invoke:client method:@"GET"];
+    XCTAssertEqual(_standInRequestCount, 1);
+
+    // A new cache reads the response written to disk.
+    client.responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:1024 * 1024
+                                                                          diskCapacity:1024 * 1024
+                                                                          directoryURL:self.cacheDirectoryURL];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"disk"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqualObjects([self invoke:client method:@"GET"].responseData, [@"[1,2,3]" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertEqual(_standInRequestCount, 1);
+
+    // Responses to other methods, and no-store responses, are not stored.
+    [self invoke:client method:@"POST"];
+    [self invoke:client method:@"POST"];
+    XCTAssertEqual(_standInRequestCount, 3);
+
+    [client.responseCache removeAllResponses];
+    _standInHandler = ^NSData *(NSURLRequest *request, NSInteger *statusCode, NSDictionary **headers) {
+        *headers = @{@"Cache-Control": @"no-store", @"ETag": @"\"v1\""};
+        return [NSData data];
+    };
+    [self invoke:client method:@"GET"];
+    [self invoke:client method:@"GET"];
+    XCTAssertEqual(_standInRequestCount, 5);
+}
+
+- (void)testCachesResponsesPerIdentity {
+    _standInHandler = ^NSData *(NSURLRequest *request, NSInteger *statusCode, NSDictionary **headers) {
+        *headers = @{@"Cache-Control": @"max-age=60"};
+        return [@"[1,2,3]" dataUsingEncoding:NSUTF8StringEncoding];
+    };
+    AWSAPIGatewayTestCredentialsProvider *credentialsProvider = [AWSAPIGatewayTestCredentialsProvider new];
+    AWSAPIGatewayClient *client = [self client];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:credentialsProvider];
+    configuration.baseURL = client.configuration.baseURL;
+    AWSEndpoint *endpoint = [[AWSEndpoint alloc] initWithRegion:AWSRegionUSEast1
+                                                    serviceName:@"execute-api"
+                                                            URL:configuration.baseURL];
+    configuration.requestInterceptors = @[[AWSNetworkingRequestInterceptor new],
+                                          [[AWSSignatureV4Signer alloc] initWithCredentialsProvider:credentialsProvider
+                                                                                           endpoint:endpoint]];
+    client.configuration = configuration;
+    client.responseCache = [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:1024 * 1024
+                                                                          diskCapacity:0
+                                                                          directoryURL:nil];
+
+    credentialsProvider.identityId = @"us-east-1:a";
+    [self invoke:client method:@"GET"];
+    [self invoke:client method:@"GET"];
+    XCTAssertEqual(_standInRequestCount, 1);
+
+    credentialsProvider.identityId = @"us-east-1:b";
+    [self invoke:client method:@"GET"];
+    XCTAssertEqual(_standInRequestCount, 2);
+
+    credentialsProvider.identityId = @"us-east-1:a";
+    [self invoke:client method:@"GET"];
+    XCTAssertEqual(_standInRequestCount, 2);
+
+    // Nothing is cached until the identity is known.
+    credentialsProvider.identityId = nil;
+    [self invoke:client method:@"GET"];
+    [self invoke:client method:@"GET"];
+    XCTAssertEqual(_standInRequestCount, 4);
+}
+
+- (void)testCoalescesIdenticalGETRequests {
+    _standInLatency = 0.2;
+    AWSAPIGatewayClient *client = [self client];
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    for (int i = 0; i < 10; i++) {
+        [tasks addObject:[client invoke:[[AWSAPIGatewayRequest alloc] initWithHTTPMethod:@"GET"
+                                                                               URLString:@"/items"
+                                                                         queryParameters:nil
+                                                                        headerParameters:nil
+                                                                                HTTPBody:nil]]];
+    }
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+    XCTAssertEqual(_standInRequestCount, 1);
+    for (AWSTask<AWSAPIGatewayResponse *> *task in tasks) {
+        XCTAssertEqual(task.result.statusCode, 200);
+    }
+
+    // A different query is a different request.
+    _standInRequestCount = 0;
+    tasks = [NSMutableArray new];
+    for (int i = 0; i < 2; i++) {
+        [tasks addObject:[client invoke:[[AWSAPIGatewayRequest alloc] initWithHTTPMethod:@"GET"
+                                                                               URLString:@"/items"
+                                                                         queryParameters:@{@"page": @(i)}
+                                                                        headerParameters:nil
+                                                                                HTTPBody:nil]]];
+    }
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+    XCTAssertEqual(_standInRequestCount, 2);
+
+    _standInRequestCount = 0;
+    client.coalescesIdenticalRequests = NO;
+    tasks = [NSMutableArray new];
+    for (int i = 0; i < 3; i++) {
+        [tasks addObject:[client invoke:[[AWSAPIGatewayRequest alloc] initWithHTTPMethod:@"GET"
+                                                                               URLString:@"/items"
+                                                                         queryParameters:nil
+                                                                        headerParameters:nil
+                                                                                HTTPBody:nil]]];
+    }
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+    XCTAssertEqual(_standInRequestCount, 3);
+}
+
+#pragma mark - Performance
+
+/*
+ * Sends bursts of identical GET requests to a stand-in endpoint answering in 20 ms, as screens refreshing the same
+ * resource do.
+ */
+- (void)measureRepeatedRequestsWithCache:(BOOL)cache {
+    _standInLatency = 0.02;
+    _standInHandler = ^NSData *(NSURLRequest *request, NSInteger *statusCode, NSDictionary **headers) {
+        *headers = @{@"Cache-Control": @"max-age=60", @"ETag": @"\"v1\""};
+        NSMutableArray *items = [NSMutableArray new];
+        for (int i = 0; i < 100; i++) {
+            [items addObject:@{@"id": @(i), @"name": [NSString stringWithFormat:@"item %d", i]}];
+        }
+        return [NSJSONSerialization dataWithJSONObject:items options:0 error:nil];
+    };
+    AWSAPIGatewayClient *client = [self client];
+    client.coalescesIdenticalRequests = cache;
+
+    [self measureBlock:^{
+        _standInRequestCount = 0;
+        client.responseCache = cache ? [[AWSAPIGatewayResponseCache alloc] initWithMemoryCapacity:1024 * 1024
+                                                                                     diskCapacity:0
+                                                                                     directoryURL:nil] : nil;
+        for (int burst = 0; burst < 10; burst++) {
+            NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+            for (int i = 0; i < 5; i++) {
+                [tasks addObject:[client invoke:[[AWSAPIGatewayRequest alloc] initWithHTTPMethod:@"GET"
+                                                                                       URLString:@"/items"
+                                                                                 queryParameters:nil
+                                                                                headerParameters:nil
+                                                                                        HTTPBody:nil]]];
+            }
+            [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+        }
+        NSLog(@"Requests sent (%@): %ld", cache ? @"cached" : @"uncached", (long)_standInRequestCount);
+    }];
+}
+
+- (void)testRepeatedRequestsPerformance {
+    [self measureRepeatedRequestsWithCache:NO];
+}
+
+- (void)testRepeatedRequestsWithCachePerformance {
+    [self measureRepeatedRequestsWithCache:YES];
+}
+
+@end
@@ -97,6 +97,7 @@ static const NSString * AWSCognitoAuthUserRefreshToken = @"refreshToken";  //Con
 static const NSString * AWSCognitoAuthUserScopes = @"scopes";
 static const NSString * AWSCognitoAuthUserTokenExpiration = @"tokenExpiration";  //Consistent with AWSCognitoIdentityUserPool name
 static NSString * AWSCognitoAuthUserPoolCurrentUser = @"currentUser";  //Consistent with AWSCognitoIdentityUserPool name
+static NSString *const AWSCognitoAuthKeychainDidChangeNotification = @"com.amazonaws.AWSCognitoIdentityUserPool.KeychainDidChange";  //Consistent with AWSCognitoIdentityUserPool name
 static NSString *const AWSCognitoAuthAppClientIdLegacy = @"CognitoUserPoolAppClientId";  //Consistent with AWSCognitoIdentityUserPool name
 static NSString *const AWSCognitoAuthAppClientSecretLegacy = @"CognitoUserPoolAppClientSecret";  //Consistent with AWSCognitoIdentityUserPool name
 static NSString *const AWSCognitoAuthAppClientId = @"AppClientId";  //Consistent with AWSCognitoIdentityUserPool name
@@ -713,6 +714,7 @@ withPresentingViewController:(UIViewController *)presentingViewController {
                 [self.keychain removeItemForKey:key];
             }
         }
+        [self keychainDidChange];
     }
 }
 
@@ -1034,12 +1036,14 @@ withPresentingViewController:(UIViewController *)presentingViewController {
 
 - (void) setCurrentUser:(NSString *) username {
     self.keychain[[self currentUserKey]] = username;
+    [self keychainDidChange];
 }
 
 - (void) clearLastKnownUser {
     NSString * currentUserKey = [self currentUserKey];
     if(currentUserKey){
         [self.keychain removeItemForKey:[self currentUserKey]];
+        [self keychainDidChange];
     }
 }
 
@@ -1054,6 +1058,14 @@ withPresentingViewController:(UIViewController *)presentingViewController {
             [self.keychain removeItemForKey:key];
         }
     }
+    [self keychainDidChange];
+}
+
+/**
+ Tell AWSCognitoIdentityUserPool, which caches the session items it shares with this class, that they changed
+ */
+- (void) keychainDidChange {
+    [[NSNotificationCenter defaultCenter] postNotificationName:AWSCognitoAuthKeychainDidChangeNotification object:nil];
 }
 
 - (NSString *) keyChainNamespaceClientId:(NSString *)username {
@@ -186,23 +186,48 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
 }
 
 - (BOOL) isSessionValid:(AWSCognitoIdentityUserSession * _Nonnull)session {
+    return [self isSessionValid:session forInterval:2 * 60];
+}
+
+- (BOOL) isSessionValid:(AWSCognitoIdentityUserSession * _Nonnull)session forInterval:(NSTimeInterval)interval {
     // If id token is not present we only need to check the accessToken to determine the validity of the token.
     if (!session.idToken) {
-        return [self isTokenValid:session.accessToken];
+        return [self isTokenValid:session.accessToken forInterval:interval];
     } else {
-        return [self isTokenValid:session.accessToken] && [self isTokenValid:session.idToken];
+        return [self isTokenValid:session.accessToken forInterval:interval] && [self isTokenValid:session.idToken forInterval:interval];
     }
     return false;
 }
 
+// The pool's refresh lead time, at most half the lifetime of the session's tokens. Short-lived tokens would otherwise
+// be refreshed on every call to getSession.
+- (NSTimeInterval) sessionRefreshLeadTimeForSession:(AWSCognitoIdentityUserSession * _Nonnull)session {
+    NSTimeInterval leadTime = self.pool.sessionRefreshLeadTime;
+    for (AWSCognitoIdentityUserSessionToken *token in @[session.accessToken ?: [NSNull null], session.idToken ?: [NSNull null]]) {
+        if ([token isKindOfClass:[NSNull class]]) {
+            continue;
+        }
+        id expiry = [token.tokenClaims valueForKey:@"exp"];
+        id issuedAt = [token.tokenClaims valueForKey:@"iat"];
+        if (expiry && issuedAt) {
+            NSTimeInterval lifetime = [expiry doubleValue] - [issuedAt doubleValue];
+            leadTime = MIN(leadTime, MAX(lifetime, 0) / 2);
+        }
+    }
+    return leadTime;
+}
+
 // Check if the token is valid or not. Returns true if the token is valid.
 //
 // The token is consider invalid if the token expiry is less than or equal to 2 min. This 2 minute buffer is
 // given so that we do not hand over a token to the user which will get expired immediately. This guarrantees that the
 // returned session tokens are valid for atleast 2 min.
 - (BOOL) isTokenValid:(AWSCognitoIdentityUserSessionToken * _Nonnull)token {
+    return [self isTokenValid:token forInterval:2 * 60];
+}
+
+- (BOOL) isTokenValid:(AWSCognitoIdentityUserSessionToken * _Nonnull)token forInterval:(NSTimeInterval)expiryWindow {
     if ([token.tokenClaims valueForKey:@"exp"]) {
-        int expiryWindow = 2 * 60;
         NSTimeInterval expiryInterval = [[token.tokenClaims valueForKey:@"exp"] doubleValue];
         NSDate *tokenExpiration =  [NSDate dateWithTimeIntervalSince1970:expiryInterval];
         return (tokenExpiration &&
@@ -213,13 +238,15 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
 
 /**
  Get a session
+ 
+ Tokens are read through the pool's in-memory session cache, so only the first call for a user reads the keychain.
  */
 -(AWSTask<AWSCognitoIdentityUserSession*> *) getSession {
     
     //check to see if we have valid tokens
     __block NSString * keyChainNamespace = [self keyChainNamespaceClientId];
     NSString * expirationTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserTokenExpiration];
-    NSString * expirationDate = self.pool.keychain[expirationTokenKey];
+    NSString * expirationDate = [self.pool sessionStringForKey:expirationTokenKey];
     
     if(expirationDate){
         NSDate *expiration = [NSDate aws_dateFromString:expirationDate format:AWSDateISO8601DateFormat1];
@@ -231,8 +258,8 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
         NSString * accessTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserAccessToken];
         NSString * idTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserIdToken];
         
-        NSString * idToken = self.pool.keychain[idTokenKey];
-        NSString * accessToken = self.pool.keychain[accessTokenKey];
+        NSString * idToken = [self.pool sessionStringForKey:idTokenKey];
+        NSString * accessToken = [self.pool sessionStringForKey:accessTokenKey];
         
         AWSCognitoIdentityUserSession * session;
         
@@ -249,55 +276,77 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
         if(session
            && [self isSessionValid:session]
            && [expiration compare:[NSDate dateWithTimeIntervalSinceNow:2 * 60]] == NSOrderedDescending) {
+            // Start refreshing a session that expires soon, callers keep getting it until the new one is stored.
+            NSTimeInterval leadTime = [self sessionRefreshLeadTimeForSession:session];
+            if(refreshToken
+               && leadTime > 2 * 60
+               && (![self isSessionValid:session forInterval:leadTime]
+                   || [expiration compare:[NSDate dateWithTimeIntervalSinceNow:leadTime]] != NSOrderedDescending)) {
+                [self refreshSession:refreshToken aheadOfExpiry:YES];
+            }
             return [AWSTask taskWithResult:session];
         }
         //else refresh it using the refresh token
         else if(refreshToken){
-            AWSCognitoIdentityProviderInitiateAuthRequest * request = [AWSCognitoIdentityProviderInitiateAuthRequest new];
-            request.authFlow = AWSCognitoIdentityProviderAuthFlowTypeRefreshTokenAuth;
-            request.clientId = self.pool.userPoolConfiguration.clientId;
-            request.analyticsMetadata = [self.pool analyticsMetadata];
-            request.userContextData = [self.pool userContextData:self.username deviceId: [self asfDeviceId]];
-            
-            NSMutableDictionary * authParameters = [[NSMutableDictionary alloc] initWithDictionary:@{@"REFRESH_TOKEN" : refreshToken}];
-            
-            //refresh token secret hash is actually client secret for this api, set it if it is supplied
-            if(self.pool.userPoolConfiguration.clientSecret != nil){
-                [authParameters setObject:self.pool.userPoolConfiguration.clientSecret forKey:@"SECRET_HASH"];
-            }
-            
-            [self addDeviceKey:authParameters];
-            
-            request.authParameters = authParameters;
-            return [[self.pool.client initiateAuth:request] continueWithBlock:^id _Nullable(AWSTask<AWSCognitoIdentityProviderInitiateAuthResponse *> * _Nonnull task) {
-                if(task.error){
-                    //If this token is no longer valid, fall back on interactive auth.
-                    if(task.error.code == AWSCognitoIdentityProviderErrorNotAuthorized) {
-                        return [self interactiveAuth];
-                    } else {
-                        return task;
-                    }
+            return [[self refreshSession:refreshToken aheadOfExpiry:NO] continueWithBlock:^id _Nullable(AWSTask<AWSCognitoIdentityUserSession *> * _Nonnull task) {
+                //If this token is no longer valid, fall back on interactive auth.
+                if(task.error && task.error.code == AWSCognitoIdentityProviderErrorNotAuthorized) {
+                    return [self interactiveAuth];
                 }
-                
-                AWSCognitoIdentityProviderInitiateAuthResponse *response = task.result;
-                AWSCognitoIdentityProviderAuthenticationResultType *authResult = response.authenticationResult;
-                /** Check to see if refreshToken is received in the response.
-                 If not, load it from the keychain.
-                 */
-                NSString * refreshToken = authResult.refreshToken;
-                if (refreshToken == nil){
-                    NSString * keyChainNamespace = [self keyChainNamespaceClientId];
-                    refreshToken = [self refreshTokenFromKeyChain:keyChainNamespace];
-                }
-                AWSCognitoIdentityUserSession * session = [[AWSCognitoIdentityUserSession alloc] initWithIdToken: authResult.idToken accessToken:authResult.accessToken refreshToken:refreshToken expiresIn:authResult.expiresIn];
-                [self updateUsernameAndPersistTokens:session];
-                return [AWSTask taskWithResult:session];
+                return task;
             }];
         }
     }
     return [self setConfirmationStatus: [self interactiveAuth]];
 }
 
+/**
+ Refresh the session with the refresh token. Concurrent refreshes of this user's session, from this or any other
+ user object, share one InitiateAuth call.
+ */
+- (AWSTask<AWSCognitoIdentityUserSession*> *) refreshSession:(NSString *) refreshToken aheadOfExpiry:(BOOL) aheadOfExpiry {
+    NSString * keyChainNamespace = [self keyChainNamespaceClientId];
+    return [self.pool coalescedSessionRefreshForKey:keyChainNamespace aheadOfExpiry:aheadOfExpiry refresh:^AWSTask * _Nonnull{
+        AWSCognitoIdentityProviderInitiateAuthRequest * request = [AWSCognitoIdentityProviderInitiateAuthRequest new];
+        request.authFlow = AWSCognitoIdentityProviderAuthFlowTypeRefreshTokenAuth;
+        request.clientId = self.pool.userPoolConfiguration.clientId;
+        request.analyticsMetadata = [self.pool analyticsMetadata];
+        request.userContextData = [self.pool userContextData:self.username deviceId: [self asfDeviceId]];
+        
+        NSMutableDictionary * authParameters = [[NSMutableDictionary alloc] initWithDictionary:@{@"REFRESH_TOKEN" : refreshToken}];
+        
+        //refresh token secret hash is actually client secret for this api, set it if it is supplied
+        if(self.pool.userPoolConfiguration.clientSecret != nil){
+            [authParameters setObject:self.pool.userPoolConfiguration.clientSecret forKey:@"SECRET_HASH"];
+        }
+        
+        [self addDeviceKey:authParameters];
+        
+        request.authParameters = authParameters;
+        return [[self.pool.client initiateAuth:request] continueWithBlock:^id _Nullable(AWSTask<AWSCognitoIdentityProviderInitiateAuthResponse *> * _Nonnull task) {
+            if(task.error){
+                if(aheadOfExpiry){
+                    AWSDDLogDebug(@"Refreshing the session ahead of expiry failed: %@", task.error);
+                }
+                return task;
+            }
+            
+            AWSCognitoIdentityProviderInitiateAuthResponse *response = task.result;
+            AWSCognitoIdentityProviderAuthenticationResultType *authResult = response.authenticationResult;
+            /** Check to see if refreshToken is received in the response.
+             If not, load it from the keychain.
+             */
+            NSString * refreshToken = authResult.refreshToken;
+            if (refreshToken == nil){
+                refreshToken = [self refreshTokenFromKeyChain:keyChainNamespace];
+            }
+            AWSCognitoIdentityUserSession * session = [[AWSCognitoIdentityUserSession alloc] initWithIdToken: authResult.idToken accessToken:authResult.accessToken refreshToken:refreshToken expiresIn:authResult.expiresIn];
+            [self updateUsernameAndPersistTokens:session];
+            return [AWSTask taskWithResult:session];
+        }];
+    }];
+}
+
 - (AWSTask<AWSCognitoIdentityUserSession*>*) getSession:(NSString *) username
                                                password:(NSString *) password
                                          validationData:(NSArray<AWSCognitoIdentityUserAttributeType*>*) validationData
@@ -1450,14 +1499,9 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
 
 -(void) signOut {
     if(self.username){
-        NSArray *keys = self.pool.keychain.allKeys;
+        //clear tokens associated with this user
         NSString *keyChainPrefix = [[self keyChainNamespaceClientId] stringByAppendingString:@"."];
-        for (NSString *key in keys) {
-            //clear tokens associated with this user
-            if([key hasPrefix:keyChainPrefix]){
-                [self.pool.keychain removeItemForKey:key];
-            }
-        }
+        [self.pool removeSessionItemsWithPrefix:keyChainPrefix];
     }
 }
 
@@ -1471,14 +1515,14 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
         NSString * keyChainNamespace = [self keyChainNamespaceClientId];
         NSString * idTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserIdToken];
         NSString * accessTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserAccessToken];
-        [self.pool.keychain removeItemForKey:idTokenKey];
-        [self.pool.keychain removeItemForKey:accessTokenKey];
+        [self.pool setSessionString:nil forKey:idTokenKey];
+        [self.pool setSessionString:nil forKey:accessTokenKey];
     }
 }
 
 - (NSString *) refreshTokenFromKeyChain: (NSString *) keyChainNamespace {
     NSString * refreshTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserRefreshToken];
-    NSString * refreshToken = self.pool.keychain[refreshTokenKey];
+    NSString * refreshToken = [self.pool sessionStringForKey:refreshTokenKey];
     return refreshToken;
 }
 
@@ -1495,7 +1539,7 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
 -(BOOL) isSessionRevocable {
     NSString * keyChainNamespace = [self keyChainNamespaceClientId];
     NSString * accessTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserAccessToken];
-    NSString * accessTokenString = self.pool.keychain[accessTokenKey];
+    NSString * accessTokenString = [self.pool sessionStringForKey:accessTokenKey];
     AWSCognitoIdentityUserSessionToken * accessToken = [[AWSCognitoIdentityUserSessionToken alloc] initWithToken:accessTokenString];
     return [accessToken.tokenClaims objectForKey:@"origin_jti"];
 }
@@ -1618,19 +1662,19 @@ static const NSString * AWSCognitoIdentityUserUserAttributePrefix = @"userAttrib
     NSString * keyChainNamespace = [self keyChainNamespaceClientId];
     if(session.idToken){
         NSString * idTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserIdToken];
-        self.pool.keychain[idTokenKey] = session.idToken.tokenString;
+        [self.pool setSessionString:session.idToken.tokenString forKey:idTokenKey];
     }
     if(session.accessToken){
         NSString * accessTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserAccessToken];
-        self.pool.keychain[accessTokenKey] = session.accessToken.tokenString;
+        [self.pool setSessionString:session.accessToken.tokenString forKey:accessTokenKey];
     }
     if(session.refreshToken){
         NSString * refreshTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserRefreshToken];
-        self.pool.keychain[refreshTokenKey] = session.refreshToken.tokenString;
+        [self.pool setSessionString:session.refreshToken.tokenString forKey:refreshTokenKey];
     }
     if(session.expirationTime){
         NSString * expirationTokenKey = [self keyChainKey:keyChainNamespace key:AWSCognitoIdentityUserTokenExpiration];
-        self.pool.keychain[expirationTokenKey] = [session.expirationTime aws_stringValue:AWSDateISO8601DateFormat1];
+        [self.pool setSessionString:[session.expirationTime aws_stringValue:AWSDateISO8601DateFormat1] forKey:expirationTokenKey];
     }
 }
 
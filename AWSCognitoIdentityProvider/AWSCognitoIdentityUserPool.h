@@ -20,6 +20,7 @@
 @class AWSCognitoIdentityMfaCodeDetails;
 @class AWSCognitoIdentitySoftwareMfaSetupRequiredDetails;
 @class AWSCognitoIdentitySelectMfaDetails;
+@class AWSCognitoIdentityUserPoolSessionMetrics;
 
 @protocol AWSCognitoIdentityInteractiveAuthenticationDelegate;
 @protocol AWSCognitoIdentityPasswordAuthentication;
@@ -43,6 +44,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) id <AWSCognitoIdentityInteractiveAuthenticationDelegate> delegate;
 
+/**
+ How long before a session expires `getSession` starts refreshing it in the background while still returning the
+ current tokens. Set to 0 to refresh only once the tokens are about to expire. The default is 5 minutes. At most half
+ the lifetime of the tokens is used, so short-lived tokens are not refreshed on every call.
+ */
+@property (nonatomic, assign) NSTimeInterval sessionRefreshLeadTime;
+
 /**
  *  Fetches the Cognito User Pool instance configured in the `info.plist` under `CognitoUserPool`
  *
@@ -105,6 +113,51 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void) clearAll;
 
+/**
+ Returns the keychain and token refresh counts of this user pool since it was created.
+ */
+- (AWSCognitoIdentityUserPoolSessionMetrics *)sessionMetrics;
+
+@end
+
+/**
+ A snapshot of how a user pool has loaded, stored and refreshed user sessions.
+
+ Session tokens are cached in memory in front of the keychain and written through to it, so repeated `getSession`
+ calls read the keychain once. Concurrent refreshes of the same user's session share a single InitiateAuth call.
+ */
+@interface AWSCognitoIdentityUserPoolSessionMetrics : NSObject
+
+/**
+ Keychain items read because they were not cached yet.
+ */
+@property (nonatomic, readonly) NSUInteger keychainReadCount;
+
+/**
+ Keychain items written or removed.
+ */
+@property (nonatomic, readonly) NSUInteger keychainWriteCount;
+
+/**
+ Reads answered from the in-memory cache.
+ */
+@property (nonatomic, readonly) NSUInteger cacheHitCount;
+
+/**
+ InitiateAuth calls made to refresh a session.
+ */
+@property (nonatomic, readonly) NSUInteger refreshCount;
+
+/**
+ Of `refreshCount`, the refreshes started ahead of expiry while the current tokens were still returned.
+ */
+@property (nonatomic, readonly) NSUInteger aheadOfExpiryRefreshCount;
+
+/**
+ Refreshes that joined one already in flight instead of calling InitiateAuth.
+ */
+@property (nonatomic, readonly) NSUInteger coalescedRefreshCount;
+
 @end
 
 @interface AWSCognitoIdentityUserPoolConfiguration : NSObject
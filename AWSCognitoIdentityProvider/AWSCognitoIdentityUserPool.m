@@ -15,6 +15,71 @@
 #import <AWSCognitoIdentityProviderASF/AWSCognitoIdentityProviderASF.h>
 
 static const NSString * AWSCognitoIdentityUserPoolCurrentUser = @"currentUser";
+static NSTimeInterval const AWSCognitoIdentityUserPoolDefaultSessionRefreshLeadTime = 5 * 60;
+// Posted by AWSCognitoAuth when it changes the session items it shares with the user pool in the keychain.
+static NSString *const AWSCognitoIdentityUserPoolKeychainDidChangeNotification = @"com.amazonaws.AWSCognitoIdentityUserPool.KeychainDidChange";
+
+// Session items cached in front of the keychain. Every pool in the app uses the same keychain service, so the cache and
+// the refreshes in flight are shared by all of them and keyed by service and item key.
+@interface AWSCognitoIdentityUserPoolSessionCache : NSObject
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *values;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSTask *> *pendingRefreshes;
+
++ (instancetype)sharedCache;
+
+@end
+
+@implementation AWSCognitoIdentityUserPoolSessionCache
+
++ (instancetype)sharedCache {
+    static AWSCognitoIdentityUserPoolSessionCache *_sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _sharedCache = [AWSCognitoIdentityUserPoolSessionCache new];
+        _sharedCache.values = [NSMutableDictionary new];
+        _sharedCache.pendingRefreshes = [NSMutableDictionary new];
+        [[NSNotificationCenter defaultCenter] addObserver:_sharedCache
+                                                 selector:@selector(keychainDidChange:)
+                                                     name:AWSCognitoIdentityUserPoolKeychainDidChangeNotification
+                                                   object:nil];
+    });
+    return _sharedCache;
+}
+
+- (void)keychainDidChange:(NSNotification *)notification {
+    @synchronized(self) {
+        [self.values removeAllObjects];
+    }
+}
+
+@end
+
+@interface AWSCognitoIdentityUserPoolSessionMetrics()
+
+@property (nonatomic, assign) NSUInteger keychainReadCount;
+@property (nonatomic, assign) NSUInteger keychainWriteCount;
+@property (nonatomic, assign) NSUInteger cacheHitCount;
+@property (nonatomic, assign) NSUInteger refreshCount;
+@property (nonatomic, assign) NSUInteger aheadOfExpiryRefreshCount;
+@property (nonatomic, assign) NSUInteger coalescedRefreshCount;
+
+@end
+
+@implementation AWSCognitoIdentityUserPoolSessionMetrics
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p> keychain reads: %lu, keychain writes: %lu, cache hits: %lu, refreshes: %lu, ahead of expiry: %lu, coalesced: %lu",
+            NSStringFromClass([self class]), self,
+            (unsigned long)self.keychainReadCount,
+            (unsigned long)self.keychainWriteCount,
+            (unsigned long)self.cacheHitCount,
+            (unsigned long)self.refreshCount,
+            (unsigned long)self.aheadOfExpiryRefreshCount,
+            (unsigned long)self.coalescedRefreshCount];
+}
+
+@end
 
 @interface AWSCognitoIdentityUserPool()
 
@@ -23,6 +88,7 @@ static const NSString * AWSCognitoIdentityUserPoolCurrentUser = @"currentUser";
 @property (nonatomic, strong) AWSCognitoIdentityUserPoolConfiguration *userPoolConfiguration;
 @property (nonatomic, strong) NSString * pinpointEndpointId;
 @property (nonatomic, assign) BOOL isCustomAuth;
+@property (nonatomic, strong) AWSCognitoIdentityUserPoolSessionMetrics *metrics;
 
 @end
 
@@ -165,6 +231,8 @@ static NSString *const AWSPinpointContextKeychainUniqueIdKey = @"com.amazonaws.A
             _configuration = [[AWSServiceManager defaultServiceManager].defaultServiceConfiguration copy];
         }
         _isCustomAuth = NO;
+        _sessionRefreshLeadTime = AWSCognitoIdentityUserPoolDefaultSessionRefreshLeadTime;
+        _metrics = [AWSCognitoIdentityUserPoolSessionMetrics new];
         _userPoolConfiguration = [userPoolConfiguration copy];
 
         _client = [[AWSCognitoIdentityProvider alloc] initWithConfiguration:_configuration];
@@ -241,7 +309,7 @@ static NSString *const AWSPinpointContextKeychainUniqueIdKey = @"com.amazonaws.A
 }
 
 - (NSString*) currentUsername {
-    return self.keychain[[self currentUserKey]];
+    return [self sessionStringForKey:[self currentUserKey]];
 }
 
 - (NSString *) currentUserKey {
@@ -249,7 +317,7 @@ static NSString *const AWSPinpointContextKeychainUniqueIdKey = @"com.amazonaws.A
 }
 
 - (void) setCurrentUser:(NSString *) username {
-    self.keychain[[self currentUserKey]] = username;
+    [self setSessionString:username forKey:[self currentUserKey]];
 }
 
 - (AWSCognitoIdentityUser*) getUser {
@@ -278,18 +346,26 @@ static NSString *const AWSPinpointContextKeychainUniqueIdKey = @"com.amazonaws.A
 - (void) clearLastKnownUser {
     NSString * currentUserKey = [self currentUserKey];
     if(currentUserKey){
-        [self.keychain removeItemForKey:[self currentUserKey]];
+        [self setSessionString:nil forKey:currentUserKey];
     }
 }
 
 - (void) clearAll {
-    NSArray *keys = self.keychain.allKeys;
     NSString *keyChainPrefix = [NSString stringWithFormat:@"%@.", self.userPoolConfiguration.clientId];
-    for (NSString *key in keys) {
-        if([key hasPrefix:keyChainPrefix]){
-            [self.keychain removeItemForKey:key];
-        }
+    [self removeSessionItemsWithPrefix:keyChainPrefix];
+}
+
+- (AWSCognitoIdentityUserPoolSessionMetrics *)sessionMetrics {
+    AWSCognitoIdentityUserPoolSessionMetrics *metrics = [AWSCognitoIdentityUserPoolSessionMetrics new];
+    @synchronized([AWSCognitoIdentityUserPoolSessionCache sharedCache]) {
+        metrics.keychainReadCount = self.metrics.keychainReadCount;
+        metrics.keychainWriteCount = self.metrics.keychainWriteCount;
+        metrics.cacheHitCount = self.metrics.cacheHitCount;
+        metrics.refreshCount = self.metrics.refreshCount;
+        metrics.aheadOfExpiryRefreshCount = self.metrics.aheadOfExpiryRefreshCount;
+        metrics.coalescedRefreshCount = self.metrics.coalescedRefreshCount;
     }
+    return metrics;
 }
 
 #pragma mark identity provider
@@ -389,6 +465,96 @@ AWSCognitoIdentityUserAttributeType* attribute(NSString *name, NSString *value)
     return result;
 }
 
+#pragma mark session cache
+
+- (NSString *) sessionCacheKey:(NSString *) key {
+    return [NSString stringWithFormat:@"%@.%@", self.keychain.service, key];
+}
+
+- (NSString *) sessionStringForKey:(NSString *) key {
+    AWSCognitoIdentityUserPoolSessionCache *cache = [AWSCognitoIdentityUserPoolSessionCache sharedCache];
+    NSString *cacheKey = [self sessionCacheKey:key];
+    @synchronized(cache) {
+        id value = cache.values[cacheKey];
+        if (value) {
+            self.metrics.cacheHitCount++;
+            return value == [NSNull null] ? nil : value;
+        }
+        // Items that are not in the keychain are cached too, so a signed out user does not read it on every call.
+        NSString *keychainValue = self.keychain[key];
+        self.metrics.keychainReadCount++;
+        cache.values[cacheKey] = keychainValue ?: [NSNull null];
+        return keychainValue;
+    }
+}
+
+- (void) setSessionString:(NSString *) value forKey:(NSString *) key {
+    AWSCognitoIdentityUserPoolSessionCache *cache = [AWSCognitoIdentityUserPoolSessionCache sharedCache];
+    NSString *cacheKey = [self sessionCacheKey:key];
+    @synchronized(cache) {
+        id cachedValue = cache.values[cacheKey];
+        if ((value && [cachedValue isEqual:value]) || (!value && cachedValue == [NSNull null])) {
+            return;
+        }
+        if (value) {
+            self.keychain[key] = value;
+        } else {
+            [self.keychain removeItemForKey:key];
+        }
+        self.metrics.keychainWriteCount++;
+        cache.values[cacheKey] = value ?: [NSNull null];
+    }
+}
+
+- (void) removeSessionItemsWithPrefix:(NSString *) prefix {
+    AWSCognitoIdentityUserPoolSessionCache *cache = [AWSCognitoIdentityUserPoolSessionCache sharedCache];
+    @synchronized(cache) {
+        for (NSString *key in self.keychain.allKeys) {
+            if ([key hasPrefix:prefix]) {
+                [self.keychain removeItemForKey:key];
+                self.metrics.keychainWriteCount++;
+            }
+        }
+        // Drop rather than mark missing, the keychain listing above may not have covered every cached item.
+        NSString *cachePrefix = [self sessionCacheKey:prefix];
+        for (NSString *cacheKey in cache.values.allKeys) {
+            if ([cacheKey hasPrefix:cachePrefix]) {
+                [cache.values removeObjectForKey:cacheKey];
+            }
+        }
+    }
+}
+
+- (AWSTask *) coalescedSessionRefreshForKey:(NSString *) key
+                              aheadOfExpiry:(BOOL) aheadOfExpiry
+                                    refresh:(AWSTask * (^)(void)) refresh {
+    AWSCognitoIdentityUserPoolSessionCache *cache = [AWSCognitoIdentityUserPoolSessionCache sharedCache];
+    NSString *cacheKey = [self sessionCacheKey:key];
+    AWSTask *task = nil;
+    @synchronized(cache) {
+        AWSTask *pending = cache.pendingRefreshes[cacheKey];
+        if (pending) {
+            self.metrics.coalescedRefreshCount++;
+            return pending;
+        }
+        self.metrics.refreshCount++;
+        if (aheadOfExpiry) {
+            self.metrics.aheadOfExpiryRefreshCount++;
+        }
+        task = refresh();
+        cache.pendingRefreshes[cacheKey] = task;
+    }
+    [task continueWithBlock:^id _Nullable(AWSTask * _Nonnull t) {
+        @synchronized(cache) {
+            if (cache.pendingRefreshes[cacheKey] == task) {
+                [cache.pendingRefreshes removeObjectForKey:cacheKey];
+            }
+        }
+        return nil;
+    }];
+    return task;
+}
+
 - (NSString*) strippedPoolId {
     return [self.userPoolConfiguration.poolId substringFromIndex:[self.userPoolConfiguration.poolId rangeOfString:@"_" ].location+1];
 }
@@ -21,6 +21,21 @@
 - (AWSCognitoIdentityProviderUserContextDataType * _Nonnull) userContextData: (NSString * _Nonnull)  username deviceId:(NSString * _Nullable) deviceId;
 - (NSString* _Nullable) currentUsername;
 - (NSString* _Nonnull) strippedPoolId;
+
+/**
+ Keychain access for session items. Values are cached in memory, shared by every pool that uses the same keychain,
+ and written through to the keychain.
+ */
+- (NSString * _Nullable) sessionStringForKey:(NSString * _Nonnull) key;
+- (void) setSessionString:(NSString * _Nullable) value forKey:(NSString * _Nonnull) key;
+- (void) removeSessionItemsWithPrefix:(NSString * _Nonnull) prefix;
+
+/**
+ Returns the refresh already in flight for the key, or starts one with the block. `aheadOfExpiry` only affects the metrics.
+ */
+- (AWSTask * _Nonnull) coalescedSessionRefreshForKey:(NSString * _Nonnull) key
+                                       aheadOfExpiry:(BOOL) aheadOfExpiry
+                                             refresh:(AWSTask * _Nonnull (^ _Nonnull)(void)) refresh;
 @end
 
 @interface AWSCognitoIdentityUserPoolSignUpResponse()
@@ -0,0 +1,294 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSCognitoIdentityProvider.h"
+
+@interface AWSCognitoIdentityProvider()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSCognitoIdentityUserPool()
+
+@property (nonatomic, strong) AWSCognitoIdentityProvider *client;
+@property (nonatomic, strong) AWSUICKeyChainStore *keychain;
+
+- (void)setCurrentUser:(NSString *)username;
+
+@end
+
+// Answers InitiateAuth with new tokens after a short delay, like the service would.
+@interface AWSCognitoIdentityUserSessionCacheTestsProvider : AWSCognitoIdentityProvider
+
+@property (nonatomic, strong) AWSCognitoIdentityProviderInitiateAuthResponse *response;
+@property (atomic, assign) NSUInteger initiateAuthCount;
+
+@end
+
+@implementation AWSCognitoIdentityUserSessionCacheTestsProvider
+
+- (AWSTask<AWSCognitoIdentityProviderInitiateAuthResponse *> *)initiateAuth:(AWSCognitoIdentityProviderInitiateAuthRequest *)request {
+    @synchronized(self) {
+        self.initiateAuthCount++;
+    }
+    AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource taskCompletionSource];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        completionSource.result = self.response;
+    });
+    return completionSource.task;
+}
+
+@end
+
+@interface AWSCognitoIdentityUserSessionCacheTests : XCTestCase
+
+@property (nonatomic, strong) NSString *poolKey;
+@property (nonatomic, strong) AWSCognitoIdentityUserPool *pool;
+@property (nonatomic, strong) AWSCognitoIdentityUserSessionCacheTestsProvider *provider;
+
+@end
+
+@implementation AWSCognitoIdentityUserSessionCacheTests
+
++ (NSString *)tokenExpiringIn:(NSTimeInterval)interval {
+    return [self tokenExpiringIn:interval issuedAgo:-1];
+}
+
+// A negative `issuedAgo` leaves out the `iat` claim.
++ (NSString *)tokenExpiringIn:(NSTimeInterval)interval issuedAgo:(NSTimeInterval)issuedAgo {
+    NSMutableDictionary *claims = [@{@"exp" : @((long long)[[NSDate dateWithTimeIntervalSinceNow:interval] timeIntervalSince1970]),
+                                     @"jti" : [[NSUUID UUID] UUIDString]} mutableCopy];
+    if (issuedAgo >= 0) {
+        claims[@"iat"] = @((long long)[[NSDate dateWithTimeIntervalSinceNow:-issuedAgo] timeIntervalSince1970]);
+    }
+    NSData *claimsData = [NSJSONSerialization dataWithJSONObject:claims options:0 error:nil];
+    NSString *encodedClaims = [[claimsData base64EncodedStringWithOptions:0] stringByReplacingOccurrencesOfString:@"=" withString:@""];
+    return [NSString stringWithFormat:@"eyJhbGciOiJub25lIn0.%@.c2lnbmF0dXJl", encodedClaims];
+}
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    // A new client id gives each test its own keychain items.
+    self.poolKey = [[NSUUID UUID] UUIDString];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1 credentialsProvider:nil];
+    AWSCognitoIdentityUserPoolConfiguration *userPoolConfiguration = [[AWSCognitoIdentityUserPoolConfiguration alloc] initWithClientId:self.poolKey
+                                                                                                                          clientSecret:nil
+                                                                                                                                poolId:@"us-east-1_somePoolId"];
+    [AWSCognitoIdentityUserPool registerCognitoIdentityUserPoolWithConfiguration:configuration
+                                                           userPoolConfiguration:userPoolConfiguration
+                                                                          forKey:self.poolKey];
+    self.pool = [AWSCognitoIdentityUserPool CognitoIdentityUserPoolForKey:self.poolKey];
+
+    self.provider = [[AWSCognitoIdentityUserSessionCacheTestsProvider alloc] initWithConfiguration:configuration];
+    AWSCognitoIdentityProviderAuthenticationResultType *authenticationResult = [AWSCognitoIdentityProviderAuthenticationResultType new];
+    authenticationResult.accessToken = [[self class] tokenExpiringIn:60 * 60];
+    authenticationResult.idToken = [[self class] tokenExpiringIn:60 * 60];
+    authenticationResult.expiresIn = @(60 * 60);
+    self.provider.response = [AWSCognitoIdentityProviderInitiateAuthResponse new];
+    self.provider.response.authenticationResult = authenticationResult;
+    self.pool.client = self.provider;
+}
+
+- (void)tearDown {
+    [self.pool clearAll];
+    [AWSCognitoIdentityUserPool removeCognitoIdentityUserPoolForKey:self.poolKey];
+    [super tearDown];
+}
+
+// Writes tokens straight to the keychain, the way a previous launch of the app left them.
+- (void)storeTokensExpiringIn:(NSTimeInterval)interval forUsername:(NSString *)username {
+    [self storeTokensExpiringIn:interval issuedAgo:-1 forUsername:username];
+}
+
+- (void)storeTokensExpiringIn:(NSTimeInterval)interval issuedAgo:(NSTimeInterval)issuedAgo forUsername:(NSString *)username {
+    NSString *prefix = [NSString stringWithFormat:@"%@.%@.", self.poolKey, username];
+    self.pool.keychain[[prefix stringByAppendingString:@"accessToken"]] = [[self class] tokenExpiringIn:interval issuedAgo:issuedAgo];
+    self.pool.keychain[[prefix stringByAppendingString:@"idToken"]] = [[self class] tokenExpiringIn:interval issuedAgo:issuedAgo];
+    self.pool.keychain[[prefix stringByAppendingString:@"refreshToken"]] = @"refreshToken";
+    self.pool.keychain[[prefix stringByAppendingString:@"tokenExpiration"]] = [[NSDate dateWithTimeIntervalSinceNow:interval] aws_stringValue:AWSDateISO8601DateFormat1];
+}
+
+- (AWSTask *)waitForTask:(AWSTask *)task {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"task"];
+    [task continueWithBlock:^id _Nullable(AWSTask * _Nonnull t) {
+        [expectation fulfill];
+        return nil;
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    return task;
+}
+
+- (void)testRepeatedGetSessionReadsTheKeychainOnce {
+    [self storeTokensExpiringIn:60 * 60 forUsername:@"user"];
+    AWSCognitoIdentityUserSessionToken *accessToken = nil;
+
+    for (NSUInteger i = 0; i < 100; i++) {
+        AWSTask<AWSCognitoIdentityUserSession *> *task = [[self.pool getUser:@"user"] getSession];
+        XCTAssertNil(task.error);
+        XCTAssertNotNil(task.result.accessToken);
+        if (accessToken) {
+            XCTAssertEqualObjects(task.result.accessToken.tokenString, accessToken.tokenString);
+        }
+        accessToken = task.result.accessToken;
+    }
+
+    AWSCognitoIdentityUserPoolSessionMetrics *metrics = [self.pool sessionMetrics];
+    XCTAssertEqual(metrics.keychainReadCount, 4);
+    XCTAssertEqual(metrics.keychainWriteCount, 0);
+    XCTAssertEqual(metrics.cacheHitCount, 99 * 4);
+    XCTAssertEqual(metrics.refreshCount, 0);
+    XCTAssertEqual(self.provider.initiateAuthCount, 0);
+}
+
+- (void)testConcurrentRefreshesShareOneInitiateAuth {
+    [self storeTokensExpiringIn:60 forUsername:@"user"];
+
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    dispatch_apply(20, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        AWSTask *task = [[self.pool getUser:@"user"] getSession];
+        @synchronized(tasks) {
+            [tasks addObject:task];
+        }
+    });
+
+    AWSTask *all = [self waitForTask:[AWSTask taskForCompletionOfAllTasks:tasks]];
+    XCTAssertNil(all.error);
+    XCTAssertEqual(self.provider.initiateAuthCount, 1);
+    for (AWSTask<AWSCognitoIdentityUserSession *> *task in tasks) {
+        XCTAssertEqualObjects(task.result.accessToken.tokenString, self.provider.response.authenticationResult.accessToken);
+        XCTAssertEqualObjects(task.result.refreshToken.tokenString, @"refreshToken");
+    }
+
+    AWSCognitoIdentityUserPoolSessionMetrics *metrics = [self.pool sessionMetrics];
+    XCTAssertEqual(metrics.refreshCount, 1);
+    XCTAssertEqual(metrics.coalescedRefreshCount, 19);
+    XCTAssertEqual(metrics.aheadOfExpiryRefreshCount, 0);
+
+    // The new tokens were written through to the keychain and are served from memory.
+    NSUInteger keychainReadCount = metrics.keychainReadCount;
+    AWSTask<AWSCognitoIdentityUserSession *> *task = [[self.pool getUser:@"user"] getSession];
+    XCTAssertEqualObjects(task.result.accessToken.tokenString, self.provider.response.authenticationResult.accessToken);
+    XCTAssertEqual([self.pool sessionMetrics].keychainReadCount, keychainReadCount);
+    XCTAssertEqualObjects(self.pool.keychain[[NSString stringWithFormat:@"%@.user.accessToken", self.poolKey]],
+                          self.provider.response.authenticationResult.accessToken);
+}
+
+- (void)testSessionIsRefreshedAheadOfExpiry {
+    [self storeTokensExpiringIn:4 * 60 forUsername:@"user"];
+    NSString *currentAccessToken = self.pool.keychain[[NSString stringWithFormat:@"%@.user.accessToken", self.poolKey]];
+
+    // The current tokens are still returned while the refresh runs.
+    AWSTask<AWSCognitoIdentityUserSession *> *first = [[self.pool getUser:@"user"] getSession];
+    XCTAssertEqualObjects(first.result.accessToken.tokenString, currentAccessToken);
+    AWSTask<AWSCognitoIdentityUserSession *> *second = [[self.pool getUser:@"user"] getSession];
+    XCTAssertEqualObjects(second.result.accessToken.tokenString, currentAccessToken);
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"refresh"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    AWSTask<AWSCognitoIdentityUserSession *> *refreshed = [[self.pool getUser:@"user"] getSession];
+    XCTAssertEqualObjects(refreshed.result.accessToken.tokenString, self.provider.response.authenticationResult.accessToken);
+    XCTAssertEqual(self.provider.initiateAuthCount, 1);
+
+    AWSCognitoIdentityUserPoolSessionMetrics *metrics = [self.pool sessionMetrics];
+    XCTAssertEqual(metrics.refreshCount, 1);
+    XCTAssertEqual(metrics.aheadOfExpiryRefreshCount, 1);
+    XCTAssertEqual(metrics.coalescedRefreshCount, 1);
+}
+
+- (void)testNoRefreshAheadOfExpiryWhenLeadTimeIsZero {
+    self.pool.sessionRefreshLeadTime = 0;
+    [self storeTokensExpiringIn:4 * 60 forUsername:@"user"];
+
+    AWSTask<AWSCognitoIdentityUserSession *> *task = [[self.pool getUser:@"user"] getSession];
+    XCTAssertNotNil(task.result);
+    XCTAssertEqual(self.provider.initiateAuthCount, 0);
+    XCTAssertEqual([self.pool sessionMetrics].refreshCount, 0);
+}
+
+- (void)testLeadTimeIsClampedToHalfTheLifetimeOfShortLivedTokens {
+    // Five minute tokens, Cognito's shortest, are only refreshed ahead of expiry in the second half of their lifetime.
+    [self storeTokensExpiringIn:5 * 60 issuedAgo:0 forUsername:@"fresh"];
+    for (NSUInteger i = 0; i < 10; i++) {
+        XCTAssertNotNil([[self.pool getUser:@"fresh"] getSession].result);
+    }
+    XCTAssertEqual(self.provider.initiateAuthCount, 0);
+
+    [self storeTokensExpiringIn:135 issuedAgo:165 forUsername:@"halfway"];
+    XCTAssertNotNil([[self.pool getUser:@"halfway"] getSession].result);
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"refresh"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(self.provider.initiateAuthCount, 1);
+    XCTAssertEqual([self.pool sessionMetrics].aheadOfExpiryRefreshCount, 1);
+}
+
+- (void)testSignOutClearsTheCachedSession {
+    [self storeTokensExpiringIn:60 * 60 forUsername:@"user"];
+    XCTAssertNotNil([[self.pool getUser:@"user"] getSession].result);
+    XCTAssertTrue([[self.pool getUser:@"user"] isSignedIn]);
+
+    [[self.pool getUser:@"user"] signOut];
+
+    XCTAssertFalse([[self.pool getUser:@"user"] isSignedIn]);
+    XCTAssertNil(self.pool.keychain[[NSString stringWithFormat:@"%@.user.accessToken", self.poolKey]]);
+    AWSTask *task = [self waitForTask:[[self.pool getUser:@"user"] getSession]];
+    XCTAssertNotNil(task.error);
+    XCTAssertEqual(task.error.code, AWSCognitoIdentityProviderClientErrorInvalidAuthenticationDelegate);
+}
+
+- (void)testCurrentUserIsWrittenThrough {
+    [self.pool setCurrentUser:@"user"];
+    XCTAssertEqualObjects(self.pool.keychain[[NSString stringWithFormat:@"%@.currentUser", self.poolKey]], @"user");
+    XCTAssertEqualObjects([self.pool currentUser].username, @"user");
+    XCTAssertEqualObjects([self.pool currentUser].username, @"user");
+
+    // Setting the same user again does not touch the keychain.
+    [self.pool setCurrentUser:@"user"];
+    AWSCognitoIdentityUserPoolSessionMetrics *metrics = [self.pool sessionMetrics];
+    XCTAssertEqual(metrics.keychainReadCount, 0);
+    XCTAssertEqual(metrics.keychainWriteCount, 1);
+
+    [self.pool clearLastKnownUser];
+    XCTAssertNil([self.pool currentUser].username);
+    XCTAssertNil(self.pool.keychain[[NSString stringWithFormat:@"%@.currentUser", self.poolKey]]);
+}
+
+- (void)testGetSessionPerformance {
+    [self storeTokensExpiringIn:60 * 60 forUsername:@"user"];
+    AWSCognitoIdentityUser *user = [self.pool getUser:@"user"];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10000; i++) {
+            @autoreleasepool {
+                [user getSession];
+            }
+        }
+    }];
+    XCTAssertEqual([self.pool sessionMetrics].keychainReadCount, 4);
+}
+
+@end
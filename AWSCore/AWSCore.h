@@ -51,6 +51,7 @@ FOUNDATION_EXPORT const unsigned char AWSCoreVersionString[] DEPRECATED_MSG_ATTR
 #import "AWSLogging.h"
 #import "AWSClientContext.h"
 #import "AWSSynchronizedMutableDictionary.h"
+#import "AWSEventStream.h"
 #import "AWSXMLDictionary.h"
 #import "AWSSerialization.h"
 #import "AWSTimestampSerialization.h"
@@ -59,6 +60,8 @@ FOUNDATION_EXPORT const unsigned char AWSCoreVersionString[] DEPRECATED_MSG_ATTR
 #import "AWSURLSessionManager.h"
 #import "AWSSignature.h"
 #import "AWSURLRequestRetryHandler.h"
+#import "AWSRequestCompression.h"
+#import "AWSResponseDecompression.h"
 #import "AWSValidation.h"
 #import "AWSInfo.h"
 #import "AWSNSCodingUtilities.h"
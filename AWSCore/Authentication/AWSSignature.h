@@ -19,6 +19,20 @@
 FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Algorithm;
 FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 
+/**
+ The smallest chunk of payload `AWSS3ChunkedEncodingInputStream` signs. S3 requires every chunk but the last to be at
+ least this large.
+ */
+FOUNDATION_EXPORT const NSUInteger AWSS3ChunkedEncodingMinimumChunkSize;
+/**
+ The largest chunk of payload `AWSS3ChunkedEncodingInputStream` signs.
+ */
+FOUNDATION_EXPORT const NSUInteger AWSS3ChunkedEncodingMaximumChunkSize;
+/**
+ The chunk size used unless another one is given, 64 KB.
+ */
+FOUNDATION_EXPORT const NSUInteger AWSS3ChunkedEncodingDefaultChunkSize;
+
 @class AWSEndpoint;
 
 @protocol AWSCredentialsProvider;
@@ -43,6 +57,13 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 
 @property (nonatomic, strong, readonly) id<AWSCredentialsProvider> _Nonnull credentialsProvider;
 
+/**
+ The payload bytes per signed chunk when an S3 request body is streamed with `aws-chunked` encoding. Larger chunks mean
+ fewer signatures and reads for large uploads. The value is clamped between `AWSS3ChunkedEncodingMinimumChunkSize` and
+ `AWSS3ChunkedEncodingMaximumChunkSize`. Defaults to `AWSS3ChunkedEncodingDefaultChunkSize`.
+ */
+@property (nonatomic, assign) NSUInteger chunkSize;
+
 - (instancetype _Nonnull)initWithCredentialsProvider:(id<AWSCredentialsProvider> _Nonnull)credentialsProvider
                                    endpoint:(AWSEndpoint * _Nonnull)endpoint;
 
@@ -132,9 +153,15 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 @interface AWSS3ChunkedEncodingInputStream : NSInputStream <NSStreamDelegate>
 
 @property (atomic, assign) int64_t totalLengthOfChunkSignatureSent;
+
+/**
+ * Payload bytes per signed chunk.
+ **/
+@property (nonatomic, assign, readonly) NSUInteger chunkSize;
+
 /**
  * Initialize the input stream with date, scope, signing key and signature
- * of request headers.
+ * of request headers, using `AWSS3ChunkedEncodingDefaultChunkSize`.
  **/
 - (instancetype _Nonnull )initWithInputStream:(NSInputStream * _Nonnull)stream
                                          date:(NSDate * _Nullable)date
@@ -143,8 +170,28 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
                               headerSignature:(NSString * _Nullable)headerSignature;
 
 /**
- * Computes new content length after data being chunked encoded.
+ * Initialize the input stream with date, scope, signing key, signature
+ * of request headers and the payload bytes per chunk. The chunk size is
+ * clamped between `AWSS3ChunkedEncodingMinimumChunkSize` and
+ * `AWSS3ChunkedEncodingMaximumChunkSize`.
+ **/
+- (instancetype _Nonnull )initWithInputStream:(NSInputStream * _Nonnull)stream
+                                         date:(NSDate * _Nullable)date
+                                        scope:(NSString * _Nullable)scope
+                                     kSigning:(NSData * _Nullable)kSigning
+                              headerSignature:(NSString * _Nullable)headerSignature
+                                    chunkSize:(NSUInteger)chunkSize;
+
+/**
+ * Computes new content length after data being chunked encoded with
+ * `AWSS3ChunkedEncodingDefaultChunkSize`.
  **/
 + (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength;
 
+/**
+ * Computes new content length after data being chunked encoded.
+ **/
++ (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength
+                                       chunkSize:(NSUInteger)chunkSize;
+
 @end
@@ -157,6 +157,7 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
     if (self = [super init]) {
         _credentialsProvider = credentialsProvider;
         _endpoint = endpoint;
+        _chunkSize = AWSS3ChunkedEncodingDefaultChunkSize;
     }
 
     return self;
@@ -238,7 +239,7 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
     NSUInteger contentLength = [[urlRequest allHTTPHeaderFields][@"Content-Length"] integerValue];
     if (nil != stream) {
         contentSha256 = @"STREAMING-AWS4-HMAC-SHA256-PAYLOAD";
-        [urlRequest setValue:[NSString stringWithFormat:@"%lu", (unsigned long)[AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:contentLength]]
+        [urlRequest setValue:[NSString stringWithFormat:@"%lu", (unsigned long)[AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:contentLength chunkSize:self.chunkSize]]
           forHTTPHeaderField:@"Content-Length"];
         [urlRequest setValue:nil forHTTPHeaderField:@"Content-Length"]; //remove Content-Length header if it is a HTTPBodyStream
         [urlRequest addValue:@"aws-chunked" forHTTPHeaderField:@"Content-Encoding"]; //add aws-chunked keyword for s3 chunk upload
@@ -305,7 +306,8 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
                                                                                                            date:date
                                                                                                           scope:scope
                                                                                                        kSigning:kSigning
-                                                                                                headerSignature:signatureString];
+                                                                                                headerSignature:signatureString
+                                                                                                      chunkSize:self.chunkSize];
         [urlRequest setHTTPBodyStream:chunkedStream];
     }
 
@@ -845,21 +847,35 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
 
 #pragma mark - S3ChunkedEncodingInputStream
 
-static NSUInteger defaultChunkSize = 32 * 1024 - 91;
+const NSUInteger AWSS3ChunkedEncodingMinimumChunkSize = 8 * 1024;
+const NSUInteger AWSS3ChunkedEncodingMaximumChunkSize = 8 * 1024 * 1024;
+const NSUInteger AWSS3ChunkedEncodingDefaultChunkSize = 64 * 1024;
+
 static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
 
+// <chunk size in hex>;chunk-signature=<sha256>\r\n
+// Chunks are at most 8 MB, so the size always fits in the six hex digits the header is padded to.
+static const char AWSS3ChunkSignaturePrefix[] = ";chunk-signature=";
+enum {
+    AWSS3ChunkSizeDigits = 6,
+    AWSS3ChunkHeaderLength = AWSS3ChunkSizeDigits + sizeof(AWSS3ChunkSignaturePrefix) - 1 + CC_SHA256_DIGEST_LENGTH * 2 + 2,
+    AWSS3ChunkTrailerLength = 2,
+};
+
+static void AWSS3HexEncode(const uint8_t *bytes, NSUInteger length, char *hex) {
+    static const char digits[] = "0123456789abcdef";
+    for (NSUInteger i = 0; i < length; i++) {
+        hex[i * 2] = digits[bytes[i] >> 4];
+        hex[i * 2 + 1] = digits[bytes[i] & 0x0f];
+    }
+}
+
 @interface AWSS3ChunkedEncodingInputStream()
 
 // original input stream
 @property (nonatomic, strong) NSInputStream *stream;
 
-// buffer for chunked data plus header
-@property (nonatomic, strong) NSMutableData *chunkData;
-
-// Mark the location of chunkData to be read
-@property (nonatomic, assign) NSUInteger location;
-
-// A flag indicates end of stream
+// Set once the final, empty chunk has been encoded
 @property (nonatomic, assign) BOOL endOfStream;
 
 // SigV4 related properties
@@ -869,15 +885,23 @@ static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427a
 // Keypath/Scope
 @property (nonatomic, strong) NSString *scope;
 
-// Signature of previous chunk. It's initialized as that of headers.
-@property (nonatomic, strong) NSString *priorSha256;
-
 // SigV4 signing key
 @property (nonatomic, strong) NSData *kSigning;
 
+// "AWS4-HMAC-SHA256-PAYLOAD\n<date>\n<scope>\n", the part of every chunk's string to sign that does not change
+@property (nonatomic, strong) NSData *stringToSignPrefix;
+
 @end
 
-@implementation AWSS3ChunkedEncodingInputStream
+@implementation AWSS3ChunkedEncodingInputStream {
+    // Encoded chunk waiting to be read, used when the caller's buffer cannot hold a whole chunk
+    uint8_t *_chunkBuffer;
+    NSUInteger _chunkLength;
+    NSUInteger _location;
+
+    // Hex signature of the previous chunk. It's initialized as that of headers.
+    char _priorSignature[CC_SHA256_DIGEST_LENGTH * 2];
+}
 
 @synthesize delegate = _delegate;
 
@@ -886,22 +910,57 @@ static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427a
                               scope:(NSString *)scope
                            kSigning:(NSData *)kSigning
                     headerSignature:(NSString *)headerSignature {
+    return [self initWithInputStream:stream
+                                date:date
+                               scope:scope
+                            kSigning:kSigning
+                     headerSignature:headerSignature
+                           chunkSize:AWSS3ChunkedEncodingDefaultChunkSize];
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream
+                               date:(NSDate *)date
+                              scope:(NSString *)scope
+                           kSigning:(NSData *)kSigning
+                    headerSignature:(NSString *)headerSignature
+                          chunkSize:(NSUInteger)chunkSize {
     if (self = [super init]) {
         _stream = stream;
         _stream.delegate = self;
         _date = [date copy];
         _scope = [scope copy];
         _kSigning = [kSigning copy];
-        _priorSha256 = [headerSignature copy];
+        _chunkSize = [AWSS3ChunkedEncodingInputStream validChunkSize:chunkSize];
+
+        NSString *prefix = [NSString stringWithFormat:@"%@\n%@\n%@\n",
+                            @"AWS4-HMAC-SHA256-PAYLOAD",
+                            [_date aws_stringValue:AWSDateISO8601DateFormat2],
+                            _scope];
+        _stringToSignPrefix = [prefix dataUsingEncoding:NSUTF8StringEncoding];
+
+        memset(_priorSignature, '0', sizeof(_priorSignature));
+        NSData *headerSignatureData = [headerSignature dataUsingEncoding:NSASCIIStringEncoding];
+        if ([headerSignatureData length] == sizeof(_priorSignature)) {
+            memcpy(_priorSignature, [headerSignatureData bytes], sizeof(_priorSignature));
+        }
 
-        // Chunk size plus signature header
-        NSUInteger chunkSize = defaultChunkSize + [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:defaultChunkSize];
-        _chunkData = [[NSMutableData alloc] initWithCapacity:chunkSize];
+        _chunkBuffer = malloc(AWSS3ChunkHeaderLength + _chunkSize + AWSS3ChunkTrailerLength);
+        if (!_chunkBuffer) {
+            return nil;
+        }
     }
 
     return self;
 }
 
+- (void)dealloc {
+    free(_chunkBuffer);
+}
+
++ (NSUInteger)validChunkSize:(NSUInteger)chunkSize {
+    return MIN(MAX(chunkSize, AWSS3ChunkedEncodingMinimumChunkSize), AWSS3ChunkedEncodingMaximumChunkSize);
+}
+
 - (void)stream:(NSStream *)aStream handleEvent:(NSStreamEvent)eventCode {
     if ((eventCode & (1 << 4))) {
         // toggle the NSStreamEventEndEncountered bit.
@@ -912,99 +971,112 @@ static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427a
     }
 }
 
-// Read next chunk of data from stream, and sign the chunk.
-// Returns YES on a successful read, NO otherwise.
-- (BOOL)nextChunk {
-    if (self.endOfStream) {
-        return NO;
+// Reads the next chunk of data from the stream into `buffer` and encodes it in place. `buffer` must hold a header, a
+// full chunk and the trailer. Returns the length of the encoded chunk, or -1 if the stream read failed.
+- (NSInteger)encodeNextChunkIntoBuffer:(uint8_t *)buffer {
+    // Fill the chunk; S3 requires every chunk but the last to be at least 8 KB.
+    uint8_t *payload = buffer + AWSS3ChunkHeaderLength;
+    NSUInteger payloadLength = 0;
+    while (payloadLength < self.chunkSize) {
+        NSInteger read = [self.stream read:payload + payloadLength maxLength:self.chunkSize - payloadLength];
+        if (read < 0) {
+            AWSDDLogError(@"stream read failed streamStatus: %lu streamError: %@", (unsigned long)[self.stream streamStatus], [self.stream streamError].description);
+            return -1;
+        }
+        if (read == 0) {
+            break;
+        }
+        payloadLength += read;
     }
 
-    // clear current chunkData for next chunk
-    [self.chunkData setLength:0];
-
-    uint8_t *chunkBuffer = calloc(defaultChunkSize, sizeof(uint8_t));
-    NSInteger read = [self.stream read:chunkBuffer maxLength:defaultChunkSize];
-
-    // mark end of stream if no data is read
-    self.endOfStream = (read <= 0);
-
-    // return NO if stream read failed
-    if (read < 0) {
-        free(chunkBuffer);
-        AWSDDLogError(@"stream read failed streamStatus: %lu streamError: %@", (unsigned long)[self.stream streamStatus], [self.stream streamError].description);
-        return NO;
-    }
+    // mark end of stream once the empty, final chunk is encoded
+    self.endOfStream = (payloadLength == 0);
 
-    NSData *data = [NSData dataWithBytesNoCopy:chunkBuffer length:read];
-    [self.chunkData appendData:[self getSignedChunk:data]];
+    [self signChunk:payload length:payloadLength header:buffer];
+    payload[payloadLength] = '\r';
+    payload[payloadLength + 1] = '\n';
 
-    AWSDDLogVerbose(@"stream read: %ld, chunk size: %lu", (long)read, (unsigned long)[self.chunkData length]);
+    self.totalLengthOfChunkSignatureSent += AWSS3ChunkHeaderLength + AWSS3ChunkTrailerLength;
+    AWSDDLogVerbose(@"stream read: %lu, chunk size: %lu", (unsigned long)payloadLength, (unsigned long)(AWSS3ChunkHeaderLength + payloadLength + AWSS3ChunkTrailerLength));
 
-    return YES;
+    return AWSS3ChunkHeaderLength + payloadLength + AWSS3ChunkTrailerLength;
 }
 
-// Signs data
-- (NSData *)getSignedChunk:(NSData *)data {
-    NSString *chunkSha256 = [self dataToHexString:[AWSSignatureSignerUtility hashData:data]];
-    NSString *stringToSign = [NSString stringWithFormat:
-                              @"%@\n%@\n%@\n%@\n%@\n%@",
-                              @"AWS4-HMAC-SHA256-PAYLOAD",
-                              [self.date aws_stringValue:AWSDateISO8601DateFormat2],
-                              self.scope,
-                              self.priorSha256,
-                              emptyStringSha256,
-                              chunkSha256];
-    AWSDDLogVerbose(@"AWS4 String to Sign: [%@]", stringToSign);
-
-    NSData *signature = [AWSSignatureSignerUtility sha256HMacWithData:[stringToSign dataUsingEncoding:NSUTF8StringEncoding]
-                                                              withKey:self.kSigning];
-    self.priorSha256 = [self dataToHexString:signature];
-    NSString *chunkedHeader = [NSString stringWithFormat:@"%06lx;chunk-signature=%@\r\n", (unsigned long)[data length], self.priorSha256];
-    AWSDDLogVerbose(@"AWS4 Chunked Header: [%@]", chunkedHeader);
-
-    NSMutableData *signedChunk = [NSMutableData data];
-    [signedChunk appendData:[chunkedHeader dataUsingEncoding:NSUTF8StringEncoding]];
-    [signedChunk appendData:data];
-    [signedChunk appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-
-    self.totalLengthOfChunkSignatureSent += [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:0];
-    return signedChunk;
-}
+// Signs the chunk and writes its header, chaining the signature from the previous chunk.
+- (void)signChunk:(const uint8_t *)payload length:(NSUInteger)length header:(uint8_t *)header {
+    uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+    char chunkSha256[CC_SHA256_DIGEST_LENGTH * 2];
+    CC_SHA256(payload, (CC_LONG)length, digest);
+    AWSS3HexEncode(digest, CC_SHA256_DIGEST_LENGTH, chunkSha256);
 
-- (NSString *)dataToHexString:(NSData *) data {
-    return [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:data
-                                                                      encoding:NSASCIIStringEncoding]];
+    // AWS4-HMAC-SHA256-PAYLOAD\n<date>\n<scope>\n<prior signature>\n<empty string sha256>\n<chunk sha256>
+    static const char separator = '\n';
+    const char *emptySha256 = [emptyStringSha256 UTF8String];
+    CCHmacContext context;
+    CCHmacInit(&context, kCCHmacAlgSHA256, [self.kSigning bytes], [self.kSigning length]);
+    CCHmacUpdate(&context, [self.stringToSignPrefix bytes], [self.stringToSignPrefix length]);
+    CCHmacUpdate(&context, _priorSignature, sizeof(_priorSignature));
+    CCHmacUpdate(&context, &separator, 1);
+    CCHmacUpdate(&context, emptySha256, strlen(emptySha256));
+    CCHmacUpdate(&context, &separator, 1);
+    CCHmacUpdate(&context, chunkSha256, sizeof(chunkSha256));
+    CCHmacFinal(&context, digest);
+    AWSS3HexEncode(digest, CC_SHA256_DIGEST_LENGTH, _priorSignature);
+
+    static const char digits[] = "0123456789abcdef";
+    for (NSUInteger i = 0; i < AWSS3ChunkSizeDigits; i++) {
+        header[AWSS3ChunkSizeDigits - 1 - i] = digits[(length >> (4 * i)) & 0x0f];
+    }
+    uint8_t *p = header + AWSS3ChunkSizeDigits;
+    memcpy(p, AWSS3ChunkSignaturePrefix, sizeof(AWSS3ChunkSignaturePrefix) - 1);
+    p += sizeof(AWSS3ChunkSignaturePrefix) - 1;
+    memcpy(p, _priorSignature, sizeof(_priorSignature));
+    p += sizeof(_priorSignature);
+    p[0] = '\r';
+    p[1] = '\n';
 }
 
 #pragma mark NSInputStream methods
 
 - (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
-    //change the defaultChunkSize according to caller reading capacity.
-    defaultChunkSize = len - [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:0];
-    // check whether there is data available
-    if ([self.chunkData length] <= self.location) {
-        // set up next chunk
-        if ([self nextChunk]) {
-            // rewind location
-            self.location = 0;
+    NSUInteger total = 0;
+    NSUInteger encodedChunkSize = AWSS3ChunkHeaderLength + self.chunkSize + AWSS3ChunkTrailerLength;
+
+    while (total < len) {
+        if (_location < _chunkLength) {
+            // Hand out what is left of the buffered chunk.
+            NSUInteger length = MIN(len - total, _chunkLength - _location);
+            memcpy(buffer + total, _chunkBuffer + _location, length);
+            _location += length;
+            total += length;
+            continue;
+        }
+        if (self.endOfStream) {
+            break;
+        }
+
+        NSInteger encoded;
+        if (len - total >= encodedChunkSize) {
+            // Room for a whole chunk: read and sign it right in the caller's buffer.
+            encoded = [self encodeNextChunkIntoBuffer:buffer + total];
+            if (encoded > 0) {
+                total += encoded;
+            }
         } else {
-            return 0;
+            encoded = [self encodeNextChunkIntoBuffer:_chunkBuffer];
+            _chunkLength = encoded > 0 ? encoded : 0;
+            _location = 0;
+        }
+        if (encoded < 0) {
+            return total > 0 ? total : -1;
         }
     }
 
-    // compute how many bytes to read from chunk
-    NSUInteger length = MIN(len, [self.chunkData length] - self.location);
-    NSRange range = {self.location, length};
-    [self.chunkData getBytes:(void *)buffer range:range];
-
-    // Update location
-    self.location += length;
-
-    return length;
+    return total;
 }
 
 - (BOOL)hasBytesAvailable {
-	return !self.endOfStream;
+    return !self.endOfStream || _location < _chunkLength;
 }
 
 - (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
@@ -1045,7 +1117,7 @@ static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427a
 
 - (NSStreamStatus)streamStatus {
     if ([self.stream streamStatus] == NSStreamStatusAtEnd) {
-        if (self.endOfStream) {
+        if (![self hasBytesAvailable]) {
             return [self.stream streamStatus];
         } else {
             return NSStreamStatusOpen;
@@ -1074,17 +1146,23 @@ static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427a
  * <data>\r\n
  **/
 + (NSUInteger)oneChunkedDataSize:(NSUInteger)dataLength {
-    return [[NSString stringWithFormat:@"%06lx;chunk-signature=%@\r\n",  (unsigned long)dataLength, emptyStringSha256] length] + dataLength + [@"\r\n" length];
+    return AWSS3ChunkHeaderLength + dataLength + AWSS3ChunkTrailerLength;
 }
 
 + (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength {
+    return [self computeContentLengthForChunkedData:dataLength chunkSize:AWSS3ChunkedEncodingDefaultChunkSize];
+}
+
++ (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength
+                                       chunkSize:(NSUInteger)chunkSize {
+    chunkSize = [self validChunkSize:chunkSize];
     NSUInteger result = 0;
 
     // length of full chunks
-    result += (dataLength / defaultChunkSize) * [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:defaultChunkSize];
+    result += (dataLength / chunkSize) * [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:chunkSize];
     
     // length of remaining data
-    NSUInteger remainingDataLength = dataLength % defaultChunkSize;
+    NSUInteger remainingDataLength = dataLength % chunkSize;
     if (remainingDataLength > 0) {
         result += [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:remainingDataLength];
     }
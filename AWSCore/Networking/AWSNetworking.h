@@ -37,10 +37,12 @@ FOUNDATION_EXPORT NSString *const AWSResponseObjectErrorUserInfoKey;
 
 @class AWSNetworkingConfiguration;
 @class AWSNetworkingRequest;
+@class AWSRequestCompressionPolicy;
 @class AWSTask<__covariant ResultType>;
 
 typedef void (^AWSNetworkingUploadProgressBlock) (int64_t bytesSent, int64_t totalBytesSent, int64_t totalBytesExpectedToSend);
 typedef void (^AWSNetworkingDownloadProgressBlock) (int64_t bytesWritten, int64_t totalBytesWritten, int64_t totalBytesExpectedToWrite);
+typedef void (^AWSNetworkingDataReceivedBlock) (NSData *data, int64_t totalBytesReceived, int64_t totalBytesExpectedToReceive);
 
 #pragma mark - AWSHTTPMethod
 
@@ -172,6 +174,16 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
  */
 @property (nonatomic, assign) NSTimeInterval timeoutIntervalForResource;
 
+/**
+ Compresses the request bodies that the policy applies to before they are signed and sent. Only set it for services that accept the `Content-Encoding` of its compressor. Defaults to `nil`, which sends bodies uncompressed.
+ */
+@property (nonatomic, copy) AWSRequestCompressionPolicy *requestCompressionPolicy;
+
+/**
+ When `YES`, successful response bodies that arrive gzip compressed, such as compressed objects and exports that the URL session does not decode itself, are decompressed chunk by chunk as they arrive. Whether a body is gzip is decided from its first bytes, since the URL session keeps the `Content-Encoding` header of bodies it has already decoded. The decompressed bytes are buffered, written to `downloadingFileURL` or handed to `dataReceived`. Bodies that are not gzip are delivered as they are. Defaults to `NO`.
+ */
+@property (nonatomic, assign) BOOL inflatesGZIPResponses;
+
 @end
 
 #pragma mark - AWSNetworkingRequest
@@ -186,6 +198,11 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
 @property (nonatomic, copy) AWSNetworkingUploadProgressBlock uploadProgress;
 @property (nonatomic, copy) AWSNetworkingDownloadProgressBlock downloadProgress;
 
+/**
+ When set, the body of a successful (2xx) response is delivered to this block chunk by chunk as it arrives instead of being accumulated in memory. The response serializer then receives `nil` data. The block is called on the URL session's delegate queue. Once part of the body has been delivered, a failed request is not retried, so the block never receives the same bytes twice.
+ */
+@property (nonatomic, copy) AWSNetworkingDataReceivedBlock dataReceived;
+
 @property (readonly, nonatomic, strong) NSURLSessionTask *task;
 @property (readonly, nonatomic, assign, getter = isCancelled) BOOL cancelled;
 
@@ -199,6 +216,7 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
 
 @property (nonatomic, copy) AWSNetworkingUploadProgressBlock uploadProgress;
 @property (nonatomic, copy) AWSNetworkingDownloadProgressBlock downloadProgress;
+@property (nonatomic, copy) AWSNetworkingDataReceivedBlock dataReceived;
 @property (nonatomic, assign, readonly, getter = isCancelled) BOOL cancelled;
 @property (nonatomic, strong) NSURL *downloadingFileURL;
 
@@ -20,6 +20,7 @@
 #import "AWSModel.h"
 #import "AWSURLSessionManager.h"
 #import "AWSService.h"
+#import "AWSRequestCompression.h"
 
 NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDomain";
 
@@ -166,6 +167,8 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     configuration.maxRetryCount = self.maxRetryCount;
     configuration.timeoutIntervalForRequest = self.timeoutIntervalForRequest;
     configuration.timeoutIntervalForResource = self.timeoutIntervalForResource;
+    configuration.requestCompressionPolicy = self.requestCompressionPolicy;
+    configuration.inflatesGZIPResponses = self.inflatesGZIPResponses;
 
     return configuration;
 }
@@ -223,6 +226,14 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     if (!self.retryHandler) {
         self.retryHandler = configuration.retryHandler;
     }
+
+    if (!self.requestCompressionPolicy) {
+        self.requestCompressionPolicy = configuration.requestCompressionPolicy;
+    }
+
+    if (configuration.inflatesGZIPResponses) {
+        self.inflatesGZIPResponses = YES;
+    }
 }
 
 - (void)setTask:(NSURLSessionTask *)task {
@@ -278,6 +289,7 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     encodingBehaviors[@"shouldWriteDirectly"] = @(AWSMTLModelEncodingBehaviorUnconditional);
 
     encodingBehaviors[@"downloadProgress"] = @(AWSMTLModelEncodingBehaviorExcluded);
+    encodingBehaviors[@"dataReceived"] = @(AWSMTLModelEncodingBehaviorExcluded);
     encodingBehaviors[@"internalRequest"] = @(AWSMTLModelEncodingBehaviorExcluded);
     encodingBehaviors[@"uploadProgress"] = @(AWSMTLModelEncodingBehaviorExcluded);
 
@@ -301,6 +313,13 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
 
 // This may be a bug in our version of Mantle--despite declaring these properties as "excluded",
 // Mantle attempts to decode them from an archive, and fails when it cannot find the field name.
+- (nullable id)decodeDataReceivedWithCoder:(NSCoder *)coder
+                              modelVersion:(NSUInteger)modelVersion {
+    return NULL;
+}
+
+// This may be a bug in our version of Mantle--despite declaring these properties as "excluded",
+// Mantle attempts to decode them from an archive, and fails when it cannot find the field name.
 - (nullable id)decodeInternalRequestWithCoder:(NSCoder *)coder
                                  modelVersion:(NSUInteger)modelVersion {
     return NULL;
@@ -321,6 +340,10 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     self.internalRequest.downloadProgress = downloadProgress;
 }
 
+- (void)setDataReceived:(AWSNetworkingDataReceivedBlock)dataReceived {
+    self.internalRequest.dataReceived = dataReceived;
+}
+
 - (BOOL)isCancelled {
     return [self.internalRequest isCancelled];
 }
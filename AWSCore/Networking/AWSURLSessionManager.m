@@ -20,6 +20,8 @@
 #import "AWSSignature.h"
 #import "AWSBolts.h"
 #import "AWSCredentialsProvider.h"
+#import "AWSRequestCompression.h"
+#import "AWSResponseDecompression.h"
 
 NSString* const AWSResponseObjectErrorUserInfoKey = @"ResponseObjectError";
 
@@ -27,6 +29,11 @@ NSString* const AWSResponseObjectErrorUserInfoKey = @"ResponseObjectError";
 
 static NSString* const AWSMobileURLSessionManagerCacheDomain = @"com.amazonaws.AWSURLSessionManager";
 
+// The number of idle response inflaters kept for reuse by a session manager.
+static const NSUInteger AWSURLSessionManagerMaximumIdleInflaters = 4;
+// Content-Length is set by the server, so it only presizes the buffer up to this length. Larger bodies grow as they arrive.
+static const NSUInteger AWSURLSessionManagerMaximumPresizedResponseLength = 1024 * 1024;
+
 typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
     AWSURLSessionTaskTypeUnknown,
     AWSURLSessionTaskTypeData,
@@ -50,6 +57,10 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 @property (nonatomic, strong) NSURL *tempDownloadedFileURL;
 @property (nonatomic, assign) BOOL shouldWriteDirectly;
 @property (nonatomic, assign) BOOL shouldWriteToFile;
+@property (nonatomic, assign) BOOL shouldStreamResponse;
+@property (nonatomic, assign) BOOL shouldInflateResponse;
+@property (nonatomic, strong) AWSGZIPResponseInflater *inflater;
+@property (nonatomic, assign) int64_t totalBytesReceived;
 
 @property (atomic, assign) int64_t lastTotalLengthOfChunkSignatureSent;
 @property (atomic, assign) int64_t payloadTotalBytesWritten;
@@ -84,6 +95,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
 @property (nonatomic, strong) NSURLSession *session;
 @property (nonatomic, strong) AWSSynchronizedMutableDictionary *sessionManagerDelegates;
+@property (nonatomic, strong) NSMutableArray<AWSGZIPResponseInflater *> *idleInflaters;
 @property (nonatomic) BOOL isSessionValid;
 
 @end
@@ -121,6 +133,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                                                  delegate:self
                                             delegateQueue:nil];
         _sessionManagerDelegates = [AWSSynchronizedMutableDictionary new];
+        _idleInflaters = [NSMutableArray new];
         _isSessionValid = YES;
     }
 
@@ -153,6 +166,9 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
     if (delegate.downloadingFileURL) delegate.shouldWriteToFile = YES;
     delegate.responseData = nil;
+    delegate.shouldStreamResponse = NO;
+    delegate.shouldInflateResponse = NO;
+    delegate.totalBytesReceived = 0;
     delegate.responseObject = nil;
     delegate.error = nil;
     NSMutableURLRequest *mutableRequest = [NSMutableURLRequest requestWithURL:delegate.request.URL];
@@ -176,6 +192,15 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                                                 parameters:request.parameters];
     }
 
+    // Compresses the body before the interceptors sign it.
+    AWSRequestCompressionPolicy *requestCompressionPolicy = request.requestCompressionPolicy;
+    if (requestCompressionPolicy) {
+        task = [task continueWithSuccessBlock:^id(AWSTask *task) {
+            [requestCompressionPolicy compressRequest:mutableRequest];
+            return nil;
+        }];
+    }
+
     for(id<AWSNetworkingRequestInterceptor>interceptor in request.requestInterceptors) {
         task = [task continueWithSuccessBlock:^id(AWSTask *task) {
             return [interceptor interceptRequest:mutableRequest];
@@ -266,6 +291,16 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
             [delegate.responseFilehandle closeFile];
         }
 
+        if (delegate.inflater) {
+            NSError *inflaterError = nil;
+            if (!error && !delegate.error && ![delegate.inflater finishWithError:&inflaterError]) {
+                AWSDDLogError(@"Error: [%@]", inflaterError);
+                delegate.error = inflaterError;
+            }
+            [self enqueueInflater:delegate.inflater];
+            delegate.inflater = nil;
+        }
+
         if (!delegate.error) {
             delegate.error = error;
         }
@@ -348,9 +383,12 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
             }
         }
 
+        // A retry would hand the body to `dataReceived` again from its first byte, so streamed responses are not retried.
+        BOOL hasStreamedResponseBody = delegate.totalBytesReceived > 0;
         if (delegate.error
             && ([sessionTask.response isKindOfClass:[NSHTTPURLResponse class]] || sessionTask.response == nil)
-            && delegate.request.retryHandler) {
+            && delegate.request.retryHandler
+            && !hasStreamedResponseBody) {
             AWSNetworkingRetryType retryType = [delegate.request.retryHandler shouldRetry:delegate.currentRetryCount
                                                                           originalRequest:delegate.request
                                                                                  response:(NSHTTPURLResponse *)sessionTask.response
@@ -480,6 +518,23 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
             // got error status code, avoid write data to disk
             delegate.shouldWriteToFile = NO;
         }
+
+        // Successful bodies are handed to `dataReceived` as they arrive, error bodies are still buffered for the response serializer.
+        delegate.shouldStreamResponse = (delegate.request.dataReceived
+                                         && !delegate.shouldWriteToFile
+                                         && httpResponse.statusCode >= 200 && httpResponse.statusCode < 300);
+        // Whether the body is gzip is known from its first bytes, see `URLSession:dataTask:didReceiveData:`. The
+        // `Content-Encoding` header cannot tell, as the URL session keeps it after decoding the body itself.
+        delegate.shouldInflateResponse = (delegate.request.inflatesGZIPResponses
+                                          && httpResponse.statusCode >= 200 && httpResponse.statusCode < 300);
+    }
+
+    // Presize the in-memory buffer from Content-Length so that appending chunks of most bodies never reallocates and copies them.
+    if (!delegate.shouldWriteToFile
+        && !delegate.shouldStreamResponse
+        && response.expectedContentLength > 0) {
+        NSUInteger capacity = (NSUInteger)MIN(response.expectedContentLength, (int64_t)AWSURLSessionManagerMaximumPresizedResponseLength);
+        delegate.responseData = [NSMutableData dataWithCapacity:capacity];
     }
     
     @try {
@@ -557,28 +612,33 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
 - (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
     AWSURLSessionManagerDelegate *delegate = [self.sessionManagerDelegates objectForKey:@(dataTask.taskIdentifier)];
-    
-    if (delegate.responseFilehandle) {
-        @try{
-            [delegate.responseFilehandle writeData:data];
+
+    if (delegate.shouldInflateResponse && !delegate.inflater) {
+        if ([AWSGZIPResponseInflater isGZIPData:data]) {
+            delegate.inflater = [self dequeueInflater];
+        } else {
+            // The body is not compressed, or the URL session already decoded its Content-Encoding.
+            delegate.shouldInflateResponse = NO;
         }
-        @catch (NSException *exception) {
-            NSString *desc = [NSString stringWithFormat:@"Failed to write data: %@", exception];
-            NSDictionary *userInfo = @{
-                                       NSLocalizedDescriptionKey:  desc
-                                       };
-            AWSDDLogError(@"Error: [%@]", exception);
-            delegate.error = [NSError errorWithDomain:AWSNetworkingErrorDomain code:AWSNetworkingErrorUnknown userInfo: userInfo];
+    }
+
+    if (delegate.inflater) {
+        NSError *error = nil;
+        BOOL inflated = [delegate.inflater inflateData:data usingBlock:^(const void *bytes, NSUInteger length) {
+            [self delegate:delegate
+                  dataTask:dataTask
+        didReceiveBodyData:[NSData dataWithBytesNoCopy:(void *)bytes length:length freeWhenDone:NO]
+                 transient:YES];
+        } error:&error];
+        if (!inflated) {
+            AWSDDLogError(@"Error: [%@]", error);
+            delegate.error = error;
             [dataTask cancel];
         }
     } else {
-        if (!delegate.responseData) {
-            delegate.responseData = [NSMutableData dataWithData:data];
-        } else if ([delegate.responseData isKindOfClass:[NSMutableData class]]) {
-            [delegate.responseData appendData:data];
-        }
+        [self delegate:delegate dataTask:dataTask didReceiveBodyData:data transient:NO];
     }
-    
+
     AWSNetworkingDownloadProgressBlock downloadProgress = delegate.request.downloadProgress;
     if (downloadProgress) {
 
@@ -602,6 +662,60 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
 #pragma mark - Helper methods
 
+// Writes, streams or buffers a chunk of the response body. Transient data only lives until this method returns.
+- (void)delegate:(AWSURLSessionManagerDelegate *)delegate
+        dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveBodyData:(NSData *)data
+       transient:(BOOL)transient {
+    if (delegate.responseFilehandle) {
+        @try{
+            [delegate.responseFilehandle writeData:data];
+        }
+        @catch (NSException *exception) {
+            NSString *desc = [NSString stringWithFormat:@"Failed to write data: %@", exception];
+            NSDictionary *userInfo = @{
+                                       NSLocalizedDescriptionKey:  desc
+                                       };
+            AWSDDLogError(@"Error: [%@]", exception);
+            delegate.error = [NSError errorWithDomain:AWSNetworkingErrorDomain code:AWSNetworkingErrorUnknown userInfo: userInfo];
+            [dataTask cancel];
+        }
+    } else if (delegate.shouldStreamResponse) {
+        delegate.totalBytesReceived += [data length];
+        // The decompressed length is not known in advance.
+        int64_t totalBytesExpectedToReceive = delegate.inflater ? NSURLResponseUnknownLength : dataTask.response.expectedContentLength;
+        delegate.request.dataReceived(transient ? [NSData dataWithBytes:data.bytes length:data.length] : data,
+                                      delegate.totalBytesReceived,
+                                      totalBytesExpectedToReceive);
+    } else {
+        if (!delegate.responseData) {
+            delegate.responseData = [NSMutableData dataWithData:data];
+        } else if ([delegate.responseData isKindOfClass:[NSMutableData class]]) {
+            [delegate.responseData appendData:data];
+        }
+    }
+}
+
+- (AWSGZIPResponseInflater *)dequeueInflater {
+    @synchronized(self.idleInflaters) {
+        AWSGZIPResponseInflater *inflater = [self.idleInflaters lastObject];
+        if (inflater) {
+            [self.idleInflaters removeLastObject];
+            return inflater;
+        }
+    }
+    return [AWSGZIPResponseInflater new];
+}
+
+- (void)enqueueInflater:(AWSGZIPResponseInflater *)inflater {
+    [inflater reset];
+    @synchronized(self.idleInflaters) {
+        if ([self.idleInflaters count] < AWSURLSessionManagerMaximumIdleInflaters) {
+            [self.idleInflaters addObject:inflater];
+        }
+    }
+}
+
 - (void)printHTTPHeadersAndBodyForRequest:(NSURLRequest *)request {
     AWSDDLogDebug(@"Request headers:\n%@", request.allHTTPHeaderFields);
     if([AWSDDLog sharedInstance].logLevel & AWSDDLogFlagDebug){
@@ -0,0 +1,129 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The default minimum length in bytes of the request bodies compressed by `AWSRequestCompressionPolicy`.
+FOUNDATION_EXPORT const NSUInteger AWSRequestCompressionDefaultMinimumLength;
+
+/// The default minimum length in bytes of the request bodies compressed at the fast compression level.
+FOUNDATION_EXPORT const NSUInteger AWSRequestCompressionDefaultFastCompressionMinimumLength;
+
+#pragma mark - AWSRequestCompressor
+
+/**
+ Compresses request bodies into one `Content-Encoding`.
+ */
+@protocol AWSRequestCompressor <NSObject>
+
+/**
+ The `Content-Encoding` header value of the compressed bodies, for example `gzip`.
+ */
+@property (nonatomic, readonly) NSString *contentEncoding;
+
+/**
+ Compresses data.
+
+ @param data The data to compress.
+ @param level The zlib compression level, from `1` for the fastest to `9` for the smallest output. `-1` selects the zlib default.
+
+ @return The compressed data, or `nil` if `data` is empty or could not be compressed.
+ */
+- (nullable NSData *)compressData:(NSData *)data level:(int)level;
+
+@end
+
+#pragma mark - AWSGZIPRequestCompressor
+
+/**
+ Gzips request bodies with a streaming deflate. The input is fed to zlib in slices and the output is drained through a
+ fixed-size buffer, so no intermediate buffer grows with the body. The `z_stream` and its buffer are reset and reused
+ between bodies rather than allocated for each one; a small pool of them lets several threads compress at once.
+ */
+@interface AWSGZIPRequestCompressor : NSObject <AWSRequestCompressor>
+
+/**
+ Returns the compressor shared by the request pipeline.
+ */
++ (instancetype)sharedCompressor;
+
+@end
+
+#pragma mark - AWSRequestCompressionPolicy
+
+/**
+ Decides which request bodies are compressed before they are signed and sent, and at which compression level.
+
+ Set a policy as the `requestCompressionPolicy` of the configuration of a service that accepts the `Content-Encoding`
+ of its compressor. Bodies shorter than `minimumLength`, bodies that are streamed, and requests that already have a
+ `Content-Encoding` header are sent as they are. Larger bodies trade compression ratio for CPU time: they are
+ compressed at `compressionLevel` up to `fastCompressionMinimumLength` bytes and at `fastCompressionLevel` beyond it.
+ */
+@interface AWSRequestCompressionPolicy : NSObject <NSCopying>
+
+/**
+ The compressor of the request bodies. Defaults to `[AWSGZIPRequestCompressor sharedCompressor]`.
+ */
+@property (nonatomic, strong) id<AWSRequestCompressor> compressor;
+
+/**
+ The minimum length in bytes of the bodies to compress. Defaults to `AWSRequestCompressionDefaultMinimumLength`, 10 KB.
+ */
+@property (nonatomic, assign) NSUInteger minimumLength;
+
+/**
+ The compression level of the bodies shorter than `fastCompressionMinimumLength`. Defaults to `6`.
+ */
+@property (nonatomic, assign) int compressionLevel;
+
+/**
+ The minimum length in bytes of the bodies compressed at `fastCompressionLevel`. Defaults to
+ `AWSRequestCompressionDefaultFastCompressionMinimumLength`, 1 MB. Set to `0` to compress every body at
+ `compressionLevel`.
+ */
+@property (nonatomic, assign) NSUInteger fastCompressionMinimumLength;
+
+/**
+ The compression level of the bodies of at least `fastCompressionMinimumLength` bytes. Defaults to `1`.
+ */
+@property (nonatomic, assign) int fastCompressionLevel;
+
+/**
+ The largest ratio of compressed to original length worth sending compressed. Bodies that do not compress below it,
+ such as already compressed media, are sent as they are. Defaults to `0.9`.
+ */
+@property (nonatomic, assign) double maximumCompressionRatio;
+
+/**
+ Returns the compression level of a body.
+
+ @param length The length in bytes of the body.
+ */
+- (int)compressionLevelForLength:(NSUInteger)length;
+
+/**
+ Compresses the body of a request in place and sets its `Content-Encoding` header if the policy applies to it.
+
+ @param request The request to compress.
+
+ @return `YES` if the body was compressed.
+ */
+- (BOOL)compressRequest:(NSMutableURLRequest *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
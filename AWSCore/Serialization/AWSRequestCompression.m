@@ -0,0 +1,260 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSRequestCompression.h"
+
+#import <zlib.h>
+#import "AWSCocoaLumberjack.h"
+
+const NSUInteger AWSRequestCompressionDefaultMinimumLength = 10 * 1024;
+const NSUInteger AWSRequestCompressionDefaultFastCompressionMinimumLength = 1024 * 1024;
+
+static NSString *const AWSRequestCompressionContentEncodingHeader = @"Content-Encoding";
+static NSString *const AWSRequestCompressionContentLengthHeader = @"Content-Length";
+
+// The length of the output buffer drained after each call to deflate.
+static const NSUInteger AWSGZIPOutputBufferLength = 64 * 1024;
+// The length of the input slices fed to deflate, which keeps avail_in within a uInt.
+static const NSUInteger AWSGZIPInputSliceLength = 1024 * 1024;
+// The number of idle deflate contexts kept for reuse.
+static const NSUInteger AWSGZIPMaximumPooledContexts = 4;
+// windowBits of 15 plus 16 writes a gzip header and trailer instead of a zlib wrapper.
+static const int AWSGZIPWindowBits = 15 + 16;
+static const int AWSGZIPMemoryLevel = 8;
+
+#pragma mark - AWSGZIPDeflateContext
+
+@interface AWSGZIPDeflateContext : NSObject {
+@public
+    z_stream _stream;
+    uint8_t *_buffer;
+    int _level;
+}
+
+- (nullable instancetype)initWithLevel:(int)level;
+
+@end
+
+@implementation AWSGZIPDeflateContext
+
+- (instancetype)initWithLevel:(int)level {
+    if (self = [super init]) {
+        _stream.zalloc = Z_NULL;
+        _stream.zfree = Z_NULL;
+        _stream.opaque = Z_NULL;
+        if (deflateInit2(&_stream, level, Z_DEFLATED, AWSGZIPWindowBits, AWSGZIPMemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return nil;
+        }
+        _level = level;
+        _buffer = malloc(AWSGZIPOutputBufferLength);
+        if (!_buffer) {
+            deflateEnd(&_stream);
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    deflateEnd(&_stream);
+    free(_buffer);
+}
+
+/// Resets the stream for a new body, changing its level if needed. Returns NO if the stream cannot be reused.
+- (BOOL)resetWithLevel:(int)level {
+    if (deflateReset(&_stream) != Z_OK) {
+        return NO;
+    }
+    if (level != _level) {
+        // Nothing has been fed to the stream since the reset, so the parameters can change without a flush.
+        if (deflateParams(&_stream, level, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return NO;
+        }
+        _level = level;
+    }
+    return YES;
+}
+
+- (nullable NSData *)deflateData:(NSData *)data {
+    // Compressed request bodies are mostly JSON, which shrinks several times over.
+    NSMutableData *compressedData = [NSMutableData dataWithCapacity:data.length / 4 + 64];
+    const uint8_t *bytes = data.bytes;
+    NSUInteger remainingLength = data.length;
+    int status = Z_OK;
+    do {
+        uInt sliceLength = (uInt)MIN(remainingLength, AWSGZIPInputSliceLength);
+        _stream.next_in = (Bytef *)bytes;
+        _stream.avail_in = sliceLength;
+        bytes += sliceLength;
+        remainingLength -= sliceLength;
+        int flush = remainingLength == 0 ? Z_FINISH : Z_NO_FLUSH;
+        do {
+            _stream.next_out = _buffer;
+            _stream.avail_out = (uInt)AWSGZIPOutputBufferLength;
+            status = deflate(&_stream, flush);
+            if (status == Z_STREAM_ERROR) {
+                return nil;
+            }
+            [compressedData appendBytes:_buffer length:AWSGZIPOutputBufferLength - _stream.avail_out];
+        } while (_stream.avail_out == 0);
+    } while (remainingLength > 0);
+
+    return status == Z_STREAM_END ? compressedData : nil;
+}
+
+@end
+
+#pragma mark - AWSGZIPRequestCompressor
+
+@interface AWSGZIPRequestCompressor()
+
+@property (nonatomic, strong) NSMutableArray<AWSGZIPDeflateContext *> *idleContexts;
+
+@end
+
+@implementation AWSGZIPRequestCompressor
+
++ (instancetype)sharedCompressor {
+    static AWSGZIPRequestCompressor *_sharedCompressor = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _sharedCompressor = [AWSGZIPRequestCompressor new];
+    });
+    return _sharedCompressor;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _idleContexts = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (NSString *)contentEncoding {
+    return @"gzip";
+}
+
+- (NSData *)compressData:(NSData *)data level:(int)level {
+    if ([data length] == 0) {
+        return nil;
+    }
+    level = level < 0 ? Z_DEFAULT_COMPRESSION : MIN(level, Z_BEST_COMPRESSION);
+
+    AWSGZIPDeflateContext *context = [self dequeueContextWithLevel:level];
+    if (!context) {
+        AWSDDLogError(@"Failed to initialize the gzip deflate stream.");
+        return nil;
+    }
+    NSData *compressedData = [context deflateData:data];
+    if (!compressedData) {
+        AWSDDLogError(@"Failed to gzip %lu bytes.", (unsigned long)data.length);
+    }
+    [self enqueueContext:context];
+    return compressedData;
+}
+
+- (AWSGZIPDeflateContext *)dequeueContextWithLevel:(int)level {
+    AWSGZIPDeflateContext *context = nil;
+    @synchronized(self.idleContexts) {
+        // Prefers a context at the same level, which skips deflateParams.
+        for (AWSGZIPDeflateContext *idleContext in self.idleContexts) {
+            if (idleContext->_level == level) {
+                context = idleContext;
+                break;
+            }
+        }
+        context = context ?: [self.idleContexts lastObject];
+        if (context) {
+            [self.idleContexts removeObjectIdenticalTo:context];
+        }
+    }
+    if (context && [context resetWithLevel:level]) {
+        return context;
+    }
+    return [[AWSGZIPDeflateContext alloc] initWithLevel:level];
+}
+
+- (void)enqueueContext:(AWSGZIPDeflateContext *)context {
+    @synchronized(self.idleContexts) {
+        if ([self.idleContexts count] < AWSGZIPMaximumPooledContexts) {
+            [self.idleContexts addObject:context];
+        }
+    }
+}
+
+@end
+
+#pragma mark - AWSRequestCompressionPolicy
+
+@implementation AWSRequestCompressionPolicy
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _compressor = [AWSGZIPRequestCompressor sharedCompressor];
+        _minimumLength = AWSRequestCompressionDefaultMinimumLength;
+        _compressionLevel = 6;
+        _fastCompressionMinimumLength = AWSRequestCompressionDefaultFastCompressionMinimumLength;
+        _fastCompressionLevel = Z_BEST_SPEED;
+        _maximumCompressionRatio = 0.9;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    AWSRequestCompressionPolicy *policy = [[[self class] allocWithZone:zone] init];
+    policy.compressor = self.compressor;
+    policy.minimumLength = self.minimumLength;
+    policy.compressionLevel = self.compressionLevel;
+    policy.fastCompressionMinimumLength = self.fastCompressionMinimumLength;
+    policy.fastCompressionLevel = self.fastCompressionLevel;
+    policy.maximumCompressionRatio = self.maximumCompressionRatio;
+    return policy;
+}
+
+- (int)compressionLevelForLength:(NSUInteger)length {
+    if (self.fastCompressionMinimumLength > 0 && length >= self.fastCompressionMinimumLength) {
+        return self.fastCompressionLevel;
+    }
+    return self.compressionLevel;
+}
+
+- (BOOL)compressRequest:(NSMutableURLRequest *)request {
+    NSData *body = request.HTTPBody;
+    if (request.HTTPBodyStream
+        || [body length] == 0
+        || [body length] < self.minimumLength
+        || [request valueForHTTPHeaderField:AWSRequestCompressionContentEncodingHeader]) {
+        return NO;
+    }
+
+    NSData *compressedBody = [self.compressor compressData:body
+                                                     level:[self compressionLevelForLength:body.length]];
+    if (!compressedBody || compressedBody.length > body.length * self.maximumCompressionRatio) {
+        AWSDDLogVerbose(@"Sending the %lu byte request body uncompressed.", (unsigned long)body.length);
+        return NO;
+    }
+    AWSDDLogVerbose(@"Compressed the request body from %lu to %lu bytes.",
+                    (unsigned long)body.length, (unsigned long)compressedBody.length);
+
+    request.HTTPBody = compressedBody;
+    [request setValue:self.compressor.contentEncoding forHTTPHeaderField:AWSRequestCompressionContentEncodingHeader];
+    if ([request valueForHTTPHeaderField:AWSRequestCompressionContentLengthHeader]) {
+        [request setValue:[NSString stringWithFormat:@"%lu", (unsigned long)compressedBody.length]
+       forHTTPHeaderField:AWSRequestCompressionContentLengthHeader];
+    }
+    return YES;
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString *const AWSGZIPResponseInflaterErrorDomain;
+typedef NS_ENUM(NSInteger, AWSGZIPResponseInflaterErrorType) {
+    AWSGZIPResponseInflaterErrorUnknown,
+    AWSGZIPResponseInflaterErrorInvalidData,
+    AWSGZIPResponseInflaterErrorTruncatedData,
+};
+
+/// The default length in bytes of the buffer that `AWSGZIPResponseInflater` decompresses into.
+FOUNDATION_EXPORT const NSUInteger AWSGZIPResponseInflaterDefaultOutputBufferLength;
+
+/**
+ Called with each run of decompressed bytes. The bytes are only valid until the block returns.
+ */
+typedef void (^AWSGZIPResponseInflaterOutputBlock)(const void *bytes, NSUInteger length);
+
+/**
+ Decompresses a gzip body incrementally, chunk by chunk as it arrives. Each chunk is inflated into a fixed-size output
+ buffer that is handed to a block every time it fills, so memory stays proportional to the buffer rather than to the
+ body. Concatenated gzip members are decompressed one after the other.
+
+ An inflater decompresses one body at a time. Call `reset` to reuse its inflate stream and buffer for another body.
+ */
+@interface AWSGZIPResponseInflater : NSObject
+
+/**
+ Returns `YES` if the data starts with the gzip magic bytes.
+ */
++ (BOOL)isGZIPData:(NSData *)data;
+
+/**
+ Creates an inflater with an output buffer of `AWSGZIPResponseInflaterDefaultOutputBufferLength` bytes.
+ */
+- (instancetype)init;
+
+/**
+ Creates an inflater.
+
+ @param outputBufferLength The length in bytes of the buffer handed to the output block.
+ */
+- (instancetype)initWithOutputBufferLength:(NSUInteger)outputBufferLength NS_DESIGNATED_INITIALIZER;
+
+/**
+ The number of compressed bytes inflated since the last reset.
+ */
+@property (nonatomic, readonly) int64_t totalBytesIn;
+
+/**
+ The number of decompressed bytes produced since the last reset.
+ */
+@property (nonatomic, readonly) int64_t totalBytesOut;
+
+/**
+ Decompresses the next chunk of the body.
+
+ @param data The next chunk of the compressed body.
+ @param block Called with each run of decompressed bytes, on the calling thread, before this method returns.
+ @param error Set to an `AWSGZIPResponseInflaterErrorDomain` error if the body is not valid gzip.
+
+ @return `NO` if the body is not valid gzip. The inflater must then be reset before it is used again.
+ */
+- (BOOL)inflateData:(NSData *)data
+         usingBlock:(AWSGZIPResponseInflaterOutputBlock)block
+              error:(NSError **)error;
+
+/**
+ Checks that the body ended with a complete gzip member.
+
+ @return `NO` and sets `error` if the body was cut short.
+ */
+- (BOOL)finishWithError:(NSError **)error;
+
+/**
+ Resets the inflater for a new body.
+ */
+- (void)reset;
+
+@end
+
+@interface NSData (AWSGZIPResponseInflater)
+
+/**
+ Returns the data decompressed with a streaming inflater, or `nil` if it is not valid gzip.
+ */
+- (nullable NSData *)aws_inflatedGZIPData;
+
+@end
+
+NS_ASSUME_NONNULL_END
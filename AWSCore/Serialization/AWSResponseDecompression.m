@@ -0,0 +1,186 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSResponseDecompression.h"
+
+#import <zlib.h>
+
+NSString *const AWSGZIPResponseInflaterErrorDomain = @"com.amazonaws.AWSGZIPResponseInflaterErrorDomain";
+
+const NSUInteger AWSGZIPResponseInflaterDefaultOutputBufferLength = 64 * 1024;
+
+// The length of the input slices fed to inflate, which keeps avail_in within a uInt.
+static const NSUInteger AWSGZIPResponseInflaterInputSliceLength = 1024 * 1024;
+// windowBits of 15 plus 32 accepts both gzip and zlib headers.
+static const int AWSGZIPResponseInflaterWindowBits = 15 + 32;
+
+@interface AWSGZIPResponseInflater() {
+    z_stream _stream;
+    uint8_t *_buffer;
+    NSUInteger _bufferLength;
+    BOOL _streamInitialized;
+    BOOL _memberEnded;
+    BOOL _failed;
+}
+
+@property (nonatomic, assign) int64_t totalBytesIn;
+@property (nonatomic, assign) int64_t totalBytesOut;
+
+@end
+
+@implementation AWSGZIPResponseInflater
+
++ (BOOL)isGZIPData:(NSData *)data {
+    if ([data length] < 2) {
+        return NO;
+    }
+    const uint8_t *bytes = data.bytes;
+    return bytes[0] == 0x1f && bytes[1] == 0x8b;
+}
+
+- (instancetype)init {
+    return [self initWithOutputBufferLength:AWSGZIPResponseInflaterDefaultOutputBufferLength];
+}
+
+- (instancetype)initWithOutputBufferLength:(NSUInteger)outputBufferLength {
+    if (self = [super init]) {
+        _bufferLength = MAX(MIN(outputBufferLength, (NSUInteger)UINT32_MAX), 1);
+        _buffer = malloc(_bufferLength);
+        _stream.zalloc = Z_NULL;
+        _stream.zfree = Z_NULL;
+        _stream.opaque = Z_NULL;
+        _stream.next_in = Z_NULL;
+        _stream.avail_in = 0;
+        _streamInitialized = _buffer && inflateInit2(&_stream, AWSGZIPResponseInflaterWindowBits) == Z_OK;
+        _failed = !_streamInitialized;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_streamInitialized) {
+        inflateEnd(&_stream);
+    }
+    free(_buffer);
+}
+
+- (BOOL)inflateData:(NSData *)data
+         usingBlock:(AWSGZIPResponseInflaterOutputBlock)block
+              error:(NSError **)error {
+    if (_failed) {
+        return [self failWithErrorType:AWSGZIPResponseInflaterErrorInvalidData
+                           description:@"The inflater failed earlier and must be reset."
+                                 error:error];
+    }
+
+    const uint8_t *bytes = data.bytes;
+    NSUInteger remainingLength = data.length;
+    while (remainingLength > 0) {
+        uInt sliceLength = (uInt)MIN(remainingLength, AWSGZIPResponseInflaterInputSliceLength);
+        _stream.next_in = (Bytef *)bytes;
+        _stream.avail_in = sliceLength;
+        bytes += sliceLength;
+        remainingLength -= sliceLength;
+        self.totalBytesIn += sliceLength;
+
+        do {
+            if (_memberEnded) {
+                if (_stream.avail_in == 0) {
+                    break;
+                }
+                // Another gzip member follows the one that ended.
+                inflateReset(&_stream);
+                _memberEnded = NO;
+            }
+            _stream.next_out = _buffer;
+            _stream.avail_out = (uInt)_bufferLength;
+            int status = inflate(&_stream, Z_NO_FLUSH);
+            if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+                _failed = YES;
+                NSString *description = [NSString stringWithFormat:@"Failed to inflate the response body: %s (%d).",
+                                         _stream.msg ?: "unknown error", status];
+                return [self failWithErrorType:AWSGZIPResponseInflaterErrorInvalidData
+                                   description:description
+                                         error:error];
+            }
+
+            NSUInteger outputLength = _bufferLength - _stream.avail_out;
+            if (outputLength > 0) {
+                self.totalBytesOut += outputLength;
+                block(_buffer, outputLength);
+            }
+            if (status == Z_STREAM_END) {
+                _memberEnded = YES;
+            } else if (status == Z_BUF_ERROR) {
+                // No progress is possible until more input arrives.
+                break;
+            }
+        } while (_stream.avail_in > 0 || _stream.avail_out == 0);
+    }
+    return YES;
+}
+
+- (BOOL)finishWithError:(NSError **)error {
+    if (_failed) {
+        return [self failWithErrorType:AWSGZIPResponseInflaterErrorInvalidData
+                           description:@"The response body is not valid gzip."
+                                 error:error];
+    }
+    if (self.totalBytesIn > 0 && !_memberEnded) {
+        return [self failWithErrorType:AWSGZIPResponseInflaterErrorTruncatedData
+                           description:@"The gzip response body was cut short."
+                                 error:error];
+    }
+    return YES;
+}
+
+- (void)reset {
+    if (_streamInitialized) {
+        _failed = inflateReset(&_stream) != Z_OK;
+    }
+    _memberEnded = NO;
+    self.totalBytesIn = 0;
+    self.totalBytesOut = 0;
+}
+
+- (BOOL)failWithErrorType:(AWSGZIPResponseInflaterErrorType)errorType
+              description:(NSString *)description
+                    error:(NSError **)error {
+    if (error) {
+        *error = [NSError errorWithDomain:AWSGZIPResponseInflaterErrorDomain
+                                     code:errorType
+                                 userInfo:@{NSLocalizedDescriptionKey: description}];
+    }
+    return NO;
+}
+
+@end
+
+@implementation NSData (AWSGZIPResponseInflater)
+
+- (NSData *)aws_inflatedGZIPData {
+    AWSGZIPResponseInflater *inflater = [AWSGZIPResponseInflater new];
+    NSMutableData *inflatedData = [NSMutableData dataWithCapacity:self.length * 4];
+    BOOL inflated = [inflater inflateData:self
+                               usingBlock:^(const void *bytes, NSUInteger length) {
+        [inflatedData appendBytes:bytes length:length];
+    } error:nil];
+    if (!inflated || ![inflater finishWithError:nil]) {
+        return nil;
+    }
+    return inflatedData;
+}
+
+@end
@@ -113,7 +113,8 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     if ([params count] == 0) {
         return nil;
     }
-    NSData *resultData = [[self xmlBuildForDictionary:params actionName:actionName serviceDefinitionRule:serviceDefinitionRule  error:error] toData];
+    // The writer already holds UTF-8 bytes, so hand its buffer over as the body instead of copying it.
+    NSData *resultData = [[self xmlBuildForDictionary:params actionName:actionName serviceDefinitionRule:serviceDefinitionRule  error:error] detachData];
 
     return resultData;
 }
@@ -14,7 +14,7 @@
 //
 #import "AWSURLRequestSerialization.h"
 
-#import "AWSGZIP.h"
+#import "AWSRequestCompression.h"
 #import "AWSBolts.h"
 #import "AWSNetworking.h"
 #import "AWSValidation.h"
@@ -114,7 +114,7 @@
         if (!error) {
             if (headers[@"Content-Encoding"] && [headers[@"Content-Encoding"] rangeOfString:@"gzip"].location != NSNotFound) {
                 //gzip the body
-                request.HTTPBody = [bodyData awsgzip_gzippedData];
+                request.HTTPBody = [[AWSGZIPRequestCompressor sharedCompressor] compressData:bodyData level:-1];
             } else {
                 request.HTTPBody = bodyData;
             }
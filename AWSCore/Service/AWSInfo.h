@@ -28,6 +28,10 @@ FOUNDATION_EXPORT NSString *const AWSInfoDefault;
  */
 @interface AWSInfo : NSObject
 
+/**
+ * A copy of the configuration taken when the object was created. Later changes to the dictionary it was created from
+ * are not reflected.
+ */
 @property (nonatomic, readonly) NSDictionary <NSString *, id> *rootInfoDictionary;
 
 /**
@@ -35,6 +35,8 @@ static NSString *const AWSInfoIdentityManager = @"IdentityManager";
 @property (nonatomic, strong) AWSCognitoCredentialsProvider *defaultCognitoCredentialsProvider;
 @property (nonatomic, assign) AWSRegionType defaultRegion;
 @property (nonatomic, strong) NSDictionary <NSString *, id> *rootInfoDictionary;
+// Service infos by service name and key. `NSNull` marks a service that is not configured.
+@property (nonatomic, strong) NSMutableDictionary <NSString *, id> *serviceInfos;
 
 @end
 
@@ -43,10 +45,30 @@ static NSString *const AWSInfoIdentityManager = @"IdentityManager";
 @property (nonatomic, strong) NSDictionary <NSString *, id> *infoDictionary;
 
 - (instancetype)initWithInfoDictionary:(NSDictionary <NSString *, id> *)infoDictionary
-                           serviceName:(NSString *) serviceName;
+                           serviceName:(NSString *)serviceName
+                                  info:(AWSInfo *)info;
 
 @end
 
+// Copies the configuration so that later changes to the dictionaries it was given cannot reach the snapshot.
+static id AWSInfoImmutableCopy(id object) {
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        NSMutableDictionary *copy = [NSMutableDictionary dictionaryWithCapacity:[object count]];
+        [object enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+            copy[key] = AWSInfoImmutableCopy(value);
+        }];
+        return [copy copy];
+    }
+    if ([object isKindOfClass:[NSArray class]]) {
+        NSMutableArray *copy = [NSMutableArray arrayWithCapacity:[object count]];
+        for (id value in object) {
+            [copy addObject:AWSInfoImmutableCopy(value)];
+        }
+        return [copy copy];
+    }
+    return [object copy];
+}
+
 @implementation AWSInfo
 
 static AWSInfo *_defaultAWSInfo = nil;
@@ -55,7 +77,8 @@ static AWSServiceConfiguration *_identityPoolConfiguration = nil;
 
 - (instancetype)initWithConfiguration:(NSDictionary<NSString *, id> *)config {
     if (self = [super init]) {
-        _rootInfoDictionary = config;
+        _rootInfoDictionary = AWSInfoImmutableCopy(config);
+        _serviceInfos = [NSMutableDictionary new];
 
         if (_rootInfoDictionary) {
             NSString *userAgent = [self.rootInfoDictionary objectForKey:AWSInfoUserAgent];
@@ -143,14 +166,29 @@ static AWSServiceConfiguration *_identityPoolConfiguration = nil;
 }
 
 + (void)overrideCredentialsProvider:(AWSCognitoCredentialsProvider *)cognitoCredentialsProvider {
-    AWSInfo.defaultAWSInfo.defaultCognitoCredentialsProvider = cognitoCredentialsProvider;
+    AWSInfo *info = AWSInfo.defaultAWSInfo;
+    @synchronized(info) {
+        info.defaultCognitoCredentialsProvider = cognitoCredentialsProvider;
+        // The service infos hand out the credentials provider they were created with.
+        [info.serviceInfos removeAllObjects];
+    }
 }
 
 - (AWSServiceInfo *)serviceInfo:(NSString *)serviceName
                          forKey:(NSString *)key {
-    NSDictionary <NSString *, id> *infoDictionary = [[self.rootInfoDictionary objectForKey:serviceName] objectForKey:key];
-    return [[AWSServiceInfo alloc] initWithInfoDictionary:infoDictionary
-                                              serviceName:serviceName];
+    NSString *cacheKey = [NSString stringWithFormat:@"%@\n%@", serviceName, key];
+    @synchronized(self) {
+        id serviceInfo = [self.serviceInfos objectForKey:cacheKey];
+        if (!serviceInfo) {
+            NSDictionary <NSString *, id> *infoDictionary = [[self.rootInfoDictionary objectForKey:serviceName] objectForKey:key];
+            serviceInfo = [[AWSServiceInfo alloc] initWithInfoDictionary:infoDictionary
+                                                             serviceName:serviceName
+                                                                    info:self];
+            [self.serviceInfos setObject:serviceInfo ?: [NSNull null]
+                                  forKey:cacheKey];
+        }
+        return serviceInfo == [NSNull null] ? nil : serviceInfo;
+    }
 }
 
 - (AWSServiceInfo *)defaultServiceInfo:(NSString *)serviceName {
@@ -163,7 +201,8 @@ static AWSServiceConfiguration *_identityPoolConfiguration = nil;
 @implementation AWSServiceInfo
 
 - (instancetype)initWithInfoDictionary:(NSDictionary <NSString *, id> *)infoDictionary
-                           serviceName:(NSString *) serviceName {
+                           serviceName:(NSString *)serviceName
+                                  info:(AWSInfo *)info {
     if (self = [super init]) {
         BOOL checkRegion = ![serviceName isEqualToString:AWSInfoIdentityManager];
         _infoDictionary = infoDictionary;
@@ -171,11 +210,11 @@ static AWSServiceConfiguration *_identityPoolConfiguration = nil;
             _infoDictionary = @{};
         }
         
-        _cognitoCredentialsProvider = [AWSInfo defaultAWSInfo].defaultCognitoCredentialsProvider;
+        _cognitoCredentialsProvider = info.defaultCognitoCredentialsProvider;
         
         _region = [[_infoDictionary objectForKey:AWSInfoRegion] aws_regionTypeValue];
         if (_region == AWSRegionUnknown) {
-            _region = [AWSInfo defaultAWSInfo].defaultRegion;
+            _region = info.defaultRegion;
         }
         
         //If there is no credentials provider configured and this isn't Cognito User Pools (which
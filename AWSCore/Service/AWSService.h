@@ -80,6 +80,42 @@ typedef NS_ENUM(NSInteger, AWSServiceErrorType) {
  */
 + (instancetype)defaultServiceManager;
 
+/**
+ Registers a block that creates a service client the first time it is requested with `serviceClientForKey:`. Registering is cheap, so all of the clients of an app can be registered on the launch path and each of them is built when it is first used. Registering a block for a key replaces the earlier registration and the client it built.
+
+ @param block The block that creates the client. It is called at most once, on the thread that first requests the client.
+ @param key   A string to identify the client.
+ */
+- (void)registerServiceClientWithBlock:(id (^)(void))block
+                                forKey:(NSString *)key;
+
+/**
+ Returns the service client registered for the key, creating it if this is the first time it is requested.
+
+ @param key A string to identify the client.
+
+ @return The service client, or `nil` if no client is registered for the key.
+ */
+- (id)serviceClientForKey:(NSString *)key;
+
+/**
+ Removes the service client registered for the key.
+
+ @param key A string to identify the client.
+ */
+- (void)removeServiceClientForKey:(NSString *)key;
+
+/**
+ Loads `AWSInfo` and the service definitions of the services on background threads, in parallel with each other and with the caller, so that the first request of each service does not have to. The definition of a service named `X` is the `AWSXResources` class of its SDK, for example `S3`, `DynamoDB` or `PinpointTargeting`; services whose SDK is not linked are skipped.
+
+ Call `+[AWSInfo configureDefaultAWSInfo:]` before this method if the configuration is not loaded from `awsconfiguration.json`.
+
+ @param serviceNames The names of the services.
+
+ @return A task that completes when all of the definitions are loaded. Its result is the names of the services that were loaded.
+ */
+- (AWSTask<NSArray<NSString *> *> *)preloadServiceDefinitions:(NSArray<NSString *> *)serviceNames;
+
 @end
 
 #pragma mark - AWSServiceConfiguration
@@ -20,6 +20,9 @@
 #import "AWSURLResponseSerialization.h"
 #import "AWSCocoaLumberjack.h"
 #import "AWSCategory.h"
+#import "AWSInfo.h"
+#import "AWSTask.h"
+#import "AWSExecutor.h"
 
 NSString *const AWSiOSSDKVersion = @"2.36.3";
 NSString *const AWSServiceErrorDomain = @"com.amazonaws.AWSServiceErrorDomain";
@@ -64,8 +67,28 @@ static NSString *const AWSServiceConfigurationUnknown = @"Unknown";
 
 #pragma mark - AWSServiceManager
 
+// The shape of the `AWS<Service>Resources` classes that hold the service definitions.
+@protocol AWSServiceResources <NSObject>
+
++ (instancetype)sharedInstance;
+
+@end
+
+// A service client that is created when it is first requested.
+@interface AWSServiceClientRegistration : NSObject
+
+@property (nonatomic, copy) id (^block)(void);
+@property (nonatomic, strong) id client;
+
+@end
+
+@implementation AWSServiceClientRegistration
+
+@end
+
 @interface AWSServiceManager()
 
+// Service client registrations by key.
 @property (nonatomic, strong) AWSSynchronizedMutableDictionary *dictionary;
 
 @end
@@ -97,6 +120,60 @@ static NSString *const AWSServiceConfigurationUnknown = @"Unknown";
     });
 }
 
+- (void)registerServiceClientWithBlock:(id (^)(void))block
+                                forKey:(NSString *)key {
+    AWSServiceClientRegistration *registration = [AWSServiceClientRegistration new];
+    registration.block = block;
+    [self.dictionary setObject:registration
+                        forKey:key];
+}
+
+- (id)serviceClientForKey:(NSString *)key {
+    AWSServiceClientRegistration *registration = [self.dictionary objectForKey:key];
+    // Each registration has its own lock, so that different clients can be created at the same time.
+    @synchronized(registration) {
+        if (registration.block) {
+            registration.client = registration.block();
+            registration.block = nil;
+        }
+        return registration.client;
+    }
+}
+
+- (void)removeServiceClientForKey:(NSString *)key {
+    [self.dictionary removeObjectForKey:key];
+}
+
+- (AWSTask<NSArray<NSString *> *> *)preloadServiceDefinitions:(NSArray<NSString *> *)serviceNames {
+    // The default executor may run the blocks on the calling thread.
+    AWSExecutor *executor = [AWSExecutor executorWithDispatchQueue:dispatch_get_global_queue(QOS_CLASS_UTILITY, 0)];
+    NSMutableArray<AWSTask<NSString *> *> *tasks = [NSMutableArray arrayWithCapacity:serviceNames.count];
+    for (NSString *serviceName in serviceNames) {
+        [tasks addObject:[AWSTask taskFromExecutor:executor withBlock:^id _Nullable{
+            [[AWSInfo defaultAWSInfo] defaultServiceInfo:serviceName];
+
+            Class<AWSServiceResources> resourcesClass = NSClassFromString([NSString stringWithFormat:@"AWS%@Resources", serviceName]);
+            if (![resourcesClass respondsToSelector:@selector(sharedInstance)]) {
+                AWSDDLogDebug(@"Couldn't find the service definition of %@. Skipping it.", serviceName);
+                return nil;
+            }
+            // The definition is parsed once, when the shared instance is created.
+            [resourcesClass sharedInstance];
+            return serviceName;
+        }]];
+    }
+
+    return [[AWSTask taskForCompletionOfAllTasks:tasks] continueWithSuccessBlock:^id _Nullable(AWSTask *task) {
+        NSMutableArray<NSString *> *loadedServiceNames = [NSMutableArray arrayWithCapacity:tasks.count];
+        for (AWSTask<NSString *> *serviceTask in tasks) {
+            if (serviceTask.result) {
+                [loadedServiceNames addObject:serviceTask.result];
+            }
+        }
+        return loadedServiceNames;
+    }];
+}
+
 @end
 
 #pragma mark - AWSServiceConfiguration
@@ -30,8 +30,16 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class AWSUICKeyChainStore;
+
 extern NSString * const AWSUICKeyChainStoreErrorDomain;
 
+/// Post this notification when keychain items were changed outside of `AWSUICKeyChainStore`, for example by an app
+/// extension sharing an access group, to drop cached values. Set `AWSUICKeyChainStoreServiceKey` in the user info to
+/// drop only the values of that service; without it every cache is dropped.
+extern NSString * const AWSUICKeyChainStoreCacheInvalidationNotification;
+extern NSString * const AWSUICKeyChainStoreServiceKey;
+
 typedef NS_ENUM(NSInteger, AWSUICKeyChainStoreErrorCode) {
     AWSUICKeyChainStoreErrorInvalidArguments = 1,
 };
@@ -100,6 +108,30 @@ typedef NS_ENUM(NSInteger, AWSUICKeyChainStoreAuthenticationPolicy) {
     AWSUICKeyChainStoreAuthenticationPolicyUserPresence = kSecAccessControlUserPresence,
 };
 
+/// Storage for the items of generic password stores. The default is the keychain; tests and platforms without one
+/// can provide a stand-in, such as `AWSUICKeyChainStoreFileBackend`. Items are scoped by the store's `service` and
+/// `accessGroup`. Implementations must be thread safe.
+@protocol AWSUICKeyChainStoreBackend <NSObject>
+
+/// Returns nil without an error when there is no item for the key.
+- (nullable NSData *)dataForKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError * __nullable __autoreleasing * __nullable)error;
+- (BOOL)setData:(NSData *)data forKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError * __nullable __autoreleasing * __nullable)error;
+- (BOOL)removeItemForKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError * __nullable __autoreleasing * __nullable)error;
+- (BOOL)removeAllItemsForStore:(AWSUICKeyChainStore *)store error:(NSError * __nullable __autoreleasing * __nullable)error;
+- (NSArray UIC_KEY_TYPE *)allKeysForStore:(AWSUICKeyChainStore *)store;
+
+@end
+
+/// Keeps the items of each store in a property list file in a directory. Not protected like the keychain; meant for
+/// tests and for builds without a keychain.
+@interface AWSUICKeyChainStoreFileBackend : NSObject <AWSUICKeyChainStoreBackend>
+
+@property (nonatomic, readonly) NSURL *directoryURL;
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL;
+
+@end
+
 @interface AWSUICKeyChainStore : NSObject
 
 @property (nonatomic, readonly) AWSUICKeyChainStoreItemClass itemClass;
@@ -123,9 +155,24 @@ __OSX_AVAILABLE_STARTING(__MAC_NA, __IPHONE_8_0);
 @property (nonatomic, readonly, nullable) NSArray UIC_KEY_TYPE *allKeys;
 @property (nonatomic, readonly, nullable) NSArray *allItems;
 
+/// Keeps the values read from and written to this store in memory, so reading a value again does not query the
+/// keychain and writing a value that is already stored is skipped. The cache is shared by all stores with the same
+/// service and access group, and is updated on every write and remove made through them. Only used for generic
+/// password stores without an authentication policy. Defaults to `+ defaultCachingEnabled`.
+@property (nonatomic, getter=isCachingEnabled) BOOL cachingEnabled;
+
+/// Where generic password items are stored, or nil for the keychain. Defaults to `+ defaultBackend`.
+@property (nonatomic, strong, nullable) id<AWSUICKeyChainStoreBackend> backend;
+
 + (NSString *)defaultService;
 + (void)setDefaultService:(NSString *)defaultService;
 
++ (BOOL)defaultCachingEnabled;
++ (void)setDefaultCachingEnabled:(BOOL)defaultCachingEnabled;
+
++ (nullable id<AWSUICKeyChainStoreBackend>)defaultBackend;
++ (void)setDefaultBackend:(nullable id<AWSUICKeyChainStoreBackend>)defaultBackend;
+
 + (AWSUICKeyChainStore *)keyChainStore;
 + (AWSUICKeyChainStore *)keyChainStoreWithService:(nullable NSString *)service;
 + (AWSUICKeyChainStore *)keyChainStoreWithService:(nullable NSString *)service accessGroup:(nullable NSString *)accessGroup;
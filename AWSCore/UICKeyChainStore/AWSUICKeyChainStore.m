@@ -9,7 +9,163 @@
 #import "AWSUICKeyChainStore.h"
 
 NSString * const AWSUICKeyChainStoreErrorDomain = @"com.kishikawakatsumi.uickeychainstore";
+NSString * const AWSUICKeyChainStoreCacheInvalidationNotification = @"com.amazonaws.AWSUICKeyChainStoreCacheInvalidationNotification";
+NSString * const AWSUICKeyChainStoreServiceKey = @"service";
 static NSString *_defaultService;
+static BOOL _defaultCachingEnabled = NO;
+static id<AWSUICKeyChainStoreBackend> _defaultBackend;
+
+#pragma mark -
+
+// The cached values of one service and access group; NSNull marks an item known to be missing.
+@interface AWSUICKeyChainStoreCache : NSObject
+
+@property (nonatomic, readonly) NSString *service;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, id> *values;
+
++ (instancetype)cacheWithService:(NSString *)service accessGroup:(NSString *)accessGroup;
+
+@end
+
+@implementation AWSUICKeyChainStoreCache
+
+static NSMutableDictionary<NSString *, AWSUICKeyChainStoreCache *> *_caches;
+
++ (instancetype)cacheWithService:(NSString *)service accessGroup:(NSString *)accessGroup
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _caches = [NSMutableDictionary new];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(invalidateCaches:)
+                                                     name:AWSUICKeyChainStoreCacheInvalidationNotification
+                                                   object:nil];
+    });
+    
+    NSString *identifier = [NSString stringWithFormat:@"%@\n%@", service, accessGroup ?: @""];
+    @synchronized (_caches) {
+        AWSUICKeyChainStoreCache *cache = _caches[identifier];
+        if (!cache) {
+            cache = [AWSUICKeyChainStoreCache new];
+            cache->_service = service.copy;
+            cache->_values = [NSMutableDictionary new];
+            _caches[identifier] = cache;
+        }
+        return cache;
+    }
+}
+
++ (void)invalidateCaches:(NSNotification *)notification
+{
+    NSString *service = notification.userInfo[AWSUICKeyChainStoreServiceKey];
+    NSArray<AWSUICKeyChainStoreCache *> *caches = nil;
+    @synchronized (_caches) {
+        caches = _caches.allValues;
+    }
+    for (AWSUICKeyChainStoreCache *cache in caches) {
+        if (!service || [cache.service isEqualToString:service]) {
+            @synchronized (cache) {
+                [cache.values removeAllObjects];
+            }
+        }
+    }
+}
+
+@end
+
+#pragma mark -
+
+@implementation AWSUICKeyChainStoreFileBackend
+
+- (instancetype)init
+{
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithDirectoryURL:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL
+{
+    self = [super init];
+    if (self) {
+        _directoryURL = directoryURL.copy;
+    }
+    
+    return self;
+}
+
+- (NSURL *)fileURLForStore:(AWSUICKeyChainStore *)store
+{
+    NSString *identifier = [NSString stringWithFormat:@"%@\n%@", store.service, store.accessGroup ?: @""];
+    NSString *fileName = [[[identifier dataUsingEncoding:NSUTF8StringEncoding] base64EncodedStringWithOptions:0] stringByReplacingOccurrencesOfString:@"/" withString:@"_"];
+    return [self.directoryURL URLByAppendingPathComponent:[fileName stringByAppendingPathExtension:@"plist"]];
+}
+
+- (NSDictionary<NSString *, NSData *> *)itemsForStore:(AWSUICKeyChainStore *)store
+{
+    return [NSDictionary dictionaryWithContentsOfURL:[self fileURLForStore:store]] ?: @{};
+}
+
+- (BOOL)writeItems:(NSDictionary<NSString *, NSData *> *)items forStore:(AWSUICKeyChainStore *)store error:(NSError *__autoreleasing *)error
+{
+    NSURL *fileURL = [self fileURLForStore:store];
+    if (items.count == 0) {
+        [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+        return YES;
+    }
+    if (![[NSFileManager defaultManager] createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:error]) {
+        return NO;
+    }
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:items format:NSPropertyListBinaryFormat_v1_0 options:0 error:error];
+    return data && [data writeToURL:fileURL options:NSDataWritingAtomic error:error];
+}
+
+- (NSData *)dataForKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError *__autoreleasing *)error
+{
+    @synchronized (self) {
+        return [self itemsForStore:store][key];
+    }
+}
+
+- (BOOL)setData:(NSData *)data forKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError *__autoreleasing *)error
+{
+    @synchronized (self) {
+        NSMutableDictionary *items = [[self itemsForStore:store] mutableCopy];
+        items[key] = data;
+        return [self writeItems:items forStore:store error:error];
+    }
+}
+
+- (BOOL)removeItemForKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError *__autoreleasing *)error
+{
+    @synchronized (self) {
+        NSMutableDictionary *items = [[self itemsForStore:store] mutableCopy];
+        if (!items[key]) {
+            return YES;
+        }
+        [items removeObjectForKey:key];
+        return [self writeItems:items forStore:store error:error];
+    }
+}
+
+- (BOOL)removeAllItemsForStore:(AWSUICKeyChainStore *)store error:(NSError *__autoreleasing *)error
+{
+    @synchronized (self) {
+        return [self writeItems:@{} forStore:store error:error];
+    }
+}
+
+- (NSArray *)allKeysForStore:(AWSUICKeyChainStore *)store
+{
+    @synchronized (self) {
+        return [self itemsForStore:store].allKeys;
+    }
+}
+
+@end
+
+#pragma mark -
 
 @interface AWSUICKeyChainStore ()
 
@@ -31,6 +187,26 @@ static NSString *_defaultService;
     _defaultService = defaultService;
 }
 
++ (BOOL)defaultCachingEnabled
+{
+    return _defaultCachingEnabled;
+}
+
++ (void)setDefaultCachingEnabled:(BOOL)defaultCachingEnabled
+{
+    _defaultCachingEnabled = defaultCachingEnabled;
+}
+
++ (id<AWSUICKeyChainStoreBackend>)defaultBackend
+{
+    return _defaultBackend;
+}
+
++ (void)setDefaultBackend:(id<AWSUICKeyChainStoreBackend>)defaultBackend
+{
+    _defaultBackend = defaultBackend;
+}
+
 #pragma mark -
 
 + (AWSUICKeyChainStore *)keyChainStore
@@ -117,6 +293,23 @@ static NSString *_defaultService;
 - (void)commonInit
 {
     _accessibility = AWSUICKeyChainStoreAccessibilityAfterFirstUnlockThisDeviceOnly;
+    _cachingEnabled = [self.class defaultCachingEnabled];
+    _backend = [self.class defaultBackend];
+}
+
+#pragma mark -
+
+- (AWSUICKeyChainStoreCache *)cache
+{
+    if (!_cachingEnabled || _itemClass != AWSUICKeyChainStoreItemClassGenericPassword || _authenticationPolicy) {
+        return nil;
+    }
+    return [AWSUICKeyChainStoreCache cacheWithService:_service accessGroup:_accessGroup];
+}
+
+- (id<AWSUICKeyChainStoreBackend>)genericPasswordBackend
+{
+    return _itemClass == AWSUICKeyChainStoreItemClassGenericPassword ? _backend : nil;
 }
 
 #pragma mark -
@@ -358,6 +551,10 @@ static NSString *_defaultService;
 
 - (BOOL)contains:(NSString *)key
 {
+    if ([self cache] || [self genericPasswordBackend]) {
+        return [self dataForKey:key error:nil] != nil;
+    }
+    
     NSMutableDictionary *query = [self query];
     query[(__bridge __strong id)kSecAttrAccount] = key;
     
@@ -447,6 +644,36 @@ static NSString *_defaultService;
 
 - (NSData *)dataForKey:(NSString *)key error:(NSError *__autoreleasing *)error
 {
+    AWSUICKeyChainStoreCache *cache = [self cache];
+    if (!cache || !key) {
+        return [self dataNoCacheForKey:key error:error];
+    }
+    
+    @synchronized (cache) {
+        id value = cache.values[key];
+        if (value) {
+            return value == [NSNull null] ? nil : value;
+        }
+        NSError *e = nil;
+        NSData *data = [self dataNoCacheForKey:key error:&e];
+        if (e) {
+            if (error) {
+                *error = e;
+            }
+            return nil;
+        }
+        cache.values[key] = data ?: [NSNull null];
+        return data;
+    }
+}
+
+- (NSData *)dataNoCacheForKey:(NSString *)key error:(NSError *__autoreleasing *)error
+{
+    id<AWSUICKeyChainStoreBackend> backend = [self genericPasswordBackend];
+    if (backend && key) {
+        return [backend dataForKey:key store:self error:error];
+    }
+    
     NSMutableDictionary *query = [self query];
     query[(__bridge __strong id)kSecMatchLimit] = (__bridge id)kSecMatchLimitOne;
     query[(__bridge __strong id)kSecReturnData] = (__bridge id)kCFBooleanTrue;
@@ -512,8 +739,28 @@ static NSString *_defaultService;
 }
 
 - (BOOL)setData:(NSData *)data forKey:(NSString *)key genericAttribute:(id)genericAttribute label:(NSString *)label comment:(NSString *)comment error:(NSError *__autoreleasing *)error {
-    @synchronized (self) {
-        return [self setDataNoLock: data forKey:key genericAttribute:genericAttribute label:label comment:comment error:error];
+    AWSUICKeyChainStoreCache *cache = [self cache];
+    if (!cache || !key) {
+        @synchronized (self) {
+            return [self setDataNoLock: data forKey:key genericAttribute:genericAttribute label:label comment:comment error:error];
+        }
+    }
+    
+    @synchronized (cache) {
+        // Writing the value that is already stored would only cost a keychain round trip.
+        if (data && !genericAttribute && !label && !comment && [cache.values[key] isEqual:data]) {
+            return YES;
+        }
+        BOOL succeeded = NO;
+        @synchronized (self) {
+            succeeded = [self setDataNoLock: data forKey:key genericAttribute:genericAttribute label:label comment:comment error:error];
+        }
+        if (succeeded) {
+            cache.values[key] = data.copy ?: [NSNull null];
+        } else {
+            [cache.values removeObjectForKey:key];
+        }
+        return succeeded;
     }
 }
 
@@ -530,6 +777,11 @@ static NSString *_defaultService;
         return [self removeItemForKey:key error:error];
     }
     
+    id<AWSUICKeyChainStoreBackend> backend = [self genericPasswordBackend];
+    if (backend) {
+        return [backend setData:data forKey:key store:self error:error];
+    }
+    
     NSMutableDictionary *query = [self query];
     query[(__bridge __strong id)kSecAttrAccount] = key;
 #if TARGET_OS_IOS
@@ -709,6 +961,29 @@ static NSString *_defaultService;
 
 - (BOOL)removeItemForKey:(NSString *)key error:(NSError *__autoreleasing *)error
 {
+    AWSUICKeyChainStoreCache *cache = [self cache];
+    if (!cache || !key) {
+        return [self removeItemNoCacheForKey:key error:error];
+    }
+    
+    @synchronized (cache) {
+        BOOL succeeded = [self removeItemNoCacheForKey:key error:error];
+        if (succeeded) {
+            cache.values[key] = [NSNull null];
+        } else {
+            [cache.values removeObjectForKey:key];
+        }
+        return succeeded;
+    }
+}
+
+- (BOOL)removeItemNoCacheForKey:(NSString *)key error:(NSError *__autoreleasing *)error
+{
+    id<AWSUICKeyChainStoreBackend> backend = [self genericPasswordBackend];
+    if (backend && key) {
+        return [backend removeItemForKey:key store:self error:error];
+    }
+    
     NSMutableDictionary *query = [self query];
     query[(__bridge __strong id)kSecAttrAccount] = key;
     
@@ -733,6 +1008,24 @@ static NSString *_defaultService;
 
 - (BOOL)removeAllItemsWithError:(NSError *__autoreleasing *)error
 {
+    AWSUICKeyChainStoreCache *cache = [self cache];
+    if (cache) {
+        @synchronized (cache) {
+            // Some items may be gone even if removing the rest failed, so forget all of them.
+            [cache.values removeAllObjects];
+            return [self removeAllItemsNoCacheWithError:error];
+        }
+    }
+    return [self removeAllItemsNoCacheWithError:error];
+}
+
+- (BOOL)removeAllItemsNoCacheWithError:(NSError *__autoreleasing *)error
+{
+    id<AWSUICKeyChainStoreBackend> backend = [self genericPasswordBackend];
+    if (backend) {
+        return [backend removeAllItemsForStore:self error:error];
+    }
+    
     NSMutableDictionary *query = [self query];
 #if !TARGET_OS_IPHONE
     query[(__bridge id)kSecMatchLimit] = (__bridge id)kSecMatchLimitAll;
@@ -853,6 +1146,28 @@ static NSString *_defaultService;
 
 - (NSArray *)items
 {
+    id<AWSUICKeyChainStoreBackend> backend = [self genericPasswordBackend];
+    if (backend) {
+        // Shaped like the keychain's attributes so `prettify:items:` and `migrateToCurrentAccessibility` apply as is.
+        NSMutableArray *items = [NSMutableArray new];
+        for (NSString *key in [backend allKeysForStore:self]) {
+            NSData *data = [backend dataForKey:key store:self error:nil];
+            if (!data) {
+                continue;
+            }
+            NSMutableDictionary *attributes = [NSMutableDictionary new];
+            attributes[(__bridge id)kSecAttrService] = _service;
+            if (_accessGroup) {
+                attributes[(__bridge id)kSecAttrAccessGroup] = _accessGroup;
+            }
+            attributes[(__bridge id)kSecAttrAccount] = key;
+            attributes[(__bridge id)kSecValueData] = data;
+            attributes[(__bridge id)kSecAttrAccessible] = (__bridge id)[self accessibilityObject];
+            [items addObject:attributes];
+        }
+        return items.copy;
+    }
+    
     NSMutableDictionary *query = [self query];
     query[(__bridge __strong id)kSecMatchLimit] = (__bridge id)kSecMatchLimitAll;
     query[(__bridge __strong id)kSecReturnAttributes] = (__bridge id)kCFBooleanTrue;
@@ -945,6 +1260,13 @@ static NSString *_defaultService;
         }
         NSString *key = item[@"key"];
         NSObject *value = item[@"value"];
+        // The cached value is unchanged, drop it so the write below is not skipped.
+        AWSUICKeyChainStoreCache *cache = [self cache];
+        if (cache && key) {
+            @synchronized (cache) {
+                [cache.values removeObjectForKey:key];
+            }
+        }
         if ([value isKindOfClass: [NSString class]]) {
             [self setString: (NSString *)value forKey:key];
         } else if ([value isKindOfClass: [NSData class]]) {
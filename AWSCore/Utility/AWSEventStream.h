@@ -0,0 +1,158 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString *const AWSEventStreamErrorDomain;
+typedef NS_ENUM(NSInteger, AWSEventStreamErrorType) {
+    AWSEventStreamErrorUnknown,
+    AWSEventStreamErrorInvalidPrelude,
+    AWSEventStreamErrorPreludeChecksumMismatch,
+    AWSEventStreamErrorMessageChecksumMismatch,
+    AWSEventStreamErrorInvalidHeader,
+    AWSEventStreamErrorIncompleteMessage,
+    AWSEventStreamErrorPayloadTooLong,
+};
+
+/// Header value types defined by the `application/vnd.amazon.eventstream` format.
+typedef NS_ENUM(uint8_t, AWSEventStreamHeaderType) {
+    AWSEventStreamHeaderTypeBoolTrue = 0,
+    AWSEventStreamHeaderTypeBoolFalse = 1,
+    AWSEventStreamHeaderTypeByte = 2,
+    AWSEventStreamHeaderTypeInt16 = 3,
+    AWSEventStreamHeaderTypeInt32 = 4,
+    AWSEventStreamHeaderTypeInt64 = 5,
+    AWSEventStreamHeaderTypeByteArray = 6,
+    AWSEventStreamHeaderTypeString = 7,
+    AWSEventStreamHeaderTypeTimestamp = 8,
+    AWSEventStreamHeaderTypeUUID = 9,
+};
+
+/// The maximum length of the encoded headers of a single message.
+FOUNDATION_EXPORT const uint32_t AWSEventStreamMaximumHeadersLength;
+
+/// The maximum length of the payload of a single message.
+FOUNDATION_EXPORT const uint32_t AWSEventStreamMaximumPayloadLength;
+
+/**
+ Continues a CRC32 (IEEE 802.3) checksum over `length` bytes. Pass `0` as `crc` to start a new checksum. Uses the ARMv8
+ CRC32 instructions when the target supports them and zlib otherwise.
+ */
+FOUNDATION_EXPORT uint32_t AWSEventStreamCRC32(uint32_t crc, const void *bytes, size_t length);
+
+#pragma mark - AWSEventStreamHeaderValue
+
+/**
+ A typed event stream header value. `value` is an `NSNumber` for boolean and integer types, `NSData` for byte arrays,
+ `NSString` for strings, `NSDate` for timestamps and `NSUUID` for UUIDs.
+ */
+@interface AWSEventStreamHeaderValue : NSObject <NSCopying>
+
+@property (nonatomic, readonly) AWSEventStreamHeaderType type;
+@property (nonatomic, readonly) id value;
+
++ (instancetype)boolValue:(BOOL)value;
++ (instancetype)byteValue:(int8_t)value;
++ (instancetype)int16Value:(int16_t)value;
++ (instancetype)int32Value:(int32_t)value;
++ (instancetype)int64Value:(int64_t)value;
++ (instancetype)byteArrayValue:(NSData *)value;
++ (instancetype)stringValue:(NSString *)value;
++ (instancetype)timestampValue:(NSDate *)value;
++ (instancetype)UUIDValue:(NSUUID *)value;
+
+@end
+
+#pragma mark - AWSEventStreamMessage
+
+@interface AWSEventStreamMessage : NSObject
+
+@property (nonatomic, readonly) NSDictionary<NSString *, AWSEventStreamHeaderValue *> *headers;
+@property (nonatomic, readonly) NSData *payload;
+
+- (instancetype)initWithHeaders:(NSDictionary<NSString *, AWSEventStreamHeaderValue *> *)headers
+                        payload:(NSData *)payload;
+
+/// Returns the value of a string header such as `:message-type`, or `nil` if it is absent or not a string.
+- (nullable NSString *)stringValueForHeader:(NSString *)name;
+
+@end
+
+#pragma mark - AWSEventStreamEncoder
+
+@interface AWSEventStreamEncoder : NSObject
+
+/**
+ Encodes a complete message.
+
+ @return The encoded message, or `nil` if a header name or value is too long to be encoded, or the payload is longer
+         than `AWSEventStreamMaximumPayloadLength`.
+ */
++ (nullable NSData *)encodeMessage:(AWSEventStreamMessage *)message
+                             error:(NSError **)error;
+
+/**
+ Encodes a header block. Callers that send many messages with the same headers can encode them once and pass the result
+ to `encodeMessageWithEncodedHeaders:payload:`.
+
+ @return The encoded headers, or `nil` if a header name or value is too long to be encoded.
+ */
++ (nullable NSData *)encodeHeaders:(NSDictionary<NSString *, AWSEventStreamHeaderValue *> *)headers
+                             error:(NSError **)error;
+
+/// Encodes a message from a header block produced by `encodeHeaders:error:` and a payload. Both CRCs are computed in a
+/// single pass while the message is written into one buffer of its final size. Returns `nil` if the headers are longer
+/// than `AWSEventStreamMaximumHeadersLength` or the payload is longer than `AWSEventStreamMaximumPayloadLength`.
++ (nullable NSData *)encodeMessageWithEncodedHeaders:(NSData *)encodedHeaders
+                                             payload:(NSData *)payload;
+
+@end
+
+#pragma mark - AWSEventStreamDecoder
+
+/**
+ An incremental event stream decoder. Feed it bytes as they arrive, from WebSocket messages or from an HTTP body through
+ `AWSNetworkingRequest.dataReceived`; frames may be split across or packed into any number of reads. Complete messages
+ are passed to the message handler in order after both CRCs have been verified.
+
+ Whole frames contained in a single read are decoded directly from that read. Only trailing partial frames are copied
+ into an internal buffer, which keeps its capacity between messages.
+
+ The decoder is not thread safe, and the message handler must not call `appendData:error:` on the same decoder.
+ */
+@interface AWSEventStreamDecoder : NSObject
+
+- (instancetype)initWithMessageHandler:(void (^)(AWSEventStreamMessage *message))messageHandler;
+
+/// The number of bytes received that do not yet form a complete message.
+@property (nonatomic, readonly) NSUInteger pendingLength;
+
+/**
+ Decodes as many complete messages as `data` makes available.
+
+ @return `NO` if the stream is malformed. The decoder then rejects all further data.
+ */
+- (BOOL)appendData:(NSData *)data
+             error:(NSError **)error;
+
+/// Decodes a buffer that contains exactly one message.
++ (nullable AWSEventStreamMessage *)decodeMessage:(NSData *)data
+                                            error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,611 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSEventStream.h"
+#import <zlib.h>
+#if defined(__ARM_FEATURE_CRC32)
+#import <arm_acle.h>
+#endif
+
+NSString *const AWSEventStreamErrorDomain = @"com.amazonaws.AWSEventStreamErrorDomain";
+
+const uint32_t AWSEventStreamMaximumHeadersLength = 128 * 1024;
+const uint32_t AWSEventStreamMaximumPayloadLength = 16 * 1024 * 1024;
+
+// Total length (4), headers length (4) and prelude CRC (4)
+static const size_t AWSEventStreamPreludeLength = 12;
+static const size_t AWSEventStreamMessageCRCLength = 4;
+static const size_t AWSEventStreamMinimumMessageLength = AWSEventStreamPreludeLength + AWSEventStreamMessageCRCLength;
+
+uint32_t AWSEventStreamCRC32(uint32_t crc, const void *bytes, size_t length) {
+    const uint8_t *cursor = bytes;
+#if defined(__ARM_FEATURE_CRC32)
+    crc = ~crc;
+    while (length >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, cursor, sizeof(word));
+        crc = __crc32d(crc, word);
+        cursor += sizeof(word);
+        length -= sizeof(word);
+    }
+    while (length > 0) {
+        crc = __crc32b(crc, *cursor);
+        cursor++;
+        length--;
+    }
+    return ~crc;
+#else
+    // zlib takes a 32-bit length.
+    while (length > 0) {
+        uInt blockLength = (uInt)MIN(length, (size_t)UINT32_MAX);
+        crc = (uint32_t)crc32(crc, cursor, blockLength);
+        cursor += blockLength;
+        length -= blockLength;
+    }
+    return crc;
+#endif
+}
+
+static uint16_t AWSEventStreamReadUInt16(const uint8_t *bytes) {
+    uint16_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt16BigToHost(value);
+}
+
+static uint32_t AWSEventStreamReadUInt32(const uint8_t *bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt32BigToHost(value);
+}
+
+static uint64_t AWSEventStreamReadUInt64(const uint8_t *bytes) {
+    uint64_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt64BigToHost(value);
+}
+
+static void AWSEventStreamWriteUInt32(uint8_t *bytes, uint32_t value) {
+    uint32_t bigEndianValue = CFSwapInt32HostToBig(value);
+    memcpy(bytes, &bigEndianValue, sizeof(bigEndianValue));
+}
+
+static NSError *AWSEventStreamError(AWSEventStreamErrorType code, NSString *failureReason) {
+    return [NSError errorWithDomain:AWSEventStreamErrorDomain
+                               code:code
+                           userInfo:@{NSLocalizedFailureReasonErrorKey: failureReason}];
+}
+
+#pragma mark - AWSEventStreamHeaderValue
+
+@interface AWSEventStreamHeaderValue()
+
+@property (nonatomic, assign) AWSEventStreamHeaderType type;
+@property (nonatomic, strong) id value;
+
+@end
+
+@implementation AWSEventStreamHeaderValue
+
++ (instancetype)headerValueWithType:(AWSEventStreamHeaderType)type value:(id)value {
+    AWSEventStreamHeaderValue *headerValue = [self new];
+    headerValue.type = type;
+    headerValue.value = value;
+    return headerValue;
+}
+
++ (instancetype)boolValue:(BOOL)value {
+    return [self headerValueWithType:value ? AWSEventStreamHeaderTypeBoolTrue : AWSEventStreamHeaderTypeBoolFalse
+                               value:@(value)];
+}
+
++ (instancetype)byteValue:(int8_t)value {
+    return [self headerValueWithType:AWSEventStreamHeaderTypeByte value:@(value)];
+}
+
++ (instancetype)int16Value:(int16_t)value {
+    return [self headerValueWithType:AWSEventStreamHeaderTypeInt16 value:@(value)];
+}
+
++ (instancetype)int32Value:(int32_t)value {
+    return [self headerValueWithType:AWSEventStreamHeaderTypeInt32 value:@(value)];
+}
+
++ (instancetype)int64Value:(int64_t)value {
+    return [self headerValueWithType:AWSEventStreamHeaderTypeInt64 value:@(value)];
+}
+
++ (instancetype)byteArrayValue:(NSData *)value {
+    return [self headerValueWithType:AWSEventStreamHeaderTypeByteArray value:[value copy]];
+}
+
++ (instancetype)stringValue:(NSString *)value {
+    return [self headerValueWithType:AWSEventStreamHeaderTypeString value:[value copy]];
+}
+
++ (instancetype)timestampValue:(NSDate *)value {
+    return [self headerValueWithType:AWSEventStreamHeaderTypeTimestamp value:value];
+}
+
++ (instancetype)UUIDValue:(NSUUID *)value {
+    return [self headerValueWithType:AWSEventStreamHeaderTypeUUID value:value];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (self == object) {
+        return YES;
+    }
+    if (![object isKindOfClass:[AWSEventStreamHeaderValue class]]) {
+        return NO;
+    }
+    AWSEventStreamHeaderValue *other = object;
+    return self.type == other.type && [self.value isEqual:other.value];
+}
+
+- (NSUInteger)hash {
+    return self.type ^ [self.value hash];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: type=%d value=%@>", NSStringFromClass([self class]), self.type, self.value];
+}
+
+@end
+
+#pragma mark - AWSEventStreamMessage
+
+@implementation AWSEventStreamMessage
+
+- (instancetype)initWithHeaders:(NSDictionary<NSString *, AWSEventStreamHeaderValue *> *)headers
+                        payload:(NSData *)payload {
+    if (self = [super init]) {
+        _headers = [headers copy];
+        _payload = [payload copy];
+    }
+    return self;
+}
+
+- (NSString *)stringValueForHeader:(NSString *)name {
+    AWSEventStreamHeaderValue *headerValue = self.headers[name];
+    if (headerValue.type != AWSEventStreamHeaderTypeString) {
+        return nil;
+    }
+    return headerValue.value;
+}
+
+@end
+
+#pragma mark - AWSEventStreamEncoder
+
+@implementation AWSEventStreamEncoder
+
++ (NSData *)encodeMessage:(AWSEventStreamMessage *)message
+                    error:(NSError **)error {
+    NSData *encodedHeaders = [self encodeHeaders:message.headers error:error];
+    if (!encodedHeaders) {
+        return nil;
+    }
+    if ([message.payload length] > AWSEventStreamMaximumPayloadLength) {
+        if (error) {
+            *error = AWSEventStreamError(AWSEventStreamErrorPayloadTooLong,
+                                         [NSString stringWithFormat:@"Payload is %lu bytes, the maximum is %u",
+                                          (unsigned long)[message.payload length], AWSEventStreamMaximumPayloadLength]);
+        }
+        return nil;
+    }
+    return [self encodeMessageWithEncodedHeaders:encodedHeaders payload:message.payload];
+}
+
++ (NSData *)encodeHeaders:(NSDictionary<NSString *, AWSEventStreamHeaderValue *> *)headers
+                    error:(NSError **)error {
+    NSMutableData *encodedHeaders = [NSMutableData new];
+    for (NSString *name in headers) {
+        AWSEventStreamHeaderValue *headerValue = headers[name];
+        NSData *nameData = [name dataUsingEncoding:NSUTF8StringEncoding];
+        if ([nameData length] == 0 || [nameData length] > UINT8_MAX) {
+            if (error) {
+                *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader,
+                                             [NSString stringWithFormat:@"Header name must be 1 to 255 bytes long: %@", name]);
+            }
+            return nil;
+        }
+
+        uint8_t nameLength = (uint8_t)[nameData length];
+        uint8_t type = headerValue.type;
+        [encodedHeaders appendBytes:&nameLength length:sizeof(nameLength)];
+        [encodedHeaders appendData:nameData];
+        [encodedHeaders appendBytes:&type length:sizeof(type)];
+
+        switch (headerValue.type) {
+            case AWSEventStreamHeaderTypeBoolTrue:
+            case AWSEventStreamHeaderTypeBoolFalse:
+                break;
+            case AWSEventStreamHeaderTypeByte: {
+                int8_t value = [headerValue.value charValue];
+                [encodedHeaders appendBytes:&value length:sizeof(value)];
+                break;
+            }
+            case AWSEventStreamHeaderTypeInt16: {
+                uint16_t value = CFSwapInt16HostToBig((uint16_t)[headerValue.value shortValue]);
+                [encodedHeaders appendBytes:&value length:sizeof(value)];
+                break;
+            }
+            case AWSEventStreamHeaderTypeInt32: {
+                uint32_t value = CFSwapInt32HostToBig((uint32_t)[headerValue.value intValue]);
+                [encodedHeaders appendBytes:&value length:sizeof(value)];
+                break;
+            }
+            case AWSEventStreamHeaderTypeInt64: {
+                uint64_t value = CFSwapInt64HostToBig((uint64_t)[headerValue.value longLongValue]);
+                [encodedHeaders appendBytes:&value length:sizeof(value)];
+                break;
+            }
+            case AWSEventStreamHeaderTypeByteArray:
+            case AWSEventStreamHeaderTypeString: {
+                NSData *valueData = headerValue.type == AWSEventStreamHeaderTypeString
+                    ? [headerValue.value dataUsingEncoding:NSUTF8StringEncoding]
+                    : headerValue.value;
+                if ([valueData length] > UINT16_MAX) {
+                    if (error) {
+                        *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader,
+                                                     [NSString stringWithFormat:@"Value of header %@ is longer than 65535 bytes", name]);
+                    }
+                    return nil;
+                }
+                uint16_t valueLength = CFSwapInt16HostToBig((uint16_t)[valueData length]);
+                [encodedHeaders appendBytes:&valueLength length:sizeof(valueLength)];
+                [encodedHeaders appendData:valueData];
+                break;
+            }
+            case AWSEventStreamHeaderTypeTimestamp: {
+                int64_t milliseconds = (int64_t)llround([headerValue.value timeIntervalSince1970] * 1000);
+                uint64_t value = CFSwapInt64HostToBig((uint64_t)milliseconds);
+                [encodedHeaders appendBytes:&value length:sizeof(value)];
+                break;
+            }
+            case AWSEventStreamHeaderTypeUUID: {
+                uuid_t value;
+                [headerValue.value getUUIDBytes:value];
+                [encodedHeaders appendBytes:value length:sizeof(value)];
+                break;
+            }
+        }
+    }
+
+    if ([encodedHeaders length] > AWSEventStreamMaximumHeadersLength) {
+        if (error) {
+            *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader,
+                                         [NSString stringWithFormat:@"Encoded headers are %lu bytes, the maximum is %u",
+                                          (unsigned long)[encodedHeaders length], AWSEventStreamMaximumHeadersLength]);
+        }
+        return nil;
+    }
+
+    return encodedHeaders;
+}
+
++ (nullable NSData *)encodeMessageWithEncodedHeaders:(NSData *)encodedHeaders
+                                             payload:(NSData *)payload {
+    size_t headersLength = [encodedHeaders length];
+    size_t payloadLength = [payload length];
+    // Both limits keep the total length well within the 32 bits of the prelude, and within what decoders accept.
+    if (headersLength > AWSEventStreamMaximumHeadersLength || payloadLength > AWSEventStreamMaximumPayloadLength) {
+        return nil;
+    }
+    size_t messageLength = AWSEventStreamMinimumMessageLength + headersLength + payloadLength;
+
+    NSMutableData *message = [NSMutableData dataWithLength:messageLength];
+    uint8_t *bytes = [message mutableBytes];
+
+    AWSEventStreamWriteUInt32(bytes, (uint32_t)messageLength);
+    AWSEventStreamWriteUInt32(bytes + 4, (uint32_t)headersLength);
+    uint32_t crc = AWSEventStreamCRC32(0, bytes, 8);
+    AWSEventStreamWriteUInt32(bytes + 8, crc);
+
+    uint8_t *cursor = bytes + AWSEventStreamPreludeLength;
+    if (headersLength > 0) {
+        memcpy(cursor, [encodedHeaders bytes], headersLength);
+        cursor += headersLength;
+    }
+    if (payloadLength > 0) {
+        memcpy(cursor, [payload bytes], payloadLength);
+        cursor += payloadLength;
+    }
+
+    // The message CRC covers the prelude too, so continue from the prelude CRC instead of starting over.
+    crc = AWSEventStreamCRC32(crc, bytes + 8, messageLength - 8 - AWSEventStreamMessageCRCLength);
+    AWSEventStreamWriteUInt32(cursor, crc);
+
+    return message;
+}
+
+@end
+
+#pragma mark - AWSEventStreamDecoder
+
+@interface AWSEventStreamDecoder()
+
+@property (nonatomic, copy) void (^messageHandler)(AWSEventStreamMessage *message);
+@property (nonatomic, strong) NSMutableData *buffer;
+@property (nonatomic, assign) NSUInteger bufferOffset;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation AWSEventStreamDecoder
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithMessageHandler:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithMessageHandler:(void (^)(AWSEventStreamMessage *message))messageHandler {
+    if (self = [super init]) {
+        _messageHandler = [messageHandler copy];
+        _buffer = [NSMutableData new];
+    }
+    return self;
+}
+
+- (NSUInteger)pendingLength {
+    return [self.buffer length] - self.bufferOffset;
+}
+
+- (BOOL)appendData:(NSData *)data
+             error:(NSError **)error {
+    if (self.error) {
+        if (error) {
+            *error = self.error;
+        }
+        return NO;
+    }
+
+    NSError *decodingError = nil;
+    if (self.pendingLength == 0) {
+        // Common case: decode whole frames straight from the caller's data and only keep the trailing partial frame.
+        size_t consumed = [AWSEventStreamDecoder decodeBytes:[data bytes]
+                                                      length:[data length]
+                                              messageHandler:self.messageHandler
+                                                       error:&decodingError];
+        [self.buffer setLength:0];
+        self.bufferOffset = 0;
+        if (!decodingError && consumed < [data length]) {
+            [self.buffer appendBytes:(const uint8_t *)[data bytes] + consumed length:[data length] - consumed];
+        }
+    } else {
+        [self.buffer appendData:data];
+        size_t consumed = [AWSEventStreamDecoder decodeBytes:(const uint8_t *)[self.buffer bytes] + self.bufferOffset
+                                                      length:self.pendingLength
+                                              messageHandler:self.messageHandler
+                                                       error:&decodingError];
+        self.bufferOffset += consumed;
+        if (self.bufferOffset == [self.buffer length]) {
+            // Keeps the allocated capacity for the next partial frame.
+            [self.buffer setLength:0];
+            self.bufferOffset = 0;
+        } else if (self.bufferOffset > 0) {
+            NSUInteger pendingLength = self.pendingLength;
+            uint8_t *bytes = [self.buffer mutableBytes];
+            memmove(bytes, bytes + self.bufferOffset, pendingLength);
+            [self.buffer setLength:pendingLength];
+            self.bufferOffset = 0;
+        }
+    }
+
+    if (decodingError) {
+        self.error = decodingError;
+        [self.buffer setLength:0];
+        self.bufferOffset = 0;
+        if (error) {
+            *error = decodingError;
+        }
+        return NO;
+    }
+    return YES;
+}
+
++ (AWSEventStreamMessage *)decodeMessage:(NSData *)data
+                                   error:(NSError **)error {
+    __block AWSEventStreamMessage *decodedMessage = nil;
+    __block NSUInteger messageCount = 0;
+    NSError *decodingError = nil;
+    size_t consumed = [self decodeBytes:[data bytes]
+                                 length:[data length]
+                         messageHandler:^(AWSEventStreamMessage *message) {
+        decodedMessage = message;
+        messageCount++;
+    }
+                                  error:&decodingError];
+
+    if (!decodingError && (messageCount != 1 || consumed != [data length])) {
+        decodingError = AWSEventStreamError(AWSEventStreamErrorIncompleteMessage,
+                                            [NSString stringWithFormat:@"Expected exactly one message in %lu bytes, decoded %lu",
+                                             (unsigned long)[data length], (unsigned long)messageCount]);
+    }
+    if (decodingError) {
+        if (error) {
+            *error = decodingError;
+        }
+        return nil;
+    }
+    return decodedMessage;
+}
+
+/// Decodes every complete message in `bytes` and returns the number of bytes consumed.
++ (size_t)decodeBytes:(const uint8_t *)bytes
+               length:(size_t)length
+       messageHandler:(void (^)(AWSEventStreamMessage *message))messageHandler
+                error:(NSError **)error {
+    size_t offset = 0;
+    while (length - offset >= AWSEventStreamPreludeLength) {
+        const uint8_t *message = bytes + offset;
+        uint32_t totalLength = AWSEventStreamReadUInt32(message);
+        uint32_t headersLength = AWSEventStreamReadUInt32(message + 4);
+        uint32_t preludeCRC = AWSEventStreamReadUInt32(message + 8);
+
+        if (totalLength < AWSEventStreamMinimumMessageLength
+            || headersLength > AWSEventStreamMaximumHeadersLength
+            || headersLength > totalLength - AWSEventStreamMinimumMessageLength
+            || totalLength - AWSEventStreamMinimumMessageLength - headersLength > AWSEventStreamMaximumPayloadLength) {
+            *error = AWSEventStreamError(AWSEventStreamErrorInvalidPrelude,
+                                         [NSString stringWithFormat:@"Invalid prelude: total length %u, headers length %u",
+                                          totalLength, headersLength]);
+            return offset;
+        }
+
+        uint32_t crc = AWSEventStreamCRC32(0, message, 8);
+        if (crc != preludeCRC) {
+            *error = AWSEventStreamError(AWSEventStreamErrorPreludeChecksumMismatch,
+                                         [NSString stringWithFormat:@"Prelude CRC %08x does not match computed CRC %08x",
+                                          preludeCRC, crc]);
+            return offset;
+        }
+
+        if (length - offset < totalLength) {
+            // Partial frame, wait for more data.
+            break;
+        }
+
+        crc = AWSEventStreamCRC32(crc, message + 8, totalLength - 8 - AWSEventStreamMessageCRCLength);
+        uint32_t messageCRC = AWSEventStreamReadUInt32(message + totalLength - AWSEventStreamMessageCRCLength);
+        if (crc != messageCRC) {
+            *error = AWSEventStreamError(AWSEventStreamErrorMessageChecksumMismatch,
+                                         [NSString stringWithFormat:@"Message CRC %08x does not match computed CRC %08x",
+                                          messageCRC, crc]);
+            return offset;
+        }
+
+        NSDictionary *headers = [self decodeHeaders:message + AWSEventStreamPreludeLength
+                                             length:headersLength
+                                              error:error];
+        if (!headers) {
+            return offset;
+        }
+
+        size_t payloadLength = totalLength - AWSEventStreamMinimumMessageLength - headersLength;
+        NSData *payload = [NSData dataWithBytes:message + AWSEventStreamPreludeLength + headersLength
+                                         length:payloadLength];
+        messageHandler([[AWSEventStreamMessage alloc] initWithHeaders:headers payload:payload]);
+
+        offset += totalLength;
+    }
+    return offset;
+}
+
++ (NSDictionary<NSString *, AWSEventStreamHeaderValue *> *)decodeHeaders:(const uint8_t *)bytes
+                                                                  length:(size_t)length
+                                                                   error:(NSError **)error {
+    NSMutableDictionary<NSString *, AWSEventStreamHeaderValue *> *headers = [NSMutableDictionary new];
+    size_t position = 0;
+
+#define AWSEventStreamRequireHeaderBytes(count) \
+    if (length - position < (count)) { \
+        *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader, @"Header extends past the end of the header block"); \
+        return nil; \
+    }
+
+    while (position < length) {
+        size_t nameLength = bytes[position];
+        position++;
+        AWSEventStreamRequireHeaderBytes(nameLength + 1);
+        NSString *name = [[NSString alloc] initWithBytes:bytes + position
+                                                  length:nameLength
+                                                encoding:NSUTF8StringEncoding];
+        position += nameLength;
+        uint8_t type = bytes[position];
+        position++;
+
+        AWSEventStreamHeaderValue *headerValue = nil;
+        switch (type) {
+            case AWSEventStreamHeaderTypeBoolTrue:
+                headerValue = [AWSEventStreamHeaderValue boolValue:YES];
+                break;
+            case AWSEventStreamHeaderTypeBoolFalse:
+                headerValue = [AWSEventStreamHeaderValue boolValue:NO];
+                break;
+            case AWSEventStreamHeaderTypeByte:
+                AWSEventStreamRequireHeaderBytes(1);
+                headerValue = [AWSEventStreamHeaderValue byteValue:(int8_t)bytes[position]];
+                position += 1;
+                break;
+            case AWSEventStreamHeaderTypeInt16:
+                AWSEventStreamRequireHeaderBytes(2);
+                headerValue = [AWSEventStreamHeaderValue int16Value:(int16_t)AWSEventStreamReadUInt16(bytes + position)];
+                position += 2;
+                break;
+            case AWSEventStreamHeaderTypeInt32:
+                AWSEventStreamRequireHeaderBytes(4);
+                headerValue = [AWSEventStreamHeaderValue int32Value:(int32_t)AWSEventStreamReadUInt32(bytes + position)];
+                position += 4;
+                break;
+            case AWSEventStreamHeaderTypeInt64:
+                AWSEventStreamRequireHeaderBytes(8);
+                headerValue = [AWSEventStreamHeaderValue int64Value:(int64_t)AWSEventStreamReadUInt64(bytes + position)];
+                position += 8;
+                break;
+            case AWSEventStreamHeaderTypeByteArray:
+            case AWSEventStreamHeaderTypeString: {
+                AWSEventStreamRequireHeaderBytes(2);
+                size_t valueLength = AWSEventStreamReadUInt16(bytes + position);
+                position += 2;
+                AWSEventStreamRequireHeaderBytes(valueLength);
+                if (type == AWSEventStreamHeaderTypeString) {
+                    NSString *value = [[NSString alloc] initWithBytes:bytes + position
+                                                               length:valueLength
+                                                             encoding:NSUTF8StringEncoding];
+                    headerValue = value ? [AWSEventStreamHeaderValue stringValue:value] : nil;
+                } else {
+                    headerValue = [AWSEventStreamHeaderValue byteArrayValue:[NSData dataWithBytes:bytes + position
+                                                                                           length:valueLength]];
+                }
+                position += valueLength;
+                break;
+            }
+            case AWSEventStreamHeaderTypeTimestamp: {
+                AWSEventStreamRequireHeaderBytes(8);
+                int64_t milliseconds = (int64_t)AWSEventStreamReadUInt64(bytes + position);
+                headerValue = [AWSEventStreamHeaderValue timestampValue:[NSDate dateWithTimeIntervalSince1970:milliseconds / 1000.0]];
+                position += 8;
+                break;
+            }
+            case AWSEventStreamHeaderTypeUUID:
+                AWSEventStreamRequireHeaderBytes(16);
+                headerValue = [AWSEventStreamHeaderValue UUIDValue:[[NSUUID alloc] initWithUUIDBytes:bytes + position]];
+                position += 16;
+                break;
+            default:
+                *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader,
+                                             [NSString stringWithFormat:@"Unknown header type %u", type]);
+                return nil;
+        }
+
+        if (!name || !headerValue) {
+            *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader, @"Header name or value is not valid UTF-8");
+            return nil;
+        }
+        headers[name] = headerValue;
+    }
+
+#undef AWSEventStreamRequireHeaderBytes
+
+    return headers;
+}
+
+@end
@@ -49,10 +49,12 @@
 - (void) writeProcessingInstruction:(NSString*)target data:(NSString*)data;
 - (void) writeCData:(NSString*)cdata;
 
-// return the written xml string buffer
+// return the written xml as a string
 - (NSMutableString*) toString;
 // return the written xml as data, set to the encoding used in the writeStartDocumentWithEncodingAndVersion method (UTF-8 per default)
 - (NSData*) toData;
+// return the written xml as data like toData, handing over the output buffer instead of copying it. the writer is left empty
+- (NSData*) detachData;
 
 // flush the buffers, if any
 - (void) flush;
@@ -87,8 +89,12 @@
 
 @interface AWSXMLWriter : NSObject <AWSNSXMLStreamWriter> {
 		
-	// the current output buffer
-	NSMutableString* writer;
+	// the current output buffer, UTF-8 encoded
+	uint8_t* buffer;
+	// the number of bytes written to the output buffer
+	NSUInteger bufferLength;
+	// the allocated size of the output buffer
+	NSUInteger bufferCapacity;
 	
 	// the target encoding
 	NSString* encoding;
@@ -107,7 +113,9 @@
 	// the namespace array. zero or more namespace attributes can be defined per element level
 	NSMutableArray* namespaceURIs;
 	// the namespace count. one per element level
-	NSMutableArray* namespaceCounts;
+	NSUInteger* namespaceCounts;
+	NSUInteger namespaceCountsLength;
+	NSUInteger namespaceCountsCapacity;
 	// the namespaces which have been written to the stream
 	NSMutableArray* namespaceWritten;
 
@@ -119,6 +127,12 @@
 	NSString* indentation;
 	// line break
 	NSString* lineBreak;
+	// UTF-8 encoded indentation and line break
+	NSData* indentationBytes;
+	NSData* lineBreakBytes;
+
+	// UTF-8 encoded end tags (</localName>) of the local names written so far, keyed by the local name instance
+	NSMapTable* endTags;
 	
 	// if true, then write elements without children as <start /> instead of <start></start>
 	BOOL automaticEmptyElements;
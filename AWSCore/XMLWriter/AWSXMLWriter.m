@@ -25,11 +25,15 @@
  ****************************************************************************/
 
 // Updated for 64bit architecture - 2014.02.18
+// Updated to write UTF-8 into a byte buffer, escaping text in bulk and caching end tags
 
 #import "AWSXMLWriter.h"
 
 #define NSBOOL(_X_) ((_X_) ? (id)kCFBooleanTrue : (id)kCFBooleanFalse)
 
+// append a C string literal to the output buffer
+#define AWSXMLWriterAppendLiteral(_WRITER_, _LITERAL_) AWSXMLWriterAppendBytes((_WRITER_), (_LITERAL_), sizeof(_LITERAL_) - 1)
+
 @interface AWSXMLWriter (UtilityMethods)
 // methods for internal use only
 // pop the namespace stack, removing any namespaces which become out-of-scope
@@ -48,6 +52,14 @@
 - (void) writeNamespaceToStream:(NSString*)prefix namespaceURI:(NSString*)namespaceURI;
 // write a length of text to the stream with escaping
 - (void) writeEscapeCharacters:(const UniChar*)characters length:(NSUInteger)length;
+// write a length of ASCII text to the stream with escaping
+- (void) writeEscapeASCIICharacters:(const char*)characters length:(NSUInteger)length;
+// return the UTF-8 encoded end tag of a local name
+- (NSData*) endTagForLocalName:(NSString*)localName;
+// write the local name of a start tag or attribute
+- (void) writeLocalName:(NSString*)localName;
+// whether the output encoding is UTF-8, i.e. the output buffer can be returned as is
+- (BOOL) isUTF8Encoded;
 @end
 
 
@@ -59,15 +71,114 @@ static NSString *const XMLNS_NAMESPACE_URI_PREFIX = @"xmlns";
 static NSString *const XSI_NAMESPACE_URI = @"http://www.w3.org/2001/XMLSchema/";
 static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 
+// the initial size of the output buffer
+static const NSUInteger AWSXMLWriterInitialBufferCapacity = 4096;
+// the number of UTF-16 characters escaped at a time when they have to be copied out of a string
+static const NSUInteger AWSXMLWriterEscapeChunkLength = 256;
+// the most bytes one UTF-16 character can be written as, i.e. &quot;
+static const NSUInteger AWSXMLWriterMaximumEscapedCharacterLength = 6;
+// the most end tags cached per writer
+static const NSUInteger AWSXMLWriterMaximumEndTagCount = 512;
+
+// how each ASCII character is written as text: 0 as is, 1 as an entity, 2 not at all
+static const uint8_t AWSXMLWriterEscapeActions[128] = {
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 2, 2, 0, 2, 2, // \t, \n and \r are valid, other control characters are not
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, // " and &
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, // < and >
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// SWAR masks for testing eight ASCII characters at once
+static const uint64_t AWSXMLWriterOnes = 0x0101010101010101ULL;
+static const uint64_t AWSXMLWriterHighBits = 0x8080808080808080ULL;
+
+// nonzero if any of the eight bytes equals the byte in value
+static inline uint64_t AWSXMLWriterHasByte(uint64_t word, uint8_t value) {
+	uint64_t difference = word ^ (AWSXMLWriterOnes * value);
+	return (difference - AWSXMLWriterOnes) & ~difference & AWSXMLWriterHighBits;
+}
+
+// nonzero if any of the eight ASCII characters may need escaping, i.e. is a control character, ", &, < or >
+static inline uint64_t AWSXMLWriterMayNeedEscape(uint64_t word) {
+	uint64_t hasControlCharacter = (word - AWSXMLWriterOnes * 0x20) & ~word & AWSXMLWriterHighBits;
+	return hasControlCharacter
+	| AWSXMLWriterHasByte(word, '"')
+	| AWSXMLWriterHasByte(word, '&')
+	| AWSXMLWriterHasByte(word, '<')
+	| AWSXMLWriterHasByte(word, '>');
+}
+
 @implementation AWSXMLWriter
 
 @synthesize automaticEmptyElements, indentation, lineBreak, level;
 
+// grow the output buffer so that it has room for length more bytes
+static inline void AWSXMLWriterReserveBytes(__unsafe_unretained AWSXMLWriter* xmlWriter, NSUInteger length) {
+	if(xmlWriter->bufferCapacity - xmlWriter->bufferLength >= length) {
+		return;
+	}
+	NSUInteger capacity = MAX(xmlWriter->bufferCapacity, AWSXMLWriterInitialBufferCapacity);
+	while(capacity - xmlWriter->bufferLength < length) {
+		capacity *= 2;
+	}
+	uint8_t* grownBuffer = realloc(xmlWriter->buffer, capacity);
+	if(!grownBuffer) {
+		// raise exception - no more memory
+		@throw([NSException exceptionWithName:@"XMLWriterException" reason:[NSString stringWithFormat:@"Could not allocate output buffer of %lu bytes", (unsigned long)capacity] userInfo:NULL]);
+	}
+	xmlWriter->buffer = grownBuffer;
+	xmlWriter->bufferCapacity = capacity;
+}
+
+static inline void AWSXMLWriterAppendBytes(__unsafe_unretained AWSXMLWriter* xmlWriter, const void* bytes, NSUInteger length) {
+	if(!length) {
+		return;
+	}
+	AWSXMLWriterReserveBytes(xmlWriter, length);
+	memcpy(xmlWriter->buffer + xmlWriter->bufferLength, bytes, length);
+	xmlWriter->bufferLength += length;
+}
+
+static inline void AWSXMLWriterPushNamespaceCount(__unsafe_unretained AWSXMLWriter* xmlWriter, NSUInteger count) {
+	if(xmlWriter->namespaceCountsLength == xmlWriter->namespaceCountsCapacity) {
+		NSUInteger capacity = MAX(xmlWriter->namespaceCountsCapacity * 2, 16);
+		NSUInteger* grownCounts = realloc(xmlWriter->namespaceCounts, capacity * sizeof(NSUInteger));
+		if(!grownCounts) {
+			// raise exception - no more memory
+			@throw([NSException exceptionWithName:@"XMLWriterException" reason:@"Could not allocate namespace stack" userInfo:NULL]);
+		}
+		xmlWriter->namespaceCounts = grownCounts;
+		xmlWriter->namespaceCountsCapacity = capacity;
+	}
+	xmlWriter->namespaceCounts[xmlWriter->namespaceCountsLength++] = count;
+}
+
+// write the entity for one of the ASCII characters which are escaped
+static inline uint8_t* AWSXMLWriterWriteEntity(uint8_t* output, uint8_t c) {
+	switch (c) {
+		case '"':
+			memcpy(output, "&quot;", 6);
+			return output + 6;
+		case '&':
+			memcpy(output, "&amp;", 5);
+			return output + 5;
+		case '<':
+			memcpy(output, "&lt;", 4);
+			return output + 4;
+		default:
+			memcpy(output, "&gt;", 4);
+			return output + 4;
+	}
+}
+
 - (AWSXMLWriter*) init {
 	self = [super init];
 	if (self != nil) {
 		// intialize variables
-		writer = [[NSMutableString alloc] init];
 		level = 0;
 		openElement = NO;
 		emptyElement = NO;
@@ -76,44 +187,52 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 		elementNamespaceURIs = [[NSMutableArray alloc]init];
 
 		namespaceURIs = [[NSMutableArray alloc]init];
-		namespaceCounts = [[NSMutableArray alloc]init];
 		namespaceWritten = [[NSMutableArray alloc]init];
 
 		namespaceURIPrefixMap = [[NSMutableDictionary alloc] init];
 		prefixNamespaceURIMap = [[NSMutableDictionary alloc] init];
 
+		endTags = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality)
+										valueOptions:NSPointerFunctionsStrongMemory];
+
 		// load default custom behaviour
-		indentation = @"\t";
-		lineBreak = @"\n";
+		[self setIndentation:@"\t"];
+		[self setLineBreak:@"\n"];
 		automaticEmptyElements = YES;
 
 		// setup default xml namespaces. assume both are previously known.
-		[namespaceCounts addObject:[NSNumber numberWithInt:2]];
+		AWSXMLWriterPushNamespaceCount(self, 2);
 		[self setPrefix:XML_NAMESPACE_URI_PREFIX namespaceURI:XML_NAMESPACE_URI];
 		[self setPrefix:XMLNS_NAMESPACE_URI_PREFIX namespaceURI:XMLNS_NAMESPACE_URI];
 	}
 	return self;
 }
 
+- (void) dealloc {
+	free(buffer);
+	free(namespaceCounts);
+}
+
+- (void) setIndentation:(NSString*)aIndentation {
+	indentation = aIndentation;
+	indentationBytes = [aIndentation dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (void) setLineBreak:(NSString*)aLineBreak {
+	lineBreak = aLineBreak;
+	lineBreakBytes = [aLineBreak dataUsingEncoding:NSUTF8StringEncoding];
+}
+
 - (void) pushNamespaceStack {
 	// step namespace count - add the current namespace count
-	NSNumber* previousCount = [namespaceCounts lastObject];
-	if([namespaceURIs count] == [previousCount intValue]) {
-		// the count is still the same
-		[namespaceCounts addObject:previousCount];
-	} else {
-		// the count has changed, save the it
-		NSNumber* count = [NSNumber numberWithUnsignedInteger:[namespaceURIs count]];
-
-		[namespaceCounts addObject:count];
-	}
+	AWSXMLWriterPushNamespaceCount(self, [namespaceURIs count]);
 }
 
 - (void) writeNamespaceAttributes {
 	if(openElement) {
 		// write namespace attributes in the namespace stack
-		NSNumber* previousCount = [namespaceCounts lastObject];
-		for(int i = [previousCount intValue]; i < [namespaceURIs count]; i++) {
+		NSUInteger previousCount = namespaceCounts[namespaceCountsLength - 1];
+		for(NSUInteger i = previousCount; i < [namespaceURIs count]; i++) {
 
 			// did we already write this namespace?
 			id written = [namespaceWritten objectAtIndex:i];
@@ -136,12 +255,12 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 
 - (void) popNamespaceStack {
 	// step namespaces one level down
-	if([namespaceCounts lastObject] != [namespaceCounts objectAtIndex:([namespaceCounts count] - 2)]) {
+	NSUInteger previousCount = namespaceCounts[namespaceCountsLength - 1];
+	NSUInteger currentCount = namespaceCounts[namespaceCountsLength - 2];
+	if(previousCount != currentCount) {
 		// remove namespaces which now are out of scope, i.e. between the current and the previus count
-		NSNumber* previousCount = [namespaceCounts lastObject];
-		NSNumber* currentCount = [namespaceCounts objectAtIndex:([namespaceCounts count] - 2)];
-		for(int i = [previousCount intValue] - 1; i >= [currentCount intValue]; i--) {
-			NSString* removedNamespaceURI = [namespaceURIs objectAtIndex:i];
+		for(NSUInteger i = previousCount; i > currentCount; i--) {
+			NSString* removedNamespaceURI = [namespaceURIs objectAtIndex:i - 1];
 			NSString* removedPrefix = [namespaceURIPrefixMap objectForKey:removedNamespaceURI];
 
 			[prefixNamespaceURIMap removeObjectForKey:removedPrefix];
@@ -154,7 +273,7 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	} else {
 		// not necessary to remove any namespaces
 	}
-	[namespaceCounts removeLastObject];
+	namespaceCountsLength -= 1;
 }
 
 - (void)setPrefix:(NSString*)prefix namespaceURI:(NSString *)namespaceURI {
@@ -223,27 +342,27 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 }
 
 - (void) writeStartDocumentWithEncodingAndVersion:(NSString*)aEncoding version:(NSString*)version {
-	if([writer length] != 0) {
+	if(bufferLength != 0) {
 		// raise exception - Starting document which is not empty
 		@throw([NSException exceptionWithName:@"XMLWriterException" reason:@"Document has already been started" userInfo:NULL]);
 	} else {
-		[self write:@"<?xml version=\""];
+		AWSXMLWriterAppendLiteral(self, "<?xml version=\"");
 		if(version) {
 			[self write:version];
 		} else {
 			// default to 1.0
-			[self write:@"1.0"];
+			AWSXMLWriterAppendLiteral(self, "1.0");
 		}
-		[self write:@"\""];
+		AWSXMLWriterAppendLiteral(self, "\"");
 
 		if(aEncoding) {
-			[self write:@" encoding=\""];
+			AWSXMLWriterAppendLiteral(self, " encoding=\"");
 			[self write:aEncoding];
-			[self write:@"\""];
+			AWSXMLWriterAppendLiteral(self, "\"");
 
 			encoding = aEncoding;
 		}
-		[self write:@" ?>"];
+		AWSXMLWriterAppendLiteral(self, " ?>");
 
 	}
 }
@@ -272,9 +391,9 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	[self pushNamespaceStack];
 
 	if(empty) {
-		[self write:@" />"];
+		AWSXMLWriterAppendLiteral(self, " />");
 	} else {
-		[self write:@">"];
+		AWSXMLWriterAppendLiteral(self, ">");
 	}
 
 	openElement = NO;
@@ -316,7 +435,7 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	[self writeLinebreak];
 	[self writeIndentation];
 
-	[self write:@"<"];
+	AWSXMLWriterAppendLiteral(self, "<");
 	if(namespaceURI) {
 		NSString* prefix = [namespaceURIPrefixMap objectForKey:namespaceURI];
 
@@ -327,10 +446,10 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 
 		if([prefix length]) {
 			[self write:prefix];
-			[self write:@":"];
+			AWSXMLWriterAppendLiteral(self, ":");
 		}
 	}
-	[self write:localName];
+	[self writeLocalName:localName];
 
 	[self pushElementStack:namespaceURI localName:localName];
 
@@ -362,24 +481,26 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	}
 
 	// write standard end element
-	[self write:@"</"];
-
+	NSString* prefix = nil;
 	if(namespaceURI) {
-		NSString* prefix = [namespaceURIPrefixMap objectForKey:namespaceURI];
+		prefix = [namespaceURIPrefixMap objectForKey:namespaceURI];
 
 		if(!prefix) {
 			// raise exception
 			@throw([NSException exceptionWithName:@"XMLWriterException" reason:[NSString stringWithFormat:@"Unknown namespace URI %@", namespaceURI] userInfo:NULL]);
 		}
-
-		if([prefix length]) {
-			[self write:prefix];
-			[self write:@":"];
-		}
 	}
 
-	[self write:localName];
-	[self write:@">"];
+	if([prefix length]) {
+		AWSXMLWriterAppendLiteral(self, "</");
+		[self write:prefix];
+		AWSXMLWriterAppendLiteral(self, ":");
+		[self writeLocalName:localName];
+		AWSXMLWriterAppendLiteral(self, ">");
+	} else {
+		NSData* endTag = [self endTagForLocalName:localName];
+		AWSXMLWriterAppendBytes(self, [endTag bytes], [endTag length]);
+	}
 
 	[self popNamespaceStack];
 	[self popElementStack];
@@ -396,9 +517,9 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	[self writeLinebreak];
 	[self writeIndentation];
 
-	[self write:@"<"];
-	[self write:localName];
-	[self write:@" />"];
+	AWSXMLWriterAppendLiteral(self, "<");
+	[self writeLocalName:localName];
+	AWSXMLWriterAppendLiteral(self, " />");
 
 	emptyElement = YES;
 	openElement = NO;
@@ -412,7 +533,7 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	[self writeLinebreak];
 	[self writeIndentation];
 
-	[self write:@"<"];
+	AWSXMLWriterAppendLiteral(self, "<");
 
 	if(namespaceURI) {
 		NSString* prefix = [namespaceURIPrefixMap objectForKey:namespaceURI];
@@ -424,12 +545,12 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 
 		if([prefix length]) {
 			[self write:prefix];
-			[self write:@":"];
+			AWSXMLWriterAppendLiteral(self, ":");
 		}
 	}
 
-	[self write:localName];
-	[self write:@" />"];
+	[self writeLocalName:localName];
+	AWSXMLWriterAppendLiteral(self, " />");
 
 	emptyElement = YES;
 	openElement = NO;
@@ -441,7 +562,7 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 
 - (void) writeAttributeWithNamespace:(NSString *)namespaceURI localName:(NSString *)localName value:(NSString *)value {
 	if(openElement) {
-		[self write:@" "];
+		AWSXMLWriterAppendLiteral(self, " ");
 
 		if(namespaceURI) {
 			NSString* prefix = [namespaceURIPrefixMap objectForKey:namespaceURI];
@@ -452,13 +573,13 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 
 			if([prefix length]) {
 				[self write:prefix];
-				[self write:@":"];
+				AWSXMLWriterAppendLiteral(self, ":");
 			}
 		}
-		[self write:localName];
-		[self write:@"=\""];
+		[self writeLocalName:localName];
+		AWSXMLWriterAppendLiteral(self, "=\"");
 		[self writeEscape:value];
-		[self write:@"\""];
+		AWSXMLWriterAppendLiteral(self, "\"");
 	} else {
 		// raise expection
 		@throw([NSException exceptionWithName:@"XMLWriterException" reason:@"No open start element" userInfo:NULL]);
@@ -488,7 +609,7 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 
 -(void) writeNamespaceToStream:(NSString*)prefix namespaceURI:(NSString*)namespaceURI {
 	if(openElement) { // write the namespace now
-		[self write:@" "];
+		AWSXMLWriterAppendLiteral(self, " ");
 
 		NSString* xmlnsPrefix = [self getPrefix:XMLNS_NAMESPACE_URI];
 		if(!xmlnsPrefix) {
@@ -500,14 +621,14 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 		if([prefix length]) {
 			// write xmlns:prefix="namespaceURI" attribute
 
-			[self write:@":"]; // colon
+			AWSXMLWriterAppendLiteral(self, ":"); // colon
 			[self write:prefix]; // prefix
 		} else {
 			// write xmlns="namespaceURI" attribute
 		}
-		[self write:@"=\""];
+		AWSXMLWriterAppendLiteral(self, "=\"");
 		[self writeEscape:namespaceURI];
-		[self write:@"\""];
+		AWSXMLWriterAppendLiteral(self, "\"");
 	} else {
 		@throw([NSException exceptionWithName:@"XMLWriterException" reason:@"No open start element" userInfo:NULL]);
 	}
@@ -527,9 +648,9 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	if(openElement) {
 		[self writeCloseElement:NO];
 	}
-	[self write:@"<!--"];
+	AWSXMLWriterAppendLiteral(self, "<!--");
 	[self write:comment]; // no escape
-	[self write:@"-->"];
+	AWSXMLWriterAppendLiteral(self, "-->");
 
 	emptyElement = NO;
 }
@@ -538,11 +659,11 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	if(openElement) {
 		[self writeCloseElement:NO];
 	}
-	[self write:@"<![CDATA["];
+	AWSXMLWriterAppendLiteral(self, "<![CDATA[");
 	[self write:target]; // no escape
-	[self write:@" "];
+	AWSXMLWriterAppendLiteral(self, " ");
 	[self write:data]; // no escape
-	[self write:@"]]>"];
+	AWSXMLWriterAppendLiteral(self, "]]>");
 
 	emptyElement = NO;
 }
@@ -551,171 +672,200 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 	if(openElement) {
 		[self writeCloseElement:NO];
 	}
-	[self write:@"<![CDATA["];
+	AWSXMLWriterAppendLiteral(self, "<![CDATA[");
 	[self write:cdata]; // no escape
-	[self write:@"]]>"];
+	AWSXMLWriterAppendLiteral(self, "]]>");
 
 	emptyElement = NO;
 }
 
 - (void) write:(NSString*)value {
-	[writer appendString:value];
+	NSUInteger length = [value length];
+	if(!length) {
+		return;
+	}
+
+	CFStringRef string = (__bridge CFStringRef)value;
+	const char* characters = CFStringGetCStringPtr(string, kCFStringEncodingASCII);
+	if(characters) {
+		// ASCII is already UTF-8
+		AWSXMLWriterAppendBytes(self, characters, length);
+		return;
+	}
+
+	CFIndex maximumLength = CFStringGetMaximumSizeForEncoding((CFIndex)length, kCFStringEncodingUTF8);
+	AWSXMLWriterReserveBytes(self, (NSUInteger)maximumLength);
+	CFIndex usedLength = 0;
+	CFStringGetBytes(string, CFRangeMake(0, (CFIndex)length), kCFStringEncodingUTF8, 0, false, buffer + bufferLength, maximumLength, &usedLength);
+	bufferLength += (NSUInteger)usedLength;
+}
+
+- (void) writeLocalName:(NSString*)localName {
+	// the local name sits between the </ and the > of the end tag
+	NSData* endTag = [self endTagForLocalName:localName];
+	AWSXMLWriterAppendBytes(self, (const uint8_t*)[endTag bytes] + 2, [endTag length] - 3);
+}
+
+- (NSData*) endTagForLocalName:(NSString*)localName {
+	// element names come from the same strings over and over, so look them up by instance
+	NSData* endTag = [endTags objectForKey:localName];
+	if(!endTag) {
+		NSMutableData* tag = [NSMutableData dataWithBytes:"</" length:2];
+		NSData* name = [localName dataUsingEncoding:NSUTF8StringEncoding];
+		if(name) {
+			[tag appendData:name];
+		}
+		[tag appendBytes:">" length:1];
+
+		endTag = tag;
+		if(localName && [endTags count] < AWSXMLWriterMaximumEndTagCount) {
+			[endTags setObject:endTag forKey:localName];
+		}
+	}
+	return endTag;
 }
 
 - (void) writeEscape:(NSString*)value {
+	NSUInteger length = [value length];
+	if(!length) {
+		return;
+	}
+
+	CFStringRef string = (__bridge CFStringRef)value;
+	const char* asciiCharacters = CFStringGetCStringPtr(string, kCFStringEncodingASCII);
+	if(asciiCharacters) {
+		// main flow for ASCII strings
+		[self writeEscapeASCIICharacters:asciiCharacters length:length];
+		return;
+	}
 
-	const UniChar *characters = CFStringGetCharactersPtr((CFStringRef)value);
+	const UniChar *characters = CFStringGetCharactersPtr(string);
 
 	if (characters) {
 		// main flow
-		[self writeEscapeCharacters:characters length:[value length]];
+		[self writeEscapeCharacters:characters length:length];
 	} else {
 		// we need to read/copy the characters for some reason, from the docs of CFStringGetCharactersPtr:
 		// A pointer to a buffer of Unicode character or NULL if the internal storage of the CFString does not allow this to be returned efficiently.
 		// Whether or not this function returns a valid pointer or NULL depends on many factors, all of which depend on how the string was created and its properties. In addition, the function result might change between different releases and on different platforms. So do not count on receiving a non- NULL result from this function under any circumstances (except when the object is created with CFStringCreateMutableWithExternalCharactersNoCopy).
 
 		// we dont need the whole data length at once
-		NSMutableData *data = [NSMutableData dataWithLength:256 * sizeof(UniChar)];
-
-		if(!data) {
-			// raise exception - no more memory
-			@throw([NSException exceptionWithName:@"XMLWriterException" reason:[NSString stringWithFormat:@"Could not allocate data buffer of %i unicode characters", 256] userInfo:NULL]);
-		}
+		UniChar chunk[AWSXMLWriterEscapeChunkLength];
 
 		NSUInteger count = 0;
 		do {
-			NSUInteger length;
-			if(count + 256 < [value length]) {
-				length = 256;
-			} else {
-				length = [value length] - count;
-			}
-
-			[value getCharacters:[data mutableBytes] range:NSMakeRange(count, length)];
+			NSUInteger chunkLength = MIN(length - count, AWSXMLWriterEscapeChunkLength);
 
-			[self writeEscapeCharacters:[data bytes] length:length];
+			CFStringGetCharacters(string, CFRangeMake((CFIndex)count, (CFIndex)chunkLength), chunk);
 
-			count += length;
-		} while(count < [value length]);
+			[self writeEscapeCharacters:chunk length:chunkLength];
 
-		// buffers autorelease
+			count += chunkLength;
+		} while(count < length);
 	}
 }
 
-- (void)writeEscapeCharacters:(const UniChar*)characters length:(NSUInteger)length {
-	int rangeStart = 0;
-	int rangeLength = 0;
-
-	for(int i = 0; i < length; i++) {
-
-		UniChar c = characters[i];
-		if (c <= 0xd7ff)  {
-			if (c >= 0x20) {
-				switch (c) {
-					case 34: {
-						// write range if any
-						if(rangeLength) {
-							CFStringAppendCharacters((CFMutableStringRef)writer, characters + rangeStart, rangeLength);
-						}
-						[self write:@"&quot;"];
-
-						break;
-					}
-						// quot
-					case 38: {
-						// write range if any
-						if(rangeLength) {
-							CFStringAppendCharacters((CFMutableStringRef)writer, characters + rangeStart, rangeLength);
-						}
-						[self write:@"&amp;"];
-
-						break;
-					}
-						// amp;
-					case 60: {
-						// write range if any
-						if(rangeLength) {
-							CFStringAppendCharacters((CFMutableStringRef)writer, characters + rangeStart, rangeLength);
-						}
-
-						[self write:@"&lt;"];
-
-						break;
-					}
-						// lt;
-					case 62: {
-						// write range if any
-						if(rangeLength) {
-							CFStringAppendCharacters((CFMutableStringRef)writer, characters + rangeStart, rangeLength);
-						}
-
-						[self write:@"&gt;"];
-
-						break;
-					}
-						// gt;
-					default: {
-						// valid
-						rangeLength++;
-
-						// note: we dont need to escape char 39 for &apos; because we use double quotes exclusively
-
-						continue;
-					}
-				}
+- (void) writeEscapeASCIICharacters:(const char*)characters length:(NSUInteger)length {
+	NSUInteger rangeStart = 0;
+	NSUInteger i = 0;
+
+	while(i < length) {
+		// skip eight characters at a time while none of them need escaping
+		while(i + sizeof(uint64_t) <= length) {
+			uint64_t word;
+			memcpy(&word, characters + i, sizeof(uint64_t));
+			if(AWSXMLWriterMayNeedEscape(word)) {
+				break;
+			}
+			i += sizeof(uint64_t);
+		}
 
-				// set range start to next
-				rangeLength = 0;
-				rangeStart = i + 1;
+		// then go character by character until the next run
+		NSUInteger wordEnd = MIN(i + sizeof(uint64_t), length);
+		for(; i < wordEnd; i++) {
+			uint8_t c = (uint8_t)characters[i];
+			uint8_t action = AWSXMLWriterEscapeActions[c];
+			if(action == 0) {
+				// valid
+				continue;
+			}
 
+			// write range if any
+			AWSXMLWriterAppendBytes(self, characters + rangeStart, i - rangeStart);
+
+			if(action == 1) {
+				AWSXMLWriterReserveBytes(self, AWSXMLWriterMaximumEscapedCharacterLength);
+				bufferLength = (NSUInteger)(AWSXMLWriterWriteEntity(buffer + bufferLength, c) - buffer);
 			} else {
-				if (c == '\n' || c == '\r' || c == '\t') {
-					// valid;
-					rangeLength++;
+				// invalid, skip
+			}
+
+			// set range start to next
+			rangeStart = i + 1;
+		}
+	}
 
-					continue;
+	// write range if any
+	// main flow will probably write all characters here
+	AWSXMLWriterAppendBytes(self, characters + rangeStart, length - rangeStart);
+}
+
+- (void)writeEscapeCharacters:(const UniChar*)characters length:(NSUInteger)length {
+	// a character never takes more than AWSXMLWriterMaximumEscapedCharacterLength bytes, so reserve once per chunk
+	// and encode straight into the buffer
+	NSUInteger count = 0;
+	while(count < length) {
+		NSUInteger chunkLength = MIN(length - count, AWSXMLWriterEscapeChunkLength);
+		AWSXMLWriterReserveBytes(self, chunkLength * AWSXMLWriterMaximumEscapedCharacterLength);
+
+		uint8_t* output = buffer + bufferLength;
+		const UniChar* chunkEnd = characters + count + chunkLength;
+		for(const UniChar* character = characters + count; character < chunkEnd; character++) {
+			UniChar c = *character;
+			if (c < 0x80) {
+				uint8_t action = AWSXMLWriterEscapeActions[c];
+				if(action == 0) {
+					// valid
+					*output++ = (uint8_t)c;
+				} else if(action == 1) {
+					output = AWSXMLWriterWriteEntity(output, (uint8_t)c);
 				} else {
 					// invalid, skip
 				}
-			}
-		} else if (c < 0xE000) {
-			// invalid, skip
-		} else if (c <= 0xFFFD) {
-			// valid
-			rangeLength++;
-
-			continue;
-		} else {
-			// invalid, skip
-		}
 
-		// write range if any
-		if(rangeLength) {
-			CFStringAppendCharacters((CFMutableStringRef)writer, characters + rangeStart, rangeLength);
+				// note: we dont need to escape char 39 for &apos; because we use double quotes exclusively
+			} else if (c < 0x800) {
+				// valid
+				*output++ = (uint8_t)(0xC0 | (c >> 6));
+				*output++ = (uint8_t)(0x80 | (c & 0x3F));
+			} else if (c <= 0xd7ff || (c >= 0xE000 && c <= 0xFFFD)) {
+				// valid
+				*output++ = (uint8_t)(0xE0 | (c >> 12));
+				*output++ = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+				*output++ = (uint8_t)(0x80 | (c & 0x3F));
+			} else {
+				// invalid (surrogates, 0xFFFE and 0xFFFF), skip
+			}
 		}
+		bufferLength = (NSUInteger)(output - buffer);
 
-		// set range start to next
-		rangeLength = 0;
-		rangeStart = i + 1;
-	}
-
-	// write range if any
-	if(rangeLength) {
-		// main flow will probably write all characters here
-		CFStringAppendCharacters((CFMutableStringRef)writer, characters + rangeStart, rangeLength);
+		count += chunkLength;
 	}
 }
 
 - (void)writeLinebreak {
-	if(lineBreak) {
-		[self write:lineBreak];
+	if(lineBreakBytes) {
+		AWSXMLWriterAppendBytes(self, [lineBreakBytes bytes], [lineBreakBytes length]);
 	}
 }
 
 - (void)writeIndentation {
-	if(indentation) {
+	NSUInteger indentationLength = [indentationBytes length];
+	if(indentationLength) {
+		const void* indentationCharacters = [indentationBytes bytes];
+		AWSXMLWriterReserveBytes(self, indentationLength * (NSUInteger)level);
 		for (int i = 0; i < level; i++) {
-			[self write:indentation];
+			AWSXMLWriterAppendBytes(self, indentationCharacters, indentationLength);
 		}
 	}
 }
@@ -729,16 +879,44 @@ static NSString *const XSI_NAMESPACE_URI_PREFIX = @"xsi";
 }
 
 - (NSMutableString*) toString {
-	return writer;
+	if(!bufferLength) {
+		return [NSMutableString string];
+	}
+	return [[NSMutableString alloc] initWithBytes:buffer length:bufferLength encoding:NSUTF8StringEncoding];
+}
+
+- (BOOL) isUTF8Encoded {
+	return !encoding || CFStringConvertIANACharSetNameToEncoding((__bridge CFStringRef)encoding) == kCFStringEncodingUTF8;
 }
 
 - (NSData*) toData {
-	if(encoding) {
-		return [writer dataUsingEncoding: CFStringConvertEncodingToNSStringEncoding(CFStringConvertIANACharSetNameToEncoding((CFStringRef)encoding)) allowLossyConversion:NO];
+	if([self isUTF8Encoded]) {
+		return [NSData dataWithBytes:buffer length:bufferLength];
 	} else {
-		return [writer dataUsingEncoding:NSUTF8StringEncoding allowLossyConversion:NO];
+		return [[self toString] dataUsingEncoding: CFStringConvertEncodingToNSStringEncoding(CFStringConvertIANACharSetNameToEncoding((__bridge CFStringRef)encoding)) allowLossyConversion:NO];
 	}
 }
 
+- (NSData*) detachData {
+	NSData* data = nil;
+	if([self isUTF8Encoded] && bufferLength) {
+		// give back the unused capacity, then hand the buffer over to the data
+		uint8_t* shrunkBuffer = realloc(buffer, bufferLength);
+		if(shrunkBuffer) {
+			buffer = shrunkBuffer;
+		}
+		data = [NSData dataWithBytesNoCopy:buffer length:bufferLength freeWhenDone:YES];
+	} else {
+		data = [self toData];
+		free(buffer);
+	}
+
+	buffer = NULL;
+	bufferLength = 0;
+	bufferCapacity = 0;
+
+	return data;
+}
+
 
 @end
@@ -0,0 +1,237 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+
+static NSString *const AWSChunkedTestEmptySha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+static NSString *const AWSChunkedTestHeaderSignature = @"4f232c4386841ef735655705268965c44a0e4690baa4adea153f7db9fa80a0a9";
+static NSString *const AWSChunkedTestScope = @"20130524/us-east-1/s3/aws4_request";
+
+// An input stream that never returns more than a few bytes per read, like a socket or a pipe.
+@interface AWSChunkedTestTricklingInputStream : NSInputStream
+
+@property (nonatomic, strong) NSInputStream *stream;
+@property (nonatomic, assign) NSUInteger maxReadLength;
+
+@end
+
+@implementation AWSChunkedTestTricklingInputStream
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
+    return [self.stream read:buffer maxLength:MIN(len, self.maxReadLength)];
+}
+
+- (BOOL)hasBytesAvailable {
+    return [self.stream hasBytesAvailable];
+}
+
+- (void)open {
+    [self.stream open];
+}
+
+- (void)close {
+    [self.stream close];
+}
+
+- (NSStreamStatus)streamStatus {
+    return [self.stream streamStatus];
+}
+
+@end
+
+@interface AWSS3ChunkedEncodingInputStreamTests : XCTestCase
+
+@end
+
+@implementation AWSS3ChunkedEncodingInputStreamTests
+
++ (NSDate *)signingDate {
+    return [NSDate dateWithTimeIntervalSince1970:1369353600];
+}
+
++ (NSData *)signingKey {
+    return [AWSSignatureV4Signer getV4DerivedKey:@"wJalrXUtnFEMI/K7MDENG/bPxRfiCYEXAMPLEKEY"
+                                            date:@"20130524"
+                                          region:@"us-east-1"
+                                         service:@"s3"];
+}
+
++ (NSData *)payloadOfLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    for (NSUInteger i = 0; i < length; i++) {
+        bytes[i] = (uint8_t)(i * 31 + (i >> 8));
+    }
+    return data;
+}
+
+// Encodes the payload the way the chunk signing algorithm is specified, one string to sign at a time.
++ (NSData *)referenceEncodingOfData:(NSData *)data chunkSize:(NSUInteger)chunkSize {
+    NSMutableData *encoded = [NSMutableData new];
+    NSString *priorSignature = AWSChunkedTestHeaderSignature;
+    NSString *date = [[self signingDate] aws_stringValue:AWSDateISO8601DateFormat2];
+    NSUInteger location = 0;
+    while (YES) {
+        NSUInteger length = MIN(chunkSize, data.length - location);
+        NSData *chunk = [data subdataWithRange:NSMakeRange(location, length)];
+        location += length;
+
+        NSString *chunkSha256 = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:[AWSSignatureSignerUtility hashData:chunk]
+                                                                                           encoding:NSASCIIStringEncoding]];
+        NSString *stringToSign = [NSString stringWithFormat:@"AWS4-HMAC-SHA256-PAYLOAD\n%@\n%@\n%@\n%@\n%@",
+                                  date, AWSChunkedTestScope, priorSignature, AWSChunkedTestEmptySha256, chunkSha256];
+        NSData *signature = [AWSSignatureSignerUtility sha256HMacWithData:[stringToSign dataUsingEncoding:NSUTF8StringEncoding]
+                                                                  withKey:[self signingKey]];
+        priorSignature = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:signature
+                                                                                    encoding:NSASCIIStringEncoding]];
+
+        NSString *header = [NSString stringWithFormat:@"%06lx;chunk-signature=%@\r\n", (unsigned long)length, priorSignature];
+        [encoded appendData:[header dataUsingEncoding:NSUTF8StringEncoding]];
+        [encoded appendData:chunk];
+        [encoded appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
+        if (length == 0) {
+            return encoded;
+        }
+    }
+}
+
++ (AWSS3ChunkedEncodingInputStream *)chunkedStreamWithStream:(NSInputStream *)stream chunkSize:(NSUInteger)chunkSize {
+    return [[AWSS3ChunkedEncodingInputStream alloc] initWithInputStream:stream
+                                                                   date:[self signingDate]
+                                                                  scope:AWSChunkedTestScope
+                                                               kSigning:[self signingKey]
+                                                        headerSignature:AWSChunkedTestHeaderSignature
+                                                              chunkSize:chunkSize];
+}
+
++ (NSData *)readAll:(NSInputStream *)stream readLength:(NSUInteger)readLength {
+    NSMutableData *result = [NSMutableData new];
+    NSMutableData *buffer = [NSMutableData dataWithLength:readLength];
+    [stream open];
+    while ([stream hasBytesAvailable]) {
+        NSInteger read = [stream read:buffer.mutableBytes maxLength:readLength];
+        if (read <= 0) {
+            break;
+        }
+        [result appendBytes:buffer.bytes length:(NSUInteger)read];
+    }
+    [stream close];
+    return result;
+}
+
+- (void)testEncodingMatchesReference {
+    NSUInteger chunkSize = AWSS3ChunkedEncodingMinimumChunkSize;
+    NSArray<NSNumber *> *payloadLengths = @[@0, @1, @(chunkSize - 1), @(chunkSize), @(3 * chunkSize + 17)];
+    // Smaller than a header, smaller than a chunk, and room for several chunks.
+    NSArray<NSNumber *> *readLengths = @[@7, @4096, @(chunkSize + 91), @(1024 * 1024)];
+
+    for (NSNumber *payloadLength in payloadLengths) {
+        NSData *payload = [[self class] payloadOfLength:payloadLength.unsignedIntegerValue];
+        NSData *expected = [[self class] referenceEncodingOfData:payload chunkSize:chunkSize];
+        XCTAssertEqual(expected.length, [AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:payload.length chunkSize:chunkSize]);
+
+        for (NSNumber *readLength in readLengths) {
+            AWSS3ChunkedEncodingInputStream *stream = [[self class] chunkedStreamWithStream:[NSInputStream inputStreamWithData:payload]
+                                                                                  chunkSize:chunkSize];
+            NSData *encoded = [[self class] readAll:stream readLength:readLength.unsignedIntegerValue];
+            XCTAssertEqualObjects(encoded, expected, @"payload %@, read length %@", payloadLength, readLength);
+            XCTAssertEqual(stream.totalLengthOfChunkSignatureSent, (int64_t)(expected.length - payload.length));
+            XCTAssertFalse([stream hasBytesAvailable]);
+        }
+    }
+}
+
+- (void)testShortReadsStillProduceFullChunks {
+    NSUInteger chunkSize = 64 * 1024;
+    NSData *payload = [[self class] payloadOfLength:5 * chunkSize + 100];
+    AWSChunkedTestTricklingInputStream *trickling = [AWSChunkedTestTricklingInputStream new];
+    trickling.stream = [NSInputStream inputStreamWithData:payload];
+    trickling.maxReadLength = 1000;
+
+    AWSS3ChunkedEncodingInputStream *stream = [[self class] chunkedStreamWithStream:trickling chunkSize:chunkSize];
+    NSData *encoded = [[self class] readAll:stream readLength:32 * 1024];
+    XCTAssertEqualObjects(encoded, [[self class] referenceEncodingOfData:payload chunkSize:chunkSize]);
+}
+
+- (void)testChunkSizeIsClamped {
+    NSInputStream *input = [NSInputStream inputStreamWithData:[NSData data]];
+    XCTAssertEqual([[self class] chunkedStreamWithStream:input chunkSize:1].chunkSize, AWSS3ChunkedEncodingMinimumChunkSize);
+    XCTAssertEqual([[self class] chunkedStreamWithStream:input chunkSize:NSUIntegerMax].chunkSize, AWSS3ChunkedEncodingMaximumChunkSize);
+    XCTAssertEqual([[self class] chunkedStreamWithStream:input chunkSize:1024 * 1024].chunkSize, 1024 * 1024);
+
+    AWSS3ChunkedEncodingInputStream *stream = [[AWSS3ChunkedEncodingInputStream alloc] initWithInputStream:input
+                                                                                                      date:[[self class] signingDate]
+                                                                                                     scope:AWSChunkedTestScope
+                                                                                                  kSigning:[[self class] signingKey]
+                                                                                           headerSignature:AWSChunkedTestHeaderSignature];
+    XCTAssertEqual(stream.chunkSize, AWSS3ChunkedEncodingDefaultChunkSize);
+    XCTAssertEqual([AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:100],
+                   [AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:100 chunkSize:AWSS3ChunkedEncodingDefaultChunkSize]);
+}
+
+- (void)testMaximumChunkSize {
+    NSUInteger chunkSize = AWSS3ChunkedEncodingMaximumChunkSize;
+    NSData *payload = [[self class] payloadOfLength:chunkSize + 1];
+    AWSS3ChunkedEncodingInputStream *stream = [[self class] chunkedStreamWithStream:[NSInputStream inputStreamWithData:payload]
+                                                                          chunkSize:chunkSize];
+    NSData *encoded = [[self class] readAll:stream readLength:chunkSize * 2];
+    XCTAssertEqualObjects(encoded, [[self class] referenceEncodingOfData:payload chunkSize:chunkSize]);
+    XCTAssertTrue([[[NSString alloc] initWithData:[encoded subdataWithRange:NSMakeRange(0, 6)] encoding:NSASCIIStringEncoding] isEqualToString:@"800000"]);
+}
+
+#pragma mark - Performance
+
+- (NSURL *)writePayloadFileOfLength:(NSUInteger)length {
+    NSURL *fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[[self class] payloadOfLength:length] writeToURL:fileURL atomically:NO];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+    }];
+    return fileURL;
+}
+
+- (void)measureThroughputWithChunkSize:(NSUInteger)chunkSize {
+    NSUInteger payloadLength = 64 * 1024 * 1024;
+    NSURL *fileURL = [self writePayloadFileOfLength:payloadLength];
+    // NSURLSession reads request bodies in 32 KB pieces.
+    NSMutableData *buffer = [NSMutableData dataWithLength:32 * 1024];
+
+    [self measureBlock:^{
+        AWSS3ChunkedEncodingInputStream *stream = [[self class] chunkedStreamWithStream:[NSInputStream inputStreamWithURL:fileURL]
+                                                                              chunkSize:chunkSize];
+        NSUInteger total = 0;
+        [stream open];
+        while ([stream hasBytesAvailable]) {
+            NSInteger read = [stream read:buffer.mutableBytes maxLength:buffer.length];
+            if (read <= 0) {
+                break;
+            }
+            total += (NSUInteger)read;
+        }
+        [stream close];
+        XCTAssertEqual(total, [AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:payloadLength chunkSize:chunkSize]);
+    }];
+}
+
+- (void)testThroughputWithDefaultChunkSize {
+    [self measureThroughputWithChunkSize:AWSS3ChunkedEncodingDefaultChunkSize];
+}
+
+- (void)testThroughputWithOneMegabyteChunks {
+    [self measureThroughputWithChunkSize:1024 * 1024];
+}
+
+@end
@@ -16,6 +16,7 @@
 #import <XCTest/XCTest.h>
 #import "AWSCore.h"
 #import "AWSTestUtility.h"
+#import "OCMock.h"
 
 @interface AWSCognitoIdentity()
 
@@ -31,7 +32,43 @@
 
 @interface AWSURLSessionManager()
 
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, strong) AWSSynchronizedMutableDictionary *sessionManagerDelegates;
+
 - (void)invalidate;
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition disposition))completionHandler;
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data;
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)sessionTask didCompleteWithError:(NSError *)error;
+
+@end
+
+// Asks for every failed request to be retried and counts how often it was asked.
+@interface AWSURLSessionManagerTestsRetryHandler : NSObject <AWSURLRequestRetryHandler>
+
+@property (nonatomic, assign) NSUInteger shouldRetryCount;
+
+@end
+
+@implementation AWSURLSessionManagerTestsRetryHandler
+
+@synthesize maxRetryCount;
+
+- (AWSNetworkingRetryType)shouldRetry:(uint32_t)currentRetryCount
+                      originalRequest:(AWSNetworkingRequest *)originalRequest
+                             response:(NSHTTPURLResponse *)response
+                                 data:(NSData *)data
+                                error:(NSError *)error {
+    self.shouldRetryCount++;
+    return AWSNetworkingRetryTypeShouldRetry;
+}
+
+- (NSTimeInterval)timeIntervalForRetry:(uint32_t)currentRetryCount
+                              response:(NSHTTPURLResponse *)response
+                                  data:(NSData *)data
+                                 error:(NSError *)error {
+    return 0;
+}
 
 @end
 
@@ -113,4 +150,321 @@
     }] waitUntilFinished];
 }
 
+/**
+ - Given: A request with a `dataReceived` block
+ - When: A successful response body arrives in several chunks
+ - Then: Each chunk is delivered to the block as it arrives and nothing is buffered
+ */
+- (void)testDataReceivedStreamsSuccessfulResponseBody {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    NSMutableArray<NSData *> *receivedChunks = [NSMutableArray new];
+    __block int64_t lastTotalBytesReceived = 0;
+    request.dataReceived = ^(NSData *data, int64_t totalBytesReceived, int64_t totalBytesExpectedToReceive) {
+        [receivedChunks addObject:data];
+        lastTotalBytesReceived = totalBytesReceived;
+        XCTAssertEqual(totalBytesExpectedToReceive, 6);
+    };
+
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:1];
+    id dataTask = [self mockDataTaskWithIdentifier:1 statusCode:200 contentLength:6];
+
+    [self sendChunks:@[[@"abc" dataUsingEncoding:NSUTF8StringEncoding], [@"def" dataUsingEncoding:NSUTF8StringEncoding]]
+            dataTask:dataTask
+      sessionManager:sessionManager];
+
+    XCTAssertEqual(receivedChunks.count, 2);
+    XCTAssertEqual(lastTotalBytesReceived, 6);
+    XCTAssertNil([delegate valueForKey:@"responseData"]);
+    [sessionManager invalidate];
+}
+
+/**
+ - Given: A request with a `dataReceived` block
+ - When: An error response body arrives
+ - Then: The body is buffered for the response serializer instead of being streamed
+ */
+- (void)testDataReceivedDoesNotStreamErrorResponseBody {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.dataReceived = ^(NSData *data, int64_t totalBytesReceived, int64_t totalBytesExpectedToReceive) {
+        XCTFail(@"Error bodies should not be streamed");
+    };
+
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:2];
+    id dataTask = [self mockDataTaskWithIdentifier:2 statusCode:400 contentLength:5];
+
+    [self sendChunks:@[[@"error" dataUsingEncoding:NSUTF8StringEncoding]]
+            dataTask:dataTask
+      sessionManager:sessionManager];
+
+    XCTAssertEqualObjects([delegate valueForKey:@"responseData"], [@"error" dataUsingEncoding:NSUTF8StringEncoding]);
+    [sessionManager invalidate];
+}
+
+/**
+ - Given: A request without a `dataReceived` block
+ - When: A response body with a Content-Length arrives in several chunks
+ - Then: The chunks are accumulated into a single buffer
+ */
+- (void)testResponseBodyIsBufferedWhenNotStreaming {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:3];
+    id dataTask = [self mockDataTaskWithIdentifier:3 statusCode:200 contentLength:6];
+
+    [self sendChunks:@[[@"abc" dataUsingEncoding:NSUTF8StringEncoding], [@"def" dataUsingEncoding:NSUTF8StringEncoding]]
+            dataTask:dataTask
+      sessionManager:sessionManager];
+
+    XCTAssertEqualObjects([delegate valueForKey:@"responseData"], [@"abcdef" dataUsingEncoding:NSUTF8StringEncoding]);
+    [sessionManager invalidate];
+}
+
+/**
+ - Given: A request with a `dataReceived` block and a retry handler
+ - When: The connection fails after part of the body was delivered to the block
+ - Then: The request fails without being retried, so the block never receives the body from the start again
+ */
+- (void)testStreamedResponseIsNotRetried {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    AWSURLSessionManagerTestsRetryHandler *retryHandler = [AWSURLSessionManagerTestsRetryHandler new];
+    request.retryHandler = retryHandler;
+    request.dataReceived = ^(NSData *data, int64_t totalBytesReceived, int64_t totalBytesExpectedToReceive) {};
+
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:9];
+    AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    [delegate setValue:taskCompletionSource forKey:@"taskCompletionSource"];
+    id dataTask = [self mockDataTaskWithIdentifier:9 statusCode:200 contentLength:6];
+
+    [self sendChunks:@[[@"abc" dataUsingEncoding:NSUTF8StringEncoding]] dataTask:dataTask sessionManager:sessionManager];
+    NSError *connectionLost = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil];
+    [sessionManager URLSession:sessionManager.session task:dataTask didCompleteWithError:connectionLost];
+
+    [taskCompletionSource.task waitUntilFinished];
+    XCTAssertEqualObjects(taskCompletionSource.task.error, connectionLost);
+    XCTAssertEqual(retryHandler.shouldRetryCount, 0);
+    [sessionManager invalidate];
+}
+
+/**
+ - Given: A request without a `dataReceived` block
+ - When: A response declares a Content-Length far larger than its body
+ - Then: The body is buffered without first allocating the declared length
+ */
+- (void)testResponseBufferPresizingIsCapped {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:10];
+    id dataTask = [self mockDataTaskWithIdentifier:10 statusCode:200 contentLength:NSUIntegerMax / 2];
+
+    [self sendChunks:@[[@"abc" dataUsingEncoding:NSUTF8StringEncoding]] dataTask:dataTask sessionManager:sessionManager];
+
+    XCTAssertEqualObjects([delegate valueForKey:@"responseData"], [@"abc" dataUsingEncoding:NSUTF8StringEncoding]);
+    [sessionManager.sessionManagerDelegates removeObjectForKey:@10];
+    [sessionManager invalidate];
+}
+
+/**
+ - Given: A request that inflates gzip responses and has a `dataReceived` block
+ - When: A gzip response body arrives in small chunks
+ - Then: The decompressed body is delivered to the block as it arrives
+ */
+- (void)testGZIPResponseBodyIsInflatedAsItArrives {
+    NSMutableString *body = [NSMutableString new];
+    for (NSUInteger i = 0; i < 2000; i++) {
+        [body appendFormat:@"{\"Key\":\"exports/part-%05lu.json\",\"Size\":%lu}\n", (unsigned long)i, (unsigned long)(i * 31)];
+    }
+    NSData *bodyData = [body dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *compressedBody = [bodyData awsgzip_gzippedData];
+
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.inflatesGZIPResponses = YES;
+    NSMutableData *receivedData = [NSMutableData new];
+    __block int64_t lastTotalBytesReceived = 0;
+    request.dataReceived = ^(NSData *data, int64_t totalBytesReceived, int64_t totalBytesExpectedToReceive) {
+        [receivedData appendData:data];
+        lastTotalBytesReceived = totalBytesReceived;
+        XCTAssertEqual(totalBytesExpectedToReceive, NSURLResponseUnknownLength);
+    };
+
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:5];
+    id dataTask = [self mockDataTaskWithIdentifier:5 statusCode:200 contentLength:compressedBody.length];
+
+    NSMutableArray<NSData *> *chunks = [NSMutableArray new];
+    for (NSUInteger offset = 0; offset < compressedBody.length; offset += 100) {
+        [chunks addObject:[compressedBody subdataWithRange:NSMakeRange(offset, MIN(100, compressedBody.length - offset))]];
+    }
+    [self sendChunks:chunks dataTask:dataTask sessionManager:sessionManager];
+
+    XCTAssertEqualObjects(receivedData, bodyData);
+    XCTAssertEqual(lastTotalBytesReceived, (int64_t)bodyData.length);
+    XCTAssertNil([delegate valueForKey:@"responseData"]);
+    [sessionManager invalidate];
+}
+
+/**
+ - Given: A request that inflates gzip responses
+ - When: A response body that is not gzip arrives
+ - Then: The body is buffered as it is
+ */
+- (void)testUncompressedResponseBodyIsNotInflated {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.inflatesGZIPResponses = YES;
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:6];
+    id dataTask = [self mockDataTaskWithIdentifier:6 statusCode:200 contentLength:6];
+
+    [self sendChunks:@[[@"abc" dataUsingEncoding:NSUTF8StringEncoding], [@"def" dataUsingEncoding:NSUTF8StringEncoding]]
+            dataTask:dataTask
+      sessionManager:sessionManager];
+
+    XCTAssertEqualObjects([delegate valueForKey:@"responseData"], [@"abcdef" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertNil([delegate valueForKey:@"inflater"]);
+    [sessionManager invalidate];
+}
+
+/**
+ - Given: A request that inflates gzip responses
+ - When: A response keeps its gzip `Content-Encoding` header but the URL session has already decoded its body
+ - Then: The body is buffered as it is, without an error
+ */
+- (void)testDecodedBodyWithGZIPContentEncodingIsNotInflated {
+    NSData *decodedBody = [@"{\"Key\":\"exports/part-00000.json\"}" dataUsingEncoding:NSUTF8StringEncoding];
+
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.inflatesGZIPResponses = YES;
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:8];
+    id dataTask = [self mockDataTaskWithIdentifier:8
+                                        statusCode:200
+                                     contentLength:decodedBody.length
+                                   contentEncoding:@"gzip"];
+
+    [self sendChunks:@[[decodedBody subdataWithRange:NSMakeRange(0, 10)],
+                       [decodedBody subdataWithRange:NSMakeRange(10, decodedBody.length - 10)]]
+            dataTask:dataTask
+      sessionManager:sessionManager];
+
+    XCTAssertEqualObjects([delegate valueForKey:@"responseData"], decodedBody);
+    XCTAssertNil([delegate valueForKey:@"inflater"]);
+    XCTAssertNil([delegate valueForKey:@"error"]);
+    [sessionManager invalidate];
+}
+
+/**
+ - Given: A request that inflates gzip responses
+ - When: A response body starts like gzip but is corrupt
+ - Then: The task is cancelled with an inflater error
+ */
+- (void)testCorruptGZIPResponseBodyCancelsTask {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.inflatesGZIPResponses = YES;
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+    id delegate = [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:7];
+    id dataTask = [self mockDataTaskWithIdentifier:7 statusCode:200 contentLength:12];
+
+    const uint8_t corruptBody[] = {0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xff};
+    [self sendChunks:@[[NSData dataWithBytes:corruptBody length:sizeof(corruptBody)]]
+            dataTask:dataTask
+      sessionManager:sessionManager];
+
+    NSError *error = [delegate valueForKey:@"error"];
+    XCTAssertEqualObjects(error.domain, AWSGZIPResponseInflaterErrorDomain);
+    XCTAssertEqual(error.code, AWSGZIPResponseInflaterErrorInvalidData);
+    OCMVerify([dataTask cancel]);
+    [sessionManager invalidate];
+}
+
+/**
+ Benchmarks receiving a 200 MB body in 64 KB chunks, buffered versus streamed.
+ */
+- (void)testPerformanceReceiving200MBResponseBody {
+    static const NSUInteger bodyLength = 200 * 1024 * 1024;
+    static const NSUInteger chunkLength = 64 * 1024;
+    NSData *chunk = [NSMutableData dataWithLength:chunkLength];
+    AWSURLSessionManager *sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:[AWSNetworkingConfiguration new]];
+
+    void (^receiveBody)(BOOL) = ^(BOOL streaming) {
+        AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+        if (streaming) {
+            request.dataReceived = ^(NSData *data, int64_t totalBytesReceived, int64_t totalBytesExpectedToReceive) {};
+        }
+        [self registerDelegateForRequest:request sessionManager:sessionManager taskIdentifier:4];
+        id dataTask = [self mockDataTaskWithIdentifier:4 statusCode:200 contentLength:bodyLength];
+        [sessionManager URLSession:sessionManager.session
+                          dataTask:dataTask
+                didReceiveResponse:[dataTask response]
+                 completionHandler:^(NSURLSessionResponseDisposition disposition) {}];
+        for (NSUInteger offset = 0; offset < bodyLength; offset += chunkLength) {
+            [sessionManager URLSession:sessionManager.session dataTask:dataTask didReceiveData:chunk];
+        }
+        [sessionManager.sessionManagerDelegates removeObjectForKey:@4];
+    };
+
+    if (@available(iOS 13.0, macOS 10.15, *)) {
+        NSArray<id<XCTMetric>> *metrics = @[[XCTClockMetric new], [XCTMemoryMetric new]];
+        [self measureWithMetrics:metrics block:^{
+            receiveBody(NO);
+        }];
+        [self measureWithMetrics:metrics block:^{
+            receiveBody(YES);
+        }];
+    }
+    [sessionManager invalidate];
+}
+
+#pragma mark - Helpers
+
+- (id)registerDelegateForRequest:(AWSNetworkingRequest *)request
+                  sessionManager:(AWSURLSessionManager *)sessionManager
+                  taskIdentifier:(NSUInteger)taskIdentifier {
+    id delegate = [NSClassFromString(@"AWSURLSessionManagerDelegate") new];
+    [delegate setValue:request forKey:@"request"];
+    [sessionManager.sessionManagerDelegates setObject:delegate forKey:@(taskIdentifier)];
+    return delegate;
+}
+
+- (id)mockDataTaskWithIdentifier:(NSUInteger)taskIdentifier
+                      statusCode:(NSInteger)statusCode
+                   contentLength:(NSUInteger)contentLength {
+    return [self mockDataTaskWithIdentifier:taskIdentifier
+                                 statusCode:statusCode
+                              contentLength:contentLength
+                            contentEncoding:nil];
+}
+
+- (id)mockDataTaskWithIdentifier:(NSUInteger)taskIdentifier
+                      statusCode:(NSInteger)statusCode
+                   contentLength:(NSUInteger)contentLength
+                 contentEncoding:(NSString *)contentEncoding {
+    NSMutableDictionary *headerFields = [NSMutableDictionary dictionaryWithObject:[@(contentLength) stringValue]
+                                                                           forKey:@"Content-Length"];
+    headerFields[@"Content-Encoding"] = contentEncoding;
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@"https://example.com"]
+                                                              statusCode:statusCode
+                                                             HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:headerFields];
+    id dataTask = OCMClassMock([NSURLSessionDataTask class]);
+    OCMStub([dataTask taskIdentifier]).andReturn(taskIdentifier);
+    OCMStub([dataTask response]).andReturn(response);
+    return dataTask;
+}
+
+- (void)sendChunks:(NSArray<NSData *> *)chunks
+          dataTask:(id)dataTask
+    sessionManager:(AWSURLSessionManager *)sessionManager {
+    [sessionManager URLSession:sessionManager.session
+                      dataTask:dataTask
+            didReceiveResponse:[dataTask response]
+             completionHandler:^(NSURLSessionResponseDisposition disposition) {
+        XCTAssertEqual(disposition, NSURLSessionResponseAllow);
+    }];
+    for (NSData *chunk in chunks) {
+        [sessionManager URLSession:sessionManager.session dataTask:dataTask didReceiveData:chunk];
+    }
+}
+
 @end
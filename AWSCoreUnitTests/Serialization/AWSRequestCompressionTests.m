@@ -0,0 +1,272 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+#import "AWSRequestCompression.h"
+
+@interface AWSRequestCompressionTests : XCTestCase
+
+@end
+
+@implementation AWSRequestCompressionTests
+
+#pragma mark - Payloads
+
+// A Kinesis PutRecords body of 500 records.
++ (NSData *)putRecordsBody {
+    NSMutableArray *records = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 500; i++) {
+        NSDictionary *event = @{@"eventId": [NSString stringWithFormat:@"event-%lu", (unsigned long)i],
+                                @"deviceId": @"8C5F2A3E-6D1B-4F7A-9E2C-1B3D5F7A9C0E",
+                                @"timestamp": @(1700000000 + i),
+                                @"temperature": @(20.0 + (i % 17) / 10.0),
+                                @"status": i % 5 == 0 ? @"warning" : @"ok"};
+        NSData *data = [NSJSONSerialization dataWithJSONObject:event options:0 error:nil];
+        [records addObject:@{@"Data": [data base64EncodedStringWithOptions:0],
+                             @"PartitionKey": [NSString stringWithFormat:@"partition-%lu", (unsigned long)(i % 8)]}];
+    }
+    return [NSJSONSerialization dataWithJSONObject:@{@"StreamName": @"telemetry", @"Records": records} options:0 error:nil];
+}
+
+// A Pinpoint PutEvents body of 100 events.
++ (NSData *)putEventsBody {
+    NSMutableDictionary *events = [NSMutableDictionary new];
+    for (NSUInteger i = 0; i < 100; i++) {
+        events[[[NSUUID UUID] UUIDString]] = @{@"EventType": i % 3 == 0 ? @"_session.start" : @"purchase",
+                                               @"Timestamp": @"2024-01-01T12:00:00.000Z",
+                                               @"AppPackageName": @"com.example.app",
+                                               @"AppVersionCode": @"1.2.3",
+                                               @"SdkName": @"aws-sdk-iOS",
+                                               @"Attributes": @{@"item": [NSString stringWithFormat:@"item-%lu", (unsigned long)i],
+                                                                @"currency": @"USD"},
+                                               @"Metrics": @{@"price": @(i * 1.5), @"quantity": @(i % 4 + 1)},
+                                               @"Session": @{@"Id": @"session-1", @"StartTimestamp": @"2024-01-01T11:59:00.000Z"}};
+    }
+    NSDictionary *body = @{@"BatchItem": @{@"endpoint-1": @{@"Endpoint": @{@"ChannelType": @"APNS",
+                                                                           @"Demographic": @{@"Make": @"Apple",
+                                                                                             @"Model": @"iPhone",
+                                                                                             @"Platform": @"iOS"}},
+                                                            @"Events": events}}};
+    return [NSJSONSerialization dataWithJSONObject:body options:0 error:nil];
+}
+
+// A CloudWatch Logs PutLogEvents body of 1,000 log lines.
++ (NSData *)putLogEventsBody {
+    NSMutableArray *logEvents = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        NSString *message = [NSString stringWithFormat:@"2024-01-01 12:00:%02lu.%03lu [INFO] RequestHandler - Handled request %lu in %lu ms",
+                             (unsigned long)(i / 60 % 60), (unsigned long)(i % 1000), (unsigned long)i, (unsigned long)(i * 7 % 300)];
+        [logEvents addObject:@{@"timestamp": @(1704110400000 + i), @"message": message}];
+    }
+    return [NSJSONSerialization dataWithJSONObject:@{@"logGroupName": @"app", @"logStreamName": @"device", @"logEvents": logEvents}
+                                           options:0
+                                             error:nil];
+}
+
++ (NSData *)randomDataOfLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    arc4random_buf(data.mutableBytes, length);
+    return data;
+}
+
++ (NSMutableURLRequest *)requestWithBody:(NSData *)body {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://kinesis.us-east-1.amazonaws.com"]];
+    request.HTTPMethod = @"POST";
+    request.HTTPBody = body;
+    return request;
+}
+
+#pragma mark - Compressor
+
+- (void)testGZIPRoundTrip {
+    NSData *body = [AWSRequestCompressionTests putRecordsBody];
+    AWSGZIPRequestCompressor *compressor = [AWSGZIPRequestCompressor new];
+    XCTAssertEqualObjects(compressor.contentEncoding, @"gzip");
+
+    // Reuses the pooled stream across bodies and levels.
+    for (int level = -1; level <= 9; level++) {
+        NSData *compressedBody = [compressor compressData:body level:level];
+        XCTAssertNotNil(compressedBody);
+        if (level != 0) {
+            // Level 0 stores the body without compressing it.
+            XCTAssertLessThan(compressedBody.length, body.length);
+        }
+        XCTAssertEqualObjects([compressedBody awsgzip_gunzippedData], body);
+    }
+}
+
+- (void)testGZIPMatchesOneShotDeflate {
+    NSData *body = [AWSRequestCompressionTests putEventsBody];
+    NSData *compressedBody = [[AWSGZIPRequestCompressor sharedCompressor] compressData:body level:-1];
+    XCTAssertEqualObjects(compressedBody, [body awsgzip_gzippedData]);
+}
+
+- (void)testGZIPCompressesBodiesLargerThanAnInputSlice {
+    NSMutableData *body = [NSMutableData new];
+    NSData *logEvents = [AWSRequestCompressionTests putLogEventsBody];
+    while (body.length < 3 * 1024 * 1024) {
+        [body appendData:logEvents];
+    }
+    [body appendData:[AWSRequestCompressionTests randomDataOfLength:100 * 1024]];
+
+    NSData *compressedBody = [[AWSGZIPRequestCompressor sharedCompressor] compressData:body level:1];
+    XCTAssertEqualObjects([compressedBody awsgzip_gunzippedData], body);
+}
+
+- (void)testGZIPEmptyData {
+    XCTAssertNil([[AWSGZIPRequestCompressor sharedCompressor] compressData:[NSData data] level:6]);
+}
+
+- (void)testGZIPConcurrentCompression {
+    NSArray<NSData *> *bodies = @[[AWSRequestCompressionTests putRecordsBody],
+                                  [AWSRequestCompressionTests putEventsBody],
+                                  [AWSRequestCompressionTests putLogEventsBody]];
+    AWSGZIPRequestCompressor *compressor = [AWSGZIPRequestCompressor new];
+    __block NSUInteger mismatches = 0;
+    dispatch_apply(48, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        NSData *body = bodies[i % bodies.count];
+        NSData *compressedBody = [compressor compressData:body level:(int)(i % 10)];
+        if (![[compressedBody awsgzip_gunzippedData] isEqualToData:body]) {
+            @synchronized(self) {
+                mismatches++;
+            }
+        }
+    });
+    XCTAssertEqual(mismatches, 0);
+}
+
+#pragma mark - Policy
+
+- (void)testPolicyDefaults {
+    AWSRequestCompressionPolicy *policy = [AWSRequestCompressionPolicy new];
+    XCTAssertEqualObjects(policy.compressor, [AWSGZIPRequestCompressor sharedCompressor]);
+    XCTAssertEqual(policy.minimumLength, AWSRequestCompressionDefaultMinimumLength);
+    XCTAssertEqual([policy compressionLevelForLength:64 * 1024], 6);
+    XCTAssertEqual([policy compressionLevelForLength:AWSRequestCompressionDefaultFastCompressionMinimumLength], 1);
+
+    policy.fastCompressionMinimumLength = 0;
+    XCTAssertEqual([policy compressionLevelForLength:AWSRequestCompressionDefaultFastCompressionMinimumLength], 6);
+
+    AWSRequestCompressionPolicy *copiedPolicy = [policy copy];
+    XCTAssertEqual(copiedPolicy.fastCompressionMinimumLength, 0);
+    XCTAssertEqual(copiedPolicy.maximumCompressionRatio, policy.maximumCompressionRatio);
+}
+
+- (void)testPolicyCompressesLargeBodies {
+    NSData *body = [AWSRequestCompressionTests putRecordsBody];
+    NSMutableURLRequest *request = [AWSRequestCompressionTests requestWithBody:body];
+    [request setValue:[NSString stringWithFormat:@"%lu", (unsigned long)body.length] forHTTPHeaderField:@"Content-Length"];
+
+    XCTAssertTrue([[AWSRequestCompressionPolicy new] compressRequest:request]);
+    XCTAssertEqualObjects([request valueForHTTPHeaderField:@"Content-Encoding"], @"gzip");
+    XCTAssertEqualObjects([request valueForHTTPHeaderField:@"Content-Length"],
+                          ([NSString stringWithFormat:@"%lu", (unsigned long)request.HTTPBody.length]));
+    XCTAssertEqualObjects([request.HTTPBody awsgzip_gunzippedData], body);
+}
+
+- (void)testPolicySkipsSmallBodies {
+    NSData *body = [@"{\"StreamName\":\"telemetry\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableURLRequest *request = [AWSRequestCompressionTests requestWithBody:body];
+
+    XCTAssertFalse([[AWSRequestCompressionPolicy new] compressRequest:request]);
+    XCTAssertEqualObjects(request.HTTPBody, body);
+    XCTAssertNil([request valueForHTTPHeaderField:@"Content-Encoding"]);
+
+    AWSRequestCompressionPolicy *policy = [AWSRequestCompressionPolicy new];
+    policy.minimumLength = 0;
+    XCTAssertTrue([policy compressRequest:request]);
+}
+
+- (void)testPolicySkipsEncodedBodies {
+    NSData *body = [AWSRequestCompressionTests putEventsBody];
+    NSMutableURLRequest *request = [AWSRequestCompressionTests requestWithBody:body];
+    [request setValue:@"aws-chunked" forHTTPHeaderField:@"Content-Encoding"];
+
+    XCTAssertFalse([[AWSRequestCompressionPolicy new] compressRequest:request]);
+    XCTAssertEqualObjects(request.HTTPBody, body);
+}
+
+- (void)testPolicySkipsIncompressibleBodies {
+    NSData *body = [AWSRequestCompressionTests randomDataOfLength:64 * 1024];
+    NSMutableURLRequest *request = [AWSRequestCompressionTests requestWithBody:body];
+
+    XCTAssertFalse([[AWSRequestCompressionPolicy new] compressRequest:request]);
+    XCTAssertEqualObjects(request.HTTPBody, body);
+    XCTAssertNil([request valueForHTTPHeaderField:@"Content-Encoding"]);
+}
+
+- (void)testConfigurationCopiesPolicy {
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:nil];
+    configuration.requestCompressionPolicy = [AWSRequestCompressionPolicy new];
+    configuration.requestCompressionPolicy.minimumLength = 1024;
+
+    AWSServiceConfiguration *copiedConfiguration = [configuration copy];
+    XCTAssertEqual(copiedConfiguration.requestCompressionPolicy.minimumLength, 1024);
+
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    [request assignProperties:configuration];
+    XCTAssertEqual(request.requestCompressionPolicy.minimumLength, 1024);
+}
+
+#pragma mark - Benchmarks
+
+// Reports the compressed size and compression time of representative bodies at each level.
+- (void)testCompressionLevelTradeoff {
+    NSDictionary<NSString *, NSData *> *bodies = @{@"PutRecords": [AWSRequestCompressionTests putRecordsBody],
+                                                   @"PutEvents": [AWSRequestCompressionTests putEventsBody],
+                                                   @"PutLogEvents": [AWSRequestCompressionTests putLogEventsBody]};
+    AWSGZIPRequestCompressor *compressor = [AWSGZIPRequestCompressor new];
+    const NSUInteger iterations = 20;
+    for (NSString *name in [[bodies allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+        NSData *body = bodies[name];
+        NSUInteger previousLength = NSUIntegerMax;
+        for (int level = 1; level <= 9; level += 4) {
+            NSUInteger compressedLength = 0;
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            for (NSUInteger i = 0; i < iterations; i++) {
+                compressedLength = [compressor compressData:body level:level].length;
+            }
+            CFAbsoluteTime duration = (CFAbsoluteTimeGetCurrent() - start) / iterations;
+            NSLog(@"%@: %lu bytes, level %d: %lu bytes (%.1f%%) in %.2f ms, %.1f MB/s",
+                  name, (unsigned long)body.length, level, (unsigned long)compressedLength,
+                  100.0 * compressedLength / body.length, duration * 1000, body.length / duration / 1024 / 1024);
+            XCTAssertLessThanOrEqual(compressedLength, previousLength);
+            previousLength = compressedLength;
+        }
+    }
+}
+
+- (void)testPolicyCompressionPerformance {
+    NSData *body = [AWSRequestCompressionTests putRecordsBody];
+    AWSRequestCompressionPolicy *policy = [AWSRequestCompressionPolicy new];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 20; i++) {
+            [policy compressRequest:[AWSRequestCompressionTests requestWithBody:body]];
+        }
+    }];
+}
+
+- (void)testOneShotGZIPPerformance {
+    NSData *body = [AWSRequestCompressionTests putRecordsBody];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 20; i++) {
+            [body awsgzip_gzippedDataWithCompressionLevel:6 / 9.0f];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,157 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+#import "AWSResponseDecompression.h"
+
+@interface AWSResponseDecompressionTests : XCTestCase
+
+@end
+
+@implementation AWSResponseDecompressionTests
+
+// A listing of `count` S3 objects, one JSON line each.
++ (NSData *)listingWithCount:(NSUInteger)count {
+    NSMutableData *listing = [NSMutableData new];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *line = [NSString stringWithFormat:@"{\"Key\":\"exports/2024/01/01/part-%08lu.json\",\"Size\":%lu,\"ETag\":\"%08lx\",\"StorageClass\":\"STANDARD\"}\n",
+                          (unsigned long)i, (unsigned long)(i * 977 % 100000), (unsigned long)(i * 2654435761u)];
+        [listing appendData:[line dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    return listing;
+}
+
++ (NSArray<NSData *> *)chunksOfData:(NSData *)data length:(NSUInteger)chunkLength {
+    NSMutableArray<NSData *> *chunks = [NSMutableArray new];
+    for (NSUInteger offset = 0; offset < data.length; offset += chunkLength) {
+        [chunks addObject:[data subdataWithRange:NSMakeRange(offset, MIN(chunkLength, data.length - offset))]];
+    }
+    return chunks;
+}
+
+- (void)testIsGZIPData {
+    NSData *listing = [AWSResponseDecompressionTests listingWithCount:10];
+    XCTAssertTrue([AWSGZIPResponseInflater isGZIPData:[listing awsgzip_gzippedData]]);
+    XCTAssertFalse([AWSGZIPResponseInflater isGZIPData:listing]);
+    XCTAssertFalse([AWSGZIPResponseInflater isGZIPData:[NSData dataWithBytes:"\x1f" length:1]]);
+}
+
+- (void)testInflatesChunksWithBoundedOutput {
+    NSData *listing = [AWSResponseDecompressionTests listingWithCount:5000];
+    NSData *compressedListing = [listing awsgzip_gzippedData];
+    AWSGZIPResponseInflater *inflater = [[AWSGZIPResponseInflater alloc] initWithOutputBufferLength:4096];
+
+    NSMutableData *inflatedData = [NSMutableData new];
+    __block NSUInteger largestOutputLength = 0;
+    for (NSData *chunk in [AWSResponseDecompressionTests chunksOfData:compressedListing length:1000]) {
+        NSError *error = nil;
+        XCTAssertTrue([inflater inflateData:chunk usingBlock:^(const void *bytes, NSUInteger length) {
+            largestOutputLength = MAX(largestOutputLength, length);
+            [inflatedData appendBytes:bytes length:length];
+        } error:&error]);
+        XCTAssertNil(error);
+    }
+
+    XCTAssertTrue([inflater finishWithError:nil]);
+    XCTAssertEqualObjects(inflatedData, listing);
+    XCTAssertEqual(inflater.totalBytesIn, (int64_t)compressedListing.length);
+    XCTAssertEqual(inflater.totalBytesOut, (int64_t)listing.length);
+    XCTAssertLessThanOrEqual(largestOutputLength, 4096);
+}
+
+- (void)testInflatesConcatenatedMembers {
+    NSData *firstPart = [AWSResponseDecompressionTests listingWithCount:100];
+    NSData *secondPart = [@"trailer\n" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableData *compressedData = [[firstPart awsgzip_gzippedData] mutableCopy];
+    [compressedData appendData:[secondPart awsgzip_gzippedData]];
+
+    NSMutableData *expectedData = [firstPart mutableCopy];
+    [expectedData appendData:secondPart];
+    XCTAssertEqualObjects([compressedData aws_inflatedGZIPData], expectedData);
+}
+
+- (void)testReportsTruncatedBody {
+    NSData *compressedListing = [[AWSResponseDecompressionTests listingWithCount:100] awsgzip_gzippedData];
+    AWSGZIPResponseInflater *inflater = [AWSGZIPResponseInflater new];
+    XCTAssertTrue([inflater inflateData:[compressedListing subdataWithRange:NSMakeRange(0, compressedListing.length - 10)]
+                             usingBlock:^(const void *bytes, NSUInteger length) {}
+                                  error:nil]);
+
+    NSError *error = nil;
+    XCTAssertFalse([inflater finishWithError:&error]);
+    XCTAssertEqualObjects(error.domain, AWSGZIPResponseInflaterErrorDomain);
+    XCTAssertEqual(error.code, AWSGZIPResponseInflaterErrorTruncatedData);
+}
+
+- (void)testReportsInvalidBodyAndRecoversAfterReset {
+    AWSGZIPResponseInflater *inflater = [AWSGZIPResponseInflater new];
+    NSError *error = nil;
+    const uint8_t corruptBody[] = {0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xff};
+    XCTAssertFalse([inflater inflateData:[NSData dataWithBytes:corruptBody length:sizeof(corruptBody)]
+                              usingBlock:^(const void *bytes, NSUInteger length) {}
+                                   error:&error]);
+    XCTAssertEqual(error.code, AWSGZIPResponseInflaterErrorInvalidData);
+
+    // The inflater is reused for the next body.
+    [inflater reset];
+    NSData *listing = [AWSResponseDecompressionTests listingWithCount:10];
+    NSMutableData *inflatedData = [NSMutableData new];
+    XCTAssertTrue([inflater inflateData:[listing awsgzip_gzippedData] usingBlock:^(const void *bytes, NSUInteger length) {
+        [inflatedData appendBytes:bytes length:length];
+    } error:nil]);
+    XCTAssertTrue([inflater finishWithError:nil]);
+    XCTAssertEqualObjects(inflatedData, listing);
+}
+
+/**
+ Benchmarks decompressing a 50 MB listing received in 64 KB chunks, buffered whole versus inflated as it arrives.
+ */
+- (void)testPerformanceInflating50MBListing {
+    NSData *listing = [AWSResponseDecompressionTests listingWithCount:400000];
+    NSArray<NSData *> *chunks = [AWSResponseDecompressionTests chunksOfData:[listing awsgzip_gzippedData] length:64 * 1024];
+    AWSGZIPResponseInflater *inflater = [AWSGZIPResponseInflater new];
+    listing = nil;
+
+    if (@available(iOS 13.0, macOS 10.15, *)) {
+        NSArray<id<XCTMetric>> *metrics = @[[XCTClockMetric new], [XCTMemoryMetric new]];
+        [self measureWithMetrics:metrics block:^{
+            @autoreleasepool {
+                NSMutableData *compressedBody = [NSMutableData new];
+                for (NSData *chunk in chunks) {
+                    [compressedBody appendData:chunk];
+                }
+                XCTAssertNotNil([compressedBody awsgzip_gunzippedData]);
+            }
+        }];
+        [self measureWithMetrics:metrics block:^{
+            __block NSUInteger newlineCount = 0;
+            for (NSData *chunk in chunks) {
+                [inflater inflateData:chunk usingBlock:^(const void *bytes, NSUInteger length) {
+                    // Stands in for a streaming parser.
+                    const uint8_t *characters = bytes;
+                    for (NSUInteger i = 0; i < length; i++) {
+                        newlineCount += characters[i] == '\n';
+                    }
+                } error:nil];
+            }
+            XCTAssertTrue([inflater finishWithError:nil]);
+            XCTAssertEqual(newlineCount, 400000);
+            [inflater reset];
+        }];
+    }
+}
+
+@end
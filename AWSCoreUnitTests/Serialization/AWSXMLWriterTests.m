@@ -0,0 +1,180 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+#import "AWSXMLWriter.h"
+
+@interface AWSXMLWriterTests : XCTestCase
+
+@end
+
+@implementation AWSXMLWriterTests
+
+// The parts of the S3 definition that CompleteMultipartUpload serializes.
++ (NSDictionary *)completeMultipartUploadDefinition {
+    return @{@"operations": @{@"CompleteMultipartUpload": @{@"input": @{@"shape": @"CompleteMultipartUploadRequest"}}},
+             @"shapes": @{@"CompleteMultipartUploadRequest": @{@"type": @"structure",
+                                                                @"members": @{@"MultipartUpload": @{@"shape": @"CompletedMultipartUpload",
+                                                                                                    @"locationName": @"CompleteMultipartUpload",
+                                                                                                    @"xmlNamespace": @{@"uri": @"http://s3.amazonaws.com/doc/2006-03-01/"}}},
+                                                                @"payload": @"MultipartUpload"},
+                          @"CompletedMultipartUpload": @{@"type": @"structure",
+                                                         @"members": @{@"Parts": @{@"shape": @"CompletedPartList",
+                                                                                   @"locationName": @"Part"}}},
+                          @"CompletedPartList": @{@"type": @"list",
+                                                  @"member": @{@"shape": @"CompletedPart"},
+                                                  @"flattened": @YES},
+                          @"CompletedPart": @{@"type": @"structure",
+                                              @"members": @{@"ETag": @{@"shape": @"ETag"},
+                                                            @"PartNumber": @{@"shape": @"PartNumber"}}},
+                          @"ETag": @{@"type": @"string"},
+                          @"PartNumber": @{@"type": @"integer"}}};
+}
+
++ (NSDictionary *)completeMultipartUploadParametersWithPartCount:(NSUInteger)partCount {
+    NSMutableArray *parts = [NSMutableArray arrayWithCapacity:partCount];
+    for (NSUInteger i = 1; i <= partCount; i++) {
+        [parts addObject:@{@"ETag": [NSString stringWithFormat:@"\"%032lx\"", (unsigned long)(i * 2654435761u)],
+                           @"PartNumber": @(i)}];
+    }
+    return @{@"MultipartUpload": @{@"Parts": parts}};
+}
+
+- (void)testWritesIndentedElements {
+    AWSXMLWriter *writer = [AWSXMLWriter new];
+    [writer writeStartElement:@"Root"];
+    [writer writeAttribute:@"xmlns" value:@"https://foo/"];
+    [writer writeStartElement:@"Name"];
+    [writer writeCharacters:@"a & b"];
+    [writer writeEndElement:@"Name"];
+    [writer writeStartElement:@"Empty"];
+    [writer writeEndElement];
+    [writer writeEndElement:@"Root"];
+
+    NSString *expectedXML = @"\n<Root xmlns=\"https://foo/\">\n\t<Name>a &amp; b</Name>\n\t<Empty />\n</Root>";
+    XCTAssertEqualObjects([writer toString], expectedXML);
+    XCTAssertEqualObjects([writer toData], [expectedXML dataUsingEncoding:NSUTF8StringEncoding]);
+}
+
+- (void)testWritesNamespacePrefixes {
+    AWSXMLWriter *writer = [AWSXMLWriter new];
+    writer.lineBreak = nil;
+    writer.indentation = nil;
+    [writer writeStartElement:@"Root"];
+    [writer writeNamespace:@"s" namespaceURI:@"urn:s"];
+    [writer writeStartElementWithNamespace:@"urn:s" localName:@"Item"];
+    [writer writeAttributeWithNamespace:@"urn:s" localName:@"id" value:@"1"];
+    [writer writeCharacters:@"x"];
+    [writer writeEndElement];
+    [writer writeEndElement];
+
+    XCTAssertEqualObjects([writer toString], @"<Root xmlns:s=\"urn:s\"><s:Item s:id=\"1\">x</s:Item></Root>");
+    XCTAssertNil([writer getPrefix:@"urn:s"]);
+}
+
+- (void)testEscapesText {
+    NSString *controlCharacter = [NSString stringWithFormat:@"%C", (unichar)0x01];
+    NSArray<NSArray<NSString *> *> *cases = @[
+        @[@"plain text without markup", @"plain text without markup"],
+        @[@"\"quoted\" & <tagged> 'text'", @"&quot;quoted&quot; &amp; &lt;tagged&gt; 'text'"],
+        @[@"tab\tnew line\ncarriage return\r", @"tab\tnew line\ncarriage return\r"],
+        @[[NSString stringWithFormat:@"before%@after", controlCharacter], @"beforeafter"],
+        @[@"café €<5", @"café €&lt;5"],
+        // Characters outside the basic multilingual plane are dropped, as they always have been.
+        @[@"smile \U0001F600!", @"smile !"],
+    ];
+
+    for (NSArray<NSString *> *testCase in cases) {
+        AWSXMLWriter *writer = [AWSXMLWriter new];
+        [writer writeCharacters:testCase[0]];
+        XCTAssertEqualObjects([writer toString], testCase[1]);
+
+        // The same text in a mutable string takes the copying path.
+        writer = [AWSXMLWriter new];
+        [writer writeCharacters:[NSMutableString stringWithString:testCase[0]]];
+        XCTAssertEqualObjects([writer toString], testCase[1]);
+    }
+}
+
+- (void)testEscapesLongText {
+    NSMutableString *text = [NSMutableString new];
+    NSMutableString *expectedText = [NSMutableString new];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [text appendFormat:@"key-%lu/%@", (unsigned long)i, i % 7 == 0 ? @"a&b" : @"ab"];
+        [expectedText appendFormat:@"key-%lu/%@", (unsigned long)i, i % 7 == 0 ? @"a&amp;b" : @"ab"];
+        if (i % 100 == 0) {
+            [text appendString:@"ü"];
+            [expectedText appendString:@"ü"];
+        }
+    }
+
+    AWSXMLWriter *writer = [AWSXMLWriter new];
+    [writer writeCharacters:text];
+    XCTAssertEqualObjects([writer toString], expectedText);
+}
+
+- (void)testDetachDataHandsOverBuffer {
+    AWSXMLWriter *writer = [AWSXMLWriter new];
+    [writer writeStartElement:@"Delete"];
+    [writer writeCharacters:@"kéy"];
+    [writer writeEndElement];
+
+    NSData *expectedData = [writer toData];
+    XCTAssertEqualObjects([writer detachData], expectedData);
+    XCTAssertEqual([[writer toData] length], 0);
+}
+
+- (void)testBuildsCompleteMultipartUpload {
+    NSDictionary *definition = [AWSXMLWriterTests completeMultipartUploadDefinition];
+    NSDictionary *parameters = [AWSXMLWriterTests completeMultipartUploadParametersWithPartCount:3];
+
+    NSError *error = nil;
+    NSData *body = [AWSXMLBuilder xmlDataForDictionary:parameters
+                                            actionName:@"CompleteMultipartUpload"
+                                 serviceDefinitionRule:definition
+                                                 error:&error];
+    XCTAssertNil(error);
+    NSString *xml = [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding];
+    XCTAssertEqualObjects(xml, [AWSXMLBuilder xmlStringForDictionary:parameters
+                                                          actionName:@"CompleteMultipartUpload"
+                                               serviceDefinitionRule:definition
+                                                               error:nil]);
+    XCTAssertTrue([xml hasPrefix:@"\n<CompleteMultipartUpload xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">\n\t<Part>"]);
+    XCTAssertTrue([xml hasSuffix:@"\n\t</Part>\n</CompleteMultipartUpload>"]);
+    XCTAssertEqual([[xml componentsSeparatedByString:@"<Part>"] count], 4);
+    XCTAssertTrue([xml containsString:@"<PartNumber>2</PartNumber>"]);
+    XCTAssertTrue([xml containsString:[NSString stringWithFormat:@"<ETag>&quot;%032lx&quot;</ETag>", (unsigned long)(2 * 2654435761u)]]);
+}
+
+/**
+ Benchmarks serializing a CompleteMultipartUpload body with 10,000 parts, the most S3 allows.
+ */
+- (void)testPerformanceCompleteMultipartUploadWith10000Parts {
+    NSDictionary *definition = [AWSXMLWriterTests completeMultipartUploadDefinition];
+    NSDictionary *parameters = [AWSXMLWriterTests completeMultipartUploadParametersWithPartCount:10000];
+
+    if (@available(iOS 13.0, macOS 10.15, *)) {
+        [self measureWithMetrics:@[[XCTClockMetric new], [XCTMemoryMetric new]] block:^{
+            NSData *body = [AWSXMLBuilder xmlDataForDictionary:parameters
+                                                    actionName:@"CompleteMultipartUpload"
+                                         serviceDefinitionRule:definition
+                                                         error:nil];
+            XCTAssertGreaterThan([body length], 10000 * 80);
+        }];
+    }
+}
+
+@end
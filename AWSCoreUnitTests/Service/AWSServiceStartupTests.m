@@ -0,0 +1,200 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+#import "AWSSTSResources.h"
+#import "AWSCognitoIdentityResources.h"
+
+@interface AWSInfo()
+
+- (instancetype)initWithConfiguration:(NSDictionary<NSString *, id> *)config;
+
+@end
+
+@interface AWSServiceStartupTests : XCTestCase
+
+@end
+
+@implementation AWSServiceStartupTests
+
++ (NSDictionary<NSString *, id> *)configuration {
+    return @{
+             @"CredentialsProvider": @{
+                     @"CognitoIdentity": @{
+                             @"Default": @{
+                                     @"PoolId": @"us-east-1:01234567-89ab-cdef-0123-456789abcdef",
+                                     @"Region": @"us-east-1"
+                                     }
+                             }
+                     },
+             @"STS": @{
+                     @"Default": @{
+                             @"Region": @"us-west-2"
+                             }
+                     },
+             @"CognitoIdentity": @{
+                     @"Default": @{
+                             @"Region": @"us-east-1"
+                             }
+                     }
+             };
+}
+
+- (void)testInfoIsAnImmutableSnapshot {
+    NSMutableDictionary *stsDictionary = [NSMutableDictionary dictionaryWithDictionary:@{@"Region": @"us-west-2"}];
+    NSMutableDictionary *configuration = [[[self class] configuration] mutableCopy];
+    configuration[@"STS"] = [NSMutableDictionary dictionaryWithDictionary:@{@"Default": stsDictionary}];
+    AWSInfo *info = [[AWSInfo alloc] initWithConfiguration:configuration];
+
+    stsDictionary[@"Region"] = @"eu-west-1";
+    [configuration removeObjectForKey:@"CognitoIdentity"];
+
+    XCTAssertEqualObjects(info.rootInfoDictionary[@"STS"][@"Default"][@"Region"], @"us-west-2");
+    XCTAssertEqual([info defaultServiceInfo:@"STS"].region, AWSRegionUSWest2);
+    XCTAssertNotNil(info.rootInfoDictionary[@"CognitoIdentity"]);
+}
+
+- (void)testServiceInfoIsCreatedOnce {
+    AWSInfo *info = [[AWSInfo alloc] initWithConfiguration:[[self class] configuration]];
+
+    AWSServiceInfo *serviceInfo = [info defaultServiceInfo:@"STS"];
+    XCTAssertNotNil(serviceInfo);
+    XCTAssertEqual([info defaultServiceInfo:@"STS"], serviceInfo);
+    XCTAssertEqual([info serviceInfo:@"STS" forKey:AWSInfoDefault], serviceInfo);
+    XCTAssertNotNil(serviceInfo.cognitoCredentialsProvider);
+
+    // There is no default region for services without an entry.
+    XCTAssertNil([info defaultServiceInfo:@"DynamoDB"]);
+    XCTAssertNil([info serviceInfo:@"STS" forKey:@"Other"]);
+}
+
+- (void)testServiceClientsAreCreatedWhenFirstRequested {
+    AWSServiceManager *serviceManager = [AWSServiceManager defaultServiceManager];
+    NSString *key = [[NSUUID UUID] UUIDString];
+    __block NSInteger creationCount = 0;
+    [serviceManager registerServiceClientWithBlock:^id{
+        @synchronized(self) {
+            creationCount++;
+        }
+        return [NSObject new];
+    } forKey:key];
+    XCTAssertEqual(creationCount, 0);
+
+    NSMutableArray *clients = [NSMutableArray new];
+    dispatch_apply(16, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^(size_t iteration) {
+        id client = [serviceManager serviceClientForKey:key];
+        @synchronized(clients) {
+            [clients addObject:client];
+        }
+    });
+    XCTAssertEqual(creationCount, 1);
+    XCTAssertEqual(clients.count, 16);
+    XCTAssertEqual([NSSet setWithArray:clients].count, 1);
+
+    [serviceManager removeServiceClientForKey:key];
+    XCTAssertNil([serviceManager serviceClientForKey:key]);
+    XCTAssertNil([serviceManager serviceClientForKey:[[NSUUID UUID] UUIDString]]);
+}
+
+- (void)testPreloadServiceDefinitions {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"preload"];
+    [[[AWSServiceManager defaultServiceManager] preloadServiceDefinitions:@[@"STS", @"NotAService", @"CognitoIdentity"]] continueWithBlock:^id _Nullable(AWSTask<NSArray<NSString *> *> *task) {
+        XCTAssertNil(task.error);
+        XCTAssertEqualObjects(task.result, (@[@"STS", @"CognitoIdentity"]));
+        [expectation fulfill];
+        return nil;
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertNotNil([[AWSSTSResources sharedInstance] JSONObject]);
+    XCTAssertNotNil([[AWSCognitoIdentityResources sharedInstance] JSONObject]);
+}
+
+#pragma mark - Performance
+
+/*
+ * Measures the time from reading the configuration to the first usable client of each service, that is a client
+ * whose service definition is loaded. The definitions are parsed again in every iteration, as on a cold launch.
+ */
+- (void)measureTimeToFirstUsableClientsWithPreloading:(BOOL)preloading {
+    NSDictionary<NSString *, id> *configuration = [[self class] configuration];
+    NSArray<Class> *resourcesClasses = @[[AWSSTSResources class], [AWSCognitoIdentityResources class]];
+
+    [self measureBlock:^{
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        NSMutableDictionary<NSString *, id> *definitions = [NSMutableDictionary new];
+        void (^loadDefinition)(Class) = ^(Class resourcesClass) {
+            id definition = [[resourcesClass new] JSONObject];
+            @synchronized(definitions) {
+                definitions[NSStringFromClass(resourcesClass)] = definition;
+            }
+        };
+        NSMutableDictionary<NSString *, dispatch_group_t> *groups = [NSMutableDictionary new];
+        if (preloading) {
+            for (Class resourcesClass in resourcesClasses) {
+                dispatch_group_t group = dispatch_group_create();
+                dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+                    loadDefinition(resourcesClass);
+                });
+                groups[NSStringFromClass(resourcesClass)] = group;
+            }
+        }
+        // A client is usable once its definition is loaded, by the preloading or on first use.
+        void (^waitForDefinition)(Class) = ^(Class resourcesClass) {
+            if (preloading) {
+                dispatch_group_wait(groups[NSStringFromClass(resourcesClass)], DISPATCH_TIME_FOREVER);
+            } else {
+                loadDefinition(resourcesClass);
+            }
+        };
+
+        AWSInfo *info = [[AWSInfo alloc] initWithConfiguration:configuration];
+        NSString *key = [[NSUUID UUID] UUIDString];
+
+        AWSServiceInfo *stsInfo = [info defaultServiceInfo:@"STS"];
+        [AWSSTS registerSTSWithConfiguration:[[AWSServiceConfiguration alloc] initWithRegion:stsInfo.region
+                                                                         credentialsProvider:stsInfo.cognitoCredentialsProvider]
+                                      forKey:key];
+        XCTAssertNotNil([AWSSTS STSForKey:key]);
+        waitForDefinition([AWSSTSResources class]);
+        CFAbsoluteTime sts = CFAbsoluteTimeGetCurrent();
+
+        AWSServiceInfo *cognitoIdentityInfo = [info defaultServiceInfo:@"CognitoIdentity"];
+        [AWSCognitoIdentity registerCognitoIdentityWithConfiguration:[[AWSServiceConfiguration alloc] initWithRegion:cognitoIdentityInfo.region
+                                                                                                 credentialsProvider:cognitoIdentityInfo.cognitoCredentialsProvider]
+                                                              forKey:key];
+        XCTAssertNotNil([AWSCognitoIdentity CognitoIdentityForKey:key]);
+        waitForDefinition([AWSCognitoIdentityResources class]);
+        CFAbsoluteTime end = CFAbsoluteTimeGetCurrent();
+
+        XCTAssertEqual(definitions.count, resourcesClasses.count);
+        NSLog(@"Time to first usable client (%@): STS %.2f ms, CognitoIdentity %.2f ms",
+              preloading ? @"preloaded" : @"serial", (sts - start) * 1000, (end - start) * 1000);
+
+        [AWSSTS removeSTSForKey:key];
+        [AWSCognitoIdentity removeCognitoIdentityForKey:key];
+    }];
+}
+
+- (void)testTimeToFirstUsableClientsPerformance {
+    [self measureTimeToFirstUsableClientsWithPreloading:NO];
+}
+
+- (void)testTimeToFirstUsableClientsWithPreloadingPerformance {
+    [self measureTimeToFirstUsableClientsWithPreloading:YES];
+}
+
+@end
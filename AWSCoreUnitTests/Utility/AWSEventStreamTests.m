@@ -0,0 +1,196 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "AWSEventStream.h"
+
+@interface AWSEventStreamTests : XCTestCase
+
+@end
+
+@implementation AWSEventStreamTests
+
+- (AWSEventStreamMessage *)messageWithAllHeaderTypes {
+    NSDictionary<NSString *, AWSEventStreamHeaderValue *> *headers = @{
+        @"true": [AWSEventStreamHeaderValue boolValue:YES],
+        @"false": [AWSEventStreamHeaderValue boolValue:NO],
+        @"byte": [AWSEventStreamHeaderValue byteValue:-7],
+        @"int16": [AWSEventStreamHeaderValue int16Value:-1234],
+        @"int32": [AWSEventStreamHeaderValue int32Value:123456789],
+        @"int64": [AWSEventStreamHeaderValue int64Value:-1234567890123],
+        @"bytes": [AWSEventStreamHeaderValue byteArrayValue:[NSData dataWithBytes:"\x00\x01\x02" length:3]],
+        @":message-type": [AWSEventStreamHeaderValue stringValue:@"event"],
+        @"timestamp": [AWSEventStreamHeaderValue timestampValue:[NSDate dateWithTimeIntervalSince1970:1700000000.123]],
+        @"uuid": [AWSEventStreamHeaderValue UUIDValue:[[NSUUID alloc] initWithUUIDString:@"E621E1F8-C36C-495A-93FC-0C247A3E6E5F"]],
+    };
+    return [[AWSEventStreamMessage alloc] initWithHeaders:headers
+                                                  payload:[@"{\"hello\":\"world\"}" dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+- (NSData *)encode:(AWSEventStreamMessage *)message {
+    NSError *error = nil;
+    NSData *encoded = [AWSEventStreamEncoder encodeMessage:message error:&error];
+    XCTAssertNil(error);
+    XCTAssertNotNil(encoded);
+    return encoded;
+}
+
+- (void)testCRC32MatchesReferenceValue {
+    const char *check = "123456789";
+    XCTAssertEqual(AWSEventStreamCRC32(0, check, strlen(check)), 0xCBF43926);
+    uint32_t crc = AWSEventStreamCRC32(0, check, 4);
+    XCTAssertEqual(AWSEventStreamCRC32(crc, check + 4, strlen(check) - 4), 0xCBF43926);
+}
+
+- (void)testEncodeMatchesReferenceFrame {
+    AWSEventStreamMessage *message = [[AWSEventStreamMessage alloc] initWithHeaders:@{@":event-type": [AWSEventStreamHeaderValue stringValue:@"AudioEvent"]}
+                                                                            payload:[NSData dataWithBytes:"\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f" length:16]];
+    NSData *expected = [[NSData alloc] initWithBase64EncodedString:@"AAAAOQAAABmteK1eCzpldmVudC10eXBlBwAKQXVkaW9FdmVudAABAgMEBQYHCAkKCwwNDg9arS9y"
+                                                           options:0];
+    XCTAssertEqualObjects([self encode:message], expected);
+}
+
+- (void)testRoundTripAllHeaderTypes {
+    AWSEventStreamMessage *message = [self messageWithAllHeaderTypes];
+    NSError *error = nil;
+    AWSEventStreamMessage *decoded = [AWSEventStreamDecoder decodeMessage:[self encode:message] error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(decoded.headers, message.headers);
+    XCTAssertEqualObjects(decoded.payload, message.payload);
+    XCTAssertEqualObjects([decoded stringValueForHeader:@":message-type"], @"event");
+    XCTAssertNil([decoded stringValueForHeader:@"int32"]);
+}
+
+- (void)testIncrementalDecodingAtEverySplitPoint {
+    AWSEventStreamMessage *message = [self messageWithAllHeaderTypes];
+    NSMutableData *stream = [NSMutableData dataWithData:[self encode:message]];
+    [stream appendData:[self encode:message]];
+
+    for (NSUInteger split = 0; split <= stream.length; split++) {
+        NSMutableArray<AWSEventStreamMessage *> *messages = [NSMutableArray new];
+        AWSEventStreamDecoder *decoder = [[AWSEventStreamDecoder alloc] initWithMessageHandler:^(AWSEventStreamMessage *decoded) {
+            [messages addObject:decoded];
+        }];
+        XCTAssertTrue([decoder appendData:[stream subdataWithRange:NSMakeRange(0, split)] error:nil]);
+        XCTAssertTrue([decoder appendData:[stream subdataWithRange:NSMakeRange(split, stream.length - split)] error:nil]);
+        XCTAssertEqual(messages.count, 2);
+        XCTAssertEqual(decoder.pendingLength, 0);
+        XCTAssertEqualObjects(messages.lastObject.headers, message.headers);
+    }
+}
+
+- (void)testByteByByteDecoding {
+    NSData *encoded = [self encode:[self messageWithAllHeaderTypes]];
+    __block NSUInteger messageCount = 0;
+    AWSEventStreamDecoder *decoder = [[AWSEventStreamDecoder alloc] initWithMessageHandler:^(AWSEventStreamMessage *decoded) {
+        messageCount++;
+    }];
+    for (NSUInteger i = 0; i < encoded.length; i++) {
+        XCTAssertTrue([decoder appendData:[encoded subdataWithRange:NSMakeRange(i, 1)] error:nil]);
+    }
+    XCTAssertEqual(messageCount, 1);
+}
+
+- (void)testChecksumMismatchFailsDecoder {
+    NSMutableData *encoded = [[self encode:[self messageWithAllHeaderTypes]] mutableCopy];
+    ((uint8_t *)encoded.mutableBytes)[encoded.length - 5] ^= 0xFF;
+
+    AWSEventStreamDecoder *decoder = [[AWSEventStreamDecoder alloc] initWithMessageHandler:^(AWSEventStreamMessage *decoded) {
+        XCTFail(@"Corrupted message should not be delivered");
+    }];
+    NSError *error = nil;
+    XCTAssertFalse([decoder appendData:encoded error:&error]);
+    XCTAssertEqualObjects(error.domain, AWSEventStreamErrorDomain);
+    XCTAssertEqual(error.code, AWSEventStreamErrorMessageChecksumMismatch);
+
+    error = nil;
+    XCTAssertFalse([decoder appendData:[self encode:[self messageWithAllHeaderTypes]] error:&error]);
+    XCTAssertNotNil(error);
+}
+
+- (void)testEncodeRejectsOversizedPayloads {
+    NSData *payload = [NSMutableData dataWithLength:AWSEventStreamMaximumPayloadLength + 1];
+    AWSEventStreamMessage *message = [[AWSEventStreamMessage alloc] initWithHeaders:@{} payload:payload];
+    NSError *error = nil;
+    XCTAssertNil([AWSEventStreamEncoder encodeMessage:message error:&error]);
+    XCTAssertEqual(error.code, AWSEventStreamErrorPayloadTooLong);
+    XCTAssertNil([AWSEventStreamEncoder encodeMessageWithEncodedHeaders:[NSData data] payload:payload]);
+
+    NSData *headers = [NSMutableData dataWithLength:AWSEventStreamMaximumHeadersLength + 1];
+    XCTAssertNil([AWSEventStreamEncoder encodeMessageWithEncodedHeaders:headers payload:[NSData data]]);
+}
+
+- (void)testPreludeChecksumMismatch {
+    NSMutableData *encoded = [[self encode:[self messageWithAllHeaderTypes]] mutableCopy];
+    ((uint8_t *)encoded.mutableBytes)[9] ^= 0x01;
+    NSError *error = nil;
+    XCTAssertNil([AWSEventStreamDecoder decodeMessage:encoded error:&error]);
+    XCTAssertEqual(error.code, AWSEventStreamErrorPreludeChecksumMismatch);
+}
+
+- (void)testTruncatedMessage {
+    NSData *encoded = [self encode:[self messageWithAllHeaderTypes]];
+    NSError *error = nil;
+    XCTAssertNil([AWSEventStreamDecoder decodeMessage:[encoded subdataWithRange:NSMakeRange(0, encoded.length - 1)] error:&error]);
+    XCTAssertEqual(error.code, AWSEventStreamErrorIncompleteMessage);
+}
+
+/// Mutates and re-splits valid streams at random. The decoder must never crash or over-read, and it must either
+/// report an error or deliver only messages whose checksums verified.
+- (void)testFuzzedInput {
+    NSData *encoded = [self encode:[self messageWithAllHeaderTypes]];
+    srand48(42);
+
+    for (NSUInteger iteration = 0; iteration < 5000; iteration++) {
+        NSMutableData *fuzzed = [encoded mutableCopy];
+        NSUInteger mutationCount = 1 + (NSUInteger)(drand48() * 4);
+        for (NSUInteger i = 0; i < mutationCount; i++) {
+            NSUInteger position = (NSUInteger)(drand48() * fuzzed.length);
+            ((uint8_t *)fuzzed.mutableBytes)[position] = (uint8_t)(drand48() * 256);
+        }
+        if (drand48() < 0.2) {
+            [fuzzed setLength:(NSUInteger)(drand48() * fuzzed.length)];
+        }
+
+        AWSEventStreamDecoder *decoder = [[AWSEventStreamDecoder alloc] initWithMessageHandler:^(AWSEventStreamMessage *decoded) {
+            XCTAssertNotNil(decoded.headers);
+            XCTAssertNotNil(decoded.payload);
+        }];
+        NSUInteger offset = 0;
+        while (offset < fuzzed.length) {
+            NSUInteger chunkLength = MIN(fuzzed.length - offset, 1 + (NSUInteger)(drand48() * 64));
+            if (![decoder appendData:[fuzzed subdataWithRange:NSMakeRange(offset, chunkLength)] error:nil]) {
+                break;
+            }
+            offset += chunkLength;
+        }
+    }
+}
+
+- (void)testDecodePerformance {
+    NSData *encoded = [self encode:[self messageWithAllHeaderTypes]];
+    NSMutableData *stream = [NSMutableData new];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [stream appendData:encoded];
+    }
+
+    [self measureBlock:^{
+        AWSEventStreamDecoder *decoder = [[AWSEventStreamDecoder alloc] initWithMessageHandler:^(AWSEventStreamMessage *decoded) {}];
+        [decoder appendData:stream error:nil];
+    }];
+}
+
+@end
@@ -0,0 +1,207 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSUICKeyChainStore.h"
+
+// Counts the calls that reach the backend, which would each be a keychain query.
+@interface AWSUICKeyChainStoreCountingBackend : AWSUICKeyChainStoreFileBackend
+
+@property (atomic, assign) NSUInteger readCount;
+@property (atomic, assign) NSUInteger writeCount;
+
+@end
+
+@implementation AWSUICKeyChainStoreCountingBackend
+
+- (NSData *)dataForKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError *__autoreleasing *)error {
+    self.readCount++;
+    return [super dataForKey:key store:store error:error];
+}
+
+- (BOOL)setData:(NSData *)data forKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError *__autoreleasing *)error {
+    self.writeCount++;
+    return [super setData:data forKey:key store:store error:error];
+}
+
+- (BOOL)removeItemForKey:(NSString *)key store:(AWSUICKeyChainStore *)store error:(NSError *__autoreleasing *)error {
+    self.writeCount++;
+    return [super removeItemForKey:key store:store error:error];
+}
+
+@end
+
+@interface AWSUICKeyChainStoreCacheTests : XCTestCase
+
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSString *service;
+
+@end
+
+@implementation AWSUICKeyChainStoreCacheTests
+
+- (void)setUp {
+    [super setUp];
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    // A new service gives each test its own items and cache.
+    self.service = [NSString stringWithFormat:@"AWSUICKeyChainStoreCacheTests.%@", [[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    [[AWSUICKeyChainStore keyChainStoreWithService:self.service] removeAllItems];
+    [super tearDown];
+}
+
+- (AWSUICKeyChainStore *)storeWithBackend:(id<AWSUICKeyChainStoreBackend>)backend cachingEnabled:(BOOL)cachingEnabled {
+    AWSUICKeyChainStore *store = [AWSUICKeyChainStore keyChainStoreWithService:self.service];
+    store.backend = backend;
+    store.cachingEnabled = cachingEnabled;
+    return store;
+}
+
+- (void)testFileBackend {
+    AWSUICKeyChainStoreFileBackend *backend = [[AWSUICKeyChainStoreFileBackend alloc] initWithDirectoryURL:self.directoryURL];
+    AWSUICKeyChainStore *store = [self storeWithBackend:backend cachingEnabled:NO];
+
+    XCTAssertNil(store[@"identityId"]);
+    XCTAssertFalse([store contains:@"identityId"]);
+    store[@"identityId"] = @"us-east-1:1234";
+    XCTAssertTrue([store setData:[NSData dataWithBytes:"\x00\xff" length:2] forKey:@"data"]);
+    XCTAssertEqualObjects(store[@"identityId"], @"us-east-1:1234");
+    XCTAssertTrue([store contains:@"identityId"]);
+    XCTAssertEqualObjects([NSSet setWithArray:store.allKeys], ([NSSet setWithArray:@[@"identityId", @"data"]]));
+    XCTAssertEqual(store.allItems.count, 2);
+
+    // The items outlive the store and the backend.
+    AWSUICKeyChainStore *reopened = [self storeWithBackend:[[AWSUICKeyChainStoreFileBackend alloc] initWithDirectoryURL:self.directoryURL]
+                                            cachingEnabled:NO];
+    XCTAssertEqualObjects(reopened[@"identityId"], @"us-east-1:1234");
+    XCTAssertEqualObjects([reopened dataForKey:@"data"], [NSData dataWithBytes:"\x00\xff" length:2]);
+
+    // Other services do not see them.
+    AWSUICKeyChainStore *other = [AWSUICKeyChainStore keyChainStoreWithService:[self.service stringByAppendingString:@".other"]];
+    other.backend = backend;
+    XCTAssertNil(other[@"identityId"]);
+
+    // Migrating is a no-op rather than a crash.
+    [store migrateToCurrentAccessibility];
+    XCTAssertEqualObjects(store[@"identityId"], @"us-east-1:1234");
+
+    store[@"identityId"] = nil;
+    XCTAssertNil(reopened[@"identityId"]);
+    XCTAssertTrue([store removeAllItems]);
+    XCTAssertEqual(reopened.allKeys.count, 0);
+}
+
+- (void)testCachedReadsAndCoalescedWrites {
+    AWSUICKeyChainStoreCountingBackend *backend = [[AWSUICKeyChainStoreCountingBackend alloc] initWithDirectoryURL:self.directoryURL];
+    AWSUICKeyChainStore *store = [self storeWithBackend:backend cachingEnabled:YES];
+
+    for (NSUInteger i = 0; i < 10; i++) {
+        XCTAssertNil(store[@"identityId"]);
+    }
+    XCTAssertEqual(backend.readCount, 1);
+
+    store[@"identityId"] = @"us-east-1:1234";
+    XCTAssertEqual(backend.writeCount, 1);
+    for (NSUInteger i = 0; i < 10; i++) {
+        XCTAssertEqualObjects(store[@"identityId"], @"us-east-1:1234");
+        XCTAssertTrue([store contains:@"identityId"]);
+    }
+    XCTAssertEqual(backend.readCount, 1);
+
+    // Storing the same value again is skipped, a new value is written.
+    store[@"identityId"] = @"us-east-1:1234";
+    XCTAssertEqual(backend.writeCount, 1);
+    store[@"identityId"] = @"us-east-1:5678";
+    XCTAssertEqual(backend.writeCount, 2);
+    XCTAssertEqualObjects(store[@"identityId"], @"us-east-1:5678");
+
+    // Stores of the same service share the cache.
+    AWSUICKeyChainStore *other = [self storeWithBackend:backend cachingEnabled:YES];
+    XCTAssertEqualObjects(other[@"identityId"], @"us-east-1:5678");
+    XCTAssertEqual(backend.readCount, 1);
+
+    [other removeItemForKey:@"identityId"];
+    XCTAssertEqual(backend.writeCount, 3);
+    XCTAssertNil(store[@"identityId"]);
+    XCTAssertEqual(backend.readCount, 1);
+}
+
+- (void)testRemoveAllAndNotificationInvalidateTheCache {
+    AWSUICKeyChainStoreCountingBackend *backend = [[AWSUICKeyChainStoreCountingBackend alloc] initWithDirectoryURL:self.directoryURL];
+    AWSUICKeyChainStore *store = [self storeWithBackend:backend cachingEnabled:YES];
+    AWSUICKeyChainStore *uncached = [self storeWithBackend:backend cachingEnabled:NO];
+
+    store[@"accessKey"] = @"AKID";
+    XCTAssertEqualObjects(store[@"accessKey"], @"AKID");
+    XCTAssertEqual(backend.readCount, 0);
+
+    // A change the cache cannot see...
+    uncached[@"accessKey"] = @"AKID2";
+    XCTAssertEqualObjects(store[@"accessKey"], @"AKID");
+
+    // ...is picked up once the cache of the service is invalidated.
+    [[NSNotificationCenter defaultCenter] postNotificationName:AWSUICKeyChainStoreCacheInvalidationNotification
+                                                        object:nil
+                                                      userInfo:@{AWSUICKeyChainStoreServiceKey : self.service}];
+    XCTAssertEqualObjects(store[@"accessKey"], @"AKID2");
+    XCTAssertEqual(backend.readCount, 1);
+
+    XCTAssertTrue([store removeAllItems]);
+    XCTAssertNil(store[@"accessKey"]);
+    XCTAssertEqual(backend.readCount, 2);
+}
+
+- (void)testCachingIsOffByDefault {
+    AWSUICKeyChainStore *store = [AWSUICKeyChainStore keyChainStoreWithService:self.service];
+    XCTAssertFalse(store.isCachingEnabled);
+    XCTAssertNil(store.backend);
+
+    AWSUICKeyChainStoreFileBackend *backend = [[AWSUICKeyChainStoreFileBackend alloc] initWithDirectoryURL:self.directoryURL];
+    [AWSUICKeyChainStore setDefaultBackend:backend];
+    [AWSUICKeyChainStore setDefaultCachingEnabled:YES];
+    AWSUICKeyChainStore *defaults = [AWSUICKeyChainStore keyChainStoreWithService:self.service];
+    [AWSUICKeyChainStore setDefaultBackend:nil];
+    [AWSUICKeyChainStore setDefaultCachingEnabled:NO];
+
+    XCTAssertTrue(defaults.isCachingEnabled);
+    XCTAssertEqual(defaults.backend, backend);
+}
+
+#pragma mark - Performance
+
+- (void)measureKeychainReadsWithCachingEnabled:(BOOL)cachingEnabled {
+    AWSUICKeyChainStore *store = [AWSUICKeyChainStore keyChainStoreWithService:self.service];
+    store.cachingEnabled = cachingEnabled;
+    store[@"identityId"] = @"us-east-1:01234567-89ab-cdef-0123-456789abcdef";
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            XCTAssertNotNil(store[@"identityId"]);
+        }
+    }];
+}
+
+- (void)testKeychainReadPerformance {
+    [self measureKeychainReadsWithCachingEnabled:NO];
+}
+
+- (void)testCachedKeychainReadPerformance {
+    [self measureKeychainReadsWithCachingEnabled:YES];
+}
+
+@end
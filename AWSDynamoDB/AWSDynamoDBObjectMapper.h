@@ -63,10 +63,24 @@ typedef NS_ENUM(NSInteger, AWSDynamoDBObjectMapperSaveBehavior) {
     AWSDynamoDBObjectMapperSaveBehaviorClobber
 };
 
+FOUNDATION_EXPORT NSString *const AWSDynamoDBObjectMapperErrorDomain;
+
+/**
+ The user info key of an `AWSDynamoDBObjectMapperErrorUnprocessedItems` error. The value is the `unprocessedKeys` or `unprocessedItems` dictionary of the last `BatchGetItem` or `BatchWriteItem` response.
+ */
+FOUNDATION_EXPORT NSString *const AWSDynamoDBObjectMapperUnprocessedItemsKey;
+
+typedef NS_ENUM(NSInteger, AWSDynamoDBObjectMapperErrorType) {
+    AWSDynamoDBObjectMapperErrorUnknown,
+    AWSDynamoDBObjectMapperErrorInvalidParameter,
+    AWSDynamoDBObjectMapperErrorUnprocessedItems,
+};
+
 @class AWSDynamoDBObjectMapperConfiguration;
 @class AWSDynamoDBQueryExpression;
 @class AWSDynamoDBScanExpression;
 @class AWSDynamoDBPaginatedOutput;
+@class AWSDynamoDBPaginatedOutputIterator;
 
 /**
  A DynamoDB Modeling protocol. All objects mapped to an Amazon DynamoDB table row need to conform to this protocol.
@@ -526,6 +540,208 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
 configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
 completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable response, NSError * _Nullable error))completionHandler;
 
+/**
+ Loads the items identified by the keys of the given models using the default configuration. Only the hash and range key attributes of the models are used, and they may map to different tables.
+
+ The keys are sent in `BatchGetItem` requests of up to 100 keys each. Unprocessed keys are retried with exponential backoff. If some keys remain unprocessed after the retries, the task fails with `AWSDynamoDBObjectMapperErrorUnprocessedItems`.
+
+ @param models Models that carry the keys of the items to load.
+
+ @return AWSTask. The result is an array of the loaded model objects in no particular order. Keys that do not match an item are left out.
+ */
+- (AWSTask<NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *> *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models;
+
+/**
+ Loads the items identified by the keys of the given models using the default configuration.
+
+ @param models            Models that carry the keys of the items to load.
+ @param completionHandler The completion handler to call when the load request is complete.
+                          `response`: An array of the loaded model objects in no particular order.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+completionHandler:(void (^ _Nullable)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ Loads the items identified by the keys of the given models.
+
+ @param models        Models that carry the keys of the items to load.
+ @param configuration A configuration. `consistentRead` and `maxConcurrentRequests` apply.
+
+ @return AWSTask. The result is an array of the loaded model objects in no particular order.
+ */
+- (AWSTask<NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *> *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                                             configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Loads the items identified by the keys of the given models.
+
+ @param models            Models that carry the keys of the items to load.
+ @param configuration     A configuration. `consistentRead` and `maxConcurrentRequests` apply.
+ @param completionHandler The completion handler to call when the load request is complete.
+                          `response`: An array of the loaded model objects in no particular order.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+    configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+completionHandler:(void (^ _Nullable)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ Saves the model objects to Amazon DynamoDB tables using the default configuration.
+
+ The models are sent as put requests in `BatchWriteItem` requests of up to 25 items each, so every model replaces the stored item the same way `AWSDynamoDBObjectMapperSaveBehaviorClobber` does, whatever the configured `saveBehavior`. When several models share a key, only the last one is written. Unprocessed items are retried with exponential backoff. If some items remain unprocessed after the retries, the task fails with `AWSDynamoDBObjectMapperErrorUnprocessedItems`.
+
+ @param models Models to save.
+
+ @return AWSTask.
+ */
+- (AWSTask *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models;
+
+/**
+ Saves the model objects to Amazon DynamoDB tables using the default configuration.
+
+ @param models            Models to save.
+ @param completionHandler The completion handler to call when the save request is complete.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
+/**
+ Saves the model objects to Amazon DynamoDB tables.
+
+ @param models        Models to save.
+ @param configuration A configuration. Only `maxConcurrentRequests` applies.
+
+ @return AWSTask.
+ */
+- (AWSTask *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+         configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Saves the model objects to Amazon DynamoDB tables.
+
+ @param models            Models to save.
+ @param configuration     A configuration. Only `maxConcurrentRequests` applies.
+ @param completionHandler The completion handler to call when the save request is complete.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+    configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
+/**
+ Deletes the items identified by the keys of the given models using the default configuration.
+
+ The keys are sent as delete requests in `BatchWriteItem` requests of up to 25 items each. Unprocessed items are retried with exponential backoff. If some items remain unprocessed after the retries, the task fails with `AWSDynamoDBObjectMapperErrorUnprocessedItems`.
+
+ @param models Models to delete.
+
+ @return AWSTask.
+ */
+- (AWSTask *)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models;
+
+/**
+ Deletes the items identified by the keys of the given models using the default configuration.
+
+ @param models            Models to delete.
+ @param completionHandler The completion handler to call when the delete request is complete.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+  completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
+/**
+ Deletes the items identified by the keys of the given models.
+
+ @param models        Models to delete.
+ @param configuration A configuration. Only `maxConcurrentRequests` applies.
+
+ @return AWSTask.
+ */
+- (AWSTask *)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+           configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Deletes the items identified by the keys of the given models.
+
+ @param models            Models to delete.
+ @param configuration     A configuration. Only `maxConcurrentRequests` applies.
+ @param completionHandler The completion handler to call when the delete request is complete.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+      configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+  completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
+/**
+ Scans an Amazon DynamoDB table in parallel segments using the default configuration and passes the matching objects to `itemsHandler` one page at a time, as each page arrives.
+
+ The table is split into `totalSegments` segments, and up to `maxConcurrentRequests` of them are scanned at a time. Each segment is paged through until it is exhausted. `exclusiveStartKey` of the expression is ignored. Calls to `itemsHandler` are never concurrent, but they are made on background threads and pages of different segments interleave.
+
+ @param resultClass   The class of the result object.
+ @param expression    An expression object.
+ @param totalSegments The number of segments to divide the table into. Must be at least 1.
+ @param itemsHandler  The block to call with the model objects of each page.
+
+ @return AWSTask. It completes once every segment has been scanned, or with the first error.
+ */
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+             itemsHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))itemsHandler;
+
+/**
+ Scans an Amazon DynamoDB table in parallel segments using the default configuration and passes the matching objects to `itemsHandler` one page at a time.
+
+ @param resultClass       The class of the result object.
+ @param expression        An expression object.
+ @param totalSegments     The number of segments to divide the table into. Must be at least 1.
+ @param itemsHandler      The block to call with the model objects of each page.
+ @param completionHandler The completion handler to call when every segment has been scanned.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)parallelScan:(Class)resultClass
+          expression:(AWSDynamoDBScanExpression *)expression
+       totalSegments:(NSUInteger)totalSegments
+        itemsHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))itemsHandler
+   completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
+/**
+ Scans an Amazon DynamoDB table in parallel segments and passes the matching objects to `itemsHandler` one page at a time.
+
+ @param resultClass   The class of the result object.
+ @param expression    An expression object.
+ @param totalSegments The number of segments to divide the table into. Must be at least 1.
+ @param configuration A configuration. `maxConcurrentRequests` bounds the number of segments scanned at a time.
+ @param itemsHandler  The block to call with the model objects of each page.
+
+ @return AWSTask.
+ */
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+            configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+             itemsHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))itemsHandler;
+
+/**
+ Scans an Amazon DynamoDB table in parallel segments and passes the matching objects to `itemsHandler` one page at a time.
+
+ @param resultClass       The class of the result object.
+ @param expression        An expression object.
+ @param totalSegments     The number of segments to divide the table into. Must be at least 1.
+ @param configuration     A configuration. `maxConcurrentRequests` bounds the number of segments scanned at a time.
+ @param itemsHandler      The block to call with the model objects of each page.
+ @param completionHandler The completion handler to call when every segment has been scanned.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)parallelScan:(Class)resultClass
+          expression:(AWSDynamoDBScanExpression *)expression
+       totalSegments:(NSUInteger)totalSegments
+       configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+        itemsHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))itemsHandler
+   completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
 @end
 
 /**
@@ -543,6 +759,11 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
  */
 @property (nonatomic, strong, nullable) NSNumber *consistentRead;
 
+/**
+ The maximum number of requests that batch operations and parallel scans keep in flight at a time. The default value is 4.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentRequests;
+
 @end
 
 /**
@@ -718,6 +939,60 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
  */
 - (void)reloadWithCompletionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
 
+/**
+ Returns an iterator over the pages of this output that reads ahead. The iterator first returns `self.items`. It then fetches the following pages in the background, up to `prefetchPageCount` pages ahead of the caller. The iterator does not change `self.items` or `self.lastEvaluatedKey`.
+
+ @param prefetchPageCount The number of pages to fetch ahead of the caller. `0` fetches each page only when it is asked for.
+
+ @return An iterator.
+ */
+- (AWSDynamoDBPaginatedOutputIterator *)iteratorWithPrefetchPageCount:(NSUInteger)prefetchPageCount;
+
+@end
+
+/**
+ Iterates over the pages of a query or scan and fetches the following pages while the caller processes the current one. Items are converted to model objects on a background queue, so the network and the conversion overlap.
+
+ Read-ahead stops once `prefetchPageCount` pages are buffered, or once the buffered pages reach `maxBufferedItems` items or `maxBufferedBytes` bytes. The page the caller asks for is always fetched.
+ */
+@interface AWSDynamoDBPaginatedOutputIterator : NSObject
+
+/**
+ The number of pages to fetch ahead of the caller.
+ */
+@property (nonatomic, assign, readonly) NSUInteger prefetchPageCount;
+
+/**
+ The maximum number of items to hold in pages the caller has not asked for yet. `0`, the default, means no limit. Set it before the first call to `nextPage`.
+ */
+@property (nonatomic, assign) NSUInteger maxBufferedItems;
+
+/**
+ The maximum size of the pages the caller has not asked for yet, in bytes. The size of an item is estimated the way DynamoDB sizes items: attribute names plus attribute values. `0`, the default, means no limit. Set it before the first call to `nextPage`.
+ */
+@property (nonatomic, assign) NSUInteger maxBufferedBytes;
+
+/**
+ Returns the next page of model objects. Call it again only after the previous task has completed.
+
+ @return `task.result` is an array of model objects, or `nil` when there are no more pages. `task.error` indicates why the request failed. After an error, the iteration ends.
+ */
+- (AWSTask<NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *> *)nextPage;
+
+/**
+ Calls `block` with each remaining page until the pages run out, `block` sets `stop` to `YES`, or a request fails. The block is called on a background thread.
+
+ @param block The block to call with the model objects of each page.
+
+ @return `task.error` indicates why the request failed, or `nil` if the iteration finished. `task.result` is always `nil`.
+ */
+- (AWSTask *)enumeratePagesUsingBlock:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, BOOL *stop))block;
+
+/**
+ Stops reading ahead and drops the buffered pages. Later calls to `nextPage` return `nil`.
+ */
+- (void)cancel;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -24,6 +24,15 @@ static NSString *const AWSInfoDynamoDBObjectMapper = @"DynamoDBObjectMapper";
 
 static const NSString *AWSDynamoDBObjectMapperHashKeyAttributePlaceHolder = @":awsddbomhashvalueplaceholder";
 NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
+NSString *const AWSDynamoDBObjectMapperErrorDomain = @"com.amazonaws.AWSDynamoDBObjectMapperErrorDomain";
+NSString *const AWSDynamoDBObjectMapperUnprocessedItemsKey = @"unprocessedItems";
+
+static const NSUInteger AWSDynamoDBObjectMapperBatchGetItemLimit = 100;
+static const NSUInteger AWSDynamoDBObjectMapperBatchWriteItemLimit = 25;
+static const NSUInteger AWSDynamoDBObjectMapperBatchMaxRetries = 8;
+static const int AWSDynamoDBObjectMapperBatchRetryBaseDelay = 50; // milliseconds
+static const int AWSDynamoDBObjectMapperBatchRetryMaxDelay = 5000; // milliseconds
+static const NSUInteger AWSDynamoDBObjectMapperDefaultMaxConcurrentRequests = 4;
 
 @interface NSString (AWSDynamoDBObjectMapperSaveBehavior)
 
@@ -121,6 +130,27 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
 
 @end
 
+@interface AWSDynamoDBPaginatedOutputIterator()
+
+@property (nonatomic, strong) AWSDynamoDBObjectMapper *dynamoDBObjectMapper;
+@property (nonatomic, assign) Class resultClass;
+@property (nonatomic, strong) AWSDynamoDBScanInput *scanInput;
+@property (nonatomic, strong) AWSDynamoDBQueryInput *queryInput;
+@property (nonatomic, strong) AWSExecutor *conversionExecutor;
+
+@property (nonatomic, strong, nullable) NSArray *firstPage;
+@property (nonatomic, strong, nullable) NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *exclusiveStartKey;
+@property (nonatomic, strong) NSMutableArray *pages;
+@property (nonatomic, assign) NSUInteger bufferedItemCount;
+@property (nonatomic, assign) NSUInteger bufferedByteCount;
+@property (nonatomic, assign, getter=isFetching) BOOL fetching;
+@property (nonatomic, assign, getter=isFinished) BOOL finished;
+
+- (instancetype)initWithPaginatedOutput:(AWSDynamoDBPaginatedOutput *)paginatedOutput
+                      prefetchPageCount:(NSUInteger)prefetchPageCount;
+
+@end
+
 @interface AWSDynamoDB()
 
 - (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
@@ -232,6 +262,9 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
                                       queryInput:(AWSDynamoDBQueryInput *)queryInput;
 - (AWSTask<AWSDynamoDBPaginatedOutput *> *)scan:(Class)resultClass
                                       scanInput:(AWSDynamoDBScanInput *)scanInput;
+- (nullable NSArray *)models:(Class)resultClass
+                   fromItems:(NSArray<NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *> *)items
+                       error:(NSError **)error;
 
 @end
 
@@ -589,19 +622,12 @@ completionHandler:completionHandler];
     return [[self.dynamoDB query:queryInput] continueWithSuccessBlock:^id(AWSTask *task) {
         AWSDynamoDBQueryOutput *queryOutput = task.result;
 
-        NSMutableArray *items = [NSMutableArray new];
         NSError *error = nil;
-        for (id item in queryOutput.items) {
-
-            NSDictionary *itemsDictionary = [self removeAttributes:item];
-
-            id responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
-                                             fromJSONDictionary:itemsDictionary
-                                                          error:&error];
-            if (error) {
-                return [AWSTask taskWithError:error];
-            }
-            [items addObject:responseObject];
+        NSArray *items = [self models:resultClass
+                            fromItems:queryOutput.items
+                                error:&error];
+        if (!items) {
+            return [AWSTask taskWithError:error];
         }
 
         AWSDynamoDBPaginatedOutput *paginatedOutput = [AWSDynamoDBPaginatedOutput new];
@@ -651,6 +677,14 @@ completionHandler:completionHandler];
 - (AWSTask<AWSDynamoDBPaginatedOutput *> *)scan:(Class)resultClass
                                      expression:(AWSDynamoDBScanExpression *)expression
                                   configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    return [self scan:resultClass
+            scanInput:[self scanInput:resultClass
+                           expression:expression]];
+}
+
+// Internal method
+- (AWSDynamoDBScanInput *)scanInput:(Class)resultClass
+                         expression:(AWSDynamoDBScanExpression *)expression {
     AWSDynamoDBScanInput *scanInput = [AWSDynamoDBScanInput new];
     scanInput.tableName = [resultClass performSelector:@selector(dynamoDBTableName)];
     scanInput.limit = expression.limit;
@@ -676,8 +710,7 @@ completionHandler:completionHandler];
     scanInput.projectionExpression = expression.projectionExpression;
     scanInput.expressionAttributeNames = expression.expressionAttributeNames;
 
-    return [self scan:resultClass
-            scanInput:scanInput];
+    return scanInput;
 }
 
 // Internal class
@@ -686,18 +719,12 @@ completionHandler:completionHandler];
     return [[self.dynamoDB scan:scanInput] continueWithSuccessBlock:^id(AWSTask *task) {
         AWSDynamoDBScanOutput *scanOutput = task.result;
 
-        NSMutableArray *items = [NSMutableArray new];
         NSError *error = nil;
-        for (id item in scanOutput.items) {
-
-            NSDictionary *itemsDictionary = [self removeAttributes:item];
-            id responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
-                                             fromJSONDictionary:itemsDictionary
-                                                          error:&error];
-            if (error) {
-                return [AWSTask taskWithError:error];
-            }
-            [items addObject:responseObject];
+        NSArray *items = [self models:resultClass
+                            fromItems:scanOutput.items
+                                error:&error];
+        if (!items) {
+            return [AWSTask taskWithError:error];
         }
 
         AWSDynamoDBPaginatedOutput *paginatedOutput = [AWSDynamoDBPaginatedOutput new];
@@ -728,8 +755,476 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
     }];
 }
 
+#pragma mark - Batch operations
+
+- (AWSTask *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    return [self batchLoad:models
+             configuration:self.objectMapperConfiguration];
+}
+
+- (void)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+completionHandler:(void (^ _Nullable)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> * _Nullable response, NSError * _Nullable error))completionHandler {
+    [self batchLoad:models
+      configuration:self.objectMapperConfiguration
+  completionHandler:completionHandler];
+}
+
+- (AWSTask *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+         configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    configuration = configuration ?: self.objectMapperConfiguration;
+
+    // BatchGetItem rejects duplicate keys, so each key is requested once.
+    NSMutableDictionary<NSString *, Class> *resultClasses = [NSMutableDictionary new];
+    NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, NSDictionary *> *> *keysByTable = [NSMutableDictionary new];
+    for (AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model in models) {
+        NSString *tableName = [[model class] dynamoDBTableName];
+        if (!resultClasses[tableName]) {
+            resultClasses[tableName] = [model class];
+            keysByTable[tableName] = [NSMutableDictionary new];
+        }
+        NSDictionary *key = [model key];
+        keysByTable[tableName][[self identifierForKey:key]] = key;
+    }
+
+    NSMutableArray<NSDictionary<NSString *, AWSDynamoDBKeysAndAttributes *> *> *chunks = [NSMutableArray new];
+    __block NSMutableDictionary<NSString *, AWSDynamoDBKeysAndAttributes *> *chunk = [NSMutableDictionary new];
+    __block NSUInteger chunkCount = 0;
+    [keysByTable enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, NSMutableDictionary<NSString *, NSDictionary *> *keysByIdentifier, BOOL *stop) {
+        NSArray<NSDictionary *> *keys = [keysByIdentifier allValues];
+        NSUInteger location = 0;
+        while (location < [keys count]) {
+            NSUInteger length = MIN([keys count] - location, AWSDynamoDBObjectMapperBatchGetItemLimit - chunkCount);
+            AWSDynamoDBKeysAndAttributes *keysAndAttributes = [AWSDynamoDBKeysAndAttributes new];
+            keysAndAttributes.keys = [keys subarrayWithRange:NSMakeRange(location, length)];
+            keysAndAttributes.consistentRead = configuration.consistentRead;
+            chunk[tableName] = keysAndAttributes;
+            chunkCount += length;
+            location += length;
+            if (chunkCount == AWSDynamoDBObjectMapperBatchGetItemLimit) {
+                [chunks addObject:chunk];
+                chunk = [NSMutableDictionary new];
+                chunkCount = 0;
+            }
+        }
+    }];
+    if (chunkCount > 0) {
+        [chunks addObject:chunk];
+    }
+
+    NSMutableArray *results = [NSMutableArray new];
+    return [[self runTasksForObjects:chunks
+                       configuration:configuration
+                          usingBlock:^AWSTask *(NSDictionary<NSString *, AWSDynamoDBKeysAndAttributes *> *requestItems) {
+        return [[self batchGetRequestItems:requestItems
+                                   attempt:0] continueWithSuccessBlock:^id(AWSTask<NSDictionary *> *task) {
+            NSDictionary<NSString *, NSArray *> *responses = task.result;
+            NSMutableArray *chunkResults = [NSMutableArray new];
+            for (NSString *tableName in responses) {
+                NSError *error = nil;
+                NSArray *models = [self models:resultClasses[tableName]
+                                     fromItems:responses[tableName]
+                                         error:&error];
+                if (!models) {
+                    return [AWSTask taskWithError:error];
+                }
+                [chunkResults addObjectsFromArray:models];
+            }
+            @synchronized(results) {
+                [results addObjectsFromArray:chunkResults];
+            }
+            return nil;
+        }];
+    }] continueWithSuccessBlock:^id(AWSTask *task) {
+        return results;
+    }];
+}
+
+- (void)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+    configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+completionHandler:(void (^ _Nullable)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> * _Nullable response, NSError * _Nullable error))completionHandler {
+    [[self batchLoad:models
+       configuration:configuration] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        NSArray *response = task.result;
+        NSError *error = task.error;
+
+        if (completionHandler) {
+            completionHandler(response, error);
+        }
+        return nil;
+    }];
+}
+
+- (AWSTask *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    return [self batchSave:models
+             configuration:self.objectMapperConfiguration];
+}
+
+- (void)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [self batchSave:models
+      configuration:self.objectMapperConfiguration
+  completionHandler:completionHandler];
+}
+
+- (AWSTask *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+         configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    return [self batchWrite:models
+              configuration:configuration
+               writeRequest:^AWSDynamoDBWriteRequest *(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model) {
+        AWSDynamoDBPutRequest *putRequest = [AWSDynamoDBPutRequest new];
+        putRequest.item = [model itemForPutItemInput];
+
+        AWSDynamoDBWriteRequest *writeRequest = [AWSDynamoDBWriteRequest new];
+        writeRequest.putRequest = putRequest;
+        return writeRequest;
+    }];
+}
+
+- (void)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+    configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [[self batchSave:models
+       configuration:configuration] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        NSError *error = task.error;
+
+        if (completionHandler) {
+            completionHandler(error);
+        }
+        return nil;
+    }];
+}
+
+- (AWSTask *)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    return [self batchRemove:models
+               configuration:self.objectMapperConfiguration];
+}
+
+- (void)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+  completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [self batchRemove:models
+        configuration:self.objectMapperConfiguration
+    completionHandler:completionHandler];
+}
+
+- (AWSTask *)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+           configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    return [self batchWrite:models
+              configuration:configuration
+               writeRequest:^AWSDynamoDBWriteRequest *(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model) {
+        AWSDynamoDBDeleteRequest *deleteRequest = [AWSDynamoDBDeleteRequest new];
+        deleteRequest.key = [model key];
+
+        AWSDynamoDBWriteRequest *writeRequest = [AWSDynamoDBWriteRequest new];
+        writeRequest.deleteRequest = deleteRequest;
+        return writeRequest;
+    }];
+}
+
+- (void)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+      configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+  completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [[self batchRemove:models
+         configuration:configuration] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        NSError *error = task.error;
+
+        if (completionHandler) {
+            completionHandler(error);
+        }
+        return nil;
+    }];
+}
+
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+             itemsHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))itemsHandler {
+    return [self parallelScan:resultClass
+                   expression:expression
+                totalSegments:totalSegments
+                configuration:self.objectMapperConfiguration
+                 itemsHandler:itemsHandler];
+}
+
+- (void)parallelScan:(Class)resultClass
+          expression:(AWSDynamoDBScanExpression *)expression
+       totalSegments:(NSUInteger)totalSegments
+        itemsHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))itemsHandler
+   completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [self parallelScan:resultClass
+            expression:expression
+         totalSegments:totalSegments
+         configuration:self.objectMapperConfiguration
+          itemsHandler:itemsHandler
+     completionHandler:completionHandler];
+}
+
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+            configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+             itemsHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))itemsHandler {
+    if (totalSegments == 0) {
+        return [AWSTask taskWithError:[NSError errorWithDomain:AWSDynamoDBObjectMapperErrorDomain
+                                                          code:AWSDynamoDBObjectMapperErrorInvalidParameter
+                                                      userInfo:@{NSLocalizedDescriptionKey : @"'totalSegments' must be at least 1."}]];
+    }
+
+    NSMutableArray<AWSDynamoDBScanInput *> *segments = [NSMutableArray arrayWithCapacity:totalSegments];
+    for (NSUInteger segment = 0; segment < totalSegments; segment++) {
+        AWSDynamoDBScanInput *scanInput = [self scanInput:resultClass
+                                               expression:expression];
+        scanInput.exclusiveStartKey = nil;
+        scanInput.segment = @(segment);
+        scanInput.totalSegments = @(totalSegments);
+        [segments addObject:scanInput];
+    }
+
+    // Serializes the handler so callers do not need to guard the state it touches.
+    NSObject *handlerLock = [NSObject new];
+    void (^serializedItemsHandler)(NSArray *) = ^(NSArray *items) {
+        @synchronized(handlerLock) {
+            itemsHandler(items);
+        }
+    };
+
+    return [self runTasksForObjects:segments
+                      configuration:configuration ?: self.objectMapperConfiguration
+                         usingBlock:^AWSTask *(AWSDynamoDBScanInput *scanInput) {
+        return [self scanSegment:resultClass
+                       scanInput:scanInput
+                    itemsHandler:serializedItemsHandler];
+    }];
+}
+
+- (void)parallelScan:(Class)resultClass
+          expression:(AWSDynamoDBScanExpression *)expression
+       totalSegments:(NSUInteger)totalSegments
+       configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+        itemsHandler:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))itemsHandler
+   completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [[self parallelScan:resultClass
+             expression:expression
+          totalSegments:totalSegments
+          configuration:configuration
+           itemsHandler:itemsHandler] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        NSError *error = task.error;
+
+        if (completionHandler) {
+            completionHandler(error);
+        }
+        return nil;
+    }];
+}
+
+// Internal method
+- (AWSTask *)scanSegment:(Class)resultClass
+               scanInput:(AWSDynamoDBScanInput *)scanInput
+            itemsHandler:(void (^)(NSArray *items))itemsHandler {
+    return [[self scan:resultClass
+             scanInput:scanInput] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBPaginatedOutput *> *task) {
+        AWSDynamoDBPaginatedOutput *paginatedOutput = task.result;
+        if ([paginatedOutput.items count] > 0) {
+            itemsHandler(paginatedOutput.items);
+        }
+        if (!paginatedOutput.lastEvaluatedKey) {
+            return nil;
+        }
+
+        scanInput.exclusiveStartKey = paginatedOutput.lastEvaluatedKey;
+        return [self scanSegment:resultClass
+                       scanInput:scanInput
+                    itemsHandler:itemsHandler];
+    }];
+}
+
+// Internal method
+- (AWSTask *)batchWrite:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+          configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+           writeRequest:(AWSDynamoDBWriteRequest *(^)(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model))writeRequestBlock {
+    // BatchWriteItem rejects two requests for the same key, so the last model for each key wins.
+    NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, AWSDynamoDBWriteRequest *> *> *requestsByTable = [NSMutableDictionary new];
+    for (AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model in models) {
+        NSString *tableName = [[model class] dynamoDBTableName];
+        NSMutableDictionary<NSString *, AWSDynamoDBWriteRequest *> *requests = requestsByTable[tableName];
+        if (!requests) {
+            requests = [NSMutableDictionary new];
+            requestsByTable[tableName] = requests;
+        }
+        requests[[self identifierForKey:[model key]]] = writeRequestBlock(model);
+    }
+
+    NSMutableArray<NSDictionary<NSString *, NSArray<AWSDynamoDBWriteRequest *> *> *> *chunks = [NSMutableArray new];
+    __block NSMutableDictionary<NSString *, NSArray<AWSDynamoDBWriteRequest *> *> *chunk = [NSMutableDictionary new];
+    __block NSUInteger chunkCount = 0;
+    [requestsByTable enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, NSMutableDictionary<NSString *, AWSDynamoDBWriteRequest *> *requests, BOOL *stop) {
+        NSArray<AWSDynamoDBWriteRequest *> *writeRequests = [requests allValues];
+        NSUInteger location = 0;
+        while (location < [writeRequests count]) {
+            NSUInteger length = MIN([writeRequests count] - location, AWSDynamoDBObjectMapperBatchWriteItemLimit - chunkCount);
+            chunk[tableName] = [writeRequests subarrayWithRange:NSMakeRange(location, length)];
+            chunkCount += length;
+            location += length;
+            if (chunkCount == AWSDynamoDBObjectMapperBatchWriteItemLimit) {
+                [chunks addObject:chunk];
+                chunk = [NSMutableDictionary new];
+                chunkCount = 0;
+            }
+        }
+    }];
+    if (chunkCount > 0) {
+        [chunks addObject:chunk];
+    }
+
+    return [self runTasksForObjects:chunks
+                      configuration:configuration ?: self.objectMapperConfiguration
+                         usingBlock:^AWSTask *(NSDictionary<NSString *, NSArray<AWSDynamoDBWriteRequest *> *> *requestItems) {
+        return [self batchWriteRequestItems:requestItems
+                                    attempt:0];
+    }];
+}
+
+// Internal method
+- (AWSTask *)batchWriteRequestItems:(NSDictionary<NSString *, NSArray<AWSDynamoDBWriteRequest *> *> *)requestItems
+                            attempt:(NSUInteger)attempt {
+    AWSDynamoDBBatchWriteItemInput *batchWriteItemInput = [AWSDynamoDBBatchWriteItemInput new];
+    batchWriteItemInput.requestItems = requestItems;
+
+    return [[self.dynamoDB batchWriteItem:batchWriteItemInput] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBBatchWriteItemOutput *> *task) {
+        NSDictionary *unprocessedItems = task.result.unprocessedItems;
+        if ([unprocessedItems count] == 0) {
+            return nil;
+        }
+        if (attempt >= AWSDynamoDBObjectMapperBatchMaxRetries) {
+            return [AWSTask taskWithError:[self unprocessedItemsError:unprocessedItems]];
+        }
+
+        AWSDDLogDebug(@"Retrying the unprocessed items of a BatchWriteItem request. Attempt: %lu", (unsigned long)attempt + 1);
+        return [[AWSTask taskWithDelay:[self batchRetryDelay:attempt]] continueWithSuccessBlock:^id(AWSTask *task) {
+            return [self batchWriteRequestItems:unprocessedItems
+                                        attempt:attempt + 1];
+        }];
+    }];
+}
+
+// Internal method. The result maps table names to the items returned across all attempts.
+- (AWSTask<NSDictionary *> *)batchGetRequestItems:(NSDictionary<NSString *, AWSDynamoDBKeysAndAttributes *> *)requestItems
+                                          attempt:(NSUInteger)attempt {
+    AWSDynamoDBBatchGetItemInput *batchGetItemInput = [AWSDynamoDBBatchGetItemInput new];
+    batchGetItemInput.requestItems = requestItems;
+
+    return [[self.dynamoDB batchGetItem:batchGetItemInput] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBBatchGetItemOutput *> *task) {
+        AWSDynamoDBBatchGetItemOutput *batchGetItemOutput = task.result;
+        NSDictionary *responses = batchGetItemOutput.responses ?: @{};
+        NSDictionary *unprocessedKeys = batchGetItemOutput.unprocessedKeys;
+        if ([unprocessedKeys count] == 0) {
+            return responses;
+        }
+        if (attempt >= AWSDynamoDBObjectMapperBatchMaxRetries) {
+            return [AWSTask taskWithError:[self unprocessedItemsError:unprocessedKeys]];
+        }
+
+        AWSDDLogDebug(@"Retrying the unprocessed keys of a BatchGetItem request. Attempt: %lu", (unsigned long)attempt + 1);
+        return [[[AWSTask taskWithDelay:[self batchRetryDelay:attempt]] continueWithSuccessBlock:^id(AWSTask *task) {
+            return [self batchGetRequestItems:unprocessedKeys
+                                      attempt:attempt + 1];
+        }] continueWithSuccessBlock:^id(AWSTask<NSDictionary *> *task) {
+            NSMutableDictionary *mergedResponses = [responses mutableCopy];
+            [task.result enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, NSArray *items, BOOL *stop) {
+                mergedResponses[tableName] = mergedResponses[tableName] ? [mergedResponses[tableName] arrayByAddingObjectsFromArray:items] : items;
+            }];
+            return mergedResponses;
+        }];
+    }];
+}
+
+// Internal method. Runs `block` for each object with at most `maxConcurrentRequests` tasks in flight, and stops
+// handing out objects after the first failure.
+- (AWSTask *)runTasksForObjects:(NSArray *)objects
+                  configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+                     usingBlock:(AWSTask *(^)(id object))block {
+    NSEnumerator *enumerator = [objects objectEnumerator];
+    NSUInteger maxConcurrentRequests = MAX(configuration.maxConcurrentRequests, 1);
+
+    NSMutableArray<AWSTask *> *workers = [NSMutableArray new];
+    for (NSUInteger i = 0; i < MIN(maxConcurrentRequests, [objects count]); i++) {
+        [workers addObject:[self runNextTaskFromEnumerator:enumerator
+                                                usingBlock:block]];
+    }
+
+    return [[AWSTask taskForCompletionOfAllTasks:workers] continueWithBlock:^id(AWSTask *task) {
+        if ([task.error.domain isEqualToString:AWSTaskErrorDomain]
+            && task.error.code == kAWSMultipleErrorsError) {
+            // Report the first failure rather than the aggregate.
+            return [AWSTask taskWithError:[task.error.userInfo[AWSTaskMultipleErrorsUserInfoKey] firstObject]];
+        }
+        return task;
+    }];
+}
+
+- (AWSTask *)runNextTaskFromEnumerator:(NSEnumerator *)enumerator
+                            usingBlock:(AWSTask *(^)(id object))block {
+    id object = nil;
+    @synchronized(enumerator) {
+        object = [enumerator nextObject];
+    }
+    if (!object) {
+        return [AWSTask taskWithResult:nil];
+    }
+
+    return [block(object) continueWithBlock:^id(AWSTask *task) {
+        if (task.error) {
+            @synchronized(enumerator) {
+                [enumerator allObjects];
+            }
+            return task;
+        }
+        return [self runNextTaskFromEnumerator:enumerator
+                                    usingBlock:block];
+    }];
+}
+
+// `NSDictionary` hashes by count alone, so keys are deduplicated by a string built from their values instead.
+- (NSString *)identifierForKey:(NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)key {
+    NSMutableString *identifier = [NSMutableString new];
+    for (NSString *attributeName in [[key allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+        [identifier appendFormat:@"%@=%@;", attributeName, [key[attributeName] aws_getAttributeValue]];
+    }
+    return identifier;
+}
+
+- (int)batchRetryDelay:(NSUInteger)attempt {
+    // Exponential backoff with full jitter.
+    int delay = MIN(AWSDynamoDBObjectMapperBatchRetryBaseDelay << MIN(attempt, 16), AWSDynamoDBObjectMapperBatchRetryMaxDelay);
+    return (int)arc4random_uniform((uint32_t)delay) + 1;
+}
+
+- (NSError *)unprocessedItemsError:(NSDictionary *)unprocessedItems {
+    return [NSError errorWithDomain:AWSDynamoDBObjectMapperErrorDomain
+                               code:AWSDynamoDBObjectMapperErrorUnprocessedItems
+                           userInfo:@{NSLocalizedDescriptionKey : @"Some items were still unprocessed after retrying.",
+                                      AWSDynamoDBObjectMapperUnprocessedItemsKey : unprocessedItems}];
+}
+
 #pragma mark - Utility
 
+- (NSArray *)models:(Class)resultClass
+          fromItems:(NSArray<NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *> *)items
+              error:(NSError **)error {
+    NSMutableArray *models = [NSMutableArray arrayWithCapacity:[items count]];
+    for (NSDictionary *item in items) {
+        NSDictionary *itemsDictionary = [self removeAttributes:item];
+        id responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
+                                         fromJSONDictionary:itemsDictionary
+                                                      error:error];
+        if (!responseObject) {
+            return nil;
+        }
+        [models addObject:responseObject];
+    }
+
+    return models;
+}
+
 - (NSDictionary *)removeAttributes:(NSDictionary *)item {
     NSMutableDictionary *mutableItem = [NSMutableDictionary new];
     [item enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
@@ -884,6 +1379,7 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
 - (instancetype)init {
     if (self = [super init]) {
         _saveBehavior = AWSDynamoDBObjectMapperSaveBehaviorUpdate;
+        _maxConcurrentRequests = AWSDynamoDBObjectMapperDefaultMaxConcurrentRequests;
     }
 
     return self;
@@ -893,6 +1389,7 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
     AWSDynamoDBObjectMapperConfiguration *configuration = [[[self class] allocWithZone:zone] init];
     configuration.saveBehavior = self.saveBehavior;
     configuration.consistentRead = [self.consistentRead copy];
+    configuration.maxConcurrentRequests = self.maxConcurrentRequests;
     
     return configuration;
 }
@@ -972,4 +1469,237 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
     return [AWSTask taskWithResult:nil];
 }
 
+- (AWSDynamoDBPaginatedOutputIterator *)iteratorWithPrefetchPageCount:(NSUInteger)prefetchPageCount {
+    return [[AWSDynamoDBPaginatedOutputIterator alloc] initWithPaginatedOutput:self
+                                                            prefetchPageCount:prefetchPageCount];
+}
+
+@end
+
+// Estimates the size of an attribute value the way DynamoDB sizes items.
+static NSUInteger AWSDynamoDBAttributeValueSize(AWSDynamoDBAttributeValue *attributeValue) {
+    if (attributeValue.S) {
+        return [attributeValue.S lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    }
+    if (attributeValue.N) {
+        return [attributeValue.N length];
+    }
+    if (attributeValue.B) {
+        return [attributeValue.B length];
+    }
+    if (attributeValue.BOOLEAN || attributeValue.NIL) {
+        return 1;
+    }
+
+    NSUInteger size = 0;
+    for (NSString *value in attributeValue.SS) {
+        size += [value lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    }
+    for (NSString *value in attributeValue.NS) {
+        size += [value length];
+    }
+    for (NSData *value in attributeValue.BS) {
+        size += [value length];
+    }
+    if (attributeValue.L) {
+        size += 3;
+        for (AWSDynamoDBAttributeValue *value in attributeValue.L) {
+            size += 1 + AWSDynamoDBAttributeValueSize(value);
+        }
+    }
+    if (attributeValue.M) {
+        size += 3;
+        for (NSString *name in attributeValue.M) {
+            size += 1 + [name lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + AWSDynamoDBAttributeValueSize(attributeValue.M[name]);
+        }
+    }
+    return size;
+}
+
+static NSUInteger AWSDynamoDBItemsSize(NSArray<NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *> *items) {
+    NSUInteger size = 0;
+    for (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *item in items) {
+        for (NSString *name in item) {
+            size += [name lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + AWSDynamoDBAttributeValueSize(item[name]);
+        }
+    }
+    return size;
+}
+
+@interface AWSDynamoDBPrefetchedPage : NSObject
+
+@property (nonatomic, strong) AWSTaskCompletionSource<NSArray *> *taskCompletionSource;
+@property (nonatomic, assign) NSUInteger itemCount;
+@property (nonatomic, assign) NSUInteger byteCount;
+
+@end
+
+@implementation AWSDynamoDBPrefetchedPage
+
+@end
+
+@implementation AWSDynamoDBPaginatedOutputIterator
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- [AWSDynamoDBPaginatedOutput iteratorWithPrefetchPageCount:]` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithPaginatedOutput:(AWSDynamoDBPaginatedOutput *)paginatedOutput
+                      prefetchPageCount:(NSUInteger)prefetchPageCount {
+    if (self = [super init]) {
+        _prefetchPageCount = prefetchPageCount;
+        _dynamoDBObjectMapper = paginatedOutput.dynamoDBObjectMapper;
+        _resultClass = paginatedOutput.resultClass;
+        _scanInput = [paginatedOutput.scanInput copy];
+        _queryInput = [paginatedOutput.queryInput copy];
+        _conversionExecutor = [AWSExecutor executorWithDispatchQueue:dispatch_get_global_queue(QOS_CLASS_UTILITY, 0)];
+        _firstPage = paginatedOutput.items ?: @[];
+        _exclusiveStartKey = paginatedOutput.lastEvaluatedKey;
+        _finished = (paginatedOutput.lastEvaluatedKey == nil);
+        _pages = [NSMutableArray new];
+    }
+
+    return self;
+}
+
+- (AWSTask *)nextPage {
+    AWSDynamoDBPrefetchedPage *page = nil;
+    @synchronized(self) {
+        if (self.firstPage) {
+            NSArray *firstPage = self.firstPage;
+            self.firstPage = nil;
+            [self fillBufferOnDemand:NO];
+            return [AWSTask taskWithResult:firstPage];
+        }
+
+        [self fillBufferOnDemand:YES];
+        page = [self.pages firstObject];
+        if (!page) {
+            return [AWSTask taskWithResult:nil];
+        }
+        [self.pages removeObjectAtIndex:0];
+        self.bufferedItemCount -= page.itemCount;
+        self.bufferedByteCount -= page.byteCount;
+        [self fillBufferOnDemand:NO];
+    }
+
+    return page.taskCompletionSource.task;
+}
+
+- (AWSTask *)enumeratePagesUsingBlock:(void (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, BOOL *stop))block {
+    return [[self nextPage] continueWithExecutor:self.conversionExecutor
+                                withSuccessBlock:^id(AWSTask<NSArray *> *task) {
+        if (!task.result) {
+            return nil;
+        }
+
+        BOOL stop = NO;
+        block(task.result, &stop);
+        if (stop) {
+            [self cancel];
+            return nil;
+        }
+        return [self enumeratePagesUsingBlock:block];
+    }];
+}
+
+- (void)cancel {
+    @synchronized(self) {
+        self.finished = YES;
+        self.firstPage = nil;
+        [self.pages removeAllObjects];
+        self.bufferedItemCount = 0;
+        self.bufferedByteCount = 0;
+    }
+}
+
+// Must be called while synchronized on `self`. A page that the caller is waiting for is always fetched; read-ahead
+// pages only while the buffer is under its limits. Pages depend on the previous `LastEvaluatedKey`, so only one
+// request is in flight at a time.
+- (void)fillBufferOnDemand:(BOOL)onDemand {
+    if (self.isFinished || self.isFetching) {
+        return;
+    }
+
+    NSUInteger pageCount = [self.pages count];
+    BOOL withinLimits = pageCount < self.prefetchPageCount
+    && (self.maxBufferedItems == 0 || self.bufferedItemCount < self.maxBufferedItems)
+    && (self.maxBufferedBytes == 0 || self.bufferedByteCount < self.maxBufferedBytes);
+    if (!(onDemand && pageCount == 0) && !withinLimits) {
+        return;
+    }
+
+    AWSDynamoDBPrefetchedPage *page = [AWSDynamoDBPrefetchedPage new];
+    page.taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    [self.pages addObject:page];
+    self.fetching = YES;
+    [self fetchPage:page];
+}
+
+- (void)fetchPage:(AWSDynamoDBPrefetchedPage *)page {
+    AWSTask *task = nil;
+    if (self.queryInput) {
+        AWSDynamoDBQueryInput *queryInput = [self.queryInput copy];
+        queryInput.exclusiveStartKey = self.exclusiveStartKey;
+        task = [self.dynamoDBObjectMapper.dynamoDB query:queryInput];
+    } else {
+        AWSDynamoDBScanInput *scanInput = [self.scanInput copy];
+        scanInput.exclusiveStartKey = self.exclusiveStartKey;
+        task = [self.dynamoDBObjectMapper.dynamoDB scan:scanInput];
+    }
+
+    [task continueWithBlock:^id(AWSTask *task) {
+        NSArray *items = nil;
+        NSDictionary *lastEvaluatedKey = nil;
+        if ([task.result isKindOfClass:[AWSDynamoDBQueryOutput class]]) {
+            AWSDynamoDBQueryOutput *queryOutput = task.result;
+            items = queryOutput.items;
+            lastEvaluatedKey = queryOutput.lastEvaluatedKey;
+        } else if ([task.result isKindOfClass:[AWSDynamoDBScanOutput class]]) {
+            AWSDynamoDBScanOutput *scanOutput = task.result;
+            items = scanOutput.items;
+            lastEvaluatedKey = scanOutput.lastEvaluatedKey;
+        }
+
+        @synchronized(self) {
+            self.fetching = NO;
+            if (task.error) {
+                self.finished = YES;
+            } else {
+                self.exclusiveStartKey = lastEvaluatedKey;
+                self.finished = self.isFinished || lastEvaluatedKey == nil;
+                page.itemCount = [items count];
+                page.byteCount = AWSDynamoDBItemsSize(items);
+                if ([self.pages indexOfObjectIdenticalTo:page] != NSNotFound) {
+                    self.bufferedItemCount += page.itemCount;
+                    self.bufferedByteCount += page.byteCount;
+                }
+                [self fillBufferOnDemand:NO];
+            }
+        }
+
+        if (task.error) {
+            [page.taskCompletionSource trySetError:task.error];
+            return nil;
+        }
+
+        // Converting off the response thread lets the next request go out while this page is being mapped.
+        [self.conversionExecutor execute:^{
+            NSError *error = nil;
+            NSArray *models = [self.dynamoDBObjectMapper models:self.resultClass
+                                                      fromItems:items ?: @[]
+                                                          error:&error];
+            if (models) {
+                [page.taskCompletionSource trySetResult:models];
+            } else {
+                [page.taskCompletionSource trySetError:error];
+            }
+        }];
+        return nil;
+    }];
+}
+
 @end
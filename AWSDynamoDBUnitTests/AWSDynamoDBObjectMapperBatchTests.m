@@ -0,0 +1,533 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <stdatomic.h>
+#import "AWSTestUtility.h"
+#import "AWSDynamoDB.h"
+
+static NSString *const AWSDynamoDBBatchTestTable = @"BatchTestItems";
+
+@interface AWSDynamoDB()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSDynamoDBBatchTestItem : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *itemId;
+@property (nonatomic, strong) NSNumber *value;
+
+@end
+
+@implementation AWSDynamoDBBatchTestItem
+
++ (NSString *)dynamoDBTableName {
+    return AWSDynamoDBBatchTestTable;
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"itemId";
+}
+
++ (NSDictionary *)JSONKeyPathsByPropertyKey {
+    return @{
+             @"itemId" : @"itemId",
+             @"value" : @"value",
+             };
+}
+
+@end
+
+/**
+ A local stand-in for the DynamoDB batch and scan APIs. Items live in memory, every response is delivered
+ asynchronously after `latency` microseconds, and each request processes at most `maxItemsPerRequest` items, leaving the
+ rest unprocessed the way a throttled table does.
+ */
+@interface AWSDynamoDBLocalStandIn : AWSDynamoDB
+
+@property (nonatomic, assign) NSUInteger maxItemsPerRequest;
+@property (nonatomic, assign) NSUInteger scanPageSize;
+@property (nonatomic, assign) useconds_t latency;
+
+@property (atomic, assign) NSUInteger requestCount;
+@property (atomic, assign) NSUInteger largestRequest;
+@property (atomic, assign) NSUInteger maxConcurrentRequests;
+@property (atomic, assign) BOOL rejectsAllItems;
+
+- (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)itemWithId:(NSString *)itemId;
+- (NSUInteger)itemCount;
+
+@end
+
+@implementation AWSDynamoDBLocalStandIn {
+    NSMutableDictionary<NSString *, NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *> *_items;
+    atomic_uint _inflight;
+}
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration {
+    if (self = [super initWithConfiguration:configuration]) {
+        _items = [NSMutableDictionary new];
+        _maxItemsPerRequest = NSUIntegerMax;
+        _scanPageSize = 10;
+    }
+    return self;
+}
+
+- (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)itemWithId:(NSString *)itemId {
+    @synchronized(_items) {
+        return _items[itemId];
+    }
+}
+
+- (NSUInteger)itemCount {
+    @synchronized(_items) {
+        return [_items count];
+    }
+}
+
+- (AWSTask *)respond:(NSUInteger)itemCount block:(id (^)(void))block {
+    @synchronized(self) {
+        self.requestCount++;
+        self.largestRequest = MAX(self.largestRequest, itemCount);
+    }
+    return [AWSTask taskFromExecutor:[AWSExecutor defaultExecutor] withBlock:^id {
+        NSUInteger inflight = atomic_fetch_add(&self->_inflight, 1) + 1;
+        @synchronized(self) {
+            self.maxConcurrentRequests = MAX(self.maxConcurrentRequests, inflight);
+        }
+        usleep(self.latency);
+        id result = block();
+        atomic_fetch_sub(&self->_inflight, 1);
+        return result;
+    }];
+}
+
+- (NSUInteger)processedCount:(NSUInteger)count {
+    return self.rejectsAllItems ? 0 : MIN(count, self.maxItemsPerRequest);
+}
+
+- (AWSTask<AWSDynamoDBBatchWriteItemOutput *> *)batchWriteItem:(AWSDynamoDBBatchWriteItemInput *)request {
+    NSUInteger itemCount = 0;
+    for (NSString *tableName in request.requestItems) {
+        itemCount += [request.requestItems[tableName] count];
+    }
+    return [self respond:itemCount block:^id {
+        __block NSUInteger remaining = [self processedCount:itemCount];
+        NSMutableDictionary *unprocessedItems = [NSMutableDictionary new];
+        [request.requestItems enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, NSArray<AWSDynamoDBWriteRequest *> *writeRequests, BOOL *stop) {
+            for (AWSDynamoDBWriteRequest *writeRequest in writeRequests) {
+                if (remaining == 0) {
+                    NSMutableArray *unprocessed = unprocessedItems[tableName] ?: [NSMutableArray new];
+                    [unprocessed addObject:writeRequest];
+                    unprocessedItems[tableName] = unprocessed;
+                    continue;
+                }
+                remaining--;
+                @synchronized(self->_items) {
+                    if (writeRequest.putRequest) {
+                        self->_items[writeRequest.putRequest.item[@"itemId"].S] = writeRequest.putRequest.item;
+                    } else {
+                        [self->_items removeObjectForKey:writeRequest.deleteRequest.key[@"itemId"].S];
+                    }
+                }
+            }
+        }];
+        AWSDynamoDBBatchWriteItemOutput *output = [AWSDynamoDBBatchWriteItemOutput new];
+        output.unprocessedItems = unprocessedItems;
+        return output;
+    }];
+}
+
+- (AWSTask<AWSDynamoDBBatchGetItemOutput *> *)batchGetItem:(AWSDynamoDBBatchGetItemInput *)request {
+    NSUInteger keyCount = 0;
+    for (NSString *tableName in request.requestItems) {
+        keyCount += [request.requestItems[tableName].keys count];
+    }
+    return [self respond:keyCount block:^id {
+        NSUInteger processedCount = [self processedCount:keyCount];
+        NSMutableDictionary *responses = [NSMutableDictionary new];
+        NSMutableDictionary *unprocessedKeys = [NSMutableDictionary new];
+        [request.requestItems enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, AWSDynamoDBKeysAndAttributes *keysAndAttributes, BOOL *stop) {
+            NSUInteger length = MIN(processedCount, [keysAndAttributes.keys count]);
+            NSMutableArray *items = [NSMutableArray new];
+            for (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *key in [keysAndAttributes.keys subarrayWithRange:NSMakeRange(0, length)]) {
+                NSDictionary *item = [self itemWithId:key[@"itemId"].S];
+                if (item) {
+                    [items addObject:item];
+                }
+            }
+            responses[tableName] = items;
+            if (length < [keysAndAttributes.keys count]) {
+                AWSDynamoDBKeysAndAttributes *unprocessed = [AWSDynamoDBKeysAndAttributes new];
+                unprocessed.keys = [keysAndAttributes.keys subarrayWithRange:NSMakeRange(length, [keysAndAttributes.keys count] - length)];
+                unprocessedKeys[tableName] = unprocessed;
+            }
+        }];
+        AWSDynamoDBBatchGetItemOutput *output = [AWSDynamoDBBatchGetItemOutput new];
+        output.responses = responses;
+        output.unprocessedKeys = unprocessedKeys;
+        return output;
+    }];
+}
+
+- (AWSTask<AWSDynamoDBScanOutput *> *)scan:(AWSDynamoDBScanInput *)request {
+    return [self respond:0 block:^id {
+        NSArray<NSString *> *itemIds = nil;
+        @synchronized(self->_items) {
+            itemIds = [[self->_items allKeys] sortedArrayUsingSelector:@selector(compare:)];
+        }
+
+        NSUInteger segment = [request.segment unsignedIntegerValue];
+        NSUInteger totalSegments = MAX([request.totalSegments unsignedIntegerValue], 1);
+        NSString *startId = request.exclusiveStartKey[@"itemId"].S;
+
+        NSMutableArray *items = [NSMutableArray new];
+        NSString *lastId = nil;
+        for (NSUInteger i = 0; i < [itemIds count]; i++) {
+            if (i % totalSegments != segment
+                || (startId && [itemIds[i] compare:startId] != NSOrderedDescending)) {
+                continue;
+            }
+            if ([items count] == self.scanPageSize) {
+                break;
+            }
+            lastId = itemIds[i];
+            [items addObject:[self itemWithId:lastId]];
+        }
+
+        AWSDynamoDBScanOutput *output = [AWSDynamoDBScanOutput new];
+        output.items = items;
+        if ([items count] == self.scanPageSize) {
+            AWSDynamoDBAttributeValue *lastKey = [AWSDynamoDBAttributeValue new];
+            lastKey.S = lastId;
+            output.lastEvaluatedKey = @{@"itemId" : lastKey};
+        }
+        return output;
+    }];
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperBatchTests : XCTestCase
+
+@property (nonatomic, strong) AWSDynamoDBObjectMapper *objectMapper;
+@property (nonatomic, strong) AWSDynamoDBLocalStandIn *standIn;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperBatchTests
+
+static NSString *const AWSDynamoDBBatchTestMapperKey = @"AWSDynamoDBObjectMapperBatchTests";
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:nil];
+    [AWSDynamoDBObjectMapper registerDynamoDBObjectMapperWithConfiguration:configuration
+                                                 objectMapperConfiguration:[AWSDynamoDBObjectMapperConfiguration new]
+                                                                    forKey:AWSDynamoDBBatchTestMapperKey];
+    self.objectMapper = [AWSDynamoDBObjectMapper DynamoDBObjectMapperForKey:AWSDynamoDBBatchTestMapperKey];
+    self.standIn = [[AWSDynamoDBLocalStandIn alloc] initWithConfiguration:configuration];
+    [self.objectMapper setValue:self.standIn forKey:@"dynamoDB"];
+}
+
+- (void)tearDown {
+    [AWSDynamoDBObjectMapper removeDynamoDBObjectMapperForKey:AWSDynamoDBBatchTestMapperKey];
+    [super tearDown];
+}
+
+- (NSArray<AWSDynamoDBBatchTestItem *> *)itemsWithCount:(NSUInteger)count {
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        AWSDynamoDBBatchTestItem *item = [AWSDynamoDBBatchTestItem new];
+        item.itemId = [NSString stringWithFormat:@"item-%05lu", (unsigned long)i];
+        item.value = @(i);
+        [items addObject:item];
+    }
+    return items;
+}
+
+- (void)testBatchSaveChunksRequests {
+    AWSTask *task = [self.objectMapper batchSave:[self itemsWithCount:260]];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([self.standIn itemCount], 260);
+    XCTAssertEqual(self.standIn.requestCount, 11);
+    XCTAssertEqual(self.standIn.largestRequest, 25);
+    XCTAssertEqualObjects([self.standIn itemWithId:@"item-00042"][@"value"].N, @"42");
+}
+
+- (void)testBatchSaveWritesTheLastModelForADuplicateKey {
+    NSArray<AWSDynamoDBBatchTestItem *> *items = [self itemsWithCount:2];
+    AWSDynamoDBBatchTestItem *duplicate = [AWSDynamoDBBatchTestItem new];
+    duplicate.itemId = items[0].itemId;
+    duplicate.value = @100;
+
+    AWSTask *task = [self.objectMapper batchSave:[items arrayByAddingObject:duplicate]];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual(self.standIn.largestRequest, 2);
+    XCTAssertEqualObjects([self.standIn itemWithId:items[0].itemId][@"value"].N, @"100");
+}
+
+- (void)testBatchSaveRetriesUnprocessedItems {
+    self.standIn.maxItemsPerRequest = 10;
+
+    AWSTask *task = [self.objectMapper batchSave:[self itemsWithCount:50]];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([self.standIn itemCount], 50);
+    // 2 chunks of 25, each written 10 at a time.
+    XCTAssertEqual(self.standIn.requestCount, 6);
+}
+
+- (void)testBatchSaveFailsWhenItemsStayUnprocessed {
+    self.standIn.rejectsAllItems = YES;
+
+    AWSTask *task = [self.objectMapper batchSave:[self itemsWithCount:3]];
+    [task waitUntilFinished];
+
+    XCTAssertEqualObjects(task.error.domain, AWSDynamoDBObjectMapperErrorDomain);
+    XCTAssertEqual(task.error.code, AWSDynamoDBObjectMapperErrorUnprocessedItems);
+    NSDictionary *unprocessedItems = task.error.userInfo[AWSDynamoDBObjectMapperUnprocessedItemsKey];
+    XCTAssertEqual([unprocessedItems[AWSDynamoDBBatchTestTable] count], 3);
+}
+
+- (void)testBatchLoadChunksAndRetries {
+    [[self.objectMapper batchSave:[self itemsWithCount:250]] waitUntilFinished];
+    self.standIn.requestCount = 0;
+    self.standIn.largestRequest = 0;
+    self.standIn.maxItemsPerRequest = 60;
+
+    NSMutableArray *keys = [NSMutableArray new];
+    for (AWSDynamoDBBatchTestItem *item in [self itemsWithCount:250]) {
+        AWSDynamoDBBatchTestItem *key = [AWSDynamoDBBatchTestItem new];
+        key.itemId = item.itemId;
+        [keys addObject:key];
+    }
+    AWSDynamoDBBatchTestItem *missing = [AWSDynamoDBBatchTestItem new];
+    missing.itemId = @"missing";
+    [keys addObject:missing];
+
+    AWSTask<NSArray *> *task = [self.objectMapper batchLoad:keys];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([task.result count], 250);
+    XCTAssertEqual(self.standIn.largestRequest, 100);
+    NSArray *values = [[task.result valueForKey:@"value"] sortedArrayUsingSelector:@selector(compare:)];
+    XCTAssertEqualObjects(values.firstObject, @0);
+    XCTAssertEqualObjects(values.lastObject, @249);
+}
+
+- (void)testBatchRemove {
+    NSArray *items = [self itemsWithCount:40];
+    [[self.objectMapper batchSave:items] waitUntilFinished];
+
+    AWSTask *task = [self.objectMapper batchRemove:[items subarrayWithRange:NSMakeRange(0, 30)]];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([self.standIn itemCount], 10);
+    XCTAssertNil([self.standIn itemWithId:@"item-00000"]);
+    XCTAssertNotNil([self.standIn itemWithId:@"item-00035"]);
+}
+
+- (void)testBatchOperationsBoundConcurrency {
+    self.standIn.latency = 2000;
+    AWSDynamoDBObjectMapperConfiguration *configuration = [AWSDynamoDBObjectMapperConfiguration new];
+    configuration.maxConcurrentRequests = 2;
+
+    AWSTask *task = [self.objectMapper batchSave:[self itemsWithCount:500]
+                                   configuration:configuration];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([self.standIn itemCount], 500);
+    XCTAssertLessThanOrEqual(self.standIn.maxConcurrentRequests, 2);
+}
+
+- (void)testParallelScanStreamsEverySegment {
+    [[self.objectMapper batchSave:[self itemsWithCount:335]] waitUntilFinished];
+    self.standIn.requestCount = 0;
+
+    NSMutableSet *itemIds = [NSMutableSet new];
+    __block NSUInteger pageCount = 0;
+    AWSTask *task = [self.objectMapper parallelScan:[AWSDynamoDBBatchTestItem class]
+                                         expression:[AWSDynamoDBScanExpression new]
+                                      totalSegments:8
+                                       itemsHandler:^(NSArray<AWSDynamoDBBatchTestItem *> *items) {
+        pageCount++;
+        XCTAssertLessThanOrEqual([items count], 10);
+        for (AWSDynamoDBBatchTestItem *item in items) {
+            XCTAssertTrue([item isKindOfClass:[AWSDynamoDBBatchTestItem class]]);
+            [itemIds addObject:item.itemId];
+        }
+    }];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual([itemIds count], 335);
+    XCTAssertGreaterThanOrEqual(pageCount, 34);
+    XCTAssertLessThanOrEqual(self.standIn.maxConcurrentRequests, 4);
+}
+
+- (void)testParallelScanRejectsZeroSegments {
+    AWSTask *task = [self.objectMapper parallelScan:[AWSDynamoDBBatchTestItem class]
+                                         expression:[AWSDynamoDBScanExpression new]
+                                      totalSegments:0
+                                       itemsHandler:^(NSArray *items) {
+        XCTFail(@"No page is expected.");
+    }];
+    [task waitUntilFinished];
+
+    XCTAssertEqualObjects(task.error.domain, AWSDynamoDBObjectMapperErrorDomain);
+    XCTAssertEqual(task.error.code, AWSDynamoDBObjectMapperErrorInvalidParameter);
+}
+
+#pragma mark - Paginated output iterator
+
+- (AWSDynamoDBPaginatedOutput *)scanWithItemCount:(NSUInteger)count {
+    [[self.objectMapper batchSave:[self itemsWithCount:count]] waitUntilFinished];
+    AWSTask<AWSDynamoDBPaginatedOutput *> *task = [self.objectMapper scan:[AWSDynamoDBBatchTestItem class]
+                                                               expression:[AWSDynamoDBScanExpression new]];
+    [task waitUntilFinished];
+    self.standIn.requestCount = 0;
+    return task.result;
+}
+
+- (void)waitForRequestCount:(NSUInteger)requestCount {
+    for (int i = 0; i < 200 && self.standIn.requestCount < requestCount; i++) {
+        [NSThread sleepForTimeInterval:0.01];
+    }
+    // Leave time for any request beyond the expected ones.
+    [NSThread sleepForTimeInterval:0.05];
+}
+
+- (void)testIteratorReturnsEveryPageInOrder {
+    AWSDynamoDBPaginatedOutputIterator *iterator = [[self scanWithItemCount:95] iteratorWithPrefetchPageCount:2];
+
+    NSMutableArray *itemIds = [NSMutableArray new];
+    NSUInteger pageCount = 0;
+    while (YES) {
+        AWSTask<NSArray *> *task = [iterator nextPage];
+        [task waitUntilFinished];
+        XCTAssertNil(task.error);
+        if (!task.result) {
+            break;
+        }
+        pageCount++;
+        [itemIds addObjectsFromArray:[task.result valueForKey:@"itemId"]];
+    }
+
+    XCTAssertEqual(pageCount, 10);
+    XCTAssertEqual([itemIds count], 95);
+    XCTAssertEqualObjects(itemIds, [itemIds sortedArrayUsingSelector:@selector(compare:)]);
+}
+
+- (void)testIteratorReadsAheadUpToThePrefetchPageCount {
+    AWSDynamoDBPaginatedOutputIterator *iterator = [[self scanWithItemCount:100] iteratorWithPrefetchPageCount:3];
+
+    [[iterator nextPage] waitUntilFinished];
+    [self waitForRequestCount:3];
+    XCTAssertEqual(self.standIn.requestCount, 3);
+
+    [[iterator nextPage] waitUntilFinished];
+    [self waitForRequestCount:4];
+    XCTAssertEqual(self.standIn.requestCount, 4);
+}
+
+- (void)testIteratorStopsReadingAheadAtTheItemLimit {
+    AWSDynamoDBPaginatedOutputIterator *iterator = [[self scanWithItemCount:100] iteratorWithPrefetchPageCount:5];
+    iterator.maxBufferedItems = 10;
+
+    [[iterator nextPage] waitUntilFinished];
+    [self waitForRequestCount:1];
+    XCTAssertEqual(self.standIn.requestCount, 1);
+}
+
+- (void)testIteratorWithoutPrefetchFetchesOnDemand {
+    AWSDynamoDBPaginatedOutputIterator *iterator = [[self scanWithItemCount:30] iteratorWithPrefetchPageCount:0];
+
+    [[iterator nextPage] waitUntilFinished];
+    [self waitForRequestCount:1];
+    XCTAssertEqual(self.standIn.requestCount, 0);
+
+    AWSTask<NSArray *> *task = [iterator nextPage];
+    [task waitUntilFinished];
+    XCTAssertEqual([task.result count], 10);
+    XCTAssertEqual(self.standIn.requestCount, 1);
+}
+
+- (void)testEnumeratePagesStopsWhenAsked {
+    AWSDynamoDBPaginatedOutputIterator *iterator = [[self scanWithItemCount:100] iteratorWithPrefetchPageCount:2];
+
+    __block NSUInteger pageCount = 0;
+    AWSTask *task = [iterator enumeratePagesUsingBlock:^(NSArray *items, BOOL *stop) {
+        XCTAssertFalse([NSThread isMainThread]);
+        pageCount++;
+        *stop = (pageCount == 3);
+    }];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual(pageCount, 3);
+    AWSTask *nextPage = [iterator nextPage];
+    [nextPage waitUntilFinished];
+    XCTAssertNil(nextPage.result);
+}
+
+- (void)testIteratorPrefetchPerformance {
+    AWSDynamoDBPaginatedOutput *paginatedOutput = [self scanWithItemCount:500];
+    self.standIn.latency = 2000;
+
+    [self measureBlock:^{
+        __block NSUInteger count = 0;
+        [[[paginatedOutput iteratorWithPrefetchPageCount:2] enumeratePagesUsingBlock:^(NSArray *items, BOOL *stop) {
+            // Simulates work on each page that is about as slow as fetching it.
+            usleep(2000);
+            count += [items count];
+        }] waitUntilFinished];
+        XCTAssertEqual(count, 500);
+    }];
+}
+
+- (void)testBatchSaveAndParallelScanPerformance {
+    self.standIn.latency = 1000;
+    self.standIn.scanPageSize = 100;
+    NSArray *items = [self itemsWithCount:5000];
+
+    [self measureBlock:^{
+        [[self.objectMapper batchSave:items] waitUntilFinished];
+
+        __block NSUInteger count = 0;
+        [[self.objectMapper parallelScan:[AWSDynamoDBBatchTestItem class]
+                              expression:[AWSDynamoDBScanExpression new]
+                           totalSegments:4
+                            itemsHandler:^(NSArray *page) {
+            count += [page count];
+        }] waitUntilFinished];
+        XCTAssertEqual(count, 5000);
+    }];
+}
+
+@end
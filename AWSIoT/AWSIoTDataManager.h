@@ -16,6 +16,7 @@
 #import "AWSIoTDataService.h"
 #import "AWSIoTService.h"
 #import "AWSIoTMQTTTypes.h"
+#import "AWSIoTMQTTDeliveryConfiguration.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -108,6 +109,26 @@ NS_ASSUME_NONNULL_BEGIN
  **/
 @property(nonatomic, assign, readonly) NSUInteger publishRetryThrottle;
 
+/**
+ The max number of QoS 1 and QoS 2 publishes awaiting acknowledgement. Further publishes are held, in order, until
+ an acknowledgement frees a slot. Default value: 0, which means unlimited.
+ **/
+@property(nonatomic, assign) NSUInteger maxInflightPublishes;
+
+/**
+ The location of a SQLite file in which unacknowledged QoS 1 and QoS 2 publishes are kept. When set, messages that were not
+ acknowledged before the app was terminated are published again, with the DUP flag set, the next time the same
+ client ID connects. Default value: nil, which keeps unacknowledged publishes in memory only.
+ **/
+@property(nonatomic, copy, nullable) NSURL *outboxFileURL;
+
+/**
+ How received messages are queued and handed to subscription callbacks: the size of the queue, what happens when it
+ is full, the size of the batches passed to batch callbacks and how many subscriptions are delivered to at once.
+ Default value: an `AWSIoTMQTTDeliveryConfiguration` with its default values.
+ **/
+@property(nonatomic, copy) AWSIoTMQTTDeliveryConfiguration *deliveryConfiguration;
+
 /**
  MQTT username used to construct the MQTT username field for enhanced custom authentication use case:
  https://docs.aws.amazon.com/iot/latest/developerguide/enhanced-custom-auth-using.html#enhanced-custom-auth-using-mqtt
@@ -745,6 +766,47 @@ DEPRECATED_MSG_ATTRIBUTE("Use `updateUserMetaData` for updating the user meta da
             fullCallback:(AWSIoTMQTTFullMessageBlock)callback
              ackCallback:(nullable AWSIoTMQTTAckBlock)ackCallback;
 
+/**
+ Subscribes to a topic at a specific QoS level, receiving its messages in batches
+
+ @param topic The Topic to subscribe to.
+
+ @param qos Specifies the QoS Level of the subscription: AWSIoTMQTTQoSAtMostOnce or AWSIoTMQTTQoSAtLeastOnce
+
+ @param callback Reference to AWSIoTMQTTBatchMessageBlock. It is invoked with the messages received since its previous
+ invocation, in order, up to `AWSIoTMQTTDeliveryConfiguration.maximumBatchSize` at a time.
+
+ @param ackCallback the callback for ack if QoS > 0.
+
+ @return Boolean value indicating success or failure.
+
+ */
+- (BOOL)subscribeToTopic:(NSString *)topic
+                     QoS:(AWSIoTMQTTQoS)qos
+           batchCallback:(AWSIoTMQTTBatchMessageBlock)callback
+             ackCallback:(nullable AWSIoTMQTTAckBlock)ackCallback;
+
+/**
+ Sets the priority of a subscription. When the messages of several subscriptions are waiting, those of higher priority
+ subscriptions are delivered first, and those of lower priority subscriptions are dropped first when the delivery queue
+ is full.
+
+ @param priority The subscription's priority. Subscriptions have AWSIoTMQTTDeliveryPriorityDefault unless set.
+
+ @param topic The Topic the subscription was made with.
+
+ */
+- (void)setDeliveryPriority:(AWSIoTMQTTDeliveryPriority)priority
+                   forTopic:(NSString *)topic;
+
+/**
+ Returns a snapshot of the queue of received messages waiting to be delivered to subscription callbacks.
+
+ @return The queue depth and the delivery counters and lag since the data manager was created.
+
+ */
+- (AWSIoTMQTTDeliveryMetrics *)deliveryMetrics;
+
 /**
  Unsubscribes from a topic
 
@@ -798,6 +860,9 @@ enableStaleDiscards: BOOL, set to NO to disable discarding stale updates (defaul
 enableIgnoreDeltas: BOOL, set to YES to disable delta updates (default NO)
 QoS: AWSIoTMQTTQoS (default AWSIoTMQTTQoSMessageDeliveryAttemptedAtMostOnce)
 shadowOperationTimeoutSeconds: double, device shadow operation timeout (default 10.0)
+enableDocumentCache: BOOL, set to YES to keep a local copy of the shadow document, see `cachedDocumentForShadow:` (default NO)
+maxPendingOperations: unsigned, number of operations that may await a response at once; responses are matched by client token, and with versioning each pending update expects the version following the previous one (default 1)
+updateCoalescingSeconds: double, merge updates made within this interval into one publish; every client token given to a merged update is called back with the result of the publish (default 0, disabled)
  
  @param callback The function to call when updates are received for the device shadow.
  
@@ -822,6 +887,9 @@ enableStaleDiscards: BOOL, set to NO to disable discarding stale updates (defaul
 enableIgnoreDeltas: BOOL, set to YES to disable delta updates (default NO)
 QoS: AWSIoTMQTTQoS (default AWSIoTMQTTQoSMessageDeliveryAttemptedAtMostOnce)
 shadowOperationTimeoutSeconds: double, device shadow operation timeout (default 10.0)
+enableDocumentCache: BOOL, set to YES to keep a local copy of the shadow document, see `cachedDocumentForShadow:` (default NO)
+maxPendingOperations: unsigned, number of operations that may await a response at once; responses are matched by client token, and with versioning each pending update expects the version following the previous one (default 1)
+updateCoalescingSeconds: double, merge updates made within this interval into one publish; every client token given to a merged update is called back with the result of the publish (default 0, disabled)
 
  @param callback The function to call when updates are received for the device shadow.
 
@@ -938,6 +1006,19 @@ shadowOperationTimeoutSeconds: double, device shadow operation timeout (default
 - (BOOL) deleteShadow:(NSString *)name
           clientToken:(NSString * _Nullable)clientToken;
 
+/**
+ Get the locally cached copy of a device shadow document
+ 
+ The cache is kept current from the accepted, delta and documents messages of a shadow registered with the
+ `enableDocumentCache` option, so the desired and reported state can be read without a get operation.
+ 
+ @param name The device shadow to read.
+ 
+ @return A dictionary with `state` and `version` keys, or nil if the shadow is unknown or nothing has been received yet.
+ 
+ */
+- (nullable NSDictionary<NSString *, id> *) cachedDocumentForShadow:(NSString *)name;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -19,22 +19,24 @@
 #import "AWSSynchronizedMutableDictionary.h"
 #import "AWSIoTModel.h"
 #import "AWSCocoaLumberjack.h"
+#import "AWSIoTShadowDocument.h"
 #import <stdatomic.h>
 
-@interface AWSIoTDataShadowModel : AWSMTLModel <AWSMTLJSONSerializing>
+@interface AWSIoTDataShadowOperation : NSObject
 
-@property (nonatomic, copy) NSString *clientToken;
-@property (nonatomic, copy) NSString *version;
+@property (nonatomic, strong) NSString *shadowName;
+@property (nonatomic, strong) NSString *clientToken;
+@property (nonatomic, assign) AWSIoTShadowOperationType operation;
+@property (nonatomic, strong) NSTimer *timer;
+// The version an update was published with, or 0 if it was published without one.
+@property (nonatomic, assign) UInt32 version;
+// Client tokens of coalesced updates that were merged into this one. They complete with its result.
+@property (nonatomic, strong) NSArray<NSString *> *supersededClientTokens;
 
 @end
 
-@implementation AWSIoTDataShadowModel
-+ (NSDictionary *)JSONKeyPathsByPropertyKey {
-    return @{
-             @"clientToken" : @"clientToken",
-             @"version" : @"version"
-             };
-}
+@implementation AWSIoTDataShadowOperation
+
 @end
 
 @interface AWSIoTDataShadow:NSObject
@@ -48,14 +50,30 @@
 @property(atomic, assign) BOOL enableStaleDiscards;
 @property(atomic, assign) BOOL enableIgnoreDeltas;
 @property(atomic, assign) BOOL enableIgnoreDocuments;
+@property(atomic, assign) BOOL enableDocumentCache;
 @property(atomic, assign) UInt32 version;
-@property(nonatomic, strong) NSString *clientToken;
+@property(atomic, strong) NSString *clientToken;
 @property(atomic, assign) AWSIoTMQTTQoS qos;
 @property(nonatomic, strong) NSMutableArray* topics;
 @property(nonatomic, strong) void(^callback)(NSString *name, AWSIoTShadowOperationType operation, AWSIoTShadowOperationStatusType status, NSString *clientToken, NSData *payload);
-@property(nonatomic, strong) NSTimer *timer;
 @property(atomic, assign) NSTimeInterval operationTimeout;
-@property(atomic, assign) AWSIoTShadowOperationType operation;
+//
+// Operations awaiting an accepted or rejected response, keyed by client token. Guarded by @synchronized(shadow).
+//
+@property(nonatomic, strong) NSMutableDictionary<NSString *, AWSIoTDataShadowOperation *> *pendingOperations;
+@property(atomic, assign) NSUInteger maxPendingOperations;
+//
+// Updates made within updateCoalescingInterval of each other are merged into coalescedState and
+// published together. Guarded by @synchronized(shadow).
+//
+@property(atomic, assign) NSTimeInterval updateCoalescingInterval;
+@property(nonatomic, strong) NSMutableDictionary *coalescedState;
+@property(nonatomic, strong) NSMutableArray<NSString *> *coalescedClientTokens;
+@property(nonatomic, strong) NSTimer *coalescingTimer;
+//
+// Local copy of the shadow document when enableDocumentCache is set. Guarded by @synchronized(shadow).
+//
+@property(nonatomic, strong) AWSIoTShadowDocument *document;
 @end
 
 @implementation AWSIoTDataShadow
@@ -69,7 +87,7 @@
 
 - (void)dealloc
 {
-    [self.timer invalidate];
+    [self invalidateTimers];
 }
 
 - (instancetype)initWithName:(NSString *)name
@@ -91,19 +109,35 @@
         _enableIgnoreDeltas = enableIgnoreDeltas;
         _enableIgnoreDocuments = enableIgnoreDocuments;
         _enableForeignStateUpdateNotifications = enableForeignStateUpdateNotifications;
+        _enableDocumentCache = NO;
         _callback = callback;
         _operationTimeout = operationTimeoutSeconds;
         _qos = qos;
         _version = 0;
         _topics = [NSMutableArray new];
-        _timer = nil;
         _clientToken = nil;
-        _operation = AWSIoTShadowOperationTypeNone;
+        _pendingOperations = [NSMutableDictionary new];
+        _maxPendingOperations = 1;
+        _updateCoalescingInterval = 0;
+        _document = [AWSIoTShadowDocument new];
     }
 
     return self;
 }
 
+- (void)invalidateTimers {
+    @synchronized(self) {
+        for (AWSIoTDataShadowOperation *pendingOperation in [self.pendingOperations allValues]) {
+            [pendingOperation.timer invalidate];
+        }
+        [self.pendingOperations removeAllObjects];
+        [self.coalescingTimer invalidate];
+        self.coalescingTimer = nil;
+        self.coalescedState = nil;
+        self.coalescedClientTokens = nil;
+    }
+}
+
 @end
 
 static NSString *const AWSInfoIoTDataManager = @"IoTDataManager";
@@ -172,6 +206,7 @@ static NSString *const AWSInfoIoTDataManager = @"IoTDataManager";
         _autoResubscribe = ars;
         _lastWillAndTestament = lwt;
         _publishRetryThrottle = 100; //Default to 100 if not specified.
+        _deliveryConfiguration = [AWSIoTMQTTDeliveryConfiguration new];
         AWSDDLogInfo(@"Initializing AWSIoTMqttConfiguration with KeepAlive:%f, baseReconnectTime:%f,"
                      "minimumConnectionTime:%f, maximumReconnectTime:%f, autoResubscribe:%@, lwt topic:%@ message:%@ ",
                      _keepAliveTimeInterval, _baseReconnectTimeInterval, _minimumConnectionTimeInterval,
@@ -201,6 +236,7 @@ static NSString *const AWSInfoIoTDataManager = @"IoTDataManager";
         _autoResubscribe = ars;
         _lastWillAndTestament = lwt;
         _publishRetryThrottle = prt;
+        _deliveryConfiguration = [AWSIoTMQTTDeliveryConfiguration new];
         AWSDDLogInfo(@"Initializing AWSIoTMqttConfiguration with KeepAlive:%f, baseReconnectTime:%f,"
                      "minimumConnectionTime:%f, maximumReconnectTime:%f, autoResubscribe:%@, lwt topic:%@ message:%@ ",
                      _keepAliveTimeInterval, _baseReconnectTimeInterval, _minimumConnectionTimeInterval,
@@ -463,6 +499,9 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     [self.mqttClient setMaximumReconnectTime:self.mqttConfiguration.maximumReconnectTimeInterval];
     [self.mqttClient setAutoResubscribe:self.mqttConfiguration.autoResubscribe];
     [self.mqttClient setPublishRetryThrottle:self.mqttConfiguration.publishRetryThrottle];
+    [self.mqttClient setMaxInflightPublishes:self.mqttConfiguration.maxInflightPublishes];
+    [self.mqttClient setOutboxFileURL:self.mqttConfiguration.outboxFileURL];
+    [self.mqttClient setDeliveryConfiguration:self.mqttConfiguration.deliveryConfiguration];
     [self.mqttClient setAutoResubscribe:self.mqttConfiguration.autoResubscribe];
     
     return [self.mqttClient connectWithClientId:clientId
@@ -502,6 +541,9 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     [self.mqttClient setMaximumReconnectTime:self.mqttConfiguration.maximumReconnectTimeInterval];
     [self.mqttClient setAutoResubscribe:self.mqttConfiguration.autoResubscribe];
     [self.mqttClient setPublishRetryThrottle:self.mqttConfiguration.publishRetryThrottle];
+    [self.mqttClient setMaxInflightPublishes:self.mqttConfiguration.maxInflightPublishes];
+    [self.mqttClient setOutboxFileURL:self.mqttConfiguration.outboxFileURL];
+    [self.mqttClient setDeliveryConfiguration:self.mqttConfiguration.deliveryConfiguration];
     [self.mqttClient setAutoResubscribe:self.mqttConfiguration.autoResubscribe];
     
     return [self.mqttClient connectWithClientId:clientId
@@ -543,6 +585,9 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     [self.mqttClient setMaximumReconnectTime:self.mqttConfiguration.maximumReconnectTimeInterval];
     [self.mqttClient setAutoResubscribe:self.mqttConfiguration.autoResubscribe];
     [self.mqttClient setPublishRetryThrottle:self.mqttConfiguration.publishRetryThrottle];
+    [self.mqttClient setMaxInflightPublishes:self.mqttConfiguration.maxInflightPublishes];
+    [self.mqttClient setOutboxFileURL:self.mqttConfiguration.outboxFileURL];
+    [self.mqttClient setDeliveryConfiguration:self.mqttConfiguration.deliveryConfiguration];
     [self.mqttClient setAutoResubscribe:self.mqttConfiguration.autoResubscribe];
 
     return [self.mqttClient connectWithClientId:clientId
@@ -759,6 +804,37 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     return YES;
 }
 
+- (BOOL)subscribeToTopic:(NSString *)topic
+                     QoS:(AWSIoTMQTTQoS)qos
+           batchCallback:(AWSIoTMQTTBatchMessageBlock)callback
+             ackCallback:(AWSIoTMQTTAckBlock)ackCallback {
+    if (topic == nil || [topic isEqualToString:@""]) {
+        return NO;
+    }
+    if ( !_userDidIssueConnect || _userDidIssueDisconnect ) {
+        //Have to be connected to make this call. Return NO to indicate failure
+        return NO;
+    }
+
+    [self.mqttClient subscribeToTopic:topic
+                                  qos:qos
+                        batchCallback:callback
+                          ackCallback:ackCallback];
+    return YES;
+}
+
+- (void)setDeliveryPriority:(AWSIoTMQTTDeliveryPriority)priority
+                   forTopic:(NSString *)topic {
+    if (topic == nil || [topic isEqualToString:@""]) {
+        return;
+    }
+    [self.mqttClient setDeliveryPriority:priority forTopic:topic];
+}
+
+- (AWSIoTMQTTDeliveryMetrics *)deliveryMetrics {
+    return [self.mqttClient deliveryMetrics];
+}
+
 - (void)unsubscribeTopic:(NSString *)topic {
     if (topic == nil || [topic isEqualToString:@""]) {
         return;
@@ -973,24 +1049,18 @@ static NSString * const AWSIoTShadowOperationStatusTypeStrings[] = {
     AWSDDLogInfo(@"handle messages for shadow:%@, operation:%ld, status:%ld",
                  name, (long)operation, (long)status);
     BOOL rc = NO;
-    NSError *error;
-    NSDictionary *jsonDictionary = [NSJSONSerialization JSONObjectWithData:payload options:NSJSONReadingMutableContainers error:&error];
-    if (jsonDictionary == nil){
-        AWSDDLogError(@"Failed to deserialize payload into json dictionanry. Error:%@",
-                      [error localizedDescription]);
+    //
+    // Only the version and client token are needed to route the message, so
+    // scan for them instead of parsing the whole document.
+    //
+    NSNumber *version = nil;
+    NSString *clientToken = nil;
+    if (!AWSIoTShadowScanPayload(payload, &version, &clientToken)) {
+        AWSDDLogError(@"Failed to scan payload of shadow (%@) as a json object.", name);
         return rc;
     }
 
-    AWSDDLogDebug(@"Successfully deserialized payload into json data: %@", [jsonDictionary description]);
-
-    AWSIoTDataShadowModel *shadowModel = [AWSMTLJSONAdapter modelOfClass:AWSIoTDataShadowModel.class
-                                                      fromJSONDictionary:jsonDictionary
-                                                                   error:&error];
-
-    if (shadowModel == nil) {
-        AWSDDLogError(@"error serializing json for shadow (%@): %@", name, error.localizedDescription);
-        return rc;
-    }
+    AWSDDLogDebug(@"Scanned shadow payload. version: %@, clientToken: %@", version, clientToken);
     //
     // Update the thing version on every accepted or delta message which
     // contains it.
@@ -999,8 +1069,8 @@ static NSString * const AWSIoTShadowOperationStatusTypeStrings[] = {
 
     rc = YES;
 
-    if ((shadowModel.version != nil) && (status != AWSIoTShadowOperationStatusTypeRejected)) {
-        UInt32 versionNumber = (UInt32)[shadowModel.version integerValue];
+    if ((version != nil) && (status != AWSIoTShadowOperationStatusTypeRejected)) {
+        UInt32 versionNumber = (UInt32)[version unsignedIntegerValue];
         //
         // The shadow version is incremented by AWS IoT and should always increase.
         // Do not update our local version if the received version is less than
@@ -1033,6 +1103,10 @@ static NSString * const AWSIoTShadowOperationStatusTypeStrings[] = {
         }
     }
 
+    if (shadow.enableDocumentCache == YES && status != AWSIoTShadowOperationStatusTypeRejected) {
+        [self updateDocumentOfShadow:shadow operation:operation status:status payload:payload];
+    }
+
     //
     // If this is a 'delta' or 'documents' message, call the user's callback
     //
@@ -1045,12 +1119,19 @@ static NSString * const AWSIoTShadowOperationStatusTypeStrings[] = {
         // only accepted/rejected messages past this point
         // ===============================================
         // If this is an unkown clientToken (e.g., it doesn't have a corresponding
-        // timeout), the shadow has been modified by another client.  If it's an
-        // update/accepted or delete/accepted, call the user's callback if they've
-        // requested foreign state update notifications.
+        // pending operation), the shadow has been modified by another client.  If
+        // it's an update/accepted or delete/accepted, call the user's callback if
+        // they've requested foreign state update notifications.
         //
-        if ((shadow.timer == nil) || ![shadowModel.clientToken isEqualToString:shadow.clientToken]) {
-            AWSDDLogDebug(@" timer is nil or shadow token mismatch.");
+        AWSIoTDataShadowOperation *pendingOperation = nil;
+        if (clientToken != nil) {
+            @synchronized(shadow) {
+                pendingOperation = shadow.pendingOperations[clientToken];
+                [shadow.pendingOperations removeObjectForKey:clientToken];
+            }
+        }
+        if (pendingOperation == nil) {
+            AWSDDLogDebug(@"no pending operation for client token (%@).", clientToken);
             if (status == AWSIoTShadowOperationStatusTypeAccepted &&
                 operation != AWSIoTShadowOperationTypeGet &&
                 shadow.enableForeignStateUpdateNotifications == YES) {
@@ -1063,20 +1144,72 @@ static NSString * const AWSIoTShadowOperationStatusTypeStrings[] = {
         }
         else {
             //
-            // This is a response to our operation.  Cancel the operation timeout.
+            // This is a response to one of our operations.  Cancel its timeout.
             //
-            [shadow.timer invalidate];
-            shadow.timer = nil;
+            [pendingOperation.timer invalidate];
+            pendingOperation.timer = nil;
             //
-            // Invoke the user's callback.
+            // Invoke the user's callback, once for the operation and once for each
+            // coalesced update it superseded.
             //
-            shadow.callback( shadow.name, operation, status, shadowModel.clientToken, payload );
+            shadow.callback( shadow.name, operation, status, clientToken, payload );
+            for (NSString *supersededClientToken in pendingOperation.supersededClientTokens) {
+                shadow.callback( shadow.name, operation, status, supersededClientToken, payload );
+            }
         }
     }
 
     return rc;
 }
 
+- (void)updateDocumentOfShadow:(AWSIoTDataShadow *)shadow
+                     operation:(AWSIoTShadowOperationType)operation
+                        status:(AWSIoTShadowOperationStatusType)status
+                       payload:(NSData *)payload {
+    if (operation == AWSIoTShadowOperationTypeDelete) {
+        @synchronized(shadow) {
+            [shadow.document clear];
+        }
+        return;
+    }
+
+    NSError *error = nil;
+    NSDictionary *jsonDictionary = [NSJSONSerialization JSONObjectWithData:payload options:NSJSONReadingMutableContainers error:&error];
+    if (![jsonDictionary isKindOfClass:[NSDictionary class]]) {
+        AWSDDLogError(@"Failed to deserialize payload of shadow (%@) into json dictionary. Error:%@",
+                      shadow.name, [error localizedDescription]);
+        return;
+    }
+
+    @synchronized(shadow) {
+        if (status == AWSIoTShadowOperationStatusTypeDelta) {
+            [shadow.document mergeDelta:jsonDictionary];
+        }
+        else if (status == AWSIoTShadowOperationStatusTypeDocuments) {
+            if ([jsonDictionary[@"current"] isKindOfClass:[NSDictionary class]]) {
+                [shadow.document replaceWithDocument:jsonDictionary[@"current"]];
+            }
+        }
+        else if (operation == AWSIoTShadowOperationTypeGet) {
+            [shadow.document replaceWithDocument:jsonDictionary];
+        }
+        else if (operation == AWSIoTShadowOperationTypeUpdate) {
+            [shadow.document mergeUpdate:jsonDictionary];
+        }
+    }
+}
+
+- (NSDictionary<NSString *, id> *)cachedDocumentForShadow:(NSString *)name {
+    AWSIoTDataShadow *shadow = [self.shadows objectForKey:name];
+    if (shadow == nil) {
+        AWSDDLogError(@"no shadow named: %@", name);
+        return nil;
+    }
+    @synchronized(shadow) {
+        return [shadow.document snapshot];
+    }
+}
+
 static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, NSData *data) = ^(NSObject *mqttClient, NSString *topic, NSData *data) {
     AWSIoTDataManager *iotDataManager = (AWSIoTDataManager *)(((AWSIoTMQTTClient *)mqttClient).associatedObject);
     //
@@ -1145,87 +1278,124 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
 }
 
 - (void) shadowOperationTimeoutOnTimer:(NSTimer *)timer {
-    NSString *shadowName = (NSString *)[timer userInfo];
-    AWSIoTDataShadow *shadow = [self.shadows objectForKey:shadowName];
-    
-    //
-    // Notify the user's application of the timeout.
-    //
-    NSString* str = @"timeout";
-    NSData* payloadData = [str dataUsingEncoding:NSUTF8StringEncoding];
-    
-    shadow.callback( shadow.name, shadow.operation, AWSIoTShadowOperationStatusTypeTimeout, shadow.clientToken, payloadData );
+    AWSIoTDataShadowOperation *pendingOperation = (AWSIoTDataShadowOperation *)[timer userInfo];
+    AWSIoTDataShadow *shadow = [self.shadows objectForKey:pendingOperation.shadowName];
+
     //
-    // Indicate that no operation is currently active.
+    // Remove the operation unless a response has already completed it.
     //
-    shadow.operation = AWSIoTShadowOperationTypeNone;
+    BOOL timedOut = NO;
+    @synchronized(shadow) {
+        if (shadow.pendingOperations[pendingOperation.clientToken] == pendingOperation) {
+            [shadow.pendingOperations removeObjectForKey:pendingOperation.clientToken];
+            timedOut = YES;
+        }
+    }
     //
     // Delete the operation timer
     //
-    [shadow.timer invalidate];
-    shadow.timer = nil;
+    [pendingOperation.timer invalidate];
+    pendingOperation.timer = nil;
+
+    if (timedOut) {
+        //
+        // Notify the user's application of the timeout.
+        //
+        NSString* str = @"timeout";
+        NSData* payloadData = [str dataUsingEncoding:NSUTF8StringEncoding];
+
+        shadow.callback( shadow.name, pendingOperation.operation, AWSIoTShadowOperationStatusTypeTimeout, pendingOperation.clientToken, payloadData );
+        for (NSString *supersededClientToken in pendingOperation.supersededClientTokens) {
+            shadow.callback( shadow.name, pendingOperation.operation, AWSIoTShadowOperationStatusTypeTimeout, supersededClientToken, payloadData );
+        }
+    }
 }
 
 - (BOOL) operationWithShadow:(NSString *)name
                    operation:(AWSIoTShadowOperationType)operation
              stateDictionary:(NSMutableDictionary *)stateDictionary {
+    return [self operationWithShadow:name operation:operation stateDictionary:stateDictionary supersededClientTokens:nil];
+}
+
+- (BOOL) operationWithShadow:(NSString *)name
+                   operation:(AWSIoTShadowOperationType)operation
+             stateDictionary:(NSMutableDictionary *)stateDictionary
+      supersededClientTokens:(NSArray<NSString *> *)supersededClientTokens {
     AWSIoTDataShadow *shadow = [self.shadows objectForKey:name];
     BOOL rc = NO;
     
     if (shadow != nil) {
-        //
-        // Don't allow a new operation if an existing one is still in progress.
-        //
-        if (shadow.timer == nil) {
-            NSString *publishTopic;
-            
+        NSString *publishTopic;
+        NSData *publishData;
+
+        @synchronized(shadow) {
+            //
+            // Don't allow a new operation once maxPendingOperations are in progress.
+            //
+            if ([shadow.pendingOperations count] >= MAX(shadow.maxPendingOperations, 1)) {
+                AWSDDLogInfo(@"operation still in progress on shadow (%@)", name);
+                return rc;
+            }
             //
             // Starting a new operation; if not provided, construct a clientToken from
             // the clientId and a rolling operation count.  Client tokens are transmitted
             // in all published state objects, and are returned to the caller along with
             // the status for each operation.  Applications can use client token values
             // to correlate received responses or timeouts with the original operations.
+            // Responses are matched to pending operations by their client token.
             //
             if ([stateDictionary objectForKey:@"clientToken"] == nil) {
                 [stateDictionary setValue:[self generateClientToken] forKey:@"clientToken"];
             }
+            NSString *clientToken = [stateDictionary objectForKey:@"clientToken"];
+            if (shadow.pendingOperations[clientToken] != nil) {
+                AWSDDLogError(@"an operation with client token (%@) is already in progress on shadow (%@)", clientToken, name);
+                return rc;
+            }
             publishTopic = [self.class buildTopicForShadow:name operation:operation];
 
             //
-            // Set the current operation type and client token for this shadow.
+            // Track the operation and remember the client token for this shadow.
             //
-            shadow.operation = operation;
-            shadow.clientToken = [stateDictionary objectForKey:@"clientToken"];
-            
+            AWSIoTDataShadowOperation *pendingOperation = [AWSIoTDataShadowOperation new];
+            pendingOperation.shadowName = name;
+            pendingOperation.clientToken = clientToken;
+            pendingOperation.operation = operation;
+            pendingOperation.supersededClientTokens = supersededClientTokens;
+            shadow.clientToken = clientToken;
+
             //
             // Start the shadow operation timer.
             //
-            shadow.timer = [NSTimer timerWithTimeInterval:shadow.operationTimeout
-                                                   target:self
-                                                 selector:@selector(shadowOperationTimeoutOnTimer:)
-                                                 userInfo:name
-                                                  repeats:NO];
-            [[NSRunLoop mainRunLoop] addTimer:shadow.timer forMode:NSRunLoopCommonModes];
+            pendingOperation.timer = [NSTimer timerWithTimeInterval:shadow.operationTimeout
+                                                             target:self
+                                                           selector:@selector(shadowOperationTimeoutOnTimer:)
+                                                           userInfo:pendingOperation
+                                                            repeats:NO];
+            [[NSRunLoop mainRunLoop] addTimer:pendingOperation.timer forMode:NSRunLoopCommonModes];
+            shadow.pendingOperations[clientToken] = pendingOperation;
             //
             // Add the version number (if known and versioning is enabled) and
-            // client token properties to the state dictionary.
+            // client token properties to the state dictionary.  Each accepted
+            // update increments the version, so an operation sent while updates
+            // are pending expects the version that follows the last of them.
             //
             if ((shadow.version > 0) && (shadow.enableVersioning == YES)) {
-                [stateDictionary setValue:[NSNumber numberWithInteger:shadow.version] forKey:@"version"];
+                UInt32 expectedVersion = [self expectedVersionOfShadow:shadow];
+                if (operation == AWSIoTShadowOperationTypeUpdate) {
+                    pendingOperation.version = expectedVersion;
+                }
+                [stateDictionary setValue:[NSNumber numberWithUnsignedInt:expectedVersion] forKey:@"version"];
             }
-            
-            NSError *error;
-            NSData *publishData = [NSJSONSerialization dataWithJSONObject:stateDictionary options:0 error:&error];
-            
-            [self publishData:publishData onTopic:publishTopic QoS:shadow.qos];
-
-            AWSDDLogInfo(@"published (%@) on topic (%@)", [[NSString alloc] initWithData:publishData encoding:NSUTF8StringEncoding], publishTopic);
 
+            NSError *error;
+            publishData = [NSJSONSerialization dataWithJSONObject:stateDictionary options:0 error:&error];
             rc = shadow.clientToken != nil;      // return the client token to the caller
         }
-        else {
-            AWSDDLogInfo(@"operation still in progress on shadow (%@)", name);
-        }
+
+        [self publishData:publishData onTopic:publishTopic QoS:shadow.qos];
+
+        AWSDDLogInfo(@"published (%@) on topic (%@)", [[NSString alloc] initWithData:publishData encoding:NSUTF8StringEncoding], publishTopic);
     }
     else {
         AWSDDLogError(@"attempting to (%@) unknown shadow (%@)", [[self.class operationTypeStrings] objectAtIndex:operation], name);
@@ -1233,6 +1403,91 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
     return rc;
 }
 
+// Must be called while synchronized on the shadow.
+- (UInt32) expectedVersionOfShadow:(AWSIoTDataShadow *)shadow {
+    UInt32 expectedVersion = shadow.version;
+    for (AWSIoTDataShadowOperation *pendingOperation in [shadow.pendingOperations allValues]) {
+        if (pendingOperation.version >= expectedVersion) {
+            expectedVersion = pendingOperation.version + 1;
+        }
+    }
+    return expectedVersion;
+}
+
+- (BOOL) coalesceUpdateWithShadow:(AWSIoTDataShadow *)shadow
+                  stateDictionary:(NSMutableDictionary *)stateDictionary {
+    @synchronized(shadow) {
+        //
+        // Remember every client token given by a caller, so that the updates a
+        // later token replaces still complete with the merged update's result.
+        //
+        NSString *clientToken = [stateDictionary objectForKey:@"clientToken"];
+        if (clientToken != nil) {
+            if (shadow.coalescedClientTokens == nil) {
+                shadow.coalescedClientTokens = [NSMutableArray new];
+            }
+            [shadow.coalescedClientTokens addObject:clientToken];
+        }
+        if (shadow.coalescedState == nil) {
+            shadow.coalescedState = stateDictionary;
+            [self scheduleCoalescedUpdateForShadow:shadow];
+        }
+        else {
+            //
+            // Merge the update into the pending one.  A client token given with a
+            // later update replaces the earlier one.
+            //
+            AWSIoTShadowMergeUpdates(shadow.coalescedState, stateDictionary);
+        }
+    }
+    return YES;
+}
+
+// Must be called while synchronized on the shadow.
+- (void) scheduleCoalescedUpdateForShadow:(AWSIoTDataShadow *)shadow {
+    shadow.coalescingTimer = [NSTimer timerWithTimeInterval:shadow.updateCoalescingInterval
+                                                     target:self
+                                                   selector:@selector(publishCoalescedUpdateOnTimer:)
+                                                   userInfo:shadow.name
+                                                    repeats:NO];
+    [[NSRunLoop mainRunLoop] addTimer:shadow.coalescingTimer forMode:NSRunLoopCommonModes];
+}
+
+- (void) publishCoalescedUpdateOnTimer:(NSTimer *)timer {
+    AWSIoTDataShadow *shadow = [self.shadows objectForKey:(NSString *)[timer userInfo]];
+    NSMutableDictionary *stateDictionary = nil;
+    NSMutableArray<NSString *> *supersededClientTokens = nil;
+
+    @synchronized(shadow) {
+        if (shadow.coalescingTimer != timer) {
+            return;
+        }
+        shadow.coalescingTimer = nil;
+        if ([shadow.pendingOperations count] >= MAX(shadow.maxPendingOperations, 1)) {
+            //
+            // No room for another operation yet; keep merging updates until there is.
+            //
+            [self scheduleCoalescedUpdateForShadow:shadow];
+            return;
+        }
+        stateDictionary = shadow.coalescedState;
+        shadow.coalescedState = nil;
+        supersededClientTokens = shadow.coalescedClientTokens;
+        shadow.coalescedClientTokens = nil;
+    }
+
+    if (stateDictionary != nil) {
+        NSString *clientToken = [stateDictionary objectForKey:@"clientToken"];
+        if (clientToken != nil) {
+            [supersededClientTokens removeObject:clientToken];
+        }
+        [self operationWithShadow:shadow.name
+                        operation:AWSIoTShadowOperationTypeUpdate
+                  stateDictionary:stateDictionary
+           supersededClientTokens:supersededClientTokens];
+    }
+}
+
 - (BOOL) registerWithShadow:(NSString *)name
                     options:(NSDictionary *)options
               eventCallback:(void(^)(NSString *name, AWSIoTShadowOperationType operation, AWSIoTShadowOperationStatusType status, NSString *clientToken, NSData *payload))callback {
@@ -1312,6 +1567,18 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
                 if (numberOptionValue != nil) {
                     shadow.operationTimeout = [numberOptionValue doubleValue];
                 }
+                numberOptionValue = [options valueForKey:@"enableDocumentCache"];
+                if (numberOptionValue != nil) {
+                    shadow.enableDocumentCache = [numberOptionValue integerValue];
+                }
+                numberOptionValue = [options valueForKey:@"maxPendingOperations"];
+                if (numberOptionValue != nil) {
+                    shadow.maxPendingOperations = MAX([numberOptionValue unsignedIntegerValue], 1);
+                }
+                numberOptionValue = [options valueForKey:@"updateCoalescingSeconds"];
+                if (numberOptionValue != nil) {
+                    shadow.updateCoalescingInterval = [numberOptionValue doubleValue];
+                }
             }
             if (shadow.enableIgnoreDeltas == NO) {
                 [self createSubscriptionsForShadow:shadow
@@ -1369,9 +1636,8 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
         // Unsubscribe from all topics associated with this shadow.
         rc = [self handleSubscriptionsForShadow:shadow.name callback:nil completionHandler:completionHandler];
 
-        //invalidate the timer as the shadow is being unregistered.
-        [shadow.timer invalidate];
-        shadow.timer = nil;
+        //invalidate the timers as the shadow is being unregistered.
+        [shadow invalidateTimers];
         //
         // Remove the shadow from the dictionary
         //
@@ -1413,9 +1679,16 @@ static void (^shadowMqttMessageHandler)(NSObject *mqttClient, NSString *topic, N
                 [jsonDictionary setValue:clientToken forKey:@"clientToken"];
             }
             //
-            // Perform the shadow update operation.
+            // Perform the shadow update operation, or merge it with the other updates
+            // made within the coalescing interval.
             //
-            rc = [self operationWithShadow:name operation:AWSIoTShadowOperationTypeUpdate stateDictionary:jsonDictionary];
+            AWSIoTDataShadow *shadow = [self.shadows objectForKey:name];
+            if (shadow != nil && shadow.updateCoalescingInterval > 0) {
+                rc = [self coalesceUpdateWithShadow:shadow stateDictionary:jsonDictionary];
+            }
+            else {
+                rc = [self operationWithShadow:name operation:AWSIoTShadowOperationTypeUpdate stateDictionary:jsonDictionary];
+            }
         }
         else {
             AWSDDLogError(@"json for (%@) cannot contain a version property", name);
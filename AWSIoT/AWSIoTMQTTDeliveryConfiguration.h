@@ -0,0 +1,90 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ What the client does with a received message when its delivery queue is full. QoS 1 messages have already been
+ acknowledged to the broker, so the drop policies never discard them; they are queued over the capacity instead.
+ */
+typedef NS_ENUM(NSInteger, AWSIoTMQTTDeliveryOverflowPolicy) {
+    /// The oldest queued QoS 0 message of the lowest priority subscription is discarded to make room. This is the
+    /// default.
+    AWSIoTMQTTDeliveryOverflowPolicyDropOldest,
+    /// The received QoS 0 message is discarded.
+    AWSIoTMQTTDeliveryOverflowPolicyDropNewest,
+    /// The connection stops reading until the queue has room, so the broker is slowed down instead of messages
+    /// being lost. Other connections sharing the connection's thread are paused too.
+    AWSIoTMQTTDeliveryOverflowPolicyBlock,
+};
+
+/**
+ The order in which the messages of different subscriptions are delivered when several are waiting.
+ */
+typedef NS_ENUM(NSInteger, AWSIoTMQTTDeliveryPriority) {
+    AWSIoTMQTTDeliveryPriorityLow,
+    /// The priority of every subscription unless it is changed.
+    AWSIoTMQTTDeliveryPriorityDefault,
+    AWSIoTMQTTDeliveryPriorityHigh,
+};
+
+/**
+ Configures how received messages are queued and handed to subscription callbacks. The messages of a subscription are
+ always delivered in the order they were received, one batch at a time.
+ */
+@interface AWSIoTMQTTDeliveryConfiguration : NSObject <NSCopying>
+
+/// The maximum number of received messages waiting to be delivered. 0 means unlimited. Defaults to 0.
+@property (nonatomic, assign) NSUInteger capacity;
+
+/// Defaults to `AWSIoTMQTTDeliveryOverflowPolicyDropOldest`.
+@property (nonatomic, assign) AWSIoTMQTTDeliveryOverflowPolicy overflowPolicy;
+
+/// The maximum number of messages passed to a batch callback at once. Defaults to 32.
+@property (nonatomic, assign) NSUInteger maximumBatchSize;
+
+/// The maximum number of subscriptions whose callbacks run at the same time. Defaults to 4.
+@property (nonatomic, assign) NSUInteger maximumConcurrentDeliveries;
+
+@end
+
+/**
+ A snapshot of the delivery queue's state and counters since the client was created.
+ */
+@interface AWSIoTMQTTDeliveryMetrics : NSObject
+
+/// Messages waiting to be delivered.
+@property (nonatomic, readonly) NSUInteger queuedMessageCount;
+
+/// The most messages that have been waiting to be delivered at once.
+@property (nonatomic, readonly) NSUInteger maximumQueuedMessageCount;
+
+/// Messages handed to subscription callbacks.
+@property (nonatomic, readonly) NSUInteger deliveredMessageCount;
+
+/// Messages discarded because the queue was full.
+@property (nonatomic, readonly) NSUInteger droppedMessageCount;
+
+/// Average time between a message being received and it being handed to its callbacks.
+@property (nonatomic, readonly) NSTimeInterval averageDeliveryLag;
+
+/// Longest time between a message being received and it being handed to its callbacks.
+@property (nonatomic, readonly) NSTimeInterval maximumDeliveryLag;
+
+@end
+
+NS_ASSUME_NONNULL_END
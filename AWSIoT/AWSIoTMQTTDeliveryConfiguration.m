@@ -0,0 +1,44 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSIoTMQTTDeliveryConfiguration.h"
+#import "AWSIoTMQTTDeliveryExecutor.h"
+
+@implementation AWSIoTMQTTDeliveryConfiguration
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _capacity = 0;
+        _overflowPolicy = AWSIoTMQTTDeliveryOverflowPolicyDropOldest;
+        _maximumBatchSize = 32;
+        _maximumConcurrentDeliveries = 4;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    AWSIoTMQTTDeliveryConfiguration *configuration = [[[self class] allocWithZone:zone] init];
+    configuration.capacity = self.capacity;
+    configuration.overflowPolicy = self.overflowPolicy;
+    configuration.maximumBatchSize = self.maximumBatchSize;
+    configuration.maximumConcurrentDeliveries = self.maximumConcurrentDeliveries;
+    return configuration;
+}
+
+@end
+
+@implementation AWSIoTMQTTDeliveryMetrics
+
+@end
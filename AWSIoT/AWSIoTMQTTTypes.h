@@ -55,6 +55,7 @@ typedef NS_ENUM(NSInteger, AWSIoTMQTTQoS) {
 typedef void(^AWSIoTMQTTNewMessageBlock)(NSData *data);
 typedef void(^AWSIoTMQTTExtendedNewMessageBlock)(NSObject *mqttClient, NSString *topic, NSData *data);
 typedef void(^AWSIoTMQTTFullMessageBlock)(NSString *topic, AWSIoTMessage *message);
+typedef void(^AWSIoTMQTTBatchMessageBlock)(NSArray<AWSIoTMessage *> *messages);
 typedef void(^AWSIoTMQTTAckBlock)(void);
 
 NS_ASSUME_NONNULL_END
@@ -25,6 +25,7 @@
 @property (nonatomic, strong) AWSIoTMQTTNewMessageBlock callback;
 @property (nonatomic, strong) AWSIoTMQTTExtendedNewMessageBlock extendedCallback;
 @property (nonatomic, strong) AWSIoTMQTTFullMessageBlock fullCallback;
+@property (nonatomic, strong) AWSIoTMQTTBatchMessageBlock batchCallback;
 @end
 
 @interface AWSIoTMQTTQueueMessage : NSObject
@@ -91,6 +92,14 @@
 
 @property(atomic, assign) BOOL isMetricsEnabled;
 @property(atomic, assign) NSUInteger publishRetryThrottle;
+@property(atomic, assign) NSUInteger maxInflightPublishes;
+@property(atomic, copy) NSURL *outboxFileURL;
+
+/**
+ How received messages are queued and handed to subscription callbacks. Setting it keeps the messages already queued,
+ their order and the delivery metrics.
+ */
+@property(atomic, copy) AWSIoTMQTTDeliveryConfiguration *deliveryConfiguration;
 @property(atomic, copy) NSString *userMetaData;
 @property(atomic, copy) NSString *password;
 
@@ -341,6 +350,38 @@ Send MQTT message to specified topic
             fullCallback:(AWSIoTMQTTFullMessageBlock)callback
              ackCallback:(AWSIoTMQTTAckBlock)ackCallback;
 
+/**
+ Subscribes to a topic at a specific QoS level, receiving messages in batches of up to
+ `deliveryConfiguration.maximumBatchSize`, in the order they were received.
+
+ @param topic The Topic to subscribe to.
+
+ @param qos Specifies the QoS Level of the subscription. Can be 0, 1, or 2.
+
+ @param callback Delegate Reference to AWSIoTMQTTBatchMessageBlock. When new messages are received the block will be invoked.
+
+ @param ackCallback the callback for ack if qos == 1 || qos == 2
+ */
+- (void)subscribeToTopic:(NSString*)topic
+                     qos:(UInt8)qos
+           batchCallback:(AWSIoTMQTTBatchMessageBlock)callback
+             ackCallback:(AWSIoTMQTTAckBlock)ackCallback;
+
+/**
+ Sets the order in which the messages of a subscription are delivered relative to other subscriptions.
+
+ @param priority The subscription's priority. Subscriptions have `AWSIoTMQTTDeliveryPriorityDefault` unless set.
+
+ @param topic The topic the subscription was made with.
+ */
+- (void)setDeliveryPriority:(AWSIoTMQTTDeliveryPriority)priority
+                   forTopic:(NSString *)topic;
+
+/**
+ Returns a snapshot of the queue of received messages waiting to be delivered.
+ */
+- (AWSIoTMQTTDeliveryMetrics *)deliveryMetrics;
+
 /**
  Unsubscribes from a topic
 
@@ -17,6 +17,7 @@
 
 #import "AWSIoTMQTTClient.h"
 #import "AWSMQTTSession.h"
+#import "AWSMQTTOutbox.h"
 #import <AWSIoT/AWSSRWebSocket.h>
 #import "AWSIoTWebSocketOutputStream.h"
 #import "AWSIoTKeychain.h"
@@ -24,7 +25,8 @@
 #import "AWSIoTMessage+AWSMQTTMessage.h"
 #import "AWSMQTTMessage.h"
 #import "AWSIoTManager.h"
-#import "AWSIoTStreamThread.h"
+#import "AWSIoTStreamConnection.h"
+#import "AWSIoTMQTTDeliveryExecutor.h"
 
 @implementation AWSIoTMQTTTopicModel
 @end
@@ -67,6 +69,9 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
 
 @property(atomic, strong) NSMutableDictionary<NSNumber *, AWSIoTMQTTAckBlock> *ackCallbackDictionary;
 
+@property(atomic, strong) AWSIoTMQTTDeliveryExecutor *deliveryExecutor; //Hands received messages to the subscription callbacks
+@property(nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *deliveryPriorities;
+
 @property NSString *lastWillAndTestamentTopic;
 @property NSData *lastWillAndTestamentMessage;
 @property UInt8 lastWillAndTestamentQoS;
@@ -77,7 +82,8 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
 
 @property (nonatomic, copy) StatusCallback connectStatusCallback;
 
-@property (nonatomic, strong) AWSIoTStreamThread *streamsThread;
+@property (nonatomic, strong) AWSIoTStreamConnection *streamConnection;
+@property (nonatomic, strong) AWSIoTStreamEventLoop *streamEventLoop; // Shared event loop hosting every stream connection of this client, chosen on the first connect
 @property (nonatomic, strong) NSThread *reconnectThread;
 
 @property (strong,atomic) dispatch_semaphore_t timerSemaphore;
@@ -87,6 +93,8 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
 
 @implementation AWSIoTMQTTClient
 
+@synthesize deliveryConfiguration = _deliveryConfiguration;
+
 #pragma mark - Initializers -
 
 - (instancetype)init {
@@ -110,7 +118,10 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
         _userDidIssueDisconnect = NO;
         _timerSemaphore = dispatch_semaphore_create(1);
         _timerQueue = dispatch_queue_create("com.amazon.aws.iot.timer-queue", DISPATCH_QUEUE_SERIAL);
-        _streamsThread = nil;
+        _streamConnection = nil;
+        _deliveryConfiguration = [AWSIoTMQTTDeliveryConfiguration new];
+        _deliveryExecutor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:_deliveryConfiguration];
+        _deliveryPriorities = [NSMutableDictionary dictionary];
     }
     return self;
 }
@@ -315,6 +326,11 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
                                                         willQoS:self.lastWillAndTestamentQoS
                                                  willRetainFlag:self.lastWillAndTestamentRetainFlag
                                            publishRetryThrottle:self.publishRetryThrottle];
+        self.session.maxInflightPublishes = self.maxInflightPublishes;
+        if (self.outboxFileURL) {
+            self.session.outbox = [[AWSMQTTOutbox alloc] initWithFileURL:self.outboxFileURL
+                                                                clientId:self.clientId];
+        }
         self.session.delegate = self;
     }
     
@@ -380,16 +396,19 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
         }
     }
 
-    //Cancel previous streams thread if necessary
+    //Cancel previous stream connection if necessary
     @synchronized(self) {
-        if (self.streamsThread && !self.streamsThread.isCancelled) {
-            AWSDDLogVerbose(@"Issued Cancel on thread [%@]", self.streamsThread);
-            [self.streamsThread cancelAndDisconnect:self.userDidIssueDisconnect];
+        if (self.streamConnection && !self.streamConnection.isCancelled) {
+            AWSDDLogVerbose(@"Issued Cancel on connection [%@]", self.streamConnection);
+            [self.streamConnection cancelAndDisconnect:self.userDidIssueDisconnect];
         }
-        self.streamsThread = [[AWSIoTStreamThread alloc] initWithSession:self.session
-                                                      decoderInputStream:inputStream
-                                                     encoderOutputStream:outputStream];
-        [self.streamsThread start];
+        self.streamConnection = [[AWSIoTStreamConnection alloc] initWithSession:self.session
+                                                             decoderInputStream:inputStream
+                                                            encoderOutputStream:outputStream
+                                                                   outputStream:nil
+                                                                      eventLoop:self.streamEventLoop];
+        self.streamEventLoop = self.streamConnection.eventLoop;
+        [self.streamConnection start];
     }
     return YES;
 }
@@ -581,6 +600,11 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
                                                         willQoS:self.lastWillAndTestamentQoS
                                                  willRetainFlag:self.lastWillAndTestamentRetainFlag
                                            publishRetryThrottle:self.publishRetryThrottle];
+        self.session.maxInflightPublishes = self.maxInflightPublishes;
+        if (self.outboxFileURL) {
+            self.session.outbox = [[AWSMQTTOutbox alloc] initWithFileURL:self.outboxFileURL
+                                                                clientId:self.clientId];
+        }
         self.session.delegate = self;
     }
     
@@ -636,11 +660,9 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
     [self.session disconnect];
     self.connectionAgeInSeconds = 0;
 
-    //Cancel the current streams thread
-    [self.streamsThread cancelAndDisconnect:YES];
-
+    //Cancel the current stream connection. onStop is set first, as the event loop may stop the connection straight away.
     __weak AWSIoTMQTTClient *weakSelf = self;
-    self.streamsThread.onStop = ^{
+    self.streamConnection.onStop = ^{
         __strong AWSIoTMQTTClient *strongSelf = weakSelf;
         //If the userDidIssueDisconnect has been set to NO, it means a new connection has been requested,
         //so we should disregard these updates
@@ -663,6 +685,7 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
         strongSelf.mqttStatus = AWSIoTMQTTStatusDisconnected;
         [strongSelf notifyConnectionStatus];
     };
+    [self.streamConnection cancelAndDisconnect:YES];
 
     AWSDDLogInfo(@"AWSIoTMQTTClient: Disconnect message issued.");
 }
@@ -968,6 +991,29 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
     [self subscribeWithTopicModel:topicModel ackCallback:ackCallback];
 }
 
+- (void)subscribeToTopic:(NSString*)topic
+                     qos:(UInt8)qos
+           batchCallback:(AWSIoTMQTTBatchMessageBlock)callback
+             ackCallback:(AWSIoTMQTTAckBlock)ackCallback {
+    if (!_userDidIssueConnect) {
+        [NSException raise:NSInternalInconsistencyException
+                    format:@"Cannot call subscribe before connecting to the server"];
+    }
+
+    if (_userDidIssueDisconnect) {
+        [NSException raise:NSInternalInconsistencyException
+                    format:@"Cannot call subscribe after disconnecting from the server"];
+    }
+
+    AWSDDLogInfo(@"Subscribing to topic %@ with batchCallback", topic);
+    AWSIoTMQTTTopicModel *topicModel = [AWSIoTMQTTTopicModel new];
+    topicModel.topic = topic;
+    topicModel.qos = qos;
+    topicModel.batchCallback = callback;
+
+    [self subscribeWithTopicModel:topicModel ackCallback:ackCallback];
+}
+
 // Private
 - (void)subscribeWithTopicModel:(AWSIoTMQTTTopicModel *)topicModel
                     ackCallback:(AWSIoTMQTTAckBlock)ackCallback {
@@ -995,6 +1041,7 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
     AWSDDLogInfo(@"Unsubscribing from topic %@", topic);
     UInt16 messageId = [self.session unsubscribeTopic:topic];
     [self.topicListeners removeObjectForKey:topic];
+    [self.deliveryExecutor removeMessagesForKey:topic];
     if (ackCallback) {
         [self.ackCallbackDictionary setObject:ackCallback
                                        forKey:[NSNumber numberWithInt:messageId]];
@@ -1005,6 +1052,68 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
     [self unsubscribeTopic:topic ackCallback:nil];
 }
 
+#pragma mark - delivery -
+
+- (void)setDeliveryConfiguration:(AWSIoTMQTTDeliveryConfiguration *)deliveryConfiguration {
+    @synchronized(self) {
+        _deliveryConfiguration = [deliveryConfiguration copy] ?: [AWSIoTMQTTDeliveryConfiguration new];
+        //Applied to the existing executor, so queued messages keep their order and the metrics are kept across connects.
+        self.deliveryExecutor.configuration = _deliveryConfiguration;
+    }
+}
+
+- (AWSIoTMQTTDeliveryConfiguration *)deliveryConfiguration {
+    @synchronized(self) {
+        return _deliveryConfiguration;
+    }
+}
+
+- (void)setDeliveryPriority:(AWSIoTMQTTDeliveryPriority)priority
+                   forTopic:(NSString *)topic {
+    @synchronized(self.deliveryPriorities) {
+        [self.deliveryPriorities setObject:@(priority) forKey:topic];
+    }
+}
+
+- (AWSIoTMQTTDeliveryPriority)deliveryPriorityForTopic:(NSString *)topic {
+    @synchronized(self.deliveryPriorities) {
+        NSNumber *priority = [self.deliveryPriorities objectForKey:topic];
+        return priority ? (AWSIoTMQTTDeliveryPriority)priority.integerValue : AWSIoTMQTTDeliveryPriorityDefault;
+    }
+}
+
+- (AWSIoTMQTTDeliveryMetrics *)deliveryMetrics {
+    return [self.deliveryExecutor metrics];
+}
+
+//Runs on a delivery worker. The messages of a subscription are handed over one batch at a time, in order.
+- (void)deliverMessages:(NSArray<AWSIoTMessage *> *)messages
+           toTopicModel:(AWSIoTMQTTTopicModel *)topicModel {
+    if (topicModel.batchCallback != nil) {
+        AWSDDLogVerbose(@"<<%@>>topicModel.batchCallback with %lu messages.", [NSThread currentThread], (unsigned long)messages.count);
+        topicModel.batchCallback(messages);
+    }
+
+    for (AWSIoTMessage *iotMessage in messages) {
+        if (topicModel.callback != nil) {
+            AWSDDLogVerbose(@"<<%@>>topicModel.callback.", [NSThread currentThread]);
+            topicModel.callback(iotMessage.messageData);
+        }
+        if (topicModel.extendedCallback != nil) {
+            AWSDDLogVerbose(@"<<%@>>topicModel.extendedcallback.", [NSThread currentThread]);
+            topicModel.extendedCallback(self, iotMessage.topic, iotMessage.messageData);
+        }
+        if (topicModel.fullCallback != nil) {
+            AWSDDLogVerbose(@"<<%@>>topicModel.messageCallback.", [NSThread currentThread]);
+            topicModel.fullCallback(iotMessage.topic, iotMessage);
+        }
+        if (self.clientDelegate != nil ) {
+            AWSDDLogVerbose(@"<<%@>>Calling receviedMessageData on client Delegate.", [NSThread currentThread]);
+            [self.clientDelegate receivedMessageData:iotMessage.rawData onTopic:iotMessage.topic];
+        }
+    }
+}
+
 #pragma mark - MQTTSessionDelegate -
 
 - (void)connectionAgeTimerHandler:(NSTimer*)theTimer {
@@ -1151,35 +1260,17 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
             AWSIoTMQTTTopicModel *topicModel = [self.topicListeners objectForKey:topicKey];
             if (topicModel) {
                 AWSIoTMessage *iotMessage = [[AWSIoTMessage alloc] initWithMQTTMessage:message];
-
-                if (topicModel.callback != nil) {
-                    AWSDDLogVerbose(@"<<%@>>topicModel.callback.", [NSThread currentThread]);
-                    dispatch_async(dispatch_get_global_queue( DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(void){
-                        topicModel.callback(iotMessage.messageData);
-                    });
-                }
-                if (topicModel.extendedCallback != nil) {
-                    AWSDDLogVerbose(@"<<%@>>topicModel.extendedcallback.", [NSThread currentThread]);
-                    __weak AWSIoTMQTTClient *weakSelf = self;
-                    dispatch_async(dispatch_get_global_queue( DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(void){
-                        topicModel.extendedCallback(weakSelf, topic, iotMessage.messageData);
-                    });
+                if (iotMessage == nil) {
+                    continue;
                 }
-                if (topicModel.fullCallback != nil) {
-                    AWSDDLogVerbose(@"<<%@>>topicModel.messageCallback.", [NSThread currentThread]);
-                    dispatch_async(dispatch_get_global_queue( DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(void){
-                        topicModel.fullCallback(iotMessage.topic, iotMessage);
-                    });
-                }
-                
-                if (self.clientDelegate != nil ) {
-                    AWSDDLogVerbose(@"<<%@>>Calling receviedMessageData on client Delegate.", [NSThread currentThread]);
-                    __weak AWSIoTMQTTClient *weakSelf = self;
-                    dispatch_async(dispatch_get_global_queue( DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(void){
-                        [weakSelf.clientDelegate receivedMessageData:message.data onTopic:topic];
-                    });
-                }
-                
+
+                __weak AWSIoTMQTTClient *weakSelf = self;
+                [self.deliveryExecutor enqueueMessage:iotMessage
+                                               forKey:topicKey
+                                             priority:[self deliveryPriorityForTopic:topicKey]
+                                              handler:^(NSArray<AWSIoTMessage *> *messages) {
+                    [weakSelf deliverMessages:messages toTopicModel:topicModel];
+                }];
             }
         }
     }
@@ -1226,18 +1317,20 @@ typedef void (^StatusCallback)(AWSIoTMQTTStatus status);
     //Create write stream to write to the WebSocket.
     self.encoderOutputStream = [AWSIoTWebSocketOutputStreamFactory createAWSIoTWebSocketOutputStreamWithWebSocket:webSocket];
     
-    //Cancel previous streams thread if necessary
+    //Cancel previous stream connection if necessary
     @synchronized(self) {
-        if (self.streamsThread && !self.streamsThread.isCancelled) {
-            AWSDDLogVerbose(@"Issued Cancel on thread [%@]", self.streamsThread);
-            [self.streamsThread cancelAndDisconnect:self.userDidIssueDisconnect];
+        if (self.streamConnection && !self.streamConnection.isCancelled) {
+            AWSDDLogVerbose(@"Issued Cancel on connection [%@]", self.streamConnection);
+            [self.streamConnection cancelAndDisconnect:self.userDidIssueDisconnect];
         }
 
-        self.streamsThread = [[AWSIoTStreamThread alloc] initWithSession:self.session
-                                                      decoderInputStream:inputStream
-                                                     encoderOutputStream:self.encoderOutputStream
-                                                            outputStream:self.websocketOutputStream];
-        [self.streamsThread start];
+        self.streamConnection = [[AWSIoTStreamConnection alloc] initWithSession:self.session
+                                                             decoderInputStream:inputStream
+                                                            encoderOutputStream:self.encoderOutputStream
+                                                                   outputStream:self.websocketOutputStream
+                                                                      eventLoop:self.streamEventLoop];
+        self.streamEventLoop = self.streamConnection.eventLoop;
+        [self.streamConnection start];
     }
 
 }
@@ -0,0 +1,72 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSIoTMQTTDeliveryConfiguration.h"
+#import "AWSIoTMessage.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^AWSIoTMQTTDeliveryHandler)(NSArray<AWSIoTMessage *> *messages);
+
+@interface AWSIoTMQTTDeliveryMetrics()
+
+@property (nonatomic, assign) NSUInteger queuedMessageCount;
+@property (nonatomic, assign) NSUInteger maximumQueuedMessageCount;
+@property (nonatomic, assign) NSUInteger deliveredMessageCount;
+@property (nonatomic, assign) NSUInteger droppedMessageCount;
+@property (nonatomic, assign) NSTimeInterval averageDeliveryLag;
+@property (nonatomic, assign) NSTimeInterval maximumDeliveryLag;
+
+@end
+
+/**
+ Hands received messages to subscription handlers on background queues. Each subscription has its own queue of
+ messages, delivered in order and one batch at a time. Subscriptions with messages waiting are served highest
+ priority first, and up to `maximumConcurrentDeliveries` of them are delivered at the same time.
+ */
+@interface AWSIoTMQTTDeliveryExecutor : NSObject
+
+/**
+ Setting the configuration keeps the queued messages, their order and the metrics. The new capacity and overflow
+ policy apply to the next received message, the batch size to the next batch. Deliveries already running over a
+ lowered `maximumConcurrentDeliveries` finish their current batch first.
+ */
+@property (copy) AWSIoTMQTTDeliveryConfiguration *configuration;
+
+- (instancetype)initWithConfiguration:(AWSIoTMQTTDeliveryConfiguration *)configuration;
+
+/**
+ Queues `message` for the subscription `key`, applying the configured overflow policy if the queue is full. QoS 1
+ messages are queued over the capacity rather than dropped.
+
+ @param handler Called with the next batch of the subscription's messages. The handler passed with the latest message
+                replaces the previous one.
+ */
+- (void)enqueueMessage:(AWSIoTMessage *)message
+                forKey:(NSString *)key
+              priority:(AWSIoTMQTTDeliveryPriority)priority
+               handler:(AWSIoTMQTTDeliveryHandler)handler;
+
+/**
+ Discards the messages of the subscription `key` that have not been delivered yet.
+ */
+- (void)removeMessagesForKey:(NSString *)key;
+
+- (AWSIoTMQTTDeliveryMetrics *)metrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
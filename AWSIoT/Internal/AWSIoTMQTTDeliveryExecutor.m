@@ -0,0 +1,295 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSIoTMQTTDeliveryExecutor.h"
+#import <AWSCore/AWSDDLogMacros.h>
+
+static const NSUInteger AWSIoTMQTTDeliveryPriorityCount = AWSIoTMQTTDeliveryPriorityHigh + 1;
+
+@interface AWSIoTMQTTDeliveryEntry : NSObject
+
+@property (nonatomic, strong) AWSIoTMessage *message;
+@property (nonatomic, assign) CFAbsoluteTime enqueueTime;
+
+@end
+
+@implementation AWSIoTMQTTDeliveryEntry
+
+@end
+
+// The queue of one subscription. A lane is scheduled from the moment it has messages until a worker finds it empty,
+// so only one worker ever delivers its messages.
+@interface AWSIoTMQTTDeliveryLane : NSObject
+
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic, strong) NSMutableArray<AWSIoTMQTTDeliveryEntry *> *entries;
+@property (nonatomic, assign) AWSIoTMQTTDeliveryPriority priority;
+@property (nonatomic, copy) AWSIoTMQTTDeliveryHandler handler;
+@property (nonatomic, assign) BOOL scheduled;
+// Set when the subscription's messages were removed while the lane was scheduled. The lane is removed once it is idle.
+@property (nonatomic, assign) BOOL removed;
+
+@end
+
+@implementation AWSIoTMQTTDeliveryLane
+
+@end
+
+@implementation AWSIoTMQTTDeliveryExecutor {
+    AWSIoTMQTTDeliveryConfiguration *_configuration;
+    NSCondition *lock;
+    NSMutableDictionary<NSString *, AWSIoTMQTTDeliveryLane *> *lanes;
+    NSMutableArray<AWSIoTMQTTDeliveryLane *> *readyLanes[AWSIoTMQTTDeliveryPriorityCount];
+    NSUInteger activeWorkerCount;
+    NSUInteger queuedMessageCount;
+    NSUInteger maximumQueuedMessageCount;
+    NSUInteger deliveredMessageCount;
+    NSUInteger droppedMessageCount;
+    NSTimeInterval totalDeliveryLag;
+    NSTimeInterval maximumDeliveryLag;
+}
+
+- (instancetype)initWithConfiguration:(AWSIoTMQTTDeliveryConfiguration *)configuration {
+    if (self = [super init]) {
+        _configuration = [configuration copy];
+        lock = [NSCondition new];
+        lanes = [NSMutableDictionary dictionary];
+        for (NSUInteger i = 0; i < AWSIoTMQTTDeliveryPriorityCount; i++) {
+            readyLanes[i] = [NSMutableArray array];
+        }
+    }
+    return self;
+}
+
+- (AWSIoTMQTTDeliveryConfiguration *)configuration {
+    [lock lock];
+    AWSIoTMQTTDeliveryConfiguration *configuration = [_configuration copy];
+    [lock unlock];
+    return configuration;
+}
+
+- (void)setConfiguration:(AWSIoTMQTTDeliveryConfiguration *)configuration {
+    [lock lock];
+    _configuration = [configuration copy];
+    // Receivers blocked on a full queue check the new capacity, and workers are added up to the new limit.
+    [lock broadcast];
+    NSUInteger readyLaneCount = 0;
+    for (NSUInteger i = 0; i < AWSIoTMQTTDeliveryPriorityCount; i++) {
+        readyLaneCount += readyLanes[i].count;
+    }
+    NSUInteger maximumConcurrentDeliveries = MAX(_configuration.maximumConcurrentDeliveries, 1);
+    NSUInteger startedWorkerCount = 0;
+    if (activeWorkerCount < maximumConcurrentDeliveries) {
+        startedWorkerCount = MIN(maximumConcurrentDeliveries - activeWorkerCount, readyLaneCount);
+        activeWorkerCount += startedWorkerCount;
+    }
+    [lock unlock];
+
+    for (NSUInteger i = 0; i < startedWorkerCount; i++) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [self runWorker];
+        });
+    }
+}
+
+- (void)enqueueMessage:(AWSIoTMessage *)message
+                forKey:(NSString *)key
+              priority:(AWSIoTMQTTDeliveryPriority)priority
+               handler:(AWSIoTMQTTDeliveryHandler)handler {
+    priority = MIN(MAX(priority, AWSIoTMQTTDeliveryPriorityLow), AWSIoTMQTTDeliveryPriorityHigh);
+
+    [lock lock];
+    // Read on every pass, as the configuration can change while the receiver waits for room.
+    while (_configuration.capacity > 0 && queuedMessageCount >= _configuration.capacity) {
+        AWSIoTMQTTDeliveryOverflowPolicy overflowPolicy = _configuration.overflowPolicy;
+        if (overflowPolicy == AWSIoTMQTTDeliveryOverflowPolicyBlock) {
+            // Workers signal whenever they take messages off the queue.
+            [lock wait];
+            continue;
+        }
+        if (overflowPolicy == AWSIoTMQTTDeliveryOverflowPolicyDropOldest && [self dropOldestMessage]) {
+            continue;
+        }
+        // QoS 1 messages have already been acknowledged, so the broker will not send them again. They are queued over
+        // the capacity rather than lost.
+        if (message.qos == AWSIoTMQTTQoSMessageDeliveryAttemptedAtMostOnce) {
+            droppedMessageCount++;
+            [lock unlock];
+            AWSDDLogWarn(@"Delivery queue is full. Dropping message on topic %@", message.topic);
+            return;
+        }
+        break;
+    }
+
+    AWSIoTMQTTDeliveryLane *lane = lanes[key];
+    if (lane == nil) {
+        lane = [AWSIoTMQTTDeliveryLane new];
+        lane.key = key;
+        lane.entries = [NSMutableArray array];
+        lanes[key] = lane;
+    }
+    lane.removed = NO;
+    lane.priority = priority;
+    lane.handler = handler;
+
+    AWSIoTMQTTDeliveryEntry *entry = [AWSIoTMQTTDeliveryEntry new];
+    entry.message = message;
+    entry.enqueueTime = CFAbsoluteTimeGetCurrent();
+    [lane.entries addObject:entry];
+    queuedMessageCount++;
+    maximumQueuedMessageCount = MAX(maximumQueuedMessageCount, queuedMessageCount);
+
+    if (!lane.scheduled) {
+        lane.scheduled = YES;
+        [readyLanes[priority] addObject:lane];
+    }
+    BOOL startsWorker = activeWorkerCount < MAX(_configuration.maximumConcurrentDeliveries, 1);
+    if (startsWorker) {
+        activeWorkerCount++;
+    }
+    [lock unlock];
+
+    if (startsWorker) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [self runWorker];
+        });
+    }
+}
+
+// Drops the oldest waiting QoS 0 message of the lowest priority lane, and returns NO if there is none. Called with the
+// lock held.
+- (BOOL)dropOldestMessage {
+    AWSIoTMQTTDeliveryLane *victim = nil;
+    AWSIoTMQTTDeliveryEntry *victimEntry = nil;
+    for (AWSIoTMQTTDeliveryLane *lane in lanes.allValues) {
+        if (victim && lane.priority > victim.priority) {
+            continue;
+        }
+        for (AWSIoTMQTTDeliveryEntry *entry in lane.entries) {
+            if (entry.message.qos != AWSIoTMQTTQoSMessageDeliveryAttemptedAtMostOnce) {
+                continue;
+            }
+            if (victim == nil
+                || lane.priority < victim.priority
+                || entry.enqueueTime < victimEntry.enqueueTime) {
+                victim = lane;
+                victimEntry = entry;
+            }
+            break;
+        }
+    }
+    if (victim == nil) {
+        return NO;
+    }
+    AWSDDLogWarn(@"Delivery queue is full. Dropping message on topic %@", victimEntry.message.topic);
+    [victim.entries removeObjectIdenticalTo:victimEntry];
+    queuedMessageCount--;
+    droppedMessageCount++;
+    return YES;
+}
+
+- (void)runWorker {
+    while (YES) {
+        [lock lock];
+        // Workers over a lowered limit stop between batches.
+        if (activeWorkerCount > MAX(_configuration.maximumConcurrentDeliveries, 1)) {
+            activeWorkerCount--;
+            [lock unlock];
+            return;
+        }
+        NSUInteger maximumBatchSize = MAX(_configuration.maximumBatchSize, 1);
+        AWSIoTMQTTDeliveryLane *lane = nil;
+        for (NSInteger priority = AWSIoTMQTTDeliveryPriorityHigh; priority >= AWSIoTMQTTDeliveryPriorityLow; priority--) {
+            if (readyLanes[priority].count > 0) {
+                lane = readyLanes[priority][0];
+                [readyLanes[priority] removeObjectAtIndex:0];
+                break;
+            }
+        }
+        if (lane == nil) {
+            activeWorkerCount--;
+            [lock unlock];
+            return;
+        }
+
+        NSUInteger batchSize = MIN(lane.entries.count, maximumBatchSize);
+        NSMutableArray<AWSIoTMessage *> *messages = [NSMutableArray arrayWithCapacity:batchSize];
+        CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+        for (NSUInteger i = 0; i < batchSize; i++) {
+            AWSIoTMQTTDeliveryEntry *entry = lane.entries[i];
+            NSTimeInterval lag = now - entry.enqueueTime;
+            totalDeliveryLag += lag;
+            maximumDeliveryLag = MAX(maximumDeliveryLag, lag);
+            [messages addObject:entry.message];
+        }
+        [lane.entries removeObjectsInRange:NSMakeRange(0, batchSize)];
+        queuedMessageCount -= batchSize;
+        deliveredMessageCount += batchSize;
+        AWSIoTMQTTDeliveryHandler handler = lane.handler;
+        [lock broadcast];
+        [lock unlock];
+
+        if (batchSize > 0) {
+            @autoreleasepool {
+                handler(messages);
+            }
+        }
+
+        // Requeue the lane behind the other lanes of its priority, so a busy subscription does not starve them.
+        [lock lock];
+        if (lane.entries.count > 0) {
+            [readyLanes[lane.priority] addObject:lane];
+        } else {
+            lane.scheduled = NO;
+            if (lane.removed) {
+                [lanes removeObjectForKey:lane.key];
+            }
+        }
+        [lock unlock];
+    }
+}
+
+- (void)removeMessagesForKey:(NSString *)key {
+    [lock lock];
+    AWSIoTMQTTDeliveryLane *lane = lanes[key];
+    if (lane) {
+        queuedMessageCount -= lane.entries.count;
+        [lane.entries removeAllObjects];
+        // A worker may still be delivering from a scheduled lane. Keeping it lets a new subscription to the key queue
+        // behind that delivery rather than start a second lane delivering alongside it.
+        if (lane.scheduled) {
+            lane.removed = YES;
+        } else {
+            [lanes removeObjectForKey:key];
+        }
+        [lock broadcast];
+    }
+    [lock unlock];
+}
+
+- (AWSIoTMQTTDeliveryMetrics *)metrics {
+    AWSIoTMQTTDeliveryMetrics *metrics = [AWSIoTMQTTDeliveryMetrics new];
+    [lock lock];
+    metrics.queuedMessageCount = queuedMessageCount;
+    metrics.maximumQueuedMessageCount = maximumQueuedMessageCount;
+    metrics.deliveredMessageCount = deliveredMessageCount;
+    metrics.droppedMessageCount = droppedMessageCount;
+    metrics.averageDeliveryLag = deliveredMessageCount > 0 ? totalDeliveryLag / deliveredMessageCount : 0;
+    metrics.maximumDeliveryLag = maximumDeliveryLag;
+    [lock unlock];
+    return metrics;
+}
+
+@end
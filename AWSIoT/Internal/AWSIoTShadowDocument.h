@@ -0,0 +1,67 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Reads the top-level `version` and `clientToken` of a shadow message without building the JSON object tree. Nested
+ objects and arrays are skipped over, so a `version` inside `state` or `metadata` is never mistaken for the document
+ version.
+
+ @return `NO` if the payload is not a JSON object. Fields that are missing are left `nil`.
+ */
+FOUNDATION_EXPORT BOOL AWSIoTShadowScanPayload(NSData *payload,
+                                               NSNumber * _Nullable * _Nullable version,
+                                               NSString * _Nullable * _Nullable clientToken);
+
+/**
+ Merges `patch` into `target` the way the shadow service merges state: objects are merged key by key, `null` removes a
+ key, and any other value replaces the existing one. Nested objects in `target` are made mutable as they are merged.
+ */
+FOUNDATION_EXPORT void AWSIoTShadowMergeState(NSMutableDictionary *target, NSDictionary *patch);
+
+/**
+ Merges a later update request into an earlier one so that publishing the result has the same effect as publishing
+ both. Unlike `AWSIoTShadowMergeState`, a `null` is kept so the service still deletes the key.
+ */
+FOUNDATION_EXPORT void AWSIoTShadowMergeUpdates(NSMutableDictionary *target, NSDictionary *patch);
+
+/**
+ A local copy of a shadow document, kept current from the accepted, delta and documents messages of the shadow. Not
+ thread safe.
+ */
+@interface AWSIoTShadowDocument : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger version;
+
+/// Replaces the document with the `state` of a get/accepted message or the `current` document of a documents message.
+- (void)replaceWithDocument:(NSDictionary *)document;
+
+/// Merges the `state` of an update/accepted message into the document.
+- (void)mergeUpdate:(NSDictionary *)document;
+
+/// Merges the `state` of a delta message into the desired state.
+- (void)mergeDelta:(NSDictionary *)document;
+
+- (void)clear;
+
+/// An immutable copy of the document with `state` and `version` keys, or `nil` if nothing has been received yet.
+- (nullable NSDictionary<NSString *, id> *)snapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,282 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSIoTShadowDocument.h"
+
+#pragma mark - Payload scanning
+
+static const uint8_t *AWSIoTShadowSkipWhitespace(const uint8_t *p, const uint8_t *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+// `p` points at the opening quote. Returns the position after the closing quote, or NULL if the string is unterminated.
+static const uint8_t *AWSIoTShadowSkipString(const uint8_t *p, const uint8_t *end, BOOL *hasEscapes) {
+    for (p++; p < end; p++) {
+        if (*p == '\\') {
+            if (hasEscapes) {
+                *hasEscapes = YES;
+            }
+            p++;
+        } else if (*p == '"') {
+            return p + 1;
+        }
+    }
+    return NULL;
+}
+
+static const uint8_t *AWSIoTShadowSkipValue(const uint8_t *p, const uint8_t *end) {
+    if (p >= end) {
+        return NULL;
+    }
+    if (*p == '"') {
+        return AWSIoTShadowSkipString(p, end, NULL);
+    }
+    if (*p == '{' || *p == '[') {
+        NSUInteger depth = 0;
+        while (p < end) {
+            if (*p == '"') {
+                p = AWSIoTShadowSkipString(p, end, NULL);
+                if (!p) {
+                    return NULL;
+                }
+                continue;
+            }
+            if (*p == '{' || *p == '[') {
+                depth++;
+            } else if (*p == '}' || *p == ']') {
+                if (--depth == 0) {
+                    return p + 1;
+                }
+            }
+            p++;
+        }
+        return NULL;
+    }
+    // Numbers, true, false and null.
+    while (p < end && *p != ',' && *p != '}' && *p != ']'
+           && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') {
+        p++;
+    }
+    return p;
+}
+
+static BOOL AWSIoTShadowKeyEquals(const uint8_t *key, size_t length, const char *name) {
+    return length == strlen(name) && memcmp(key, name, length) == 0;
+}
+
+BOOL AWSIoTShadowScanPayload(NSData *payload, NSNumber **version, NSString **clientToken) {
+    if (version) {
+        *version = nil;
+    }
+    if (clientToken) {
+        *clientToken = nil;
+    }
+
+    const uint8_t *p = [payload bytes];
+    const uint8_t *end = p + [payload length];
+    p = AWSIoTShadowSkipWhitespace(p, end);
+    if (p >= end || *p != '{') {
+        return NO;
+    }
+    p = AWSIoTShadowSkipWhitespace(p + 1, end);
+    if (p < end && *p == '}') {
+        return YES;
+    }
+
+    BOOL foundVersion = NO;
+    BOOL foundClientToken = NO;
+    while (p < end) {
+        if (*p != '"') {
+            return NO;
+        }
+        const uint8_t *key = p + 1;
+        p = AWSIoTShadowSkipString(p, end, NULL);
+        if (!p) {
+            return NO;
+        }
+        size_t keyLength = (size_t)(p - 1 - key);
+
+        p = AWSIoTShadowSkipWhitespace(p, end);
+        if (p >= end || *p != ':') {
+            return NO;
+        }
+        p = AWSIoTShadowSkipWhitespace(p + 1, end);
+        const uint8_t *value = p;
+        BOOL hasEscapes = NO;
+        if (p < end && *p == '"') {
+            p = AWSIoTShadowSkipString(p, end, &hasEscapes);
+        } else {
+            p = AWSIoTShadowSkipValue(p, end);
+        }
+        if (!p) {
+            return NO;
+        }
+
+        if (AWSIoTShadowKeyEquals(key, keyLength, "version") && *value != '"') {
+            foundVersion = YES;
+            if (version) {
+                NSString *number = [[NSString alloc] initWithBytes:value
+                                                            length:(NSUInteger)(p - value)
+                                                          encoding:NSUTF8StringEncoding];
+                *version = @(strtoull([number UTF8String], NULL, 10));
+            }
+        } else if (AWSIoTShadowKeyEquals(key, keyLength, "clientToken") && *value == '"') {
+            foundClientToken = YES;
+            if (clientToken) {
+                if (hasEscapes) {
+                    // Rare enough that the full parser can take care of unescaping.
+                    NSData *fragment = [NSData dataWithBytes:value length:(NSUInteger)(p - value)];
+                    *clientToken = [NSJSONSerialization JSONObjectWithData:fragment
+                                                                   options:NSJSONReadingFragmentsAllowed
+                                                                     error:nil];
+                } else {
+                    *clientToken = [[NSString alloc] initWithBytes:value + 1
+                                                            length:(NSUInteger)(p - value - 2)
+                                                          encoding:NSUTF8StringEncoding];
+                }
+            }
+        }
+        if (foundVersion && foundClientToken) {
+            return YES;
+        }
+
+        p = AWSIoTShadowSkipWhitespace(p, end);
+        if (p < end && *p == ',') {
+            p = AWSIoTShadowSkipWhitespace(p + 1, end);
+        } else if (p < end && *p == '}') {
+            return YES;
+        } else {
+            return NO;
+        }
+    }
+    return NO;
+}
+
+#pragma mark - State merging
+
+static void AWSIoTShadowMerge(NSMutableDictionary *target, NSDictionary *patch, BOOL keepNulls) {
+    [patch enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+        if (value == [NSNull null] && !keepNulls) {
+            [target removeObjectForKey:key];
+            return;
+        }
+        if ([value isKindOfClass:[NSDictionary class]]) {
+            id existing = target[key];
+            if ([existing isKindOfClass:[NSDictionary class]]) {
+                if (![existing isKindOfClass:[NSMutableDictionary class]]) {
+                    existing = [existing mutableCopy];
+                    target[key] = existing;
+                }
+                AWSIoTShadowMerge(existing, value, keepNulls);
+            } else {
+                NSMutableDictionary *merged = [NSMutableDictionary new];
+                AWSIoTShadowMerge(merged, value, keepNulls);
+                target[key] = merged;
+            }
+            return;
+        }
+        target[key] = value;
+    }];
+}
+
+void AWSIoTShadowMergeState(NSMutableDictionary *target, NSDictionary *patch) {
+    AWSIoTShadowMerge(target, patch, NO);
+}
+
+void AWSIoTShadowMergeUpdates(NSMutableDictionary *target, NSDictionary *patch) {
+    AWSIoTShadowMerge(target, patch, YES);
+}
+
+#pragma mark - AWSIoTShadowDocument
+
+@interface AWSIoTShadowDocument()
+
+@property (nonatomic, assign) NSUInteger version;
+@property (nonatomic, strong, nullable) NSMutableDictionary *state;
+
+@end
+
+@implementation AWSIoTShadowDocument
+
+- (void)updateVersion:(NSDictionary *)document {
+    id version = document[@"version"];
+    if ([version isKindOfClass:[NSNumber class]]) {
+        self.version = MAX(self.version, [version unsignedIntegerValue]);
+    }
+}
+
+- (void)replaceWithDocument:(NSDictionary *)document {
+    NSDictionary *state = document[@"state"];
+    self.state = [NSMutableDictionary new];
+    if ([state isKindOfClass:[NSDictionary class]]) {
+        for (NSString *section in @[@"desired", @"reported"]) {
+            if ([state[section] isKindOfClass:[NSDictionary class]]) {
+                NSMutableDictionary *sectionState = [NSMutableDictionary new];
+                AWSIoTShadowMergeState(sectionState, state[section]);
+                self.state[section] = sectionState;
+            }
+        }
+    }
+    self.version = 0;
+    [self updateVersion:document];
+}
+
+- (void)mergeUpdate:(NSDictionary *)document {
+    NSDictionary *state = document[@"state"];
+    if (![state isKindOfClass:[NSDictionary class]]) {
+        return;
+    }
+    if (!self.state) {
+        self.state = [NSMutableDictionary new];
+    }
+    AWSIoTShadowMergeState(self.state, state);
+    [self updateVersion:document];
+}
+
+- (void)mergeDelta:(NSDictionary *)document {
+    NSDictionary *state = document[@"state"];
+    if (![state isKindOfClass:[NSDictionary class]]) {
+        return;
+    }
+    if (!self.state) {
+        self.state = [NSMutableDictionary new];
+    }
+    AWSIoTShadowMergeState(self.state, @{@"desired" : state});
+    [self updateVersion:document];
+}
+
+- (void)clear {
+    self.state = nil;
+    self.version = 0;
+}
+
+- (NSDictionary<NSString *, id> *)snapshot {
+    if (!self.state) {
+        return nil;
+    }
+
+    // A round trip through JSON is the cheapest deep copy that leaves no mutable containers behind.
+    NSData *data = [NSJSONSerialization dataWithJSONObject:self.state options:0 error:nil];
+    NSDictionary *state = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : @{};
+    return @{
+             @"state" : state ?: @{},
+             @"version" : @(self.version),
+             };
+}
+
+@end
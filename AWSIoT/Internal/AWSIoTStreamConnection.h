@@ -15,12 +15,19 @@
 
 #import <Foundation/Foundation.h>
 #import "AWSMQTTSession.h"
+#import "AWSIoTStreamEventLoop.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
-@interface AWSIoTStreamThread : NSThread
+/**
+ Connects an MQTT session to its streams on a shared event loop, which runs the session's stream events and timer.
+ The connection counts against its event loop from the moment it is created until it has stopped.
+ */
+@interface AWSIoTStreamConnection : NSObject
 
 @property(strong, nullable) void (^onStop)(void);
+@property(readonly, getter=isCancelled) BOOL cancelled;
+@property(nonatomic, readonly) AWSIoTStreamEventLoop *eventLoop;
 
 -(instancetype)initWithSession:(nonnull AWSMQTTSession *)session
             decoderInputStream:(nonnull NSInputStream *)decoderInputStream
@@ -31,6 +38,14 @@ NS_ASSUME_NONNULL_BEGIN
            encoderOutputStream:(nonnull NSOutputStream *)decoderOutputStream
                   outputStream:(nullable NSOutputStream *)outputStream;
 
+/// Without an event loop, the connection attaches to the least loaded event loop of the default group.
+-(instancetype)initWithSession:(nonnull AWSMQTTSession *)session
+            decoderInputStream:(nonnull NSInputStream *)decoderInputStream
+           encoderOutputStream:(nonnull NSOutputStream *)encoderOutputStream
+                  outputStream:(nullable NSOutputStream *)outputStream
+                     eventLoop:(nullable AWSIoTStreamEventLoop *)eventLoop;
+
+- (void)start;
 - (void)cancelAndDisconnect:(BOOL)shouldDisconnect;
 @end
 
@@ -0,0 +1,166 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSIoTStreamConnection.h"
+#import <AWSCore/AWSDDLogMacros.h>
+
+@interface AWSIoTStreamConnection()
+
+@property(nonatomic, strong, nullable) AWSMQTTSession *session;
+@property(nonatomic, strong, nullable) NSOutputStream *encoderOutputStream;
+@property(nonatomic, strong, nullable) NSInputStream  *decoderInputStream;
+@property(nonatomic, strong, nullable) NSOutputStream *outputStream;
+@property(nonatomic, strong) AWSIoTStreamEventLoop *eventLoop;
+@property(assign) BOOL cancelled;
+@property(nonatomic, assign) BOOL shouldDisconnect;
+@property(atomic, assign) BOOL attached;
+@end
+
+@implementation AWSIoTStreamConnection
+
+- (nonnull instancetype)initWithSession:(nonnull AWSMQTTSession *)session
+                     decoderInputStream:(nonnull NSInputStream *)decoderInputStream
+                    encoderOutputStream:(nonnull NSOutputStream *)encoderOutputStream {
+    return [self initWithSession:session
+              decoderInputStream:decoderInputStream
+             encoderOutputStream:encoderOutputStream
+                    outputStream:nil];
+}
+
+-(instancetype)initWithSession:(nonnull AWSMQTTSession *)session
+            decoderInputStream:(nonnull NSInputStream *)decoderInputStream
+           encoderOutputStream:(nonnull NSOutputStream *)encoderOutputStream
+                  outputStream:(nullable NSOutputStream *)outputStream {
+    return [self initWithSession:session
+              decoderInputStream:decoderInputStream
+             encoderOutputStream:encoderOutputStream
+                    outputStream:outputStream
+                       eventLoop:nil];
+}
+
+-(instancetype)initWithSession:(nonnull AWSMQTTSession *)session
+            decoderInputStream:(nonnull NSInputStream *)decoderInputStream
+           encoderOutputStream:(nonnull NSOutputStream *)encoderOutputStream
+                  outputStream:(nullable NSOutputStream *)outputStream
+                     eventLoop:(nullable AWSIoTStreamEventLoop *)eventLoop {
+    if (self = [super init]) {
+        _session = session;
+        _decoderInputStream = decoderInputStream;
+        _encoderOutputStream = encoderOutputStream;
+        _outputStream = outputStream;
+        //Attached here rather than in start, so connections created one after another are spread over the event loops.
+        if (eventLoop) {
+            _eventLoop = eventLoop;
+            [_eventLoop attachConnection];
+        } else {
+            _eventLoop = [[AWSIoTStreamEventLoopGroup defaultGroup] attachConnectionToNextEventLoop];
+        }
+        _attached = YES;
+        _shouldDisconnect = NO;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    //A connection that was never stopped still counts against its event loop.
+    if (_attached) {
+        [_eventLoop detachConnection];
+    }
+}
+
+- (void)detachFromEventLoop {
+    @synchronized(self) {
+        if (!self.attached) {
+            return;
+        }
+        self.attached = NO;
+    }
+    [self.eventLoop detachConnection];
+}
+
+- (void)start {
+    AWSDDLogVerbose(@"Starting connection [%@] on event loop [%@]", self, self.eventLoop.thread);
+    [self.eventLoop performBlock:^{
+        if (self.outputStream) {
+            [self.outputStream scheduleInRunLoop:self.eventLoop.runLoop
+                                         forMode:NSDefaultRunLoopMode];
+            [self.outputStream open];
+        }
+
+        //The session schedules its encoder, decoder and timer in the current run loop, which is the event loop's.
+        [self.session connectToInputStream:self.decoderInputStream
+                              outputStream:self.encoderOutputStream];
+    }];
+}
+
+- (void)cancelAndDisconnect:(BOOL)shouldDisconnect {
+    @synchronized(self) {
+        if (self.cancelled) {
+            return;
+        }
+        self.cancelled = YES;
+    }
+    AWSDDLogVerbose(@"Issued Cancel and Disconnect = [%@] on connection [%@]", shouldDisconnect ? @"YES" : @"NO", self);
+    self.shouldDisconnect = shouldDisconnect;
+    //Runs after the start block, as blocks are performed on the event loop in order.
+    [self.eventLoop performBlock:^{
+        [self cleanUp];
+    }];
+}
+
+- (void)cleanUp {
+    NSRunLoop *runLoop = self.eventLoop.runLoop;
+
+    if (self.shouldDisconnect) {
+        if (self.session) {
+            [self.session close];
+            self.session = nil;
+        }
+
+        if (self.outputStream) {
+            self.outputStream.delegate = nil;
+            [self.outputStream close];
+            [self.outputStream removeFromRunLoop:runLoop
+                                         forMode:NSDefaultRunLoopMode];
+            self.outputStream = nil;
+        }
+
+        if (self.decoderInputStream) {
+            [self.decoderInputStream close];
+            self.decoderInputStream = nil;
+        }
+
+        if (self.encoderOutputStream) {
+            [self.encoderOutputStream close];
+            self.encoderOutputStream = nil;
+        }
+    } else {
+        //The event loop outlives this connection, so take its streams off the run loop
+        //to stop their events reaching the session without closing them.
+        AWSDDLogVerbose(@"Skipping disconnect for connection: [%@]", self);
+        [self.outputStream removeFromRunLoop:runLoop forMode:NSDefaultRunLoopMode];
+        [self.decoderInputStream removeFromRunLoop:runLoop forMode:NSDefaultRunLoopMode];
+        [self.encoderOutputStream removeFromRunLoop:runLoop forMode:NSDefaultRunLoopMode];
+    }
+
+    [self detachFromEventLoop];
+
+    if (self.onStop) {
+        self.onStop();
+        self.onStop = nil;
+    }
+}
+
+@end
@@ -0,0 +1,86 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A thread whose run loop hosts the streams and timers of many MQTT connections.
+
+ The run loop sleeps in the kernel until one of its streams is ready or a block is performed on it,
+ so an idle event loop costs no CPU however many connections it hosts.
+ */
+@interface AWSIoTStreamEventLoop : NSObject
+
+/// The run loop of the event loop's thread. Streams and timers are scheduled in its default mode.
+@property (nonatomic, readonly) NSRunLoop *runLoop;
+
+/// The thread the event loop runs on.
+@property (nonatomic, readonly) NSThread *thread;
+
+/// The number of connections attached to the event loop.
+@property (readonly) NSUInteger connectionCount;
+
+- (instancetype)initWithName:(NSString *)name;
+
+/**
+ Runs `block` on the event loop's thread, after the blocks performed before it.
+ */
+- (void)performBlock:(void (^)(void))block;
+
+- (void)attachConnection;
+- (void)detachConnection;
+
+/**
+ Stops the event loop's thread once the blocks already performed on it have run.
+ */
+- (void)stop;
+
+@end
+
+/**
+ A fixed set of event loops shared by the MQTT connections of a process.
+ */
+@interface AWSIoTStreamEventLoopGroup : NSObject
+
+@property (nonatomic, readonly) NSArray<AWSIoTStreamEventLoop *> *eventLoops;
+
+/**
+ The group used by `AWSIoTMQTTClient`, with one event loop per active processor, from 2 up to 4.
+ */
++ (instancetype)defaultGroup;
+
+- (instancetype)initWithEventLoopCount:(NSUInteger)eventLoopCount;
+
+/**
+ Returns the event loop hosting the fewest connections.
+ */
+- (AWSIoTStreamEventLoop *)nextEventLoop;
+
+/**
+ Attaches a connection to the event loop hosting the fewest connections and returns it. Choosing and attaching are
+ one step, so connections attached from several threads at once are still spread evenly.
+ */
+- (AWSIoTStreamEventLoop *)attachConnectionToNextEventLoop;
+
+/**
+ Stops every event loop of the group. The default group is never stopped.
+ */
+- (void)stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
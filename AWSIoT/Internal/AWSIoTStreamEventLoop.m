@@ -0,0 +1,146 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSIoTStreamEventLoop.h"
+#import <AWSCore/AWSDDLogMacros.h>
+
+@interface AWSIoTStreamEventLoop()
+
+@property (nonatomic, strong) NSRunLoop *runLoop;
+@property (nonatomic, strong) NSThread *thread;
+@property (assign) NSUInteger connectionCount;
+@property (atomic, assign) BOOL stopped;
+
+@end
+
+@implementation AWSIoTStreamEventLoop
+
+- (instancetype)initWithName:(NSString *)name {
+    if (self = [super init]) {
+        dispatch_semaphore_t started = dispatch_semaphore_create(0);
+        __weak AWSIoTStreamEventLoop *weakSelf = self;
+        _thread = [[NSThread alloc] initWithBlock:^{
+            [weakSelf runWithStartedSemaphore:started];
+        }];
+        _thread.name = name;
+        _thread.qualityOfService = NSQualityOfServiceUserInitiated;
+        [_thread start];
+        // The run loop is only known once the thread is running.
+        dispatch_semaphore_wait(started, DISPATCH_TIME_FOREVER);
+    }
+    return self;
+}
+
+- (void)runWithStartedSemaphore:(dispatch_semaphore_t)started {
+    NSRunLoop *runLoop = [NSRunLoop currentRunLoop];
+    self.runLoop = runLoop;
+
+    //An empty source keeps the run loop waiting in the kernel while no stream or timer is scheduled on it,
+    //instead of returning straight away.
+    CFRunLoopSourceContext sourceContext = {0};
+    CFRunLoopSourceRef source = CFRunLoopSourceCreate(NULL, 0, &sourceContext);
+    CFRunLoopAddSource([runLoop getCFRunLoop], source, kCFRunLoopDefaultMode);
+    dispatch_semaphore_signal(started);
+
+    AWSDDLogVerbose(@"Started event loop [%@]", [NSThread currentThread]);
+    while (!self.stopped) {
+        @autoreleasepool {
+            [runLoop runMode:NSDefaultRunLoopMode beforeDate:[NSDate distantFuture]];
+        }
+    }
+
+    CFRunLoopRemoveSource([runLoop getCFRunLoop], source, kCFRunLoopDefaultMode);
+    CFRelease(source);
+    AWSDDLogVerbose(@"Stopped event loop [%@]", [NSThread currentThread]);
+}
+
+- (void)performBlock:(void (^)(void))block {
+    CFRunLoopRef runLoop = [self.runLoop getCFRunLoop];
+    CFRunLoopPerformBlock(runLoop, kCFRunLoopDefaultMode, block);
+    CFRunLoopWakeUp(runLoop);
+}
+
+- (void)attachConnection {
+    @synchronized(self) {
+        self.connectionCount++;
+    }
+}
+
+- (void)detachConnection {
+    @synchronized(self) {
+        if (self.connectionCount > 0) {
+            self.connectionCount--;
+        }
+    }
+}
+
+- (void)stop {
+    [self performBlock:^{
+        self.stopped = YES;
+        CFRunLoopStop(CFRunLoopGetCurrent());
+    }];
+}
+
+@end
+
+@implementation AWSIoTStreamEventLoopGroup
+
++ (instancetype)defaultGroup {
+    static AWSIoTStreamEventLoopGroup *_defaultGroup = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSUInteger processorCount = [[NSProcessInfo processInfo] activeProcessorCount];
+        _defaultGroup = [[AWSIoTStreamEventLoopGroup alloc] initWithEventLoopCount:MIN(MAX(processorCount, 2), 4)];
+    });
+    return _defaultGroup;
+}
+
+- (instancetype)initWithEventLoopCount:(NSUInteger)eventLoopCount {
+    if (self = [super init]) {
+        NSMutableArray *eventLoops = [NSMutableArray arrayWithCapacity:eventLoopCount];
+        for (NSUInteger i = 0; i < MAX(eventLoopCount, 1); i++) {
+            NSString *name = [NSString stringWithFormat:@"com.amazonaws.iot.stream-event-loop.%lu", (unsigned long)i];
+            [eventLoops addObject:[[AWSIoTStreamEventLoop alloc] initWithName:name]];
+        }
+        _eventLoops = [eventLoops copy];
+    }
+    return self;
+}
+
+- (AWSIoTStreamEventLoop *)nextEventLoop {
+    AWSIoTStreamEventLoop *nextEventLoop = self.eventLoops.firstObject;
+    for (AWSIoTStreamEventLoop *eventLoop in self.eventLoops) {
+        if (eventLoop.connectionCount < nextEventLoop.connectionCount) {
+            nextEventLoop = eventLoop;
+        }
+    }
+    return nextEventLoop;
+}
+
+- (AWSIoTStreamEventLoop *)attachConnectionToNextEventLoop {
+    @synchronized(self) {
+        AWSIoTStreamEventLoop *eventLoop = [self nextEventLoop];
+        [eventLoop attachConnection];
+        return eventLoop;
+    }
+}
+
+- (void)stop {
+    for (AWSIoTStreamEventLoop *eventLoop in self.eventLoops) {
+        [eventLoop stop];
+    }
+}
+
+@end
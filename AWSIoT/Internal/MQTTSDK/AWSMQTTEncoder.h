@@ -32,6 +32,10 @@ typedef enum {
 
 @class AWSMQTTEncoder;
 
+// Called once a message has been handed to the stream in full (YES), or when it is dropped because the encoder is not
+// open or the stream failed (NO).
+typedef void (^AWSMQTTEncoderCompletionBlock)(BOOL written);
+
 @protocol AWSMQTTEncoderDelegate
 
 - (void)encoder:(AWSMQTTEncoder*)sender handleEvent:(AWSMQTTEncoderEvent)eventCode;
@@ -45,7 +49,16 @@ typedef enum {
 
 - (id)initWithStream:(NSOutputStream*)aStream;
 
+// Whether the message fits in an MQTT frame, whose remaining length is at most 268,435,455 bytes. Longer messages are
+// dropped by encodeMessage:.
++ (BOOL)isEncodableMessage:(AWSMQTTMessage*)msg;
+
+// Queues the message and returns without waiting for it to be written. Messages are written in the order they are
+// queued, one frame at a time. Messages are dropped unless the encoder is ready or sending. Closing the encoder, or a
+// stream failure, drops the queued messages and leaves the encoder in the end encountered or error status.
 - (void)encodeMessage:(AWSMQTTMessage*)msg;
+// As above, calling completionHandler on the encoder's queue when the message has been written or dropped.
+- (void)encodeMessage:(AWSMQTTMessage*)msg completionHandler:(AWSMQTTEncoderCompletionBlock)completionHandler;
 - (void)open;
 - (void)close;
 
@@ -15,27 +15,74 @@
 
 #import "AWSCocoaLumberjack.h"
 #import "AWSMQTTEncoder.h"
+#import "AWSMQTTRingBuffer.h"
+
+// Payloads up to this length are copied in behind the header so the frame goes out in one write. Longer payloads are
+// written from their own bytes.
+static const NSUInteger AWSMQTTEncoderCoalescedPayloadLength = 16 * 1024;
+// The frame buffer is kept for the next frame unless a frame grew it beyond this length.
+static const NSUInteger AWSMQTTEncoderRetainedFrameBufferLength = 64 * 1024;
+// The largest remaining length the four byte variable length encoding can express.
+static const NSUInteger AWSMQTTEncoderMaximumRemainingLength = 268435455;
+// Marks the encoder's queue, so that close can tell whether it is already running on it.
+static void *AWSMQTTEncoderQueueKey = &AWSMQTTEncoderQueueKey;
+
+@interface AWSMQTTEncoderPendingMessage : NSObject
+
+@property (nonatomic, strong) AWSMQTTMessage *message;
+@property (nonatomic, copy) AWSMQTTEncoderCompletionBlock completionHandler;
+
+@end
+
+@implementation AWSMQTTEncoderPendingMessage
+
+@end
 
 @interface AWSMQTTEncoder () {
-    NSMutableData*  buffer;
-    NSInteger       byteIndex;
+    // The fixed header, the variable header and small payloads of the frame being written.
+    UInt8*          frameBuffer;
+    NSUInteger      frameBufferCapacity;
+    NSUInteger      frameLength;
+    NSUInteger      frameIndex;
+    // A payload too long to coalesce, written after the frame buffer without being copied.
+    NSData*         payload;
+    NSUInteger      payloadIndex;
+    BOOL            writingFrame;
+    AWSMQTTEncoderCompletionBlock frameCompletionHandler;
 }
 
 @property (nonatomic, strong) dispatch_queue_t encodeQueue;
 @property (nonatomic, strong) NSOutputStream* stream;
+@property (nonatomic, strong) AWSMQTTRingBuffer<AWSMQTTEncoderPendingMessage *> *pendingMessages;
 @end
 
 @implementation AWSMQTTEncoder
 
 - (id)initWithStream:(NSOutputStream*)aStream
 {
-    _status = AWSMQTTEncoderStatusInitializing;
-    self.stream = aStream;
-    [self.stream setDelegate:self];
-    self.encodeQueue = dispatch_queue_create("com.amazon.aws.iot.encoder-queue", DISPATCH_QUEUE_SERIAL);
+    if (self = [super init]) {
+        _status = AWSMQTTEncoderStatusInitializing;
+        self.stream = aStream;
+        [self.stream setDelegate:self];
+        self.encodeQueue = dispatch_queue_create("com.amazon.aws.iot.encoder-queue", DISPATCH_QUEUE_SERIAL);
+        dispatch_queue_set_specific(self.encodeQueue, AWSMQTTEncoderQueueKey, (__bridge void *)self.encodeQueue, NULL);
+        self.pendingMessages = [[AWSMQTTRingBuffer alloc] initWithCapacity:16];
+    }
     return self;
 }
 
+- (void)dealloc {
+    free(frameBuffer);
+}
+
++ (BOOL)isEncodableMessage:(AWSMQTTMessage*)msg {
+    NSUInteger dataLength = [[msg data] length];
+    NSUInteger payloadLength = [[msg payload] length];
+    // Each length is compared on its own first, so their sum cannot overflow.
+    return dataLength <= AWSMQTTEncoderMaximumRemainingLength
+        && payloadLength <= AWSMQTTEncoderMaximumRemainingLength - dataLength;
+}
+
 - (void)open {
     AWSDDLogDebug(@"opening encoder stream.");
     [self.stream setDelegate:self];
@@ -45,9 +92,14 @@
 
 - (void)close {
     AWSDDLogDebug(@"closing encoder stream.");
-    [self.stream close];
-    [self.stream setDelegate:nil];
-    self.stream = nil;
+    // Closing on the encoder's queue lets messages queued before the close, such as DISCONNECT, be written first.
+    if (dispatch_get_specific(AWSMQTTEncoderQueueKey) == (__bridge void *)self.encodeQueue) {
+        [self closeStream];
+    } else {
+        dispatch_sync(self.encodeQueue, ^{
+            [self closeStream];
+        });
+    }
 }
 
 //This is executed in the runLoop.
@@ -89,92 +141,214 @@
 }
 
 - (void)encodeMessage:(AWSMQTTMessage*)msg {
-    dispatch_assert_queue_not(self.encodeQueue);
-    dispatch_sync(self.encodeQueue, ^{
-        [self encodeWhenReady:msg];
+    [self encodeMessage:msg completionHandler:nil];
+}
+
+- (void)encodeMessage:(AWSMQTTMessage*)msg completionHandler:(AWSMQTTEncoderCompletionBlock)completionHandler {
+    AWSMQTTEncoderPendingMessage *pendingMessage = [AWSMQTTEncoderPendingMessage new];
+    pendingMessage.message = msg;
+    pendingMessage.completionHandler = completionHandler;
+    dispatch_async(self.encodeQueue, ^{
+        [self encodeWhenReady:pendingMessage];
     });
 }
 
 # pragma mark - private/serial functions -
 
-- (void)encodeWhenReady:(AWSMQTTMessage*)msg {
+- (void)closeStream {
+    dispatch_assert_queue(self.encodeQueue);
+    [self.stream close];
+    [self.stream setDelegate:nil];
+    self.stream = nil;
+    if (_status != AWSMQTTEncoderStatusError) {
+        _status = AWSMQTTEncoderStatusEndEncountered;
+    }
+    [self dropPendingMessages];
+}
+
+- (void)encodeWhenReady:(AWSMQTTEncoderPendingMessage*)pendingMessage {
     dispatch_assert_queue(self.encodeQueue);
-    UInt8 header;
-    NSInteger n, length;
 
-    if (_status != AWSMQTTEncoderStatusReady) {
+    if (self.stream == nil || (_status != AWSMQTTEncoderStatusReady && _status != AWSMQTTEncoderStatusSending)) {
         AWSDDLogInfo(@"Encoder not ready");
+        if (pendingMessage.completionHandler) {
+            pendingMessage.completionHandler(NO);
+        }
         return;
     }
 
-    assert (buffer == NULL);
-    assert (byteIndex == 0);
+    [self.pendingMessages enqueue:pendingMessage];
+    if (!writingFrame) {
+        [self writeBytes];
+    }
+}
 
-    buffer = [[NSMutableData alloc] init];
+- (void)writeBytes {
+    dispatch_assert_queue(self.encodeQueue);
+
+    while (YES) {
+        if (self.stream == nil) {
+            [self dropPendingMessages];
+            return;
+        }
+        if (!writingFrame) {
+            AWSMQTTEncoderPendingMessage *pendingMessage = [self.pendingMessages dequeue];
+            if (pendingMessage == nil) {
+                _status = AWSMQTTEncoderStatusReady;
+                return;
+            }
+            if (![self prepareFrameForMessage:pendingMessage.message]) {
+                if (pendingMessage.completionHandler) {
+                    pendingMessage.completionHandler(NO);
+                }
+                continue;
+            }
+            frameCompletionHandler = pendingMessage.completionHandler;
+            writingFrame = YES;
+        }
+
+        NSInteger n = [self writeFrame];
+        if (n == -1) {
+            _status = AWSMQTTEncoderStatusError;
+            [self finishFrameWritten:NO];
+            [self dropPendingMessages];
+            [_delegate encoder:self handleEvent:AWSMQTTEncoderEventErrorOccurred];
+            return;
+        }
+        if (n == 0) {
+            // Wait for NSStreamEventHasSpaceAvailable to write the rest.
+            _status = AWSMQTTEncoderStatusSending;
+            return;
+        }
+        [self finishFrameWritten:YES];
+    }
+}
+
+// Lays out the fixed header, the message data and, if it is short, the payload in the frame buffer.
+- (BOOL)prepareFrameForMessage:(AWSMQTTMessage*)msg {
+    if (![AWSMQTTEncoder isEncodableMessage:msg]) {
+        AWSDDLogError(@"Dropping a message of type %d, which is longer than MQTT allows.", [msg type]);
+        return NO;
+    }
+    NSData *data = [msg data];
+    NSData *messagePayload = [msg payload];
+    NSUInteger remainingLength = [data length] + [messagePayload length];
 
     // encode fixed header
-    header = [msg type] << 4;
+    UInt8 header[5];
+    NSUInteger headerLength = 0;
+    header[headerLength] = [msg type] << 4;
     if ([msg isDuplicate]) {
-        header |= 0x08;
+        header[headerLength] |= 0x08;
     }
-    header |= [msg qos] << 1;
+    header[headerLength] |= [msg qos] << 1;
     if ([msg retainFlag]) {
-        header |= 0x01;
+        header[headerLength] |= 0x01;
     }
-    [buffer appendBytes:&header length:1];
+    headerLength++;
 
     // encode remaining length
-    length = [[msg data] length];
+    NSUInteger length = remainingLength;
     do {
         UInt8 digit = length % 128;
         length /= 128;
         if (length > 0) {
             digit |= 0x80;
         }
-        [buffer appendBytes:&digit length:1];
+        header[headerLength++] = digit;
     }
     while (length > 0);
 
-    // encode message data
-    if ([msg data] != NULL) {
-        [buffer appendData:[msg data]];
+    BOOL coalescesPayload = [messagePayload length] <= AWSMQTTEncoderCoalescedPayloadLength;
+    NSUInteger requiredLength = headerLength + [data length] + (coalescesPayload ? [messagePayload length] : 0);
+    if (requiredLength > frameBufferCapacity) {
+        UInt8 *grownBuffer = realloc(frameBuffer, requiredLength);
+        if (grownBuffer == NULL) {
+            AWSDDLogError(@"Failed to allocate a frame buffer of %lu bytes.", (unsigned long)requiredLength);
+            return NO;
+        }
+        frameBuffer = grownBuffer;
+        frameBufferCapacity = requiredLength;
+    }
+
+    memcpy(frameBuffer, header, headerLength);
+    frameLength = headerLength;
+    if ([data length] > 0) {
+        memcpy(frameBuffer + frameLength, [data bytes], [data length]);
+        frameLength += [data length];
+    }
+    if (coalescesPayload) {
+        if ([messagePayload length] > 0) {
+            memcpy(frameBuffer + frameLength, [messagePayload bytes], [messagePayload length]);
+            frameLength += [messagePayload length];
+        }
+        payload = nil;
+    } else {
+        payload = messagePayload;
+    }
+    frameIndex = 0;
+    payloadIndex = 0;
+    return YES;
+}
+
+// Returns 1 once the whole frame is written, 0 if the stream took part of it, and -1 if the stream failed.
+- (NSInteger)writeFrame {
+    if (frameIndex < frameLength) {
+        NSInteger n = [self.stream write:frameBuffer + frameIndex maxLength:frameLength - frameIndex];
+        if (n == -1) {
+            return -1;
+        }
+        frameIndex += n;
+        if (frameIndex < frameLength) {
+            return 0;
+        }
     }
 
-    n = [self.stream write:[buffer bytes] maxLength:[buffer length]];
-    if (n == -1) {
-        _status = AWSMQTTEncoderStatusError;
-        [_delegate encoder:self handleEvent:AWSMQTTEncoderEventErrorOccurred];
+    if (payloadIndex < [payload length]) {
+        NSInteger n = [self.stream write:(const UInt8*)[payload bytes] + payloadIndex maxLength:[payload length] - payloadIndex];
+        if (n == -1) {
+            return -1;
+        }
+        payloadIndex += n;
+        if (payloadIndex < [payload length]) {
+            return 0;
+        }
     }
-    else if (n < [buffer length]) {
-        byteIndex += n;
-        _status = AWSMQTTEncoderStatusSending;
+    return 1;
+}
+
+- (void)finishFrameWritten:(BOOL)written {
+    AWSMQTTEncoderCompletionBlock completionHandler = frameCompletionHandler;
+    frameCompletionHandler = nil;
+    writingFrame = NO;
+    frameLength = 0;
+    frameIndex = 0;
+    payload = nil;
+    payloadIndex = 0;
+
+    // Give back the memory of a frame that was far larger than usual.
+    if (frameBufferCapacity > AWSMQTTEncoderRetainedFrameBufferLength) {
+        free(frameBuffer);
+        frameBuffer = NULL;
+        frameBufferCapacity = 0;
     }
-    else {
-        buffer = NULL;
-        // XXX [delegate encoder:self handleEvent:MQTTEncoderEventReady];
+
+    if (completionHandler) {
+        completionHandler(written);
     }
 }
 
-- (void)writeBytes {
+- (void)dropPendingMessages {
     dispatch_assert_queue(self.encodeQueue);
-    UInt8* ptr;
-    NSInteger n, length;
-
-    ptr = (UInt8*) [buffer bytes] + byteIndex;
-    // Number of bytes pending for transfer
-    length = [buffer length] - byteIndex;
-    n = [self.stream write:ptr maxLength:length];
-    if (n == -1) {
-        _status = AWSMQTTEncoderStatusError;
-        [_delegate encoder:self handleEvent:AWSMQTTEncoderEventErrorOccurred];
-    }
-    else if (n < length) {
-        byteIndex += n;
-    }
-    else {
-        buffer = NULL;
-        byteIndex = 0;
-        _status = AWSMQTTEncoderStatusReady;
+
+    if (writingFrame) {
+        [self finishFrameWritten:NO];
+    }
+    AWSMQTTEncoderPendingMessage *pendingMessage;
+    while ((pendingMessage = [self.pendingMessages dequeue])) {
+        if (pendingMessage.completionHandler) {
+            pendingMessage.completionHandler(NO);
+        }
     }
 }
 
@@ -97,6 +97,11 @@ typedef enum {
 @property (assign) BOOL retainFlag;
 @property (assign) BOOL isDuplicate;
 @property (strong) NSData * data;
+// The application payload of an outbound PUBLISH, sent after data. It is held by reference rather than copied into data.
+@property (strong) NSData * payload;
+
+// data followed by payload, i.e. everything after the fixed header.
+- (NSData*)remainingData;
 
 @end
 
@@ -146,12 +146,13 @@
     AWSDDLogVerbose(@"Publish message on topic: %@, retain flag: %@", topic, retain ? @"true":@"false");
     NSMutableData* data = [NSMutableData data];
     [data AWSMQTT_appendMQTTString:topic];
-    [data appendData:payload];
     AWSMQTTMessage *msg = [[AWSMQTTMessage alloc] initWithType:AWSMQTTPublish
                                                      qos:0
                                               retainFlag:retain
                                                  dupFlag:false
                                                     data:data];
+    // Copying immutable data only retains it.
+    msg.payload = [payload copy];
     return msg;
 }
 
@@ -166,12 +167,12 @@
     NSMutableData* data = [NSMutableData data];
     [data AWSMQTT_appendMQTTString:topic];
     [data AWSMQTT_appendUInt16BigEndian:msgId];
-    [data appendData:payload];
     AWSMQTTMessage *msg = [[AWSMQTTMessage alloc] initWithType:AWSMQTTPublish
                                                      qos:qosLevel
                                               retainFlag:retain
                                                  dupFlag:dup
                                                     data:data];
+    msg.payload = [payload copy];
     return msg;
 }
 
@@ -242,6 +243,18 @@
     _isDuplicate = true;
 }
 
+- (NSData*)remainingData {
+    if ([self.payload length] == 0) {
+        return self.data;
+    }
+    NSMutableData* remainingData = [NSMutableData dataWithCapacity:[self.data length] + [self.payload length]];
+    if (self.data != nil) {
+        [remainingData appendData:self.data];
+    }
+    [remainingData appendData:self.payload];
+    return remainingData;
+}
+
 @end
 
 @implementation NSMutableData (AWSMQTT)
@@ -0,0 +1,46 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+@class AWSMQTTMessage;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A SQLite store for the QoS 1 and QoS 2 messages of one client that have not been acknowledged yet. `AWSMQTTSession`
+ saves each outbound PUBLISH, replaces it with the PUBREL once a QoS 2 message is received, and removes it on PUBACK or
+ PUBCOMP. A new session restores the stored messages and replays them with the DUP flag set.
+
+ Writes are applied asynchronously, in order, on a private queue. Reads wait for pending writes.
+ */
+@interface AWSMQTTOutbox : NSObject
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+                       clientId:(NSString *)clientId;
+
+- (void)saveMessage:(AWSMQTTMessage *)message
+          messageId:(UInt16)messageId;
+
+- (void)removeMessageId:(UInt16)messageId;
+
+- (void)removeAllMessages;
+
+/// Enumerates the stored messages in the order they were saved.
+- (void)enumerateMessagesUsingBlock:(void (^)(UInt16 messageId, AWSMQTTMessage *message))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,166 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSMQTTOutbox.h"
+#import <AWSCore/AWSFMDB.h>
+#import "AWSCocoaLumberjack.h"
+#import "AWSMQTTMessage.h"
+
+@interface AWSMQTTOutbox()
+
+@property (nonatomic, strong) AWSFMDatabaseQueue *databaseQueue;
+@property (nonatomic, strong) dispatch_queue_t writeQueue;
+@property (nonatomic, strong) NSString *clientId;
+
+@end
+
+@implementation AWSMQTTOutbox
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithFileURL:clientId:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+                       clientId:(NSString *)clientId {
+    if (self = [super init]) {
+        _clientId = clientId;
+        _writeQueue = dispatch_queue_create("com.amazonaws.AWSMQTTOutbox", DISPATCH_QUEUE_SERIAL);
+
+        NSError *error = nil;
+        if (![[NSFileManager defaultManager] createDirectoryAtURL:[fileURL URLByDeletingLastPathComponent]
+                                      withIntermediateDirectories:YES
+                                                       attributes:nil
+                                                            error:&error]) {
+            AWSDDLogError(@"Failed to create a directory for the MQTT outbox. [%@]", error);
+        }
+
+        _databaseQueue = [AWSFMDatabaseQueue serialDatabaseQueueWithPath:[fileURL path]];
+        [_databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            // Every publish and acknowledgement is a write; WAL keeps them from rewriting the whole page each time.
+            if (![db executeStatements:@"PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL"]) {
+                AWSDDLogError(@"Failed to enable WAL for the MQTT outbox. %@", db.lastError);
+            }
+
+            if (![db executeUpdate:
+                  @"CREATE TABLE IF NOT EXISTS outbox ("
+                  @"client_id TEXT NOT NULL,"
+                  @"message_id INTEGER NOT NULL,"
+                  @"type INTEGER NOT NULL,"
+                  @"qos INTEGER NOT NULL,"
+                  @"retain INTEGER NOT NULL,"
+                  @"data BLOB NOT NULL,"
+                  @"PRIMARY KEY (client_id, message_id))"]) {
+                AWSDDLogError(@"SQLite error. [%@]", db.lastError);
+            }
+        }];
+    }
+    return self;
+}
+
+- (void)saveMessage:(AWSMQTTMessage *)message
+          messageId:(UInt16)messageId {
+    NSDictionary *parameters = @{
+                                 @"client_id" : self.clientId,
+                                 @"message_id" : @(messageId),
+                                 @"type" : @(message.type),
+                                 @"qos" : @(message.qos),
+                                 @"retain" : @(message.retainFlag),
+                                 @"data" : [message remainingData] ?: [NSData data],
+                                 };
+    AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
+    dispatch_async(self.writeQueue, ^{
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            if (![db executeUpdate:
+                  @"INSERT OR REPLACE INTO outbox ("
+                  @"client_id, message_id, type, qos, retain, data"
+                  @") VALUES ("
+                  @":client_id, :message_id, :type, :qos, :retain, :data"
+                  @")"
+           withParameterDictionary:parameters]) {
+                AWSDDLogError(@"SQLite error. [%@]", db.lastError);
+            }
+        }];
+    });
+}
+
+- (void)removeMessageId:(UInt16)messageId {
+    NSDictionary *parameters = @{
+                                 @"client_id" : self.clientId,
+                                 @"message_id" : @(messageId),
+                                 };
+    AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
+    dispatch_async(self.writeQueue, ^{
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            if (![db executeUpdate:@"DELETE FROM outbox WHERE client_id = :client_id AND message_id = :message_id"
+           withParameterDictionary:parameters]) {
+                AWSDDLogError(@"SQLite error. [%@]", db.lastError);
+            }
+        }];
+    });
+}
+
+- (void)removeAllMessages {
+    NSDictionary *parameters = @{@"client_id" : self.clientId};
+    AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
+    dispatch_async(self.writeQueue, ^{
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            if (![db executeUpdate:@"DELETE FROM outbox WHERE client_id = :client_id"
+           withParameterDictionary:parameters]) {
+                AWSDDLogError(@"SQLite error. [%@]", db.lastError);
+            }
+        }];
+    });
+}
+
+- (void)enumerateMessagesUsingBlock:(void (^)(UInt16 messageId, AWSMQTTMessage *message))block {
+    NSMutableArray<NSNumber *> *messageIds = [NSMutableArray new];
+    NSMutableArray<AWSMQTTMessage *> *messages = [NSMutableArray new];
+    NSDictionary *parameters = @{@"client_id" : self.clientId};
+    AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
+
+    dispatch_sync(self.writeQueue, ^{
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            AWSFMResultSet *rs = [db executeQuery:
+                                  @"SELECT message_id, type, qos, retain, data "
+                                  @"FROM outbox "
+                                  @"WHERE client_id = :client_id "
+                                  @"ORDER BY rowid ASC"
+                          withParameterDictionary:parameters];
+            if (!rs) {
+                AWSDDLogError(@"SQLite error. [%@]", db.lastError);
+                return;
+            }
+            while ([rs next]) {
+                AWSMQTTMessage *message = [[AWSMQTTMessage alloc] initWithType:(UInt8)[rs intForColumn:@"type"]
+                                                                            qos:(UInt8)[rs intForColumn:@"qos"]
+                                                                     retainFlag:[rs boolForColumn:@"retain"]
+                                                                        dupFlag:NO
+                                                                           data:[rs dataForColumn:@"data"]];
+                [messageIds addObject:@([rs intForColumn:@"message_id"])];
+                [messages addObject:message];
+            }
+            [rs close];
+        }];
+    });
+
+    for (NSUInteger i = 0; i < [messages count]; i++) {
+        block([messageIds[i] unsignedShortValue], messages[i]);
+    }
+}
+
+@end
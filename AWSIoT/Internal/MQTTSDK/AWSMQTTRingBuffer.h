@@ -0,0 +1,35 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A FIFO queue backed by a circular buffer. Enqueue and dequeue are O(1); the buffer doubles when it is full and
+/// never shrinks. Not thread safe.
+@interface AWSMQTTRingBuffer<ObjectType> : NSObject
+
+@property (nonatomic, readonly) NSUInteger count;
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+- (void)enqueue:(ObjectType)object;
+- (nullable ObjectType)dequeue;
+- (nullable ObjectType)peek;
+- (void)removeAllObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,90 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSMQTTRingBuffer.h"
+
+@implementation AWSMQTTRingBuffer {
+    __strong id *_objects;
+    NSUInteger _capacity;
+    NSUInteger _head;
+    NSUInteger _count;
+}
+
+- (instancetype)init {
+    return [self initWithCapacity:16];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    if (self = [super init]) {
+        _capacity = MAX(capacity, 1);
+        _objects = (__strong id *)calloc(_capacity, sizeof(id));
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self removeAllObjects];
+    free(_objects);
+}
+
+- (NSUInteger)count {
+    return _count;
+}
+
+- (void)enqueue:(id)object {
+    if (_count == _capacity) {
+        [self grow];
+    }
+    _objects[(_head + _count) % _capacity] = object;
+    _count++;
+}
+
+- (id)dequeue {
+    if (_count == 0) {
+        return nil;
+    }
+    id object = _objects[_head];
+    _objects[_head] = nil;
+    _head = (_head + 1) % _capacity;
+    _count--;
+    return object;
+}
+
+- (id)peek {
+    return _count > 0 ? _objects[_head] : nil;
+}
+
+- (void)removeAllObjects {
+    while (_count > 0) {
+        [self dequeue];
+    }
+    _head = 0;
+}
+
+- (void)grow {
+    NSUInteger capacity = _capacity * 2;
+    __strong id *objects = (__strong id *)calloc(capacity, sizeof(id));
+    for (NSUInteger i = 0; i < _count; i++) {
+        NSUInteger index = (_head + i) % _capacity;
+        objects[i] = _objects[index];
+        _objects[index] = nil;
+    }
+    free(_objects);
+    _objects = objects;
+    _capacity = capacity;
+    _head = 0;
+}
+
+@end
@@ -16,6 +16,7 @@
 #import <Foundation/Foundation.h>
 
 @class AWSMQTTMessage;
+@class AWSMQTTOutbox;
 
 typedef enum {
     AWSMQTTSessionStatusCreated,
@@ -97,6 +98,10 @@ typedef enum {
              onMessageIdResolved:(void (^)(UInt16))onMessageIdResolved;
 - (void)publishJson:(id)payload onTopic:(NSString*)theTopic;
 
+#pragma mark Outbound Flow Control
+@property NSUInteger maxInflightPublishes; //The max number of QoS 1 and QoS 2 publishes awaiting acknowledgement. Further publishes are held in order until a slot frees up. 0 means unlimited.
+@property (nonatomic, strong) AWSMQTTOutbox *outbox; //Persists unacknowledged QoS 1 and QoS 2 publishes. Stored messages are restored when this is set and replayed once the session connects.
+
 - (BOOL)isReadyToPublish;
 - (void)send:(AWSMQTTMessage*)msg;
 
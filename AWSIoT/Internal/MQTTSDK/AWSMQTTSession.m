@@ -18,6 +18,8 @@
 #import "AWSMQTTDecoder.h"
 #import "AWSMQTTEncoder.h"
 #import "AWSMQttTxFlow.h"
+#import "AWSMQTTOutbox.h"
+#import "AWSMQTTRingBuffer.h"
 #import "AWSIoTMessage.h"
 #import "AWSIoTMessage+AWSMQTTMessage.h"
 
@@ -37,6 +39,7 @@
     NSMutableDictionary* txFlows; //Required for QOS1. Outbound publishes will be stored in txFlows until a PubAck is received
     NSMutableDictionary* rxFlows; //Required for handling QOS 2.
     unsigned int         retryThreshold; //used to throtttle retries. Overloading the publishes beyond service limit will result in message loss.
+    NSUInteger           encoderBacklog; //Messages handed to the encoder and not yet written or dropped. Accessed on drainSenderSerialQueue.
 }
 
 // private methods & properties
@@ -48,6 +51,7 @@
 
 - (void)newMessage:(AWSMQTTMessage*)msg;
 - (void)error:(AWSMQTTSessionEvent)event;
+- (void)notifyError:(NSNumber *)eventCode;
 - (void)handlePublish:(AWSMQTTMessage*)msg;
 - (void)handlePuback:(AWSMQTTMessage*)msg;
 - (void)handlePubrec:(AWSMQTTMessage*)msg;
@@ -57,7 +61,9 @@
 - (void)send:(AWSMQTTMessage*)msg;
 - (UInt16)nextMsgId;
 
-@property (strong,atomic) NSMutableArray* queue; //Queue to temporarily hold messages if encoder is busy sending another message
+@property (strong,atomic) AWSMQTTRingBuffer<AWSMQTTMessage *>* queue; //Queue to temporarily hold messages if encoder is busy sending another message
+@property (nonatomic, strong) NSMutableOrderedSet<NSNumber *>* inflightMsgIds; //QoS 1 and QoS 2 flows that have been sent and not yet acknowledged, in the order they were sent
+@property (nonatomic, strong) AWSMQTTRingBuffer<NSNumber *>* heldMsgIds; //Flows waiting for the session to connect or for room in the in-flight window
 @property (strong,atomic) NSMutableArray* timerRing; // circular array of 60. Each element is a set that contains the messages that need to be retried.
 @property (nonatomic, strong) dispatch_queue_t drainSenderSerialQueue;
 @property (nonatomic, strong) AWSMQTTEncoder* encoder; //Low level protocol handler that converts a message into out bound network data
@@ -66,6 +72,15 @@
 
 @end
 
+// At most this many messages wait in the encoder, the rest wait in the session queue. This is the capacity the encoder's
+// own queue starts with, so it never grows.
+static const NSUInteger AWSMQTTSessionMaximumEncoderBacklog = 16;
+
+static BOOL AWSMQTTEncoderIsOpen(AWSMQTTEncoder *encoder) {
+    AWSMQTTEncoderStatus encoderStatus = [encoder status];
+    return encoder != nil && (encoderStatus == AWSMQTTEncoderStatusReady || encoderStatus == AWSMQTTEncoderStatusSending);
+}
+
 @implementation AWSMQTTSession
 
 #pragma mark Initializer method
@@ -99,7 +114,9 @@
         keepAliveInterval = theKeepAliveInterval;
         connectMessage = msg;
         _publishRetryThrottle = publishRetryThrottle;
-        self.queue = [NSMutableArray array];
+        self.queue = [AWSMQTTRingBuffer new];
+        _inflightMsgIds = [NSMutableOrderedSet new];
+        _heldMsgIds = [AWSMQTTRingBuffer new];
         txMsgId = 1;
         txFlows = [[NSMutableDictionary alloc] init];
         rxFlows = [[NSMutableDictionary alloc] init];
@@ -226,16 +243,8 @@
                                                            msgId:msgId
                                                       retainFlag:retainFlag
                                                          dupFlag:false];
-    __block unsigned int deadline;
-    dispatch_sync(serialQueue, ^{
-        deadline = ticks + 60;
-    });
-    AWSMQttTxFlow *flow = [AWSMQttTxFlow flowWithMsg:msg
-                                            deadline:deadline];
-    [txFlows setObject:flow forKey:[NSNumber numberWithUnsignedInt:msgId]];
-    [[self.timerRing objectAtIndex:([flow deadline] % 60)] addObject:[NSNumber numberWithUnsignedInt:msgId]];
     AWSDDLogDebug(@"Published message %hu for QOS 1", msgId);
-    [self send:msg];
+    [self addFlowWithMsg:msg msgId:msgId];
     return msgId;
 }
 
@@ -264,11 +273,7 @@
                                                            msgId:msgId
                                                       retainFlag:retainFlag
                                                          dupFlag:false];
-    AWSMQttTxFlow *flow = [AWSMQttTxFlow flowWithMsg:msg
-                                            deadline:(ticks + 60)];
-    [txFlows setObject:flow forKey:[NSNumber numberWithUnsignedInt:msgId]];
-    [[self.timerRing objectAtIndex:([flow deadline] % 60)] addObject:[NSNumber numberWithUnsignedInt:msgId]];
-    [self send:msg];
+    [self addFlowWithMsg:msg msgId:msgId];
     return msgId;
 }
 
@@ -296,40 +301,53 @@
         }
     }
 
+    __block unsigned int currentTicks;
     dispatch_sync(serialQueue, ^{
-        ticks++;
+        currentTicks = ++self->ticks;
     });
-    NSEnumerator *e = [[[self.timerRing objectAtIndex:(ticks % 60)] allObjects] objectEnumerator];
-    id msgId;
-    
+
     //Stay under the throttle here and move the work to the next tick if throttle is breached.
     NSUInteger count = [self.queue count];
     [self drainSenderQueue];
-    while ((msgId = [e nextObject])) {
-        AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
-        AWSMQTTMessage *msg = [flow msg];
-        [flow setDeadline:(ticks + 60)];
-        [msg setDupFlag];
-        [self send:msg];
-        count++;
-        if ( count >= _publishRetryThrottle ) {
-            break;
+
+    //The flows and the timer ring are updated under the same lock as the send and ack paths; the messages are sent
+    //outside it.
+    NSMutableArray<AWSMQTTMessage *> *messages = [NSMutableArray new];
+    @synchronized(txFlows) {
+        NSEnumerator *e = [[[self.timerRing objectAtIndex:(currentTicks % 60)] allObjects] objectEnumerator];
+        id msgId;
+        while ((msgId = [e nextObject])) {
+            AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
+            AWSMQTTMessage *msg = [flow msg];
+            if (msg == nil) {
+                continue;
+            }
+            [flow setDeadline:(currentTicks + 60)];
+            [msg setDupFlag];
+            [messages addObject:msg];
+            count++;
+            if ( count >= _publishRetryThrottle ) {
+                break;
+            }
+        }
+
+        //The threshold has been breached, move the overflow to the next tick.
+        while ((msgId = [e nextObject])) {
+            AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
+            [flow setDeadline:((currentTicks +1) %  60)];
+            [[self.timerRing objectAtIndex:((currentTicks + 1) % 60)] addObject:msgId];
+            [[self.timerRing objectAtIndex:(currentTicks % 60)] removeObject:msgId];
         }
     }
-    
-    //The threshold has been breached, move the overflow to the next tick.
-    while ((msgId = [e nextObject])) {
-        AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
-        [flow setDeadline:((ticks +1) %  60)];
-        [[self.timerRing objectAtIndex:((ticks + 1) % 60)] addObject:msgId];
-        [[self.timerRing objectAtIndex:(ticks % 60)] removeObject:msgId];
+    for (AWSMQTTMessage *msg in messages) {
+        [self send:msg];
     }
-    
+
     if (count > 0 ) {
-        AWSDDLogVerbose(@"ClockTick: %d: republished %lu messages from timerHandler", ticks,(unsigned long)count);
+        AWSDDLogVerbose(@"ClockTick: %d: republished %lu messages from timerHandler", currentTicks,(unsigned long)count);
     }
     else {
-        AWSDDLogVerbose(@"ClockTick:%d: nothing to republish", ticks);
+        AWSDDLogVerbose(@"ClockTick:%d: nothing to republish", currentTicks);
     }
 }
 
@@ -352,7 +370,7 @@
                     case AWSMQTTSessionStatusConnected: {
                         dispatch_assert_queue_not(self.drainSenderSerialQueue);
                         dispatch_sync(self.drainSenderSerialQueue, ^{
-                            [self queueNextMessage];
+                            [self sendQueuedMessages];
                         });
                         break;
                     }
@@ -417,6 +435,7 @@
                                 
                                 [_delegate session:self handleEvent:AWSMQTTSessionEventConnected];
                                 [[NSRunLoop currentRunLoop] addTimer:self.timer forMode:NSDefaultRunLoopMode];
+                                [self replayFlows];
                             }
                             else {
                                 [self error:AWSMQTTSessionEventConnectionRefused];
@@ -568,8 +587,7 @@
         return;
     }
     
-    [[self.timerRing objectAtIndex:([flow deadline] % 60)] removeObject:msgId];
-    [txFlows removeObjectForKey:msgId];
+    [self completeFlowWithMsgId:msgId];
     AWSDDLogDebug(@"Removing msgID %@ from internal store for QOS1 guarantee", msgId);
     [self.delegate session:self newAckForMessageId:msgId.unsignedShortValue];
 }
@@ -584,19 +602,22 @@
     if ([msgId unsignedIntValue] == 0) {
         return;
     }
-    AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
-    if (flow == nil) {
-        return;
-    }
-    msg = [flow msg];
-    if ([msg type] != AWSMQTTPublish || [msg qos] != 2) {
-        return;
+    @synchronized(txFlows) {
+        AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
+        if (flow == nil) {
+            return;
+        }
+        msg = [flow msg];
+        if ([msg type] != AWSMQTTPublish || [msg qos] != 2) {
+            return;
+        }
+        msg = [AWSMQTTMessage pubrelMessageWithMessageId:[msgId unsignedIntValue]];
+        [flow setMsg:msg];
+        [[self.timerRing objectAtIndex:([flow deadline] % 60)] removeObject:msgId];
+        [flow setDeadline:[self flowDeadline]];
+        [[self.timerRing objectAtIndex:([flow deadline] % 60)] addObject:msgId];
     }
-    msg = [AWSMQTTMessage pubrelMessageWithMessageId:[msgId unsignedIntValue]];
-    [flow setMsg:msg];
-    [[self.timerRing objectAtIndex:([flow deadline] % 60)] removeObject:msgId];
-    [flow setDeadline:(ticks + 60)];
-    [[self.timerRing objectAtIndex:([flow deadline] % 60)] addObject:msgId];
+    [self.outbox saveMessage:msg messageId:[msgId unsignedShortValue]];
     
     [self send:msg];
 }
@@ -639,8 +660,7 @@
         return;
     }
     
-    [[self.timerRing objectAtIndex:([flow deadline] % 60)] removeObject:msgId];
-    [txFlows removeObjectForKey:msgId];
+    [self completeFlowWithMsgId:msgId];
 
     AWSDDLogDebug(@"Removing msgID %@ from internal store for QOS2 guarantee", msgId);
     [self.delegate session:self newAckForMessageId:msgId.unsignedShortValue];
@@ -661,29 +681,31 @@
     }
     status = AWSMQTTSessionStatusError;
     
-    usleep(1000000); // 1 sec delay
-    
-    [_delegate session:self handleEvent:eventCode];
+    //Notify after a 1 sec delay. The delay is scheduled on the current run loop rather than slept out,
+    //as the run loop is an event loop shared with other sessions.
+    [self performSelector:@selector(notifyError:) withObject:@(eventCode) afterDelay:1.0];
+}
+
+- (void)notifyError:(NSNumber *)eventCode {
+    [_delegate session:self handleEvent:(AWSMQTTSessionEvent)eventCode.intValue];
     
     if(_connectionHandler){
-        _connectionHandler(eventCode);
+        _connectionHandler((AWSMQTTSessionEvent)eventCode.intValue);
     }
-    
 }
 
 # pragma mark Message Send methods
 - (void)send:(AWSMQTTMessage*)msg {
-    if ([self.encoder status] == AWSMQTTEncoderStatusReady) {
-        [self drainSenderQueue];
-        AWSDDLogVerbose(@"<<%@>>: MQTTSession.send msg to server", [NSThread currentThread]);
-        [self.encoder encodeMessage:msg];
-    }
-    else {
-        dispatch_assert_queue_not(self.drainSenderSerialQueue);
-        dispatch_sync(self.drainSenderSerialQueue, ^{
-            [self queueMessage:msg];
-        });
+    if (![AWSMQTTEncoder isEncodableMessage:msg]) {
+        AWSDDLogError(@"Dropping a message of type %d, which is longer than MQTT allows.", [msg type]);
+        return;
     }
+    //Messages go out through the session queue, which holds them while the encoder is not ready or its backlog is full.
+    dispatch_assert_queue_not(self.drainSenderSerialQueue);
+    dispatch_sync(self.drainSenderSerialQueue, ^{
+        [self queueMessage:msg];
+        [self sendQueuedMessages];
+    });
 }
 
 - (UInt16)nextMsgId {
@@ -696,7 +718,7 @@
 
 - (BOOL)isReadyToPublish {
     AWSDDLogVerbose(@"<<%@>> MQTTEncoderStatus = %d", [NSThread currentThread],[self.encoder status]);
-    return self.encoder && [self.encoder status] == AWSMQTTEncoderStatusReady;
+    return AWSMQTTEncoderIsOpen(self.encoder) && encoderBacklog < AWSMQTTSessionMaximumEncoderBacklog;
 }
 
 - (void)drainSenderQueue {
@@ -706,23 +728,183 @@
     });
 }
 
+# pragma mark Outbound Flows
+
+- (void)setOutbox:(AWSMQTTOutbox *)outbox {
+    _outbox = outbox;
+    [outbox enumerateMessagesUsingBlock:^(UInt16 messageId, AWSMQTTMessage *msg) {
+        NSNumber *msgId = [NSNumber numberWithUnsignedInt:messageId];
+        @synchronized(self->txFlows) {
+            if ([self->txFlows objectForKey:msgId] != nil) {
+                return;
+            }
+            if ([msg type] == AWSMQTTPublish) {
+                [msg setDupFlag];
+            }
+            [self->txFlows setObject:[AWSMQttTxFlow flowWithMsg:msg deadline:0] forKey:msgId];
+            [self.heldMsgIds enqueue:msgId];
+        }
+        AWSDDLogDebug(@"Restored msgID %@ from the outbox", msgId);
+    }];
+}
+
+- (void)addFlowWithMsg:(AWSMQTTMessage*)msg msgId:(UInt16)msgId {
+    //A message too long to send would otherwise be stored and retried for good.
+    if (![AWSMQTTEncoder isEncodableMessage:msg]) {
+        AWSDDLogError(@"Dropping publish %hu, which is longer than MQTT allows.", msgId);
+        return;
+    }
+    NSNumber *key = [NSNumber numberWithUnsignedInt:msgId];
+    AWSMQttTxFlow *flow = [AWSMQttTxFlow flowWithMsg:msg deadline:0];
+    [self.outbox saveMessage:msg messageId:msgId];
+
+    BOOL shouldSend = NO;
+    @synchronized(txFlows) {
+        [txFlows setObject:flow forKey:key];
+        //Hold the message behind any earlier held message so that publishes go out in order.
+        if (status == AWSMQTTSessionStatusConnected && [self.heldMsgIds count] == 0 && [self hasInflightCapacity]) {
+            [self startFlow:flow msgId:key];
+            shouldSend = YES;
+        } else {
+            [self.heldMsgIds enqueue:key];
+        }
+    }
+    if (shouldSend) {
+        [self send:msg];
+    }
+}
+
+- (void)completeFlowWithMsgId:(NSNumber*)msgId {
+    NSMutableArray<AWSMQTTMessage *> *messages = [NSMutableArray new];
+    @synchronized(txFlows) {
+        AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
+        [[self.timerRing objectAtIndex:([flow deadline] % 60)] removeObject:msgId];
+        [txFlows removeObjectForKey:msgId];
+        [self.inflightMsgIds removeObject:msgId];
+        [self startHeldFlows:messages];
+    }
+    [self.outbox removeMessageId:[msgId unsignedShortValue]];
+    for (AWSMQTTMessage *msg in messages) {
+        [self send:msg];
+    }
+}
+
+//Resends the flows that were in flight when the connection dropped, with the DUP flag set, then starts held flows.
+- (void)replayFlows {
+    NSMutableArray<AWSMQTTMessage *> *messages = [NSMutableArray new];
+    @synchronized(txFlows) {
+        for (NSNumber *msgId in self.inflightMsgIds) {
+            AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
+            AWSMQTTMessage *msg = [flow msg];
+            if ([msg type] == AWSMQTTPublish) {
+                [msg setDupFlag];
+            }
+            [[self.timerRing objectAtIndex:([flow deadline] % 60)] removeObject:msgId];
+            [flow setDeadline:[self flowDeadline]];
+            [[self.timerRing objectAtIndex:([flow deadline] % 60)] addObject:msgId];
+            [messages addObject:msg];
+        }
+        [self startHeldFlows:messages];
+    }
+    if ([messages count] > 0) {
+        AWSDDLogDebug(@"Replaying %lu unacknowledged messages", (unsigned long)[messages count]);
+    }
+    for (AWSMQTTMessage *msg in messages) {
+        [self send:msg];
+    }
+}
+
+//Must be called while synchronized on txFlows. The started messages are added to `messages` to be sent outside the lock.
+- (void)startHeldFlows:(NSMutableArray<AWSMQTTMessage *> *)messages {
+    while (status == AWSMQTTSessionStatusConnected && [self.heldMsgIds count] > 0 && [self hasInflightCapacity]) {
+        NSNumber *msgId = [self.heldMsgIds dequeue];
+        AWSMQttTxFlow *flow = [txFlows objectForKey:msgId];
+        if (flow == nil) {
+            continue;
+        }
+        [self startFlow:flow msgId:msgId];
+        [messages addObject:[flow msg]];
+    }
+}
+
+//Must be called while synchronized on txFlows.
+- (void)startFlow:(AWSMQttTxFlow*)flow msgId:(NSNumber*)msgId {
+    [flow setDeadline:[self flowDeadline]];
+    [[self.timerRing objectAtIndex:([flow deadline] % 60)] addObject:msgId];
+    [self.inflightMsgIds addObject:msgId];
+}
+
+- (BOOL)hasInflightCapacity {
+    return self.maxInflightPublishes == 0 || [self.inflightMsgIds count] < self.maxInflightPublishes;
+}
+
+- (unsigned int)flowDeadline {
+    __block unsigned int deadline;
+    dispatch_sync(serialQueue, ^{
+        deadline = ticks + 60;
+    });
+    return deadline;
+}
+
 # pragma mark - private/serial functions -
 
-- (void)queueNextMessage {
+- (void)sendQueuedMessages {
+    dispatch_assert_queue(self.drainSenderSerialQueue);
+
+    while (self.queue.count > 0 && self.isReadyToPublish) {
+        AWSDDLogVerbose(@"<<%@>>: MQTTSession.send msg to server", [NSThread currentThread]);
+        [self encodeMessage:[self.queue dequeue]];
+    }
+}
+
+- (void)encodeMessage:(AWSMQTTMessage*)msg {
     dispatch_assert_queue(self.drainSenderSerialQueue);
 
-    if ([self.queue count] > 0) {
-        AWSDDLogDebug(@"Sending message from session queue");
-        AWSMQTTMessage *msg = [self.queue objectAtIndex:0];
-        [self.queue removeObjectAtIndex:0];
-        [self.encoder encodeMessage:msg];
+    AWSMQTTEncoder *encoder = self.encoder;
+    encoderBacklog++;
+    __weak AWSMQTTSession *weakSelf = self;
+    [encoder encodeMessage:msg completionHandler:^(BOOL written) {
+        AWSMQTTSession *session = weakSelf;
+        if (session == nil) {
+            return;
+        }
+        dispatch_async(session.drainSenderSerialQueue, ^{
+            [session encoder:encoder didFinishMessage:msg written:written];
+        });
+    }];
+}
+
+- (void)encoder:(AWSMQTTEncoder*)encoder didFinishMessage:(AWSMQTTMessage*)msg written:(BOOL)written {
+    dispatch_assert_queue(self.drainSenderSerialQueue);
+
+    encoderBacklog--;
+    //A message the encoder dropped on closing or on a stream failure goes back to the session queue, to be sent once
+    //the session has reconnected. Messages an open encoder refused would only be refused again.
+    if (!written && !AWSMQTTEncoderIsOpen(encoder) && [self shouldRequeueDroppedMessage:msg]) {
+        AWSDDLogDebug(@"Requeueing a message of type %d dropped by the encoder", [msg type]);
+        [self queueMessage:msg];
+    }
+    [self sendQueuedMessages];
+}
+
+- (BOOL)shouldRequeueDroppedMessage:(AWSMQTTMessage*)msg {
+    switch ([msg type]) {
+        case AWSMQTTPublish:
+            //QoS 1 and 2 publishes are still in flight and replayFlows resends them once the session reconnects.
+            return [msg qos] == 0;
+        case AWSMQTTSubscribe:
+        case AWSMQTTUnsubscribe:
+            return YES;
+        default:
+            //CONNECT, PINGREQ, DISCONNECT and acknowledgements belong to the connection that was lost.
+            return NO;
     }
 }
 
 - (void)queueMessage:(AWSMQTTMessage*)msg {
     dispatch_assert_queue(self.drainSenderSerialQueue);
 
-    [self.queue addObject:msg];
+    [self.queue enqueue:msg];
 }
 
 - (void)drainAllMessages {
@@ -731,9 +913,7 @@
     int count = 0;
     while (self.queue.count > 0 && count < _publishRetryThrottle && self.isReadyToPublish) {
         AWSDDLogDebug(@"Sending message from session queue" );
-        AWSMQTTMessage *msg = [self.queue objectAtIndex:0];
-        [self.queue removeObjectAtIndex:0];
-        [self.encoder encodeMessage:msg];
+        [self encodeMessage:[self.queue dequeue]];
         count = count + 1;
     }
 }
@@ -94,6 +94,9 @@ extern NSString *const AWSSRHTTPResponseErrorKey;
 // Send Data (can be nil) in a ping message.
 - (void)sendPing:(NSData *)data;
 
+// Number of bytes passed to send: that have not yet been written to the output stream, including framing. 0 once the socket has closed or failed.
+@property (nonatomic, readonly) NSUInteger bufferedAmount;
+
 @end
 
 #pragma mark - AWSSRWebSocketDelegate
@@ -17,6 +17,7 @@
 #import "AWSCocoaLumberjack.h"
 #import "AWSSRWebSocket.h"
 #import <errno.h>
+#import <stdatomic.h>
 
 //
 // In Xcode 7 there seems to be an issue linking against libicucore;
@@ -215,6 +216,7 @@ typedef void (^data_callback)(AWSSRWebSocket *webSocket,  NSData *data);
  
     NSMutableData *_outputBuffer;
     NSUInteger _outputBufferOffset;
+    _Atomic(NSUInteger) _bufferedAmount;
 
     uint8_t _currentFrameOpcode;
     size_t _currentFrameCount;
@@ -778,14 +780,31 @@ static __strong NSData *CRLFCRLF;
             return;
     }
     [_outputBuffer appendData:data];
+    atomic_fetch_add(&_bufferedAmount, data.length);
     [self _pumpWriting];
 }
 
+- (NSUInteger)bufferedAmount;
+{
+    return atomic_load(&_bufferedAmount);
+}
+
+// Saturates at 0, as a send still in flight when the socket closes releases its bytes after they were zeroed.
+- (void)_releaseBufferedAmount:(NSUInteger)length;
+{
+    NSUInteger bufferedAmount = atomic_load(&_bufferedAmount);
+    while (!atomic_compare_exchange_weak(&_bufferedAmount, &bufferedAmount, bufferedAmount - MIN(bufferedAmount, length))) {
+    }
+}
+
 - (void)send:(id)data;
 {
     NSAssert(self.readyState != AWSSR_CONNECTING, @"Invalid State: Cannot call send: until connection is open");
     // TODO: maybe not copy this for performance
     data = [data copy];
+    // Counted until the frame reaches _outputBuffer, which then accounts for it in _writeData:.
+    NSUInteger pendingLength = [data isKindOfClass:[NSData class]] ? [(NSData *)data length] : 0;
+    atomic_fetch_add(&_bufferedAmount, pendingLength);
     dispatch_async(_workQueue, ^{
         if ([data isKindOfClass:[NSString class]]) {
             [self _sendFrameWithOpcode:SROpCodeTextFrame data:[(NSString *)data dataUsingEncoding:NSUTF8StringEncoding]];
@@ -796,6 +815,7 @@ static __strong NSData *CRLFCRLF;
         } else {
             assert(NO);
         }
+        [self _releaseBufferedAmount:pendingLength];
     });
 }
 
@@ -1160,6 +1180,7 @@ static const uint8_t SRPayloadLenMask   = 0x7F;
         }
         
         _outputBufferOffset += bytesWritten;
+        [self _releaseBufferedAmount:(NSUInteger)bytesWritten];
         
         if (_outputBufferOffset > 4096 && _outputBufferOffset > (_outputBuffer.length >> 1)) {
             _outputBuffer = [[NSMutableData alloc] initWithBytes:(char *)_outputBuffer.bytes + _outputBufferOffset length:_outputBuffer.length - _outputBufferOffset];
@@ -1219,6 +1240,9 @@ static const uint8_t SRPayloadLenMask   = 0x7F;
 
 - (void)_scheduleCleanup
 {
+    // Nothing left in the output buffer will be written once the socket has closed or failed.
+    atomic_store(&_bufferedAmount, 0);
+
     @synchronized(self) {
         if (_cleanupScheduled) {
             return;
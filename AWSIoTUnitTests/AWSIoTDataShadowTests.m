@@ -0,0 +1,397 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSIoT.h"
+#import "AWSIoTShadowDocument.h"
+
+@interface AWSIoTDataManager()
+
+- (BOOL)handleMessagesForShadow:(NSString *)name
+                      operation:(AWSIoTShadowOperationType)operation
+                         status:(AWSIoTShadowOperationStatusType)status
+                        payload:(NSData *)payload;
+
+@end
+
+static NSData *AWSIoTShadowTestData(NSString *string) {
+    return [string dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+@interface AWSIoTDataShadowTests : XCTestCase
+
+@property (nonatomic, strong) id dataManager;
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *published;
+@property (nonatomic, strong) NSMutableArray<NSArray *> *events;
+
+@end
+
+@implementation AWSIoTDataShadowTests
+
+- (void)setUp {
+    [super setUp];
+
+    AWSStaticCredentialsProvider *credentialsProvider = [[AWSStaticCredentialsProvider alloc] initWithAccessKey:@"testAccessKey"
+                                                                                                       secretKey:@"testSecretKey"];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                                    endpoint:[[AWSEndpoint alloc] initWithURLString:@"TESTENDPOINT.iot.amazonaws.com"]
+                                                                         credentialsProvider:credentialsProvider];
+    NSString *key = [[NSUUID UUID] UUIDString];
+    [AWSIoTDataManager registerIoTDataManagerWithConfiguration:configuration forKey:key];
+
+    self.published = [NSMutableArray new];
+    self.events = [NSMutableArray new];
+    self.dataManager = OCMPartialMock([AWSIoTDataManager IoTDataManagerForKey:key]);
+
+    NSMutableArray *published = self.published;
+    OCMStub([self.dataManager publishData:[OCMArg any] onTopic:[OCMArg any] QoS:AWSIoTMQTTQoSMessageDeliveryAttemptedAtMostOnce])
+    .andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSData *data;
+        __unsafe_unretained NSString *topic;
+        [invocation getArgument:&data atIndex:2];
+        [invocation getArgument:&topic atIndex:3];
+        BOOL rc = YES;
+        [invocation setReturnValue:&rc];
+        @synchronized(published) {
+            [published addObject:@{@"topic" : topic,
+                                   @"state" : [NSJSONSerialization JSONObjectWithData:data options:0 error:nil]}];
+        }
+    });
+}
+
+- (void)tearDown {
+    [self.dataManager stopMocking];
+    [super tearDown];
+}
+
+- (void)registerShadowWithOptions:(NSDictionary *)options {
+    NSMutableArray *events = self.events;
+    [self.dataManager registerWithShadow:@"thing"
+                                 options:options
+                           eventCallback:^(NSString *name, AWSIoTShadowOperationType operation, AWSIoTShadowOperationStatusType status, NSString *clientToken, NSData *payload) {
+                               @synchronized(events) {
+                                   [events addObject:@[@(operation), @(status), clientToken ?: [NSNull null]]];
+                               }
+                           }];
+}
+
+- (void)respondWithStatus:(AWSIoTShadowOperationStatusType)status
+                operation:(AWSIoTShadowOperationType)operation
+                  payload:(NSString *)payload {
+    [self.dataManager handleMessagesForShadow:@"thing"
+                                    operation:operation
+                                       status:status
+                                      payload:AWSIoTShadowTestData(payload)];
+}
+
+#pragma mark - Payload scanning
+
+- (void)testScanPayloadReadsTopLevelFields {
+    NSNumber *version = nil;
+    NSString *clientToken = nil;
+    NSString *payload = @"{\"state\":{\"reported\":{\"version\":3,\"clientToken\":\"inner\",\"s\":\"}{\\\"\"}},"
+                        @"\"metadata\":{\"version\":7},\"version\" : 42 ,\"timestamp\":1,\"clientToken\":\"outer\"}";
+    XCTAssertTrue(AWSIoTShadowScanPayload(AWSIoTShadowTestData(payload), &version, &clientToken));
+    XCTAssertEqualObjects(version, @42);
+    XCTAssertEqualObjects(clientToken, @"outer");
+}
+
+- (void)testScanPayloadUnescapesClientToken {
+    NSString *clientToken = nil;
+    XCTAssertTrue(AWSIoTShadowScanPayload(AWSIoTShadowTestData(@"{\"clientToken\":\"a\\\"b\\u00e9\"}"), NULL, &clientToken));
+    XCTAssertEqualObjects(clientToken, @"a\"bé");
+}
+
+- (void)testScanPayloadMissingFields {
+    NSNumber *version = @1;
+    NSString *clientToken = @"stale";
+    XCTAssertTrue(AWSIoTShadowScanPayload(AWSIoTShadowTestData(@" { } "), &version, &clientToken));
+    XCTAssertNil(version);
+    XCTAssertNil(clientToken);
+
+    XCTAssertTrue(AWSIoTShadowScanPayload(AWSIoTShadowTestData(@"{\"version\":\"5\",\"state\":[1,{\"a\":[]}]}"), &version, &clientToken));
+    XCTAssertNil(version);
+}
+
+- (void)testScanPayloadRejectsMalformedInput {
+    for (NSString *payload in @[@"", @"[]", @"timeout", @"{\"version\":1", @"{\"state\":{\"a\":1}", @"{\"a\" 1}", @"{\"unterminated}"]) {
+        XCTAssertFalse(AWSIoTShadowScanPayload(AWSIoTShadowTestData(payload), NULL, NULL), @"%@", payload);
+    }
+}
+
+#pragma mark - State merging
+
+- (void)testMergeState {
+    NSMutableDictionary *target = [@{@"a" : @1, @"b" : @{@"c" : @2, @"d" : @3}, @"e" : @"x"} mutableCopy];
+    AWSIoTShadowMergeState(target, @{@"a" : [NSNull null], @"b" : @{@"c" : @4, @"d" : [NSNull null]}, @"e" : @{@"f" : @5}});
+    XCTAssertEqualObjects(target, (@{@"b" : @{@"c" : @4}, @"e" : @{@"f" : @5}}));
+    XCTAssertTrue([target[@"b"] isKindOfClass:[NSMutableDictionary class]]);
+
+    NSMutableDictionary *update = [@{@"state" : @{@"reported" : @{@"a" : @1, @"b" : @{@"c" : @2}}}} mutableCopy];
+    AWSIoTShadowMergeUpdates(update, @{@"state" : @{@"reported" : @{@"a" : [NSNull null], @"b" : @{@"d" : @3}}}});
+    XCTAssertEqualObjects(update, (@{@"state" : @{@"reported" : @{@"a" : [NSNull null], @"b" : @{@"c" : @2, @"d" : @3}}}}));
+}
+
+- (void)testDocumentMerges {
+    AWSIoTShadowDocument *document = [AWSIoTShadowDocument new];
+    XCTAssertNil([document snapshot]);
+
+    [document replaceWithDocument:@{@"state" : @{@"desired" : @{@"color" : @"red"}, @"reported" : @{@"color" : @"blue"}, @"delta" : @{@"color" : @"red"}},
+                                    @"version" : @4}];
+    [document mergeDelta:@{@"state" : @{@"power" : @"on"}, @"version" : @5}];
+    [document mergeUpdate:@{@"state" : @{@"reported" : @{@"color" : @"red", @"power" : @"on"}}, @"version" : @6}];
+    [document mergeUpdate:@{@"state" : @{@"reported" : @{@"color" : @"green"}}, @"version" : @3}];
+
+    NSDictionary *expected = @{@"state" : @{@"desired" : @{@"color" : @"red", @"power" : @"on"},
+                                            @"reported" : @{@"color" : @"green", @"power" : @"on"}},
+                               @"version" : @6};
+    XCTAssertEqualObjects([document snapshot], expected);
+
+    [document clear];
+    XCTAssertNil([document snapshot]);
+}
+
+#pragma mark - Pipelined operations
+
+- (void)testSingleOperationByDefault {
+    [self registerShadowWithOptions:nil];
+
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":1}}}" clientToken:@"t1"]);
+    XCTAssertFalse([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":2}}}" clientToken:@"t2"]);
+    XCTAssertEqual(self.published.count, 1);
+
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{\"desired\":{\"a\":1}},\"version\":1,\"clientToken\":\"t1\"}"];
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":2}}}" clientToken:@"t2"]);
+    XCTAssertEqual(self.published.count, 2);
+}
+
+- (void)testPipelinedOperationsMatchResponsesByClientToken {
+    [self registerShadowWithOptions:@{@"maxPendingOperations" : @3}];
+
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":1}}}" clientToken:@"t1"]);
+    XCTAssertTrue([self.dataManager getShadow:@"thing" clientToken:@"t2"]);
+    XCTAssertFalse([self.dataManager getShadow:@"thing" clientToken:@"t2"]);
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":3}}}" clientToken:@"t3"]);
+    XCTAssertFalse([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":4}}}" clientToken:@"t4"]);
+    XCTAssertEqual(self.published.count, 3);
+
+    // Responses arrive out of order.
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeGet
+                    payload:@"{\"state\":{},\"version\":1,\"clientToken\":\"t2\"}"];
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeRejected
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"code\":409,\"clientToken\":\"t3\"}"];
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{},\"version\":2,\"clientToken\":\"t1\"}"];
+    // A second response for a completed operation is not reported again.
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{},\"version\":3,\"clientToken\":\"t1\"}"];
+
+    NSArray *expected = @[@[@(AWSIoTShadowOperationTypeGet), @(AWSIoTShadowOperationStatusTypeAccepted), @"t2"],
+                          @[@(AWSIoTShadowOperationTypeUpdate), @(AWSIoTShadowOperationStatusTypeRejected), @"t3"],
+                          @[@(AWSIoTShadowOperationTypeUpdate), @(AWSIoTShadowOperationStatusTypeAccepted), @"t1"]];
+    XCTAssertEqualObjects(self.events, expected);
+}
+
+- (void)testPipelinedUpdatesExpectConsecutiveVersions {
+    [self registerShadowWithOptions:@{@"maxPendingOperations" : @3}];
+    XCTAssertTrue([self.dataManager getShadow:@"thing" clientToken:@"get"]);
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeGet
+                    payload:@"{\"state\":{},\"version\":5,\"clientToken\":\"get\"}"];
+
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":1}}}" clientToken:@"t1"]);
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":2}}}" clientToken:@"t2"]);
+    // The delta for the first update can arrive before its accepted response.
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeDelta
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{\"a\":1},\"version\":6}"];
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":3}}}" clientToken:@"t3"]);
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{},\"version\":6,\"clientToken\":\"t1\"}"];
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"desired\":{\"a\":4}}}" clientToken:@"t4"]);
+
+    NSArray *versions = [self.published valueForKeyPath:@"state.version"];
+    XCTAssertEqualObjects(versions, (@[[NSNull null], @5, @6, @7, @8]));
+}
+
+- (void)testPipelinedOperationTimesOutIndividually {
+    [self registerShadowWithOptions:@{@"maxPendingOperations" : @2, @"shadowOperationTimeoutSeconds" : @0.2}];
+
+    XCTAssertTrue([self.dataManager getShadow:@"thing" clientToken:@"t1"]);
+    XCTAssertTrue([self.dataManager getShadow:@"thing" clientToken:@"t2"]);
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeGet
+                    payload:@"{\"state\":{},\"version\":1,\"clientToken\":\"t1\"}"];
+
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+    NSArray *expected = @[@[@(AWSIoTShadowOperationTypeGet), @(AWSIoTShadowOperationStatusTypeAccepted), @"t1"],
+                          @[@(AWSIoTShadowOperationTypeGet), @(AWSIoTShadowOperationStatusTypeTimeout), @"t2"]];
+    XCTAssertEqualObjects(self.events, expected);
+}
+
+#pragma mark - Update coalescing
+
+- (void)testCoalescedUpdatesArePublishedTogether {
+    [self registerShadowWithOptions:@{@"updateCoalescingSeconds" : @0.1}];
+
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"a\":1,\"b\":1}}}"]);
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"b\":2}}}"]);
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"c\":null}}}" clientToken:@"last"]);
+    XCTAssertEqual(self.published.count, 0);
+
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+
+    XCTAssertEqual(self.published.count, 1);
+    NSDictionary *state = self.published.firstObject[@"state"];
+    XCTAssertEqualObjects(state[@"state"], (@{@"reported" : @{@"a" : @1, @"b" : @2, @"c" : [NSNull null]}}));
+    XCTAssertEqualObjects(state[@"clientToken"], @"last");
+}
+
+- (void)testSupersededCoalescedUpdatesCompleteWithMergedResult {
+    [self registerShadowWithOptions:@{@"updateCoalescingSeconds" : @0.05, @"shadowOperationTimeoutSeconds" : @0.2}];
+
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"a\":1}}}" clientToken:@"first"]);
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"b\":2}}}" clientToken:@"second"]);
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    XCTAssertEqualObjects(self.published.lastObject[@"state"][@"clientToken"], @"second");
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{},\"version\":1,\"clientToken\":\"second\"}"];
+
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"a\":3}}}" clientToken:@"third"]);
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"b\":4}}}" clientToken:@"fourth"]);
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+    NSArray *expected = @[@[@(AWSIoTShadowOperationTypeUpdate), @(AWSIoTShadowOperationStatusTypeAccepted), @"second"],
+                          @[@(AWSIoTShadowOperationTypeUpdate), @(AWSIoTShadowOperationStatusTypeAccepted), @"first"],
+                          @[@(AWSIoTShadowOperationTypeUpdate), @(AWSIoTShadowOperationStatusTypeTimeout), @"fourth"],
+                          @[@(AWSIoTShadowOperationTypeUpdate), @(AWSIoTShadowOperationStatusTypeTimeout), @"third"]];
+    XCTAssertEqualObjects(self.events, expected);
+}
+
+- (void)testCoalescedUpdateWaitsForPendingOperation {
+    [self registerShadowWithOptions:@{@"updateCoalescingSeconds" : @0.05}];
+
+    XCTAssertTrue([self.dataManager getShadow:@"thing" clientToken:@"get"]);
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"a\":1}}}"]);
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertEqual(self.published.count, 1);
+
+    XCTAssertTrue([self.dataManager updateShadow:@"thing" jsonString:@"{\"state\":{\"reported\":{\"b\":2}}}"]);
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeGet
+                    payload:@"{\"state\":{},\"version\":1,\"clientToken\":\"get\"}"];
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+
+    XCTAssertEqual(self.published.count, 2);
+    XCTAssertEqualObjects(self.published.lastObject[@"state"][@"state"], (@{@"reported" : @{@"a" : @1, @"b" : @2}}));
+}
+
+#pragma mark - Document cache
+
+- (void)testDocumentCacheFollowsShadowMessages {
+    [self registerShadowWithOptions:@{@"enableDocumentCache" : @YES, @"maxPendingOperations" : @2}];
+    XCTAssertNil([self.dataManager cachedDocumentForShadow:@"thing"]);
+    XCTAssertNil([self.dataManager cachedDocumentForShadow:@"unknown"]);
+
+    XCTAssertTrue([self.dataManager getShadow:@"thing" clientToken:@"get"]);
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeGet
+                    payload:@"{\"state\":{\"desired\":{\"color\":\"red\"},\"reported\":{\"color\":\"blue\"}},"
+                            @"\"metadata\":{},\"version\":4,\"clientToken\":\"get\"}"];
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeDelta
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{\"power\":\"on\"},\"version\":5}"];
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{\"reported\":{\"color\":\"red\",\"power\":\"on\"}},\"version\":6,\"clientToken\":\"other\"}"];
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeRejected
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"code\":400,\"message\":\"bad\",\"version\":9}"];
+
+    NSDictionary *expected = @{@"state" : @{@"desired" : @{@"color" : @"red", @"power" : @"on"},
+                                            @"reported" : @{@"color" : @"red", @"power" : @"on"}},
+                               @"version" : @6};
+    XCTAssertEqualObjects([self.dataManager cachedDocumentForShadow:@"thing"], expected);
+
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeDocuments
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"previous\":{},\"current\":{\"state\":{\"desired\":{\"color\":\"green\"}},\"version\":7},\"timestamp\":1}"];
+    XCTAssertEqualObjects([self.dataManager cachedDocumentForShadow:@"thing"],
+                          (@{@"state" : @{@"desired" : @{@"color" : @"green"}}, @"version" : @7}));
+
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeAccepted
+                  operation:AWSIoTShadowOperationTypeDelete
+                    payload:@"{\"version\":8,\"timestamp\":1}"];
+    XCTAssertNil([self.dataManager cachedDocumentForShadow:@"thing"]);
+}
+
+- (void)testDocumentCacheIsOffByDefault {
+    [self registerShadowWithOptions:nil];
+    [self respondWithStatus:AWSIoTShadowOperationStatusTypeDelta
+                  operation:AWSIoTShadowOperationTypeUpdate
+                    payload:@"{\"state\":{\"power\":\"on\"},\"version\":5}"];
+    XCTAssertNil([self.dataManager cachedDocumentForShadow:@"thing"]);
+}
+
+#pragma mark - Performance
+
+- (NSData *)largeShadowPayload {
+    NSMutableDictionary *reported = [NSMutableDictionary new];
+    NSMutableDictionary *metadata = [NSMutableDictionary new];
+    for (NSUInteger i = 0; i < 200; i++) {
+        NSString *key = [NSString stringWithFormat:@"sensor%lu", (unsigned long)i];
+        reported[key] = @{@"value" : @(i), @"unit" : @"celsius", @"history" : @[@1, @2, @3, @4]};
+        metadata[key] = @{@"value" : @{@"timestamp" : @1700000000}, @"unit" : @{@"timestamp" : @1700000000}};
+    }
+    NSDictionary *document = @{@"state" : @{@"reported" : reported},
+                               @"metadata" : @{@"reported" : metadata},
+                               @"version" : @1234,
+                               @"timestamp" : @1700000000,
+                               @"clientToken" : @"token"};
+    return [NSJSONSerialization dataWithJSONObject:document options:0 error:nil];
+}
+
+- (void)testScanPayloadPerformance {
+    NSData *payload = [self largeShadowPayload];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            NSNumber *version = nil;
+            NSString *clientToken = nil;
+            AWSIoTShadowScanPayload(payload, &version, &clientToken);
+        }
+    }];
+}
+
+- (void)testFullParsePerformance {
+    NSData *payload = [self largeShadowPayload];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            NSDictionary *document = [NSJSONSerialization JSONObjectWithData:payload options:NSJSONReadingMutableContainers error:nil];
+            (void)document[@"version"];
+        }
+    }];
+}
+
+@end
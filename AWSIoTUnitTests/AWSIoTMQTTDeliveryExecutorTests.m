@@ -0,0 +1,427 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSIoTMQTTDeliveryExecutor.h"
+
+@interface AWSIoTMQTTDeliveryExecutorTests : XCTestCase
+
+@property (nonatomic, strong) dispatch_semaphore_t gateEntered;
+@property (nonatomic, strong) dispatch_semaphore_t gateOpened;
+
+@end
+
+@implementation AWSIoTMQTTDeliveryExecutorTests
+
++ (AWSIoTMessage *)messageWithTopic:(NSString *)topic index:(NSUInteger)index {
+    AWSIoTMessage *message = [AWSIoTMessage new];
+    message.topic = topic;
+    message.messageData = [[NSString stringWithFormat:@"%lu", (unsigned long)index] dataUsingEncoding:NSUTF8StringEncoding];
+    return message;
+}
+
++ (NSUInteger)indexOfMessage:(AWSIoTMessage *)message {
+    return (NSUInteger)[[[NSString alloc] initWithData:message.messageData encoding:NSUTF8StringEncoding] integerValue];
+}
+
++ (AWSIoTMQTTDeliveryConfiguration *)serialConfiguration {
+    AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryConfiguration new];
+    configuration.maximumConcurrentDeliveries = 1;
+    return configuration;
+}
+
+- (void)setUp {
+    self.gateEntered = dispatch_semaphore_create(0);
+    self.gateOpened = dispatch_semaphore_create(0);
+}
+
+// Occupies the executor's only worker until `openGate` is called.
+- (void)closeGateOnExecutor:(AWSIoTMQTTDeliveryExecutor *)executor {
+    dispatch_semaphore_t gateEntered = self.gateEntered;
+    dispatch_semaphore_t gateOpened = self.gateOpened;
+    [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"gate" index:0]
+                      forKey:@"gate"
+                    priority:AWSIoTMQTTDeliveryPriorityHigh
+                     handler:^(NSArray<AWSIoTMessage *> *messages) {
+        dispatch_semaphore_signal(gateEntered);
+        dispatch_semaphore_wait(gateOpened, DISPATCH_TIME_FOREVER);
+    }];
+    dispatch_semaphore_wait(gateEntered, DISPATCH_TIME_FOREVER);
+}
+
+- (void)openGate {
+    dispatch_semaphore_signal(self.gateOpened);
+}
+
+- (void)testDeliversEachTopicInOrder {
+    AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryConfiguration new];
+    configuration.capacity = 0;
+    configuration.maximumBatchSize = 8;
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:configuration];
+
+    NSUInteger topicCount = 10;
+    NSUInteger messageCount = 500;
+    NSMutableDictionary<NSString *, NSMutableArray<NSNumber *> *> *deliveredIndexes = [NSMutableDictionary dictionary];
+    XCTestExpectation *delivered = [self expectationWithDescription:@"Messages delivered"];
+    delivered.expectedFulfillmentCount = topicCount * messageCount;
+
+    for (NSUInteger i = 0; i < messageCount; i++) {
+        for (NSUInteger t = 0; t < topicCount; t++) {
+            NSString *topic = [NSString stringWithFormat:@"devices/%lu", (unsigned long)t];
+            [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:topic index:i]
+                              forKey:topic
+                            priority:AWSIoTMQTTDeliveryPriorityDefault
+                             handler:^(NSArray<AWSIoTMessage *> *messages) {
+                XCTAssertLessThanOrEqual(messages.count, 8);
+                for (AWSIoTMessage *message in messages) {
+                    @synchronized (deliveredIndexes) {
+                        NSMutableArray *indexes = deliveredIndexes[topic] ?: [NSMutableArray array];
+                        deliveredIndexes[topic] = indexes;
+                        [indexes addObject:@([AWSIoTMQTTDeliveryExecutorTests indexOfMessage:message])];
+                    }
+                    [delivered fulfill];
+                }
+            }];
+        }
+    }
+    [self waitForExpectations:@[delivered] timeout:10];
+
+    for (NSString *topic in deliveredIndexes) {
+        NSArray<NSNumber *> *indexes = deliveredIndexes[topic];
+        XCTAssertEqual(indexes.count, messageCount);
+        for (NSUInteger i = 0; i < indexes.count; i++) {
+            XCTAssertEqual(indexes[i].unsignedIntegerValue, i, @"Out of order on %@", topic);
+        }
+    }
+    AWSIoTMQTTDeliveryMetrics *metrics = [executor metrics];
+    XCTAssertEqual(metrics.deliveredMessageCount, topicCount * messageCount);
+    XCTAssertEqual(metrics.queuedMessageCount, 0);
+    XCTAssertEqual(metrics.droppedMessageCount, 0);
+}
+
+- (void)testDeliversWaitingMessagesInBatches {
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:[AWSIoTMQTTDeliveryExecutorTests serialConfiguration]];
+    [self closeGateOnExecutor:executor];
+
+    NSMutableArray<NSNumber *> *batchSizes = [NSMutableArray array];
+    XCTestExpectation *delivered = [self expectationWithDescription:@"Batches delivered"];
+    delivered.expectedFulfillmentCount = 4;
+    for (NSUInteger i = 0; i < 100; i++) {
+        [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"t" index:i]
+                          forKey:@"t"
+                        priority:AWSIoTMQTTDeliveryPriorityDefault
+                         handler:^(NSArray<AWSIoTMessage *> *messages) {
+            [batchSizes addObject:@(messages.count)];
+            [delivered fulfill];
+        }];
+    }
+    XCTAssertEqual([executor metrics].queuedMessageCount, 100);
+    [self openGate];
+    [self waitForExpectations:@[delivered] timeout:5];
+
+    XCTAssertEqualObjects(batchSizes, (@[@32, @32, @32, @4]));
+    AWSIoTMQTTDeliveryMetrics *metrics = [executor metrics];
+    XCTAssertEqual(metrics.maximumQueuedMessageCount, 100);
+    XCTAssertGreaterThan(metrics.averageDeliveryLag, 0);
+    XCTAssertGreaterThanOrEqual(metrics.maximumDeliveryLag, metrics.averageDeliveryLag);
+}
+
+- (void)testDeliversHigherPrioritiesFirst {
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:[AWSIoTMQTTDeliveryExecutorTests serialConfiguration]];
+    [self closeGateOnExecutor:executor];
+
+    NSMutableArray<NSString *> *deliveredTopics = [NSMutableArray array];
+    XCTestExpectation *delivered = [self expectationWithDescription:@"Messages delivered"];
+    delivered.expectedFulfillmentCount = 3;
+    NSArray *priorities = @[@(AWSIoTMQTTDeliveryPriorityLow), @(AWSIoTMQTTDeliveryPriorityDefault), @(AWSIoTMQTTDeliveryPriorityHigh)];
+    NSArray *topics = @[@"low", @"default", @"high"];
+    for (NSUInteger i = 0; i < topics.count; i++) {
+        [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:topics[i] index:i]
+                          forKey:topics[i]
+                        priority:[priorities[i] integerValue]
+                         handler:^(NSArray<AWSIoTMessage *> *messages) {
+            [deliveredTopics addObject:messages[0].topic];
+            [delivered fulfill];
+        }];
+    }
+    [self openGate];
+    [self waitForExpectations:@[delivered] timeout:5];
+
+    XCTAssertEqualObjects(deliveredTopics, (@[@"high", @"default", @"low"]));
+}
+
+- (void)testDropNewestDiscardsReceivedMessagesWhenFull {
+    AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryExecutorTests serialConfiguration];
+    configuration.capacity = 10;
+    configuration.overflowPolicy = AWSIoTMQTTDeliveryOverflowPolicyDropNewest;
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:configuration];
+    [self closeGateOnExecutor:executor];
+
+    NSMutableArray<NSNumber *> *deliveredIndexes = [NSMutableArray array];
+    XCTestExpectation *delivered = [self expectationWithDescription:@"Messages delivered"];
+    delivered.expectedFulfillmentCount = 10;
+    for (NSUInteger i = 0; i < 20; i++) {
+        [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"t" index:i]
+                          forKey:@"t"
+                        priority:AWSIoTMQTTDeliveryPriorityDefault
+                         handler:^(NSArray<AWSIoTMessage *> *messages) {
+            for (AWSIoTMessage *message in messages) {
+                [deliveredIndexes addObject:@([AWSIoTMQTTDeliveryExecutorTests indexOfMessage:message])];
+                [delivered fulfill];
+            }
+        }];
+    }
+    XCTAssertEqual([executor metrics].droppedMessageCount, 10);
+    [self openGate];
+    [self waitForExpectations:@[delivered] timeout:5];
+
+    XCTAssertEqualObjects(deliveredIndexes, (@[@0, @1, @2, @3, @4, @5, @6, @7, @8, @9]));
+}
+
+- (void)testDropOldestDiscardsLowestPriorityMessagesFirst {
+    AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryExecutorTests serialConfiguration];
+    configuration.capacity = 4;
+    configuration.overflowPolicy = AWSIoTMQTTDeliveryOverflowPolicyDropOldest;
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:configuration];
+    [self closeGateOnExecutor:executor];
+
+    NSMutableArray<NSString *> *deliveredMessages = [NSMutableArray array];
+    XCTestExpectation *delivered = [self expectationWithDescription:@"Messages delivered"];
+    delivered.expectedFulfillmentCount = 4;
+    AWSIoTMQTTDeliveryHandler handler = ^(NSArray<AWSIoTMessage *> *messages) {
+        for (AWSIoTMessage *message in messages) {
+            [deliveredMessages addObject:[NSString stringWithFormat:@"%@%lu", message.topic,
+                                          (unsigned long)[AWSIoTMQTTDeliveryExecutorTests indexOfMessage:message]]];
+            [delivered fulfill];
+        }
+    };
+    for (NSUInteger i = 0; i < 3; i++) {
+        [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"low" index:i]
+                          forKey:@"low"
+                        priority:AWSIoTMQTTDeliveryPriorityLow
+                         handler:handler];
+    }
+    for (NSUInteger i = 0; i < 3; i++) {
+        [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"high" index:i]
+                          forKey:@"high"
+                        priority:AWSIoTMQTTDeliveryPriorityHigh
+                         handler:handler];
+    }
+    XCTAssertEqual([executor metrics].droppedMessageCount, 2);
+    [self openGate];
+    [self waitForExpectations:@[delivered] timeout:5];
+
+    XCTAssertEqualObjects(deliveredMessages, (@[@"high0", @"high1", @"high2", @"low2"]));
+}
+
+- (void)testDropPoliciesNeverDiscardQoS1Messages {
+    XCTAssertEqual([AWSIoTMQTTDeliveryConfiguration new].capacity, 0);
+
+    // Messages 0, 2 and 4 are QoS 0, the others QoS 1. Once only QoS 1 messages are queued, both policies drop the
+    // received QoS 0 message.
+    NSDictionary<NSNumber *, NSArray<NSNumber *> *> *expectedIndexesByPolicy = @{
+        @(AWSIoTMQTTDeliveryOverflowPolicyDropOldest) : @[@1, @3, @5],
+        @(AWSIoTMQTTDeliveryOverflowPolicyDropNewest) : @[@0, @1, @3, @5],
+    };
+    for (NSNumber *overflowPolicy in expectedIndexesByPolicy) {
+        NSArray<NSNumber *> *expectedIndexes = expectedIndexesByPolicy[overflowPolicy];
+        AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryExecutorTests serialConfiguration];
+        configuration.capacity = 2;
+        configuration.overflowPolicy = overflowPolicy.integerValue;
+        AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:configuration];
+        [self closeGateOnExecutor:executor];
+
+        NSMutableArray<NSNumber *> *deliveredIndexes = [NSMutableArray array];
+        XCTestExpectation *delivered = [self expectationWithDescription:@"Messages delivered"];
+        delivered.expectedFulfillmentCount = expectedIndexes.count;
+        for (NSUInteger i = 0; i < 6; i++) {
+            AWSIoTMessage *message = [AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"t" index:i];
+            message.qos = i % 2 == 0 ? AWSIoTMQTTQoSMessageDeliveryAttemptedAtMostOnce : AWSIoTMQTTQoSMessageDeliveryAttemptedAtLeastOnce;
+            [executor enqueueMessage:message
+                              forKey:@"t"
+                            priority:AWSIoTMQTTDeliveryPriorityDefault
+                             handler:^(NSArray<AWSIoTMessage *> *messages) {
+                for (AWSIoTMessage *message in messages) {
+                    [deliveredIndexes addObject:@([AWSIoTMQTTDeliveryExecutorTests indexOfMessage:message])];
+                    [delivered fulfill];
+                }
+            }];
+        }
+        XCTAssertEqual([executor metrics].droppedMessageCount, 6 - expectedIndexes.count);
+        [self openGate];
+        [self waitForExpectations:@[delivered] timeout:5];
+
+        XCTAssertEqualObjects(deliveredIndexes, expectedIndexes);
+    }
+}
+
+- (void)testBlockHoldsTheReceiverUntilThereIsRoom {
+    AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryExecutorTests serialConfiguration];
+    configuration.capacity = 2;
+    configuration.overflowPolicy = AWSIoTMQTTDeliveryOverflowPolicyBlock;
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:configuration];
+    [self closeGateOnExecutor:executor];
+
+    NSMutableArray<NSNumber *> *deliveredIndexes = [NSMutableArray array];
+    XCTestExpectation *delivered = [self expectationWithDescription:@"Messages delivered"];
+    delivered.expectedFulfillmentCount = 5;
+    XCTestExpectation *received = [self expectationWithDescription:@"Messages queued"];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        for (NSUInteger i = 0; i < 5; i++) {
+            [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"t" index:i]
+                              forKey:@"t"
+                            priority:AWSIoTMQTTDeliveryPriorityDefault
+                             handler:^(NSArray<AWSIoTMessage *> *messages) {
+                for (AWSIoTMessage *message in messages) {
+                    [deliveredIndexes addObject:@([AWSIoTMQTTDeliveryExecutorTests indexOfMessage:message])];
+                    [delivered fulfill];
+                }
+            }];
+        }
+        [received fulfill];
+    });
+
+    [NSThread sleepForTimeInterval:0.2];
+    XCTAssertEqual([executor metrics].queuedMessageCount, 2);
+    [self openGate];
+    [self waitForExpectations:@[received, delivered] timeout:5];
+
+    XCTAssertEqualObjects(deliveredIndexes, (@[@0, @1, @2, @3, @4]));
+    XCTAssertEqual([executor metrics].droppedMessageCount, 0);
+}
+
+- (void)testSettingTheConfigurationKeepsQueuedMessagesAndMetrics {
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:[AWSIoTMQTTDeliveryExecutorTests serialConfiguration]];
+    [self closeGateOnExecutor:executor];
+
+    NSMutableArray<NSNumber *> *deliveredIndexes = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *batchSizes = [NSMutableArray array];
+    XCTestExpectation *delivered = [self expectationWithDescription:@"Messages delivered"];
+    delivered.expectedFulfillmentCount = 5;
+    for (NSUInteger i = 0; i < 5; i++) {
+        [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"t" index:i]
+                          forKey:@"t"
+                        priority:AWSIoTMQTTDeliveryPriorityDefault
+                         handler:^(NSArray<AWSIoTMessage *> *messages) {
+            [batchSizes addObject:@(messages.count)];
+            for (AWSIoTMessage *message in messages) {
+                [deliveredIndexes addObject:@([AWSIoTMQTTDeliveryExecutorTests indexOfMessage:message])];
+                [delivered fulfill];
+            }
+        }];
+    }
+
+    AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryExecutorTests serialConfiguration];
+    configuration.maximumBatchSize = 2;
+    executor.configuration = configuration;
+    XCTAssertEqual(executor.configuration.maximumBatchSize, 2);
+    XCTAssertEqual([executor metrics].queuedMessageCount, 5);
+    [self openGate];
+    [self waitForExpectations:@[delivered] timeout:5];
+
+    XCTAssertEqualObjects(deliveredIndexes, (@[@0, @1, @2, @3, @4]));
+    XCTAssertEqualObjects(batchSizes, (@[@2, @2, @1]));
+    AWSIoTMQTTDeliveryMetrics *metrics = [executor metrics];
+    XCTAssertEqual(metrics.deliveredMessageCount, 6);
+    XCTAssertEqual(metrics.maximumQueuedMessageCount, 5);
+}
+
+- (void)testRemoveMessagesForKeyDiscardsWaitingMessages {
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:[AWSIoTMQTTDeliveryExecutorTests serialConfiguration]];
+    [self closeGateOnExecutor:executor];
+
+    __block NSUInteger deliveredCount = 0;
+    for (NSUInteger i = 0; i < 5; i++) {
+        [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"t" index:i]
+                          forKey:@"t"
+                        priority:AWSIoTMQTTDeliveryPriorityDefault
+                         handler:^(NSArray<AWSIoTMessage *> *messages) {
+            deliveredCount += messages.count;
+        }];
+    }
+    [executor removeMessagesForKey:@"t"];
+    XCTAssertEqual([executor metrics].queuedMessageCount, 0);
+
+    XCTestExpectation *drained = [self expectationWithDescription:@"Queue drained"];
+    [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"other" index:0]
+                      forKey:@"other"
+                    priority:AWSIoTMQTTDeliveryPriorityLow
+                     handler:^(NSArray<AWSIoTMessage *> *messages) {
+        [drained fulfill];
+    }];
+    [self openGate];
+    [self waitForExpectations:@[drained] timeout:5];
+    XCTAssertEqual(deliveredCount, 0);
+}
+
+- (void)testResubscribingWhileDeliveringKeepsOneLane {
+    AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryConfiguration new];
+    configuration.maximumConcurrentDeliveries = 4;
+    AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:configuration];
+    // A worker is delivering from the "gate" lane when its messages are removed.
+    [self closeGateOnExecutor:executor];
+    [executor removeMessagesForKey:@"gate"];
+
+    __block BOOL gateOpen = NO;
+    XCTestExpectation *delivered = [self expectationWithDescription:@"Message delivered"];
+    [executor enqueueMessage:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:@"gate" index:1]
+                      forKey:@"gate"
+                    priority:AWSIoTMQTTDeliveryPriorityDefault
+                     handler:^(NSArray<AWSIoTMessage *> *messages) {
+        XCTAssertTrue(gateOpen);
+        [delivered fulfill];
+    }];
+
+    // Idle workers are available, but the new message waits for the delivery in progress.
+    [NSThread sleepForTimeInterval:0.2];
+    gateOpen = YES;
+    [self openGate];
+    [self waitForExpectations:@[delivered] timeout:5];
+    XCTAssertEqual([executor metrics].deliveredMessageCount, 2);
+}
+
+/**
+ Benchmarks a burst of 100,000 retained messages across 100 topics, the case that used to queue one GCD block per
+ message and callback.
+ */
+- (void)testPerformanceBurstOf100000Messages {
+    AWSIoTMQTTDeliveryConfiguration *configuration = [AWSIoTMQTTDeliveryConfiguration new];
+    configuration.capacity = 0;
+    NSMutableArray<AWSIoTMessage *> *messages = [NSMutableArray arrayWithCapacity:100000];
+    for (NSUInteger i = 0; i < 100000; i++) {
+        [messages addObject:[AWSIoTMQTTDeliveryExecutorTests messageWithTopic:[NSString stringWithFormat:@"devices/%lu", (unsigned long)(i % 100)] index:i]];
+    }
+
+    [self measureBlock:^{
+        AWSIoTMQTTDeliveryExecutor *executor = [[AWSIoTMQTTDeliveryExecutor alloc] initWithConfiguration:configuration];
+        dispatch_group_t group = dispatch_group_create();
+        for (NSUInteger i = 0; i < messages.count; i++) {
+            dispatch_group_enter(group);
+        }
+        for (AWSIoTMessage *message in messages) {
+            [executor enqueueMessage:message
+                              forKey:message.topic
+                            priority:AWSIoTMQTTDeliveryPriorityDefault
+                             handler:^(NSArray<AWSIoTMessage *> *batch) {
+                for (NSUInteger i = 0; i < batch.count; i++) {
+                    dispatch_group_leave(group);
+                }
+            }];
+        }
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    }];
+}
+
+@end
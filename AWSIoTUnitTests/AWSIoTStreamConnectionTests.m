@@ -0,0 +1,300 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSIoTStreamConnection.h"
+#import "TestMQTTBroker.h"
+#import "TestMQTTSessionDelegate.h"
+#import "AWSIoTMQTTClient.h"
+
+@interface AWSIoTMQTTClient()
+
+@property (nonatomic, strong) AWSIoTStreamEventLoop *streamEventLoop;
+
+@end
+
+@interface AWSIoTStreamConnectionTests : XCTestCase
+
+@property (nonatomic, strong) AWSIoTStreamConnection *connection;
+@property (nonatomic, strong) AWSMQTTSession *session;
+@property (nonatomic, strong) NSInputStream *decoderInputStream;
+@property (nonatomic, strong) NSOutputStream *encoderOutputStream;
+@property (nonatomic, strong) NSOutputStream *outputStream;
+
+@end
+
+@implementation AWSIoTStreamConnectionTests
+
+- (void)setUp {
+    // Mock the dependencies
+    self.decoderInputStream = OCMClassMock([NSInputStream class]);
+    self.encoderOutputStream = OCMClassMock([NSOutputStream class]);
+    self.outputStream = OCMClassMock([NSOutputStream class]);
+    self.session = OCMClassMock([AWSMQTTSession class]);
+
+    // Create an expectation and fulfill it when session.connectToInputStream:outputStream is invoked
+    XCTestExpectation *startExpectation = [self expectationWithDescription:@"AWSIoTStreamConnection.start expectation"];
+    OCMStub([self.session connectToInputStream:[OCMArg any] outputStream:[OCMArg any]])
+        .andCall(startExpectation, @selector(fulfill));
+    
+    self.connection = [[AWSIoTStreamConnection alloc] initWithSession:self.session
+                                                   decoderInputStream:self.decoderInputStream
+                                                  encoderOutputStream:self.encoderOutputStream
+                                                         outputStream:self.outputStream];
+    [self.connection start];
+    [self waitForExpectations:@[startExpectation] timeout:1];
+}
+
+- (void)tearDown {
+    self.connection = nil;
+    self.session = nil;
+    self.decoderInputStream = nil;
+    self.encoderOutputStream = nil;
+    self.outputStream = nil;
+}
+
+/// Given: An AWSIoTStreamConnection
+/// When: The connection is started
+/// Then: The output stream is opened on the event loop and the session is connected to the decoder and encoder streams
+- (void)testStart_shouldOpenStream_andInvokeConnectOnSession {
+    OCMVerify([self.outputStream scheduleInRunLoop:self.connection.eventLoop.runLoop forMode:NSDefaultRunLoopMode]);
+    OCMVerify([self.outputStream open]);
+    OCMVerify([self.session connectToInputStream:[OCMArg any] outputStream:[OCMArg any]]);
+}
+
+/// Given: A running AWSIoTStreamConnection
+/// When: The connection is cancelled with disconnect set to YES
+/// Then: The session is closed and all streams are closed
+- (void)testCancelAndDisconnect_shouldCloseStreams_andInvokeOnStop {
+    XCTestExpectation *stopExpectation = [self expectationWithDescription:@"AWSIoTStreamConnection.onStop expectation"];
+    self.connection.onStop = ^{
+        [stopExpectation fulfill];
+    };
+
+    [self.connection cancelAndDisconnect:YES];
+    [self waitForExpectations:@[stopExpectation] timeout:1];
+
+    OCMVerify([self.decoderInputStream close]);
+    OCMVerify([self.encoderOutputStream close]);
+    OCMVerify([self.outputStream close]);
+    OCMVerify([self.session close]);
+}
+
+/// Given: A running AWSIoTStreamConnection
+/// When: The connection is cancelled with disconnect set to NO
+/// Then: Neither the session nor the streams are closed
+- (void)testCancel_shouldNotCloseStreams_andInvokeOnStop {
+    XCTestExpectation *stopExpectation = [self expectationWithDescription:@"AWSIoTStreamConnection.onStop expectation"];
+    self.connection.onStop = ^{
+        [stopExpectation fulfill];
+    };
+
+    __block BOOL didInvokeSessionClose = NO;
+    [OCMStub([self.session close]) andDo:^(NSInvocation *invocation) {
+        didInvokeSessionClose = YES;
+    }];
+
+    __block BOOL didInvokeDecoderInputStreamClose = NO;
+    [OCMStub([self.decoderInputStream close]) andDo:^(NSInvocation *invocation) {
+        didInvokeDecoderInputStreamClose = YES;
+    }];
+
+    __block BOOL didInvokeEncoderDecoderInputStreamClose = NO;
+    [OCMStub([self.encoderOutputStream close]) andDo:^(NSInvocation *invocation) {
+        didInvokeEncoderDecoderInputStreamClose = YES;
+    }];
+
+    __block BOOL didInvokeOutputStreamClose = NO;
+    [OCMStub([self.outputStream close]) andDo:^(NSInvocation *invocation) {
+        didInvokeOutputStreamClose = YES;
+    }];
+
+    [self.connection cancelAndDisconnect:NO];
+    [self waitForExpectations:@[stopExpectation] timeout:1];
+
+    XCTAssertFalse(didInvokeSessionClose);
+    XCTAssertFalse(didInvokeDecoderInputStreamClose);
+    XCTAssertFalse(didInvokeEncoderDecoderInputStreamClose);
+    XCTAssertFalse(didInvokeOutputStreamClose);
+    OCMVerify([self.decoderInputStream removeFromRunLoop:self.connection.eventLoop.runLoop forMode:NSDefaultRunLoopMode]);
+    OCMVerify([self.encoderOutputStream removeFromRunLoop:self.connection.eventLoop.runLoop forMode:NSDefaultRunLoopMode]);
+}
+
+/// Given: An event loop group with two event loops
+/// When: Connections are started on the event loops it hands out
+/// Then: The connections are spread over the event loops, and the sessions are connected on the event loop threads
+- (void)testEventLoopGroup_shouldSpreadConnections_acrossEventLoops {
+    AWSIoTStreamEventLoopGroup *group = [[AWSIoTStreamEventLoopGroup alloc] initWithEventLoopCount:2];
+    NSMutableArray<AWSIoTStreamConnection *> *connections = [NSMutableArray new];
+    XCTestExpectation *connectExpectation = [self expectationWithDescription:@"Sessions connected"];
+    connectExpectation.expectedFulfillmentCount = 4;
+
+    for (NSUInteger i = 0; i < 4; i++) {
+        AWSMQTTSession *session = OCMClassMock([AWSMQTTSession class]);
+        AWSIoTStreamEventLoop *eventLoop = [group nextEventLoop];
+        OCMStub([session connectToInputStream:[OCMArg any] outputStream:[OCMArg any]]).andDo(^(NSInvocation *invocation) {
+            XCTAssertEqualObjects([NSThread currentThread], eventLoop.thread);
+            [connectExpectation fulfill];
+        });
+        AWSIoTStreamConnection *connection = [[AWSIoTStreamConnection alloc] initWithSession:session
+                                                                          decoderInputStream:OCMClassMock([NSInputStream class])
+                                                                         encoderOutputStream:OCMClassMock([NSOutputStream class])
+                                                                                outputStream:nil
+                                                                                   eventLoop:eventLoop];
+        [connection start];
+        [connections addObject:connection];
+    }
+    [self waitForExpectations:@[connectExpectation] timeout:1];
+
+    XCTAssertEqual(group.eventLoops[0].connectionCount, 2);
+    XCTAssertEqual(group.eventLoops[1].connectionCount, 2);
+    for (AWSIoTStreamConnection *connection in connections) {
+        [connection cancelAndDisconnect:YES];
+    }
+    [group stop];
+}
+
+/// Given: Several clients per event loop of the default group, all created before any of them connects
+/// When: The clients connect
+/// Then: Each client is given its event loop on connect, and the clients are spread over every event loop
+- (void)testDefaultGroup_shouldSpreadClientsCreatedBeforeConnecting_acrossEventLoops {
+    NSArray<AWSIoTStreamEventLoop *> *eventLoops = [AWSIoTStreamEventLoopGroup defaultGroup].eventLoops;
+    NSUInteger clientCount = eventLoops.count * 8;
+    NSMutableArray<AWSIoTMQTTClient *> *clients = [NSMutableArray new];
+    for (NSUInteger i = 0; i < clientCount; i++) {
+        AWSIoTMQTTClient *client = [[AWSIoTMQTTClient alloc] initWithDelegate:nil];
+        XCTAssertNil(client.streamEventLoop);
+        [clients addObject:client];
+    }
+
+    for (AWSIoTMQTTClient *client in clients) {
+        [client webSocketDidOpen:OCMClassMock([AWSSRWebSocket class])];
+    }
+
+    NSMutableSet<AWSIoTStreamEventLoop *> *assignedEventLoops = [NSMutableSet new];
+    for (AWSIoTMQTTClient *client in clients) {
+        XCTAssertNotNil(client.streamEventLoop);
+        [assignedEventLoops addObject:client.streamEventLoop];
+    }
+    XCTAssertEqualObjects(assignedEventLoops, [NSSet setWithArray:eventLoops]);
+
+    NSUInteger minimumConnectionCount = NSUIntegerMax;
+    NSUInteger maximumConnectionCount = 0;
+    for (AWSIoTStreamEventLoop *eventLoop in eventLoops) {
+        minimumConnectionCount = MIN(minimumConnectionCount, eventLoop.connectionCount);
+        maximumConnectionCount = MAX(maximumConnectionCount, eventLoop.connectionCount);
+    }
+    XCTAssertLessThanOrEqual(maximumConnectionCount - minimumConnectionCount, 1);
+
+    for (AWSIoTMQTTClient *client in clients) {
+        [client disconnect];
+    }
+}
+
+/// Given: A local broker stand-in and an event loop group with four event loops
+/// When: 1,000 sessions connect and each publishes a QoS 1 message
+/// Then: Every session is connected and acknowledged, and the sessions only ever run on the four event loop threads
+- (void)testScale_shouldHost1000Sessions_onFourEventLoops {
+    const NSUInteger sessionCount = 1000;
+    AWSIoTStreamEventLoopGroup *group = [[AWSIoTStreamEventLoopGroup alloc] initWithEventLoopCount:4];
+    AWSIoTStreamEventLoopGroup *brokerGroup = [[AWSIoTStreamEventLoopGroup alloc] initWithEventLoopCount:1];
+    TestMQTTBroker *broker = [[TestMQTTBroker alloc] initWithEventLoop:[brokerGroup nextEventLoop]];
+
+    XCTestExpectation *connectedExpectation = [self expectationWithDescription:@"Sessions connected"];
+    connectedExpectation.expectedFulfillmentCount = sessionCount;
+    XCTestExpectation *ackExpectation = [self expectationWithDescription:@"Publishes acknowledged"];
+    ackExpectation.expectedFulfillmentCount = sessionCount;
+    NSMutableSet<NSThread *> *sessionThreads = [NSMutableSet set];
+
+    OnEventSessionDelegateBlock onEvent = ^void(AWSMQTTSession *session, AWSMQTTSessionEvent event) {
+        if (event == AWSMQTTSessionEventConnected) {
+            @synchronized (sessionThreads) {
+                [sessionThreads addObject:[NSThread currentThread]];
+            }
+            [connectedExpectation fulfill];
+            [session publishDataAtLeastOnce:[@"{\"temperature\":21}" dataUsingEncoding:NSUTF8StringEncoding]
+                                    onTopic:@"devices/telemetry"];
+        }
+    };
+    OnAckSessionDelegateBlock onAck = ^void(AWSMQTTSession *session, UInt16 msgId) {
+        @synchronized (sessionThreads) {
+            [sessionThreads addObject:[NSThread currentThread]];
+        }
+        [ackExpectation fulfill];
+    };
+    TestMQTTSessionDelegate *sessionDelegate = [[TestMQTTSessionDelegate alloc] initWithOnMessageBlock:nil
+                                                                                               onEvent:onEvent
+                                                                                                 onAck:onAck];
+
+    NSMutableArray<AWSMQTTSession *> *sessions = [NSMutableArray arrayWithCapacity:sessionCount];
+    NSMutableArray<AWSIoTStreamConnection *> *connections = [NSMutableArray arrayWithCapacity:sessionCount];
+    NSDate *start = [NSDate date];
+    for (NSUInteger i = 0; i < sessionCount; i++) {
+        AWSMQTTSession *session = [[AWSMQTTSession alloc] initWithClientId:[NSString stringWithFormat:@"device-%lu", (unsigned long)i]
+                                                                  userName:nil
+                                                                  password:nil
+                                                                 keepAlive:60
+                                                              cleanSession:YES
+                                                                 willTopic:nil
+                                                                   willMsg:nil
+                                                                   willQoS:0
+                                                            willRetainFlag:NO
+                                                      publishRetryThrottle:10];
+        session.delegate = sessionDelegate;
+        [sessions addObject:session];
+
+        NSInputStream *inputStream;
+        NSOutputStream *outputStream;
+        [broker acceptConnectionWithInputStream:&inputStream outputStream:&outputStream];
+        AWSIoTStreamConnection *connection = [[AWSIoTStreamConnection alloc] initWithSession:session
+                                                                          decoderInputStream:inputStream
+                                                                         encoderOutputStream:outputStream
+                                                                                outputStream:nil
+                                                                                   eventLoop:[group nextEventLoop]];
+        [connection start];
+        [connections addObject:connection];
+    }
+
+    [self waitForExpectations:@[connectedExpectation, ackExpectation] timeout:60];
+    NSLog(@"Connected %lu sessions and acknowledged their publishes in %.2fs", (unsigned long)sessionCount, -[start timeIntervalSinceNow]);
+
+    XCTAssertEqual(broker.connectCount, sessionCount);
+    XCTAssertEqual(broker.publishCount, sessionCount);
+    NSSet<NSThread *> *eventLoopThreads = [NSSet setWithArray:[group.eventLoops valueForKey:@"thread"]];
+    XCTAssertTrue([sessionThreads isSubsetOfSet:eventLoopThreads]);
+    for (AWSIoTStreamEventLoop *eventLoop in group.eventLoops) {
+        XCTAssertEqual(eventLoop.connectionCount, sessionCount / group.eventLoops.count);
+    }
+
+    XCTestExpectation *stopExpectation = [self expectationWithDescription:@"Connections stopped"];
+    stopExpectation.expectedFulfillmentCount = sessionCount;
+    for (AWSIoTStreamConnection *connection in connections) {
+        connection.onStop = ^{
+            [stopExpectation fulfill];
+        };
+        [connection cancelAndDisconnect:YES];
+    }
+    [self waitForExpectations:@[stopExpectation] timeout:60];
+    for (AWSIoTStreamEventLoop *eventLoop in group.eventLoops) {
+        XCTAssertEqual(eventLoop.connectionCount, 0);
+    }
+
+    [broker close];
+    [group stop];
+    [brokerGroup stop];
+}
+
+@end
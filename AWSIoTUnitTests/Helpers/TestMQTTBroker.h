@@ -0,0 +1,48 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSIoTStreamEventLoop.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An in-memory stand-in for an MQTT broker. It accepts every CONNECT, acknowledges QoS 1 publishes and answers pings,
+ over bound stream pairs serviced by an event loop.
+ */
+@interface TestMQTTBroker : NSObject
+
+@property (readonly) NSUInteger connectCount;
+@property (readonly) NSUInteger publishCount;
+
+- (instancetype)initWithEventLoop:(AWSIoTStreamEventLoop *)eventLoop;
+
+/**
+ Accepts a client connection.
+
+ @param inputStream Set to the stream the client reads the broker's messages from.
+ @param outputStream Set to the stream the client writes its messages to.
+ */
+- (void)acceptConnectionWithInputStream:(NSInputStream * _Nullable * _Nonnull)inputStream
+                           outputStream:(NSOutputStream * _Nullable * _Nonnull)outputStream;
+
+/**
+ Closes every accepted connection.
+ */
+- (void)close;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,157 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "TestMQTTBroker.h"
+#import "AWSMQTTDecoder.h"
+#import "AWSMQTTEncoder.h"
+#import "AWSMQTTMessage.h"
+
+@interface TestMQTTBroker ()
+
+@property (assign) NSUInteger connectCount;
+@property (assign) NSUInteger publishCount;
+
+- (void)didReceiveMessage:(AWSMQTTMessage *)message;
+
+@end
+
+// One client connection. Replies are held until the encoder is ready.
+@interface TestMQTTBrokerConnection : NSObject <AWSMQTTDecoderDelegate, AWSMQTTEncoderDelegate>
+
+@property (nonatomic, weak) TestMQTTBroker *broker;
+@property (nonatomic, strong) AWSMQTTDecoder *decoder;
+@property (nonatomic, strong) AWSMQTTEncoder *encoder;
+@property (nonatomic, strong) NSMutableArray<AWSMQTTMessage *> *pendingReplies;
+@property (nonatomic, assign) BOOL encoderReady;
+
+@end
+
+@implementation TestMQTTBrokerConnection
+
+- (void)reply:(AWSMQTTMessage *)message {
+    if (self.encoderReady) {
+        [self.encoder encodeMessage:message];
+    } else {
+        [self.pendingReplies addObject:message];
+    }
+}
+
+- (void)decoder:(AWSMQTTDecoder *)sender newMessage:(AWSMQTTMessage *)msg {
+    [self.broker didReceiveMessage:msg];
+    switch (msg.type) {
+        case AWSMQTTConnect: {
+            const UInt8 accepted[] = {0x00, 0x00};
+            [self reply:[[AWSMQTTMessage alloc] initWithType:AWSMQTTConnack
+                                                        data:[NSData dataWithBytes:accepted length:sizeof(accepted)]]];
+            break;
+        }
+        case AWSMQTTPublish:
+            if (msg.qos == 1 && msg.data.length >= 2) {
+                const UInt8 *bytes = msg.data.bytes;
+                NSUInteger topicLength = (bytes[0] << 8) | bytes[1];
+                if (msg.data.length >= topicLength + 4) {
+                    UInt16 msgId = (bytes[topicLength + 2] << 8) | bytes[topicLength + 3];
+                    [self reply:[AWSMQTTMessage pubackMessageWithMessageId:msgId]];
+                }
+            }
+            break;
+        case AWSMQTTPingreq:
+            [self reply:[[AWSMQTTMessage alloc] initWithType:AWSMQTTPingresp]];
+            break;
+        default:
+            break;
+    }
+}
+
+- (void)decoder:(AWSMQTTDecoder *)sender handleEvent:(AWSMQTTDecoderEvent)eventCode {
+}
+
+- (void)encoder:(AWSMQTTEncoder *)sender handleEvent:(AWSMQTTEncoderEvent)eventCode {
+    if (eventCode == AWSMQTTEncoderEventReady && !self.encoderReady) {
+        self.encoderReady = YES;
+        for (AWSMQTTMessage *message in self.pendingReplies) {
+            [self.encoder encodeMessage:message];
+        }
+        [self.pendingReplies removeAllObjects];
+    }
+}
+
+@end
+
+@implementation TestMQTTBroker {
+    AWSIoTStreamEventLoop *eventLoop;
+    NSMutableArray<TestMQTTBrokerConnection *> *connections;
+}
+
+- (instancetype)initWithEventLoop:(AWSIoTStreamEventLoop *)anEventLoop {
+    if (self = [super init]) {
+        eventLoop = anEventLoop;
+        connections = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)acceptConnectionWithInputStream:(NSInputStream * _Nullable * _Nonnull)inputStream
+                           outputStream:(NSOutputStream * _Nullable * _Nonnull)outputStream {
+    NSInputStream *brokerInputStream;
+    NSOutputStream *brokerOutputStream;
+    [NSStream getBoundStreamsWithBufferSize:4096 inputStream:&brokerInputStream outputStream:outputStream];
+    [NSStream getBoundStreamsWithBufferSize:4096 inputStream:inputStream outputStream:&brokerOutputStream];
+
+    TestMQTTBrokerConnection *connection = [TestMQTTBrokerConnection new];
+    connection.broker = self;
+    connection.pendingReplies = [NSMutableArray array];
+    connection.decoder = [[AWSMQTTDecoder alloc] initWithStream:brokerInputStream];
+    connection.decoder.delegate = connection;
+    connection.encoder = [[AWSMQTTEncoder alloc] initWithStream:brokerOutputStream];
+    connection.encoder.delegate = connection;
+    @synchronized (connections) {
+        [connections addObject:connection];
+    }
+
+    [eventLoop performBlock:^{
+        [connection.encoder open];
+        [connection.decoder open];
+    }];
+}
+
+- (void)didReceiveMessage:(AWSMQTTMessage *)message {
+    @synchronized (self) {
+        if (message.type == AWSMQTTConnect) {
+            self.connectCount++;
+        } else if (message.type == AWSMQTTPublish) {
+            self.publishCount++;
+        }
+    }
+}
+
+- (void)close {
+    NSArray<TestMQTTBrokerConnection *> *closedConnections;
+    @synchronized (connections) {
+        closedConnections = [connections copy];
+        [connections removeAllObjects];
+    }
+    dispatch_semaphore_t closed = dispatch_semaphore_create(0);
+    [eventLoop performBlock:^{
+        for (TestMQTTBrokerConnection *connection in closedConnections) {
+            [connection.decoder close];
+            [connection.encoder close];
+        }
+        dispatch_semaphore_signal(closed);
+    }];
+    dispatch_semaphore_wait(closed, DISPATCH_TIME_FOREVER);
+}
+
+@end
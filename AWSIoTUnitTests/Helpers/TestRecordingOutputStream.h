@@ -0,0 +1,39 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An output stream that accepts every write without a run loop, recording what was written. Thread safe.
+ */
+@interface TestRecordingOutputStream : NSOutputStream
+
+/**
+ @param recordsData Whether to keep the written bytes in `writtenData`, or only count them.
+ */
+- (instancetype)initRecordingData:(BOOL)recordsData;
+
+/// Each write accepts at most this many bytes. 0, the default, accepts whole writes.
+@property (atomic, assign) NSUInteger maximumWriteLength;
+
+@property (atomic, readonly) NSData *writtenData;
+@property (atomic, readonly) NSUInteger writtenLength;
+@property (atomic, readonly) NSUInteger writeCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,117 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "TestRecordingOutputStream.h"
+
+@implementation TestRecordingOutputStream {
+    BOOL _recordsData;
+    NSMutableData *_writtenData;
+    NSUInteger _writtenLength;
+    NSUInteger _writeCount;
+    NSStreamStatus _streamStatus;
+    __weak id<NSStreamDelegate> _delegate;
+}
+
+- (instancetype)initRecordingData:(BOOL)recordsData {
+    if (self = [super init]) {
+        _recordsData = recordsData;
+        _writtenData = [NSMutableData new];
+        _streamStatus = NSStreamStatusNotOpen;
+    }
+    return self;
+}
+
+- (NSInteger)write:(const uint8_t *)buffer maxLength:(NSUInteger)length {
+    @synchronized (self) {
+        if (_streamStatus == NSStreamStatusClosed) {
+            return -1;
+        }
+        NSUInteger acceptedLength = self.maximumWriteLength > 0 ? MIN(length, self.maximumWriteLength) : length;
+        if (_recordsData) {
+            [_writtenData appendBytes:buffer length:acceptedLength];
+        }
+        _writtenLength += acceptedLength;
+        _writeCount += 1;
+        return (NSInteger)acceptedLength;
+    }
+}
+
+- (NSData *)writtenData {
+    @synchronized (self) {
+        return [_writtenData copy];
+    }
+}
+
+- (NSUInteger)writtenLength {
+    @synchronized (self) {
+        return _writtenLength;
+    }
+}
+
+- (NSUInteger)writeCount {
+    @synchronized (self) {
+        return _writeCount;
+    }
+}
+
+- (BOOL)hasSpaceAvailable {
+    return YES;
+}
+
+- (void)open {
+    @synchronized (self) {
+        _streamStatus = NSStreamStatusOpen;
+    }
+}
+
+- (void)close {
+    @synchronized (self) {
+        _streamStatus = NSStreamStatusClosed;
+    }
+}
+
+- (NSStreamStatus)streamStatus {
+    @synchronized (self) {
+        return _streamStatus;
+    }
+}
+
+- (NSError *)streamError {
+    return nil;
+}
+
+- (id<NSStreamDelegate>)delegate {
+    return _delegate;
+}
+
+- (void)setDelegate:(id<NSStreamDelegate>)delegate {
+    _delegate = delegate;
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSRunLoopMode)mode {
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSRunLoopMode)mode {
+}
+
+- (id)propertyForKey:(NSStreamPropertyKey)key {
+    return nil;
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSStreamPropertyKey)key {
+    return NO;
+}
+
+@end
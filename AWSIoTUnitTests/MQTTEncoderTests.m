@@ -0,0 +1,269 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSIoT.h"
+#import "AWSMQTTEncoder.h"
+#import "AWSMQTTMessage.h"
+
+#import "TestRecordingOutputStream.h"
+
+NSTimeInterval MQTTEncoderTimeout = 5.0;
+
+@interface MQTTEncoderTests : XCTestCase
+
+@end
+
+/// Claims a length without holding the bytes, for checks that only read the length.
+@interface MQTTEncoderTestsLengthOnlyData : NSData
+
+@property (nonatomic, assign) NSUInteger claimedLength;
+
+@end
+
+@implementation MQTTEncoderTestsLengthOnlyData
+
+- (NSUInteger)length {
+    return self.claimedLength;
+}
+
+- (const void *)bytes {
+    return NULL;
+}
+
+@end
+
+@implementation MQTTEncoderTests
+
++ (NSData *)payloadWithLength:(NSUInteger)length {
+    NSMutableData *payload = [NSMutableData dataWithLength:length];
+    UInt8 *bytes = payload.mutableBytes;
+    for (NSUInteger i = 0; i < length; i++) {
+        bytes[i] = (UInt8)(i * 31);
+    }
+    return [payload copy];
+}
+
+// The bytes a QoS 1 publish of `payload` on "t/1" with message id 7 is sent as.
++ (NSData *)publishFrameWithPayload:(NSData *)payload {
+    NSMutableData *body = [NSMutableData new];
+    [body AWSMQTT_appendMQTTString:@"t/1"];
+    [body AWSMQTT_appendUInt16BigEndian:7];
+    [body appendData:payload];
+
+    NSMutableData *frame = [NSMutableData new];
+    [frame AWSMQTT_appendByte:(AWSMQTTPublish << 4) | (1 << 1)];
+    NSUInteger length = body.length;
+    do {
+        UInt8 digit = length % 128;
+        length /= 128;
+        [frame AWSMQTT_appendByte:length > 0 ? (digit | 0x80) : digit];
+    } while (length > 0);
+    [frame appendData:body];
+    return frame;
+}
+
++ (AWSMQTTMessage *)publishMessageWithPayload:(NSData *)payload {
+    return [AWSMQTTMessage publishMessageWithData:payload onTopic:@"t/1" qos:1 msgId:7 retainFlag:NO dupFlag:NO];
+}
+
++ (AWSMQTTEncoder *)readyEncoderWithStream:(NSOutputStream *)stream {
+    AWSMQTTEncoder *encoder = [[AWSMQTTEncoder alloc] initWithStream:stream];
+    [stream open];
+    encoder.status = AWSMQTTEncoderStatusReady;
+    return encoder;
+}
+
+- (void)testPublishMessageKeepsPayloadByReference {
+    NSData *payload = [MQTTEncoderTests payloadWithLength:1024];
+    AWSMQTTMessage *message = [MQTTEncoderTests publishMessageWithPayload:payload];
+    XCTAssertTrue(message.payload == payload);
+    XCTAssertEqual(message.data.length, 7);
+
+    NSMutableData *expectedRemainingData = [NSMutableData new];
+    [expectedRemainingData appendData:message.data];
+    [expectedRemainingData appendData:payload];
+    XCTAssertEqualObjects([message remainingData], expectedRemainingData);
+}
+
+- (void)testWritesSmallFrameInOneWrite {
+    TestRecordingOutputStream *stream = [[TestRecordingOutputStream alloc] initRecordingData:YES];
+    AWSMQTTEncoder *encoder = [MQTTEncoderTests readyEncoderWithStream:stream];
+    NSData *payload = [MQTTEncoderTests payloadWithLength:200];
+
+    XCTestExpectation *written = [self expectationWithDescription:@"Message written"];
+    [encoder encodeMessage:[MQTTEncoderTests publishMessageWithPayload:payload] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [written fulfill];
+    }];
+    [self waitForExpectations:@[written] timeout:MQTTEncoderTimeout];
+
+    XCTAssertEqualObjects(stream.writtenData, [MQTTEncoderTests publishFrameWithPayload:payload]);
+    XCTAssertEqual(stream.writeCount, 1);
+    XCTAssertEqual(encoder.status, AWSMQTTEncoderStatusReady);
+}
+
+- (void)testWritesLargePayloadFromItsOwnBytes {
+    TestRecordingOutputStream *stream = [[TestRecordingOutputStream alloc] initRecordingData:YES];
+    AWSMQTTEncoder *encoder = [MQTTEncoderTests readyEncoderWithStream:stream];
+    NSData *payload = [MQTTEncoderTests payloadWithLength:300 * 1024];
+
+    XCTestExpectation *written = [self expectationWithDescription:@"Message written"];
+    [encoder encodeMessage:[MQTTEncoderTests publishMessageWithPayload:payload] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [written fulfill];
+    }];
+    [self waitForExpectations:@[written] timeout:MQTTEncoderTimeout];
+
+    XCTAssertEqualObjects(stream.writtenData, [MQTTEncoderTests publishFrameWithPayload:payload]);
+    // The header and the payload are written separately.
+    XCTAssertEqual(stream.writeCount, 2);
+}
+
+- (void)testResumesPartialWritesInOrderWhenSpaceIsAvailable {
+    TestRecordingOutputStream *stream = [[TestRecordingOutputStream alloc] initRecordingData:YES];
+    stream.maximumWriteLength = 1000;
+    AWSMQTTEncoder *encoder = [MQTTEncoderTests readyEncoderWithStream:stream];
+
+    NSArray<NSNumber *> *payloadLengths = @[@5000, @10, @40000];
+    NSMutableData *expectedData = [NSMutableData new];
+    NSMutableArray<NSNumber *> *completedMessages = [NSMutableArray new];
+    XCTestExpectation *written = [self expectationWithDescription:@"Messages written"];
+    written.expectedFulfillmentCount = payloadLengths.count;
+    for (NSUInteger i = 0; i < payloadLengths.count; i++) {
+        NSData *payload = [MQTTEncoderTests payloadWithLength:payloadLengths[i].unsignedIntegerValue];
+        [expectedData appendData:[MQTTEncoderTests publishFrameWithPayload:payload]];
+        [encoder encodeMessage:[MQTTEncoderTests publishMessageWithPayload:payload] completionHandler:^(BOOL success) {
+            XCTAssertTrue(success);
+            @synchronized (completedMessages) {
+                [completedMessages addObject:@(i)];
+            }
+            [written fulfill];
+        }];
+    }
+
+    // Stands in for the run loop telling the encoder the stream has room again.
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:MQTTEncoderTimeout];
+    while (stream.writtenLength < expectedData.length && [deadline timeIntervalSinceNow] > 0) {
+        [encoder stream:stream handleEvent:NSStreamEventHasSpaceAvailable];
+    }
+    [self waitForExpectations:@[written] timeout:MQTTEncoderTimeout];
+
+    XCTAssertEqualObjects(stream.writtenData, expectedData);
+    XCTAssertEqualObjects(completedMessages, (@[@0, @1, @2]));
+    XCTAssertEqual(encoder.status, AWSMQTTEncoderStatusReady);
+}
+
+- (void)testRejectsMessagesLongerThanMQTTAllows {
+    MQTTEncoderTestsLengthOnlyData *payload = [MQTTEncoderTestsLengthOnlyData new];
+    AWSMQTTMessage *message = [MQTTEncoderTests publishMessageWithPayload:[NSData data]];
+    message.payload = payload;
+    NSUInteger dataLength = message.data.length;
+
+    payload.claimedLength = 268435455 - dataLength;
+    XCTAssertTrue([AWSMQTTEncoder isEncodableMessage:message]);
+    payload.claimedLength = 268435456 - dataLength;
+    XCTAssertFalse([AWSMQTTEncoder isEncodableMessage:message]);
+    payload.claimedLength = NSUIntegerMax;
+    XCTAssertFalse([AWSMQTTEncoder isEncodableMessage:message]);
+
+    TestRecordingOutputStream *stream = [[TestRecordingOutputStream alloc] initRecordingData:YES];
+    AWSMQTTEncoder *encoder = [MQTTEncoderTests readyEncoderWithStream:stream];
+    XCTestExpectation *dropped = [self expectationWithDescription:@"Message dropped"];
+    [encoder encodeMessage:message completionHandler:^(BOOL success) {
+        XCTAssertFalse(success);
+        [dropped fulfill];
+    }];
+    [self waitForExpectations:@[dropped] timeout:MQTTEncoderTimeout];
+    XCTAssertEqual(stream.writtenLength, 0);
+}
+
+- (void)testDropsMessagesUntilReady {
+    TestRecordingOutputStream *stream = [[TestRecordingOutputStream alloc] initRecordingData:YES];
+    AWSMQTTEncoder *encoder = [[AWSMQTTEncoder alloc] initWithStream:stream];
+
+    XCTestExpectation *dropped = [self expectationWithDescription:@"Message dropped"];
+    [encoder encodeMessage:[AWSMQTTMessage pingreqMessage] completionHandler:^(BOOL success) {
+        XCTAssertFalse(success);
+        [dropped fulfill];
+    }];
+    [self waitForExpectations:@[dropped] timeout:MQTTEncoderTimeout];
+    XCTAssertEqual(stream.writtenLength, 0);
+}
+
+- (void)testCloseWritesQueuedMessagesFirst {
+    TestRecordingOutputStream *stream = [[TestRecordingOutputStream alloc] initRecordingData:YES];
+    AWSMQTTEncoder *encoder = [MQTTEncoderTests readyEncoderWithStream:stream];
+
+    XCTestExpectation *written = [self expectationWithDescription:@"DISCONNECT written"];
+    [encoder encodeMessage:[AWSMQTTMessage disconnectMessage] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [written fulfill];
+    }];
+    [encoder close];
+    [self waitForExpectations:@[written] timeout:MQTTEncoderTimeout];
+
+    const UInt8 disconnectFrame[] = {AWSMQTTDisconnect << 4, 0x00};
+    XCTAssertEqualObjects(stream.writtenData, [NSData dataWithBytes:disconnectFrame length:sizeof(disconnectFrame)]);
+}
+
+#pragma mark - Performance
+
+// Publishes `count` QoS 1 messages with payloads of `payloadLength` bytes and logs the rate.
+- (void)measurePublishesWithPayloadLength:(NSUInteger)payloadLength count:(NSUInteger)count {
+    NSData *payload = [MQTTEncoderTests payloadWithLength:payloadLength];
+    [self measureBlock:^{
+        TestRecordingOutputStream *stream = [[TestRecordingOutputStream alloc] initRecordingData:NO];
+        AWSMQTTEncoder *encoder = [MQTTEncoderTests readyEncoderWithStream:stream];
+        dispatch_semaphore_t written = dispatch_semaphore_create(0);
+
+        NSDate *start = [NSDate date];
+        for (NSUInteger i = 0; i < count; i++) {
+            AWSMQTTMessage *message = [AWSMQTTMessage publishMessageWithData:payload
+                                                                     onTopic:@"devices/thing/telemetry"
+                                                                         qos:1
+                                                                       msgId:(UInt16)(i % UINT16_MAX + 1)
+                                                                  retainFlag:NO
+                                                                     dupFlag:NO];
+            [encoder encodeMessage:message completionHandler:i + 1 < count ? nil : ^(BOOL success) {
+                dispatch_semaphore_signal(written);
+            }];
+        }
+        dispatch_semaphore_wait(written, DISPATCH_TIME_FOREVER);
+        NSTimeInterval elapsed = -[start timeIntervalSinceNow];
+
+        NSLog(@"%lu-byte payloads: %.0f publishes/s, %.1f MB/s", (unsigned long)payloadLength,
+              count / elapsed, stream.writtenLength / elapsed / (1024 * 1024));
+        [encoder close];
+    }];
+}
+
+- (void)testPerformancePublishes64BytePayloads {
+    [self measurePublishesWithPayloadLength:64 count:20000];
+}
+
+- (void)testPerformancePublishes4KBPayloads {
+    [self measurePublishesWithPayloadLength:4 * 1024 count:20000];
+}
+
+- (void)testPerformancePublishes64KBPayloads {
+    [self measurePublishesWithPayloadLength:64 * 1024 count:2000];
+}
+
+- (void)testPerformancePublishes1MBPayloads {
+    [self measurePublishesWithPayloadLength:1024 * 1024 count:200];
+}
+
+@end
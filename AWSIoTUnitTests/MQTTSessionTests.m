@@ -16,16 +16,29 @@
 #import <XCTest/XCTest.h>
 #import <objc/runtime.h>
 #import "AWSMQTTSession.h"
+#import "AWSMQTTMessage.h"
+#import "AWSMQTTOutbox.h"
+#import "AWSMQTTRingBuffer.h"
+#import "AWSMQTTEncoder.h"
 
 #import "MQTTDecoderTestHelpers.h"
 #import "TestDataWriter.h"
 #import "TestMQTTSessionDelegate.h"
+#import "AWSIoTStreamEventLoop.h"
+#import "TestRecordingOutputStream.h"
 
 @interface AWSMQTTSession (Testing)
 
 - (void)handlePublish:(AWSMQTTMessage*)msg;
+- (void)handlePuback:(AWSMQTTMessage*)msg;
+- (void)replayFlows;
+- (void)error:(AWSMQTTSessionEvent)eventCode;
 - (void)_unit_test_override_send:(AWSMQTTMessage*)msg;
 
+@property (strong,atomic) AWSMQTTRingBuffer<AWSMQTTMessage *>* queue;
+@property (nonatomic, strong) dispatch_queue_t drainSenderSerialQueue;
+@property (nonatomic, strong) AWSMQTTEncoder* encoder;
+
 @end
 
 void unit_test_class_SwapMethods(Class, SEL left, SEL right);
@@ -35,6 +48,7 @@ void unit_test_class_SwapMethods(Class, SEL left, SEL right);
 @property (nonatomic, strong) AWSMQTTSession *systemUnderTest;
 @property (nonatomic, strong) NSMutableArray<NSString *> *interactions;
 @property (nonatomic, strong) NSMutableArray<NSArray<NSString *> *> *messageHandlerTopicMessagePairs;
+@property (nonatomic, strong) NSMutableArray<AWSMQTTMessage *> *sentMessages;
 
 @end
 
@@ -47,6 +61,7 @@ void unit_test_class_SwapMethods(Class, SEL left, SEL right);
 
     NSMutableArray *messageHandlerTopicMessagePairs = [NSMutableArray array];
     self.interactions = [NSMutableArray array];
+    self.sentMessages = [NSMutableArray array];
     self.messageHandlerTopicMessagePairs = messageHandlerTopicMessagePairs;
     self.systemUnderTest = [[AWSMQTTSession alloc] initWithClientId:[[NSUUID UUID] UUIDString]
                                                            userName:[[NSUUID UUID] UUIDString]
@@ -259,6 +274,230 @@ void unit_test_class_SwapMethods(Class, SEL left, SEL right);
     }
 }
 
+- (void)testRingBufferPreservesOrderAcrossGrowth {
+    AWSMQTTRingBuffer<NSNumber *> *buffer = [[AWSMQTTRingBuffer alloc] initWithCapacity:4];
+    NSUInteger next = 0;
+    NSUInteger expected = 0;
+    for (NSUInteger round = 0; round < 50; round++) {
+        for (NSUInteger i = 0; i < 3; i++) {
+            [buffer enqueue:@(next++)];
+        }
+        XCTAssertEqualObjects([buffer peek], @(expected));
+        XCTAssertEqualObjects([buffer dequeue], @(expected++));
+    }
+    XCTAssertEqual(buffer.count, 100);
+    while (buffer.count > 0) {
+        XCTAssertEqualObjects([buffer dequeue], @(expected++));
+    }
+    XCTAssertNil([buffer dequeue]);
+    XCTAssertEqual(expected, 150);
+}
+
+- (void)testInflightWindowHoldsPublishesUntilAcknowledged {
+    [self swapSendAndRun:^{
+        [self markConnected:self.systemUnderTest];
+        self.systemUnderTest.maxInflightPublishes = 2;
+
+        NSMutableArray<NSNumber *> *msgIds = [NSMutableArray array];
+        for (int i = 0; i < 5; i++) {
+            NSData *data = [[NSString stringWithFormat:@"message %d", i] dataUsingEncoding:NSUTF8StringEncoding];
+            [msgIds addObject:@([self.systemUnderTest publishDataAtLeastOnce:data onTopic:@"topic"])];
+        }
+        XCTAssertEqual([self publishCount], 2);
+
+        [self.systemUnderTest handlePuback:[AWSMQTTMessage pubackMessageWithMessageId:[msgIds[0] unsignedShortValue]]];
+        XCTAssertEqual([self publishCount], 3);
+
+        for (NSNumber *msgId in [msgIds subarrayWithRange:NSMakeRange(1, 4)]) {
+            [self.systemUnderTest handlePuback:[AWSMQTTMessage pubackMessageWithMessageId:[msgId unsignedShortValue]]];
+        }
+        XCTAssertEqual([self publishCount], 5);
+        XCTAssertEqual([[self.interactions filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"SELF BEGINSWITH %@", @"-[MQTTSessionTests session:newAckForMessageId:]"]] count], 5);
+    }];
+}
+
+- (void)testPublishesAreHeldUntilConnectedAndReplayedWithDupFlag {
+    [self swapSendAndRun:^{
+        [self.systemUnderTest publishDataAtLeastOnce:[NSData dataWithBytes:"a" length:1] onTopic:@"topic"];
+        [self.systemUnderTest publishDataAtLeastOnce:[NSData dataWithBytes:"b" length:1] onTopic:@"topic"];
+        XCTAssertEqual([self publishCount], 0);
+
+        [self markConnected:self.systemUnderTest];
+        [self.systemUnderTest replayFlows];
+        XCTAssertEqual([self publishCount], 2);
+        XCTAssertFalse(self.sentMessages.lastObject.isDuplicate);
+
+        // A reconnect resends everything that is still unacknowledged.
+        [self.sentMessages removeAllObjects];
+        [self.systemUnderTest replayFlows];
+        XCTAssertEqual([self publishCount], 2);
+        for (AWSMQTTMessage *message in self.sentMessages) {
+            XCTAssertTrue(message.isDuplicate);
+        }
+    }];
+}
+
+- (void)testOutboxRestoresUnacknowledgedPublishes {
+    NSURL *fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [self swapSendAndRun:^{
+        AWSMQTTOutbox *outbox = [[AWSMQTTOutbox alloc] initWithFileURL:fileURL clientId:@"client"];
+        self.systemUnderTest.outbox = outbox;
+        [self markConnected:self.systemUnderTest];
+        UInt16 first = [self.systemUnderTest publishDataAtLeastOnce:[NSData dataWithBytes:"a" length:1] onTopic:@"topic"];
+        [self.systemUnderTest publishDataAtLeastOnce:[NSData dataWithBytes:"b" length:1] onTopic:@"topic"];
+        [self.systemUnderTest publishDataExactlyOnce:[NSData dataWithBytes:"c" length:1] onTopic:@"topic"];
+        [self.systemUnderTest handlePuback:[AWSMQTTMessage pubackMessageWithMessageId:first]];
+        // Waits for the outbox writes to land.
+        [outbox enumerateMessagesUsingBlock:^(UInt16 messageId, AWSMQTTMessage *message) {}];
+
+        AWSMQTTSession *restored = [self newSession];
+        restored.outbox = [[AWSMQTTOutbox alloc] initWithFileURL:fileURL clientId:@"client"];
+        [self.sentMessages removeAllObjects];
+        [self markConnected:restored];
+        [restored replayFlows];
+
+        XCTAssertEqual([self publishCount], 2);
+        XCTAssertEqual(self.sentMessages[0].qos, 1);
+        XCTAssertEqual(self.sentMessages[1].qos, 2);
+        for (AWSMQTTMessage *message in self.sentMessages) {
+            XCTAssertTrue(message.isDuplicate);
+        }
+
+        // Another client's messages are not restored.
+        AWSMQTTSession *otherClient = [self newSession];
+        otherClient.outbox = [[AWSMQTTOutbox alloc] initWithFileURL:fileURL clientId:@"other"];
+        [self.sentMessages removeAllObjects];
+        [self markConnected:otherClient];
+        [otherClient replayFlows];
+        XCTAssertEqual([self publishCount], 0);
+    }];
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+}
+
+- (void)testEncoderBacklogIsBoundedAndDroppedMessagesAreRequeued {
+    // A socket that takes one byte at a time keeps the first frame in the encoder.
+    TestRecordingOutputStream *stream = [[TestRecordingOutputStream alloc] initRecordingData:NO];
+    stream.maximumWriteLength = 1;
+    [stream open];
+    AWSMQTTEncoder *encoder = [[AWSMQTTEncoder alloc] initWithStream:stream];
+    encoder.status = AWSMQTTEncoderStatusReady;
+    self.systemUnderTest.encoder = encoder;
+    [self markConnected:self.systemUnderTest];
+
+    [self.systemUnderTest send:[AWSMQTTMessage pingreqMessage]];
+    for (int i = 0; i < 100; i++) {
+        NSData *data = [[NSString stringWithFormat:@"message %d", i] dataUsingEncoding:NSUTF8StringEncoding];
+        [self.systemUnderTest publishDataAtMostOnce:data onTopic:@"topic"];
+    }
+    XCTAssertEqual([self queuedMessageCount], 85);
+    XCTAssertFalse([self.systemUnderTest isReadyToPublish]);
+
+    // Closing drops the backlog. The publishes go back to the session queue, the PINGREQ does not.
+    [encoder close];
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+    while ([self queuedMessageCount] < 100 && [deadline timeIntervalSinceNow] > 0) {
+        [NSThread sleepForTimeInterval:0.01];
+    }
+    XCTAssertEqual([self queuedMessageCount], 100);
+    XCTAssertEqual(encoder.status, AWSMQTTEncoderStatusEndEncountered);
+    XCTAssertFalse([self.systemUnderTest isReadyToPublish]);
+}
+
+- (void)testErrorDelaysNotificationWithoutBlockingTheEventLoop {
+    AWSIoTStreamEventLoop *eventLoop = [[AWSIoTStreamEventLoop alloc] initWithName:@"MQTTSessionTests"];
+    XCTestExpectation *eventLoopExpectation = [self expectationWithDescription:@"Event loop ran the next block"];
+    XCTestExpectation *errorExpectation = [self expectationWithDescription:@"Delegate notified of the error"];
+    TestMQTTSessionDelegate *delegate = [[TestMQTTSessionDelegate alloc] initWithOnMessageBlock:nil
+                                                                                        onEvent:^(AWSMQTTSession *session, AWSMQTTSessionEvent eventCode) {
+        XCTAssertEqual(eventCode, AWSMQTTSessionEventConnectionError);
+        XCTAssertEqualObjects([NSThread currentThread], eventLoop.thread);
+        [errorExpectation fulfill];
+    }
+                                                                                          onAck:nil];
+    self.systemUnderTest.delegate = delegate;
+
+    [eventLoop performBlock:^{
+        [self.systemUnderTest error:AWSMQTTSessionEventConnectionError];
+    }];
+    [eventLoop performBlock:^{
+        [eventLoopExpectation fulfill];
+    }];
+
+    [self waitForExpectations:@[eventLoopExpectation] timeout:0.5];
+    [self waitForExpectations:@[errorExpectation] timeout:2];
+    [eventLoop stop];
+}
+
+- (void)testSustainedAtLeastOncePublishingPerformance {
+    NSData *payload = [NSMutableData dataWithLength:256];
+    [self swapSendAndRun:^{
+        [self measureBlock:^{
+            AWSMQTTSession *session = [self newSession];
+            session.maxInflightPublishes = 64;
+            [self markConnected:session];
+            [self.sentMessages removeAllObjects];
+
+            AWSMQTTRingBuffer<NSNumber *> *unacknowledged = [AWSMQTTRingBuffer new];
+            for (int i = 0; i < 10000; i++) {
+                [unacknowledged enqueue:@([session publishDataAtLeastOnce:payload onTopic:@"telemetry"])];
+                // The broker acknowledges with a lag of half the window.
+                if (unacknowledged.count > 32) {
+                    [session handlePuback:[AWSMQTTMessage pubackMessageWithMessageId:[[unacknowledged dequeue] unsignedShortValue]]];
+                }
+            }
+            while (unacknowledged.count > 0) {
+                [session handlePuback:[AWSMQTTMessage pubackMessageWithMessageId:[[unacknowledged dequeue] unsignedShortValue]]];
+            }
+            XCTAssertEqual([self publishCount], 10000);
+        }];
+    }];
+}
+
+#pragma mark - Helpers
+
+- (AWSMQTTSession *)newSession {
+    AWSMQTTSession *session = [[AWSMQTTSession alloc] initWithClientId:@"client"
+                                                              userName:nil
+                                                              password:nil
+                                                             keepAlive:1
+                                                          cleanSession:NO
+                                                             willTopic:nil
+                                                               willMsg:nil
+                                                               willQoS:0
+                                                        willRetainFlag:NO
+                                                  publishRetryThrottle:10];
+    session.delegate = self;
+    return session;
+}
+
+- (void)markConnected:(AWSMQTTSession *)session {
+    [session setValue:@(AWSMQTTSessionStatusConnected) forKey:@"status"];
+}
+
+- (NSUInteger)queuedMessageCount {
+    __block NSUInteger count = 0;
+    dispatch_sync(self.systemUnderTest.drainSenderSerialQueue, ^{
+        count = self.systemUnderTest.queue.count;
+    });
+    return count;
+}
+
+- (NSUInteger)publishCount {
+    return [[self.sentMessages filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"type == %d", AWSMQTTPublish]] count];
+}
+
+- (void)swapSendAndRun:(void (^)(void))block {
+    SEL originalSelector = @selector(send:);
+    SEL swizzledSelector = @selector(_unit_test_override_send:);
+    Class class = [AWSMQTTSession class];
+    unit_test_class_SwapMethods(class, originalSelector, swizzledSelector);
+    @try {
+        block();
+    } @finally {
+        unit_test_class_SwapMethods(class, swizzledSelector, originalSelector);
+    }
+}
+
 #pragma mark - AWSMQTTSessionDelegate
 
 - (void)session:(AWSMQTTSession*)session handleEvent:(AWSMQTTSessionEvent)eventCode
@@ -279,6 +518,7 @@ void unit_test_class_SwapMethods(Class, SEL left, SEL right);
 - (void)_unit_test_override_session:(AWSMQTTSession*)session didSend:(AWSMQTTMessage*)message
 {
     [self.interactions addObject:[NSString stringWithFormat:@"%s %i %@", __FUNCTION__, message.type, message.data]];
+    [self.sentMessages addObject:message];
 }
 
 @end
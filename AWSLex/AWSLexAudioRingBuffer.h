@@ -0,0 +1,113 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * A snapshot of the audio that has passed through an `AWSLexAudioRingBuffer`.
+ */
+@interface AWSLexAudioStreamingMetrics : NSObject
+
+/*
+ * Bytes of audio handed to the buffer, including the bytes that were dropped.
+ */
+@property (nonatomic, readonly) NSUInteger capturedByteCount;
+
+/*
+ * Bytes of audio written to the request body stream.
+ */
+@property (nonatomic, readonly) NSUInteger streamedByteCount;
+
+/*
+ * Bytes of audio dropped because the buffer was full.
+ */
+@property (nonatomic, readonly) NSUInteger droppedByteCount;
+
+/*
+ * The number of writes that did not fit in the buffer.
+ */
+@property (nonatomic, readonly) NSUInteger overrunCount;
+
+/*
+ * Bytes of audio waiting to be streamed.
+ */
+@property (nonatomic, readonly) NSUInteger bufferedByteCount;
+
+/*
+ * The most audio that has been waiting to be streamed at once.
+ */
+@property (nonatomic, readonly) NSUInteger peakBufferedByteCount;
+
+@end
+
+/*
+ * A fixed-capacity FIFO of audio frames between the audio source and the request body stream. Each write is one frame
+ * from the encoder. When a new frame does not fit, the oldest whole frames are dropped to make room rather than
+ * growing the buffer, so the stream never holds part of a PCM sample or of an Opus frame. The first frame written
+ * after a reset, which carries the stream header such as the Opus preamble, and a frame that has been partly read are
+ * never dropped; if the new frame still does not fit, it is dropped instead. Readable bytes are handed out as
+ * contiguous regions of the buffer's storage so they can be written to a stream without an intermediate copy. All
+ * methods are thread safe.
+ */
+@interface AWSLexAudioRingBuffer : NSObject
+
+@property (nonatomic, readonly) NSUInteger capacity;
+
+/*
+ * Bytes waiting to be read.
+ */
+@property (nonatomic, readonly) NSUInteger length;
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/*
+ * Copies a frame into the buffer, dropping the oldest whole frames if there is not enough room.
+ *
+ * @return the number of bytes stored: `length`, or 0 if the frame was dropped.
+ */
+- (NSUInteger)writeBytes:(const void *)bytes length:(NSUInteger)length;
+
+/*
+ * Returns the oldest contiguous region of readable bytes, or NULL if the buffer is empty. The region stays valid until
+ * it is consumed or a write drops or moves it; it may be shorter than `length` when the readable bytes wrap around the end
+ * of the storage. Use `writeToOutputStream:` when writes may happen at the same time.
+ */
+- (nullable const uint8_t *)readableBytesWithLength:(NSUInteger *)length;
+
+/*
+ * Marks bytes returned by `readableBytesWithLength:` as read.
+ */
+- (void)consumeLength:(NSUInteger)length;
+
+/*
+ * Writes readable bytes straight from the buffer's storage to the stream until the stream has no space left or the
+ * buffer is empty.
+ *
+ * @return the number of bytes written, or -1 if the stream failed.
+ */
+- (NSInteger)writeToOutputStream:(NSOutputStream *)outputStream;
+
+/*
+ * Discards the readable bytes and resets the metrics.
+ */
+- (void)reset;
+
+- (AWSLexAudioStreamingMetrics *)metrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
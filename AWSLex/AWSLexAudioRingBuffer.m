@@ -0,0 +1,226 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSLexAudioRingBuffer.h"
+
+@interface AWSLexAudioStreamingMetrics()
+
+@property (nonatomic, assign) NSUInteger capturedByteCount;
+@property (nonatomic, assign) NSUInteger streamedByteCount;
+@property (nonatomic, assign) NSUInteger droppedByteCount;
+@property (nonatomic, assign) NSUInteger overrunCount;
+@property (nonatomic, assign) NSUInteger bufferedByteCount;
+@property (nonatomic, assign) NSUInteger peakBufferedByteCount;
+
+@end
+
+@implementation AWSLexAudioStreamingMetrics
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p> captured: %lu, streamed: %lu, dropped: %lu, overruns: %lu, buffered: %lu, peak: %lu",
+            NSStringFromClass([self class]), self,
+            (unsigned long)self.capturedByteCount,
+            (unsigned long)self.streamedByteCount,
+            (unsigned long)self.droppedByteCount,
+            (unsigned long)self.overrunCount,
+            (unsigned long)self.bufferedByteCount,
+            (unsigned long)self.peakBufferedByteCount];
+}
+
+@end
+
+@implementation AWSLexAudioRingBuffer {
+    uint8_t *_storage;
+    NSUInteger _readIndex;
+    NSUInteger _length;
+    NSUInteger _capturedByteCount;
+    NSUInteger _streamedByteCount;
+    NSUInteger _droppedByteCount;
+    NSUInteger _overrunCount;
+    NSUInteger _peakLength;
+    // The lengths of the whole writes (encoder frames) in the buffer, oldest first.
+    NSMutableArray<NSNumber *> *_frameLengths;
+    // Bytes of the oldest frame that have already been read.
+    NSUInteger _headFrameReadLength;
+    // Whether the oldest frame is the stream header, the first frame written since the last reset.
+    BOOL _headFrameIsHeader;
+    BOOL _headerWritten;
+}
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithCapacity:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    if (self = [super init]) {
+        _capacity = MAX(capacity, 1);
+        _storage = malloc(_capacity);
+        if (!_storage) {
+            return nil;
+        }
+        _frameLengths = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_storage);
+}
+
+- (NSUInteger)length {
+    @synchronized(self) {
+        return _length;
+    }
+}
+
+- (NSUInteger)writeBytes:(const void *)bytes length:(NSUInteger)length {
+    @synchronized(self) {
+        _capturedByteCount += length;
+        if (length == 0) {
+            return 0;
+        }
+
+        // Only whole frames are dropped, so the stream never holds part of a sample or of an encoded frame. The oldest
+        // frame stays when it is the stream header or has been partly read.
+        NSUInteger keptLength = 0;
+        if (_frameLengths.count > 0 && (_headFrameIsHeader || _headFrameReadLength > 0)) {
+            keptLength = _frameLengths[0].unsignedIntegerValue - _headFrameReadLength;
+        }
+        if (_length + length > _capacity) {
+            _overrunCount++;
+            if (length > _capacity - keptLength) {
+                _droppedByteCount += length;
+                return 0;
+            }
+            [self dropOldestFramesForLength:length keptLength:keptLength];
+        }
+
+        NSUInteger writeIndex = (_readIndex + _length) % _capacity;
+        NSUInteger firstPart = MIN(length, _capacity - writeIndex);
+        memcpy(_storage + writeIndex, bytes, firstPart);
+        if (length > firstPart) {
+            memcpy(_storage, (const uint8_t *)bytes + firstPart, length - firstPart);
+        }
+
+        if (!_headerWritten) {
+            _headerWritten = YES;
+            _headFrameIsHeader = YES;
+        }
+        [_frameLengths addObject:@(length)];
+        _length += length;
+        _peakLength = MAX(_peakLength, _length);
+        return length;
+    }
+}
+
+// Drops the oldest whole frames behind the kept part of the oldest frame until `length` bytes fit. The kept bytes
+// are moved up to sit right before the remaining frames. Called while synchronized.
+- (void)dropOldestFramesForLength:(NSUInteger)length keptLength:(NSUInteger)keptLength {
+    NSUInteger firstDroppedFrame = keptLength > 0 ? 1 : 0;
+    NSUInteger droppedLength = 0;
+    NSUInteger droppedFrameCount = 0;
+    while (_length - droppedLength + length > _capacity) {
+        droppedLength += _frameLengths[firstDroppedFrame + droppedFrameCount].unsignedIntegerValue;
+        droppedFrameCount++;
+    }
+    [_frameLengths removeObjectsInRange:NSMakeRange(firstDroppedFrame, droppedFrameCount)];
+
+    for (NSUInteger i = keptLength; i > 0; i--) {
+        _storage[(_readIndex + droppedLength + i - 1) % _capacity] = _storage[(_readIndex + i - 1) % _capacity];
+    }
+    _readIndex = (_readIndex + droppedLength) % _capacity;
+    _length -= droppedLength;
+    _droppedByteCount += droppedLength;
+}
+
+- (const uint8_t *)readableBytesWithLength:(NSUInteger *)length {
+    @synchronized(self) {
+        *length = MIN(_length, _capacity - _readIndex);
+        return _length > 0 ? _storage + _readIndex : NULL;
+    }
+}
+
+- (void)consumeLength:(NSUInteger)length {
+    @synchronized(self) {
+        length = MIN(length, _length);
+        _readIndex = (_readIndex + length) % _capacity;
+        _length -= length;
+        _streamedByteCount += length;
+        _headFrameReadLength += length;
+        while (_frameLengths.count > 0 && _headFrameReadLength >= _frameLengths[0].unsignedIntegerValue) {
+            _headFrameReadLength -= _frameLengths[0].unsignedIntegerValue;
+            [_frameLengths removeObjectAtIndex:0];
+            _headFrameIsHeader = NO;
+        }
+        if (_length == 0) {
+            // Start over at the beginning so the next writes are read back in one region.
+            _readIndex = 0;
+        }
+    }
+}
+
+- (NSInteger)writeToOutputStream:(NSOutputStream *)outputStream {
+    @synchronized(self) {
+        NSInteger total = 0;
+        while (_length > 0 && [outputStream hasSpaceAvailable]) {
+            NSUInteger regionLength = 0;
+            const uint8_t *region = [self readableBytesWithLength:&regionLength];
+            NSInteger written = [outputStream write:region maxLength:regionLength];
+            if (written < 0) {
+                return -1;
+            }
+            if (written == 0) {
+                break;
+            }
+            [self consumeLength:(NSUInteger)written];
+            total += written;
+        }
+        return total;
+    }
+}
+
+- (void)reset {
+    @synchronized(self) {
+        _readIndex = 0;
+        _length = 0;
+        [_frameLengths removeAllObjects];
+        _headFrameReadLength = 0;
+        _headFrameIsHeader = NO;
+        _headerWritten = NO;
+        _capturedByteCount = 0;
+        _streamedByteCount = 0;
+        _droppedByteCount = 0;
+        _overrunCount = 0;
+        _peakLength = 0;
+    }
+}
+
+- (AWSLexAudioStreamingMetrics *)metrics {
+    AWSLexAudioStreamingMetrics *metrics = [AWSLexAudioStreamingMetrics new];
+    @synchronized(self) {
+        metrics.capturedByteCount = _capturedByteCount;
+        metrics.streamedByteCount = _streamedByteCount;
+        metrics.droppedByteCount = _droppedByteCount;
+        metrics.overrunCount = _overrunCount;
+        metrics.bufferedByteCount = _length;
+        metrics.peakBufferedByteCount = _peakLength;
+    }
+    return metrics;
+}
+
+@end
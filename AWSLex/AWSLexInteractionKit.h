@@ -19,6 +19,7 @@
 #import <AWSCore/AWSCore.h>
 #import "AWSLexModel.h"
 #import "AWSLexService.h"
+#import "AWSLexAudioRingBuffer.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -191,6 +192,19 @@ typedef NS_ENUM(NSInteger, AWSLexSpeechEncoding) {
  */
 @property (nonatomic, assign) AWSLexSpeechEncoding encoding;
 
+/*
+ * Bytes of captured audio that can wait for the request to read them. When the buffer is full, the oldest whole
+ * frames of waiting audio are dropped, and counted as dropped in `audioStreamingMetrics`. Defaults to 256 KB.
+ */
+@property (nonatomic, assign) NSUInteger audioBufferCapacity;
+
+/*
+ * Keep a copy of the whole utterance so a failed request can be retried and `interactionKitOnRecordingEnd:audioStream:contentType:`
+ * receives the audio. When disabled, memory use no longer grows with the length of the recording, speech requests are not
+ * retried and the recording end callback receives empty audio. Defaults to true.
+ */
+@property (nonatomic, assign) BOOL       retainsRecordedAudio;
+
 /*
  * Set sessionAttribute globally.
  */
@@ -422,6 +436,11 @@ typedef NS_ENUM(NSInteger, AWSLexSpeechEncoding) {
  */
 - (void)cancel;
 
+/**
+ Returns how much of the captured audio has been streamed to the service, buffered or dropped since listening last started.
+ */
+- (AWSLexAudioStreamingMetrics * _Nullable)audioStreamingMetrics;
+
 @end
 
 @interface AWSLexSwitchModeInput : NSObject
@@ -19,6 +19,7 @@
 #import "BFAudioRecorder.h"
 #import "AWSLex.h"
 #import "AWSLexRequestRetryHandler.h"
+#import "AWSLexAudioRingBuffer.h"
 #import <AVFoundation/AVFoundation.h>
 
 NSString *const AWSInfoInteractionKit = @"LexInteractionKit";
@@ -46,6 +47,8 @@ NSString *const AWSLexInteractionKitReleaseAudioSourceLockObject = @"AWSLexInter
 const NSUInteger DefaultInteractionKitStartingPointThreshold = 9;
 const NSUInteger DefaultInteractionKitEndpointThreshold = 80;
 const float      DefaultInteractionKitLrtThreshold = 1.8f;
+//About 8 seconds of 16 kHz, 16 bit PCM.
+const NSUInteger DefaultInteractionKitAudioBufferCapacity = 256 * 1024;
 
 typedef NS_ENUM(NSInteger, AWSLexSpeechState) {
     AWSLexSpeechStateUninitialized,
@@ -157,6 +160,8 @@ const NSUInteger MaxSpeechTimeoutInterval = 15;
         });
         _botName = botName;
         _botAlias = botAlias;
+        _audioBufferCapacity = DefaultInteractionKitAudioBufferCapacity;
+        _retainsRecordedAudio = YES;
     }
     return self;
 }
@@ -190,6 +195,8 @@ const NSUInteger MaxSpeechTimeoutInterval = 15;
     config.noSpeechTimeoutInterval = NoSpeechTimeoutInterval;
     config.maxSpeechTimeoutInterval = MaxSpeechTimeoutInterval;
     config.autoPlayback = YES;
+    config.audioBufferCapacity = DefaultInteractionKitAudioBufferCapacity;
+    config.retainsRecordedAudio = YES;
     return config;
 }
 
@@ -205,6 +212,8 @@ const NSUInteger MaxSpeechTimeoutInterval = 15;
     configuration.noSpeechTimeoutInterval = _noSpeechTimeoutInterval;
     configuration.maxSpeechTimeoutInterval = _maxSpeechTimeoutInterval;
     configuration.autoPlayback = _autoPlayback;
+    configuration.audioBufferCapacity = _audioBufferCapacity;
+    configuration.retainsRecordedAudio = _retainsRecordedAudio;
     return configuration;
 }
 
@@ -232,7 +241,6 @@ const NSUInteger MaxSpeechTimeoutInterval = 15;
 
 @implementation AWSLexInteractionKit{
     AWSLexAudioPlayer *audioPlayer;
-    NSUInteger numOfBytesSent;
     BOOL isStreaming;
     NSDate *recordingStartDate;
     AWSLexSpeechState speechState;
@@ -241,11 +249,14 @@ const NSUInteger MaxSpeechTimeoutInterval = 15;
     BFVADConfig *vadConfig;
     
     // the processed audio to be sent over http
-    NSMutableData *consumerAudioBuffer;
     NSInputStream *consumerStream;
-    //the processed audio buffer
-    NSMutableData *producerAudioBuffer;
+    //the processed audio waiting for space in the producer stream
+    AWSLexAudioRingBuffer *audioRingBuffer;
+    //the whole utterance, kept for retries and the recording end callback
+    NSMutableData *recordedAudio;
     NSOutputStream *producerStream;
+    //listening has stopped; close the producer stream once the buffered audio has been written to it
+    BOOL closesProducerStreamWhenDrained;
     
     dispatch_queue_t interactionDelegateQueue;
     
@@ -565,7 +576,7 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     [self dispatchBlockOnMainQueue:^{
         if(weakSelf.microphoneDelegate && [weakSelf.microphoneDelegate respondsToSelector:@selector(interactionKitOnRecordingEnd:audioStream:contentType:)]) {
             //TODO: need to decode the audio to something thats understandable by the audio player.
-            [weakSelf.microphoneDelegate interactionKitOnRecordingEnd:weakSelf audioStream:[self->producerAudioBuffer copy] contentType:[self->audioSource contentType]];
+            [weakSelf.microphoneDelegate interactionKitOnRecordingEnd:weakSelf audioStream:[self->recordedAudio copy] ?: [NSData data] contentType:[self->audioSource contentType]];
         }
     }];
 }
@@ -614,8 +625,9 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         consumerStream = cStream;
         producerStream = pStream;
         
-        producerAudioBuffer = [NSMutableData new];
-        consumerAudioBuffer = [NSMutableData new];
+        audioRingBuffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:self.interactionKitConfig.audioBufferCapacity];
+        recordedAudio = self.interactionKitConfig.retainsRecordedAudio ? [NSMutableData new] : nil;
+        closesProducerStreamWhenDrained = NO;
         
         producerStream.delegate = self;
         
@@ -624,8 +636,6 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
                                   forMode:NSDefaultRunLoopMode];
         [producerStream open];
         
-        numOfBytesSent = 0;
-        
         [audioSource start];
         
         AWSDDLogVerbose(@"Started Listening to Audio Source");
@@ -636,32 +646,47 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     if (isListening) {
         AWSDDLogVerbose(@"Stop Listening",nil);
         isListening = NO;
+        [self releaseAudioSource];
+        
+        //the end of the utterance may still be waiting in the ring buffer for the request to read it.
+        closesProducerStreamWhenDrained = YES;
+        if (!isStreaming || [self writeBufferedAudio] < 0 || [audioRingBuffer length] == 0) {
+            [self closeProducerStream];
+        }
+    }
+}
+
+- (void)closeProducerStream{
+    @synchronized (self) {
+        closesProducerStreamWhenDrained = NO;
         [producerStream close];
         producerStream.delegate = nil;
-        
-        [self releaseAudioSource];
     }
 }
 
 - (void)streamAudio:(NSData *)audio{
-    [producerAudioBuffer appendBytes:audio.bytes length:audio.length];
-    if(producerAudioBuffer.length > numOfBytesSent && [producerStream hasSpaceAvailable]) {
-        NSRange range = NSMakeRange(numOfBytesSent, producerAudioBuffer.length - numOfBytesSent);
-        UInt8 chunkBuffer[range.length];
-        [producerAudioBuffer getBytes:chunkBuffer range:range];
-        NSInteger result = [producerStream write:chunkBuffer maxLength:range.length];
-        AWSDDLogVerbose(@"wrote %ld to producer stream", (long)result);
-        if (result >= 0) {
-            numOfBytesSent += result;
-            //start streaming only after we get an actual audio
-            [self startStreaming];
-        }else{
-            NSError *audioError = [NSError errorWithDomain:AWSLexInteractionKitErrorDomain code:AWSLexInteractionKitErrorCodeAudioStreaming userInfo:nil];
-            [self handleError:audioError];
-        }
+    [recordedAudio appendData:audio];
+    [audioRingBuffer writeBytes:audio.bytes length:audio.length];
+    if ([self writeBufferedAudio] > 0) {
+        //start streaming only after we get an actual audio
+        [self startStreaming];
     }
 }
 
+- (NSInteger)writeBufferedAudio{
+    NSInteger result = [audioRingBuffer writeToOutputStream:producerStream];
+    AWSDDLogVerbose(@"wrote %ld to producer stream", (long)result);
+    if (result < 0) {
+        NSError *audioError = [NSError errorWithDomain:AWSLexInteractionKitErrorDomain code:AWSLexInteractionKitErrorCodeAudioStreaming userInfo:nil];
+        [self handleError:audioError];
+    }
+    return result;
+}
+
+- (AWSLexAudioStreamingMetrics *)audioStreamingMetrics{
+    return [audioRingBuffer metrics];
+}
+
 - (void)startStreaming{
     if(!isStreaming) {
         isStreaming = YES;
@@ -699,6 +724,17 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             [self handleError:streamError];
             break;
         }
+        case NSStreamEventHasSpaceAvailable:{
+            //the request has read some audio; send what was buffered while the stream was full.
+            if (aStream == producerStream) {
+                if ([self writeBufferedAudio] >= 0
+                    && closesProducerStreamWhenDrained
+                    && [audioRingBuffer length] == 0) {
+                    [self closeProducerStream];
+                }
+            }
+            break;
+        }
         default:
             break;
     }
@@ -947,11 +983,16 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 
 #pragma mark - Retry Handler
 
+- (BOOL)canResetInputStream{
+    //without the recorded audio there is nothing to resend.
+    return self.currentState != AWSLexInteractionModeSpeech || recordedAudio != nil;
+}
+
 - (NSInputStream *)resetInputStream{
     //iOS doesn't allow seeking for non file based streams.
     //So resetting the consumer stream to a new input stream.
     if (self.currentState == AWSLexInteractionModeSpeech) {
-        consumerStream = [[NSInputStream alloc] initWithData:producerAudioBuffer];
+        consumerStream = [[NSInputStream alloc] initWithData:recordedAudio ?: [NSData data]];
         return consumerStream;
     }else{
         return [[NSInputStream alloc] initWithData:[textInput dataUsingEncoding:NSUTF8StringEncoding]];
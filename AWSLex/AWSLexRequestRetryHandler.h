@@ -20,6 +20,10 @@
 
 - (NSInputStream *)resetInputStream;
 
+@optional
+
+- (BOOL)canResetInputStream;
+
 @end
 
 @interface AWSLexRequestRetryHandler : AWSURLRequestRetryHandler
@@ -30,6 +30,9 @@
                                                     error:error];
     
     if(retryType != AWSNetworkingRetryTypeShouldNotRetry && [response.URL.path hasSuffix:@"/content"]) {
+        if([self.delegate respondsToSelector:@selector(canResetInputStream)] && ![self.delegate canResetInputStream]) {
+            return AWSNetworkingRetryTypeShouldNotRetry;
+        }
         return AWSNetworkingRetryTypeResetStreamAndRetry;
     }
     
@@ -0,0 +1,243 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <mach/mach.h>
+#import "AWSLexAudioRingBuffer.h"
+
+// 16 kHz, 16 bit mono PCM delivered in 20 ms frames.
+static const NSUInteger AWSLexTestSampleRate = 16000;
+static const NSUInteger AWSLexTestFrameBytes = AWSLexTestSampleRate * 2 / 50;
+
+static uint64_t AWSLexTestMemoryFootprint(void) {
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.phys_footprint;
+}
+
+@interface AWSLexAudioRingBufferTests : XCTestCase
+
+@end
+
+@implementation AWSLexAudioRingBufferTests
+
+- (void)testWriteAndReadAcrossTheEndOfStorage {
+    AWSLexAudioRingBuffer *buffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:8];
+    XCTAssertEqual([buffer writeBytes:"abcdef" length:6], 6);
+
+    NSUInteger length = 0;
+    const uint8_t *region = [buffer readableBytesWithLength:&length];
+    XCTAssertEqual(length, 6);
+    XCTAssertEqual(memcmp(region, "abcd", 4), 0);
+    [buffer consumeLength:4];
+
+    XCTAssertEqual([buffer writeBytes:"ghijk" length:5], 5);
+    XCTAssertEqual(buffer.length, 7);
+
+    // The readable bytes wrap around; they are handed out as two regions without copying.
+    region = [buffer readableBytesWithLength:&length];
+    XCTAssertEqual(length, 4);
+    XCTAssertEqual(memcmp(region, "efgh", 4), 0);
+    [buffer consumeLength:length];
+
+    region = [buffer readableBytesWithLength:&length];
+    XCTAssertEqual(length, 3);
+    XCTAssertEqual(memcmp(region, "ijk", 3), 0);
+    [buffer consumeLength:length];
+
+    XCTAssertEqual(buffer.length, 0);
+    XCTAssertTrue([buffer readableBytesWithLength:&length] == NULL);
+    XCTAssertEqual(length, 0);
+    XCTAssertEqual([buffer metrics].streamedByteCount, 11);
+}
+
+- (NSData *)readAllFromBuffer:(AWSLexAudioRingBuffer *)buffer {
+    NSMutableData *readable = [NSMutableData new];
+    NSUInteger length = 0;
+    const uint8_t *region = NULL;
+    while ((region = [buffer readableBytesWithLength:&length]) != NULL) {
+        [readable appendBytes:region length:length];
+        [buffer consumeLength:length];
+    }
+    return readable;
+}
+
+- (void)testOverrunDropsWholeFramesAndKeepsTheHeader {
+    AWSLexAudioRingBuffer *buffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:10];
+
+    // The first frame is the stream header. Room for "hij" is made by dropping the oldest frame behind it.
+    XCTAssertEqual([buffer writeBytes:"HDR" length:3], 3);
+    XCTAssertEqual([buffer writeBytes:"abcd" length:4], 4);
+    XCTAssertEqual([buffer writeBytes:"efg" length:3], 3);
+    XCTAssertEqual([buffer writeBytes:"hij" length:3], 3);
+    XCTAssertEqualObjects([self readAllFromBuffer:buffer], [@"HDRefghij" dataUsingEncoding:NSUTF8StringEncoding]);
+
+    // A frame that has been partly read is kept whole, and a frame that cannot fit is dropped rather than cut.
+    XCTAssertEqual([buffer writeBytes:"klmno" length:5], 5);
+    XCTAssertEqual([buffer writeBytes:"pqrs" length:4], 4);
+    [buffer consumeLength:2];
+    XCTAssertEqual([buffer writeBytes:"tuvwx" length:5], 5);
+    XCTAssertEqual([buffer writeBytes:"yz0123456789" length:12], 0);
+    XCTAssertEqualObjects([self readAllFromBuffer:buffer], [@"mnotuvwx" dataUsingEncoding:NSUTF8StringEncoding]);
+
+    AWSLexAudioStreamingMetrics *metrics = [buffer metrics];
+    XCTAssertEqual(metrics.capturedByteCount, 39);
+    XCTAssertEqual(metrics.droppedByteCount, 20);
+    XCTAssertEqual(metrics.overrunCount, 3);
+    XCTAssertEqual(metrics.streamedByteCount, 19);
+    XCTAssertEqual(metrics.peakBufferedByteCount, 10);
+
+    [buffer reset];
+    metrics = [buffer metrics];
+    XCTAssertEqual(metrics.capturedByteCount, 0);
+    XCTAssertEqual(metrics.droppedByteCount, 0);
+    XCTAssertEqual(buffer.length, 0);
+}
+
+- (void)testWriteToOutputStreamStopsWhenTheStreamIsFull {
+    NSInputStream *inputStream = nil;
+    NSOutputStream *outputStream = nil;
+    [NSStream getBoundStreamsWithBufferSize:1024 inputStream:&inputStream outputStream:&outputStream];
+    [inputStream open];
+    [outputStream open];
+
+    AWSLexAudioRingBuffer *buffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:4096];
+    NSMutableData *audio = [NSMutableData dataWithLength:3000];
+    for (NSUInteger i = 0; i < audio.length; i++) {
+        ((uint8_t *)audio.mutableBytes)[i] = (uint8_t)i;
+    }
+    [buffer writeBytes:audio.bytes length:audio.length];
+
+    NSMutableData *received = [NSMutableData new];
+    uint8_t readBuffer[512];
+    while (received.length < audio.length) {
+        NSInteger written = [buffer writeToOutputStream:outputStream];
+        XCTAssertGreaterThanOrEqual(written, 0);
+        NSInteger read = [inputStream read:readBuffer maxLength:sizeof(readBuffer)];
+        XCTAssertGreaterThan(read, 0);
+        [received appendBytes:readBuffer length:(NSUInteger)read];
+    }
+    XCTAssertEqualObjects(received, audio);
+    XCTAssertEqual([buffer metrics].streamedByteCount, audio.length);
+
+    [inputStream close];
+    [outputStream close];
+}
+
+/*
+ * Streams ten minutes of a 440 Hz tone through the buffer and a bound stream pair sized like the one the interaction
+ * kit uses, reading the body as a request would. Memory use must not grow with the length of the recording.
+ */
+- (void)testTenMinutesOfPCMUseFlatMemory {
+    NSInputStream *inputStream = nil;
+    NSOutputStream *outputStream = nil;
+    [NSStream getBoundStreamsWithBufferSize:4096 inputStream:&inputStream outputStream:&outputStream];
+    [inputStream open];
+    [outputStream open];
+
+    AWSLexAudioRingBuffer *buffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:64 * 1024];
+    int16_t frame[AWSLexTestFrameBytes / 2];
+    uint8_t readBuffer[2048];
+    NSUInteger frameCount = 10 * 60 * 50;
+    NSUInteger sample = 0;
+    NSUInteger receivedByteCount = 0;
+    uint64_t footprintAfterFirstMinute = 0;
+
+    for (NSUInteger i = 0; i < frameCount; i++) {
+        @autoreleasepool {
+            for (NSUInteger j = 0; j < AWSLexTestFrameBytes / 2; j++, sample++) {
+                frame[j] = (int16_t)(8000.0 * sin(2.0 * M_PI * 440.0 * sample / AWSLexTestSampleRate));
+            }
+            XCTAssertEqual([buffer writeBytes:frame length:AWSLexTestFrameBytes], AWSLexTestFrameBytes);
+            XCTAssertGreaterThanOrEqual([buffer writeToOutputStream:outputStream], 0);
+
+            // The request reads a little less than a frame each time, so audio backs up in the ring buffer
+            // until the periodic larger reads catch up.
+            NSUInteger toRead = (i % 10 == 9) ? 4 * sizeof(readBuffer) : AWSLexTestFrameBytes / 2;
+            while (toRead > 0 && [inputStream hasBytesAvailable]) {
+                NSInteger read = [inputStream read:readBuffer maxLength:MIN(toRead, sizeof(readBuffer))];
+                if (read <= 0) {
+                    break;
+                }
+                receivedByteCount += (NSUInteger)read;
+                toRead -= MIN(toRead, (NSUInteger)read);
+            }
+        }
+        if (i == 60 * 50) {
+            footprintAfterFirstMinute = AWSLexTestMemoryFootprint();
+        }
+    }
+
+    // Drain what is left.
+    while (YES) {
+        [buffer writeToOutputStream:outputStream];
+        if (![inputStream hasBytesAvailable]) {
+            break;
+        }
+        NSInteger read = [inputStream read:readBuffer maxLength:sizeof(readBuffer)];
+        if (read <= 0) {
+            break;
+        }
+        receivedByteCount += (NSUInteger)read;
+    }
+
+    AWSLexAudioStreamingMetrics *metrics = [buffer metrics];
+    NSUInteger totalByteCount = frameCount * AWSLexTestFrameBytes;
+    XCTAssertEqual(metrics.capturedByteCount, totalByteCount);
+    XCTAssertEqual(metrics.droppedByteCount, 0);
+    XCTAssertEqual(metrics.overrunCount, 0);
+    XCTAssertEqual(metrics.streamedByteCount, totalByteCount);
+    XCTAssertEqual(receivedByteCount, totalByteCount);
+    XCTAssertGreaterThan(metrics.peakBufferedByteCount, 0);
+    XCTAssertLessThanOrEqual(metrics.peakBufferedByteCount, buffer.capacity);
+
+    // Nine more minutes of audio is about 17 MB; none of it may stay behind.
+    uint64_t footprintAtEnd = AWSLexTestMemoryFootprint();
+    if (footprintAfterFirstMinute > 0 && footprintAtEnd > footprintAfterFirstMinute) {
+        XCTAssertLessThan(footprintAtEnd - footprintAfterFirstMinute, 2 * 1024 * 1024);
+    }
+
+    [inputStream close];
+    [outputStream close];
+}
+
+- (void)testStreamingPerformance {
+    NSInputStream *inputStream = nil;
+    NSOutputStream *outputStream = nil;
+    [NSStream getBoundStreamsWithBufferSize:4096 inputStream:&inputStream outputStream:&outputStream];
+    [inputStream open];
+    [outputStream open];
+
+    AWSLexAudioRingBuffer *buffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:64 * 1024];
+    NSData *frame = [NSMutableData dataWithLength:AWSLexTestFrameBytes];
+    NSMutableData *readBuffer = [NSMutableData dataWithLength:4096];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 60 * 50; i++) {
+            [buffer writeBytes:frame.bytes length:frame.length];
+            [buffer writeToOutputStream:outputStream];
+            while ([inputStream hasBytesAvailable] && [inputStream read:readBuffer.mutableBytes maxLength:readBuffer.length] > 0) {
+            }
+        }
+    }];
+
+    [inputStream close];
+    [outputStream close];
+}
+
+@end
@@ -34,6 +34,8 @@ public class AWSLocationTracker {
     let trackerName: String
     let locationService: AWSLocationBehavior
     let locationsQueue: AtomicValue<[CLLocation]> = AtomicValue(initialValue: [])
+    let lastEmittedLocation: AtomicValue<CLLocation?> = AtomicValue(initialValue: nil)
+    let journal: PositionJournal?
     var trackerOptions: TrackerOptions?
     var trackingEnabled: AtomicValue<Bool> = AtomicValue(initialValue: false)
     
@@ -62,14 +64,17 @@ public class AWSLocationTracker {
         AWSLocation.register(with: config, forKey: trackerName)
         
         self.init(trackerName: trackerName,
-                  locationService: AWSLocationAdapter(location: AWSLocation(forKey: trackerName)))
+                  locationService: AWSLocationAdapter(location: AWSLocation(forKey: trackerName)),
+                  journal: PositionJournal(trackerName: trackerName))
     }
     
     /// Internal constructor for testing
     init(trackerName: String,
-         locationService: AWSLocationBehavior) {
+         locationService: AWSLocationBehavior,
+         journal: PositionJournal? = nil) {
         self.trackerName = trackerName
         self.locationService = locationService
+        self.journal = journal
         self.operationQueue = OperationQueue()
         operationQueue.name = "com.amazonaws.AWSLocationTrackerOperationQueue"
         operationQueue.maxConcurrentOperationCount = 1
@@ -98,6 +103,12 @@ public class AWSLocationTracker {
         self.trackerOptions = getDefaultTrackerOptions(options: options)
         self.delegate = delegate
         self.listener = listener
+        if let journal = journal {
+            // Locations that were not sent before the app was last killed.
+            let journaledLocations = journal.load()
+            AWSLocationTrackerLogger.info("Restoring \(journaledLocations.count) locations from the journal.")
+            locationsQueue.set(journaledLocations)
+        }
         self.setUpRetrieveLocationsTimer()
         self.setUpEmitLocationsTimer()
         self.trackingEnabled.set(true)
@@ -114,7 +125,10 @@ public class AWSLocationTracker {
             return
         }
         AWSLocationTrackerLogger.info("Adding \(locations.count) locations to the queue.")
-        locationsQueue.append(contentsOf: locations)
+        locationsQueue.with { queue in
+            queue.append(contentsOf: locations)
+            journal?.append(locations)
+        }
     }
     
     /// True if this tracker instance is currently monitoring and sending the device's location. False otherwise.
@@ -135,6 +149,7 @@ public class AWSLocationTracker {
         }
         
         reset()
+        journal?.replace(with: [])
     }
     
     // MARK: - Internal methods
@@ -154,11 +169,9 @@ public class AWSLocationTracker {
             return trackerOptions
         }
         
-        // `customDeviceId` is to be generated, reuse existing retrieve and emit location frequenceies
-        return TrackerOptions(customDeviceId: tryGetDeviceId(for: trackerName,
-                                                             userDefaults: userDefaults),
-                              retrieveLocationFrequency: trackerOptions.retrieveLocationFrequency,
-                              emitLocationFrequency: trackerOptions.emitLocationFrequency)
+        // `customDeviceId` is to be generated, reuse the other passed in options
+        return trackerOptions.withCustomDeviceId(tryGetDeviceId(for: trackerName,
+                                                                userDefaults: userDefaults))
     }
     
     func tryGetDeviceId(for trackerName: String,
@@ -203,6 +216,10 @@ public class AWSLocationTracker {
                                                        deviceId: deviceId,
                                                        locationsQueue: self.locationsQueue,
                                                        locationService: self.locationService,
+                                                       journal: self.journal,
+                                                       filter: PositionFilter(options: options),
+                                                       lastEmittedLocation: self.lastEmittedLocation,
+                                                       maximumConcurrentBatches: options.maximumConcurrentBatches,
                                                        listener: self.listener)
                 self.operationQueue.addOperation(operation)
                 
@@ -229,6 +246,7 @@ public class AWSLocationTracker {
         }
         
         locationsQueue.set([])
+        lastEmittedLocation.set(nil)
         trackingEnabled.set(false)
     }
     
@@ -24,6 +24,13 @@ class EmitLocationsOperation: AsynchronousOperation {
     private let listener: ((TrackingListener) -> Void)?
     private let locationService: AWSLocationBehavior
     private let isCalledFromBackgroundTask: Bool
+    private let journal: PositionJournal?
+    private let filter: PositionFilter?
+    private let lastEmittedLocation: AtomicValue<CLLocation?>?
+    private let maximumConcurrentBatches: Int
+    
+    /// Serializes the handling of responses, which arrive concurrently when several batches are in flight.
+    private let responseLock = NSLock()
     
     let group = DispatchGroup()
     
@@ -32,12 +39,20 @@ class EmitLocationsOperation: AsynchronousOperation {
          locationsQueue: AtomicValue<[CLLocation]>,
          locationService: AWSLocationBehavior,
          isCalledFromBackgroundTask: Bool = false,
+         journal: PositionJournal? = nil,
+         filter: PositionFilter? = nil,
+         lastEmittedLocation: AtomicValue<CLLocation?>? = nil,
+         maximumConcurrentBatches: Int = TrackerOptions.defaultMaximumConcurrentBatches,
          listener: ((TrackingListener) -> Void)?) {
         self.trackerName = trackerName
         self.deviceId = deviceId
         self.locationsQueue = locationsQueue
         self.locationService = locationService
         self.isCalledFromBackgroundTask = isCalledFromBackgroundTask
+        self.journal = journal
+        self.filter = filter
+        self.lastEmittedLocation = lastEmittedLocation
+        self.maximumConcurrentBatches = max(maximumConcurrentBatches, 1)
         self.listener = listener
     }
     
@@ -52,48 +67,62 @@ class EmitLocationsOperation: AsynchronousOperation {
         let unexpiredLocations = self.locationsQueue.getAndSet([]).filter { (location) -> Bool in
             return Date().timeIntervalSince(location.timestamp) < EmitLocationsOperation.locationExpiryTime
         }
-        
-        let totalPositionUpdates = unexpiredLocations.map { (location) -> AWSLocationDevicePositionUpdate in
-            location.toAWSLocationDevicePositionUpdate(deviceId: deviceId)
+        let locations = filter?.filter(unexpiredLocations, after: lastEmittedLocation?.get()) ?? unexpiredLocations
+        if locations.count != unexpiredLocations.count {
+            AWSLocationTrackerLogger.verbose("Filtered \(unexpiredLocations.count) locations down to \(locations.count).")
         }
         
-        guard totalPositionUpdates.count != 0 else {
+        guard locations.count != 0 else {
             AWSLocationTrackerLogger.info("No locations to emit")
-            finish()
+            finishEmitting()
             return
         }
         
-        AWSLocationTrackerLogger.info("Emitting \(totalPositionUpdates.count) locations to Amazon Location Service.")
+        AWSLocationTrackerLogger.info("Emitting \(locations.count) locations to Amazon Location Service.")
         
-        let positionUpdateBatches = totalPositionUpdates.chunked(into: EmitLocationsOperation.maximumBatchSize)
-        for (index, positionUpdates) in positionUpdateBatches.enumerated() {
+        // Up to `maximumConcurrentBatches` requests are in flight at once.
+        let batchSlots = DispatchSemaphore(value: maximumConcurrentBatches)
+        let locationBatches = locations.chunked(into: EmitLocationsOperation.maximumBatchSize)
+        for (index, batch) in locationBatches.enumerated() {
             AWSLocationTrackerLogger.verbose(
-                "Emitting locations to Amazon Location Service. Batch \(index + 1) of \(positionUpdates.count)")
+                "Emitting locations to Amazon Location Service. Batch \(index + 1) of \(locationBatches.count)")
 
             guard let request = AWSLocationBatchUpdateDevicePositionRequest() else {
                 fatalError("Could not instantiate `AWSLocationBatchUpdateDevicePositionRequest()`")
             }
             request.trackerName = trackerName
-            request.updates = positionUpdates
+            request.updates = batch.map { $0.toAWSLocationDevicePositionUpdate(deviceId: deviceId) }
         
+            batchSlots.wait()
             group.enter()
             locationService.batchUpdateDevicePosition(request) { (response, error) in
-                self.positionsUpdatedCompletionHandler(unexpiredLocations: unexpiredLocations,
+                self.responseLock.lock()
+                self.positionsUpdatedCompletionHandler(locations: batch,
                                                        request: request,
                                                        response: response,
                                                        error: error,
                                                        onComplete: {
+                                                        self.responseLock.unlock()
+                                                        batchSlots.signal()
                                                         self.group.leave()
                                                        })
             }
-            group.wait()
+        }
+        group.wait()
+        finishEmitting()
+    }
+    
+    /// Writes the locations still to be sent, including those queued meanwhile, to the journal and finishes.
+    private func finishEmitting() {
+        if let journal = journal {
+            locationsQueue.atomicallyPerform { journal.replace(with: $0) }
         }
         finish()
     }
 
     // MARK: - Response Handling
     
-    private func positionsUpdatedCompletionHandler(unexpiredLocations: [CLLocation],
+    private func positionsUpdatedCompletionHandler(locations: [CLLocation],
                                                    request: AWSLocationBatchUpdateDevicePositionRequest,
                                                    response: AWSLocationBatchUpdateDevicePositionResponse?,
                                                    error: Error?,
@@ -101,7 +130,7 @@ class EmitLocationsOperation: AsynchronousOperation {
         if let error = error as NSError? {
             AWSLocationTrackerLogger.debug("Error: \(error)")
             if let urlError = error as? URLError {
-                self.handleURLError(urlError, unexpiredLocations: unexpiredLocations)
+                self.handleURLError(urlError, locations: locations)
             } else if error.domain == AWSLocationErrorDomain,
                       let errorType = AWSLocationErrorType.init(rawValue: error.code) {
                 self.handleAWSLocationError(errorType, error: error)
@@ -111,15 +140,22 @@ class EmitLocationsOperation: AsynchronousOperation {
                                                              recoverySuggestion: "Unknown Error occured")))
             }
         } else if let response = response {
+            if let lastLocation = locations.last {
+                lastEmittedLocation?.with { lastEmittedLocation in
+                    if lastEmittedLocation == nil || lastEmittedLocation!.timestamp < lastLocation.timestamp {
+                        lastEmittedLocation = lastLocation
+                    }
+                }
+            }
             self.listener?(.onDataPublished(.init(request: request,
                                                   response: response)))
         }
         onComplete()
     }
     
-    private func handleURLError(_ urlError: URLError, unexpiredLocations: [CLLocation]) {
+    private func handleURLError(_ urlError: URLError, locations: [CLLocation]) {
         if urlError.code.rawValue == NSURLErrorNotConnectedToInternet {
-            self.locationsQueue.append(contentsOf: unexpiredLocations)
+            self.locationsQueue.append(contentsOf: locations)
         }
         
         self.listener?(.onDataPublicationError(
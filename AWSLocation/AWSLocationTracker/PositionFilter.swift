@@ -0,0 +1,124 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import CoreLocation
+
+/// Drops the locations that add little to the tracked path before they are sent.
+struct PositionFilter {
+    let minimumDistance: CLLocationDistance
+    let minimumTimeInterval: TimeInterval
+    let simplificationTolerance: CLLocationDistance
+
+    init(options: TrackerOptions) {
+        self.minimumDistance = options.minimumDistance
+        self.minimumTimeInterval = options.minimumTimeInterval
+        self.simplificationTolerance = options.simplificationTolerance
+    }
+
+    var isEnabled: Bool {
+        return minimumDistance > 0 || minimumTimeInterval > 0 || simplificationTolerance > 0
+    }
+
+    /// Returns the locations to send, in sample time order.
+    ///
+    /// - Parameters:
+    ///   - locations: The locations to filter
+    ///   - previousLocation: The last location sent, which the thresholds are measured from
+    func filter(_ locations: [CLLocation], after previousLocation: CLLocation? = nil) -> [CLLocation] {
+        guard isEnabled else {
+            return locations
+        }
+        let sortedLocations = locations.sorted { $0.timestamp < $1.timestamp }
+        let thresholded = applyThresholds(sortedLocations, after: previousLocation)
+        return PositionFilter.simplify(thresholded, tolerance: simplificationTolerance)
+    }
+
+    private func applyThresholds(_ locations: [CLLocation], after previousLocation: CLLocation?) -> [CLLocation] {
+        guard minimumDistance > 0 || minimumTimeInterval > 0 else {
+            return locations
+        }
+        var lastKept = previousLocation
+        return locations.filter { location in
+            if let lastKept = lastKept {
+                if location.distance(from: lastKept) < minimumDistance {
+                    return false
+                }
+                if location.timestamp.timeIntervalSince(lastKept.timestamp) < minimumTimeInterval {
+                    return false
+                }
+            }
+            lastKept = location
+            return true
+        }
+    }
+
+    /// Simplifies a path with the Douglas-Peucker algorithm, keeping its first and last locations and every location
+    /// further than `tolerance` meters from the simplified path.
+    static func simplify(_ locations: [CLLocation], tolerance: CLLocationDistance) -> [CLLocation] {
+        guard tolerance > 0, locations.count > 2 else {
+            return locations
+        }
+        // Projects the locations on a plane in meters around the first one, which is precise enough at the scale
+        // of the locations sent in a batch.
+        let origin = locations[0].coordinate
+        let metersPerDegreeLatitude = 111_320.0
+        let metersPerDegreeLongitude = metersPerDegreeLatitude * cos(origin.latitude * .pi / 180)
+        let points = locations.map { location -> (x: Double, y: Double) in
+            ((location.coordinate.longitude - origin.longitude) * metersPerDegreeLongitude,
+             (location.coordinate.latitude - origin.latitude) * metersPerDegreeLatitude)
+        }
+
+        var keep = [Bool](repeating: false, count: points.count)
+        keep[0] = true
+        keep[points.count - 1] = true
+        var ranges = [(first: 0, last: points.count - 1)]
+        while let range = ranges.popLast() {
+            var farthestIndex = range.first
+            var farthestDistance = 0.0
+            for index in range.first + 1 ..< range.last {
+                let distance = distanceToSegment(points[index], points[range.first], points[range.last])
+                if distance > farthestDistance {
+                    farthestIndex = index
+                    farthestDistance = distance
+                }
+            }
+            if farthestDistance > tolerance {
+                keep[farthestIndex] = true
+                if farthestIndex - range.first > 1 {
+                    ranges.append((range.first, farthestIndex))
+                }
+                if range.last - farthestIndex > 1 {
+                    ranges.append((farthestIndex, range.last))
+                }
+            }
+        }
+        return zip(locations, keep).compactMap { $1 ? $0 : nil }
+    }
+
+    static func distanceToSegment(_ point: (x: Double, y: Double),
+                                  _ start: (x: Double, y: Double),
+                                  _ end: (x: Double, y: Double)) -> Double {
+        let dx = end.x - start.x
+        let dy = end.y - start.y
+        let lengthSquared = dx * dx + dy * dy
+        var t = 0.0
+        if lengthSquared > 0 {
+            t = max(0, min(1, ((point.x - start.x) * dx + (point.y - start.y) * dy) / lengthSquared))
+        }
+        let x = start.x + t * dx - point.x
+        let y = start.y + t * dy - point.y
+        return (x * x + y * y).squareRoot()
+    }
+}
@@ -0,0 +1,147 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import CoreLocation
+
+/// Keeps the locations that have not been sent yet on disk, so that they are sent after the app is restarted.
+///
+/// Locations are appended as fixed size records: the sample time, latitude, longitude and horizontal accuracy as
+/// little-endian doubles. A record cut short by the app being killed mid-write is ignored when the journal is loaded.
+class PositionJournal {
+    private static let recordSize = 4 * MemoryLayout<Double>.size
+
+    let fileURL: URL
+    private let lock = NSLock()
+
+    init(fileURL: URL) {
+        self.fileURL = fileURL
+    }
+
+    /// Creates the journal of a tracker in the application support directory.
+    convenience init(trackerName: String) {
+        let directoryURL = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("com.amazonaws.AWSLocationTracker", isDirectory: true)
+        let fileName = trackerName.addingPercentEncoding(withAllowedCharacters: .alphanumerics) ?? trackerName
+        self.init(fileURL: directoryURL.appendingPathComponent("\(fileName).journal"))
+    }
+
+    /// Appends locations to the journal.
+    func append(_ locations: [CLLocation]) {
+        guard !locations.isEmpty else {
+            return
+        }
+        lock.lock()
+        defer {
+            lock.unlock()
+        }
+        let data = PositionJournal.encode(locations)
+        do {
+            if let fileHandle = try? FileHandle(forWritingTo: fileURL) {
+                defer {
+                    fileHandle.closeFile()
+                }
+                // Drops a record cut short by an earlier crash, which would misalign the records appended after it.
+                let length = fileHandle.seekToEndOfFile()
+                let alignedLength = length - length % UInt64(PositionJournal.recordSize)
+                if alignedLength != length {
+                    fileHandle.truncateFile(atOffset: alignedLength)
+                }
+                fileHandle.write(data)
+            } else {
+                try createDirectory()
+                try data.write(to: fileURL, options: .atomic)
+            }
+        } catch {
+            AWSLocationTrackerLogger.error("Failed to append locations to the journal: \(error)")
+        }
+    }
+
+    /// Replaces the locations in the journal.
+    func replace(with locations: [CLLocation]) {
+        lock.lock()
+        defer {
+            lock.unlock()
+        }
+        do {
+            if locations.isEmpty {
+                if FileManager.default.fileExists(atPath: fileURL.path) {
+                    try FileManager.default.removeItem(at: fileURL)
+                }
+                return
+            }
+            try createDirectory()
+            try PositionJournal.encode(locations).write(to: fileURL, options: .atomic)
+        } catch {
+            AWSLocationTrackerLogger.error("Failed to write the journal: \(error)")
+        }
+    }
+
+    /// Returns the locations in the journal.
+    func load() -> [CLLocation] {
+        lock.lock()
+        defer {
+            lock.unlock()
+        }
+        guard let data = try? Data(contentsOf: fileURL) else {
+            return []
+        }
+        return PositionJournal.decode(data)
+    }
+
+    private func createDirectory() throws {
+        try FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(),
+                                                withIntermediateDirectories: true,
+                                                attributes: nil)
+    }
+
+    // MARK: - Records
+
+    static func encode(_ locations: [CLLocation]) -> Data {
+        var data = Data(capacity: locations.count * recordSize)
+        for location in locations {
+            for value in [location.timestamp.timeIntervalSince1970,
+                          location.coordinate.latitude,
+                          location.coordinate.longitude,
+                          location.horizontalAccuracy] {
+                withUnsafeBytes(of: value.bitPattern.littleEndian) { data.append(contentsOf: $0) }
+            }
+        }
+        return data
+    }
+
+    static func decode(_ data: Data) -> [CLLocation] {
+        let recordCount = data.count / recordSize
+        var locations = [CLLocation]()
+        locations.reserveCapacity(recordCount)
+        data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) in
+            func double(at offset: Int) -> Double {
+                var bitPattern: UInt64 = 0
+                withUnsafeMutableBytes(of: &bitPattern) { $0.copyMemory(from: UnsafeRawBufferPointer(rebasing: buffer[offset ..< offset + 8])) }
+                return Double(bitPattern: UInt64(littleEndian: bitPattern))
+            }
+            for index in 0 ..< recordCount {
+                let offset = index * recordSize
+                let coordinate = CLLocationCoordinate2D(latitude: double(at: offset + 8),
+                                                        longitude: double(at: offset + 16))
+                locations.append(CLLocation(coordinate: coordinate,
+                                            altitude: 0,
+                                            horizontalAccuracy: double(at: offset + 24),
+                                            verticalAccuracy: -1,
+                                            timestamp: Date(timeIntervalSince1970: double(at: offset))))
+            }
+        }
+        return locations
+    }
+}
@@ -13,10 +13,13 @@
 // permissions and limitations under the License.
 //
 
+import CoreLocation
+
 /// Configuration options for tracking.
 public struct TrackerOptions {
     static let defaultRetrieveLocationFrequency = TimeInterval(30) // 30 seconds
     static let defaultEmitLocationFrequency = TimeInterval(300) // 5 minutes
+    static let defaultMaximumConcurrentBatches = 3
     
     /// The custom ID chosen to identify this device on the chosen tracker resource.
     public let customDeviceId: String?
@@ -27,11 +30,45 @@ public struct TrackerOptions {
     /// The frequency in seconds to publish a batch of locations to Amazon Location Service.
     public let emitLocationFrequency: TimeInterval
     
+    /// Locations closer than this distance in meters to the previously sent location are not sent. Defaults to 0,
+    /// sending every location.
+    public let minimumDistance: CLLocationDistance
+    
+    /// Locations sampled less than this many seconds after the previously sent location are not sent. Defaults to 0,
+    /// sending every location.
+    public let minimumTimeInterval: TimeInterval
+    
+    /// The tolerance in meters used to simplify the path of the locations before they are sent. Locations that are
+    /// closer than this to the simplified path are not sent. Defaults to 0, which does not simplify the path.
+    public let simplificationTolerance: CLLocationDistance
+    
+    /// The maximum number of `BatchUpdateDevicePosition` requests in flight at once. Defaults to 3.
+    public let maximumConcurrentBatches: Int
+    
     public init(customDeviceId: String? = nil,
                 retrieveLocationFrequency: TimeInterval? = nil,
-                emitLocationFrequency: TimeInterval? = nil) {
+                emitLocationFrequency: TimeInterval? = nil,
+                minimumDistance: CLLocationDistance = 0,
+                minimumTimeInterval: TimeInterval = 0,
+                simplificationTolerance: CLLocationDistance = 0,
+                maximumConcurrentBatches: Int? = nil) {
         self.customDeviceId = customDeviceId
         self.retrieveLocationFrequency = retrieveLocationFrequency ?? TrackerOptions.defaultRetrieveLocationFrequency
         self.emitLocationFrequency = emitLocationFrequency ?? TrackerOptions.defaultEmitLocationFrequency
+        self.minimumDistance = max(minimumDistance, 0)
+        self.minimumTimeInterval = max(minimumTimeInterval, 0)
+        self.simplificationTolerance = max(simplificationTolerance, 0)
+        self.maximumConcurrentBatches = max(maximumConcurrentBatches ?? TrackerOptions.defaultMaximumConcurrentBatches, 1)
+    }
+    
+    /// Returns the same options for another device.
+    func withCustomDeviceId(_ customDeviceId: String) -> TrackerOptions {
+        return TrackerOptions(customDeviceId: customDeviceId,
+                              retrieveLocationFrequency: retrieveLocationFrequency,
+                              emitLocationFrequency: emitLocationFrequency,
+                              minimumDistance: minimumDistance,
+                              minimumTimeInterval: minimumTimeInterval,
+                              simplificationTolerance: simplificationTolerance,
+                              maximumConcurrentBatches: maximumConcurrentBatches)
     }
 }
@@ -0,0 +1,325 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import XCTest
+import CoreLocation
+@testable import AWSLocation
+
+/// Records the requests sent to the service, answering each after `latency` on a background queue.
+class RecordingMockAWSLocation: AWSLocationBehavior {
+    var latency: TimeInterval = 0
+    var error: Error?
+    private let lock = NSLock()
+    private(set) var requests = [AWSLocationBatchUpdateDevicePositionRequest]()
+    private(set) var maximumRequestsInFlight = 0
+    private var requestsInFlight = 0
+
+    var positionCount: Int {
+        return requests.reduce(0) { $0 + ($1.updates?.count ?? 0) }
+    }
+
+    func batchUpdateDevicePosition(_ request: AWSLocationBatchUpdateDevicePositionRequest,
+                                   completionHandler: BatchUpdateDevicePositionCompletionHandler?) {
+        lock.lock()
+        requests.append(request)
+        requestsInFlight += 1
+        maximumRequestsInFlight = max(maximumRequestsInFlight, requestsInFlight)
+        lock.unlock()
+
+        DispatchQueue.global().asyncAfter(deadline: .now() + latency) {
+            self.lock.lock()
+            self.requestsInFlight -= 1
+            self.lock.unlock()
+            completionHandler?((self.error == nil ? AWSLocationBatchUpdateDevicePositionResponse() : nil, self.error))
+        }
+    }
+}
+
+class PositionQueueTests: XCTestCase {
+
+    let trackerName = "trackerName"
+    let deviceId = "deviceId"
+    var journalURL: URL!
+
+    override func setUp() {
+        super.setUp()
+        journalURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString, isDirectory: true)
+            .appendingPathComponent("tracker.journal")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: journalURL.deletingLastPathComponent())
+        super.tearDown()
+    }
+
+    // MARK: - Journal
+
+    func testJournalSurvivesRestarts() throws {
+        let locations = ReplayTrajectory.commute(duration: 10)
+        PositionJournal(fileURL: journalURL).append(Array(locations[0 ..< 4]))
+        PositionJournal(fileURL: journalURL).append(Array(locations[4...]))
+
+        let loaded = PositionJournal(fileURL: journalURL).load()
+        XCTAssertEqual(loaded.count, locations.count)
+        for (location, loadedLocation) in zip(locations, loaded) {
+            XCTAssertEqual(location.coordinate.latitude, loadedLocation.coordinate.latitude)
+            XCTAssertEqual(location.coordinate.longitude, loadedLocation.coordinate.longitude)
+            XCTAssertEqual(location.timestamp, loadedLocation.timestamp)
+        }
+
+        PositionJournal(fileURL: journalURL).replace(with: [])
+        XCTAssertTrue(PositionJournal(fileURL: journalURL).load().isEmpty)
+    }
+
+    func testJournalIgnoresRecordCutShort() throws {
+        let locations = ReplayTrajectory.commute(duration: 3)
+        let journal = PositionJournal(fileURL: journalURL)
+        journal.append(Array(locations[0 ..< 2]))
+
+        // The app was killed while appending.
+        let fileHandle = try FileHandle(forWritingTo: journalURL)
+        fileHandle.seekToEndOfFile()
+        fileHandle.write(Data(repeating: 0xFF, count: 5))
+        fileHandle.closeFile()
+        XCTAssertEqual(journal.load().count, 2)
+
+        journal.append([locations[2]])
+        let loaded = journal.load()
+        XCTAssertEqual(loaded.count, 3)
+        XCTAssertEqual(loaded[2].timestamp, locations[2].timestamp)
+    }
+
+    func testJournalKeepsLocationsUntilTheyAreSent() {
+        let journal = PositionJournal(fileURL: journalURL)
+        let locations = ReplayTrajectory.commute(duration: 25)
+        let locationsQueue = AtomicValue<[CLLocation]>(initialValue: locations)
+        journal.append(locations)
+
+        let locationService = RecordingMockAWSLocation()
+        locationService.error = URLError(.notConnectedToInternet)
+        emit(locationsQueue: locationsQueue, locationService: locationService, journal: journal)
+        XCTAssertEqual(journal.load().count, 25)
+        XCTAssertEqual(locationsQueue.get().count, 25)
+
+        locationService.error = nil
+        emit(locationsQueue: locationsQueue, locationService: locationService, journal: journal)
+        XCTAssertTrue(journal.load().isEmpty)
+        XCTAssertEqual(locationService.positionCount, 50)
+    }
+
+    func testTrackerRestoresJournaledLocations() {
+        let journal = PositionJournal(fileURL: journalURL)
+        let locationTracker = AWSLocationTracker(trackerName: trackerName,
+                                                 locationService: RecordingMockAWSLocation(),
+                                                 journal: journal)
+        _ = locationTracker.startTracking(delegate: MockAWSLocationTrackerDelegate())
+        locationTracker.interceptLocationsRetrieved(ReplayTrajectory.commute(duration: 3))
+        XCTAssertEqual(journal.load().count, 3)
+
+        // The app is killed and launched again.
+        let restartedTracker = AWSLocationTracker(trackerName: trackerName,
+                                                  locationService: RecordingMockAWSLocation(),
+                                                  journal: PositionJournal(fileURL: journalURL))
+        _ = restartedTracker.startTracking(delegate: MockAWSLocationTrackerDelegate())
+        XCTAssertEqual(restartedTracker.locationsQueue.get().count, 3)
+
+        restartedTracker.stopTracking()
+        XCTAssertTrue(journal.load().isEmpty)
+    }
+
+    // MARK: - Filtering
+
+    func testThresholds() {
+        let start = Date()
+        let locations = (0 ..< 10).map { index in
+            CLLocation(coordinate: CLLocationCoordinate2D(latitude: 47.6 + Double(index) * 0.00005, longitude: -122.3),
+                       altitude: 0,
+                       horizontalAccuracy: 5,
+                       verticalAccuracy: -1,
+                       timestamp: start.addingTimeInterval(TimeInterval(index)))
+        }
+        // The locations are about 5.6 meters and 1 second apart.
+        XCTAssertEqual(PositionFilter(options: TrackerOptions()).filter(locations).count, 10)
+        XCTAssertEqual(PositionFilter(options: TrackerOptions(minimumDistance: 10)).filter(locations).count, 5)
+        XCTAssertEqual(PositionFilter(options: TrackerOptions(minimumTimeInterval: 3)).filter(locations).count, 4)
+        XCTAssertEqual(PositionFilter(options: TrackerOptions(minimumDistance: 10))
+                        .filter(Array(locations[1...]), after: locations[0]).count, 4)
+    }
+
+    func testSimplificationKeepsCorners() {
+        let start = Date()
+        let coordinates = [(0.0, 0.0), (0.0, 0.001), (0.0, 0.002), (0.001, 0.002), (0.002, 0.002), (0.002, 0.0021)]
+        let locations = coordinates.enumerated().map { index, coordinate in
+            CLLocation(coordinate: CLLocationCoordinate2D(latitude: 47.6 + coordinate.0, longitude: -122.3 + coordinate.1),
+                       altitude: 0,
+                       horizontalAccuracy: 5,
+                       verticalAccuracy: -1,
+                       timestamp: start.addingTimeInterval(TimeInterval(index)))
+        }
+        let simplified = PositionFilter.simplify(locations, tolerance: 10)
+        XCTAssertEqual(simplified.map { $0.timestamp }, [locations[0], locations[2], locations[5]].map { $0.timestamp })
+        XCTAssertEqual(PositionFilter.simplify(locations, tolerance: 0).count, locations.count)
+    }
+
+    // MARK: - Concurrent batches
+
+    func testBatchesAreSentConcurrently() {
+        let locationsQueue = AtomicValue<[CLLocation]>(initialValue: ReplayTrajectory.commute(duration: 50))
+        let locationService = RecordingMockAWSLocation()
+        locationService.latency = 0.05
+        let published = expectation(description: "Data was published")
+        published.expectedFulfillmentCount = 5
+        emit(locationsQueue: locationsQueue, locationService: locationService, maximumConcurrentBatches: 2) { event in
+            if case .onDataPublished = event {
+                published.fulfill()
+            }
+        }
+        wait(for: [published], timeout: 1)
+        XCTAssertEqual(locationService.requests.count, 5)
+        XCTAssertEqual(locationService.maximumRequestsInFlight, 2)
+    }
+
+    // MARK: - Replay
+
+    /// Replays a recorded commute, emitting every 5 minutes as the tracker does by default, and reports the requests
+    /// and positions sent with and without filtering.
+    func testReplayCommute() {
+        let trajectory = ReplayTrajectory.commute(duration: 40 * 60)
+
+        let unfiltered = replay(trajectory, options: TrackerOptions())
+        XCTAssertEqual(unfiltered.positionCount, trajectory.count)
+
+        let options = TrackerOptions(minimumDistance: 10, simplificationTolerance: 15)
+        let filtered = replay(trajectory, options: options)
+        let sentLocations = filtered.requests.flatMap { $0.updates ?? [] }.map { update in
+            CLLocation(latitude: update.position![1].doubleValue, longitude: update.position![0].doubleValue)
+        }
+        print("Replayed \(trajectory.count) locations: \(unfiltered.requests.count) requests unfiltered, "
+              + "\(filtered.requests.count) requests and \(filtered.positionCount) positions filtered")
+
+        XCTAssertLessThan(filtered.requests.count * 10, unfiltered.requests.count)
+        // The sent path stays close to the recorded one.
+        let maximumDeviation = trajectory.map { ReplayTrajectory.distance(from: $0, toPath: sentLocations) }.max() ?? 0
+        XCTAssertLessThan(maximumDeviation, options.minimumDistance + options.simplificationTolerance + 5)
+    }
+
+    func testReplayCommutePerformance() {
+        let trajectory = ReplayTrajectory.commute(duration: 40 * 60)
+        measure {
+            _ = replay(trajectory, options: TrackerOptions(minimumDistance: 10, simplificationTolerance: 15))
+        }
+    }
+
+    // MARK: - Helpers
+
+    func emit(locationsQueue: AtomicValue<[CLLocation]>,
+              locationService: AWSLocationBehavior,
+              journal: PositionJournal? = nil,
+              filter: PositionFilter? = nil,
+              lastEmittedLocation: AtomicValue<CLLocation?>? = nil,
+              maximumConcurrentBatches: Int = 3,
+              listener: ((TrackingListener) -> Void)? = nil) {
+        let operation = EmitLocationsOperation(trackerName: trackerName,
+                                               deviceId: deviceId,
+                                               locationsQueue: locationsQueue,
+                                               locationService: locationService,
+                                               journal: journal,
+                                               filter: filter,
+                                               lastEmittedLocation: lastEmittedLocation,
+                                               maximumConcurrentBatches: maximumConcurrentBatches,
+                                               listener: listener)
+        operation.start()
+    }
+
+    func replay(_ trajectory: [CLLocation], options: TrackerOptions) -> RecordingMockAWSLocation {
+        let locationService = RecordingMockAWSLocation()
+        let locationsQueue = AtomicValue<[CLLocation]>(initialValue: [])
+        let lastEmittedLocation = AtomicValue<CLLocation?>(initialValue: nil)
+        let locationsPerEmit = Int(TrackerOptions.defaultEmitLocationFrequency)
+        for start in stride(from: 0, to: trajectory.count, by: locationsPerEmit) {
+            locationsQueue.append(contentsOf: trajectory[start ..< min(start + locationsPerEmit, trajectory.count)])
+            emit(locationsQueue: locationsQueue,
+                 locationService: locationService,
+                 filter: PositionFilter(options: options),
+                 lastEmittedLocation: lastEmittedLocation,
+                 maximumConcurrentBatches: options.maximumConcurrentBatches)
+        }
+        return locationService
+    }
+}
+
+/// Recorded trajectories to replay through the tracker.
+enum ReplayTrajectory {
+    /// A commute sampled every second over `duration` seconds, ending now: parked for the first quarter, driving
+    /// through a grid of streets at 12 m/s for half of the time, then parked again. Parked locations have a few
+    /// meters of GPS noise.
+    static func commute(duration: Int) -> [CLLocation] {
+        var random = UInt64(42)
+        func noise() -> Double {
+            // A linear congruential generator, so that replays are reproducible.
+            random = random &* 6364136223846793005 &+ 1442695040888963407
+            return Double(random >> 33) / Double(1 << 31) - 0.5
+        }
+        let metersPerDegreeLatitude = 111_320.0
+        let origin = CLLocationCoordinate2D(latitude: 47.6, longitude: -122.3)
+        let metersPerDegreeLongitude = metersPerDegreeLatitude * cos(origin.latitude * .pi / 180)
+        let start = Date().addingTimeInterval(-TimeInterval(duration))
+
+        var x = 0.0
+        var y = 0.0
+        var heading = 0
+        return (0 ..< duration).map { second in
+            let driving = second >= duration / 4 && second < duration * 3 / 4
+            if driving {
+                // Turns at every block of 600 meters.
+                if second % 50 == 0 {
+                    heading = (heading + (second % 100 == 0 ? 1 : 3)) % 4
+                }
+                x += [12.0, 0, -12, 0][heading]
+                y += [0.0, 12, 0, -12][heading]
+            }
+            let noiseX = driving ? noise() : noise() * 6
+            let noiseY = driving ? noise() : noise() * 6
+            let coordinate = CLLocationCoordinate2D(latitude: origin.latitude + (y + noiseY) / metersPerDegreeLatitude,
+                                                    longitude: origin.longitude + (x + noiseX) / metersPerDegreeLongitude)
+            return CLLocation(coordinate: coordinate,
+                              altitude: 0,
+                              horizontalAccuracy: 5,
+                              verticalAccuracy: -1,
+                              timestamp: start.addingTimeInterval(TimeInterval(second)))
+        }
+    }
+
+    /// The distance in meters from a location to the nearest segment of a path.
+    static func distance(from location: CLLocation, toPath path: [CLLocation]) -> CLLocationDistance {
+        guard let first = path.first else {
+            return .infinity
+        }
+        let metersPerDegreeLatitude = 111_320.0
+        let metersPerDegreeLongitude = metersPerDegreeLatitude * cos(first.coordinate.latitude * .pi / 180)
+        func project(_ location: CLLocation) -> (x: Double, y: Double) {
+            return ((location.coordinate.longitude - first.coordinate.longitude) * metersPerDegreeLongitude,
+                    (location.coordinate.latitude - first.coordinate.latitude) * metersPerDegreeLatitude)
+        }
+        let point = project(location)
+        if path.count == 1 {
+            return PositionFilter.distanceToSegment(point, project(first), project(first))
+        }
+        return zip(path, path.dropFirst()).map {
+            PositionFilter.distanceToSegment(point, project($0), project($1))
+        }.min() ?? .infinity
+    }
+}
@@ -120,6 +120,23 @@ typedef void(^AWSInitializationCompletionBlock)(AWSPinpoint * _Nonnull pinpoint)
  */
 @property (nonatomic, assign) int sessionTimeout;
 
+/**
+ Whether endpoint profile updates are skipped when they would send the same profile the service last acknowledged.
+ An unchanged profile is still sent once a day.
+ Defaults to YES.
+ 
+ @returns whether unchanged endpoint profile updates are skipped.
+ */
+@property (nonatomic, assign) BOOL skipUnchangedEndpointProfileUpdates;
+
+/**
+ The time in seconds `updateEndpointProfile` waits before sending an update, so that the calls made in the meantime are coalesced into one update of the latest profile.
+ Defaults to 0, which sends each update immediately.
+ 
+ @returns the endpoint profile update debounce interval.
+ */
+@property (nonatomic, assign) NSTimeInterval endpointProfileUpdateDebounceInterval;
+
 /**
  The Pinpoint AppId
  Defaults to the specified `appId` in the `Info.plist`.
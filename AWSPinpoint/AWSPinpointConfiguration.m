@@ -160,6 +160,8 @@ static NSString* const UNKNOWN = @"Unknown";
         _targetingServiceConfiguration = targetingServiceConfiguration;
         _maxStorageSize = maxStorageSize;
         _sessionTimeout = sessionTimeout;
+        _skipUnchangedEndpointProfileUpdates = YES;
+        _endpointProfileUpdateDebounceInterval = 0;
     }
     return self;
 }
@@ -33,12 +33,15 @@ NS_ASSUME_NONNULL_BEGIN
 - (void) currentEndpointProfileWithCompletion:(void (^_Nonnull)(AWSPinpointEndpointProfile *profile))completion;
 
 /**
- * Sends an update of the current endpoint
+ * Sends an update of the current endpoint.
+ * The update is skipped, and the task completes with a nil result, when the profile is the same as the one the service last acknowledged and `skipUnchangedEndpointProfileUpdates` is enabled.
+ * When `endpointProfileUpdateDebounceInterval` is set, the calls made within the interval share one update of the latest profile and complete with its result.
  */
 - (AWSTask *)updateEndpointProfile;
 
 /**
  * Updates with the provided endpoint profile, AWSPinpointTargetingClient attributes and metrics are added to the profile.
+ * The update is skipped, and the task completes with a nil result, when the profile is the same as the one the service last acknowledged and `skipUnchangedEndpointProfileUpdates` is enabled.
  */
 - (AWSTask *)updateEndpointProfile:(AWSPinpointEndpointProfile*) endpointProfile;
 
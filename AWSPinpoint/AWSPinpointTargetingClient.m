@@ -14,6 +14,7 @@
  */
 
 #import <AWSCore/AWSNSCodingUtilities.h>
+#import <CommonCrypto/CommonDigest.h>
 #import "AWSPinpointTargetingClient.h"
 #import "AWSPinpointEndpointProfile.h"
 #import "AWSPinpointDateUtils.h"
@@ -26,9 +27,15 @@
 NSString *const AWSPinpointEndpointAttributesKey = @"AWSPinpointEndpointAttributesKey";
 NSString *const AWSPinpointEndpointMetricsKey = @"AWSPinpointEndpointMetricsKey";
 NSString *const AWSPinpointEndpointProfileKey = @"AWSPinpointEndpointProfileKey";
+NSString *const AWSPinpointEndpointProfileUpdateFingerprintKey = @"AWSPinpointEndpointProfileUpdateFingerprintKey";
 NSString *const AWSPinpointTargetingClientErrorDomain = @"com.amazonaws.AWSPinpointAnalyticsClientErrorDomain";
 NSString *const APNS_CHANNEL_TYPE = @"APNS";
 
+static NSString *const AWSPinpointUpdateFingerprintKey = @"fingerprint";
+static NSString *const AWSPinpointUpdateAcknowledgedDateKey = @"acknowledgedDate";
+// An unchanged profile is still sent this often, so the service keeps hearing from the endpoint.
+static NSTimeInterval const AWSPinpointUnchangedEndpointProfileUpdateInterval = 24 * 60 * 60;
+
 @interface AWSPinpointTargetingClient()
 
 @property (nonatomic, weak) AWSPinpointContext *context;
@@ -38,6 +45,9 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
 @property (nonatomic) NSMutableDictionary* globalMetrics;
 @property (nonatomic) AWSPinpointEndpointProfile *endpointProfile;
 @property (nonatomic, strong) AWSUICKeyChainStore *keychain;
+@property (nonatomic, strong) NSData *acknowledgedUpdateFingerprint;
+@property (nonatomic, strong) NSDate *acknowledgedUpdateDate;
+@property (nonatomic, strong) AWSTaskCompletionSource *pendingUpdateCompletionSource;
 @end
 
 @interface AWSPinpointConfiguration()
@@ -67,6 +77,7 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
         [self migrateLegacyKeyValueStore];
         [self initGlobalAttributes];
         [self initGlobalMetrics];
+        [self initAcknowledgedUpdate];
     }
     
     return self;
@@ -117,6 +128,27 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
     }
 }
 
+- (void) initAcknowledgedUpdate {
+    NSData *acknowledgedUpdateData = [_keychain dataForKey:AWSPinpointEndpointProfileUpdateFingerprintKey];
+    if (acknowledgedUpdateData == nil) {
+        return;
+    }
+
+    NSSet *allowableClasses = [[NSSet alloc] initWithObjects:[NSDictionary class],
+                               [NSString class],
+                               [NSData class],
+                               [NSDate class],
+                               nil];
+    NSError *decodingError;
+    NSDictionary *acknowledgedUpdate = [AWSNSCodingUtilities versionSafeUnarchivedObjectOfClasses:allowableClasses fromData:acknowledgedUpdateData error:&decodingError];
+    if (decodingError || ![acknowledgedUpdate isKindOfClass:[NSDictionary class]]) {
+        AWSDDLogError(@"Error decoding the last acknowledged endpoint profile update: %@", decodingError);
+        return;
+    }
+    _acknowledgedUpdateFingerprint = acknowledgedUpdate[AWSPinpointUpdateFingerprintKey];
+    _acknowledgedUpdateDate = acknowledgedUpdate[AWSPinpointUpdateAcknowledgedDateKey];
+}
+
 - (AWSPinpointEndpointProfile *) currentEndpointProfile {
     BOOL isRegisteredForRemoteNotifications = [AWSPinpointNotificationManager isNotificationEnabled];
     return [self localEndpointProfileWithIsRegisteredForRemoteNotifications:isRegisteredForRemoteNotifications];
@@ -262,6 +294,41 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
 }
 
 - (AWSTask *)updateEndpointProfile {
+    NSTimeInterval debounceInterval = self.context.configuration.endpointProfileUpdateDebounceInterval;
+    if (debounceInterval <= 0) {
+        return [self updateCurrentEndpointProfile];
+    }
+
+    @synchronized(self) {
+        if (!self.pendingUpdateCompletionSource) {
+            // The window starts at the first call, so a steady stream of calls still sends an update every interval.
+            self.pendingUpdateCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(debounceInterval * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                [self sendPendingUpdate];
+            });
+        }
+        return self.pendingUpdateCompletionSource.task;
+    }
+}
+
+- (void)sendPendingUpdate {
+    AWSTaskCompletionSource *completionSource = nil;
+    @synchronized(self) {
+        completionSource = self.pendingUpdateCompletionSource;
+        self.pendingUpdateCompletionSource = nil;
+    }
+
+    [[self updateCurrentEndpointProfile] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        if (task.error) {
+            [completionSource setError:task.error];
+        } else {
+            [completionSource setResult:task.result];
+        }
+        return nil;
+    }];
+}
+
+- (AWSTask *)updateCurrentEndpointProfile {
     AWSTaskCompletionSource *tcs = [AWSTaskCompletionSource taskCompletionSource];
     AWSTask *returnTask = [tcs.task continueWithSuccessBlock:^id _Nullable(AWSTask * _Nonnull t) {
         return [self executeUpdate:t.result];
@@ -287,17 +354,80 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
         [_keychain setData:endpointProfileData forKey:AWSPinpointEndpointProfileKey];
     }
 
-    return [[self.context.targetingService updateEndpoint:[self updateEndpointRequestForEndpoint:self.endpointProfile]] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+    AWSPinpointTargetingUpdateEndpointRequest *updateEndpointRequest = [self updateEndpointRequestForEndpoint:self.endpointProfile];
+    NSData *fingerprint = [self fingerprintForUpdateEndpointRequest:updateEndpointRequest];
+    if ([self isAcknowledgedUpdateFingerprint:fingerprint]) {
+        AWSDDLogVerbose(@"Endpoint profile is unchanged since the last update. Skipping the update.");
+        return [AWSTask taskWithResult:nil];
+    }
+
+    return [[self.context.targetingService updateEndpoint:updateEndpointRequest] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
         if (task.error) {
             AWSDDLogError(@"Unable to successfully update endpoint. Error Message:%@", task.error);
             return task;
         } else {
             AWSDDLogVerbose(@"Endpoint Updated Successfully! %@", task.result);
+            [self recordAcknowledgedUpdateWithFingerprint:fingerprint];
             return task;
         }
     }];
 }
 
+// A digest of everything the update sends except the effective date, which changes every time.
+- (NSData *)fingerprintForUpdateEndpointRequest:(AWSPinpointTargetingUpdateEndpointRequest *) updateEndpointRequest {
+    AWSPinpointTargetingUpdateEndpointRequest *request = [updateEndpointRequest copy];
+    request.endpointRequest = [updateEndpointRequest.endpointRequest copy];
+    request.endpointRequest.effectiveDate = nil;
+
+    NSDictionary *JSONDictionary = [AWSMTLJSONAdapter JSONDictionaryFromModel:request];
+    if (![NSJSONSerialization isValidJSONObject:JSONDictionary]) {
+        return nil;
+    }
+    NSError *error;
+    NSData *JSONData = [NSJSONSerialization dataWithJSONObject:JSONDictionary
+                                                       options:NSJSONWritingSortedKeys
+                                                         error:&error];
+    if (error) {
+        AWSDDLogError(@"Error serializing the endpoint profile update: %@", error);
+        return nil;
+    }
+
+    NSMutableData *fingerprint = [NSMutableData dataWithLength:CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(JSONData.bytes, (CC_LONG)JSONData.length, fingerprint.mutableBytes);
+    return fingerprint;
+}
+
+- (BOOL)isAcknowledgedUpdateFingerprint:(NSData *) fingerprint {
+    if (!self.context.configuration.skipUnchangedEndpointProfileUpdates || fingerprint == nil) {
+        return NO;
+    }
+    @synchronized(self) {
+        return [fingerprint isEqualToData:self.acknowledgedUpdateFingerprint]
+            && [[NSDate date] timeIntervalSinceDate:self.acknowledgedUpdateDate] < AWSPinpointUnchangedEndpointProfileUpdateInterval;
+    }
+}
+
+- (void)recordAcknowledgedUpdateWithFingerprint:(NSData *) fingerprint {
+    if (fingerprint == nil) {
+        return;
+    }
+    @synchronized(self) {
+        _acknowledgedUpdateFingerprint = fingerprint;
+        _acknowledgedUpdateDate = [NSDate date];
+
+        NSError *codingError;
+        NSData *acknowledgedUpdateData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:@{AWSPinpointUpdateFingerprintKey: _acknowledgedUpdateFingerprint,
+                                                                                                      AWSPinpointUpdateAcknowledgedDateKey: _acknowledgedUpdateDate}
+                                                                              requiringSecureCoding:YES
+                                                                                              error:&codingError];
+        if (codingError) {
+            AWSDDLogError(@"Error archiving the acknowledged endpoint profile update: %@", codingError);
+        } else {
+            [_keychain setData:acknowledgedUpdateData forKey:AWSPinpointEndpointProfileUpdateFingerprintKey];
+        }
+    }
+}
+
 - (void) verifyMinimumLengthForKey:(NSString*) key {
     if (key.length < 1) {
         @throw [NSException exceptionWithName:AWSPinpointTargetingClientErrorDomain
@@ -0,0 +1,194 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSPinpoint.h"
+#import "AWSPinpointContext.h"
+
+static NSString *const UserDefaultSuiteNameAWSPinpointTargetingClientUpdateTests = @"AWSPinpointTargetingClientUpdateTests";
+
+@interface AWSPinpointTargetingClient()
+@property (nonatomic, weak) AWSPinpointContext *context;
+@end
+
+@interface AWSPinpointConfiguration()
+@property (nonatomic, strong) NSUserDefaults *userDefaults;
+@end
+
+@interface AWSPinpointTargetingClientUpdateTests : XCTestCase
+
+@property (nonatomic, strong) AWSPinpoint *pinpoint;
+@property (nonatomic, strong) NSMutableArray<AWSPinpointTargetingUpdateEndpointRequest *> *sentRequests;
+@property (nonatomic, strong) NSError *nextError;
+
+@end
+
+@implementation AWSPinpointTargetingClientUpdateTests
+
+- (void)setUp {
+    [super setUp];
+    AWSCognitoCredentialsProvider *credentialsProvider = [[AWSCognitoCredentialsProvider alloc] initWithRegionType:AWSRegionUSEast1
+                                                                                                    identityPoolId:@"fakeIdentityPoolId"
+                                                                                                     unauthRoleArn:@"fakeUnauthRoleArn"
+                                                                                                       authRoleArn:@"fakeAuthRoleArn"
+                                                                                           identityProviderManager:nil];
+    AWSServiceConfiguration *awsConfiguration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                            credentialsProvider:credentialsProvider];
+    [AWSServiceManager defaultServiceManager].defaultServiceConfiguration = awsConfiguration;
+
+    [[NSUserDefaults standardUserDefaults] removeSuiteNamed:UserDefaultSuiteNameAWSPinpointTargetingClientUpdateTests];
+    [[AWSUICKeyChainStore keyChainStoreWithService:AWSPinpointContextKeychainService] removeAllItems];
+
+    self.sentRequests = [NSMutableArray new];
+    self.nextError = nil;
+}
+
+- (AWSPinpointTargetingClient *)targetingClientWithConfiguration:(void (^)(AWSPinpointConfiguration *configuration))configure {
+    // A new app id gives each test its own client.
+    AWSPinpointConfiguration *configuration = [[AWSPinpointConfiguration alloc] initWithAppId:[[NSUUID UUID] UUIDString] launchOptions:@{}];
+    configuration.userDefaults = [[NSUserDefaults alloc] initWithSuiteName:UserDefaultSuiteNameAWSPinpointTargetingClientUpdateTests];
+    configuration.enableAutoSessionRecording = NO;
+    if (configure) {
+        configure(configuration);
+    }
+    self.pinpoint = [AWSPinpoint pinpointWithConfiguration:configuration];
+
+    id mockTargetingService = OCMClassMock([AWSPinpointTargeting class]);
+    __weak typeof(self) weakSelf = self;
+    OCMStub([mockTargetingService updateEndpoint:[OCMArg any]]).andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained AWSPinpointTargetingUpdateEndpointRequest *request = nil;
+        [invocation getArgument:&request atIndex:2];
+        AWSTask *task = nil;
+        @synchronized (weakSelf) {
+            [weakSelf.sentRequests addObject:request];
+            if (weakSelf.nextError) {
+                task = [AWSTask taskWithError:weakSelf.nextError];
+                weakSelf.nextError = nil;
+            } else {
+                task = [AWSTask taskWithResult:[AWSPinpointTargetingUpdateEndpointResponse new]];
+            }
+        }
+        [invocation setReturnValue:&task];
+        [invocation retainArguments];
+    });
+    self.pinpoint.targetingClient.context.targetingService = mockTargetingService;
+
+    return self.pinpoint.targetingClient;
+}
+
+- (AWSTask *)waitForTask:(AWSTask *)task {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"update"];
+    [task continueWithBlock:^id _Nullable(AWSTask * _Nonnull t) {
+        [expectation fulfill];
+        return nil;
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    return task;
+}
+
+- (NSUInteger)sentRequestCount {
+    @synchronized (self) {
+        return self.sentRequests.count;
+    }
+}
+
+- (void)testUnchangedProfileIsSentOnce {
+    AWSPinpointTargetingClient *targetingClient = [self targetingClientWithConfiguration:nil];
+
+    AWSTask *first = [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertNil(first.error);
+    XCTAssertNotNil(first.result);
+    XCTAssertEqual([self sentRequestCount], 1);
+
+    AWSTask *second = [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertNil(second.error);
+    XCTAssertNil(second.result);
+    XCTAssertEqual([self sentRequestCount], 1);
+}
+
+- (void)testChangedProfileIsSent {
+    AWSPinpointTargetingClient *targetingClient = [self targetingClientWithConfiguration:nil];
+    [self waitForTask:[targetingClient updateEndpointProfile]];
+
+    [targetingClient addAttribute:@[@"blue"] forKey:@"color"];
+    [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertEqual([self sentRequestCount], 2);
+    XCTAssertEqualObjects(self.sentRequests.lastObject.endpointRequest.attributes[@"color"], @[@"blue"]);
+
+    [targetingClient addMetric:@(3) forKey:@"level"];
+    [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertEqual([self sentRequestCount], 3);
+
+    // Going back to a profile sent earlier is still a change from the last one the service acknowledged.
+    [targetingClient removeMetricForKey:@"level"];
+    [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertEqual([self sentRequestCount], 4);
+
+    [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertEqual([self sentRequestCount], 4);
+}
+
+- (void)testFailedUpdateIsSentAgain {
+    AWSPinpointTargetingClient *targetingClient = [self targetingClientWithConfiguration:nil];
+    self.nextError = [NSError errorWithDomain:AWSPinpointTargetingErrorDomain code:AWSPinpointTargetingErrorUnknown userInfo:nil];
+
+    AWSTask *failed = [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertNotNil(failed.error);
+    XCTAssertEqual([self sentRequestCount], 1);
+
+    AWSTask *retried = [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertNil(retried.error);
+    XCTAssertNotNil(retried.result);
+    XCTAssertEqual([self sentRequestCount], 2);
+}
+
+- (void)testUnchangedProfileIsSentWhenSkippingIsDisabled {
+    AWSPinpointTargetingClient *targetingClient = [self targetingClientWithConfiguration:^(AWSPinpointConfiguration *configuration) {
+        configuration.skipUnchangedEndpointProfileUpdates = NO;
+    }];
+
+    [self waitForTask:[targetingClient updateEndpointProfile]];
+    [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertEqual([self sentRequestCount], 2);
+}
+
+- (void)testRapidUpdatesAreDebounced {
+    AWSPinpointTargetingClient *targetingClient = [self targetingClientWithConfiguration:^(AWSPinpointConfiguration *configuration) {
+        configuration.endpointProfileUpdateDebounceInterval = 0.2;
+    }];
+
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 10; i++) {
+        [targetingClient addAttribute:@[[NSString stringWithFormat:@"%lu", (unsigned long)i]] forKey:@"step"];
+        [tasks addObject:[targetingClient updateEndpointProfile]];
+    }
+    XCTAssertEqual([self sentRequestCount], 0);
+
+    AWSTask *all = [self waitForTask:[AWSTask taskForCompletionOfAllTasks:tasks]];
+    XCTAssertNil(all.error);
+    XCTAssertEqual([self sentRequestCount], 1);
+    XCTAssertEqualObjects(self.sentRequests.lastObject.endpointRequest.attributes[@"step"], @[@"9"]);
+    for (AWSTask *task in tasks) {
+        XCTAssertNotNil(task.result);
+    }
+
+    // A later call starts a new window.
+    [targetingClient addAttribute:@[@"10"] forKey:@"step"];
+    [self waitForTask:[targetingClient updateEndpointProfile]];
+    XCTAssertEqual([self sentRequestCount], 2);
+}
+
+@end
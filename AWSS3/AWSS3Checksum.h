@@ -0,0 +1,100 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSS3Model.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Updates a CRC32C (Castagnoli) checksum with `length` bytes. Pass 0 as `crc` to start a new checksum. Uses the CRC32C
+ instructions of the CPU when it has them.
+ */
+FOUNDATION_EXPORT uint32_t AWSS3CRC32C(uint32_t crc, const void *bytes, size_t length);
+
+/**
+ The table driven implementation of `AWSS3CRC32C`, used when the CPU has no CRC32C instructions.
+ */
+FOUNDATION_EXPORT uint32_t AWSS3CRC32CPortable(uint32_t crc, const void *bytes, size_t length);
+
+/**
+ Computes the checksums S3 accepts in the `x-amz-checksum-*` headers incrementally, as the data is read.
+ */
+@interface AWSS3Checksum : NSObject
+
+/**
+ The algorithm of the checksum.
+ */
+@property (nonatomic, assign, readonly) AWSS3ChecksumAlgorithm algorithm;
+
+/**
+ Whether `AWSS3CRC32C` uses the CRC32C instructions of the CPU.
+ */
+@property (class, nonatomic, assign, readonly, getter=isHardwareAccelerated) BOOL hardwareAccelerated;
+
+/**
+ Returns `YES` for the algorithms this class computes, `AWSS3ChecksumAlgorithmCRC32C` and `AWSS3ChecksumAlgorithmSHA256`.
+ */
++ (BOOL)isSupportedAlgorithm:(AWSS3ChecksumAlgorithm)algorithm;
+
+/**
+ Returns a new checksum, or `nil` if the algorithm is not supported.
+ */
+- (nullable instancetype)initWithAlgorithm:(AWSS3ChecksumAlgorithm)algorithm;
+
+- (void)updateWithBytes:(const void *)bytes length:(NSUInteger)length;
+
+- (void)updateWithData:(NSData *)data;
+
+/**
+ Finishes the checksum and returns its bytes. The checksum cannot be updated afterwards.
+ */
+- (NSData *)digest;
+
+/**
+ Finishes the checksum and returns it base64 encoded, as it is sent to S3.
+ */
+- (NSString *)base64Digest;
+
+/**
+ Computes the base64 encoded checksum of a file, reading it in chunks.
+ */
++ (nullable NSString *)base64ChecksumOfFileAtURL:(NSURL *)fileURL
+                                       algorithm:(AWSS3ChecksumAlgorithm)algorithm
+                                           error:(NSError **)error;
+
+/**
+ Computes the checksum S3 reports for an object uploaded in parts: the checksum of the concatenated checksums of
+ the parts, base64 encoded and followed by `-` and the number of parts. The part checksums are base64 encoded and in
+ part number order.
+ */
++ (nullable NSString *)compositeChecksumOfPartChecksums:(NSArray<NSString *> *)partChecksums
+                                              algorithm:(AWSS3ChecksumAlgorithm)algorithm;
+
+/**
+ The name of the algorithm in the `x-amz-checksum-algorithm` header, e.g. `CRC32C`.
+ */
++ (nullable NSString *)nameForAlgorithm:(AWSS3ChecksumAlgorithm)algorithm;
+
++ (AWSS3ChecksumAlgorithm)algorithmForName:(nullable NSString *)name;
+
+/**
+ The header carrying a checksum of the algorithm, e.g. `x-amz-checksum-crc32c`.
+ */
++ (nullable NSString *)headerNameForAlgorithm:(AWSS3ChecksumAlgorithm)algorithm;
+
+@end
+
+NS_ASSUME_NONNULL_END
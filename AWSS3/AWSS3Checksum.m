@@ -0,0 +1,332 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSS3Checksum.h"
+#import <CommonCrypto/CommonDigest.h>
+#import <sys/sysctl.h>
+
+#if defined(__aarch64__)
+#import <arm_acle.h>
+#elif defined(__x86_64__)
+#import <nmmintrin.h>
+#endif
+
+static const NSUInteger AWSS3ChecksumFileBufferSize = 1024 * 1024;
+
+#pragma mark - CRC32C
+
+static uint32_t AWSS3CRC32CTable[8][256];
+
+static void AWSS3CRC32CInitializeTable(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+        }
+        AWSS3CRC32CTable[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int slice = 1; slice < 8; slice++) {
+            uint32_t previous = AWSS3CRC32CTable[slice - 1][i];
+            AWSS3CRC32CTable[slice][i] = (previous >> 8) ^ AWSS3CRC32CTable[0][previous & 0xFF];
+        }
+    }
+}
+
+// Slicing-by-8, reading eight little-endian bytes at a time.
+static uint32_t AWSS3CRC32CUpdatePortable(uint32_t crc, const uint8_t *bytes, size_t length) {
+    while (length >= 8) {
+        uint64_t value;
+        memcpy(&value, bytes, sizeof(value));
+        value ^= crc;
+        crc = AWSS3CRC32CTable[7][value & 0xFF] ^
+              AWSS3CRC32CTable[6][(value >> 8) & 0xFF] ^
+              AWSS3CRC32CTable[5][(value >> 16) & 0xFF] ^
+              AWSS3CRC32CTable[4][(value >> 24) & 0xFF] ^
+              AWSS3CRC32CTable[3][(value >> 32) & 0xFF] ^
+              AWSS3CRC32CTable[2][(value >> 40) & 0xFF] ^
+              AWSS3CRC32CTable[1][(value >> 48) & 0xFF] ^
+              AWSS3CRC32CTable[0][value >> 56];
+        bytes += 8;
+        length -= 8;
+    }
+    while (length--) {
+        crc = (crc >> 8) ^ AWSS3CRC32CTable[0][(crc ^ *bytes++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(__aarch64__)
+
+__attribute__((target("crc")))
+static uint32_t AWSS3CRC32CUpdateHardware(uint32_t crc, const uint8_t *bytes, size_t length) {
+    while (length >= 8) {
+        uint64_t value;
+        memcpy(&value, bytes, sizeof(value));
+        crc = __crc32cd(crc, value);
+        bytes += 8;
+        length -= 8;
+    }
+    while (length--) {
+        crc = __crc32cb(crc, *bytes++);
+    }
+    return crc;
+}
+
+static BOOL AWSS3CRC32CHardwareAvailable(void) {
+    int available = 0;
+    size_t size = sizeof(available);
+    if (sysctlbyname("hw.optional.armv8_crc32", &available, &size, NULL, 0) != 0) {
+        return NO;
+    }
+    return available != 0;
+}
+
+#elif defined(__x86_64__)
+
+__attribute__((target("sse4.2")))
+static uint32_t AWSS3CRC32CUpdateHardware(uint32_t crc, const uint8_t *bytes, size_t length) {
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t value;
+        memcpy(&value, bytes, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+        bytes += 8;
+        length -= 8;
+    }
+    crc = (uint32_t)crc64;
+    while (length--) {
+        crc = _mm_crc32_u8(crc, *bytes++);
+    }
+    return crc;
+}
+
+static BOOL AWSS3CRC32CHardwareAvailable(void) {
+    return __builtin_cpu_supports("sse4.2");
+}
+
+#else
+
+static BOOL AWSS3CRC32CHardwareAvailable(void) {
+    return NO;
+}
+
+#endif
+
+typedef uint32_t (*AWSS3CRC32CUpdateFunction)(uint32_t crc, const uint8_t *bytes, size_t length);
+
+static AWSS3CRC32CUpdateFunction AWSS3CRC32CSelectedUpdate(BOOL *hardwareAccelerated) {
+    static AWSS3CRC32CUpdateFunction update = NULL;
+    static BOOL accelerated = NO;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        AWSS3CRC32CInitializeTable();
+        update = AWSS3CRC32CUpdatePortable;
+#if defined(__aarch64__) || defined(__x86_64__)
+        if (AWSS3CRC32CHardwareAvailable()) {
+            update = AWSS3CRC32CUpdateHardware;
+            accelerated = YES;
+        }
+#endif
+    });
+    if (hardwareAccelerated) {
+        *hardwareAccelerated = accelerated;
+    }
+    return update;
+}
+
+uint32_t AWSS3CRC32C(uint32_t crc, const void *bytes, size_t length) {
+    return ~AWSS3CRC32CSelectedUpdate(NULL)(~crc, bytes, length);
+}
+
+uint32_t AWSS3CRC32CPortable(uint32_t crc, const void *bytes, size_t length) {
+    AWSS3CRC32CSelectedUpdate(NULL);
+    return ~AWSS3CRC32CUpdatePortable(~crc, bytes, length);
+}
+
+#pragma mark - AWSS3Checksum
+
+@interface AWSS3Checksum() {
+    uint32_t _crc;
+    CC_SHA256_CTX _sha256;
+    NSData *_digest;
+}
+
+@end
+
+@implementation AWSS3Checksum
+
++ (BOOL)isHardwareAccelerated {
+    BOOL hardwareAccelerated = NO;
+    AWSS3CRC32CSelectedUpdate(&hardwareAccelerated);
+    return hardwareAccelerated;
+}
+
++ (BOOL)isSupportedAlgorithm:(AWSS3ChecksumAlgorithm)algorithm {
+    return algorithm == AWSS3ChecksumAlgorithmCRC32C || algorithm == AWSS3ChecksumAlgorithmSHA256;
+}
+
+- (instancetype)init {
+    @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                   reason:@"`- init` is not a valid initializer. Use `- initWithAlgorithm:` instead."
+                                 userInfo:nil];
+    return nil;
+}
+
+- (instancetype)initWithAlgorithm:(AWSS3ChecksumAlgorithm)algorithm {
+    if (![AWSS3Checksum isSupportedAlgorithm:algorithm]) {
+        return nil;
+    }
+    if (self = [super init]) {
+        _algorithm = algorithm;
+        _crc = 0;
+        if (algorithm == AWSS3ChecksumAlgorithmSHA256) {
+            CC_SHA256_Init(&_sha256);
+        }
+    }
+    return self;
+}
+
+- (void)updateWithBytes:(const void *)bytes length:(NSUInteger)length {
+    NSAssert(_digest == nil, @"The checksum is already finished.");
+    switch (self.algorithm) {
+        case AWSS3ChecksumAlgorithmCRC32C:
+            _crc = AWSS3CRC32C(_crc, bytes, length);
+            break;
+        case AWSS3ChecksumAlgorithmSHA256: {
+            const uint8_t *remainingBytes = bytes;
+            while (length > 0) {
+                CC_LONG chunkLength = (CC_LONG)MIN(length, (NSUInteger)UINT32_MAX);
+                CC_SHA256_Update(&_sha256, remainingBytes, chunkLength);
+                remainingBytes += chunkLength;
+                length -= chunkLength;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+- (void)updateWithData:(NSData *)data {
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        [self updateWithBytes:bytes length:byteRange.length];
+    }];
+}
+
+- (NSData *)digest {
+    if (_digest) {
+        return _digest;
+    }
+    switch (self.algorithm) {
+        case AWSS3ChecksumAlgorithmCRC32C: {
+            uint32_t bigEndianCRC = CFSwapInt32HostToBig(_crc);
+            _digest = [NSData dataWithBytes:&bigEndianCRC length:sizeof(bigEndianCRC)];
+            break;
+        }
+        case AWSS3ChecksumAlgorithmSHA256: {
+            unsigned char sha256[CC_SHA256_DIGEST_LENGTH];
+            CC_SHA256_Final(sha256, &_sha256);
+            _digest = [NSData dataWithBytes:sha256 length:CC_SHA256_DIGEST_LENGTH];
+            break;
+        }
+        default:
+            _digest = [NSData data];
+            break;
+    }
+    return _digest;
+}
+
+- (NSString *)base64Digest {
+    return [[self digest] base64EncodedStringWithOptions:kNilOptions];
+}
+
++ (NSString *)base64ChecksumOfFileAtURL:(NSURL *)fileURL
+                              algorithm:(AWSS3ChecksumAlgorithm)algorithm
+                                  error:(NSError **)error {
+    AWSS3Checksum *checksum = [[AWSS3Checksum alloc] initWithAlgorithm:algorithm];
+    if (!checksum) {
+        return nil;
+    }
+    NSInputStream *inputStream = [NSInputStream inputStreamWithURL:fileURL];
+    [inputStream open];
+    uint8_t *buffer = malloc(AWSS3ChecksumFileBufferSize);
+    NSInteger bytesRead = 0;
+    while ((bytesRead = [inputStream read:buffer maxLength:AWSS3ChecksumFileBufferSize]) > 0) {
+        [checksum updateWithBytes:buffer length:bytesRead];
+    }
+    free(buffer);
+    NSError *streamError = inputStream.streamError;
+    [inputStream close];
+    if (bytesRead < 0 || streamError) {
+        if (error) {
+            *error = streamError ?: [NSError errorWithDomain:NSCocoaErrorDomain
+                                                        code:NSFileReadUnknownError
+                                                    userInfo:@{NSURLErrorKey: fileURL}];
+        }
+        return nil;
+    }
+    return [checksum base64Digest];
+}
+
++ (NSString *)compositeChecksumOfPartChecksums:(NSArray<NSString *> *)partChecksums
+                                     algorithm:(AWSS3ChecksumAlgorithm)algorithm {
+    AWSS3Checksum *checksum = [[AWSS3Checksum alloc] initWithAlgorithm:algorithm];
+    if (!checksum) {
+        return nil;
+    }
+    for (NSString *partChecksum in partChecksums) {
+        NSData *digest = [[NSData alloc] initWithBase64EncodedString:partChecksum options:kNilOptions];
+        if (!digest) {
+            return nil;
+        }
+        [checksum updateWithData:digest];
+    }
+    return [NSString stringWithFormat:@"%@-%lu", [checksum base64Digest], (unsigned long)[partChecksums count]];
+}
+
++ (NSString *)nameForAlgorithm:(AWSS3ChecksumAlgorithm)algorithm {
+    switch (algorithm) {
+        case AWSS3ChecksumAlgorithmCRC32:
+            return @"CRC32";
+        case AWSS3ChecksumAlgorithmCRC32C:
+            return @"CRC32C";
+        case AWSS3ChecksumAlgorithmSHA1:
+            return @"SHA1";
+        case AWSS3ChecksumAlgorithmSHA256:
+            return @"SHA256";
+        default:
+            return nil;
+    }
+}
+
++ (AWSS3ChecksumAlgorithm)algorithmForName:(NSString *)name {
+    for (AWSS3ChecksumAlgorithm algorithm = AWSS3ChecksumAlgorithmCRC32; algorithm <= AWSS3ChecksumAlgorithmSHA256; algorithm++) {
+        if (name && [name caseInsensitiveCompare:[self nameForAlgorithm:algorithm]] == NSOrderedSame) {
+            return algorithm;
+        }
+    }
+    return AWSS3ChecksumAlgorithmUnknown;
+}
+
++ (NSString *)headerNameForAlgorithm:(AWSS3ChecksumAlgorithm)algorithm {
+    NSString *name = [self nameForAlgorithm:algorithm];
+    if (!name) {
+        return nil;
+    }
+    return [@"x-amz-checksum-" stringByAppendingString:[name lowercaseString]];
+}
+
+@end
@@ -21,6 +21,7 @@
 + (NSValueTransformer *)serverSideEncryptionJSONTransformer;
 + (NSValueTransformer *)requestPayerJSONTransformer;
 + (NSValueTransformer *)expiresJSONTransformer;
++ (NSValueTransformer *)checksumAlgorithmJSONTransformer;
 @end
 
 @implementation AWSS3CreateMultipartUploadRequest (RequestHeaders)
@@ -99,6 +100,10 @@
         else if ([lKey isEqualToString:@"x-amz-tagging" ]) {
             uploadRequest.tagging = requestHeaders[key];
         }
+        else if ([lKey isEqualToString:@"x-amz-checksum-algorithm" ]) {
+            NSValueTransformer *transformer = [AWSS3CreateMultipartUploadRequest checksumAlgorithmJSONTransformer];
+            uploadRequest.checksumAlgorithm = (AWSS3ChecksumAlgorithm)[[transformer transformedValue:requestHeaders[key]] integerValue];
+        }
     }
     uploadRequest.metadata = metadata;
 }
@@ -107,6 +107,14 @@ typedef NS_ENUM(NSInteger, AWSS3BucketVersioningStatus) {
     AWSS3BucketVersioningStatusSuspended,
 };
 
+typedef NS_ENUM(NSInteger, AWSS3ChecksumAlgorithm) {
+    AWSS3ChecksumAlgorithmUnknown,
+    AWSS3ChecksumAlgorithmCRC32,
+    AWSS3ChecksumAlgorithmCRC32C,
+    AWSS3ChecksumAlgorithmSHA1,
+    AWSS3ChecksumAlgorithmSHA256,
+};
+
 typedef NS_ENUM(NSInteger, AWSS3CompressionType) {
     AWSS3CompressionTypeUnknown,
     AWSS3CompressionTypeNone,
@@ -1133,6 +1141,16 @@ typedef NS_ENUM(NSInteger, AWSS3Types) {
  */
 @property (nonatomic, strong) NSString * _Nullable bucket;
 
+/**
+ <p>The base64-encoded, 32-bit CRC32C checksum of the object. For an object uploaded in parts, this is the checksum of the checksums of its parts, followed by the number of parts.</p>
+ */
+@property (nonatomic, strong) NSString * _Nullable checksumCRC32C;
+
+/**
+ <p>The base64-encoded, 256-bit SHA-256 digest of the object. For an object uploaded in parts, this is the digest of the digests of its parts, followed by the number of parts.</p>
+ */
+@property (nonatomic, strong) NSString * _Nullable checksumSHA256;
+
 /**
  <p>Entity tag that identifies the newly created object's data. Objects with different object data will have different entity tags. The entity tag is an opaque string. The entity tag may or may not be an MD5 digest of the object data. If the entity tag is not an MD5 digest of the object data, it will contain one or more nonhexadecimal characters and/or will consist of less than 32 or more than 32 hexadecimal digits.</p>
  */
@@ -1232,6 +1250,16 @@ typedef NS_ENUM(NSInteger, AWSS3Types) {
 @interface AWSS3CompletedPart : AWSModel
 
 
+/**
+ <p>The base64-encoded, 32-bit CRC32C checksum of the part.</p>
+ */
+@property (nonatomic, strong) NSString * _Nullable checksumCRC32C;
+
+/**
+ <p>The base64-encoded, 256-bit SHA-256 digest of the part.</p>
+ */
+@property (nonatomic, strong) NSString * _Nullable checksumSHA256;
+
 /**
  <p>Entity tag returned when the part was uploaded.</p>
  */
@@ -1725,6 +1753,11 @@ typedef NS_ENUM(NSInteger, AWSS3Types) {
  */
 @property (nonatomic, strong) NSString * _Nullable bucket;
 
+/**
+ <p>The algorithm used to create the checksums of the parts and of the object. The checksum of each part must be sent when it is uploaded and again when the upload is completed.</p>
+ */
+@property (nonatomic, assign) AWSS3ChecksumAlgorithm checksumAlgorithm;
+
 /**
  <p>Specifies caching behavior along the request/reply chain.</p>
  */
@@ -619,6 +619,8 @@ return [date aws_stringValue:AWSDateISO8601DateFormat1];
 + (NSDictionary *)JSONKeyPathsByPropertyKey {
 	return @{
              @"bucket" : @"Bucket",
+             @"checksumCRC32C" : @"ChecksumCRC32C",
+             @"checksumSHA256" : @"ChecksumSHA256",
              @"ETag" : @"ETag",
              @"expiration" : @"Expiration",
              @"key" : @"Key",
@@ -734,6 +736,8 @@ return [date aws_stringValue:AWSDateISO8601DateFormat1];
 
 + (NSDictionary *)JSONKeyPathsByPropertyKey {
 	return @{
+             @"checksumCRC32C" : @"ChecksumCRC32C",
+             @"checksumSHA256" : @"ChecksumSHA256",
              @"ETag" : @"ETag",
              @"partNumber" : @"PartNumber",
              };
@@ -1522,6 +1526,7 @@ return [date aws_stringValue:AWSDateISO8601DateFormat1];
              @"ACL" : @"ACL",
              @"bucket" : @"Bucket",
              @"cacheControl" : @"CacheControl",
+             @"checksumAlgorithm" : @"ChecksumAlgorithm",
              @"contentDisposition" : @"ContentDisposition",
              @"contentEncoding" : @"ContentEncoding",
              @"contentLanguage" : @"ContentLanguage",
@@ -1596,6 +1601,37 @@ return [date aws_stringValue:AWSDateISO8601DateFormat1];
     }];
 }
 
++ (NSValueTransformer *)checksumAlgorithmJSONTransformer {
+    return [AWSMTLValueTransformer reversibleTransformerWithForwardBlock:^NSNumber *(NSString *value) {
+        if ([value caseInsensitiveCompare:@"CRC32"] == NSOrderedSame) {
+            return @(AWSS3ChecksumAlgorithmCRC32);
+        }
+        if ([value caseInsensitiveCompare:@"CRC32C"] == NSOrderedSame) {
+            return @(AWSS3ChecksumAlgorithmCRC32C);
+        }
+        if ([value caseInsensitiveCompare:@"SHA1"] == NSOrderedSame) {
+            return @(AWSS3ChecksumAlgorithmSHA1);
+        }
+        if ([value caseInsensitiveCompare:@"SHA256"] == NSOrderedSame) {
+            return @(AWSS3ChecksumAlgorithmSHA256);
+        }
+        return @(AWSS3ChecksumAlgorithmUnknown);
+    } reverseBlock:^NSString *(NSNumber *value) {
+        switch ([value integerValue]) {
+            case AWSS3ChecksumAlgorithmCRC32:
+                return @"CRC32";
+            case AWSS3ChecksumAlgorithmCRC32C:
+                return @"CRC32C";
+            case AWSS3ChecksumAlgorithmSHA1:
+                return @"SHA1";
+            case AWSS3ChecksumAlgorithmSHA256:
+                return @"SHA256";
+            default:
+                return nil;
+        }
+    }];
+}
+
 + (NSValueTransformer *)expiresJSONTransformer {
     return [AWSMTLValueTransformer reversibleTransformerWithForwardBlock:^id(NSString *str) {
         return [NSDate aws_dateFromString:str];
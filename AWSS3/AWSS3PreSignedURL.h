@@ -50,6 +50,11 @@ typedef NS_ENUM(NSInteger, AWSS3PresignedURLErrorType) {
 
 @interface AWSS3PreSignedURLBuilder : AWSService
 
+/**
+ How much sooner than requested a cached pre-signed URL may expire and still be returned. When this is greater than zero, URLs are cached per object, HTTP method, headers, parameters and access key, and a request for the same object returns the cached URL as long as it expires no later than the requested expiration date and no more than this interval before it. Set this to the longest you are willing to let a URL be valid for less than asked in exchange for not signing it again, for example 300 seconds for URLs that are requested with a one hour expiration date. The default is `0`, which disables the cache.
+ */
+@property (nonatomic, assign) NSTimeInterval preSignedURLCacheTolerance;
+
 /**
  Returns the singleton service client. If the singleton object does not exist, the SDK instantiates the default service client with `defaultServiceConfiguration` from `[AWSServiceManager defaultServiceManager]`. The reference to this object is maintained by the SDK, and you do not need to retain it manually.
 
@@ -198,6 +203,22 @@ typedef NS_ENUM(NSInteger, AWSS3PresignedURLErrorType) {
  */
 - (AWSTask<NSURL *> *)getPreSignedURL:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest;
 
+/**
+ Build time-limited pre-signed URLs for several objects in the same bucket with one credentials lookup. The signing key, the credential scope and the canonical query string and headers are computed once and shared by every URL, so signing many keys costs little more than hashing each object path.
+
+ @param keys The names of the S3 objects.
+ @param getPreSignedURLRequest The bucket, HTTP method, expiration date and additional headers and parameters shared by every URL. Its `key` is ignored.
+ @return The pre-signed URLs, in the same order as `keys`.
+ @see AWSS3GetPreSignedURLRequest
+ */
+- (AWSTask<NSArray<NSURL *> *> *)getPreSignedURLsForKeys:(NSArray<NSString *> *)keys
+                                                  request:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest;
+
+/**
+ Removes every cached pre-signed URL, for example after the credentials they were signed with have been revoked.
+ */
+- (void)removeAllCachedPreSignedURLs;
+
 @end
 
 /** The GetPreSignedURLRequest contains the parameters used to create
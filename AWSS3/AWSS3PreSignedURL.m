@@ -25,12 +25,38 @@ NSString *const AWSS3PresignedURLErrorDomain = @"com.amazonaws.AWSS3PresignedURL
 
 static NSString *const AWSS3PreSignedURLBuilderAcceleratedEndpoint = @"s3-accelerate.amazonaws.com";
 
+static NSUInteger const AWSS3PreSignedURLBuilderCacheCountLimit = 1000;
+static int32_t const AWSS3PreSignedURLBuilderMaximumExpireDuration = 604800;
+
 static NSString *const AWSInfoS3PreSignedURLBuilder = @"S3PreSignedURLBuilder";
 static NSString *const AWSS3PreSignedURLBuilderSDKVersion = @"2.36.3";
 
+@interface AWSS3PreSignedURLCacheEntry : NSObject
+
+@property (nonatomic, strong) NSURL *URL;
+@property (nonatomic, strong) NSDate *expirationDate;
+
+@end
+
+@implementation AWSS3PreSignedURLCacheEntry
+
+@end
+
 @interface AWSS3PreSignedURLBuilder()
 
 @property (nonatomic, strong) AWSServiceConfiguration *configuration;
+@property (nonatomic, strong) NSCache<NSString *, AWSS3PreSignedURLCacheEntry *> *preSignedURLCache;
+
+@end
+
+@interface AWSSignatureV4Signer()
+
++ (NSString *)getCredentialScopeForDate:(NSDate *)date
+                             regionName:(NSString *)regionName
+                            serviceName:(NSString *)serviceName;
++ (NSString *)getURIEncodedQueryStringForSigV4:(NSArray<NSURLQueryItem *> *)queryItems;
++ (NSString *)getCanonicalizedQueryString:(NSString *)query;
++ (NSString *)getCanonicalizedHeaderString:(NSDictionary *)headers;
 
 @end
 
@@ -54,6 +80,15 @@ static NSString *const AWSS3PreSignedURLBuilderSDKVersion = @"2.36.3";
 @property NSNumber *partNumber;
 @end
 
+static void AWSS3PreSignedURLHexEncode(const uint8_t digest[CC_SHA256_DIGEST_LENGTH], char hex[CC_SHA256_DIGEST_LENGTH * 2 + 1]) {
+    static const char digits[] = "0123456789abcdef";
+    for (NSUInteger i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        hex[2 * i] = digits[digest[i] >> 4];
+        hex[2 * i + 1] = digits[digest[i] & 0x0f];
+    }
+    hex[CC_SHA256_DIGEST_LENGTH * 2] = '\0';
+}
+
 @implementation AWSS3PreSignedURLBuilder
 
 static AWSSynchronizedMutableDictionary *_serviceClients = nil;
@@ -147,118 +182,37 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             [_configuration.endpoint setRegion:_configuration.regionType
                                        service:AWSServiceS3];
         }
+
+        _preSignedURLCache = [NSCache new];
+        _preSignedURLCache.countLimit = AWSS3PreSignedURLBuilderCacheCountLimit;
     }
 
     return self;
 }
 
 - (AWSTask<NSURL *> *)getPreSignedURL:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest {
+    if (self.preSignedURLCacheTolerance > 0) {
+        return [[self getPreSignedURLsForKeys:@[getPreSignedURLRequest.key ?: @""]
+                                      request:getPreSignedURLRequest] continueWithSuccessBlock:^id _Nullable(AWSTask<NSArray<NSURL *> *> * _Nonnull task) {
+            return task.result.firstObject;
+        }];
+    }
+
     //retrive parameters from request;
     NSString *bucketName = getPreSignedURLRequest.bucket;
     NSString *keyName = getPreSignedURLRequest.key;
     AWSHTTPMethod httpMethod = getPreSignedURLRequest.HTTPMethod;
     AWSServiceConfiguration *configuration = self.configuration;
     id<AWSCredentialsProvider>credentialsProvider = configuration.credentialsProvider;
-    AWSEndpoint *endpoint = self.configuration.endpoint;
-    BOOL isAccelerateModeEnabled = getPreSignedURLRequest.isAccelerateModeEnabled;
 
     NSDate *expires = getPreSignedURLRequest.expires;
 
     return [[[AWSTask taskWithResult:nil] continueWithBlock:^id(AWSTask *task) {
 
-        //validate additionalParams
-        for (id key in getPreSignedURLRequest.requestParameters) {
-            id value = getPreSignedURLRequest.requestParameters[key];
-            if (![key isKindOfClass:[NSString class]]
-                || ![value isKindOfClass:[NSString class]]) {
-                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                                  code:AWSS3PresignedURLErrorInvalidRequestParameters
-                                                              userInfo:@{NSLocalizedDescriptionKey: @"requestParameters can only contain key-value pairs in NSString type."}]
-                        ];
-            }
-        }
-
-        //validate endpoint
-        if (!endpoint) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorEndpointIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"endpoint in configuration can not be nil"}]
-                    ];
-        } else if (endpoint.serviceType != AWSServiceS3) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidServiceType
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"Invalid serviceType: serviceType in endpoint must be AWSServiceS3"}]
-                    ];
-        }
-
-        //validate credentialsProvider
-        if (!credentialsProvider) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PreSignedURLErrorCredentialProviderIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"credentialsProvider in configuration can not be nil"}]
-                    ];
-        }
-
-        //validate bucketName
-        if (!bucketName || [bucketName length] < 1) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorBucketNameIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"S3 bucket can not be nil or empty"}]];
-        }
-
-        // validate values for transfer acceleration.
-        if (isAccelerateModeEnabled) {
-            // validate the bucket name
-            if (![bucketName aws_isVirtualHostedStyleCompliant]) {
-                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                                  code:AWSS3PresignedURLErrorInvalidBucketNameForAccelerateModeEnabled
-                                                              userInfo:@{
-                                                                         NSLocalizedDescriptionKey: @"For your bucket to work with transfer acceleration, the bucket name must conform to DNS naming requirements and must not contain periods."}]];
-            }
-            
-            // validate the preferred access style
-            if (getPreSignedURLRequest.preferredAccessStyle == AWSS3BucketAccessStylePath) {
-                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                                  code:AWSS3PresignedURLErrorInvalidAccessStyleForAccelerateModeEnabled
-                                                              userInfo:@{
-                                                                         NSLocalizedDescriptionKey: @"Transfer Acceleration is only supported on virtual-hosted style requests."}]];
-            }
-        }
-
-        //validate keyName
-        if (!keyName || [keyName length] < 1) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorKeyNameIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"S3 key can not be nil or empty"}]
-                    ];
-        }
-
-        //validate expires Date
-        if (!expires) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidExpiresDate
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"expires can not be nil"}]
-                    ];
-        }else if ([expires timeIntervalSinceNow] < 0.0) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidExpiresDate
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"expires can not be in past"}]
-                    ];
-        }
-
-        //validate httpMethod
-        switch (httpMethod) {
-            case AWSHTTPMethodGET:
-            case AWSHTTPMethodPUT:
-            case AWSHTTPMethodHEAD:
-            case AWSHTTPMethodDELETE:
-                break;
-            default:
-                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                                  code:AWSS3PresignedURLErrorUnsupportedHTTPVerbs
-                                                              userInfo:@{NSLocalizedDescriptionKey: @"unsupported HTTP Method, currently only support AWSHTTPMethodGET, AWSHTTPMethodPUT, AWSHTTPMethodHEAD, AWSHTTPMethodDELETE"}]
-                        ];
-                break;
+        NSError *error = [self validatePreSignedURLRequest:getPreSignedURLRequest
+                                                      keys:@[keyName ?: @""]];
+        if (error) {
+            return [AWSTask taskWithError:error];
         }
 
         return [[credentialsProvider credentials] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
@@ -270,45 +224,16 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             return credentialsProvider;
         }];
     }] continueWithSuccessBlock:^id _Nullable(AWSTask * _Nonnull task) {
-        //generate baseURL String (use virtualHostStyle if possible)
-        //base url is not url encoded.
-        NSString *keyPath = nil;
-        if (bucketName == nil || [self shouldUseVirtualHostStyleForRequest:getPreSignedURLRequest]) {
-            keyPath = (keyName == nil ? @"" : [NSString stringWithFormat:@"%@", [keyName aws_stringWithURLEncodingPath]]);
-        } else {
-            keyPath = (keyName == nil ? [NSString stringWithFormat:@"%@", bucketName] : [NSString stringWithFormat:@"%@/%@", bucketName, [keyName aws_stringWithURLEncodingPath]]);
-        }
-
-        //generate correct hostName (use virtualHostStyle if possible)
-        NSString *host = nil;
-        if (!self.configuration.localTestingEnabled &&
-            bucketName &&
-            [self shouldUseVirtualHostStyleForRequest:getPreSignedURLRequest]) {
-            if (isAccelerateModeEnabled) {
-                host = [NSString stringWithFormat:@"%@.%@", bucketName, AWSS3PreSignedURLBuilderAcceleratedEndpoint];
-            } else {
-                host = [NSString stringWithFormat:@"%@.%@", bucketName, endpoint.hostName];
-            }
-        } else {
-            host = endpoint.hostName;
-        }
-        [getPreSignedURLRequest setValue:host forRequestHeader:@"host"];
-        
-        //If this is a presigned request for a multipart upload, set the uploadID and partNumber on the request.
-        if (getPreSignedURLRequest.uploadID
-            && getPreSignedURLRequest.partNumber) {
-            
-            [getPreSignedURLRequest setValue:getPreSignedURLRequest.uploadID
-                         forRequestParameter:@"uploadId"];
-            
-            [getPreSignedURLRequest setValue:[NSString stringWithFormat:@"%@", getPreSignedURLRequest.partNumber]
-                         forRequestParameter:@"partNumber"];
-        }
-        NSString *portNumber = endpoint.portNumber != nil ? [NSString stringWithFormat:@":%@", endpoint.portNumber.stringValue]: @"";
-        AWSEndpoint *newEndpoint = [[AWSEndpoint alloc]initWithRegion:configuration.regionType service:AWSServiceS3 URL:[NSURL URLWithString:[NSString stringWithFormat:@"%@://%@%@", endpoint.useUnsafeURL?@"http":@"https", host, portNumber]]];
+        BOOL useVirtualHostStyle = [self shouldUseVirtualHostStyleForRequest:getPreSignedURLRequest];
+        NSString *keyPath = [self keyPathForKey:keyName
+                                         bucket:bucketName
+                            useVirtualHostStyle:useVirtualHostStyle];
+        NSURL *hostURL = [self prepareRequestForSigning:getPreSignedURLRequest
+                                    useVirtualHostStyle:useVirtualHostStyle];
+        AWSEndpoint *newEndpoint = [[AWSEndpoint alloc]initWithRegion:configuration.regionType service:AWSServiceS3 URL:hostURL];
         
         int32_t expireDuration = [expires timeIntervalSinceNow];
-        if (expireDuration > 604800) {
+        if (expireDuration > AWSS3PreSignedURLBuilderMaximumExpireDuration) {
             return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
                                                               code:AWSS3PresignedURLErrorInvalidExpiresDate
                                                           userInfo:@{NSLocalizedDescriptionKey: @"Invalid ExpiresDate, must be less than seven days in future"}]
@@ -326,6 +251,350 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     }];
 }
 
+- (AWSTask<NSArray<NSURL *> *> *)getPreSignedURLsForKeys:(NSArray<NSString *> *)keys
+                                                  request:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest {
+    id<AWSCredentialsProvider>credentialsProvider = self.configuration.credentialsProvider;
+
+    return [[[AWSTask taskWithResult:nil] continueWithBlock:^id(AWSTask *task) {
+        NSError *error = [self validatePreSignedURLRequest:getPreSignedURLRequest
+                                                      keys:keys];
+        if (error) {
+            return [AWSTask taskWithError:error];
+        }
+
+        return [[credentialsProvider credentials] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
+            AWSCredentials *credentials = task.result;
+            if ([credentials.expiration timeIntervalSinceNow] < getPreSignedURLRequest.minimumCredentialsExpirationInterval) {
+                [credentialsProvider invalidateCachedTemporaryCredentials];
+                return [credentialsProvider credentials];
+            }
+
+            return task;
+        }];
+    }] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
+        AWSCredentials *credentials = task.result;
+        if (!credentials) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                                              code:AWSS3PreSignedURLErrorInternalError
+                                                          userInfo:@{NSLocalizedDescriptionKey: @"Credentials result unexpectedly nil generating presigned URL"}]];
+        }
+
+        NSError *error = nil;
+        NSArray<NSURL *> *URLs = [self preSignedURLsForKeys:keys
+                                                    request:getPreSignedURLRequest
+                                                credentials:credentials
+                                                      error:&error];
+        if (!URLs) {
+            return [AWSTask taskWithError:error];
+        }
+        return URLs;
+    }];
+}
+
+- (void)removeAllCachedPreSignedURLs {
+    [self.preSignedURLCache removeAllObjects];
+}
+
+/*
+ Signs every key with the same date, expiration and credentials. Everything in the canonical request except the path
+ is the same for every key, so the canonical query string, the canonical headers and the signing key are computed once,
+ and the string to sign is hashed into an HMAC context that is copied for each key.
+ */
+- (NSArray<NSURL *> *)preSignedURLsForKeys:(NSArray<NSString *> *)keys
+                                   request:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest
+                               credentials:(AWSCredentials *)credentials
+                                     error:(NSError **)error {
+    NSDate *date = [NSDate aws_clockSkewFixedDate];
+    NSDate *expires = getPreSignedURLRequest.expires;
+    int32_t expireDuration = [expires timeIntervalSinceNow];
+    if (expireDuration > AWSS3PreSignedURLBuilderMaximumExpireDuration) {
+        *error = [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                     code:AWSS3PresignedURLErrorInvalidExpiresDate
+                                 userInfo:@{NSLocalizedDescriptionKey: @"Invalid ExpiresDate, must be less than seven days in future"}];
+        return nil;
+    }
+
+    BOOL useVirtualHostStyle = [self shouldUseVirtualHostStyleForRequest:getPreSignedURLRequest];
+    NSURL *hostURL = [self prepareRequestForSigning:getPreSignedURLRequest
+                                useVirtualHostStyle:useVirtualHostStyle];
+    NSString *httpMethod = [NSString aws_stringWithHTTPMethod:getPreSignedURLRequest.HTTPMethod];
+    NSDictionary<NSString *, NSString *> *requestHeaders = getPreSignedURLRequest.requestHeaders;
+    NSDictionary<NSString *, NSString *> *requestParameters = getPreSignedURLRequest.requestParameters;
+
+    // A cached URL was signed for the same object, headers, parameters and access key, and expires no later than
+    // requested and no more than the tolerance before that.
+    NSTimeInterval cacheTolerance = self.preSignedURLCacheTolerance;
+    NSString *cacheKeyPrefix = nil;
+    if (cacheTolerance > 0) {
+        cacheKeyPrefix = [NSString stringWithFormat:@"%@\n%@\n%@\n%@\n%@\n",
+                          credentials.accessKey,
+                          httpMethod,
+                          hostURL.absoluteString,
+                          [AWSSignatureV4Signer getCanonicalizedHeaderString:requestHeaders],
+                          [AWSSignatureV4Signer getCanonicalizedQueryString:[AWSSignatureV4Signer getURIEncodedQueryStringForSigV4:[AWSNetworkingHelpers queryItemsFromDictionary:requestParameters]]]];
+    }
+    NSDate *expirationDate = [NSDate dateWithTimeIntervalSinceNow:expireDuration];
+    if (credentials.expiration && [credentials.expiration compare:expirationDate] == NSOrderedAscending) {
+        // Temporary credentials invalidate the URL when they expire.
+        expirationDate = credentials.expiration;
+    }
+
+    NSMutableArray<NSURL *> *URLs = [NSMutableArray arrayWithCapacity:keys.count];
+    NSMutableArray<NSNumber *> *uncachedIndexes = [NSMutableArray new];
+    for (NSUInteger i = 0; i < keys.count; i++) {
+        AWSS3PreSignedURLCacheEntry *entry = nil;
+        if (cacheKeyPrefix) {
+            entry = [self.preSignedURLCache objectForKey:[cacheKeyPrefix stringByAppendingString:keys[i]]];
+            if (entry
+                && ([entry.expirationDate compare:expires] == NSOrderedDescending
+                    || [expires timeIntervalSinceDate:entry.expirationDate] > cacheTolerance
+                    || [entry.expirationDate timeIntervalSinceNow] <= 0)) {
+                entry = nil;
+            }
+        }
+        if (entry) {
+            [URLs addObject:entry.URL];
+        } else {
+            [URLs addObject:(NSURL *)[NSNull null]];
+            [uncachedIndexes addObject:@(i)];
+        }
+    }
+    if (uncachedIndexes.count == 0) {
+        return URLs;
+    }
+
+    NSString *regionName = self.configuration.endpoint.regionName;
+    NSString *serviceName = self.configuration.endpoint.serviceName;
+    NSString *iso8601Date = [date aws_stringValue:AWSDateISO8601DateFormat2];
+    NSString *credentialsScope = [AWSSignatureV4Signer getCredentialScopeForDate:date
+                                                                      regionName:regionName
+                                                                     serviceName:serviceName];
+
+    NSMutableArray<NSURLQueryItem *> *queryItems = [[AWSNetworkingHelpers queryItemsFromDictionary:requestParameters] mutableCopy];
+    [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Algorithm" value:AWSSignatureV4Algorithm]];
+    [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Credential"
+                                                      value:[NSString stringWithFormat:@"%@/%@", credentials.accessKey, credentialsScope]]];
+    [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Date" value:iso8601Date]];
+    [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Expires" value:[NSString stringWithFormat:@"%d", expireDuration]]];
+    [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-SignedHeaders"
+                                                      value:[AWSSignatureV4Signer getSignedHeadersString:requestHeaders]]];
+    if (credentials.sessionKey.length > 0) {
+        [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Security-Token" value:credentials.sessionKey]];
+    }
+    NSString *queryString = [AWSSignatureV4Signer getURIEncodedQueryStringForSigV4:queryItems];
+
+    // The canonical request is the method, the path and this suffix.
+    NSString *canonicalRequestSuffix = [NSString stringWithFormat:@"\n%@\n%@\n%@\nUNSIGNED-PAYLOAD",
+                                        [AWSSignatureV4Signer getCanonicalizedQueryString:queryString],
+                                        [AWSSignatureV4Signer getCanonicalizedHeaderString:requestHeaders],
+                                        [AWSSignatureV4Signer getSignedHeadersString:requestHeaders]];
+    NSData *canonicalRequestPrefixData = [[NSString stringWithFormat:@"%@\n", httpMethod] dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *canonicalRequestSuffixData = [canonicalRequestSuffix dataUsingEncoding:NSUTF8StringEncoding];
+
+    NSData *kSigning = [AWSSignatureV4Signer getV4DerivedKey:credentials.secretKey
+                                                        date:[date aws_stringValue:AWSDateShortDateFormat1]
+                                                      region:regionName
+                                                     service:serviceName];
+    NSData *stringToSignPrefix = [[NSString stringWithFormat:@"%@\n%@\n%@\n", AWSSignatureV4Algorithm, iso8601Date, credentialsScope] dataUsingEncoding:NSUTF8StringEncoding];
+    CCHmacContext stringToSignContext;
+    CCHmacInit(&stringToSignContext, kCCHmacAlgSHA256, kSigning.bytes, kSigning.length);
+    CCHmacUpdate(&stringToSignContext, stringToSignPrefix.bytes, stringToSignPrefix.length);
+
+    NSString *URLPrefix = [NSString stringWithFormat:@"%@/", hostURL.absoluteString];
+    char hexDigest[CC_SHA256_DIGEST_LENGTH * 2 + 1];
+    for (NSNumber *index in uncachedIndexes) {
+        NSString *keyName = keys[index.unsignedIntegerValue];
+        NSString *keyPath = [self keyPathForKey:keyName
+                                         bucket:getPreSignedURLRequest.bucket
+                            useVirtualHostStyle:useVirtualHostStyle];
+        // Matches the canonical URI the signer derives from a URL with this path.
+        NSString *path = [keyPath stringByRemovingPercentEncoding] ?: keyPath;
+        NSString *canonicalURI = [NSString stringWithFormat:@"/%@", [path aws_stringWithURLEncodingPath]];
+        NSData *canonicalURIData = [canonicalURI dataUsingEncoding:NSUTF8StringEncoding];
+
+        uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+        CC_SHA256_CTX canonicalRequestContext;
+        CC_SHA256_Init(&canonicalRequestContext);
+        CC_SHA256_Update(&canonicalRequestContext, canonicalRequestPrefixData.bytes, (CC_LONG)canonicalRequestPrefixData.length);
+        CC_SHA256_Update(&canonicalRequestContext, canonicalURIData.bytes, (CC_LONG)canonicalURIData.length);
+        CC_SHA256_Update(&canonicalRequestContext, canonicalRequestSuffixData.bytes, (CC_LONG)canonicalRequestSuffixData.length);
+        CC_SHA256_Final(digest, &canonicalRequestContext);
+        AWSS3PreSignedURLHexEncode(digest, hexDigest);
+
+        uint8_t signature[CC_SHA256_DIGEST_LENGTH];
+        CCHmacContext signatureContext = stringToSignContext;
+        CCHmacUpdate(&signatureContext, hexDigest, CC_SHA256_DIGEST_LENGTH * 2);
+        CCHmacFinal(&signatureContext, signature);
+        AWSS3PreSignedURLHexEncode(signature, hexDigest);
+
+        NSURL *URL = [NSURL URLWithString:[NSString stringWithFormat:@"%@%@?%@&X-Amz-Signature=%s", URLPrefix, keyPath, queryString, hexDigest]];
+        if (!URL) {
+            *error = [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                         code:AWSS3PreSignedURLErrorInternalError
+                                     userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Unable to build a pre-signed URL for key: %@", keyName]}];
+            return nil;
+        }
+        URLs[index.unsignedIntegerValue] = URL;
+
+        if (cacheKeyPrefix) {
+            AWSS3PreSignedURLCacheEntry *entry = [AWSS3PreSignedURLCacheEntry new];
+            entry.URL = URL;
+            entry.expirationDate = expirationDate;
+            [self.preSignedURLCache setObject:entry forKey:[cacheKeyPrefix stringByAppendingString:keyName]];
+        }
+    }
+
+    return URLs;
+}
+
+- (NSError *)validatePreSignedURLRequest:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest
+                                    keys:(NSArray<NSString *> *)keys {
+    NSString *bucketName = getPreSignedURLRequest.bucket;
+    AWSHTTPMethod httpMethod = getPreSignedURLRequest.HTTPMethod;
+    id<AWSCredentialsProvider>credentialsProvider = self.configuration.credentialsProvider;
+    AWSEndpoint *endpoint = self.configuration.endpoint;
+    BOOL isAccelerateModeEnabled = getPreSignedURLRequest.isAccelerateModeEnabled;
+    NSDate *expires = getPreSignedURLRequest.expires;
+
+    //validate additionalParams
+    for (id key in getPreSignedURLRequest.requestParameters) {
+        id value = getPreSignedURLRequest.requestParameters[key];
+        if (![key isKindOfClass:[NSString class]]
+            || ![value isKindOfClass:[NSString class]]) {
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorInvalidRequestParameters
+                                   userInfo:@{NSLocalizedDescriptionKey: @"requestParameters can only contain key-value pairs in NSString type."}];
+        }
+    }
+
+    //validate endpoint
+    if (!endpoint) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorEndpointIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"endpoint in configuration can not be nil"}];
+    } else if (endpoint.serviceType != AWSServiceS3) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidServiceType
+                               userInfo:@{NSLocalizedDescriptionKey: @"Invalid serviceType: serviceType in endpoint must be AWSServiceS3"}];
+    }
+
+    //validate credentialsProvider
+    if (!credentialsProvider) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PreSignedURLErrorCredentialProviderIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"credentialsProvider in configuration can not be nil"}];
+    }
+
+    //validate bucketName
+    if (!bucketName || [bucketName length] < 1) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorBucketNameIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"S3 bucket can not be nil or empty"}];
+    }
+
+    // validate values for transfer acceleration.
+    if (isAccelerateModeEnabled) {
+        // validate the bucket name
+        if (![bucketName aws_isVirtualHostedStyleCompliant]) {
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorInvalidBucketNameForAccelerateModeEnabled
+                                   userInfo:@{NSLocalizedDescriptionKey: @"For your bucket to work with transfer acceleration, the bucket name must conform to DNS naming requirements and must not contain periods."}];
+        }
+        
+        // validate the preferred access style
+        if (getPreSignedURLRequest.preferredAccessStyle == AWSS3BucketAccessStylePath) {
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorInvalidAccessStyleForAccelerateModeEnabled
+                                   userInfo:@{NSLocalizedDescriptionKey: @"Transfer Acceleration is only supported on virtual-hosted style requests."}];
+        }
+    }
+
+    //validate keyName
+    for (NSString *keyName in keys) {
+        if (![keyName isKindOfClass:[NSString class]] || [keyName length] < 1) {
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorKeyNameIsNil
+                                   userInfo:@{NSLocalizedDescriptionKey: @"S3 key can not be nil or empty"}];
+        }
+    }
+
+    //validate expires Date
+    if (!expires) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidExpiresDate
+                               userInfo:@{NSLocalizedDescriptionKey: @"expires can not be nil"}];
+    }else if ([expires timeIntervalSinceNow] < 0.0) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidExpiresDate
+                               userInfo:@{NSLocalizedDescriptionKey: @"expires can not be in past"}];
+    }
+
+    //validate httpMethod
+    switch (httpMethod) {
+        case AWSHTTPMethodGET:
+        case AWSHTTPMethodPUT:
+        case AWSHTTPMethodHEAD:
+        case AWSHTTPMethodDELETE:
+            break;
+        default:
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorUnsupportedHTTPVerbs
+                                   userInfo:@{NSLocalizedDescriptionKey: @"unsupported HTTP Method, currently only support AWSHTTPMethodGET, AWSHTTPMethodPUT, AWSHTTPMethodHEAD, AWSHTTPMethodDELETE"}];
+            break;
+    }
+
+
+
+    return nil;
+}
+
+- (NSString *)keyPathForKey:(NSString *)keyName
+                     bucket:(NSString *)bucketName
+        useVirtualHostStyle:(BOOL)useVirtualHostStyle {
+    //generate baseURL String (use virtualHostStyle if possible)
+    //base url is not url encoded.
+    if (bucketName == nil || useVirtualHostStyle) {
+        return (keyName == nil ? @"" : [NSString stringWithFormat:@"%@", [keyName aws_stringWithURLEncodingPath]]);
+    } else {
+        return (keyName == nil ? [NSString stringWithFormat:@"%@", bucketName] : [NSString stringWithFormat:@"%@/%@", bucketName, [keyName aws_stringWithURLEncodingPath]]);
+    }
+}
+
+// Sets the host header and the multipart upload parameters on the request, and returns the URL of the host to sign for.
+- (NSURL *)prepareRequestForSigning:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest
+                useVirtualHostStyle:(BOOL)useVirtualHostStyle {
+    NSString *bucketName = getPreSignedURLRequest.bucket;
+    AWSEndpoint *endpoint = self.configuration.endpoint;
+
+    //generate correct hostName (use virtualHostStyle if possible)
+    NSString *host = nil;
+    if (!self.configuration.localTestingEnabled &&
+        bucketName &&
+        useVirtualHostStyle) {
+        if (getPreSignedURLRequest.isAccelerateModeEnabled) {
+            host = [NSString stringWithFormat:@"%@.%@", bucketName, AWSS3PreSignedURLBuilderAcceleratedEndpoint];
+        } else {
+            host = [NSString stringWithFormat:@"%@.%@", bucketName, endpoint.hostName];
+        }
+    } else {
+        host = endpoint.hostName;
+    }
+    [getPreSignedURLRequest setValue:host forRequestHeader:@"host"];
+
+    //If this is a presigned request for a multipart upload, set the uploadID and partNumber on the request.
+    if (getPreSignedURLRequest.uploadID
+        && getPreSignedURLRequest.partNumber) {
+
+        [getPreSignedURLRequest setValue:getPreSignedURLRequest.uploadID
+                     forRequestParameter:@"uploadId"];
+
+        [getPreSignedURLRequest setValue:[NSString stringWithFormat:@"%@", getPreSignedURLRequest.partNumber]
+                     forRequestParameter:@"partNumber"];
+    }
+    NSString *portNumber = endpoint.portNumber != nil ? [NSString stringWithFormat:@":%@", endpoint.portNumber.stringValue]: @"";
+    return [NSURL URLWithString:[NSString stringWithFormat:@"%@://%@%@", endpoint.useUnsafeURL?@"http":@"https", host, portNumber]];
+}
+
 - (BOOL)shouldUseVirtualHostStyleForRequest:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest  {
     if (getPreSignedURLRequest.preferredAccessStyle == AWSS3BucketAccessStylePath) {
         AWSDDLogVerbose(@"Using path-style access because it is set as preferred access style");
@@ -1545,6 +1545,17 @@
       \"documentation\":\"<p>Describes how uncompressed comma-separated values (CSV)-formatted results are formatted.</p>\"\
     },\
     \"CacheControl\":{\"type\":\"string\"},\
+    \"ChecksumAlgorithm\":{\
+      \"type\":\"string\",\
+      \"enum\":[\
+        \"CRC32\",\
+        \"CRC32C\",\
+        \"SHA1\",\
+        \"SHA256\"\
+      ]\
+    },\
+    \"ChecksumCRC32C\":{\"type\":\"string\"},\
+    \"ChecksumSHA256\":{\"type\":\"string\"},\
     \"CloudFunction\":{\"type\":\"string\"},\
     \"CloudFunctionConfiguration\":{\
       \"type\":\"structure\",\
@@ -1591,6 +1602,14 @@
     \"CompleteMultipartUploadOutput\":{\
       \"type\":\"structure\",\
       \"members\":{\
+        \"ChecksumCRC32C\":{\
+          \"shape\":\"ChecksumCRC32C\",\
+          \"documentation\":\"<p>The base64-encoded, 32-bit CRC32C checksum of the object. For an object uploaded in parts, this is the checksum of the checksums of its parts, followed by the number of parts.</p>\"\
+        },\
+        \"ChecksumSHA256\":{\
+          \"shape\":\"ChecksumSHA256\",\
+          \"documentation\":\"<p>The base64-encoded, 256-bit SHA-256 digest of the object. For an object uploaded in parts, this is the digest of the digests of its parts, followed by the number of parts.</p>\"\
+        },\
         \"Location\":{\
           \"shape\":\"Location\",\
           \"documentation\":\"<p>The URI that identifies the newly created object.</p>\"\
@@ -1698,6 +1717,14 @@
     \"CompletedPart\":{\
       \"type\":\"structure\",\
       \"members\":{\
+        \"ChecksumCRC32C\":{\
+          \"shape\":\"ChecksumCRC32C\",\
+          \"documentation\":\"<p>The base64-encoded, 32-bit CRC32C checksum of the part.</p>\"\
+        },\
+        \"ChecksumSHA256\":{\
+          \"shape\":\"ChecksumSHA256\",\
+          \"documentation\":\"<p>The base64-encoded, 256-bit SHA-256 digest of the part.</p>\"\
+        },\
         \"ETag\":{\
           \"shape\":\"ETag\",\
           \"documentation\":\"<p>Entity tag returned when the part was uploaded.</p>\"\
@@ -2273,6 +2300,12 @@
           \"location\":\"header\",\
           \"locationName\":\"Cache-Control\"\
         },\
+        \"ChecksumAlgorithm\":{\
+          \"shape\":\"ChecksumAlgorithm\",\
+          \"documentation\":\"<p>The algorithm used to create the checksums of the parts and of the object.</p>\",\
+          \"location\":\"header\",\
+          \"locationName\":\"x-amz-checksum-algorithm\"\
+        },\
         \"ContentDisposition\":{\
           \"shape\":\"ContentDisposition\",\
           \"documentation\":\"<p>Specifies presentational information for the object.</p>\",\
@@ -57,7 +57,8 @@
                     URLRequest: (NSMutableURLRequest *) URLRequest {
     
     NSSet *disallowedHeaders = [[NSSet alloc] initWithArray:
-                                @[@"x-amz-acl", @"x-amz-tagging", @"x-amz-storage-class", @"x-amz-server-side-encryption"]];
+                                @[@"x-amz-acl", @"x-amz-tagging", @"x-amz-storage-class", @"x-amz-server-side-encryption",
+                                  @"x-amz-checksum-algorithm"]];
     
     for (NSString *key in requestHeaders) {
         //Do not include custom metadata or custom grants
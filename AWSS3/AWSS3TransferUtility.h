@@ -28,7 +28,8 @@ typedef NS_ENUM(NSInteger, AWSS3TransferUtilityErrorType) {
     AWSS3TransferUtilityErrorServerError,
     AWSS3TransferUtilityErrorLocalFileNotFound,
     AWSS3TransferUtilityErrorBaseDirectoryNotFound,
-    AWSS3TransferUtilityErrorPartialFileNotCreated
+    AWSS3TransferUtilityErrorPartialFileNotCreated,
+    AWSS3TransferUtilityErrorChecksumMismatch
 };
 
 FOUNDATION_EXPORT NSString *const AWSS3TransferUtilityURLSessionDidBecomeInvalidNotification;
@@ -705,6 +706,13 @@ handleEventsForBackgroundURLSession:(NSString *)identifier
  */
 @property (nonatomic, assign) AWSS3BucketAccessStyle preferredAccessStyle;
 
+/**
+ The checksum to compute for transfers. The default is `AWSS3ChecksumAlgorithmUnknown`, which computes none.
+
+ `AWSS3ChecksumAlgorithmCRC32C` and `AWSS3ChecksumAlgorithmSHA256` are supported. Uploads send the checksum of the file or of each part as it is read, and S3 rejects data that does not match it. Multipart uploads also check the checksum S3 reports for the completed object. Downloads ask S3 for the checksum of the object and fail with `AWSS3TransferUtilityErrorChecksumMismatch` if the downloaded file does not match it. Objects uploaded in parts report a checksum of their parts, which downloads cannot check.
+ */
+@property (nonatomic, assign) AWSS3ChecksumAlgorithm checksumAlgorithm;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -21,6 +21,7 @@
 #import "AWSS3CreateMultipartUploadRequest+RequestHeaders.h"
 #import "AWSS3TransferUtilityTasks+Completion.h"
 #import "AWSS3TransferUtility_private.h"
+#import "AWSS3Checksum.h"
 
 #import <AWSCore/AWSFMDB.h>
 #import <AWSCore/AWSSynchronizedMutableDictionary.h>
@@ -358,8 +359,13 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
 - (void) hydrateFromDB:(NSMutableDictionary *) tempMultiPartMasterTaskDictionary
       tempTransferDictionary: (NSMutableDictionary *) tempTransferDictionary
 {
-    //Get All Tasks from DB
+    //Clean up parts whose multipart upload record is gone before reading the rest.
+    [AWSS3TransferUtilityDatabaseHelper deleteOrphanedSubTasksFromDB:_sessionIdentifier databaseQueue:_databaseQueue];
+    
+    //Get All Tasks from DB. Completed parts are left out; each multipart upload loads them when it needs them.
     NSMutableArray *tasks = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:_sessionIdentifier databaseQueue:_databaseQueue];
+    //Transfers that need no more processing are deleted together at the end.
+    NSMutableArray<NSString *> *finishedTransferIDs = [NSMutableArray new];
     
     //Iterate through the tasks and populate transferRequests and Multipart dictionary.
     for( NSMutableDictionary *task in tasks ) {
@@ -372,7 +378,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             //If task is completed, no more processing is required.
             if (transferUtilityUploadTask.status == AWSS3TransferUtilityTransferStatusCompleted ) {
                 [self.completedTaskDictionary setObject:transferUtilityUploadTask forKey:transferUtilityUploadTask.transferID];
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:transferUtilityUploadTask.transferID databaseQueue:self->_databaseQueue];
+                [finishedTransferIDs addObject:transferUtilityUploadTask.transferID];
                 continue;
             }
             //Lodge in temporary Dictionary
@@ -385,7 +391,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             //If task is completed, no more processing is required.
             if (transferUtilityDownloadTask.status == AWSS3TransferUtilityTransferStatusCompleted ) {
                 [self.completedTaskDictionary setObject:transferUtilityDownloadTask forKey:transferUtilityDownloadTask.transferID];
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:transferUtilityDownloadTask.transferID databaseQueue:self->_databaseQueue];
+                [finishedTransferIDs addObject:transferUtilityDownloadTask.transferID];
                 continue;
             }
             //Lodge in temporary Dictionary for linking
@@ -401,7 +407,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
                 transferUtilityMultiPartUploadTask.status == AWSS3TransferUtilityTransferStatusCancelled ||
                 transferUtilityMultiPartUploadTask.status == AWSS3TransferUtilityTransferStatusError) {
                 [self.completedTaskDictionary setObject:transferUtilityMultiPartUploadTask forKey:transferUtilityMultiPartUploadTask.transferID];
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:transferUtilityMultiPartUploadTask.transferID databaseQueue:self->_databaseQueue];
+                [finishedTransferIDs addObject:transferUtilityMultiPartUploadTask.transferID];
                 continue;
             }
             
@@ -416,13 +422,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             //Get the Master MultiPart record from the Dictionary.
             AWSS3TransferUtilityMultiPartUploadTask *multiPartUploadTask = [tempMultiPartMasterTaskDictionary objectForKey:subTask.uploadID];
             if ( !multiPartUploadTask ) {
-                //Couldn't find the multipart upload master record. Must be an orphan part record. Clean up the DB and continue.
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:subTask.transferID databaseQueue:self->_databaseQueue];
-                continue;
-            }
-            //Check if the subTask is is already completed. If it is, add it to the completed parts list, update the progress object and go to the next iteration of the loop
-            if (subTask.status== AWSS3TransferUtilityTransferStatusCompleted ) {
-                [multiPartUploadTask.completedPartsSet addObject:subTask];
+                //The multipart upload has finished. Its parts are deleted with it below.
                 continue;
             }
             
@@ -430,6 +430,8 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             [tempTransferDictionary setObject:subTask forKey:@(sessionTaskID)];
         }
     }
+    
+    [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestsFromDB:finishedTransferIDs databaseQueue:self->_databaseQueue];
 }
 
 - (void) linkTransfersToNSURLSession:(NSMutableDictionary *) tempMultiPartMasterTaskDictionary
@@ -760,6 +762,8 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
     transferUtilityMultiPartUploadTask.uploadID = [task objectForKey:@"multi_part_id"];
     NSNumber *statusValue = [task objectForKey:@"status"];
     transferUtilityMultiPartUploadTask.status = [statusValue intValue];
+    //Loaded from the database on first use.
+    transferUtilityMultiPartUploadTask.completedPartsSet = nil;
     return transferUtilityMultiPartUploadTask;
 }
 
@@ -775,6 +779,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
     subTask.uploadID = [task objectForKey:@"multi_part_id"];
     subTask.transferID = [task objectForKey:@"transfer_id"];
     subTask.totalBytesExpectedToSend = [[task objectForKey:@"content_length"] integerValue];
+    subTask.checksum = [task objectForKey:@"checksum"];
     
     NSNumber *statusValue = [task objectForKey:@"status"];
     subTask.status = [statusValue intValue];
@@ -883,6 +888,22 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
     [expression setValue:contentType forRequestHeader:@"Content-Type"];
     expression.completionHandler = completionHandler;
     
+    //Send the checksum of the file, unless the expression already has one. It is saved with the request headers,
+    //so retries send it again.
+    AWSS3ChecksumAlgorithm checksumAlgorithm = self.transferUtilityConfiguration.checksumAlgorithm;
+    NSString *checksumHeader = [AWSS3Checksum headerNameForAlgorithm:checksumAlgorithm];
+    if ([AWSS3Checksum isSupportedAlgorithm:checksumAlgorithm] && ![self requestHeaders:expression.requestHeaders containHeader:checksumHeader]) {
+        NSError *checksumError = nil;
+        NSString *checksum = [AWSS3Checksum base64ChecksumOfFileAtURL:fileURL algorithm:checksumAlgorithm error:&checksumError];
+        if (!checksum) {
+            if (temporaryFileCreated) {
+                [self removeFile:[fileURL path]];
+            }
+            return [AWSTask taskWithError:checksumError];
+        }
+        [expression setValue:checksum forRequestHeader:checksumHeader];
+    }
+    
     //Create TransferUtility Upload Task
     AWSS3TransferUtilityUploadTask *transferUtilityUploadTask = [AWSS3TransferUtilityUploadTask new];
     transferUtilityUploadTask.nsURLSessionID = self.sessionIdentifier;
@@ -1143,6 +1164,14 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
       [expression setValue:contentType forRequestHeader:@"Content-Type"];
     }
     
+    //The parts are uploaded with checksums of this algorithm. The header is saved with the transfer, so the
+    //algorithm is known when it is resumed.
+    if ([AWSS3Checksum isSupportedAlgorithm:self.transferUtilityConfiguration.checksumAlgorithm]
+        && ![self requestHeaders:expression.requestHeaders containHeader:@"x-amz-checksum-algorithm"]) {
+        [expression setValue:[AWSS3Checksum nameForAlgorithm:self.transferUtilityConfiguration.checksumAlgorithm]
+            forRequestHeader:@"x-amz-checksum-algorithm"];
+    }
+    
     expression.completionHandler = completionHandler;
     
     //Create TransferUtility Multipart Upload Task
@@ -1217,6 +1246,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
         
         AWSDDLogInfo(@"Initiated multipart upload on server: %@", output.uploadId);
         AWSDDLogInfo(@"Concurrency Limit is %@", self.transferUtilityConfiguration.multiPartConcurrencyLimit);
+        NSMutableArray<AWSS3TransferUtilityUploadSubTask *> *createdSubTasks = [NSMutableArray arrayWithCapacity:partCount];
         //Loop through the file and upload the parts one by one
         for (int32_t i = 1; i <= partCount ; i++) {
             NSUInteger dataLength = AWSS3TransferUtilityMultiPartSize;
@@ -1253,9 +1283,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             }
             
             if (!subTaskCreationError) {
-                //Save in Database after the file has been created, so that file can be referenced incase upload is paused and needs to be restarted.
-                [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTaskInDB:transferUtilityMultiPartUploadTask subTask:subTask
-            databaseQueue:self.databaseQueue];
+                [createdSubTasks addObject:subTask];
             } else {
                 //Abort the request, so the server can clean up any partials.
                 [self callAbortMultiPartForUploadTask:transferUtilityMultiPartUploadTask];
@@ -1269,6 +1297,12 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             
         }
         
+        //Save in Database after the files have been created, so that they can be referenced incase upload is paused and needs to be restarted.
+        //The parts are saved in a single transaction.
+        [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:transferUtilityMultiPartUploadTask
+                                                                            subTasks:createdSubTasks
+                                                                       databaseQueue:self.databaseQueue];
+        
         //Start the subTasks
         for(id taskIdentifier in transferUtilityMultiPartUploadTask.inProgressPartsDictionary) {
             AWSS3TransferUtilityUploadSubTask *subTask = [transferUtilityMultiPartUploadTask.inProgressPartsDictionary objectForKey:taskIdentifier];
@@ -1284,11 +1318,12 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
 - (NSString *)createTemporaryFileForPart:(NSString *)fileName
                               partNumber:(long)partNumber
                               dataLength:(NSUInteger)dataLength
+                                checksum:(AWSS3Checksum *)checksum
                                    error:(NSError **)error {
     NSURL *fileURL = [NSURL fileURLWithPath: fileName isDirectory: false];
     NSUInteger offset = (partNumber - 1) * AWSS3TransferUtilityMultiPartSize;
 
-    NSURL *partialFileURL = [self createPartialFile:fileURL offset:offset length:dataLength error:error];
+    NSURL *partialFileURL = [self createPartialFile:fileURL offset:offset length:dataLength checksum:checksum error:error];
     if (*error) {
         NSString *errorMessage = [NSString stringWithFormat:@"Unable to process Part #: %ld", partNumber];
         NSDictionary *userInfo = [NSDictionary dictionaryWithObject:errorMessage
@@ -1306,10 +1341,11 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
 - (nullable NSURL *)createPartialFile:(NSURL *)fileURL
                                offset:(NSUInteger)offset
                                length:(NSUInteger)length
+                             checksum:(nullable AWSS3Checksum *)checksum
                                 error:(NSError * _Nullable *)error {
     NSURL *baseURL = [NSURL URLWithString:self.cacheDirectoryPath];
     AWSDDLogDebug(@"Setting Base URL to Caches Directory: %@", baseURL);
-    return [self createPartialFile:fileURL offset:offset length:length baseURL:baseURL error:error];
+    return [self createPartialFile:fileURL offset:offset length:length baseURL:baseURL checksum:checksum error:error];
 }
 
 - (nullable NSURL *)createPartialFile:(NSURL *)fileURL
@@ -1317,6 +1353,16 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
                                length:(NSUInteger)length
                                baseURL:(NSURL *)baseURL
                                 error:(NSError * _Nullable *)error {
+    return [self createPartialFile:fileURL offset:offset length:length baseURL:baseURL checksum:nil error:error];
+}
+
+//Copies the part to its own file. The checksum, if given, is updated with the bytes as they are copied.
+- (nullable NSURL *)createPartialFile:(NSURL *)fileURL
+                               offset:(NSUInteger)offset
+                               length:(NSUInteger)length
+                              baseURL:(NSURL *)baseURL
+                             checksum:(nullable AWSS3Checksum *)checksum
+                                error:(NSError * _Nullable *)error {
     if (![[NSFileManager defaultManager] fileExistsAtPath:fileURL.path]) {
         NSDictionary *userInfo = @{NSLocalizedDescriptionKey:[NSString stringWithFormat:@"Local file not found: %@", fileURL]};
         *error = [NSError errorWithDomain:AWSS3TransferUtilityErrorDomain
@@ -1389,6 +1435,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             if (*error) {
                 break;
             }
+            [checksum updateWithData:data];
 
             // Write data
             if (@available(iOS 13.0, *)) {
@@ -1429,16 +1476,28 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
        internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAddSubTaskTo
 {
     __block NSError *error = nil;
+    AWSS3ChecksumAlgorithm checksumAlgorithm = [self checksumAlgorithmForRequestHeaders:transferUtilityMultiPartUploadTask.expression.requestHeaders];
     //Create a temporary part file if required.
     if (!(subTask.file || [subTask.file isEqualToString:@""]) || ![[NSFileManager defaultManager] fileExistsAtPath:subTask.file]) {
-        //Create a temporary file for this part.
-        NSString * partFileName = [self createTemporaryFileForPart:transferUtilityMultiPartUploadTask.file partNumber:[subTask.partNumber integerValue] dataLength:subTask.totalBytesExpectedToSend error:&error];
+        //Create a temporary file for this part, computing its checksum while it is copied.
+        AWSS3Checksum *checksum = [[AWSS3Checksum alloc] initWithAlgorithm:checksumAlgorithm];
+        NSString * partFileName = [self createTemporaryFileForPart:transferUtilityMultiPartUploadTask.file partNumber:[subTask.partNumber integerValue] dataLength:subTask.totalBytesExpectedToSend checksum:checksum error:&error];
         if (partFileName == nil)  {
             //Unable to create partFile. Send back error object to indicate that createUploadSubtask failed.
             return error;
         }
         subTask.file = partFileName;
+        subTask.checksum = [checksum base64Digest];
     }
+    else if (!subTask.checksum && [AWSS3Checksum isSupportedAlgorithm:checksumAlgorithm]) {
+        subTask.checksum = [AWSS3Checksum base64ChecksumOfFileAtURL:[NSURL fileURLWithPath:subTask.file]
+                                                          algorithm:checksumAlgorithm
+                                                              error:&error];
+        if (!subTask.checksum) {
+            return error;
+        }
+    }
+    NSString *checksumHeader = subTask.checksum ? [AWSS3Checksum headerNameForAlgorithm:checksumAlgorithm] : nil;
     
     //Create a presignedURL for this part.
     AWSS3GetPreSignedURLRequest *request = [AWSS3GetPreSignedURLRequest new];
@@ -1462,6 +1521,9 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
         contentMD5 = [NSString aws_base64md5FromData: [NSData dataWithContentsOfFile: subTask.file]];
         [request setContentMD5: contentMD5];
     }
+    if (checksumHeader) {
+        [request setValue:subTask.checksum forRequestHeader:checksumHeader];
+    }
 
     [[[self.preSignedURLBuilder getPreSignedURL:request] continueWithBlock:^id(AWSTask *task) {
         error = task.error;
@@ -1480,6 +1542,9 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
         if (contentMD5 != nil) {
             [urlRequest setValue:contentMD5 forHTTPHeaderField:@"Content-MD5"];
         }
+        if (checksumHeader) {
+            [urlRequest setValue:subTask.checksum forHTTPHeaderField:checksumHeader];
+        }
         NSURLSessionUploadTask *nsURLUploadTask = [self getURLSessionUploadTaskWithRequest:urlRequest
                                                                                   fromFile:[NSURL fileURLWithPath:subTask.file]
                                                                                      error:&error];
@@ -1629,6 +1694,12 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
     }
     expression.completionHandler = completionHandler;
     
+    //Ask for the checksum of the object to verify the download with.
+    if ([AWSS3Checksum isSupportedAlgorithm:self.transferUtilityConfiguration.checksumAlgorithm]
+        && ![self requestHeaders:expression.requestHeaders containHeader:@"x-amz-checksum-mode"]) {
+        [expression setValue:@"ENABLED" forRequestHeader:@"x-amz-checksum-mode"];
+    }
+    
     //Create Download Task and set it up.
     AWSS3TransferUtilityDownloadTask *transferUtilityDownloadTask = [AWSS3TransferUtilityDownloadTask new];
     transferUtilityDownloadTask.nsURLSessionID = self.sessionIdentifier;
@@ -1907,12 +1978,22 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
         [tempDictionary setObject:subTask forKey:subTask.partNumber];
     }
     
-    //Compose the request.
+    //Compose the request. The checksums of the parts are sent again, S3 checks them against the uploaded parts.
+    AWSS3ChecksumAlgorithm checksumAlgorithm = [self checksumAlgorithmForRequestHeaders:uploadTask.expression.requestHeaders];
+    NSMutableArray<NSString *> *partChecksums = [NSMutableArray arrayWithCapacity:[tempDictionary count]];
     for(int i = 1; i <= [tempDictionary count]; i++) {
         AWSS3TransferUtilityUploadSubTask *subTask = [tempDictionary objectForKey: [NSNumber numberWithInt:i]];
         AWSS3CompletedPart *completedPart = [AWSS3CompletedPart new];
         completedPart.partNumber = subTask.partNumber;
         completedPart.ETag = subTask.eTag;
+        if (checksumAlgorithm == AWSS3ChecksumAlgorithmCRC32C) {
+            completedPart.checksumCRC32C = subTask.checksum;
+        } else if (checksumAlgorithm == AWSS3ChecksumAlgorithmSHA256) {
+            completedPart.checksumSHA256 = subTask.checksum;
+        }
+        if (subTask.checksum) {
+            [partChecksums addObject:subTask.checksum];
+        }
         [completedParts addObject:completedPart];
     }
     
@@ -1925,7 +2006,41 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
     compReq.uploadId = uploadTask.uploadID;
     compReq.multipartUpload = multipartUpload;
     
-    return [self.s3 completeMultipartUpload:compReq];
+    if (![AWSS3Checksum isSupportedAlgorithm:checksumAlgorithm] || [partChecksums count] != [completedParts count]) {
+        return [self.s3 completeMultipartUpload:compReq];
+    }
+    
+    //Check the checksum S3 reports for the object against the one combined from the parts.
+    NSString *expectedChecksum = [AWSS3Checksum compositeChecksumOfPartChecksums:partChecksums algorithm:checksumAlgorithm];
+    return [[self.s3 completeMultipartUpload:compReq] continueWithSuccessBlock:^id(AWSTask<AWSS3CompleteMultipartUploadOutput *> *task) {
+        NSString *checksum = checksumAlgorithm == AWSS3ChecksumAlgorithmCRC32C ? task.result.checksumCRC32C : task.result.checksumSHA256;
+        if (checksum && ![checksum isEqualToString:expectedChecksum]) {
+            NSString *errorMessage = [NSString stringWithFormat:@"The checksum of the object is [%@], expected [%@]", checksum, expectedChecksum];
+            AWSDDLogError(@"%@", errorMessage);
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferUtilityErrorDomain
+                                                              code:AWSS3TransferUtilityErrorChecksumMismatch
+                                                          userInfo:@{@"Message": errorMessage}]];
+        }
+        return task;
+    }];
+}
+
+- (AWSS3ChecksumAlgorithm)checksumAlgorithmForRequestHeaders:(NSDictionary<NSString *, NSString *> *)requestHeaders {
+    for (NSString *key in requestHeaders) {
+        if ([[key lowercaseString] isEqualToString:@"x-amz-checksum-algorithm"]) {
+            return [AWSS3Checksum algorithmForName:requestHeaders[key]];
+        }
+    }
+    return AWSS3ChecksumAlgorithmUnknown;
+}
+
+- (BOOL)requestHeaders:(NSDictionary<NSString *, NSString *> *)requestHeaders containHeader:(NSString *)header {
+    for (NSString *key in requestHeaders) {
+        if ([key caseInsensitiveCompare:header] == NSOrderedSame) {
+            return YES;
+        }
+    }
+    return NO;
 }
 
 - (AWSTask *) callAbortMultiPartForUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) uploadTask {
@@ -2259,7 +2374,7 @@ didCompleteWithError:(NSError *)error {
                 [[ self callFinishMultiPartForUploadTask:transferUtilityMultiPartUploadTask] continueWithBlock:^id (AWSTask *task) {
                     if (task.error) {
                         AWSDDLogError(@"Error finishing up MultiPartForUpload Task[%@]", task.error);
-                        transferUtilityMultiPartUploadTask.error = error;
+                        transferUtilityMultiPartUploadTask.error = task.error;
                         transferUtilityMultiPartUploadTask.status = AWSS3TransferUtilityTransferStatusError;
                         
                         //Abort the request, so the server can clean up any partials.
@@ -2320,7 +2435,10 @@ didCompleteWithError:(NSError *)error {
             downloadTask.status = AWSS3TransferUtilityTransferStatusError;
         }
         
-        if (downloadTask.error && HTTPResponse) {
+        //A checksum mismatch comes with a successful response and already describes itself, the body is the downloaded data.
+        BOOL isChecksumMismatch = [downloadTask.error.domain isEqualToString:AWSS3TransferUtilityErrorDomain]
+            && downloadTask.error.code == AWSS3TransferUtilityErrorChecksumMismatch;
+        if (downloadTask.error && HTTPResponse && !isChecksumMismatch) {
             if ([self isErrorRetriable:HTTPResponse.statusCode responseFromServer:downloadTask.responseData])  {
                 if (downloadTask.retryCount < self.transferUtilityConfiguration.retryLimit) {
                     AWSDDLogDebug(@"Retry count is below limit and error is retriable. ");
@@ -2535,6 +2653,11 @@ didFinishDownloadingToURL:(NSURL *)location {
         AWSDDLogDebug(@"Unable to find information for task %lu in taskDictionary", (unsigned long)downloadTask.taskIdentifier);
         return;
     }
+    NSError *checksumError = [self verifyChecksumOfDownloadedFile:location response:downloadTask.response];
+    if (checksumError) {
+        transferUtilityTask.error = checksumError;
+        return;
+    }
     if (transferUtilityTask.location) {
         if (![[NSFileManager defaultManager] fileExistsAtPath:[transferUtilityTask.location path]]) {
             NSError *error = nil;
@@ -2554,6 +2677,41 @@ didFinishDownloadingToURL:(NSURL *)location {
     }
 }
 
+//Returns an error if the response has a checksum of the whole object that the downloaded file does not match.
+- (NSError *)verifyChecksumOfDownloadedFile:(NSURL *)location response:(NSURLResponse *)response {
+    if (![response isKindOfClass:[NSHTTPURLResponse class]] || ((NSHTTPURLResponse *)response).statusCode / 100 != 2) {
+        return nil;
+    }
+    NSDictionary *headers = ((NSHTTPURLResponse *)response).allHeaderFields;
+    for (NSNumber *algorithm in @[@(AWSS3ChecksumAlgorithmCRC32C), @(AWSS3ChecksumAlgorithmSHA256)]) {
+        NSString *headerName = [AWSS3Checksum headerNameForAlgorithm:[algorithm integerValue]];
+        NSString *expectedChecksum = nil;
+        for (NSString *key in headers) {
+            if ([key caseInsensitiveCompare:headerName] == NSOrderedSame) {
+                expectedChecksum = headers[key];
+            }
+        }
+        //Objects uploaded in parts have a checksum of the checksums of their parts, e.g. "checksum-3".
+        if (!expectedChecksum || [expectedChecksum containsString:@"-"]) {
+            continue;
+        }
+        NSError *error = nil;
+        NSString *checksum = [AWSS3Checksum base64ChecksumOfFileAtURL:location algorithm:[algorithm integerValue] error:&error];
+        if (!checksum) {
+            return error;
+        }
+        if (![checksum isEqualToString:expectedChecksum]) {
+            NSString *errorMessage = [NSString stringWithFormat:@"The checksum of the downloaded file is [%@], expected [%@]", checksum, expectedChecksum];
+            AWSDDLogError(@"%@", errorMessage);
+            return [NSError errorWithDomain:AWSS3TransferUtilityErrorDomain
+                                       code:AWSS3TransferUtilityErrorChecksumMismatch
+                                   userInfo:@{@"Message": errorMessage}];
+        }
+        return nil;
+    }
+    return nil;
+}
+
 - (void)URLSession:(NSURLSession *)session
       downloadTask:(NSURLSessionDownloadTask *)downloadTask
       didWriteData:(int64_t)bytesWritten
@@ -2597,6 +2755,7 @@ totalBytesExpectedToWrite:(int64_t)totalBytesExpectedToWrite {
         _multiPartConcurrencyLimit = @(AWSS3TransferUtilityMultiPartDefaultConcurrencyLimit);
         _timeoutIntervalForResource = AWSS3TransferUtilityTimeoutIntervalForResource;
         _preferredAccessStyle = AWSS3BucketAccessStyleVirtualHosted;
+        _checksumAlgorithm = AWSS3ChecksumAlgorithmUnknown;
     }
     return self;
 }
@@ -2609,6 +2768,7 @@ totalBytesExpectedToWrite:(int64_t)totalBytesExpectedToWrite {
     configuration.multiPartConcurrencyLimit = self.multiPartConcurrencyLimit;
     configuration.timeoutIntervalForResource = self.timeoutIntervalForResource;
     configuration.preferredAccessStyle = self.preferredAccessStyle;
+    configuration.checksumAlgorithm = self.checksumAlgorithm;
     return configuration;
 }
 
@@ -23,6 +23,19 @@
 NSString *const AWSS3TransferUtilityDatabaseDirectory = @"/com/amazonaws/AWSS3TransferUtility/";
 NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
 
+static NSString *const AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag = @"UPDATE awstransfer "
+@"SET status=:status, etag = :etag, session_task_id = :session_task_id, retry_count = :retry_count "
+@"WHERE transfer_id=:transfer_id and "
+@"      part_number =:part_number ";
+
+static NSString *const AWSS3TransferUtiltyInsertIntoAWSTransfer = @"INSERT INTO awstransfer ("
+@"transfer_id,ns_url_session_id, session_task_id, transfer_type, bucket_name, key, part_number, multi_part_id, etag, file, "
+@"temporary_file_created, content_length, status, retry_count, request_headers, request_parameters, checksum"
+@") VALUES ("
+@":transfer_id,:ns_url_session_id, :session_task_id, :transfer_type, :bucket_name, :key, :part_number, :multi_part_id, :etag, :file, :temporary_file_created, :content_length, "
+@":status, :retry_count, :request_headers, :request_parameters, :checksum"
+@")";
+
 #pragma mark - AWSS3 Transfer Utility Database Functions
 
 @implementation AWSS3TransferUtilityDatabaseHelper
@@ -45,7 +58,13 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     @"status TEXT NOT NULL,"
     @"retry_count INTEGER NOT NULL,"
     @"request_headers TEXT,"
-    @"request_parameters TEXT)";
+    @"request_parameters TEXT,"
+    @"checksum TEXT)";
+    NSString *const AWSS3TransferUtilityAddChecksumColumn = @"ALTER TABLE awstransfer ADD COLUMN checksum TEXT";
+    NSString *const AWSS3TransferUtilityCreateTransferIndex = @"CREATE INDEX IF NOT EXISTS awstransfer_transfer_id "
+    @"ON awstransfer (transfer_id, part_number)";
+    NSString *const AWSS3TransferUtilityCreateSessionIndex = @"CREATE INDEX IF NOT EXISTS awstransfer_ns_url_session_id "
+    @"ON awstransfer (ns_url_session_id, transfer_id, part_number)";
     
     NSString *dbDirPath = [cacheDirectoryPath stringByAppendingString:AWSS3TransferUtilityDatabaseDirectory];
     BOOL fileExistsAtPath = [[NSFileManager defaultManager] fileExistsAtPath:dbDirPath];
@@ -73,6 +92,18 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
         if (! [db executeUpdate: AWSS3TransferUtilityCreateAWSTransfer]) {
             AWSDDLogError(@"Failed to create awstransfer Database table. [%@]", db.lastError);
         }
+        //Databases created by earlier versions have no checksum column.
+        if (![db columnExists:@"checksum" inTableWithName:@"awstransfer"] &&
+            ![db executeUpdate: AWSS3TransferUtilityAddChecksumColumn]) {
+            AWSDDLogError(@"Failed to add checksum column to awstransfer Database table. [%@]", db.lastError);
+        }
+        //Parts are looked up by transfer ID and part number, and recovery reads a session's transfers in that order.
+        if (! [db executeUpdate: AWSS3TransferUtilityCreateTransferIndex]) {
+            AWSDDLogError(@"Failed to create awstransfer transfer index. [%@]", db.lastError);
+        }
+        if (! [db executeUpdate: AWSS3TransferUtilityCreateSessionIndex]) {
+            AWSDDLogError(@"Failed to create awstransfer session index. [%@]", db.lastError);
+        }
     }];
     return databaseQueue;
 }
@@ -99,6 +130,51 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     }];
 }
 
+//Delete the transfer requests with the given transfer IDs in a single transaction
++ (void) deleteTransferRequestsFromDB:(NSArray<NSString *> *) transferIDs
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    if ([transferIDs count] == 0) {
+        return;
+    }
+    NSString *const AWSS3TransferUtilityDeleteTransfer =  @"DELETE FROM awstransfer "
+    @"WHERE transfer_id=:transfer_id";
+    
+    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        for (NSString *transferID in transferIDs) {
+            BOOL result = [db executeUpdate: AWSS3TransferUtilityDeleteTransfer
+                    withParameterDictionary:@{
+                                              @"transfer_id": transferID
+                                              }];
+            if (!result) {
+                AWSDDLogError(@"Failed to delete transfer_request [%@] in Database. [%@]", transferID,
+                              db.lastError);
+                *rollback = YES;
+                return;
+            }
+        }
+    }];
+}
+
+//Delete the multipart upload parts of a session whose multipart upload record is gone
++ (void) deleteOrphanedSubTasksFromDB:(NSString *) nsURLSessionID
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    NSString *const AWSS3TransferUtilityDeleteOrphanedSubTasks = @"DELETE FROM awstransfer "
+    @"WHERE ns_url_session_id=:ns_url_session_id and "
+    @"      transfer_type='MULTI_PART_UPLOAD_SUB_TASK' and "
+    @"      transfer_id NOT IN (SELECT transfer_id FROM awstransfer "
+    @"                          WHERE ns_url_session_id=:ns_url_session_id and transfer_type='MULTI_PART_UPLOAD')";
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        BOOL result = [db executeUpdate:AWSS3TransferUtilityDeleteOrphanedSubTasks
+                withParameterDictionary:@{
+                                          @"ns_url_session_id": nsURLSessionID
+                                          }];
+        if (!result) {
+            AWSDDLogError(@"Failed to delete orphaned subtasks of session [%@] in Database. [%@]", nsURLSessionID,
+                          db.lastError);
+        }
+    }];
+}
+
 //Delete a transfer request given its transfer ID and task Identifier.
 + (void) deleteTransferRequestFromDB:(NSString *) transferID
                       taskIdentifier: (NSUInteger) taskIdentifier
@@ -127,10 +203,6 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
                             status: (AWSS3TransferUtilityTransferStatusType) status
                        retry_count: (NSUInteger) retryCount
                      databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
-    NSString *const AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag = @"UPDATE awstransfer "
-    @"SET status=:status, etag = :etag, session_task_id = :session_task_id, retry_count = :retry_count "
-    @"WHERE transfer_id=:transfer_id and "
-    @"      part_number =:part_number ";
     [databaseQueue inDatabase:^(AWSFMDatabase *db) {
         BOOL result = [db executeUpdate: AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag
                 withParameterDictionary:@{
@@ -149,6 +221,44 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     }];
 }
 
+// update the records of the given subtasks and of the multipart upload itself in a single transaction
++ (void) updateMultiPartUploadRequestInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
+                                 subTasks:(NSArray<AWSS3TransferUtilityUploadSubTask *> *) subTasks
+                            databaseQueue:(AWSFMDatabaseQueue *) databaseQueue {
+    NSMutableArray<NSDictionary *> *parametersList = [NSMutableArray arrayWithCapacity:[subTasks count] + 1];
+    for (AWSS3TransferUtilityUploadSubTask *subTask in subTasks) {
+        [parametersList addObject:@{
+                                    @"transfer_id": subTask.transferID,
+                                    @"session_task_id": @(subTask.taskIdentifier),
+                                    @"etag": subTask.eTag ?: @"",
+                                    @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:subTask.status],
+                                    @"part_number": subTask.partNumber,
+                                    @"retry_count": @(task.retryCount)
+                                    }];
+    }
+    [parametersList addObject:@{
+                                @"transfer_id": task.transferID,
+                                @"session_task_id": @0,
+                                @"etag": @"",
+                                @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:task.status],
+                                @"part_number": @0,
+                                @"retry_count": @(task.retryCount)
+                                }];
+    
+    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        for (NSDictionary *parameters in parametersList) {
+            BOOL result = [db executeUpdate: AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag
+                    withParameterDictionary:parameters];
+            if (!result) {
+                AWSDDLogError(@"Failed to update transfer_request [%@] in Database. [%@]", task.transferID,
+                              db.lastError);
+                *rollback = YES;
+                return;
+            }
+        }
+    }];
+}
+
 
 + (void) insertUploadTransferRequestInDB:(AWSS3TransferUtilityUploadTask *) task
                            databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
@@ -221,23 +331,52 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
 + (void) insertMultiPartUploadRequestSubTaskInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
                                          subTask:(AWSS3TransferUtilityUploadSubTask *) subTask
                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
-    [AWSS3TransferUtilityDatabaseHelper insertTransferRequestInDB:task.transferID
-                                                   nsURLSessionID:task.nsURLSessionID
-                                                   taskIdentifier:@(subTask.taskIdentifier)
-                                                     transferType:subTask.transferType
-                                                           bucket:task.bucket
-                                                              key:task.key
-                                                       partNumber:subTask.partNumber
-                                                      multiPartID:task.uploadID
-                                                             eTag:@""
-                                                             file:subTask.file
-                                             temporaryFileCreated: YES
-                                                    contentLength:@(subTask.totalBytesExpectedToSend)
-                                                           status:subTask.status
-                                                       retryCount:@(0)
-                                               requestHeadersJSON:[self getJSONRepresentation:task.expression.requestHeaders]
-                                            requestParametersJSON:[self getJSONRepresentation:task.expression.requestParameters]
-                                                    databaseQueue:databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                        subTasks:@[subTask]
+                                                                   databaseQueue:databaseQueue];
+}
+
++ (void) insertMultiPartUploadRequestSubTasksInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
+                                         subTasks:(NSArray<AWSS3TransferUtilityUploadSubTask *> *) subTasks
+                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    //The parts share the request headers and parameters of the multipart upload.
+    NSString *requestHeadersJSON = [self getJSONRepresentation:task.expression.requestHeaders];
+    NSString *requestParametersJSON = [self getJSONRepresentation:task.expression.requestParameters];
+    NSMutableArray<NSDictionary *> *parametersList = [NSMutableArray arrayWithCapacity:[subTasks count]];
+    for (AWSS3TransferUtilityUploadSubTask *subTask in subTasks) {
+        NSMutableDictionary *parameters = [[AWSS3TransferUtilityDatabaseHelper transferRequestParameters:task.transferID
+                                                                                 nsURLSessionID:task.nsURLSessionID
+                                                                                 taskIdentifier:@(subTask.taskIdentifier)
+                                                                                   transferType:subTask.transferType
+                                                                                         bucket:task.bucket
+                                                                                            key:task.key
+                                                                                     partNumber:subTask.partNumber
+                                                                                    multiPartID:task.uploadID
+                                                                                           eTag:@""
+                                                                                           file:subTask.file
+                                                                           temporaryFileCreated:YES
+                                                                                  contentLength:@(subTask.totalBytesExpectedToSend)
+                                                                                         status:subTask.status
+                                                                                     retryCount:@(0)
+                                                                             requestHeadersJSON:requestHeadersJSON
+                                                                          requestParametersJSON:requestParametersJSON] mutableCopy];
+        if (subTask.checksum) {
+            parameters[@"checksum"] = subTask.checksum;
+        }
+        [parametersList addObject:parameters];
+    }
+    
+    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        for (NSDictionary *parameters in parametersList) {
+            BOOL result = [db executeUpdate: AWSS3TransferUtiltyInsertIntoAWSTransfer
+                    withParameterDictionary:parameters];
+            if (!result) {
+                AWSDDLogError(@"Failed to save Transfer [%@] in awstransfer database table. [%@]", task.transferID, db.lastError);
+                *rollback = YES;
+                return;
+            }
+        }
+    }];
 }
 
 + (void) insertTransferRequestInDB: (NSString *) transferID
@@ -257,39 +396,25 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
                 requestHeadersJSON: (NSString *) requestHeadersJSON
              requestParametersJSON: (NSString *) requestParametersJSON
                      databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
-    NSString *const AWSS3TransferUtiltyInsertIntoAWSTransfer = @"INSERT INTO awstransfer ("
-    @"transfer_id,ns_url_session_id, session_task_id, transfer_type, bucket_name, key, part_number, multi_part_id, etag, file, "
-    @"temporary_file_created, content_length, status, retry_count, request_headers, request_parameters"
-    @") VALUES ("
-    @":transfer_id,:ns_url_session_id, :session_task_id, :transfer_type, :bucket_name, :key, :part_number, :multi_part_id, :etag, :file, :temporary_file_created, :content_length, "
-    @":status, :retry_count, :request_headers, :request_parameters"
-    @")";
-    
-    NSNumber *tempFileCreated = [NSNumber numberWithInt:0];
-    if (temporaryFileCreated) {
-        tempFileCreated = [NSNumber numberWithInt:1];
-    }
-    
+    NSDictionary *parameters = [AWSS3TransferUtilityDatabaseHelper transferRequestParameters:transferID
+                                                                              nsURLSessionID:nsURLSessionID
+                                                                              taskIdentifier:taskIdentifier
+                                                                                transferType:transferType
+                                                                                      bucket:bucket
+                                                                                         key:key
+                                                                                  partNumber:partNumber
+                                                                                 multiPartID:multiPartID
+                                                                                        eTag:eTag
+                                                                                        file:file
+                                                                        temporaryFileCreated:temporaryFileCreated
+                                                                               contentLength:contentLength
+                                                                                      status:status
+                                                                                  retryCount:retryCount
+                                                                          requestHeadersJSON:requestHeadersJSON
+                                                                       requestParametersJSON:requestParametersJSON];
     [databaseQueue inDatabase:^(AWSFMDatabase *db) {
         BOOL result = [db executeUpdate: AWSS3TransferUtiltyInsertIntoAWSTransfer
-                withParameterDictionary:@{
-                                          @"transfer_id": transferID,
-                                          @"ns_url_session_id": nsURLSessionID,
-                                          @"session_task_id":taskIdentifier,
-                                          @"transfer_type": transferType,
-                                          @"bucket_name": bucket,
-                                          @"key": key,
-                                          @"part_number": partNumber,
-                                          @"multi_part_id": multiPartID,
-                                          @"etag": eTag,
-                                          @"file": [AWSS3TransferUtilityDatabaseHelper relativePathFromAbsolutePath:file],
-                                          @"temporary_file_created": tempFileCreated,
-                                          @"content_length": contentLength,
-                                          @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:status],
-                                          @"request_headers": requestHeadersJSON,
-                                          @"request_parameters": requestParametersJSON,
-                                          @"retry_count": retryCount
-                                          }];
+                withParameterDictionary:parameters];
         
         if (!result) {
             AWSDDLogError(@"Failed to save Transfer [%@] in awstransfer database table. [%@]", transferID, db.lastError);
@@ -297,14 +422,58 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     }];
 }
 
++ (NSDictionary *) transferRequestParameters: (NSString *) transferID
+                              nsURLSessionID: (NSString *) nsURLSessionID
+                              taskIdentifier: (NSNumber *) taskIdentifier
+                                transferType: (NSString *) transferType
+                                      bucket: (NSString *) bucket
+                                         key: (NSString *) key
+                                  partNumber: (NSNumber *) partNumber
+                                 multiPartID: (NSString *) multiPartID
+                                        eTag: (NSString *) eTag
+                                        file: (NSString *) file
+                        temporaryFileCreated: (BOOL) temporaryFileCreated
+                               contentLength: (NSNumber *) contentLength
+                                      status: (AWSS3TransferUtilityTransferStatusType) status
+                                  retryCount: (NSNumber *) retryCount
+                          requestHeadersJSON: (NSString *) requestHeadersJSON
+                       requestParametersJSON: (NSString *) requestParametersJSON {
+    NSNumber *tempFileCreated = [NSNumber numberWithInt:0];
+    if (temporaryFileCreated) {
+        tempFileCreated = [NSNumber numberWithInt:1];
+    }
+    
+    return @{
+             @"transfer_id": transferID,
+             @"ns_url_session_id": nsURLSessionID,
+             @"session_task_id":taskIdentifier,
+             @"transfer_type": transferType,
+             @"bucket_name": bucket,
+             @"key": key,
+             @"part_number": partNumber,
+             @"multi_part_id": multiPartID,
+             @"etag": eTag,
+             @"file": [AWSS3TransferUtilityDatabaseHelper relativePathFromAbsolutePath:file],
+             @"temporary_file_created": tempFileCreated,
+             @"content_length": contentLength,
+             @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:status],
+             @"request_headers": requestHeadersJSON,
+             @"request_parameters": requestParametersJSON,
+             @"retry_count": retryCount,
+             @"checksum": [NSNull null]
+             };
+}
+
 + (NSMutableArray *) getTransferTaskDataFromDB:(NSString *)nsURLSessionID
                                  databaseQueue: (AWSFMDatabaseQueue *) databaseQueue
 {
     NSString *const AWSS3TransferUtilityQueryAWSTransfer = @"Select transfer_id, session_task_id, "
     @"transfer_type, bucket_name, key, part_number, multi_part_id, etag, file, temporary_file_created, content_length, "
-    @"status, retry_count, request_headers, request_parameters "
+    @"status, retry_count, request_headers, request_parameters, checksum "
     @"From awstransfer "
-    @"Where ns_url_session_id=:ns_url_session_id order by transfer_id, part_number";
+    @"Where ns_url_session_id=:ns_url_session_id and "
+    @"      not (transfer_type='MULTI_PART_UPLOAD_SUB_TASK' and status='COMPLETED') "
+    @"order by transfer_id, part_number";
     
     NSMutableArray *tasks = [NSMutableArray new];
     //Read from DB
@@ -326,12 +495,16 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
             [transfer setObject:[rs stringForColumn:@"etag"] forKey:@"etag"];
             [transfer setObject:[AWSS3TransferUtilityDatabaseHelper absolutePathFromRelativePath:[rs stringForColumn:@"file"]] forKey:@"file"];
             [transfer setObject:@([rs intForColumn:@"temporary_file_created"]) forKey:@"temporary_file_created"];
-            [transfer setObject:@([rs intForColumn:@"content_length"]) forKey:@"content_length"];
+            [transfer setObject:@([rs longLongIntForColumn:@"content_length"]) forKey:@"content_length"];
             [transfer setObject:@([rs intForColumn:@"retry_count"]) forKey:@"retry_count"];
             [transfer setObject:[rs stringForColumn:@"request_headers"] forKey:@"request_headers"];
             [transfer setObject:[rs stringForColumn:@"request_parameters"] forKey:@"request_parameters"];
             NSNumber *statusValue = [ NSNumber numberWithInteger:[AWSS3TransferUtilityDatabaseHelper getEnumRepresentation:[rs stringForColumn:@"status"]]];
             [transfer setObject: statusValue forKey:@"status"];
+            NSString *checksum = [rs stringForColumn:@"checksum"];
+            if (checksum) {
+                [transfer setObject:checksum forKey:@"checksum"];
+            }
             [tasks addObject:transfer];
         }
         rs = nil;
@@ -339,6 +512,40 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     return tasks;
 }
 
+//Completed parts are not part of the recovered transfers. A multipart upload loads them when it needs them.
++ (NSMutableSet<AWSS3TransferUtilityUploadSubTask *> *) getCompletedPartsFromDB:(NSString *) transferID
+                                                                  databaseQueue:(AWSFMDatabaseQueue *) databaseQueue {
+    NSString *const AWSS3TransferUtilityQueryCompletedParts = @"Select session_task_id, part_number, multi_part_id, etag, file, content_length, checksum "
+    @"From awstransfer "
+    @"Where transfer_id=:transfer_id and "
+    @"      transfer_type='MULTI_PART_UPLOAD_SUB_TASK' and "
+    @"      status='COMPLETED'";
+    
+    NSMutableSet<AWSS3TransferUtilityUploadSubTask *> *completedParts = [NSMutableSet new];
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        AWSFMResultSet *rs = [db executeQuery:AWSS3TransferUtilityQueryCompletedParts
+                      withParameterDictionary:@{
+                                                @"transfer_id": transferID
+                                                }];
+        while ([rs next]) {
+            AWSS3TransferUtilityUploadSubTask *subTask = [AWSS3TransferUtilityUploadSubTask new];
+            subTask.transferID = transferID;
+            subTask.transferType = @"MULTI_PART_UPLOAD_SUB_TASK";
+            subTask.taskIdentifier = [rs intForColumn:@"session_task_id"];
+            subTask.partNumber = @([rs intForColumn:@"part_number"]);
+            subTask.uploadID = [rs stringForColumn:@"multi_part_id"];
+            subTask.eTag = [rs stringForColumn:@"etag"];
+            subTask.file = [AWSS3TransferUtilityDatabaseHelper absolutePathFromRelativePath:[rs stringForColumn:@"file"]];
+            subTask.totalBytesExpectedToSend = [rs longLongIntForColumn:@"content_length"];
+            subTask.totalBytesSent = subTask.totalBytesExpectedToSend;
+            subTask.checksum = [rs stringForColumn:@"checksum"];
+            subTask.status = AWSS3TransferUtilityTransferStatusCompleted;
+            [completedParts addObject:subTask];
+        }
+        rs = nil;
+    }];
+    return completedParts;
+}
 
 + (NSString *) getJSONRepresentation: (NSDictionary *) dict {
     NSError *error = nil;
@@ -139,6 +139,20 @@
     return _expression;
 }
 
+- (NSMutableSet<AWSS3TransferUtilityUploadSubTask *> *)completedPartsSet {
+    @synchronized(self) {
+        //A recovered multipart upload reads its completed parts from the database the first time they are needed.
+        if (!_completedPartsSet && self.transferID) {
+            _completedPartsSet = [AWSS3TransferUtilityDatabaseHelper getCompletedPartsFromDB:self.transferID
+                                                                               databaseQueue:self.databaseQueue];
+        }
+        if (!_completedPartsSet) {
+            _completedPartsSet = [NSMutableSet new];
+        }
+        return _completedPartsSet;
+    }
+}
+
 - (void)cancel {
     self.cancelled = YES;
     self.status = AWSS3TransferUtilityTransferStatusCancelled;
@@ -161,27 +175,16 @@
         return;
     }
     
-    for (NSNumber *key in [self.inProgressPartsDictionary allKeys]) {
-        AWSS3TransferUtilityUploadSubTask *subTask = [self.inProgressPartsDictionary objectForKey:key];
+    NSArray<AWSS3TransferUtilityUploadSubTask *> *subTasks = [self.inProgressPartsDictionary allValues];
+    for (AWSS3TransferUtilityUploadSubTask *subTask in subTasks) {
         subTask.status = AWSS3TransferUtilityTransferStatusInProgress;
-        [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:subTask.transferID
-                                                           partNumber:subTask.partNumber
-                                                       taskIdentifier:subTask.taskIdentifier
-                                                                 eTag:subTask.eTag
-                                                               status:subTask.status
-                                                          retry_count:self.retryCount
-                                                        databaseQueue:self.databaseQueue];
         [subTask.sessionTask resume];
     }
     self.status = AWSS3TransferUtilityTransferStatusInProgress;
-    //Update the Master Record
-    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:self.transferID
-                                                       partNumber:@0
-                                                   taskIdentifier:0
-                                                             eTag:@""
-                                                           status:self.status
-                                                      retry_count:self.retryCount
-                                                    databaseQueue:self.databaseQueue];
+    //Update the subtasks and the Master Record
+    [AWSS3TransferUtilityDatabaseHelper updateMultiPartUploadRequestInDB:self
+                                                                subTasks:subTasks
+                                                           databaseQueue:self.databaseQueue];
 }
 
 - (void)suspend {
@@ -190,28 +193,16 @@
         return;
     }
     
-    for (NSNumber *key in [self.inProgressPartsDictionary allKeys]) {
-        AWSS3TransferUtilityUploadSubTask *subTask = [self.inProgressPartsDictionary objectForKey:key];
+    NSArray<AWSS3TransferUtilityUploadSubTask *> *subTasks = [self.inProgressPartsDictionary allValues];
+    for (AWSS3TransferUtilityUploadSubTask *subTask in subTasks) {
         [subTask.sessionTask suspend];
         subTask.status = AWSS3TransferUtilityTransferStatusPaused;
-        
-        [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:subTask.transferID
-                                                           partNumber:subTask.partNumber
-                                                       taskIdentifier:subTask.taskIdentifier
-                                                                 eTag:subTask.eTag
-                                                               status:subTask.status
-                                                          retry_count:self.retryCount
-                                                        databaseQueue:self.databaseQueue];
     }
     self.status = AWSS3TransferUtilityTransferStatusPaused;
-    //Update the Master Record
-    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:self.transferID
-                                                       partNumber:@0
-                                                   taskIdentifier:0
-                                                             eTag:@""
-                                                           status:self.status
-                                                      retry_count:self.retryCount
-                                                    databaseQueue:self.databaseQueue];
+    //Update the subtasks and the Master Record
+    [AWSS3TransferUtilityDatabaseHelper updateMultiPartUploadRequestInDB:self
+                                                                subTasks:subTasks
+                                                           databaseQueue:self.databaseQueue];
 }
 
 -(void) setCompletionHandler:(AWSS3TransferUtilityMultiPartUploadCompletionHandlerBlock)completionHandler {
@@ -85,6 +85,8 @@
 @property NSString *transferID;
 @property AWSS3TransferUtilityTransferStatusType status;
 @property NSString *uploadID;
+//The base64 encoded checksum of the part, if the multipart upload has a checksum algorithm.
+@property (copy) NSString *checksum;
 
 @end
 
@@ -153,6 +155,12 @@
                       taskIdentifier: (NSUInteger) taskIdentifier
                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
 
++ (void) deleteTransferRequestsFromDB:(NSArray<NSString *> *) transferIDs
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) deleteOrphanedSubTasksFromDB:(NSString *) nsURLSessionID
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
 + (void) updateTransferRequestInDB: (NSString *) transferID
                         partNumber: (NSNumber *) partNumber
                     taskIdentifier: (NSUInteger) taskIdentifier
@@ -161,6 +169,10 @@
                        retry_count: (NSUInteger) retryCount
                      databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
 
++ (void) updateMultiPartUploadRequestInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
+                                 subTasks:(NSArray<AWSS3TransferUtilityUploadSubTask *> *) subTasks
+                            databaseQueue:(AWSFMDatabaseQueue *) databaseQueue;
+
 + (void) insertUploadTransferRequestInDB:(AWSS3TransferUtilityUploadTask *) task
                              databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
 
@@ -174,9 +186,16 @@
                                          subTask:(AWSS3TransferUtilityUploadSubTask *) subTask
                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
 
++ (void) insertMultiPartUploadRequestSubTasksInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
+                                         subTasks:(NSArray<AWSS3TransferUtilityUploadSubTask *> *) subTasks
+                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
 + (NSMutableArray *) getTransferTaskDataFromDB:(NSString *)nsURLSessionID
                                  databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
 
++ (NSMutableSet<AWSS3TransferUtilityUploadSubTask *> *) getCompletedPartsFromDB:(NSString *) transferID
+                                                                  databaseQueue:(AWSFMDatabaseQueue *) databaseQueue;
+
 + (NSString *) getJSONRepresentation: (NSDictionary *) dict;
 + (NSDictionary*) getDictionaryFromJson: (NSString *)json;
 
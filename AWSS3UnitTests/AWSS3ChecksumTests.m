@@ -0,0 +1,180 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSS3.h"
+#import "AWSS3Checksum.h"
+#import "AWSS3CreateMultipartUploadRequest+RequestHeaders.h"
+
+static NSUInteger const AWSS3ChecksumTestsBenchmarkSize = 64 * 1024 * 1024;
+
+@interface AWSS3TransferUtility()
+
+- (nullable NSURL *)createPartialFile:(NSURL *)fileURL
+                               offset:(NSUInteger)offset
+                               length:(NSUInteger)length
+                              baseURL:(NSURL *)baseURL
+                             checksum:(nullable AWSS3Checksum *)checksum
+                                error:(NSError **)error;
+
+@end
+
+@interface AWSS3ChecksumTests : XCTestCase
+
+@end
+
+@implementation AWSS3ChecksumTests
+
++ (NSData *)dataOfLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    for (NSUInteger i = 0; i < length; i++) {
+        bytes[i] = (uint8_t)(i * 31 + 7);
+    }
+    return data;
+}
+
++ (NSString *)checksumOfData:(NSData *)data algorithm:(AWSS3ChecksumAlgorithm)algorithm {
+    AWSS3Checksum *checksum = [[AWSS3Checksum alloc] initWithAlgorithm:algorithm];
+    [checksum updateWithData:data];
+    return [checksum base64Digest];
+}
+
+- (void)testKnownValues {
+    NSData *data = [@"123456789" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertEqual(AWSS3CRC32C(0, data.bytes, data.length), 0xE3069283);
+    XCTAssertEqual(AWSS3CRC32CPortable(0, data.bytes, data.length), 0xE3069283);
+    XCTAssertEqualObjects([[self class] checksumOfData:data algorithm:AWSS3ChecksumAlgorithmCRC32C], @"4waSgw==");
+
+    XCTAssertEqualObjects([[self class] checksumOfData:[@"abc" dataUsingEncoding:NSUTF8StringEncoding] algorithm:AWSS3ChecksumAlgorithmSHA256],
+                          @"ungWv48Bz+pBQUDeXa4iI7ADYaOWF3qctBD/YfIAFa0=");
+    XCTAssertEqualObjects([[self class] checksumOfData:[NSData data] algorithm:AWSS3ChecksumAlgorithmCRC32C], @"AAAAAA==");
+
+    XCTAssertNil([[AWSS3Checksum alloc] initWithAlgorithm:AWSS3ChecksumAlgorithmSHA1]);
+    XCTAssertNil([[AWSS3Checksum alloc] initWithAlgorithm:AWSS3ChecksumAlgorithmUnknown]);
+    XCTAssertEqualObjects([AWSS3Checksum headerNameForAlgorithm:AWSS3ChecksumAlgorithmCRC32C], @"x-amz-checksum-crc32c");
+    XCTAssertEqual([AWSS3Checksum algorithmForName:@"sha256"], AWSS3ChecksumAlgorithmSHA256);
+    XCTAssertEqual([AWSS3Checksum algorithmForName:nil], AWSS3ChecksumAlgorithmUnknown);
+}
+
+- (void)testIncrementalUpdatesMatchOneUpdate {
+    NSData *data = [[self class] dataOfLength:100003];
+    uint32_t crc = 0;
+    // Uneven chunks start the hardware and table driven loops at every alignment.
+    for (NSUInteger offset = 0, length = 1; offset < data.length; offset += length, length = length * 2 + 1) {
+        length = MIN(length, data.length - offset);
+        crc = AWSS3CRC32C(crc, (const uint8_t *)data.bytes + offset, length);
+    }
+    XCTAssertEqual(crc, AWSS3CRC32CPortable(0, data.bytes, data.length));
+    XCTAssertEqual(AWSS3CRC32C(0, data.bytes, data.length), AWSS3CRC32CPortable(0, data.bytes, data.length));
+
+    for (NSNumber *algorithm in @[@(AWSS3ChecksumAlgorithmCRC32C), @(AWSS3ChecksumAlgorithmSHA256)]) {
+        AWSS3Checksum *checksum = [[AWSS3Checksum alloc] initWithAlgorithm:[algorithm integerValue]];
+        [checksum updateWithData:[data subdataWithRange:NSMakeRange(0, 5)]];
+        [checksum updateWithData:[data subdataWithRange:NSMakeRange(5, data.length - 5)]];
+        XCTAssertEqualObjects([checksum base64Digest], [[self class] checksumOfData:data algorithm:[algorithm integerValue]]);
+    }
+}
+
+- (void)testCompositeChecksum {
+    NSData *first = [[self class] dataOfLength:1000];
+    NSData *second = [@"123456789" dataUsingEncoding:NSUTF8StringEncoding];
+    NSArray<NSString *> *partChecksums = @[[[self class] checksumOfData:first algorithm:AWSS3ChecksumAlgorithmCRC32C],
+                                           [[self class] checksumOfData:second algorithm:AWSS3ChecksumAlgorithmCRC32C]];
+
+    NSMutableData *digests = [NSMutableData new];
+    for (NSString *partChecksum in partChecksums) {
+        [digests appendData:[[NSData alloc] initWithBase64EncodedString:partChecksum options:kNilOptions]];
+    }
+    NSString *expected = [NSString stringWithFormat:@"%@-2", [[self class] checksumOfData:digests algorithm:AWSS3ChecksumAlgorithmCRC32C]];
+    XCTAssertEqualObjects([AWSS3Checksum compositeChecksumOfPartChecksums:partChecksums algorithm:AWSS3ChecksumAlgorithmCRC32C], expected);
+    XCTAssertNil([AWSS3Checksum compositeChecksumOfPartChecksums:@[@"not base64!"] algorithm:AWSS3ChecksumAlgorithmCRC32C]);
+}
+
+- (void)testPartChecksumIsComputedWhileCopying {
+    NSURL *directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+    NSURL *fileURL = [directoryURL URLByAppendingPathComponent:@"file"];
+    NSData *data = [[self class] dataOfLength:3 * 1024 * 1024 + 17];
+    XCTAssertTrue([data writeToURL:fileURL atomically:YES]);
+
+    AWSS3TransferUtility *transferUtility = [AWSS3TransferUtility defaultS3TransferUtility];
+    AWSS3Checksum *checksum = [[AWSS3Checksum alloc] initWithAlgorithm:AWSS3ChecksumAlgorithmSHA256];
+    NSError *error = nil;
+    NSURL *partURL = [transferUtility createPartialFile:fileURL
+                                                 offset:1024 * 1024
+                                                 length:2 * 1024 * 1024
+                                                baseURL:directoryURL
+                                               checksum:checksum
+                                                  error:&error];
+    XCTAssertNil(error);
+    NSData *part = [data subdataWithRange:NSMakeRange(1024 * 1024, 2 * 1024 * 1024)];
+    XCTAssertEqualObjects([NSData dataWithContentsOfURL:partURL], part);
+    XCTAssertEqualObjects([checksum base64Digest], [[self class] checksumOfData:part algorithm:AWSS3ChecksumAlgorithmSHA256]);
+    XCTAssertEqualObjects([AWSS3Checksum base64ChecksumOfFileAtURL:partURL algorithm:AWSS3ChecksumAlgorithmSHA256 error:&error],
+                          [checksum base64Digest]);
+
+    XCTAssertNil([AWSS3Checksum base64ChecksumOfFileAtURL:[directoryURL URLByAppendingPathComponent:@"missing"]
+                                                algorithm:AWSS3ChecksumAlgorithmCRC32C
+                                                    error:&error]);
+    XCTAssertNotNil(error);
+
+    [[NSFileManager defaultManager] removeItemAtURL:directoryURL error:nil];
+}
+
+- (void)testChecksumAlgorithmHeaderIsPropagated {
+    AWSS3CreateMultipartUploadRequest *uploadRequest = [AWSS3CreateMultipartUploadRequest new];
+    [AWSS3CreateMultipartUploadRequest propagateHeaderInformation:uploadRequest
+                                                   requestHeaders:@{@"x-amz-checksum-algorithm": @"CRC32C"}];
+    XCTAssertEqual(uploadRequest.checksumAlgorithm, AWSS3ChecksumAlgorithmCRC32C);
+
+    AWSS3TransferUtilityConfiguration *configuration = [AWSS3TransferUtilityConfiguration new];
+    XCTAssertEqual(configuration.checksumAlgorithm, AWSS3ChecksumAlgorithmUnknown);
+    configuration.checksumAlgorithm = AWSS3ChecksumAlgorithmSHA256;
+    XCTAssertEqual([configuration copy].checksumAlgorithm, AWSS3ChecksumAlgorithmSHA256);
+}
+
+#pragma mark - Performance
+
+- (void)measureThroughput:(void (^)(NSData *data))block name:(NSString *)name {
+    NSData *data = [[self class] dataOfLength:AWSS3ChecksumTestsBenchmarkSize];
+    [self measureBlock:^{
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        block(data);
+        CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - start;
+        NSLog(@"%@: %.0f MB/s", name, AWSS3ChecksumTestsBenchmarkSize / elapsed / (1024 * 1024));
+    }];
+}
+
+- (void)testCRC32CPerformance {
+    NSLog(@"CRC32C hardware accelerated: %@", AWSS3Checksum.isHardwareAccelerated ? @"YES" : @"NO");
+    [self measureThroughput:^(NSData *data) {
+        XCTAssertNotEqual(AWSS3CRC32C(0, data.bytes, data.length), 0);
+    } name:@"CRC32C"];
+}
+
+- (void)testCRC32CPortablePerformance {
+    [self measureThroughput:^(NSData *data) {
+        XCTAssertNotEqual(AWSS3CRC32CPortable(0, data.bytes, data.length), 0);
+    } name:@"CRC32C (table driven)"];
+}
+
+- (void)testSHA256Performance {
+    [self measureThroughput:^(NSData *data) {
+        XCTAssertNotNil([[self class] checksumOfData:data algorithm:AWSS3ChecksumAlgorithmSHA256]);
+    } name:@"SHA-256"];
+}
+
+@end
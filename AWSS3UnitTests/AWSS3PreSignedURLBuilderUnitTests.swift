@@ -147,6 +147,175 @@ final class AWSS3PreSignedURLBuilderUnitTests: XCTestCase {
         }
         waitForExpectations(timeout: 1)
     }
+
+    private func preSignedURLs(
+        forKeys keys: [String],
+        request: AWSS3GetPreSignedURLRequest
+    ) -> [URL] {
+        let task = builder.getPreSignedURLs(forKeys: keys, request: request)
+        task.waitUntilFinished()
+        XCTAssertNil(task.error)
+        return task.result as? [URL] ?? []
+    }
+
+    private func queryValue(_ name: String, in url: URL) -> String? {
+        URLComponents(url: url, resolvingAgainstBaseURL: false)?
+            .queryItems?
+            .first { $0.name == name }?
+            .value
+    }
+
+    /// Signs the unsigned part of `presignedURL` with `AWSSignatureV4Signer`, using the date and expiration in `presignedURL`.
+    private func referenceSignature(
+        for presignedURL: URL,
+        request: AWSS3GetPreSignedURLRequest
+    ) -> String? {
+        var components = URLComponents(url: presignedURL, resolvingAgainstBaseURL: false)!
+        components.percentEncodedQuery = nil
+        var urlRequest = URLRequest(url: components.url!)
+        urlRequest.httpMethod = "GET"
+        urlRequest.allHTTPHeaderFields = request.requestHeaders
+
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.timeZone = TimeZone(identifier: "UTC")
+        formatter.dateFormat = "yyyyMMdd'T'HHmmss'Z'"
+        let date = formatter.date(from: queryValue("X-Amz-Date", in: presignedURL)!)!
+        let expireDuration = Int32(queryValue("X-Amz-Expires", in: presignedURL)!)!
+
+        let task = AWSSignatureV4Signer.sigV4SignedURL(
+            with: urlRequest,
+            credentialProvider: self,
+            regionName: "us-east-1",
+            serviceName: "s3",
+            date: date,
+            expireDuration: expireDuration,
+            signBody: false,
+            signSessionToken: true
+        )
+        task.waitUntilFinished()
+        guard let signedURL = task.result as URL? else {
+            return nil
+        }
+        return queryValue("X-Amz-Signature", in: signedURL)
+    }
+
+    /// Given: several keys, including keys that need percent-encoding
+    /// When: `AWSS3PreSignedURLBuilder.getPreSignedURLs(forKeys:request:)` is invoked
+    /// Then: Each URL has the path of its key and the signature `AWSSignatureV4Signer` computes for that path.
+    func testPreSignedURLsForKeys_matchSignerForEachKey() {
+        let keys = ["photo.jpg", "folder/sub folder/file name.txt", "unicode/ファイル.png", "reserved!*'();:@&=+$,?#[]"]
+        for style in [AWSS3BucketAccessStyle.virtualHosted, .path] {
+            let request = createRequest(bucket: "batchbucket", key: "", preferredAccessStyle: style)
+            let urls = preSignedURLs(forKeys: keys, request: request)
+            XCTAssertEqual(urls.count, keys.count)
+
+            for (key, url) in zip(keys, urls) {
+                let components = URLComponents(url: url, resolvingAgainstBaseURL: false)
+                let expectedPath = style == .path ? "/batchbucket/\(key)" : "/\(key)"
+                XCTAssertEqual(components?.path, expectedPath)
+                XCTAssertEqual(queryValue("X-Amz-Security-Token", in: url), "sessionKey")
+                XCTAssertNotNil(queryValue("X-Amz-Signature", in: url))
+                XCTAssertEqual(queryValue("X-Amz-Signature", in: url), referenceSignature(for: url, request: request), key)
+            }
+        }
+    }
+
+    /// Given: an empty key among the keys
+    /// When: `AWSS3PreSignedURLBuilder.getPreSignedURLs(forKeys:request:)` is invoked
+    /// Then: The task fails with `.keyNameIsNil` and no URLs are returned.
+    func testPreSignedURLsForKeys_withEmptyKey() {
+        let request = createRequest(bucket: "batchbucket", key: "", preferredAccessStyle: .virtualHosted)
+        let task = builder.getPreSignedURLs(forKeys: ["a", ""], request: request)
+        task.waitUntilFinished()
+        XCTAssertNil(task.result)
+        XCTAssertEqual((task.error as NSError?)?.domain, AWSS3PresignedURLErrorDomain)
+        XCTAssertEqual((task.error as NSError?)?.code, AWSS3PresignedURLErrorType.keyNameIsNil.rawValue)
+    }
+
+    /// Given: a builder with `preSignedURLCacheTolerance` set
+    /// When: the same key is requested again with a later expiration date
+    /// Then: The cached URL is returned while it expires within the tolerance of the requested date, and a new one otherwise.
+    func testPreSignedURLCache() {
+        builder.preSignedURLCacheTolerance = 300
+        let request = createRequest(bucket: "cachebucket", key: "cached", preferredAccessStyle: .virtualHosted)
+        let first = preSignedURLs(forKeys: ["cached"], request: request)[0]
+        let firstExpires = Int(queryValue("X-Amz-Expires", in: first)!)!
+        XCTAssertGreaterThan(firstExpires, 3500)
+
+        request.expires = Date().addingTimeInterval(3700)
+        XCTAssertEqual(preSignedURLs(forKeys: ["cached"], request: request)[0], first)
+
+        let singleTask = builder.getPreSignedURL(request)
+        singleTask.waitUntilFinished()
+        XCTAssertEqual(singleTask.result as URL?, first)
+
+        // The cached URL would expire long before this.
+        request.expires = Date().addingTimeInterval(7200)
+        XCTAssertGreaterThan(Int(queryValue("X-Amz-Expires", in: preSignedURLs(forKeys: ["cached"], request: request)[0])!)!, 7000)
+
+        // The cached URL would outlive this.
+        request.expires = Date().addingTimeInterval(600)
+        XCTAssertLessThanOrEqual(Int(queryValue("X-Amz-Expires", in: preSignedURLs(forKeys: ["cached"], request: request)[0])!)!, 600)
+
+        // Other keys are not affected.
+        request.expires = Date().addingTimeInterval(3700)
+        XCTAssertGreaterThan(Int(queryValue("X-Amz-Expires", in: preSignedURLs(forKeys: ["other"], request: request)[0])!)!, 3600)
+
+        builder.removeAllCachedPreSignedURLs()
+        XCTAssertGreaterThan(Int(queryValue("X-Amz-Expires", in: preSignedURLs(forKeys: ["cached"], request: request)[0])!)!, 3600)
+    }
+
+    /// Given: a builder without `preSignedURLCacheTolerance`
+    /// When: the same key is requested twice
+    /// Then: Every URL is signed for the requested expiration date.
+    func testPreSignedURLCache_disabledByDefault() {
+        let request = createRequest(bucket: "cachebucket", key: "cached", preferredAccessStyle: .virtualHosted)
+        _ = preSignedURLs(forKeys: ["cached"], request: request)
+        request.expires = Date().addingTimeInterval(3700)
+        XCTAssertGreaterThan(Int(queryValue("X-Amz-Expires", in: preSignedURLs(forKeys: ["cached"], request: request)[0])!)!, 3600)
+    }
+
+    // MARK: - Performance
+
+    private let performanceKeys = (0..<1000).map { "images/\($0 / 100)/photo \($0).jpg" }
+
+    private func measureURLsPerSecond(_ block: () -> Int) {
+        measure {
+            let start = Date()
+            let count = block()
+            XCTAssertEqual(count, performanceKeys.count)
+            print(String(format: "%.0f URLs/sec", Double(count) / Date().timeIntervalSince(start)))
+        }
+    }
+
+    func testPerformance_getPreSignedURLOneKeyAtATime() {
+        let request = createRequest(bucket: "perfbucket", key: "", preferredAccessStyle: .virtualHosted)
+        measureURLsPerSecond {
+            performanceKeys.filter { key in
+                request.key = key
+                let task = builder.getPreSignedURL(request)
+                task.waitUntilFinished()
+                return task.result != nil
+            }.count
+        }
+    }
+
+    func testPerformance_getPreSignedURLsForKeys() {
+        let request = createRequest(bucket: "perfbucket", key: "", preferredAccessStyle: .virtualHosted)
+        measureURLsPerSecond {
+            preSignedURLs(forKeys: performanceKeys, request: request).count
+        }
+    }
+
+    func testPerformance_getPreSignedURLsForKeysFromCache() {
+        builder.preSignedURLCacheTolerance = 300
+        let request = createRequest(bucket: "perfbucket", key: "", preferredAccessStyle: .virtualHosted)
+        _ = preSignedURLs(forKeys: performanceKeys, request: request)
+        measureURLsPerSecond {
+            preSignedURLs(forKeys: performanceKeys, request: request).count
+        }
+    }
 }
 
 extension AWSS3PreSignedURLBuilderUnitTests: AWSCredentialsProvider {
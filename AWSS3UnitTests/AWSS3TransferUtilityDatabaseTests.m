@@ -0,0 +1,220 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSFMDB.h>
+#import "AWSTestUtility.h"
+#import "AWSS3TransferUtility.h"
+#import "AWSS3TransferUtilityDatabaseHelper.h"
+#import "AWSS3TransferUtility_private.h"
+
+@interface AWSS3TransferUtility()
+
+@property (strong, nonatomic) NSString *sessionIdentifier;
+@property (strong, nonatomic) AWSFMDatabaseQueue *databaseQueue;
+
+- (void) hydrateFromDB:(NSMutableDictionary *) tempMultiPartMasterTaskDictionary
+tempTransferDictionary: (NSMutableDictionary *) tempTransferDictionary;
+
+@end
+
+@interface AWSS3TransferUtilityDatabaseTests : XCTestCase
+
+@property (nonatomic, strong) NSString *directoryPath;
+@property (nonatomic, strong) AWSFMDatabaseQueue *databaseQueue;
+
+@end
+
+@implementation AWSS3TransferUtilityDatabaseTests
+
+- (void)setUp {
+    [super setUp];
+    self.directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    self.databaseQueue = [AWSS3TransferUtilityDatabaseHelper createDatabase:self.directoryPath];
+}
+
+- (void)tearDown {
+    [self.databaseQueue close];
+    [[NSFileManager defaultManager] removeItemAtPath:self.directoryPath error:nil];
+    [super tearDown];
+}
+
++ (AWSS3TransferUtilityMultiPartUploadTask *)multiPartUploadTaskWithSessionIdentifier:(NSString *)sessionIdentifier
+                                                                        databaseQueue:(AWSFMDatabaseQueue *)databaseQueue {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [AWSS3TransferUtilityMultiPartUploadTask new];
+    task.transferID = [[NSUUID UUID] UUIDString];
+    task.nsURLSessionID = sessionIdentifier;
+    task.databaseQueue = databaseQueue;
+    task.transferType = @"MULTI_PART_UPLOAD";
+    task.bucket = @"bucket";
+    task.key = @"key";
+    task.uploadID = [[NSUUID UUID] UUIDString];
+    task.file = @"";
+    task.contentLength = @(0);
+    task.status = AWSS3TransferUtilityTransferStatusInProgress;
+    return task;
+}
+
++ (NSArray<AWSS3TransferUtilityUploadSubTask *> *)subTasksForTask:(AWSS3TransferUtilityMultiPartUploadTask *)task
+                                                            count:(NSUInteger)count
+                                                           status:(AWSS3TransferUtilityTransferStatusType)status {
+    NSMutableArray<AWSS3TransferUtilityUploadSubTask *> *subTasks = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 1; i <= count; i++) {
+        AWSS3TransferUtilityUploadSubTask *subTask = [AWSS3TransferUtilityUploadSubTask new];
+        subTask.transferID = task.transferID;
+        subTask.uploadID = task.uploadID;
+        subTask.partNumber = @(i);
+        subTask.taskIdentifier = i;
+        subTask.transferType = @"MULTI_PART_UPLOAD_SUB_TASK";
+        subTask.totalBytesExpectedToSend = 5 * 1024 * 1024;
+        subTask.file = [NSString stringWithFormat:@"/tmp/part-%lu", (unsigned long)i];
+        subTask.eTag = @"";
+        subTask.status = status;
+        [subTasks addObject:subTask];
+    }
+    return subTasks;
+}
+
+- (NSUInteger)rowCountForTransferID:(NSString *)transferID {
+    __block NSUInteger count = 0;
+    [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        AWSFMResultSet *rs = [db executeQuery:@"SELECT COUNT(*) FROM awstransfer WHERE transfer_id=:transfer_id"
+                      withParameterDictionary:@{@"transfer_id": transferID}];
+        if ([rs next]) {
+            count = (NSUInteger)[rs longLongIntForColumnIndex:0];
+        }
+        [rs close];
+    }];
+    return count;
+}
+
+- (void)testTableIsIndexed {
+    NSMutableSet<NSString *> *indexes = [NSMutableSet new];
+    [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        AWSFMResultSet *rs = [db executeQuery:@"SELECT name FROM sqlite_master WHERE type='index' AND tbl_name='awstransfer'"];
+        while ([rs next]) {
+            [indexes addObject:[rs stringForColumn:@"name"]];
+        }
+        [rs close];
+    }];
+    XCTAssertTrue([indexes containsObject:@"awstransfer_transfer_id"]);
+    XCTAssertTrue([indexes containsObject:@"awstransfer_ns_url_session_id"]);
+}
+
+- (void)testCompletedPartsAreLoadedOnDemand {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [[self class] multiPartUploadTaskWithSessionIdentifier:@"session"
+                                                                                             databaseQueue:self.databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestInDB:task databaseQueue:self.databaseQueue];
+    NSArray<AWSS3TransferUtilityUploadSubTask *> *subTasks = [[self class] subTasksForTask:task
+                                                                                     count:5
+                                                                                    status:AWSS3TransferUtilityTransferStatusWaiting];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                        subTasks:subTasks
+                                                                   databaseQueue:self.databaseQueue];
+    XCTAssertEqual([self rowCountForTransferID:task.transferID], 6);
+
+    NSArray<AWSS3TransferUtilityUploadSubTask *> *completed = [subTasks subarrayWithRange:NSMakeRange(0, 2)];
+    for (AWSS3TransferUtilityUploadSubTask *subTask in completed) {
+        subTask.status = AWSS3TransferUtilityTransferStatusCompleted;
+        subTask.eTag = [NSString stringWithFormat:@"etag-%@", subTask.partNumber];
+    }
+    [AWSS3TransferUtilityDatabaseHelper updateMultiPartUploadRequestInDB:task
+                                                                subTasks:completed
+                                                           databaseQueue:self.databaseQueue];
+
+    // Recovery reads the upload and its remaining parts only.
+    NSArray *rows = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:@"session" databaseQueue:self.databaseQueue];
+    XCTAssertEqual(rows.count, 4);
+    XCTAssertEqualObjects(rows.firstObject[@"transfer_type"], @"MULTI_PART_UPLOAD");
+    XCTAssertEqualObjects([rows valueForKey:@"part_number"], (@[@0, @3, @4, @5]));
+
+    NSMutableSet<AWSS3TransferUtilityUploadSubTask *> *completedParts = [AWSS3TransferUtilityDatabaseHelper getCompletedPartsFromDB:task.transferID
+                                                                                                                     databaseQueue:self.databaseQueue];
+    XCTAssertEqual(completedParts.count, 2);
+    for (AWSS3TransferUtilityUploadSubTask *subTask in completedParts) {
+        XCTAssertEqualObjects(subTask.eTag, ([NSString stringWithFormat:@"etag-%@", subTask.partNumber]));
+        XCTAssertEqual(subTask.totalBytesExpectedToSend, 5 * 1024 * 1024);
+        XCTAssertEqualObjects(subTask.uploadID, task.uploadID);
+    }
+
+    // A recovered upload loads the completed parts when they are first used.
+    AWSS3TransferUtilityMultiPartUploadTask *recovered = [AWSS3TransferUtilityMultiPartUploadTask new];
+    recovered.transferID = task.transferID;
+    recovered.databaseQueue = self.databaseQueue;
+    recovered.completedPartsSet = nil;
+    XCTAssertEqual(recovered.completedPartsSet.count, 2);
+}
+
+- (void)testBulkDeletes {
+    AWSS3TransferUtilityMultiPartUploadTask *finished = [[self class] multiPartUploadTaskWithSessionIdentifier:@"session"
+                                                                                                 databaseQueue:self.databaseQueue];
+    AWSS3TransferUtilityMultiPartUploadTask *running = [[self class] multiPartUploadTaskWithSessionIdentifier:@"session"
+                                                                                                databaseQueue:self.databaseQueue];
+    AWSS3TransferUtilityMultiPartUploadTask *orphaned = [[self class] multiPartUploadTaskWithSessionIdentifier:@"session"
+                                                                                                 databaseQueue:self.databaseQueue];
+    for (AWSS3TransferUtilityMultiPartUploadTask *task in @[finished, running, orphaned]) {
+        if (task != orphaned) {
+            [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestInDB:task databaseQueue:self.databaseQueue];
+        }
+        [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                            subTasks:[[self class] subTasksForTask:task
+                                                                                                             count:3
+                                                                                                            status:AWSS3TransferUtilityTransferStatusCompleted]
+                                                                       databaseQueue:self.databaseQueue];
+    }
+
+    [AWSS3TransferUtilityDatabaseHelper deleteOrphanedSubTasksFromDB:@"session" databaseQueue:self.databaseQueue];
+    XCTAssertEqual([self rowCountForTransferID:orphaned.transferID], 0);
+    XCTAssertEqual([self rowCountForTransferID:finished.transferID], 4);
+
+    [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestsFromDB:@[finished.transferID, @"unknown"]
+                                                       databaseQueue:self.databaseQueue];
+    XCTAssertEqual([self rowCountForTransferID:finished.transferID], 0);
+    XCTAssertEqual([self rowCountForTransferID:running.transferID], 4);
+}
+
+#pragma mark - Performance
+
+- (void)testRecoveringTenThousandQueuedSubTasksPerformance {
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+    NSString *key = [[NSUUID UUID] UUIDString];
+    [AWSS3TransferUtility registerS3TransferUtilityWithConfiguration:[AWSServiceManager defaultServiceManager].defaultServiceConfiguration
+                                                              forKey:key];
+    AWSS3TransferUtility *transferUtility = [AWSS3TransferUtility S3TransferUtilityForKey:key];
+    AWSFMDatabaseQueue *databaseQueue = transferUtility.databaseQueue;
+
+    AWSS3TransferUtilityMultiPartUploadTask *task = [[self class] multiPartUploadTaskWithSessionIdentifier:transferUtility.sessionIdentifier
+                                                                                             databaseQueue:databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestInDB:task databaseQueue:databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                        subTasks:[[self class] subTasksForTask:task
+                                                                                                         count:10000
+                                                                                                        status:AWSS3TransferUtilityTransferStatusWaiting]
+                                                                   databaseQueue:databaseQueue];
+    [self addTeardownBlock:^{
+        [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:task.transferID databaseQueue:databaseQueue];
+        [AWSS3TransferUtility removeS3TransferUtilityForKey:key];
+    }];
+
+    [self measureBlock:^{
+        NSMutableDictionary *tempMultiPartMasterTaskDictionary = [NSMutableDictionary new];
+        NSMutableDictionary *tempTransferDictionary = [NSMutableDictionary new];
+        [transferUtility hydrateFromDB:tempMultiPartMasterTaskDictionary tempTransferDictionary:tempTransferDictionary];
+        XCTAssertEqual(tempMultiPartMasterTaskDictionary.count, 1);
+        XCTAssertEqual(tempTransferDictionary.count, 10000);
+    }];
+}
+
+@end
@@ -44,3 +44,4 @@ FOUNDATION_EXPORT const unsigned char AWSTranscribeStreamingVersionString[] DEPR
 #import "AWSTranscribeStreamingService.h"
 #import "AWSTranscribeStreamingWebSocketProvider.h"
 #import "AWSTranscribeStreamingEventDecoder.h"
+#import "AWSTranscribeStreamingSendQueueConfiguration.h"
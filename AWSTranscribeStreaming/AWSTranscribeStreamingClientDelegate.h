@@ -15,6 +15,7 @@
 
 #import <Foundation/Foundation.h>
 #import "AWSTranscribeStreamingModel.h"
+#import "AWSTranscribeStreamingSendQueueConfiguration.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -71,6 +72,24 @@ typedef NS_ENUM(NSInteger, AWSTranscribeStreamingClientConnectionStatus) {
 - (void)didReceiveEvent:(nullable AWSTranscribeStreamingTranscriptResultStream *)event
           decodingError:(nullable NSError *)decodingError;
 
+@optional
+
+/**
+ Invoked when the audio waiting to be written, in the client's send queue and the web socket's output buffer, reaches
+ `AWSTranscribeStreamingSendQueueConfiguration.highWatermark`. Callers may want to reduce the rate or quality of the audio they send.
+
+ @param metrics the state of the send queue when the watermark was reached
+ */
+- (void)sendQueueDidReachHighWatermark:(AWSTranscribeStreamingSendQueueMetrics *)metrics NS_SWIFT_NAME(sendQueueDidReachHighWatermark(_:));
+
+/**
+ Invoked when the audio waiting to be written falls to `AWSTranscribeStreamingSendQueueConfiguration.lowWatermark` after
+ the high watermark was reached.
+
+ @param metrics the state of the send queue when the watermark was reached
+ */
+- (void)sendQueueDidDrainToLowWatermark:(AWSTranscribeStreamingSendQueueMetrics *)metrics NS_SWIFT_NAME(sendQueueDidDrainToLowWatermark(_:));
+
 @end
 
 NS_ASSUME_NONNULL_END
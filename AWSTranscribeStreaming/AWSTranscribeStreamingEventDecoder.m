@@ -79,11 +79,20 @@
 
 +(bool)verifyMessageLengthHeaderForData:(NSData *)data
                           decodingError:(NSError **)decodingErrorPointer {
-    int totalLength = [AWSTranscribeStreamingEventDecoder getTotalLengthForData:data];
-    if (data.length < totalLength) {
-        NSString *failureReason = [NSString stringWithFormat:@"Prelude specifies data size of %d, actual size is %lu",
-                                   totalLength,
-                                   data.length];
+    // The prelude (12 bytes) and message CRC (4 bytes) frame the headers and body, which must fit between them.
+    NSUInteger totalLength = [AWSTranscribeStreamingEventDecoder getTotalLengthForData:data];
+    NSUInteger headerLength = [AWSTranscribeStreamingEventDecoder getHeaderLengthForData:data];
+    NSString *failureReason = nil;
+    if (totalLength < 16 || data.length < totalLength) {
+        failureReason = [NSString stringWithFormat:@"Prelude specifies data size of %lu, actual size is %lu",
+                         (unsigned long)totalLength,
+                         (unsigned long)data.length];
+    } else if (headerLength > totalLength - 16) {
+        failureReason = [NSString stringWithFormat:@"Prelude specifies header size of %lu, which does not fit in a message of %lu bytes",
+                         (unsigned long)headerLength,
+                         (unsigned long)totalLength];
+    }
+    if (failureReason) {
         NSDictionary *userInfo = @{NSLocalizedFailureReasonErrorKey: failureReason};
         *decodingErrorPointer = [NSError errorWithDomain:AWSTranscribeStreamingClientErrorDomain
                                                     code:AWSTranscribeStreamingClientErrorCodeInvalidMessageLengthHeader
@@ -93,52 +102,95 @@
     return YES;
 }
 
+// The length of the message in `data`, bounded by the bytes actually available. 0 if not even the prelude and CRC fit.
++(NSUInteger)getMessageLengthForData:(NSData *)data {
+    NSUInteger messageLen = MIN((NSUInteger)[AWSTranscribeStreamingEventDecoder getTotalLengthForData:data], [data length]);
+    return messageLen < 16 ? 0 : messageLen;
+}
+
 +(NSDictionary<NSString *, NSString *> *)getHeadersForData:(NSData *)data {
-    
-    int headerLen = [AWSTranscribeStreamingEventDecoder getHeaderLengthForData:data];
-    NSData *headerData = [data subdataWithRange:NSMakeRange(12, headerLen)];
-    int currentPosition = 0;
+    // Headers are read in place from the message buffer rather than from per-field subdata copies.
+    NSUInteger messageLen = [AWSTranscribeStreamingEventDecoder getMessageLengthForData:data];
+    if (messageLen == 0) {
+        return @{};
+    }
+    const uint8_t *bytes = [data bytes];
+    NSUInteger headerStartPos = 4 + 4 + 4;
+    NSUInteger headerLen = MIN((NSUInteger)[AWSTranscribeStreamingEventDecoder getHeaderLengthForData:data],
+                               messageLen - headerStartPos - 4);
+    const uint8_t *headerBytes = bytes + headerStartPos;
+    NSUInteger currentPosition = 0;
     NSMutableDictionary<NSString *, NSString *> *dictionary = [NSMutableDictionary new];
-    
+
     while (currentPosition < headerLen) {
-        int currentHeaderLen = *(int *)[[headerData subdataWithRange:NSMakeRange(currentPosition, 1)]  bytes];
+        NSUInteger currentHeaderLen = headerBytes[currentPosition];
         currentPosition++;
-        NSString *headerKey = [[NSString alloc] initWithData:[headerData subdataWithRange:NSMakeRange(currentPosition, currentHeaderLen)] encoding:NSUTF8StringEncoding];
+        // Key, type (1 byte) and value length (2 bytes) must fit in the header block.
+        if (currentPosition + currentHeaderLen + 3 > headerLen) {
+            break;
+        }
+        NSString *headerKey = [[NSString alloc] initWithBytes:headerBytes + currentPosition
+                                                       length:currentHeaderLen
+                                                     encoding:NSUTF8StringEncoding];
         AWSDDLogVerbose(@"Header Name: %@", headerKey);
         currentPosition += currentHeaderLen;
-        
+
         // skip header type info, always 7 while decoding
         currentPosition++;
-        
-        int currentHeaderValueLen = CFSwapInt16(*(UInt16 *)[[headerData subdataWithRange:NSMakeRange(currentPosition, 2)]  bytes]);
+
+        uint16_t currentHeaderValueLen;
+        memcpy(&currentHeaderValueLen, headerBytes + currentPosition, sizeof(currentHeaderValueLen));
+        currentHeaderValueLen = CFSwapInt16BigToHost(currentHeaderValueLen);
         currentPosition += 2;
+        if (currentPosition + currentHeaderValueLen > headerLen) {
+            break;
+        }
 
-        NSString *headerValue = [[NSString alloc] initWithData:[headerData subdataWithRange:NSMakeRange(currentPosition, currentHeaderValueLen)] encoding:NSUTF8StringEncoding];
+        NSString *headerValue = [[NSString alloc] initWithBytes:headerBytes + currentPosition
+                                                         length:currentHeaderValueLen
+                                                       encoding:NSUTF8StringEncoding];
         AWSDDLogVerbose(@"Header Value: %@", headerValue);
 
-        dictionary[headerKey] = headerValue;
+        if (headerKey && headerValue) {
+            dictionary[headerKey] = headerValue;
+        }
 
         currentPosition += currentHeaderValueLen;
     }
-    
+
     return [NSDictionary dictionaryWithDictionary:dictionary];
 }
 
 +(NSString *)getBodyForData:(NSData *)data {
+    NSUInteger messageLen = [AWSTranscribeStreamingEventDecoder getMessageLengthForData:data];
     NSUInteger headerLen = [AWSTranscribeStreamingEventDecoder getHeaderLengthForData:data];
-    NSUInteger messageLen = [data length];
+    if (messageLen == 0 || headerLen > messageLen - 16) {
+        return nil;
+    }
     NSUInteger dataStartPos = 4 + 4 + 4 + headerLen;
     NSUInteger dataLen = messageLen - dataStartPos - 4;
-    NSString *dataString = [[NSString alloc] initWithData:[data subdataWithRange:NSMakeRange(dataStartPos, dataLen)] encoding:NSUTF8StringEncoding];
+    NSString *dataString = [[NSString alloc] initWithBytes:(const uint8_t *)[data bytes] + dataStartPos
+                                                    length:dataLen
+                                                  encoding:NSUTF8StringEncoding];
     return dataString;
 }
 
-+(int)getTotalLengthForData:(NSData *)data {
-    return CFSwapInt32(*(UInt32 *)[[data subdataWithRange:NSMakeRange(0, 4)] bytes]);;
++(uint32_t)getTotalLengthForData:(NSData *)data {
+    return [AWSTranscribeStreamingEventDecoder readUInt32FromData:data atOffset:0];
+}
+
++(uint32_t)getHeaderLengthForData:(NSData *)data {
+    return [AWSTranscribeStreamingEventDecoder readUInt32FromData:data atOffset:4];
 }
 
-+(int)getHeaderLengthForData:(NSData *)data {
-    return CFSwapInt32(*(UInt32 *)[[data subdataWithRange:NSMakeRange(4, 8)] bytes]);;
+// Returns 0 if the data is too short to hold the value.
++(uint32_t)readUInt32FromData:(NSData *)data atOffset:(NSUInteger)offset {
+    uint32_t value;
+    if (offset > [data length] || [data length] - offset < sizeof(value)) {
+        return 0;
+    }
+    memcpy(&value, (const uint8_t *)[data bytes] + offset, sizeof(value));
+    return CFSwapInt32BigToHost(value);
 }
 
 @end
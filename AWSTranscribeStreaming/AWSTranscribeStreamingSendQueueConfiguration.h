@@ -0,0 +1,98 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ What the client does with audio when the send queue is full.
+ */
+typedef NS_ENUM(NSInteger, AWSTranscribeStreamingSendQueuePolicy) {
+    /// Chunks are handed to the web socket as soon as they are sent. This is the default.
+    AWSTranscribeStreamingSendQueuePolicyUnbounded,
+    /// `sendData:headers:` blocks the calling thread until the queue has room for the chunk.
+    AWSTranscribeStreamingSendQueuePolicyBlock,
+    /// The oldest queued chunks are discarded to make room for the new chunk. A chunk larger than `capacity` is discarded
+    /// itself.
+    AWSTranscribeStreamingSendQueuePolicyDropOldest,
+    /// Queued chunks with identical headers are merged into larger frames, and the oldest chunks are discarded if the
+    /// queue is still full.
+    AWSTranscribeStreamingSendQueuePolicyCoalesce,
+};
+
+/**
+ Configures the queue between `-[AWSTranscribeStreaming sendData:headers:]` and the web socket. Audio is held in the
+ queue while the web socket's own output buffer is above `webSocketBufferLimit`.
+ */
+@interface AWSTranscribeStreamingSendQueueConfiguration : NSObject <NSCopying>
+
+/// Defaults to `AWSTranscribeStreamingSendQueuePolicyUnbounded`.
+@property (nonatomic, assign) AWSTranscribeStreamingSendQueuePolicy policy;
+
+/// The maximum number of audio bytes held in the queue. Defaults to 256 KB.
+@property (nonatomic, assign) NSUInteger capacity;
+
+/// The number of bytes the web socket may buffer before audio is held in the queue. Defaults to 32 KB.
+@property (nonatomic, assign) NSUInteger webSocketBufferLimit;
+
+/// The largest frame built by merging queued chunks under `AWSTranscribeStreamingSendQueuePolicyCoalesce`. Defaults to 32 KB.
+@property (nonatomic, assign) NSUInteger maximumCoalescedChunkLength;
+
+/// Queue depth, in bytes queued plus bytes buffered by the web socket, at which the delegate's
+/// `sendQueueDidReachHighWatermark:` is invoked. Defaults to 128 KB.
+@property (nonatomic, assign) NSUInteger highWatermark;
+
+/// Queue depth at which the delegate's `sendQueueDidDrainToLowWatermark:` is invoked after the high watermark was
+/// reached. Defaults to 32 KB.
+@property (nonatomic, assign) NSUInteger lowWatermark;
+
+@end
+
+/**
+ A snapshot of the send queue's state and counters since the transcription started.
+ */
+@interface AWSTranscribeStreamingSendQueueMetrics : NSObject
+
+/// Chunks waiting in the queue.
+@property (nonatomic, readonly) NSUInteger queuedChunkCount;
+
+/// Bytes of audio waiting in the queue.
+@property (nonatomic, readonly) NSUInteger queuedByteCount;
+
+/// Bytes handed to the web socket that it has not yet written, or 0 if the web socket provider does not report it.
+@property (nonatomic, readonly) NSUInteger webSocketBufferedByteCount;
+
+/// Frames handed to the web socket.
+@property (nonatomic, readonly) NSUInteger sentChunkCount;
+
+/// Chunks discarded because the queue was full.
+@property (nonatomic, readonly) NSUInteger droppedChunkCount;
+
+/// Bytes of audio discarded because the queue was full.
+@property (nonatomic, readonly) NSUInteger droppedByteCount;
+
+/// Chunks merged into a previously queued chunk.
+@property (nonatomic, readonly) NSUInteger coalescedChunkCount;
+
+/// Average time between a chunk being sent and it being handed to the web socket.
+@property (nonatomic, readonly) NSTimeInterval averageSendLatency;
+
+/// Longest time between a chunk being sent and it being handed to the web socket.
+@property (nonatomic, readonly) NSTimeInterval maximumSendLatency;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,48 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSTranscribeStreamingSendQueueConfiguration.h"
+#import "AWSTranscribeStreamingSendQueue.h"
+
+@implementation AWSTranscribeStreamingSendQueueConfiguration
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _policy = AWSTranscribeStreamingSendQueuePolicyUnbounded;
+        _capacity = 256 * 1024;
+        _webSocketBufferLimit = 32 * 1024;
+        _maximumCoalescedChunkLength = 32 * 1024;
+        _highWatermark = 128 * 1024;
+        _lowWatermark = 32 * 1024;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    AWSTranscribeStreamingSendQueueConfiguration *configuration = [[[self class] allocWithZone:zone] init];
+    configuration.policy = self.policy;
+    configuration.capacity = self.capacity;
+    configuration.webSocketBufferLimit = self.webSocketBufferLimit;
+    configuration.maximumCoalescedChunkLength = self.maximumCoalescedChunkLength;
+    configuration.highWatermark = self.highWatermark;
+    configuration.lowWatermark = self.lowWatermark;
+    return configuration;
+}
+
+@end
+
+@implementation AWSTranscribeStreamingSendQueueMetrics
+
+@end
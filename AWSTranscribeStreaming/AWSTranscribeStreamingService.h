@@ -293,9 +293,20 @@ Then call the following to get the service client:
  */
 - (void)endTranscription;
 
+/**
+ Configures how audio passed to `sendData:headers:` is queued while the web socket is backed up. Changes take effect when the next
+ transcription starts. By default audio is handed to the web socket without bounds.
+ */
+@property (nonatomic, copy) AWSTranscribeStreamingSendQueueConfiguration *sendQueueConfiguration;
+
+/**
+ Returns the current queue depth and the send counters and latencies of the current transcription.
+ */
+- (AWSTranscribeStreamingSendQueueMetrics *)sendQueueMetrics;
+
 /**
  Sends a chunk of data to AWSTranscribeStreaming. Internally, this method encodes the data and headers and sends it on the underlying
- web socket.
+ web socket, subject to `sendQueueConfiguration`.
 
  @param data the data to send
  @param headers headers describing the chunk of data
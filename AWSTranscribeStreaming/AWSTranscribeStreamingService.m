@@ -25,7 +25,7 @@
 #import <AWSCore/AWSURLRequestRetryHandler.h>
 #import <AWSCore/AWSSynchronizedMutableDictionary.h>
 #import "AWSTranscribeStreamingClientDelegate.h"
-#import "AWSTranscribeEventEncoder.h"
+#import "AWSTranscribeStreamingSendQueue.h"
 #import "AWSTranscribeStreamingResources.h"
 #import "AWSSRWebSocketAdaptor.h"
 #import "AWSTranscribeStreamingWebSocketProvider.h"
@@ -67,6 +67,7 @@ static NSDictionary *errorCodeDictionary = nil;
 @property (nonatomic, strong) AWSNetworking *networking;
 @property (nonatomic, strong) AWSServiceConfiguration *configuration;
 @property (nonatomic, strong) id<AWSTranscribeStreamingWebSocketProvider> webSocketProvider;
+@property (nonatomic, strong) AWSTranscribeStreamingSendQueue *sendQueue;
 
 @end
 
@@ -192,6 +193,8 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         }
         
         _webSocketProvider = webSocketProvider;
+        _sendQueue = [[AWSTranscribeStreamingSendQueue alloc] initWithWebSocketProvider:webSocketProvider];
+        _sendQueueConfiguration = [AWSTranscribeStreamingSendQueueConfiguration new];
         
         _configuration.baseURL = _configuration.endpoint.URL;
         
@@ -207,7 +210,7 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
       callbackQueue:(dispatch_queue_t)callbackQueue {
     
     [self.webSocketProvider setDelegate:delegate dispatchQueue:callbackQueue];
-    
+    self.sendQueue.callbackQueue = callbackQueue;
 }
 
 // Note that this method hands off work to the global queue, to prevent potential deadlocks on the main thread while
@@ -216,6 +219,8 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 // UI in the main thread, which would be a problem if this method was invoked from the main thread (which is a
 // completely reasonable use case).
 - (void)startTranscriptionWSS:(AWSTranscribeStreamingStartStreamTranscriptionRequest *)request {
+    [self.sendQueue reset];
+    self.sendQueue.configuration = self.sendQueueConfiguration;
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
         NSError *error;
         [self invokeRequestForWSS:request
@@ -246,17 +251,20 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 }
 
 - (void)sendData:(NSData *)data headers:(NSDictionary *)headers {
-    NSData *encodedChunk = [AWSTranscribeEventEncoder encodeChunk:data headers:headers];
-    [self.webSocketProvider send:encodedChunk];
+    [self.sendQueue enqueueData:data headers:headers];
 }
 
 - (void)sendEndFrame {
-    NSData *endFrame = [AWSTranscribeEventEncoder getEndFrameData];
-    [self.webSocketProvider send:endFrame];
+    [self.sendQueue enqueueEndFrame];
 }
 
 - (void)endTranscription {
     [self.webSocketProvider disconnect];
+    [self.sendQueue reset];
+}
+
+- (AWSTranscribeStreamingSendQueueMetrics *)sendQueueMetrics {
+    return [self.sendQueue metrics];
 }
 
 - (void)invokeRequestForWSS:(AWSRequest *)request
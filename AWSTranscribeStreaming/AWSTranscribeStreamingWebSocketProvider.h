@@ -28,6 +28,12 @@ NS_ASSUME_NONNULL_BEGIN
      dispatchQueue:(dispatch_queue_t)dispatchQueue;
 -(void)configureWithURLRequest:(NSURLRequest *)urlRequest;
 
+@optional
+
+/// The number of bytes passed to `send:` that have not yet been written to the network. The client holds audio in its
+/// send queue while this is above `AWSTranscribeStreamingSendQueueConfiguration.webSocketBufferLimit`.
+-(NSUInteger)bufferedAmount;
+
 @end
 
 NS_ASSUME_NONNULL_END
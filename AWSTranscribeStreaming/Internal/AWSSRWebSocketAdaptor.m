@@ -55,6 +55,10 @@
     [self.webSocket send:data];
 }
 
+- (NSUInteger)bufferedAmount {
+    return self.webSocket.bufferedAmount;
+}
+
 - (void)connect {
     AWSDDLogDebug(@"Web socket %@ is trying to open", self.webSocket);
     [self.webSocket open];
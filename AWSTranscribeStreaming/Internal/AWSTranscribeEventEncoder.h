@@ -24,8 +24,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 /// Encodes a chunk of data into the stream, per
 /// https://docs.aws.amazon.com/transcribe/latest/dg/streaming-format.html
-+(NSData *)encodeChunk:(NSData *)data
-               headers:(NSDictionary<NSString *, NSString *> *)headers;
+/// Returns nil if a header name or value is too long to be encoded.
++(nullable NSData *)encodeChunk:(NSData *)data
+                        headers:(NSDictionary<NSString *, NSString *> *)headers;
 
 @end
 
@@ -15,74 +15,70 @@
 
 #import "AWSTranscribeEventEncoder.h"
 #import "AWSTranscribeStreamingModel.h"
-#import <CommonCrypto/CommonDigest.h>
-#import <zlib.h>
 #import <AWSCore/AWSCore.h>
 
+static const NSUInteger AWSTranscribeEventHeaderBlockCacheLimit = 16;
+
 @implementation AWSTranscribeEventEncoder
 
 +(NSData *)getEndFrameData {
-    NSDictionary<NSString *, NSString *> *endHeaders = @{
-                                                        @":message-type": @"event",
-                                                        @":event-type": @"AudioEvent"
-                                                        };
-    
-    return [AWSTranscribeEventEncoder encodeChunk:[@"" dataUsingEncoding:NSUTF8StringEncoding]
-                                          headers:endHeaders];
+    static NSData *endFrameData = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSDictionary<NSString *, NSString *> *endHeaders = @{
+                                                            @":message-type": @"event",
+                                                            @":event-type": @"AudioEvent"
+                                                            };
+        endFrameData = [AWSTranscribeEventEncoder encodeChunk:[NSData data]
+                                                      headers:endHeaders];
+    });
+    return endFrameData;
 }
 
-+(NSData *)encodeChunk:(NSData *)data
-               headers:(NSDictionary<NSString *, NSString *> *)headers {
-    
-    NSUInteger headersLen = 0;
-    for (NSString *key in headers) {
-        headersLen += [key length];
-        headersLen += [headers[key] length];
-        headersLen += 4;
++(nullable NSData *)encodeChunk:(NSData *)data
+                        headers:(NSDictionary<NSString *, NSString *> *)headers {
+    NSData *headerBlock = [AWSTranscribeEventEncoder headerBlockForHeaders:headers];
+    if (!headerBlock) {
+        return nil;
+    }
+    return [AWSEventStreamEncoder encodeMessageWithEncodedHeaders:headerBlock payload:data];
+}
+
+/// Returns the encoded header block for `headers`. Audio frames all carry the same few headers, so encoded blocks are
+/// cached and shared between frames. Returns nil if the headers cannot be encoded.
++(nullable NSData *)headerBlockForHeaders:(NSDictionary<NSString *, NSString *> *)headers {
+    static NSMutableDictionary<NSDictionary *, NSData *> *headerBlockCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        headerBlockCache = [NSMutableDictionary new];
+    });
+
+    @synchronized(headerBlockCache) {
+        NSData *headerBlock = headerBlockCache[headers];
+        if (headerBlock) {
+            return headerBlock;
+        }
     }
-    
-    NSUInteger payloadLength = [data length];
-    NSUInteger headerLength = headersLen;
-    NSUInteger messageLength = 16 + payloadLength + headerLength;
-    
-    NSMutableData *resultData = [[NSMutableData alloc] initWithCapacity:messageLength];
-    
-    int messageLengthToEncode = (int)messageLength;
-    messageLengthToEncode = CFSwapInt32HostToBig(messageLengthToEncode);
-    [resultData appendBytes:&messageLengthToEncode length:sizeof(messageLengthToEncode)];
-    int headerLengthToEncode = (int)headerLength;
-    headerLengthToEncode = CFSwapInt32HostToBig(headerLengthToEncode);
-    [resultData appendBytes:&headerLengthToEncode length:sizeof(headerLengthToEncode)];
-    NSData *preludeData = [resultData subdataWithRange:NSMakeRange(0, 8)];
-    
-    unsigned long crc = crc32(0, preludeData.bytes, (int)preludeData.length);
-    
-    uint32_t crcInt = CFSwapInt32HostToBig((uint32_t)crc);
-    [resultData appendBytes:&crcInt length:sizeof(crcInt)];
-    
+
+    NSMutableDictionary<NSString *, AWSEventStreamHeaderValue *> *headerValues = [NSMutableDictionary new];
     for (NSString *headerKey in headers) {
-        UInt8 headerKeyLen = (UInt8)[headerKey length];
-        
-        uint16_t headerValLen = (uint16_t)[headers[headerKey] length];
-        headerValLen = CFSwapInt16(headerValLen);
-        
-        [resultData appendBytes:&headerKeyLen length:sizeof(headerKeyLen)];
-        NSData *headerData = [headerKey dataUsingEncoding:NSUTF8StringEncoding];
-        [resultData appendBytes:[headerData bytes] length:[headerData length]];
-        UInt8 headerType = 7;
-        [resultData appendBytes:&headerType length:sizeof(headerType)];
-        [resultData appendBytes:&headerValLen length:sizeof(headerValLen)];
-        NSData *headerValueData = [headers[headerKey] dataUsingEncoding:NSUTF8StringEncoding];
-        [resultData appendBytes:[headerValueData bytes] length:[headerValueData length]];
+        headerValues[headerKey] = [AWSEventStreamHeaderValue stringValue:headers[headerKey]];
+    }
+
+    NSError *error = nil;
+    NSData *headerBlock = [AWSEventStreamEncoder encodeHeaders:headerValues error:&error];
+    if (!headerBlock) {
+        AWSDDLogError(@"Failed to encode event headers: %@", error);
+        return nil;
+    }
+
+    @synchronized(headerBlockCache) {
+        if ([headerBlockCache count] >= AWSTranscribeEventHeaderBlockCacheLimit) {
+            [headerBlockCache removeAllObjects];
+        }
+        headerBlockCache[[headers copy]] = headerBlock;
     }
-    [resultData appendBytes:[data bytes] length:[data length]];
-    
-    unsigned long crcMessage = crc32(0, resultData.bytes, (int)resultData.length);
-    
-    uint32_t crcMessageInt = CFSwapInt32HostToBig((uint32_t)crcMessage);
-    [resultData appendBytes:&crcMessageInt length:sizeof(crcMessageInt)];
-    
-    return resultData;
+    return headerBlock;
 }
 
 @end
@@ -0,0 +1,60 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSTranscribeStreamingClientDelegate.h"
+#import "AWSTranscribeStreamingSendQueueConfiguration.h"
+#import "AWSTranscribeStreamingWebSocketProvider.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface AWSTranscribeStreamingSendQueueMetrics()
+
+@property (nonatomic, assign) NSUInteger queuedChunkCount;
+@property (nonatomic, assign) NSUInteger queuedByteCount;
+@property (nonatomic, assign) NSUInteger webSocketBufferedByteCount;
+@property (nonatomic, assign) NSUInteger sentChunkCount;
+@property (nonatomic, assign) NSUInteger droppedChunkCount;
+@property (nonatomic, assign) NSUInteger droppedByteCount;
+@property (nonatomic, assign) NSUInteger coalescedChunkCount;
+@property (nonatomic, assign) NSTimeInterval averageSendLatency;
+@property (nonatomic, assign) NSTimeInterval maximumSendLatency;
+
+@end
+
+/// Orders, bounds and paces the audio frames handed to a web socket provider, according to an
+/// `AWSTranscribeStreamingSendQueueConfiguration`.
+@interface AWSTranscribeStreamingSendQueue : NSObject
+
+@property (nonatomic, copy) AWSTranscribeStreamingSendQueueConfiguration *configuration;
+
+/// The queue on which watermark callbacks are delivered to the provider's client delegate.
+@property (nonatomic, strong, nullable) dispatch_queue_t callbackQueue;
+
+- (instancetype)initWithWebSocketProvider:(id<AWSTranscribeStreamingWebSocketProvider>)webSocketProvider;
+
+- (void)enqueueData:(NSData *)data headers:(NSDictionary *)headers NS_SWIFT_NAME(enqueue(_:headers:));
+
+/// Queues the end frame behind any pending audio. The end frame is never dropped or coalesced.
+- (void)enqueueEndFrame;
+
+/// Discards pending audio, wakes blocked senders and resets the metrics.
+- (void)reset;
+
+- (AWSTranscribeStreamingSendQueueMetrics *)metrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
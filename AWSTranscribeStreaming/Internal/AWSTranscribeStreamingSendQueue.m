@@ -0,0 +1,317 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSTranscribeStreamingSendQueue.h"
+#import <AWSCore/AWSCore.h>
+#import "AWSTranscribeEventEncoder.h"
+
+// How often a saturated web socket is checked for room while audio is queued.
+static const NSTimeInterval AWSTranscribeStreamingSendQueuePollInterval = 0.01;
+
+@interface AWSTranscribeStreamingPendingChunk : NSObject
+
+@property (nonatomic, strong) NSMutableData *data;
+@property (nonatomic, strong) NSDictionary *headers;
+@property (nonatomic, assign) CFAbsoluteTime enqueueTime;
+@property (nonatomic, assign) BOOL isEndFrame;
+
+@end
+
+@implementation AWSTranscribeStreamingPendingChunk
+
+@end
+
+@interface AWSTranscribeStreamingSendQueue()
+
+@property (nonatomic, strong) id<AWSTranscribeStreamingWebSocketProvider> webSocketProvider;
+@property (nonatomic, strong) NSCondition *condition;
+@property (nonatomic, strong) dispatch_queue_t drainQueue;
+@property (nonatomic, strong) NSMutableArray<AWSTranscribeStreamingPendingChunk *> *pendingChunks;
+@property (nonatomic, assign) NSUInteger pendingByteCount;
+@property (nonatomic, assign) NSUInteger generation;
+@property (nonatomic, assign) BOOL drainScheduled;
+@property (nonatomic, assign) BOOL aboveHighWatermark;
+
+@property (nonatomic, assign) NSUInteger sentChunkCount;
+@property (nonatomic, assign) NSUInteger droppedChunkCount;
+@property (nonatomic, assign) NSUInteger droppedByteCount;
+@property (nonatomic, assign) NSUInteger coalescedChunkCount;
+@property (nonatomic, assign) NSTimeInterval totalSendLatency;
+@property (nonatomic, assign) NSTimeInterval maximumSendLatency;
+
+@end
+
+@implementation AWSTranscribeStreamingSendQueue
+
+@synthesize configuration = _configuration;
+
+- (instancetype)initWithWebSocketProvider:(id<AWSTranscribeStreamingWebSocketProvider>)webSocketProvider {
+    if (self = [super init]) {
+        _webSocketProvider = webSocketProvider;
+        _configuration = [AWSTranscribeStreamingSendQueueConfiguration new];
+        _condition = [NSCondition new];
+        _drainQueue = dispatch_queue_create("com.amazonaws.AWSTranscribeStreamingSendQueue", DISPATCH_QUEUE_SERIAL);
+        _pendingChunks = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (AWSTranscribeStreamingSendQueueConfiguration *)configuration {
+    [self.condition lock];
+    AWSTranscribeStreamingSendQueueConfiguration *configuration = _configuration;
+    [self.condition unlock];
+    return configuration;
+}
+
+- (void)setConfiguration:(AWSTranscribeStreamingSendQueueConfiguration *)configuration {
+    configuration = [configuration copy];
+    [self.condition lock];
+    _configuration = configuration;
+    // Senders blocked on a full queue re-check it against the new capacity.
+    [self.condition broadcast];
+    [self.condition unlock];
+}
+
+- (void)enqueueData:(NSData *)data headers:(NSDictionary *)headers {
+    AWSTranscribeStreamingPendingChunk *chunk = [AWSTranscribeStreamingPendingChunk new];
+    chunk.data = [data mutableCopy];
+    chunk.headers = [headers copy];
+    [self enqueueChunk:chunk];
+}
+
+- (void)enqueueEndFrame {
+    AWSTranscribeStreamingPendingChunk *chunk = [AWSTranscribeStreamingPendingChunk new];
+    chunk.data = [NSMutableData new];
+    chunk.isEndFrame = YES;
+    [self enqueueChunk:chunk];
+}
+
+- (void)enqueueChunk:(AWSTranscribeStreamingPendingChunk *)chunk {
+    chunk.enqueueTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger length = [chunk.data length];
+
+    [self.condition lock];
+    AWSTranscribeStreamingSendQueueConfiguration *configuration = _configuration;
+
+    if (configuration.policy == AWSTranscribeStreamingSendQueuePolicyUnbounded) {
+        [self.condition unlock];
+        [self sendChunk:chunk];
+        [self.condition lock];
+        [self updateWatermarks];
+        [self.condition unlock];
+        return;
+    }
+
+    BOOL coalesced = NO;
+    AWSTranscribeStreamingPendingChunk *lastChunk = [self.pendingChunks lastObject];
+    if (configuration.policy == AWSTranscribeStreamingSendQueuePolicyCoalesce
+        && !chunk.isEndFrame
+        && lastChunk
+        && !lastChunk.isEndFrame
+        && [lastChunk.headers isEqualToDictionary:chunk.headers]
+        && [lastChunk.data length] + length <= configuration.maximumCoalescedChunkLength) {
+        [lastChunk.data appendData:chunk.data];
+        self.pendingByteCount += length;
+        self.coalescedChunkCount++;
+        coalesced = YES;
+    }
+
+    if (!coalesced) {
+        if (configuration.policy == AWSTranscribeStreamingSendQueuePolicyBlock && !chunk.isEndFrame) {
+            NSUInteger generation = self.generation;
+            while (self.pendingByteCount > 0
+                   && self.pendingByteCount + length > _configuration.capacity
+                   && generation == self.generation) {
+                [self.condition wait];
+            }
+            if (generation != self.generation) {
+                // The transcription ended while this chunk was waiting for room.
+                [self.condition unlock];
+                return;
+            }
+        } else if (!chunk.isEndFrame) {
+            if (length > configuration.capacity) {
+                // The chunk would not fit even in an empty queue, so it is dropped rather than the audio already queued.
+                self.droppedChunkCount++;
+                self.droppedByteCount += length;
+                [self updateWatermarks];
+                [self.condition unlock];
+                return;
+            }
+            while (self.pendingByteCount + length > configuration.capacity
+                   && [self.pendingChunks count] > 0
+                   && !self.pendingChunks.firstObject.isEndFrame) {
+                AWSTranscribeStreamingPendingChunk *droppedChunk = self.pendingChunks.firstObject;
+                [self.pendingChunks removeObjectAtIndex:0];
+                self.pendingByteCount -= [droppedChunk.data length];
+                self.droppedChunkCount++;
+                self.droppedByteCount += [droppedChunk.data length];
+            }
+        }
+
+        [self.pendingChunks addObject:chunk];
+        self.pendingByteCount += length;
+    }
+
+    [self scheduleDrainAfter:0];
+    [self updateWatermarks];
+    [self.condition unlock];
+}
+
+- (void)reset {
+    [self.condition lock];
+    self.generation++;
+    [self.pendingChunks removeAllObjects];
+    self.pendingByteCount = 0;
+    self.aboveHighWatermark = NO;
+    self.sentChunkCount = 0;
+    self.droppedChunkCount = 0;
+    self.droppedByteCount = 0;
+    self.coalescedChunkCount = 0;
+    self.totalSendLatency = 0;
+    self.maximumSendLatency = 0;
+    [self.condition broadcast];
+    [self.condition unlock];
+}
+
+- (AWSTranscribeStreamingSendQueueMetrics *)metrics {
+    [self.condition lock];
+    AWSTranscribeStreamingSendQueueMetrics *metrics = [self metricsWithWebSocketBufferedByteCount:[self webSocketBufferedByteCount]];
+    [self.condition unlock];
+    return metrics;
+}
+
+#pragma mark - Draining
+
+- (void)drain {
+    [self.condition lock];
+    self.drainScheduled = NO;
+    while ([self.pendingChunks count] > 0
+           && [self webSocketBufferedByteCount] <= _configuration.webSocketBufferLimit) {
+        AWSTranscribeStreamingPendingChunk *chunk = self.pendingChunks.firstObject;
+        [self.pendingChunks removeObjectAtIndex:0];
+        self.pendingByteCount -= [chunk.data length];
+        [self.condition broadcast];
+
+        // Encoding and handing off happen outside the lock so that senders are not held up by the web socket.
+        [self.condition unlock];
+        [self sendChunk:chunk];
+        [self.condition lock];
+    }
+
+    // Keep polling while audio is waiting, and while the socket drains back to the low watermark.
+    if ([self.pendingChunks count] > 0 || self.aboveHighWatermark) {
+        [self scheduleDrainAfter:AWSTranscribeStreamingSendQueuePollInterval];
+    }
+    [self updateWatermarks];
+    [self.condition unlock];
+}
+
+- (void)sendChunk:(AWSTranscribeStreamingPendingChunk *)chunk {
+    NSData *frame = chunk.isEndFrame
+        ? [AWSTranscribeEventEncoder getEndFrameData]
+        : [AWSTranscribeEventEncoder encodeChunk:chunk.data headers:chunk.headers];
+    if (!frame) {
+        // A frame without its headers would be rejected by the service, so the chunk is dropped instead.
+        [self.condition lock];
+        self.droppedChunkCount++;
+        self.droppedByteCount += [chunk.data length];
+        [self.condition unlock];
+        return;
+    }
+    [self.webSocketProvider send:frame];
+
+    NSTimeInterval latency = CFAbsoluteTimeGetCurrent() - chunk.enqueueTime;
+    [self.condition lock];
+    self.sentChunkCount++;
+    self.totalSendLatency += latency;
+    self.maximumSendLatency = MAX(self.maximumSendLatency, latency);
+    [self.condition unlock];
+}
+
+// Must be called with the condition locked.
+- (void)scheduleDrainAfter:(NSTimeInterval)delay {
+    if (self.drainScheduled) {
+        return;
+    }
+    self.drainScheduled = YES;
+
+    __weak AWSTranscribeStreamingSendQueue *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.drainQueue, ^{
+        [weakSelf drain];
+    });
+}
+
+#pragma mark - Watermarks and metrics
+
+// Must be called with the condition locked.
+- (void)updateWatermarks {
+    AWSTranscribeStreamingSendQueueConfiguration *configuration = _configuration;
+    NSUInteger webSocketBufferedByteCount = [self webSocketBufferedByteCount];
+    NSUInteger depth = self.pendingByteCount + webSocketBufferedByteCount;
+
+    SEL callback = NULL;
+    if (!self.aboveHighWatermark && depth >= configuration.highWatermark) {
+        self.aboveHighWatermark = YES;
+        callback = @selector(sendQueueDidReachHighWatermark:);
+        // Polls until the depth falls back to the low watermark, even if nothing else is sent.
+        [self scheduleDrainAfter:AWSTranscribeStreamingSendQueuePollInterval];
+    } else if (self.aboveHighWatermark && depth <= configuration.lowWatermark) {
+        self.aboveHighWatermark = NO;
+        callback = @selector(sendQueueDidDrainToLowWatermark:);
+    }
+
+    if (!callback) {
+        return;
+    }
+
+    id<AWSTranscribeStreamingClientDelegate> delegate = self.webSocketProvider.clientDelegate;
+    if (![delegate respondsToSelector:callback]) {
+        return;
+    }
+    AWSTranscribeStreamingSendQueueMetrics *metrics = [self metricsWithWebSocketBufferedByteCount:webSocketBufferedByteCount];
+    dispatch_queue_t callbackQueue = self.callbackQueue ?: dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    dispatch_async(callbackQueue, ^{
+        if (callback == @selector(sendQueueDidReachHighWatermark:)) {
+            [delegate sendQueueDidReachHighWatermark:metrics];
+        } else {
+            [delegate sendQueueDidDrainToLowWatermark:metrics];
+        }
+    });
+}
+
+- (NSUInteger)webSocketBufferedByteCount {
+    if ([self.webSocketProvider respondsToSelector:@selector(bufferedAmount)]) {
+        return [self.webSocketProvider bufferedAmount];
+    }
+    return 0;
+}
+
+// Must be called with the condition locked.
+- (AWSTranscribeStreamingSendQueueMetrics *)metricsWithWebSocketBufferedByteCount:(NSUInteger)webSocketBufferedByteCount {
+    AWSTranscribeStreamingSendQueueMetrics *metrics = [AWSTranscribeStreamingSendQueueMetrics new];
+    metrics.queuedChunkCount = [self.pendingChunks count];
+    metrics.queuedByteCount = self.pendingByteCount;
+    metrics.webSocketBufferedByteCount = webSocketBufferedByteCount;
+    metrics.sentChunkCount = self.sentChunkCount;
+    metrics.droppedChunkCount = self.droppedChunkCount;
+    metrics.droppedByteCount = self.droppedByteCount;
+    metrics.coalescedChunkCount = self.coalescedChunkCount;
+    metrics.averageSendLatency = self.sentChunkCount > 0 ? self.totalSendLatency / self.sentChunkCount : 0;
+    metrics.maximumSendLatency = self.maximumSendLatency;
+    return metrics;
+}
+
+@end
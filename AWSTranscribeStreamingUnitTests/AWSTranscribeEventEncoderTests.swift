@@ -0,0 +1,123 @@
+//
+// Copyright 2010-2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import XCTest
+@testable import AWSTranscribeStreaming
+
+class AWSTranscribeEventEncoderTests: XCTestCase {
+
+    /// 20 ms of 16 kHz, 16-bit mono PCM
+    static let pcmChunk = Data(count: 640)
+
+    static let audioEventHeaders = [
+        ":content-type": "application/octet-stream",
+        ":event-type": "AudioEvent",
+        ":message-type": "event"
+    ]
+
+    // Given: A payload and a single header
+    // When: The chunk is encoded
+    // Then: The frame matches a reference encoding, including both CRCs
+    func testEncodeChunkMatchesReferenceFrame() {
+        let payload = Data((0 ..< 16).map { UInt8($0) })
+        let encoded = AWSTranscribeEventEncoder.encodeChunk(payload, headers: [":event-type": "AudioEvent"])
+        let expected = Data(base64Encoded: "AAAAOQAAABmteK1eCzpldmVudC10eXBlBwAKQXVkaW9FdmVudAABAgMEBQYHCAkKCwwNDg9arS9y")
+        XCTAssertEqual(encoded, expected)
+    }
+
+    // Given: Frames encoded with the same headers
+    // When: The frames are encoded one after another
+    // Then: Each frame is correctly sized and independent of the previous one
+    func testEncodeChunkWithCachedHeaders() {
+        guard let first = AWSTranscribeEventEncoder.encodeChunk(AWSTranscribeEventEncoderTests.pcmChunk,
+                                                                headers: AWSTranscribeEventEncoderTests.audioEventHeaders),
+            let second = AWSTranscribeEventEncoder.encodeChunk(Data(repeating: 1, count: 640),
+                                                               headers: AWSTranscribeEventEncoderTests.audioEventHeaders) else {
+            XCTFail("Failed to encode the chunks")
+            return
+        }
+        XCTAssertEqual(first.count, second.count)
+        XCTAssertNotEqual(first, second)
+        XCTAssertEqual(first.prefix(12), second.prefix(12))
+
+        let totalLength = first.prefix(4).reduce(0) { ($0 << 8) | Int($1) }
+        XCTAssertEqual(totalLength, first.count)
+    }
+
+    // Given: A header name longer than the 255 bytes the format allows
+    // When: The chunk is encoded
+    // Then: No frame is returned, rather than a frame without headers
+    func testEncodeChunkFailsWhenHeadersCannotBeEncoded() {
+        let headers = [String(repeating: "h", count: 256): "AudioEvent"]
+        XCTAssertNil(AWSTranscribeEventEncoder.encodeChunk(AWSTranscribeEventEncoderTests.pcmChunk, headers: headers))
+    }
+
+    // Given: The end frame
+    // When: It is requested more than once
+    // Then: It is an empty audio event and the same instance is reused
+    func testEndFrameIsReused() {
+        let endFrame = AWSTranscribeEventEncoder.getEndFrameData()
+        XCTAssertTrue(endFrame == AWSTranscribeEventEncoder.getEndFrameData())
+        let totalLength = endFrame.prefix(4).reduce(0) { ($0 << 8) | Int($1) }
+        let headerLength = endFrame.dropFirst(4).prefix(4).reduce(0) { ($0 << 8) | Int($1) }
+        XCTAssertEqual(totalLength, 16 + headerLength)
+    }
+
+    // Given: Frames that are shorter than their prelude, cut off, or declare headers longer than the frame
+    // When: They are decoded
+    // Then: Each is rejected with a decode error instead of being read out of bounds
+    func testDecodeRejectsMalformedFrames() {
+        guard let frame = AWSTranscribeEventEncoder.encodeChunk(Data(count: 8), headers: [":event-type": "AudioEvent"]) else {
+            XCTFail("Failed to encode the frame")
+            return
+        }
+        var oversizedHeaders = frame
+        oversizedHeaders.replaceSubrange(4 ..< 8, with: [0x7f, 0xff, 0xff, 0xff])
+        let cases: [(Data, AWSTranscribeStreamingClientErrorCode)] = [
+            (frame.prefix(10), .invalidMessagePrelude),
+            (frame.prefix(frame.count - 1), .invalidMessageLengthHeader),
+            (Data([0, 0, 0, 4]) + frame.dropFirst(4), .invalidMessageLengthHeader),
+            (oversizedHeaders, .invalidMessageLengthHeader)
+        ]
+        for (data, expectedCode) in cases {
+            var error: NSError?
+            XCTAssertNil(AWSTranscribeStreamingEventDecoder.decodeEvent(data, decodingError: &error))
+            XCTAssertEqual(error?.domain, AWSTranscribeStreamingClientErrorDomain)
+            XCTAssertEqual(error?.code, expectedCode.rawValue)
+        }
+    }
+
+    /// Encodes one minute of audio (3,000 frames of 20 ms PCM).
+    func testEncodePerformance() {
+        measure {
+            for _ in 0 ..< 3_000 {
+                _ = AWSTranscribeEventEncoder.encodeChunk(AWSTranscribeEventEncoderTests.pcmChunk,
+                                                          headers: AWSTranscribeEventEncoderTests.audioEventHeaders)
+            }
+        }
+    }
+
+    /// Decodes the headers and body of 3,000 transcript events.
+    func testDecodePerformance() {
+        let eventData = TestData.transcriptEventData
+        measure {
+            var error: NSError?
+            for _ in 0 ..< 3_000 {
+                _ = AWSTranscribeStreamingEventDecoder.decodeEvent(eventData, decodingError: &error)
+            }
+            XCTAssertNil(error)
+        }
+    }
+}
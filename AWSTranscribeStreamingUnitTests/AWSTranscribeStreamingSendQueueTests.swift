@@ -0,0 +1,286 @@
+//
+// Copyright 2010-2024 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import XCTest
+import AWSCore
+@testable import AWSTranscribeStreaming
+
+class AWSTranscribeStreamingSendQueueTests: XCTestCase {
+
+    let audioHeaders = [":event-type": "AudioEvent", ":content-type": "application/octet-stream", ":message-type": "event"]
+
+    // Given: A drop-oldest queue in front of a socket that drains slower than audio is produced
+    // When: Audio is enqueued faster than the socket can take it
+    // Then: The queue never holds more than its capacity, and every chunk is either sent or counted as dropped
+    func testDropOldestBoundsQueuedBytes() {
+        let provider = ThrottledWebSocketProvider(bytesPerTick: 1_000)
+        let queue = makeQueue(provider: provider, policy: .dropOldest)
+        queue.configuration.capacity = 8_000
+
+        for sequence in 0..<200 {
+            queue.enqueue(chunk(sequence: sequence), headers: audioHeaders)
+            XCTAssertLessThanOrEqual(queue.metrics().queuedByteCount, 8_000)
+        }
+
+        waitUntil {
+            let metrics = queue.metrics()
+            return metrics.sentChunkCount + metrics.droppedChunkCount == 200
+        }
+        let metrics = queue.metrics()
+        XCTAssertGreaterThan(metrics.droppedChunkCount, 0)
+        XCTAssertEqual(metrics.droppedByteCount, metrics.droppedChunkCount * 640)
+        XCTAssertEqual(metrics.queuedChunkCount, 0)
+        XCTAssertEqual(provider.sentFrames.count, metrics.sentChunkCount)
+        provider.stop()
+    }
+
+    // Given: A block queue in front of a throttled socket
+    // When: More audio than the queue can hold is enqueued from a producer thread
+    // Then: The producer waits for room, nothing is dropped, and frames arrive in order with the end frame last
+    func testBlockDeliversEveryChunkInOrder() {
+        let provider = ThrottledWebSocketProvider(bytesPerTick: 4_000)
+        let queue = makeQueue(provider: provider, policy: .block)
+        queue.configuration.capacity = 4_000
+
+        let producerFinished = expectation(description: "Producer finished")
+        DispatchQueue.global().async {
+            for sequence in 0..<100 {
+                queue.enqueue(self.chunk(sequence: sequence), headers: self.audioHeaders)
+            }
+            queue.enqueueEndFrame()
+            producerFinished.fulfill()
+        }
+        wait(for: [producerFinished], timeout: 10)
+
+        waitUntil { provider.sentFrames.count == 101 }
+        let messages = provider.sentFrames.compactMap { try? AWSEventStreamDecoder.decodeMessage($0) }
+        XCTAssertEqual(messages.count, 101)
+        XCTAssertEqual(messages.dropLast().map { Int($0.payload.first ?? 0) }, Array(0..<100))
+        XCTAssertEqual(messages.last?.payload.count, 0)
+        XCTAssertEqual(queue.metrics().droppedChunkCount, 0)
+        XCTAssertEqual(queue.metrics().sentChunkCount, 101)
+        provider.stop()
+    }
+
+    // Given: A coalescing queue in front of a saturated socket
+    // When: Small chunks with identical headers are enqueued
+    // Then: They are merged into frames no larger than the maximum coalesced chunk length
+    func testCoalesceMergesChunksWithEqualHeaders() {
+        let provider = ThrottledWebSocketProvider(bytesPerTick: 0)
+        provider.buffered = 1_000_000
+        let queue = makeQueue(provider: provider, policy: .coalesce)
+        queue.configuration.maximumCoalescedChunkLength = 6_400
+
+        for sequence in 0..<50 {
+            queue.enqueue(chunk(sequence: sequence), headers: audioHeaders)
+        }
+
+        let metrics = queue.metrics()
+        XCTAssertEqual(metrics.coalescedChunkCount, 45)
+        XCTAssertEqual(metrics.queuedChunkCount, 5)
+        XCTAssertEqual(metrics.queuedByteCount, 50 * 640)
+
+        provider.buffered = 0
+        provider.bytesPerTick = 1_000_000
+        waitUntil { provider.sentFrames.count == 5 }
+        let payloads = provider.sentFrames.compactMap { try? AWSEventStreamDecoder.decodeMessage($0).payload }
+        XCTAssertEqual(payloads.map { $0.count }, Array(repeating: 6_400, count: 5))
+        provider.stop()
+    }
+
+    // Given: A queue with a delegate that implements the watermark callbacks
+    // When: The socket stalls until the depth passes the high watermark, then drains
+    // Then: The delegate is told once when the high watermark is reached and once when it drains to the low watermark
+    func testWatermarkCallbacks() {
+        let provider = ThrottledWebSocketProvider(bytesPerTick: 0)
+        let delegate = MockTranscribeStreamingClientDelegate()
+        provider.clientDelegate = delegate
+        let queue = makeQueue(provider: provider, policy: .dropOldest)
+        queue.configuration.webSocketBufferLimit = 0
+        queue.configuration.highWatermark = 6_400
+        queue.configuration.lowWatermark = 1_280
+
+        let reachedHigh = expectation(description: "High watermark reached")
+        let drainedToLow = expectation(description: "Drained to low watermark")
+        delegate.highWatermarkCallback = { metrics in
+            XCTAssertGreaterThanOrEqual(metrics.queuedByteCount + metrics.webSocketBufferedByteCount, 6_400)
+            reachedHigh.fulfill()
+        }
+        delegate.lowWatermarkCallback = { metrics in
+            XCTAssertLessThanOrEqual(metrics.queuedByteCount + metrics.webSocketBufferedByteCount, 1_280)
+            drainedToLow.fulfill()
+        }
+
+        for sequence in 0..<20 {
+            queue.enqueue(chunk(sequence: sequence), headers: audioHeaders)
+        }
+        wait(for: [reachedHigh], timeout: 1)
+
+        provider.bytesPerTick = 10_000
+        wait(for: [drainedToLow], timeout: 2)
+        provider.stop()
+    }
+
+    // Given: A drop-oldest queue that is full
+    // When: The end frame is enqueued and more audio follows it
+    // Then: The end frame is never dropped
+    func testEndFrameIsNeverDropped() {
+        let provider = ThrottledWebSocketProvider(bytesPerTick: 0)
+        provider.buffered = 1_000_000
+        let queue = makeQueue(provider: provider, policy: .dropOldest)
+        queue.configuration.capacity = 1_280
+
+        queue.enqueue(chunk(sequence: 0), headers: audioHeaders)
+        queue.enqueueEndFrame()
+        for sequence in 1..<10 {
+            queue.enqueue(chunk(sequence: sequence), headers: audioHeaders)
+        }
+
+        provider.buffered = 0
+        provider.bytesPerTick = 1_000_000
+        waitUntil { provider.sentFrames.count == queue.metrics().sentChunkCount && queue.metrics().queuedChunkCount == 0 }
+        let messages = provider.sentFrames.compactMap { try? AWSEventStreamDecoder.decodeMessage($0) }
+        XCTAssertTrue(messages.contains { $0.payload.isEmpty })
+        provider.stop()
+    }
+
+    // Given: A drop-oldest queue holding audio behind a stalled socket
+    // When: A chunk larger than the queue's capacity is enqueued
+    // Then: That chunk is dropped and the audio already queued is kept
+    func testDropOldestDropsChunksLargerThanCapacity() {
+        let provider = ThrottledWebSocketProvider(bytesPerTick: 0)
+        provider.buffered = 1_000_000
+        let queue = makeQueue(provider: provider, policy: .dropOldest)
+        queue.configuration.capacity = 1_280
+
+        queue.enqueue(chunk(sequence: 0), headers: audioHeaders)
+        queue.enqueue(chunk(sequence: 1), headers: audioHeaders)
+        queue.enqueue(Data(count: 2_000), headers: audioHeaders)
+
+        let metrics = queue.metrics()
+        XCTAssertEqual(metrics.queuedChunkCount, 2)
+        XCTAssertEqual(metrics.queuedByteCount, 1_280)
+        XCTAssertEqual(metrics.droppedChunkCount, 1)
+        XCTAssertEqual(metrics.droppedByteCount, 2_000)
+        provider.stop()
+    }
+
+    func testEnqueuePerformance() {
+        let audio = Data(count: 640)
+        measure {
+            let provider = ThrottledWebSocketProvider(bytesPerTick: Int.max / 2)
+            let queue = makeQueue(provider: provider, policy: .dropOldest)
+            for _ in 0..<3_000 {
+                queue.enqueue(audio, headers: audioHeaders)
+            }
+            queue.reset()
+            provider.stop()
+        }
+    }
+
+    // MARK: - Helpers
+
+    func makeQueue(provider: ThrottledWebSocketProvider,
+                   policy: AWSTranscribeStreamingSendQueuePolicy) -> AWSTranscribeStreamingSendQueue {
+        let queue = AWSTranscribeStreamingSendQueue(webSocketProvider: provider)
+        queue.configuration.policy = policy
+        queue.configuration.webSocketBufferLimit = 640
+        return queue
+    }
+
+    /// 20 ms of 16 kHz, 16-bit PCM whose first byte carries a sequence number.
+    func chunk(sequence: Int) -> Data {
+        var data = Data(count: 640)
+        data[0] = UInt8(truncatingIfNeeded: sequence)
+        return data
+    }
+
+    func waitUntil(timeout: TimeInterval = 5, _ condition: () -> Bool) {
+        let deadline = Date(timeIntervalSinceNow: timeout)
+        while !condition() && Date() < deadline {
+            Thread.sleep(forTimeInterval: 0.005)
+        }
+        XCTAssertTrue(condition())
+    }
+}
+
+/// A web socket stand-in that reports its buffered byte count and drains `bytesPerTick` bytes every 5 ms, like a
+/// socket on a slow uplink.
+class ThrottledWebSocketProvider: NSObject, AWSTranscribeStreamingWebSocketProvider {
+
+    var clientDelegate: AWSTranscribeStreamingClientDelegate = MockTranscribeStreamingClientDelegate()
+
+    private let lock = NSLock()
+    private var _buffered = 0
+    private var _bytesPerTick: Int
+    private var _sentFrames = [Data]()
+    private let timer = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "ThrottledWebSocketProvider"))
+
+    var buffered: Int {
+        get { lock.lock(); defer { lock.unlock() }; return _buffered }
+        set { lock.lock(); _buffered = newValue; lock.unlock() }
+    }
+
+    var bytesPerTick: Int {
+        get { lock.lock(); defer { lock.unlock() }; return _bytesPerTick }
+        set { lock.lock(); _bytesPerTick = newValue; lock.unlock() }
+    }
+
+    var sentFrames: [Data] {
+        lock.lock(); defer { lock.unlock() }
+        return _sentFrames
+    }
+
+    init(bytesPerTick: Int) {
+        _bytesPerTick = bytesPerTick
+        super.init()
+        timer.schedule(deadline: .now(), repeating: .milliseconds(5))
+        timer.setEventHandler { [weak self] in
+            guard let self = self else { return }
+            self.lock.lock()
+            self._buffered = max(0, self._buffered - self._bytesPerTick)
+            self.lock.unlock()
+        }
+        timer.resume()
+    }
+
+    func stop() {
+        timer.cancel()
+    }
+
+    func send(_ data: Data) {
+        lock.lock()
+        _buffered += data.count
+        _sentFrames.append(data)
+        lock.unlock()
+    }
+
+    func bufferedAmount() -> Int {
+        return buffered
+    }
+
+    func connect() {
+    }
+
+    func disconnect() {
+    }
+
+    func setDelegate(_ delegate: AWSTranscribeStreamingClientDelegate, dispatchQueue: DispatchQueue) {
+        clientDelegate = delegate
+    }
+
+    func configure(with urlRequest: URLRequest) {
+    }
+}
@@ -9,4 +9,6 @@
 #import "AWSTranscribeStreamingWebSocketProvider.h"
 #import "AWSSRWebSocket+TranscribeStreaming.h"
 #import "AWSTranscribeStreamingEventDecoder.h"
+#import "AWSTranscribeEventEncoder.h"
+#import "AWSTranscribeStreamingSendQueue.h"
 #import "AWSTranscribeStreamingClientDelegate.h"
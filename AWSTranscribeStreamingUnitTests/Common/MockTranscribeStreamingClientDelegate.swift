@@ -19,6 +19,8 @@ import AWSTranscribeStreaming
 class MockTranscribeStreamingClientDelegate: NSObject, AWSTranscribeStreamingClientDelegate {
     var receiveEventCallback: ((AWSTranscribeStreamingTranscriptResultStream?, Error?) -> Void)?
     var connectionStatusCallback: ((AWSTranscribeStreamingClientConnectionStatus, Error?) -> Void)?
+    var highWatermarkCallback: ((AWSTranscribeStreamingSendQueueMetrics) -> Void)?
+    var lowWatermarkCallback: ((AWSTranscribeStreamingSendQueueMetrics) -> Void)?
 
     func didReceiveEvent(_ event: AWSTranscribeStreamingTranscriptResultStream?, decodingError: Error?) {
         receiveEventCallback?(event, decodingError)
@@ -28,4 +30,12 @@ class MockTranscribeStreamingClientDelegate: NSObject, AWSTranscribeStreamingCli
                                    withError error: Error?) {
         connectionStatusCallback?(connectionStatus, error)
     }
+
+    func sendQueueDidReachHighWatermark(_ metrics: AWSTranscribeStreamingSendQueueMetrics) {
+        highWatermarkCallback?(metrics)
+    }
+
+    func sendQueueDidDrainToLowWatermark(_ metrics: AWSTranscribeStreamingSendQueueMetrics) {
+        lowWatermarkCallback?(metrics)
+    }
 }